@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/scoped_timer.h"
+#include "execution/sql/join_hash_table.h"
+#include "execution/sql/memory_pool.h"
+#include "execution/sql/sorter.h"
+#include "execution/sql/spill_file.h"
+#include "execution/util/hash.h"
+#include "storage/data_table.h"
+#include "storage/storage_util.h"
+#include "test_util/bwtree_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "transaction/transaction_context.h"
+
+namespace terrier {
+
+/**
+ * These benchmarks measure the unit costs of optimizer::CostModelParameters on the host. Each benchmark counts the
+ * units its parameter is defined on as items, so that the parameter is 1e9 divided by the reported items per second.
+ * They run single-threaded on tables larger than the caches, the way one pipeline of a query would.
+ */
+class CostModelCalibrationBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) final {
+    redo_buffer_ = common::AllocationUtil::AllocateAligned(initializer_.ProjectedRowSize());
+    redo_ = initializer_.InitializeRow(redo_buffer_);
+    StorageTestUtil::PopulateRandomRow(redo_, layout_, 0, &generator_);
+    read_buffer_ = common::AllocationUtil::AllocateAligned(initializer_.ProjectedRowSize());
+    read_ = initializer_.InitializeRow(read_buffer_);
+
+    keys_.resize(num_tuples_);
+    for (uint32_t i = 0; i < num_tuples_; i++) keys_[i] = i;
+    std::shuffle(keys_.begin(), keys_.end(), generator_);
+  }
+
+  void TearDown(const benchmark::State &state) final {
+    delete[] redo_buffer_;
+    delete[] read_buffer_;
+  }
+
+  // Tuple layout, about the width the cost model assumes
+  const uint8_t column_size_ = 8;
+  const storage::BlockLayout layout_{{column_size_, column_size_, column_size_, column_size_}};
+  const storage::ProjectedRowInitializer initializer_ =
+      storage::ProjectedRowInitializer::Create(layout_, StorageTestUtil::ProjectionListAllColumns(layout_));
+
+  // Workload
+  const uint32_t num_tuples_ = 10000000;
+
+  // Test infrastructure
+  std::default_random_engine generator_;
+  storage::BlockStore block_store_{1000, 1000};
+  storage::RecordBufferSegmentPool buffer_pool_{num_tuples_, num_tuples_};
+
+  byte *redo_buffer_;
+  storage::ProjectedRow *redo_;
+  byte *read_buffer_;
+  storage::ProjectedRow *read_;
+
+  // The keys [0, num_tuples_) in random order
+  std::vector<uint64_t> keys_;
+};
+
+/**
+ * The tuple of the hash table and sort benchmarks
+ */
+struct CalibrationTuple {
+  uint64_t key_, a_, b_, c_;
+};
+
+// seq_tuple_cost_: scan a DataTable vector at a time
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CostModelCalibrationBenchmark, SeqScan)(benchmark::State &state) {
+  storage::DataTable table(&block_store_, layout_, storage::layout_version_t(0));
+  transaction::TransactionContext txn(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                      common::ManagedPointer(&buffer_pool_), DISABLED);
+  for (uint32_t i = 0; i < num_tuples_; i++) table.Insert(common::ManagedPointer(&txn), *redo_);
+
+  storage::ProjectedColumnsInitializer initializer(layout_, StorageTestUtil::ProjectionListAllColumns(layout_),
+                                                   common::Constants::K_DEFAULT_VECTOR_SIZE);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+  storage::ProjectedColumns *columns = initializer.Initialize(buffer);
+
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      auto it = table.begin();
+      while (it != table.end()) table.Scan(common::ManagedPointer(&txn), &it, columns);
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  delete[] buffer;
+  state.SetItemsProcessed(state.iterations() * num_tuples_);
+}
+
+// cpu_operator_cost_: compare a column against a constant
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CostModelCalibrationBenchmark, Predicate)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_ms;
+    uint64_t matches = 0;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (const uint64_t key : keys_) matches += static_cast<uint64_t>(key < num_tuples_ / 2);
+    }
+    benchmark::DoNotOptimize(matches);
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_tuples_);
+}
+
+// index_probe_cost_: look up random keys in a BwTree, counting log2(keys) levels per lookup
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CostModelCalibrationBenchmark, IndexProbe)(benchmark::State &state) {
+  auto *const tree = BwTreeTestUtil::GetEmptyTree();
+  for (uint32_t i = 0; i < num_tuples_; i++) tree->Insert(static_cast<int64_t>(i), static_cast<int64_t>(i));
+
+  std::vector<int64_t> values;
+  values.reserve(1);
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (const uint64_t key : keys_) {
+        tree->GetValue(static_cast<int64_t>(key), values);
+        values.clear();
+      }
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  delete tree;
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_tuples_ * std::log2(num_tuples_)));
+}
+
+// index_tuple_cost_: fetch the tuples of random TupleSlots from a DataTable
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CostModelCalibrationBenchmark, IndexTupleFetch)(benchmark::State &state) {
+  storage::DataTable table(&block_store_, layout_, storage::layout_version_t(0));
+  transaction::TransactionContext txn(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                      common::ManagedPointer(&buffer_pool_), DISABLED);
+  std::vector<storage::TupleSlot> slots;
+  slots.reserve(num_tuples_);
+  for (uint32_t i = 0; i < num_tuples_; i++) slots.emplace_back(table.Insert(common::ManagedPointer(&txn), *redo_));
+  std::shuffle(slots.begin(), slots.end(), generator_);
+
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (const auto slot : slots) table.Select(common::ManagedPointer(&txn), slot, read_);
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_tuples_);
+}
+
+// hash_build_cost_: insert tuples into a JoinHashTable and build it
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CostModelCalibrationBenchmark, HashBuild)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    execution::sql::MemoryPool memory(nullptr);
+    execution::sql::JoinHashTable join_hash_table(&memory, sizeof(CalibrationTuple));
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (const uint64_t key : keys_) {
+        auto *tuple = reinterpret_cast<CalibrationTuple *>(
+            join_hash_table.AllocInputTuple(execution::util::Hasher::Hash(key)));
+        tuple->key_ = key;
+      }
+      join_hash_table.Build();
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_tuples_);
+}
+
+// hash_probe_cost_: probe a built JoinHashTable with random keys
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CostModelCalibrationBenchmark, HashProbe)(benchmark::State &state) {
+  const auto key_eq = [](void *, void *probe_tuple, void *table_tuple) {
+    return reinterpret_cast<const CalibrationTuple *>(probe_tuple)->key_ ==
+           reinterpret_cast<const CalibrationTuple *>(table_tuple)->key_;
+  };
+  execution::sql::MemoryPool memory(nullptr);
+  execution::sql::JoinHashTable join_hash_table(&memory, sizeof(CalibrationTuple));
+  for (uint32_t i = 0; i < num_tuples_; i++) {
+    auto *tuple = reinterpret_cast<CalibrationTuple *>(
+        join_hash_table.AllocInputTuple(execution::util::Hasher::Hash(static_cast<uint64_t>(i))));
+    tuple->key_ = i;
+  }
+  join_hash_table.Build();
+
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_ms;
+    uint64_t matches = 0;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (const uint64_t key : keys_) {
+        CalibrationTuple probe{key, 0, 0, 0};
+        for (auto iter = join_hash_table.Lookup<false>(execution::util::Hasher::Hash(key));
+             iter.HasNext(key_eq, nullptr, &probe);) {
+          iter.NextMatch();
+          matches++;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(matches);
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_tuples_);
+}
+
+// sort_compare_cost_: sort tuples with a Sorter, counting n * log2(n) comparisons
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CostModelCalibrationBenchmark, Sort)(benchmark::State &state) {
+  const auto cmp_fn = [](const void *lhs, const void *rhs) -> int32_t {
+    const auto l = reinterpret_cast<const CalibrationTuple *>(lhs)->key_;
+    const auto r = reinterpret_cast<const CalibrationTuple *>(rhs)->key_;
+    return l < r ? -1 : (l == r ? 0 : 1);
+  };
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    execution::sql::MemoryPool memory(nullptr);
+    execution::sql::Sorter sorter(&memory, cmp_fn, sizeof(CalibrationTuple));
+    for (const uint64_t key : keys_) reinterpret_cast<CalibrationTuple *>(sorter.AllocInputTuple())->key_ = key;
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      sorter.Sort();
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_tuples_ * std::log2(num_tuples_)));
+}
+
+// spill_tuple_cost_: write tuples to a spill file and read them back
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CostModelCalibrationBenchmark, Spill)(benchmark::State &state) {
+  constexpr uint32_t tuples_per_chunk = 4096;
+  std::vector<CalibrationTuple> chunk(tuples_per_chunk);
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    execution::sql::SpillFile file;
+    std::vector<uint64_t> offsets;
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (uint32_t i = 0; i < num_tuples_; i += tuples_per_chunk) {
+        offsets.push_back(file.Append(chunk.data(), tuples_per_chunk * sizeof(CalibrationTuple)));
+      }
+      for (const uint64_t offset : offsets) {
+        file.Read(offset, chunk.data(), tuples_per_chunk * sizeof(CalibrationTuple));
+      }
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_tuples_);
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark Registration
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(CostModelCalibrationBenchmark, SeqScan)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+BENCHMARK_REGISTER_F(CostModelCalibrationBenchmark, Predicate)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+BENCHMARK_REGISTER_F(CostModelCalibrationBenchmark, IndexProbe)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+BENCHMARK_REGISTER_F(CostModelCalibrationBenchmark, IndexTupleFetch)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+BENCHMARK_REGISTER_F(CostModelCalibrationBenchmark, HashBuild)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+BENCHMARK_REGISTER_F(CostModelCalibrationBenchmark, HashProbe)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+BENCHMARK_REGISTER_F(CostModelCalibrationBenchmark, Sort)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+BENCHMARK_REGISTER_F(CostModelCalibrationBenchmark, Spill)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+// clang-format on
+
+}  // namespace terrier
@@ -359,7 +359,7 @@ void BindNodeVisitor::Visit(UNUSED_ATTRIBUTE parser::TransactionStatement *node,
 }
 void BindNodeVisitor::Visit(parser::AnalyzeStatement *node, UNUSED_ATTRIBUTE parser::ParseResult *parse_result) {
   BINDER_LOG_DEBUG("Visiting AnalyzeStatement ...");
-  node->GetAnalyzeTable()->TryBindDatabaseName(default_database_name_);
+  if (node->GetAnalyzeTable() != nullptr) node->GetAnalyzeTable()->TryBindDatabaseName(default_database_name_);
 }
 
 void BindNodeVisitor::Visit(UNUSED_ATTRIBUTE parser::ConstantValueExpression *expr,
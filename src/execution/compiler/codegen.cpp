@@ -184,10 +184,44 @@ ast::Expr *CodeGen::PCIFilter(ast::Identifier pci, parser::ExpressionType comp_t
   return Factory()->NewBuiltinCallExpr(fun, std::move(args));
 }
 
+ast::Expr *CodeGen::PCIFilterLike(ast::Identifier pci, parser::ExpressionType comp_type, uint32_t col_idx,
+                                  std::string_view pattern) {
+  TERRIER_ASSERT(
+      comp_type == parser::ExpressionType::COMPARE_LIKE || comp_type == parser::ExpressionType::COMPARE_NOT_LIKE,
+      "Not a LIKE comparison");
+  ast::Builtin builtin =
+      comp_type == parser::ExpressionType::COMPARE_LIKE ? ast::Builtin::FilterLike : ast::Builtin::FilterNotLike;
+  std::vector<ast::Expr *> args{MakeExpr(pci), IntLiteral(col_idx), StringLiteral(pattern)};
+  return BuiltinCall(builtin, std::move(args));
+}
+
+ast::Expr *CodeGen::PCIFilterInList(ast::Identifier pci, uint32_t col_idx,
+                                    const std::vector<std::string_view> &values) {
+  std::vector<ast::Expr *> args{MakeExpr(pci), IntLiteral(col_idx)};
+  for (const auto &value : values) args.emplace_back(StringLiteral(value));
+  return BuiltinCall(ast::Builtin::FilterInList, std::move(args));
+}
+
 ast::Expr *CodeGen::ExecCtxGetMem() {
   return OneArgCall(ast::Builtin::ExecutionContextGetMemoryPool, exec_ctx_var_, false);
 }
 
+ast::Expr *CodeGen::ExecCtxReportRows(uint32_t probe_id, ast::Expr *num_rows) {
+  std::vector<ast::Expr *> args{MakeExpr(exec_ctx_var_), IntLiteral(probe_id), num_rows};
+  return BuiltinCall(ast::Builtin::ExecutionContextReportRows, std::move(args));
+}
+
+ast::Expr *CodeGen::PCIFilterVector(ast::Identifier pci, uint32_t filter_id) {
+  std::vector<ast::Expr *> args{MakeExpr(exec_ctx_var_), MakeExpr(pci), IntLiteral(filter_id)};
+  return BuiltinCall(ast::Builtin::FilterVector, std::move(args));
+}
+
+ast::Expr *CodeGen::PCIHashColumn(ast::Identifier pci, uint16_t col_idx, type::TypeId col_type, bool combine) {
+  std::vector<ast::Expr *> args{MakeExpr(pci), IntLiteral(col_idx), IntLiteral(static_cast<int8_t>(col_type)),
+                                BoolLiteral(combine)};
+  return BuiltinCall(ast::Builtin::PCIHashColumn, std::move(args));
+}
+
 ast::Expr *CodeGen::SizeOf(ast::Identifier type_name) { return OneArgCall(ast::Builtin::SizeOf, type_name, false); }
 
 ast::Expr *CodeGen::HTInitCall(ast::Builtin builtin, ast::Identifier object, ast::Identifier struct_type) {
@@ -240,6 +274,9 @@ ast::Expr *CodeGen::IndexIteratorScan(ast::Identifier iter, planner::IndexScanTy
       use_limit = true;
       builtin = ast::Builtin::IndexIteratorScanLimitDescending;
       break;
+    case planner::IndexScanType::AscendingRanges:
+      builtin = ast::Builtin::IndexIteratorScanRanges;
+      break;
     default:
       UNREACHABLE("Unknown scan type");
   }
@@ -493,9 +530,12 @@ ast::Expr *CodeGen::DateToSql(int16_t year, uint8_t month, uint8_t day) {
 }
 
 ast::Expr *CodeGen::StringToSql(std::string_view str) {
+  return OneArgCall(ast::Builtin::StringToSql, StringLiteral(str));
+}
+
+ast::Expr *CodeGen::StringLiteral(std::string_view str) {
   ast::Identifier str_ident = Context()->GetIdentifier({str.data(), str.length()});
-  ast::Expr *str_lit = Factory()->NewStringLiteral(DUMMY_POS, str_ident);
-  return OneArgCall(ast::Builtin::StringToSql, str_lit);
+  return Factory()->NewStringLiteral(DUMMY_POS, str_ident);
 }
 
 ast::Expr *CodeGen::StorageInterfaceInit(ast::Identifier si, uint32_t table_oid, ast::Identifier col_oids,
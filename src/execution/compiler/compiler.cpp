@@ -7,9 +7,18 @@
 #include "execution/compiler/translator_factory.h"
 #include "execution/sema/sema.h"
 #include "loggers/execution_logger.h"
+#include "planner/plannodes/aggregate_plan_node.h"
 
 namespace terrier::execution::compiler {
 
+namespace {
+// Whether the aggregation groups input that is already sorted on its group by terms
+bool IsStreamingAggregate(const terrier::planner::AbstractPlanNode &op) {
+  const auto &agg = static_cast<const planner::AggregatePlanNode &>(op);
+  return agg.GetAggregateStrategyType() == planner::AggregateStrategyType::SORTED && !agg.GetGroupByTerms().empty();
+}
+}  // namespace
+
 Compiler::Compiler(CodeGen *codegen, const planner::AbstractPlanNode *plan) : codegen_(codegen), plan_(plan) {
   // Make the pipelines
   auto main_pipeline = std::make_unique<Pipeline>(codegen_);
@@ -72,6 +81,16 @@ ast::File *Compiler::Compile() {
 void Compiler::MakePipelines(const terrier::planner::AbstractPlanNode &op, Pipeline *curr_pipeline) {
   switch (op.GetPlanNodeType()) {
     case terrier::planner::PlanNodeType::AGGREGATE:
+      if (IsStreamingAggregate(op)) {
+        // Aggregating sorted input does not break the pipeline. Both sides belong to the current pipeline.
+        auto bottom_translator = TranslatorFactory::CreateBottomTranslator(&op, codegen_);
+        auto top_translator = TranslatorFactory::CreateTopTranslator(&op, bottom_translator.get(), codegen_);
+        MakePipelines(*op.GetChild(0), curr_pipeline);
+        curr_pipeline->Add(std::move(bottom_translator));
+        curr_pipeline->Add(std::move(top_translator));
+        return;
+      }
+      [[fallthrough]];
     case terrier::planner::PlanNodeType::ORDERBY: {
       // These nodes split in two parts: A "build" side (called bottom) and an "iterate" side (called top).
       auto bottom_translator = TranslatorFactory::CreateBottomTranslator(&op, codegen_);
@@ -85,7 +104,8 @@ void Compiler::MakePipelines(const terrier::planner::AbstractPlanNode &op, Pipel
       curr_pipeline->Add(std::move(top_translator));
       return;
     }
-    case terrier::planner::PlanNodeType::HASHJOIN: {
+    case terrier::planner::PlanNodeType::HASHJOIN:
+    case terrier::planner::PlanNodeType::MERGEJOIN: {
       // The hash join splits also splits in a "build" side (called left) and an "iterate" side (called right).
       auto left_translator = TranslatorFactory::CreateLeftTranslator(&op, codegen_);
       auto right_translator = TranslatorFactory::CreateRightTranslator(&op, left_translator.get(), codegen_);
@@ -95,7 +115,7 @@ void Compiler::MakePipelines(const terrier::planner::AbstractPlanNode &op, Pipel
       MakePipelines(*op.GetChild(0), next_pipeline.get());
       next_pipeline->Add(std::move(left_translator));
       pipelines_.emplace_back(std::move(next_pipeline));
-      // The "iterate" side belongs the current pipeline.
+      // The "iterate" side belongs the current pipeline. For a merge join, it streams against the sorted left side.
       MakePipelines(*op.GetChild(1), curr_pipeline);
       curr_pipeline->Add(std::move(right_translator));
       return;
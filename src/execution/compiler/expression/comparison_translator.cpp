@@ -28,6 +28,10 @@ ast::Expr *ComparisonTranslator::DeriveExpr(ExpressionEvaluator *evaluator) {
     case terrier::parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
       op_token = parsing::Token::Type::LESS_EQUAL;
       break;
+    case terrier::parser::ExpressionType::COMPARE_LIKE:
+      return codegen_->BuiltinCall(ast::Builtin::Like, {left_expr, right_expr});
+    case terrier::parser::ExpressionType::COMPARE_NOT_LIKE:
+      return codegen_->BuiltinCall(ast::Builtin::NotLike, {left_expr, right_expr});
     default:
       UNREACHABLE("Unsupported expression");
   }
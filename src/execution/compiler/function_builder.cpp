@@ -29,6 +29,17 @@ void FunctionBuilder::StartIfStmt(ast::Expr *condition) {
   blocks_.emplace_back(ifblock);
 }
 
+void FunctionBuilder::StartIfElseStmt(ast::Expr *condition) {
+  auto ifblock = codegen_->EmptyBlock();
+  auto elseblock = codegen_->EmptyBlock();
+  Append(codegen_->Factory()->NewIfStmt(DUMMY_POS, condition, ifblock, elseblock));
+  // The else block is only current once the then block is popped by StartElseBlock
+  blocks_.emplace_back(elseblock);
+  blocks_.emplace_back(ifblock);
+}
+
+void FunctionBuilder::StartElseBlock() { blocks_.pop_back(); }
+
 void FunctionBuilder::FinishBlockStmt() { blocks_.pop_back(); }
 
 ast::FunctionDecl *FunctionBuilder::Finish() {
@@ -1,25 +1,116 @@
 #include "execution/compiler/operator/aggregate_translator.h"
+#include <cmath>
+#include <limits>
 #include <utility>
 #include <vector>
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/translator_factory.h"
+#include "optimizer/statistics/stats_storage.h"
+#include "parser/expression/aggregate_expression.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/derived_value_expression.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
 
 namespace terrier::execution::compiler {
+namespace {
+// The most keys a directly addressed table has slots for, i.e. as many as SMALLINT has values
+constexpr double K_MAX_DENSE_KEYS = 1 << 16;
+// The largest magnitude of a statistics bound that is converted to a key
+constexpr double K_MAX_DENSE_BOUND = 1e18;
+
+// Find the range of a single integer grouping key whose groups can be directly addressed. TINYINT and SMALLINT keys
+// use their whole domain. Wider keys that read a column of the child scan use the range of the column's statistics;
+// the keys outside of it, such as those written since the statistics were collected, are hashed.
+bool DenseKeyRange(const planner::AggregatePlanNode *op, CodeGen *codegen, int64_t *min_key, int64_t *max_key) {
+  const auto *key = op->GetGroupByTerms()[0].Get();
+  switch (key->GetReturnValueType()) {
+    case type::TypeId::TINYINT:
+      *min_key = std::numeric_limits<int8_t>::min();
+      *max_key = std::numeric_limits<int8_t>::max();
+      return true;
+    case type::TypeId::SMALLINT:
+      *min_key = std::numeric_limits<int16_t>::min();
+      *max_key = std::numeric_limits<int16_t>::max();
+      return true;
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      break;
+    default:
+      return false;
+  }
+
+  // Look through the reference to the output of the child scan
+  const auto *scan = dynamic_cast<const planner::SeqScanPlanNode *>(op->GetChild(0));
+  if (scan == nullptr) return false;
+  if (key->GetExpressionType() == parser::ExpressionType::VALUE_TUPLE) {
+    const auto *dve = dynamic_cast<const parser::DerivedValueExpression *>(key);
+    if (dve->GetTupleIdx() != 0) return false;
+    key = scan->GetOutputSchema()->GetColumn(static_cast<uint32_t>(dve->GetValueIdx())).GetExpr().Get();
+  }
+  const auto *cve = dynamic_cast<const parser::ColumnValueExpression *>(key);
+  auto stats_storage = codegen->ExecCtx()->GetStatsStorage();
+  if (cve == nullptr || stats_storage == nullptr) return false;
+  auto table_stats = stats_storage->GetTableStats(codegen->ExecCtx()->DBOid(), scan->GetTableOid());
+  if (table_stats == nullptr || !table_stats->HasColumnStats(cve->GetColumnOid())) return false;
+  const auto &bounds = table_stats->GetColumnStats(cve->GetColumnOid())->GetHistogramBounds();
+  if (bounds.empty()) return false;
+  const double min_bound = std::floor(bounds.front());
+  const double max_bound = std::ceil(bounds.back());
+  // Negated, so that NaN bounds are rejected as well
+  if (!(max_bound - min_bound < K_MAX_DENSE_KEYS && std::fabs(min_bound) <= K_MAX_DENSE_BOUND &&
+        std::fabs(max_bound) <= K_MAX_DENSE_BOUND)) {
+    return false;
+  }
+  *min_key = static_cast<int64_t>(min_bound);
+  *max_key = static_cast<int64_t>(max_bound);
+  return true;
+}
+}  // namespace
+
 AggregateBottomTranslator::AggregateBottomTranslator(const terrier::planner::AggregatePlanNode *op, CodeGen *codegen)
     : OperatorTranslator(codegen),
       num_group_by_terms_{static_cast<uint32_t>(op->GetGroupByTerms().size())},
       op_(op),
+      is_global_{op->GetGroupByTerms().empty()},
+      is_streaming_{!is_global_ && op->GetAggregateStrategyType() == planner::AggregateStrategyType::SORTED},
+      // A key with few enough values gets a slot for each
+      is_dense_{UsesHashTable() && num_group_by_terms_ == 1 &&
+                DenseKeyRange(op, codegen, &dense_min_key_, &dense_max_key_)},
       hash_val_(codegen->NewIdentifier("hash_val")),
       agg_values_(codegen->NewIdentifier("agg_value")),
       values_struct_(codegen->NewIdentifier("AggValues")),
       payload_struct_(codegen->NewIdentifier("AggPayload")),
       agg_payload_(codegen->NewIdentifier("agg_payload")),
       key_check_(codegen->NewIdentifier("aggKeyCheckFn")),
-      agg_ht_(codegen->NewIdentifier("agg_ht")) {}
+      agg_ht_(codegen->NewIdentifier("agg_ht")),
+      merge_fn_(codegen->NewIdentifier("aggMergeFn")),
+      merge_key_check_(codegen->NewIdentifier("aggMergeKeyCheckFn")),
+      part_ht_(codegen->NewIdentifier("agg_part_ht")),
+      part_iter_(codegen->NewIdentifier("agg_part_iter")),
+      agg_partial_(codegen->NewIdentifier("agg_partial")),
+      has_group_(codegen->NewIdentifier("agg_has_group")) {
+  if (is_global_) {
+    for (uint32_t term_idx = 0; term_idx < op->GetAggregateTerms().size(); term_idx++) {
+      global_aggs_.emplace_back(codegen->NewIdentifier(AGG_TERM_NAMES));
+    }
+  }
+}
 
-// Declare the hash table
+// Declare the hash table, or the aggregates themselves if there is no GROUP BY
 void AggregateBottomTranslator::InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) {
+  if (is_global_) {
+    // agg_term_i : AggregateType
+    for (uint32_t term_idx = 0; term_idx < global_aggs_.size(); term_idx++) {
+      const auto &term = op_->GetAggregateTerms()[term_idx];
+      ast::Expr *type = codegen_->AggregateType(term->GetExpressionType(), term->GetChild(0)->GetReturnValueType());
+      state_fields->emplace_back(codegen_->MakeField(global_aggs_[term_idx], type));
+    }
+    return;
+  }
+  // The current group of a streaming aggregation is a local variable
+  if (is_streaming_) return;
+
   // agg_hash_table : AggregationHashTable
   ast::Expr *ht_type = codegen_->BuiltinType(ast::BuiltinType::Kind::AggregationHashTable);
   state_fields->emplace_back(codegen_->MakeField(agg_ht_, ht_type));
@@ -31,34 +122,82 @@ void AggregateBottomTranslator::InitializeStructs(util::RegionVector<ast::Decl *
   GenValuesStruct(decls);
 }
 
-// Create the key check function.
+// Create the key check and partial aggregate merge functions.
 void AggregateBottomTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  if (!MaySpill()) return;
   GenSingleKeyCheckFn(decls);
+  GenMergeFn(decls);
 }
 
-// Call @aggHTInit on the hash table
+// Call @aggHTInit on the hash table, or @aggInit on the aggregates if there is no GROUP BY
 void AggregateBottomTranslator::InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) {
+  if (is_global_) {
+    // @aggInit(&state.agg_term_i)
+    for (const auto &agg : global_aggs_) {
+      ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::AggInit, {codegen_->GetStateMemberPtr(agg)});
+      setup_stmts->emplace_back(codegen_->MakeStmt(init_call));
+    }
+    return;
+  }
+  if (is_streaming_) return;
   // @aggHTInit(&state.agg_hash_table, @execCtxGetMem(execCtx), @sizeOf(AggPayload))
   ast::Expr *init_call = codegen_->HTInitCall(ast::Builtin::AggHashTableInit, agg_ht_, payload_struct_);
   // Add it the setup statements
   setup_stmts->emplace_back(codegen_->MakeStmt(init_call));
+
+  if (is_dense_) {
+    // @aggHTSetDenseRange(&state.agg_hash_table, min_key, max_key)
+    std::vector<ast::Expr *> range_args{codegen_->GetStateMemberPtr(agg_ht_), codegen_->IntLiteral(dense_min_key_),
+                                        codegen_->IntLiteral(dense_max_key_)};
+    ast::Expr *range_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableSetDenseRange, std::move(range_args));
+    setup_stmts->emplace_back(codegen_->MakeStmt(range_call));
+  }
 }
 
 // Call @aggHTFree
 void AggregateBottomTranslator::InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) {
+  if (!UsesHashTable()) return;
   ast::Expr *free_call = codegen_->OneArgStateCall(ast::Builtin::AggHashTableFree, agg_ht_);
   teardown_stmts->emplace_back(codegen_->MakeStmt(free_call));
 }
 
-void AggregateBottomTranslator::Produce(FunctionBuilder *builder) { child_translator_->Produce(builder); }
+void AggregateBottomTranslator::Produce(FunctionBuilder *builder) {
+  if (!is_streaming_) {
+    child_translator_->Produce(builder);
+    return;
+  }
+  // var agg_payload : AggPayload
+  builder->Append(codegen_->DeclareVariable(agg_payload_, codegen_->MakeExpr(payload_struct_), nullptr));
+  // var agg_has_group = false
+  builder->Append(codegen_->DeclareVariable(has_group_, nullptr, codegen_->BoolLiteral(false)));
+  child_translator_->Produce(builder);
+  // Pass the last group, if any, to the parent once the input is exhausted
+  builder->StartIfStmt(codegen_->MakeExpr(has_group_));
+  parent_translator_->Consume(builder);
+  builder->FinishBlockStmt();
+}
 
 void AggregateBottomTranslator::Abort(FunctionBuilder *builder) { child_translator_->Abort(builder); }
 
 void AggregateBottomTranslator::Consume(FunctionBuilder *builder) {
   // Generate values to aggregate
   FillValues(builder);
-  // Hash Call
-  GenHashCall(builder);
+  if (is_global_) {
+    // Call @aggAdvance(&state.agg_term_i, &agg_values.agg_term_i) for each expression
+    for (uint32_t term_idx = 0; term_idx < global_aggs_.size(); term_idx++) {
+      ast::Expr *arg1 = codegen_->GetStateMemberPtr(global_aggs_[term_idx]);
+      ast::Expr *arg2 = GetAggTerm(agg_values_, term_idx, true);
+      builder->Append(codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::AggAdvance, {arg1, arg2})));
+    }
+    return;
+  }
+  if (is_streaming_) {
+    GenStreamingGroupSwitch(builder);
+    GenAdvance(builder);
+    return;
+  }
+  // Hash Call, unless the key is the slot
+  if (!is_dense_) GenHashCall(builder);
   // Make Lookup call
   GenLookupCall(builder);
   // Construct aggregates if needed
@@ -67,7 +206,77 @@ void AggregateBottomTranslator::Consume(FunctionBuilder *builder) {
   GenAdvance(builder);
 }
 
+bool AggregateBottomTranslator::ConsumesVectors() {
+  if (!is_global_) return false;
+  for (const auto &term : op_->GetAggregateTerms()) {
+    if (term->IsDistinct()) return false;
+    switch (term->GetExpressionType()) {
+      case terrier::parser::ExpressionType::AGGREGATE_COUNT:
+      case terrier::parser::ExpressionType::AGGREGATE_SUM:
+      case terrier::parser::ExpressionType::AGGREGATE_MIN:
+      case terrier::parser::ExpressionType::AGGREGATE_MAX:
+      case terrier::parser::ExpressionType::AGGREGATE_AVG:
+        break;
+      default:
+        return false;
+    }
+    // The term must read a numeric column of the scan as it is
+    uint16_t col_idx;
+    type::TypeId col_type;
+    if (!GetScanColumn(term->GetChild(0).Get(), &col_idx, &col_type)) return false;
+    switch (col_type) {
+      case type::TypeId::TINYINT:
+      case type::TypeId::SMALLINT:
+      case type::TypeId::INTEGER:
+      case type::TypeId::BIGINT:
+      case type::TypeId::DECIMAL:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+void AggregateBottomTranslator::ConsumeVector(FunctionBuilder *builder) {
+  ast::Expr *pci = codegen_->MakeExpr(*child_translator_->GetMaterializedTuple().first);
+  for (uint32_t term_idx = 0; term_idx < global_aggs_.size(); term_idx++) {
+    uint16_t col_idx;
+    type::TypeId col_type;
+    GetScanColumn(op_->GetAggregateTerms()[term_idx]->GetChild(0).Get(), &col_idx, &col_type);
+    // @aggAdvanceBatch(&state.agg_term_i, pci, col_idx, col_type)
+    std::vector<ast::Expr *> args{codegen_->GetStateMemberPtr(global_aggs_[term_idx]), pci,
+                                  codegen_->IntLiteral(col_idx), codegen_->IntLiteral(static_cast<int8_t>(col_type))};
+    builder->Append(codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::AggAdvanceBatch, std::move(args))));
+  }
+}
+
+// Generate @pciHashColumn(pci, key_col_idx, key_col_type, combine) for every grouping key
+void AggregateBottomTranslator::GenChildVectorHash(FunctionBuilder *builder) {
+  if (!HashesKeyVectors()) return;
+  dynamic_cast<SeqScanTranslator *>(child_translator_)->GenHashKeys(builder, GetGroupByKeys());
+}
+
+bool AggregateBottomTranslator::HashesKeyVectors() {
+  // Only the hash table hashes its keys
+  if (!UsesHashTable() || is_dense_) return false;
+  auto *scan = dynamic_cast<SeqScanTranslator *>(child_translator_);
+  return scan != nullptr && scan->CanHashKeys(GetGroupByKeys());
+}
+
+std::vector<const terrier::parser::AbstractExpression *> AggregateBottomTranslator::GetGroupByKeys() const {
+  std::vector<const terrier::parser::AbstractExpression *> keys;
+  for (const auto &term : op_->GetGroupByTerms()) {
+    keys.emplace_back(term.Get());
+  }
+  return keys;
+}
+
 ast::Expr *AggregateBottomTranslator::GetOutput(uint32_t attr_idx) {
+  // The aggregates without GROUP BY are in the state: @aggResult(&state.agg_term_i)
+  if (is_global_) {
+    return codegen_->BuiltinCall(ast::Builtin::AggResult, {codegen_->GetStateMemberPtr(global_aggs_[attr_idx])});
+  }
   // Either access a scalar group by term
   if (attr_idx < num_group_by_terms_) {
     return GetGroupByTerm(agg_payload_, attr_idx);
@@ -83,6 +292,12 @@ ast::Expr *AggregateBottomTranslator::GetChildOutput(uint32_t child_idx, uint32_
   return child_translator_->GetOutput(attr_idx);
 }
 
+bool AggregateBottomTranslator::GetScanColumn(const terrier::parser::AbstractExpression *term, uint16_t *col_idx,
+                                              type::TypeId *col_type) {
+  auto *scan = dynamic_cast<SeqScanTranslator *>(child_translator_);
+  return scan != nullptr && scan->GetColumnRef(term, col_idx, col_type);
+}
+
 ast::Expr *AggregateBottomTranslator::GetGroupByTerm(ast::Identifier object, uint32_t idx) {
   ast::Identifier member = codegen_->Context()->GetIdentifier(GROUP_BY_TERM_NAMES + std::to_string(idx));
   return codegen_->MemberExpr(object, member);
@@ -157,20 +372,33 @@ void AggregateBottomTranslator::GenValuesStruct(util::RegionVector<ast::Decl *>
 /*
  * Generate the key check logic
  */
-void AggregateBottomTranslator::GenKeyCheck(FunctionBuilder *builder) {
+void AggregateBottomTranslator::GenKeyCheck(FunctionBuilder *builder, ast::Identifier object) {
   // Compare group by terms one by one
   // Generate if (payload.term_i )
   for (uint32_t term_idx = 0; term_idx < op_->GetGroupByTerms().size(); term_idx++) {
-    ast::Expr *lhs = GetGroupByTerm(agg_payload_, term_idx);
-    ast::Expr *rhs = GetGroupByTerm(agg_values_, term_idx);
-    ast::Expr *cond = codegen_->Compare(parsing::Token::Type::BANG_EQUAL, lhs, rhs);
-    builder->StartIfStmt(cond);
+    builder->StartIfStmt(GenGroupByTermDistinct(agg_payload_, object, term_idx));
     builder->Append(codegen_->ReturnStmt(codegen_->BoolLiteral(false)));
     builder->FinishBlockStmt();
   }
   builder->Append(codegen_->ReturnStmt(codegen_->BoolLiteral(true)));
 }
 
+// (@sqlToBool(@isValNull(lhs.term_i)) != @sqlToBool(@isValNull(rhs.term_i)))
+//   or (!@sqlToBool(@isValNull(lhs.term_i)) and lhs.term_i != rhs.term_i)
+ast::Expr *AggregateBottomTranslator::GenGroupByTermDistinct(ast::Identifier lhs, ast::Identifier rhs,
+                                                             uint32_t term_idx) {
+  auto is_null = [&](ast::Identifier object) {
+    ast::Expr *sql_is_null = codegen_->OneArgCall(ast::Builtin::IsValNull, GetGroupByTerm(object, term_idx));
+    return codegen_->OneArgCall(ast::Builtin::SqlToBool, sql_is_null);
+  };
+  ast::Expr *nulls_differ = codegen_->Compare(parsing::Token::Type::BANG_EQUAL, is_null(lhs), is_null(rhs));
+  ast::Expr *lhs_not_null = codegen_->UnaryOp(parsing::Token::Type::BANG, is_null(lhs));
+  ast::Expr *ne = codegen_->Compare(parsing::Token::Type::BANG_EQUAL, GetGroupByTerm(lhs, term_idx),
+                                    GetGroupByTerm(rhs, term_idx));
+  ast::Expr *values_differ = codegen_->BinaryOp(parsing::Token::Type::AND, lhs_not_null, ne);
+  return codegen_->BinaryOp(parsing::Token::Type::OR, nulls_differ, values_differ);
+}
+
 /*
  * First declare var agg_values : AggValues
  * For each group by term, generate agg_values.term_i = group_by_term_i
@@ -203,7 +431,14 @@ void AggregateBottomTranslator::FillValues(FunctionBuilder *builder) {
 }
 
 // Generate var agg_payload = @ptrCast(*AggPayload, @aggHTLookup(&state.agg_ht, agg_hash_val, keyCheck, &agg_values))
+// or, if the key is the slot, var agg_payload = @ptrCast(*AggPayload, @aggHTLookupDense(&state.agg_ht, key))
 void AggregateBottomTranslator::GenLookupCall(FunctionBuilder *builder) {
+  if (is_dense_) {
+    std::vector<ast::Expr *> lookup_args{codegen_->GetStateMemberPtr(agg_ht_), GetGroupByTerm(agg_values_, 0)};
+    ast::Expr *lookup_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableLookupDense, std::move(lookup_args));
+    builder->Append(codegen_->DeclareVariable(agg_payload_, nullptr, codegen_->PtrCast(payload_struct_, lookup_call)));
+    return;
+  }
   // First create @aggHTLookup((&state.agg_ht, agg_hash_val, keyCheck, &agg_values)
   std::vector<ast::Expr *> lookup_args{codegen_->GetStateMemberPtr(agg_ht_), codegen_->MakeExpr(hash_val_),
                                        codegen_->MakeExpr(key_check_), codegen_->PointerTo(agg_values_)};
@@ -229,8 +464,15 @@ void AggregateBottomTranslator::GenConstruct(FunctionBuilder *builder) {
   builder->StartIfStmt(cond);
 
   // Set agg_payload = @ptrCast(*AggPayload, @aggHTInsert(&state.agg_table, agg_hash_val))
-  std::vector<ast::Expr *> insert_args{codegen_->GetStateMemberPtr(agg_ht_), codegen_->MakeExpr(hash_val_)};
-  ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableInsert, std::move(insert_args));
+  // or, if the key is the slot, @aggHTInsertDense(&state.agg_table, key)
+  ast::Expr *insert_call;
+  if (is_dense_) {
+    insert_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableInsertDense,
+                                        {codegen_->GetStateMemberPtr(agg_ht_), GetGroupByTerm(agg_values_, 0)});
+  } else {
+    std::vector<ast::Expr *> insert_args{codegen_->GetStateMemberPtr(agg_ht_), codegen_->MakeExpr(hash_val_)};
+    insert_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableInsert, std::move(insert_args));
+  }
   ast::Expr *cast_call = codegen_->PtrCast(payload_struct_, insert_call);
   builder->Append(codegen_->Assign(codegen_->MakeExpr(agg_payload_), cast_call));
 
@@ -264,6 +506,12 @@ void AggregateBottomTranslator::GenAdvance(FunctionBuilder *builder) {
 
 // Generate var agg_hash_val = @hash(groub_by_term1, group_by_term2, ...)
 void AggregateBottomTranslator::GenHashCall(FunctionBuilder *builder) {
+  if (HashesKeyVectors()) {
+    // var agg_hash_val = @pciGetHash(pci)
+    ast::Expr *pci = codegen_->MakeExpr(*child_translator_->GetMaterializedTuple().first);
+    builder->Append(codegen_->DeclareVariable(hash_val_, nullptr, codegen_->OneArgCall(ast::Builtin::PCIGetHash, pci)));
+    return;
+  }
   // Create the @hash(group_by_term1, group_by_term2, ...) call
   std::vector<ast::Expr *> hash_args{};
   for (uint32_t term_idx = 0; term_idx < op_->GetGroupByTerms().size(); term_idx++) {
@@ -290,17 +538,113 @@ void AggregateBottomTranslator::GenSingleKeyCheckFn(util::RegionVector<terrier::
   ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Bool);
   FunctionBuilder builder(codegen_, key_check_, std::move(params), ret_type);
   // Fill up the function
-  GenKeyCheck(&builder);
+  GenKeyCheck(&builder, agg_values_);
   // Add it to top level declarations
   decls->emplace_back(builder.Finish());
 }
 
+// fun aggMergeKeyCheckFn(agg_payload: *AggPayload, agg_partial: *AggPayload) -> bool {...}
+// fun aggMergeFn(state: *State, agg_part_ht: *AggregationHashTable, agg_part_iter: *AggOverflowPartIter) -> nil {
+//   for (; @aggPartIterHasNext(agg_part_iter); @aggPartIterNext(agg_part_iter)) {
+//     var hash_val = @aggPartIterGetHash(agg_part_iter)
+//     var agg_partial = @ptrCast(*AggPayload, @aggPartIterGetRow(agg_part_iter))
+//     var agg_payload = @ptrCast(*AggPayload, @aggHTLookup(agg_part_ht, hash_val, aggMergeKeyCheckFn, agg_partial))
+//     if (agg_payload == nil) { agg_payload = @ptrCast(*AggPayload, @aggHTInsert(agg_part_ht, hash_val)); ... }
+//     @aggMerge(&agg_payload.agg_term_i, &agg_partial.agg_term_i)
+//   }
+// }
+void AggregateBottomTranslator::GenMergeFn(util::RegionVector<ast::Decl *> *decls) {
+  {
+    util::RegionVector<ast::FieldDecl *> params(
+        {codegen_->MakeField(agg_payload_, codegen_->PointerType(payload_struct_)),
+         codegen_->MakeField(agg_partial_, codegen_->PointerType(payload_struct_))},
+        codegen_->Region());
+    FunctionBuilder builder(codegen_, merge_key_check_, std::move(params),
+                            codegen_->BuiltinType(ast::BuiltinType::Kind::Bool));
+    GenKeyCheck(&builder, agg_partial_);
+    decls->emplace_back(builder.Finish());
+  }
+
+  ast::Expr *ht_type = codegen_->PointerType(codegen_->BuiltinType(ast::BuiltinType::AggregationHashTable));
+  ast::Expr *iter_type = codegen_->PointerType(codegen_->BuiltinType(ast::BuiltinType::AggOverflowPartIter));
+  util::RegionVector<ast::FieldDecl *> params(
+      {codegen_->MakeField(codegen_->GetStateVar(), codegen_->PointerType(codegen_->GetStateType())),
+       codegen_->MakeField(part_ht_, ht_type), codegen_->MakeField(part_iter_, iter_type)},
+      codegen_->Region());
+  FunctionBuilder builder(codegen_, merge_fn_, std::move(params), codegen_->BuiltinType(ast::BuiltinType::Kind::Nil));
+  ast::Expr *has_next_call = codegen_->OneArgCall(ast::Builtin::AggPartIterHasNext, part_iter_, false);
+  ast::Stmt *next_stmt = codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::AggPartIterNext, part_iter_, false));
+  builder.StartForStmt(nullptr, has_next_call, next_stmt);
+  {
+    ast::Expr *hash_call = codegen_->OneArgCall(ast::Builtin::AggPartIterGetHash, part_iter_, false);
+    builder.Append(codegen_->DeclareVariable(hash_val_, nullptr, hash_call));
+    ast::Expr *row_call = codegen_->OneArgCall(ast::Builtin::AggPartIterGetRow, part_iter_, false);
+    builder.Append(codegen_->DeclareVariable(agg_partial_, nullptr, codegen_->PtrCast(payload_struct_, row_call)));
+
+    std::vector<ast::Expr *> lookup_args{codegen_->MakeExpr(part_ht_), codegen_->MakeExpr(hash_val_),
+                                         codegen_->MakeExpr(merge_key_check_), codegen_->MakeExpr(agg_partial_)};
+    ast::Expr *lookup_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableLookup, std::move(lookup_args));
+    builder.Append(codegen_->DeclareVariable(agg_payload_, nullptr, codegen_->PtrCast(payload_struct_, lookup_call)));
+
+    // Start a group for the first partial aggregate of its key
+    ast::Expr *is_new = codegen_->Compare(parsing::Token::Type::EQUAL_EQUAL, codegen_->NilLiteral(),
+                                          codegen_->MakeExpr(agg_payload_));
+    builder.StartIfStmt(is_new);
+    std::vector<ast::Expr *> insert_args{codegen_->MakeExpr(part_ht_), codegen_->MakeExpr(hash_val_)};
+    ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableInsert, std::move(insert_args));
+    builder.Append(codegen_->Assign(codegen_->MakeExpr(agg_payload_), codegen_->PtrCast(payload_struct_, insert_call)));
+    for (uint32_t term_idx = 0; term_idx < num_group_by_terms_; term_idx++) {
+      builder.Append(codegen_->Assign(GetGroupByTerm(agg_payload_, term_idx), GetGroupByTerm(agg_partial_, term_idx)));
+    }
+    for (uint32_t term_idx = 0; term_idx < op_->GetAggregateTerms().size(); term_idx++) {
+      ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::AggInit, {GetAggTerm(agg_payload_, term_idx, true)});
+      builder.Append(codegen_->MakeStmt(init_call));
+    }
+    builder.FinishBlockStmt();
+
+    for (uint32_t term_idx = 0; term_idx < op_->GetAggregateTerms().size(); term_idx++) {
+      ast::Expr *merge_call = codegen_->BuiltinCall(
+          ast::Builtin::AggMerge, {GetAggTerm(agg_payload_, term_idx, true), GetAggTerm(agg_partial_, term_idx, true)});
+      builder.Append(codegen_->MakeStmt(merge_call));
+    }
+  }
+  builder.FinishBlockStmt();
+  decls->emplace_back(builder.Finish());
+}
+
+void AggregateBottomTranslator::GenStreamingGroupSwitch(FunctionBuilder *builder) {
+  // if (agg_has_group) { if (agg_payload.term_i IS DISTINCT FROM agg_values.term_i) { agg_has_group = false } ... }
+  builder->StartIfStmt(codegen_->MakeExpr(has_group_));
+  for (uint32_t term_idx = 0; term_idx < num_group_by_terms_; term_idx++) {
+    builder->StartIfStmt(GenGroupByTermDistinct(agg_payload_, agg_values_, term_idx));
+    builder->Append(codegen_->Assign(codegen_->MakeExpr(has_group_), codegen_->BoolLiteral(false)));
+    builder->FinishBlockStmt();
+  }
+  // The group is complete, pass it to the parent
+  builder->StartIfStmt(codegen_->UnaryOp(parsing::Token::Type::BANG, codegen_->MakeExpr(has_group_)));
+  parent_translator_->Consume(builder);
+  builder->FinishBlockStmt();
+  builder->FinishBlockStmt();
+
+  // if (!agg_has_group) { agg_payload.term_i = agg_values.term_i; @aggInit(&agg_payload.expr_i); ... }
+  builder->StartIfStmt(codegen_->UnaryOp(parsing::Token::Type::BANG, codegen_->MakeExpr(has_group_)));
+  for (uint32_t term_idx = 0; term_idx < num_group_by_terms_; term_idx++) {
+    builder->Append(codegen_->Assign(GetGroupByTerm(agg_payload_, term_idx), GetGroupByTerm(agg_values_, term_idx)));
+  }
+  for (uint32_t term_idx = 0; term_idx < op_->GetAggregateTerms().size(); term_idx++) {
+    ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::AggInit, {GetAggTerm(agg_payload_, term_idx, true)});
+    builder->Append(codegen_->MakeStmt(init_call));
+  }
+  builder->Append(codegen_->Assign(codegen_->MakeExpr(has_group_), codegen_->BoolLiteral(true)));
+  builder->FinishBlockStmt();
+}
+
 ///////////////////////////////////////////////
 ///// Top Translator
 ///////////////////////////////////////////////
 
 void AggregateTopTranslator::Produce(FunctionBuilder *builder) {
-  DeclareIterator(builder);
+  if (bottom_->UsesHashTable()) DeclareIterator(builder);
   // In case of nested loop joins, let the child produce
   if (child_translator_ != nullptr) {
     child_translator_->Produce(builder);
@@ -311,7 +655,33 @@ void AggregateTopTranslator::Produce(FunctionBuilder *builder) {
 }
 
 void AggregateTopTranslator::Consume(FunctionBuilder *builder) {
-  GenHTLoop(builder);
+  // Without GROUP BY, there is exactly one group, even if the input is empty. Streaming
+  // aggregations call this once per group.
+  if (!bottom_->UsesHashTable()) {
+    bool has_having = GenHaving(builder);
+    parent_translator_->Consume(builder);
+    if (has_having) {
+      builder->FinishBlockStmt();
+    }
+    return;
+  }
+  // The groups of a table that spilled are merged one partition at a time, after which the table is empty
+  // for (@aggHTNextSpilledPart(&state.agg_ht, state, aggMergeFn)) { scan @aggHTGetSpilledPart(&state.agg_ht) }
+  if (bottom_->MaySpill()) {
+    std::vector<ast::Expr *> next_args{codegen_->GetStateMemberPtr(bottom_->agg_ht_),
+                                       codegen_->MakeExpr(codegen_->GetStateVar()),
+                                       codegen_->MakeExpr(bottom_->merge_fn_)};
+    ast::Expr *next_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableNextSpilledPartition, std::move(next_args));
+    builder->StartForStmt(nullptr, next_call, nullptr);
+    GenHTScan(builder, codegen_->OneArgCall(ast::Builtin::AggHashTableGetSpilledPartition,
+                                            codegen_->GetStateMemberPtr(bottom_->agg_ht_)));
+    builder->FinishBlockStmt();
+  }
+  GenHTScan(builder, codegen_->GetStateMemberPtr(bottom_->agg_ht_));
+}
+
+void AggregateTopTranslator::GenHTScan(FunctionBuilder *builder, ast::Expr *agg_ht) {
+  GenHTLoop(builder, agg_ht);
   DeclareResult(builder);
   bool has_having = GenHaving(builder);
   parent_translator_->Consume(builder);
@@ -328,7 +698,7 @@ void AggregateTopTranslator::Consume(FunctionBuilder *builder) {
 
 void AggregateTopTranslator::Abort(FunctionBuilder *builder) {
   // Close iterator
-  CloseIterator(builder);
+  if (bottom_->UsesHashTable()) CloseIterator(builder);
   if (child_translator_ != nullptr) child_translator_->Abort(builder);
 }
 
@@ -349,10 +719,10 @@ void AggregateTopTranslator::DeclareIterator(FunctionBuilder *builder) {
   builder->Append(codegen_->DeclareVariable(agg_iterator_, iter_type, nullptr));
 }
 
-// for (@aggHTIterInit(&agg_iter, &state.table); @aggHTIterHasNext(&agg_iter); @aggHTIterNext(&agg_iter)) {...}
-void AggregateTopTranslator::GenHTLoop(FunctionBuilder *builder) {
+// for (@aggHTIterInit(&agg_iter, agg_ht); @aggHTIterHasNext(&agg_iter); @aggHTIterNext(&agg_iter)) {...}
+void AggregateTopTranslator::GenHTLoop(FunctionBuilder *builder, ast::Expr *agg_ht) {
   // Loop Initialization
-  std::vector<ast::Expr *> init_args{codegen_->PointerTo(agg_iterator_), codegen_->GetStateMemberPtr(bottom_->agg_ht_)};
+  std::vector<ast::Expr *> init_args{codegen_->PointerTo(agg_iterator_), agg_ht};
   ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableIterInit, std::move(init_args));
   ast::Stmt *loop_init = codegen_->MakeStmt(init_call);
   // Loop condition
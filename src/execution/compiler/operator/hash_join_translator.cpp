@@ -3,7 +3,10 @@
 #include <utility>
 #include <vector>
 #include "execution/compiler/function_builder.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/translator_factory.h"
+#include "execution/exec/execution_context.h"
+#include "parser/expression/derived_value_expression.h"
 #include "planner/plannodes/hash_join_plan_node.h"
 
 namespace terrier::execution::compiler {
@@ -14,7 +17,8 @@ HashJoinLeftTranslator::HashJoinLeftTranslator(const terrier::planner::HashJoinP
       hash_val_{codegen->NewIdentifier("hash_val")},
       build_struct_{codegen->NewIdentifier("BuildRow")},
       build_row_{codegen->NewIdentifier("build_row")},
-      join_ht_{codegen->NewIdentifier("join_ht")} {}
+      join_ht_{codegen->NewIdentifier("join_ht")},
+      match_{codegen->Context()->GetIdentifier(MATCH_NAME)} {}
 
 void HashJoinLeftTranslator::Produce(FunctionBuilder *builder) {
   // Produce the rest of the pipeline
@@ -32,6 +36,10 @@ void HashJoinLeftTranslator::Consume(FunctionBuilder *builder) {
   GenHTInsert(builder);
   // Fill up the build row
   FillBuildRow(builder);
+  // No probe tuple matched the build row yet
+  if (HasMatchFlag()) {
+    builder->Append(codegen_->Assign(GetMatchFlag(), codegen_->BoolLiteral(false)));
+  }
 }
 
 // Declare the hash table
@@ -46,6 +54,10 @@ void HashJoinLeftTranslator::InitializeStructs(util::RegionVector<ast::Decl *> *
   util::RegionVector<ast::FieldDecl *> fields{codegen_->Region()};
   // Add child output columns
   GetChildOutputFields(&fields, LEFT_ATTR_NAME);
+  // Add the flag recording whether a probe tuple matched the row
+  if (HasMatchFlag()) {
+    fields.emplace_back(codegen_->MakeField(match_, codegen_->BuiltinType(ast::BuiltinType::Kind::Bool)));
+  }
   // Make the struct
   decls->emplace_back(codegen_->MakeStruct(build_struct_, std::move(fields)));
 }
@@ -56,6 +68,30 @@ void HashJoinLeftTranslator::InitializeSetup(util::RegionVector<ast::Stmt *> *se
   ast::Expr *init_call = codegen_->HTInitCall(ast::Builtin::JoinHashTableInit, join_ht_, build_struct_);
   // Add it the setup statements
   setup_stmts->emplace_back(codegen_->MakeStmt(init_call));
+  // @joinHTEnableBloomFilter(&state.join_table)
+  if (UseBloomFilter()) {
+    ast::Expr *enable_call = codegen_->OneArgStateCall(ast::Builtin::JoinHashTableEnableBloomFilter, join_ht_);
+    setup_stmts->emplace_back(codegen_->MakeStmt(enable_call));
+  }
+}
+
+bool HashJoinLeftTranslator::UseBloomFilter() const {
+  // Joins that output unmatched probe tuples cannot filter them out, and joins that output unmatched build rows
+  // materialize their probe tuples. Only sequential scans probe with vectors of tuples they can filter before probing.
+  const auto join_type = op_->GetLogicalJoinType();
+  return (join_type == planner::LogicalJoinType::INNER || join_type == planner::LogicalJoinType::SEMI) &&
+         op_->GetChild(1)->GetPlanNodeType() == planner::PlanNodeType::SEQSCAN;
+}
+
+bool HashJoinLeftTranslator::HasMatchFlag() const {
+  const auto join_type = op_->GetLogicalJoinType();
+  return join_type == planner::LogicalJoinType::SEMI || EmitsUnmatchedBuildRows();
+}
+
+bool HashJoinLeftTranslator::EmitsUnmatchedBuildRows() const {
+  const auto join_type = op_->GetLogicalJoinType();
+  return join_type == planner::LogicalJoinType::LEFT || join_type == planner::LogicalJoinType::OUTER ||
+         join_type == planner::LogicalJoinType::ANTI;
 }
 
 // Call @joinHTFree on the hash table
@@ -68,6 +104,19 @@ void HashJoinLeftTranslator::InitializeTeardown(util::RegionVector<ast::Stmt *>
 void HashJoinLeftTranslator::GenBuildCall(FunctionBuilder *builder) {
   ast::Expr *build_call = codegen_->OneArgStateCall(ast::Builtin::JoinHashTableBuild, join_ht_);
   builder->Append(codegen_->MakeStmt(build_call));
+  GenReportBuildRows(builder);
+}
+
+// Call @execCtxReportRows(execCtx, probe_id, @joinHTGetTupleCount(&state.join_hash_table))
+void HashJoinLeftTranslator::GenReportBuildRows(FunctionBuilder *builder) {
+  // The build is a pipeline breaker, so the whole build side has been counted by now. The optimizer learns its size
+  // to plan the join better the next time.
+  const auto *build_child = op_->GetChild(0);
+  if (build_child->GetFragmentKey() == 0) return;
+  const uint32_t probe_id =
+      codegen_->AddCardinalityProbe(build_child->GetFragmentKey(), build_child->GetEstimatedRows());
+  ast::Expr *count_call = codegen_->OneArgStateCall(ast::Builtin::JoinHashTableGetTupleCount, join_ht_);
+  builder->Append(codegen_->MakeStmt(codegen_->ExecCtxReportRows(probe_id, count_call)));
 }
 
 // Declare var hash_val = @hash(join_keys)
@@ -113,6 +162,8 @@ ast::Expr *HashJoinLeftTranslator::GetBuildValue(uint32_t idx) {
   return codegen_->MemberExpr(build_row_, member);
 }
 
+ast::Expr *HashJoinLeftTranslator::GetMatchFlag() { return codegen_->MemberExpr(build_row_, match_); }
+
 ast::Expr *HashJoinLeftTranslator::GetOutput(uint32_t attr_idx) { return GetBuildValue(attr_idx); }
 
 ast::Expr *HashJoinLeftTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) {
@@ -133,13 +184,23 @@ HashJoinRightTranslator::HashJoinRightTranslator(const terrier::planner::HashJoi
       probe_struct_{codegen->NewIdentifier("ProbeRow")},
       probe_row_{codegen->NewIdentifier("probe_row")},
       key_check_{codegen->NewIdentifier("joinKeyCheckFn")},
-      join_iter_{codegen->NewIdentifier("join_iter")} {}
+      spilled_key_check_{codegen->NewIdentifier("spilledKeyCheckFn")},
+      probe_hash_fn_{codegen->NewIdentifier("probeHashFn")},
+      join_iter_{codegen->NewIdentifier("join_iter")},
+      entry_iter_{codegen->NewIdentifier("entry_iter")},
+      matched_{codegen->NewIdentifier("matched")} {}
 
 void HashJoinRightTranslator::Produce(FunctionBuilder *builder) {
   // Declare the iterator
   DeclareIterator(builder);
   // Let right child produce its code
   child_translator_->Produce(builder);
+  // Once all the probe tuples went through, output the build rows none of them matched
+  if (left_->EmitsUnmatchedBuildRows()) {
+    GenUnmatchedBuildLoop(builder);
+  }
+  // Join the partitions that did not fit in memory
+  GenSpilledPartitionLoop(builder);
   // Close iterator
   GenIteratorClose(builder);
 }
@@ -151,20 +212,186 @@ void HashJoinRightTranslator::Abort(FunctionBuilder *builder) {
 }
 
 void HashJoinRightTranslator::Consume(FunctionBuilder *builder) {
+  // Materialize the probe tuple if necessary. The hash value reads the join keys from it.
+  if (!is_child_materializer_) {
+    DeclareProbeRow(builder);
+    FillProbeRow(builder);
+  }
   // Create the right hash_value
   GenHashValue(builder);
-  // Materialize the probe tuple if necessary.
-  if (!is_child_materializer_) {
+  // The build rows of a spilled partition are not in memory, so its probe tuples are spilled next to them
+  // if (@joinHTIsPartitionSpilled(&state.join_ht, hash_val)) { spill } else { probe }
+  std::vector<ast::Expr *> spilled_args{codegen_->GetStateMemberPtr(left_->join_ht_), codegen_->MakeExpr(hash_val_)};
+  builder->StartIfElseStmt(
+      codegen_->BuiltinCall(ast::Builtin::JoinHashTableIsPartitionSpilled, std::move(spilled_args)));
+  GenSpillProbeRow(builder);
+  builder->StartElseBlock();
+  GenProbe(builder, key_check_, GetProbeTuple());
+  builder->FinishBlockStmt();
+}
+
+ast::Expr *HashJoinRightTranslator::GetProbeTuple() {
+  if (is_child_materializer_) {
+    // If the child is a materializer, directly use its tuple as a probe.
+    auto child_tuple = child_translator_->GetMaterializedTuple();
+    TERRIER_ASSERT(child_tuple.first != nullptr && child_tuple.second != nullptr, "Materialize should have output");
+    return is_child_ptr_ ? codegen_->MakeExpr(*child_tuple.first) : codegen_->PointerTo(*child_tuple.first);
+  }
+  // Otherwise use the constructed probe row.
+  return codegen_->PointerTo(probe_row_);
+}
+
+// @joinHTSpillProbe(&state.join_ht, hash_val, &probe_row, @sizeOf(ProbeRow))
+void HashJoinRightTranslator::GenSpillProbeRow(FunctionBuilder *builder) {
+  // A materialized child tuple is copied into a probe row first
+  if (is_child_materializer_) {
+    probe_from_row_ = true;
+    DeclareProbeRow(builder);
     FillProbeRow(builder);
+    probe_from_row_ = false;
+  }
+  std::vector<ast::Expr *> spill_args{codegen_->GetStateMemberPtr(left_->join_ht_), codegen_->MakeExpr(hash_val_),
+                                      codegen_->PointerTo(probe_row_), codegen_->SizeOf(probe_struct_)};
+  ast::Expr *spill_call = codegen_->BuiltinCall(ast::Builtin::JoinHashTableSpillProbe, std::move(spill_args));
+  builder->Append(codegen_->MakeStmt(spill_call));
+}
+
+void HashJoinRightTranslator::GenProbe(FunctionBuilder *builder, ast::Identifier key_check, ast::Expr *probe_tuple) {
+  // var matched = false
+  if (EmitsUnmatchedProbeRows()) {
+    builder->Append(codegen_->DeclareVariable(matched_, nullptr, codegen_->BoolLiteral(false)));
   }
   // Generate the probe loop
-  GenProbeLoop(builder);
+  GenProbeLoop(builder, key_check, probe_tuple);
   // Get the matching tuple
   DeclareMatch(builder);
-  // Let the parent consume
-  parent_translator_->Consume(builder);
+  // Record the match, and let the parent consume
+  GenMatch(builder);
   // Close Loop
   builder->FinishBlockStmt();
+  // Output the probe tuple with NULL build attributes if nothing matched it
+  if (EmitsUnmatchedProbeRows()) {
+    GenUnmatchedProbeRow(builder);
+  }
+}
+
+// for (@joinHTNextSpilledPartition(&state.join_ht, include_unprobed)) {
+//   for (@joinHTNextSpilledProbe(&state.join_ht)) {
+//     var probe_row = @ptrCast(*ProbeRow, @joinHTGetSpilledProbe(&state.join_ht))
+//     var hash_val = @hash(right_join_keys)
+//     probe
+//   }
+//   unmatched build rows
+// }
+void HashJoinRightTranslator::GenSpilledPartitionLoop(FunctionBuilder *builder) {
+  // Partitions without probe tuples only matter to joins that output unmatched build rows
+  std::vector<ast::Expr *> next_partition_args{codegen_->GetStateMemberPtr(left_->join_ht_),
+                                               codegen_->BoolLiteral(left_->EmitsUnmatchedBuildRows())};
+  builder->StartForStmt(
+      nullptr, codegen_->BuiltinCall(ast::Builtin::JoinHashTableNextSpilledPartition, std::move(next_partition_args)),
+      nullptr);
+
+  probe_from_row_ = true;
+  ast::Expr *next_probe_call =
+      codegen_->OneArgCall(ast::Builtin::JoinHashTableNextSpilledProbe, codegen_->GetStateMemberPtr(left_->join_ht_));
+  builder->StartForStmt(nullptr, next_probe_call, nullptr);
+  ast::Expr *get_probe_call =
+      codegen_->OneArgCall(ast::Builtin::JoinHashTableGetSpilledProbe, codegen_->GetStateMemberPtr(left_->join_ht_));
+  builder->Append(codegen_->DeclareVariable(probe_row_, nullptr, codegen_->PtrCast(probe_struct_, get_probe_call)));
+  builder->Append(codegen_->DeclareVariable(hash_val_, nullptr, GenHashCall()));
+  GenProbe(builder, is_child_materializer_ ? spilled_key_check_ : key_check_, codegen_->MakeExpr(probe_row_));
+  builder->FinishBlockStmt();
+  probe_from_row_ = false;
+
+  if (left_->EmitsUnmatchedBuildRows()) {
+    GenUnmatchedBuildLoop(builder);
+  }
+  builder->FinishBlockStmt();
+}
+
+bool HashJoinRightTranslator::EmitsUnmatchedProbeRows() const {
+  const auto join_type = op_->GetLogicalJoinType();
+  return join_type == planner::LogicalJoinType::RIGHT || join_type == planner::LogicalJoinType::OUTER;
+}
+
+void HashJoinRightTranslator::GenMatch(FunctionBuilder *builder) {
+  if (EmitsUnmatchedProbeRows()) {
+    // matched = true
+    builder->Append(codegen_->Assign(codegen_->MakeExpr(matched_), codegen_->BoolLiteral(true)));
+  }
+  switch (op_->GetLogicalJoinType()) {
+    case planner::LogicalJoinType::SEMI: {
+      // Output each build row once, on its first match
+      // if (!build_row.match) { build_row.match = true; ... }
+      builder->StartIfStmt(codegen_->UnaryOp(parsing::Token::Type::BANG, left_->GetMatchFlag()));
+      builder->Append(codegen_->Assign(left_->GetMatchFlag(), codegen_->BoolLiteral(true)));
+      parent_translator_->Consume(builder);
+      builder->FinishBlockStmt();
+      return;
+    }
+    case planner::LogicalJoinType::ANTI: {
+      // Matched build rows are never output
+      builder->Append(codegen_->Assign(left_->GetMatchFlag(), codegen_->BoolLiteral(true)));
+      return;
+    }
+    case planner::LogicalJoinType::LEFT:
+    case planner::LogicalJoinType::OUTER: {
+      builder->Append(codegen_->Assign(left_->GetMatchFlag(), codegen_->BoolLiteral(true)));
+      break;
+    }
+    default:
+      break;
+  }
+  parent_translator_->Consume(builder);
+}
+
+// if (!matched) { var build_row: BuildRow; @initSqlNull(&build_row.left_attr0); ...; parent consume }
+void HashJoinRightTranslator::GenUnmatchedProbeRow(FunctionBuilder *builder) {
+  builder->StartIfStmt(codegen_->UnaryOp(parsing::Token::Type::BANG, codegen_->MakeExpr(matched_)));
+  builder->Append(codegen_->DeclareVariable(left_->build_row_, codegen_->MakeExpr(left_->build_struct_), nullptr));
+  for (uint32_t attr_idx = 0; attr_idx < op_->GetChild(0)->GetOutputSchema()->GetColumns().size(); attr_idx++) {
+    GenInitNull(builder, left_->GetBuildValue(attr_idx));
+  }
+  parent_translator_->Consume(builder);
+  builder->FinishBlockStmt();
+}
+
+// for (@joinHTEntryIterInit(&entry_iter, &state.join_ht); @joinHTEntryIterHasNext(&entry_iter);
+//      @joinHTEntryIterNext(&entry_iter)) {
+//   var build_row = @ptrCast(*BuildRow, @joinHTEntryIterGetRow(&entry_iter))
+//   if (!build_row.match) { var probe_row: ProbeRow; @initSqlNull(&probe_row.right_attr0); ...; parent consume }
+// }
+void HashJoinRightTranslator::GenUnmatchedBuildLoop(FunctionBuilder *builder) {
+  ast::Expr *iter_type = codegen_->BuiltinType(ast::BuiltinType::Kind::JoinHashTableEntryIterator);
+  builder->Append(codegen_->DeclareVariable(entry_iter_, iter_type, nullptr));
+
+  std::vector<ast::Expr *> init_args{codegen_->PointerTo(entry_iter_), codegen_->GetStateMemberPtr(left_->join_ht_)};
+  ast::Stmt *loop_init =
+      codegen_->MakeStmt(codegen_->BuiltinCall(ast::Builtin::JoinHashTableEntryIterInit, std::move(init_args)));
+  ast::Expr *has_next_call = codegen_->OneArgCall(ast::Builtin::JoinHashTableEntryIterHasNext, entry_iter_, true);
+  ast::Stmt *loop_next =
+      codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::JoinHashTableEntryIterNext, entry_iter_, true));
+  builder->StartForStmt(loop_init, has_next_call, loop_next);
+
+  ast::Expr *get_row_call = codegen_->OneArgCall(ast::Builtin::JoinHashTableEntryIterGetRow, entry_iter_, true);
+  ast::Expr *cast_call = codegen_->PtrCast(left_->build_struct_, get_row_call);
+  builder->Append(codegen_->DeclareVariable(left_->build_row_, nullptr, cast_call));
+
+  builder->StartIfStmt(codegen_->UnaryOp(parsing::Token::Type::BANG, left_->GetMatchFlag()));
+  DeclareProbeRow(builder);
+  for (uint32_t attr_idx = 0; attr_idx < op_->GetChild(1)->GetOutputSchema()->GetColumns().size(); attr_idx++) {
+    GenInitNull(builder, GetProbeValue(attr_idx));
+  }
+  parent_translator_->Consume(builder);
+  builder->FinishBlockStmt();
+
+  builder->FinishBlockStmt();
+}
+
+// @initSqlNull(&attr)
+void HashJoinRightTranslator::GenInitNull(FunctionBuilder *builder, ast::Expr *attr) {
+  ast::Expr *init_call = codegen_->OneArgCall(ast::Builtin::InitSqlNull, codegen_->PointerTo(attr));
+  builder->Append(codegen_->MakeStmt(init_call));
 }
 
 ast::Expr *HashJoinRightTranslator::GetOutput(uint32_t attr_idx) {
@@ -186,7 +413,7 @@ ast::Expr *HashJoinRightTranslator::GetChildOutput(uint32_t child_idx, uint32_t
 
 ast::Expr *HashJoinRightTranslator::GetProbeValue(uint32_t idx) {
   // If the right child is a materializer, get its output.
-  if (is_child_materializer_) {
+  if (is_child_materializer_ && !probe_from_row_) {
     return child_translator_->GetOutput(idx);
   }
   // Otherwise get the attribute from the probe row.
@@ -194,12 +421,9 @@ ast::Expr *HashJoinRightTranslator::GetProbeValue(uint32_t idx) {
   return codegen_->MemberExpr(probe_row_, member);
 }
 
-// Make the probe struct if necessary.
+// Make the probe struct. Even if the child already materialized its tuple, spilled probe tuples are copied into it.
 void HashJoinRightTranslator::InitializeStructs(util::RegionVector<ast::Decl *> *decls) {
-  // If the child already materialized it's tuple, do nothing
-  if (is_child_materializer_) return;
-
-  // Otherwise let the struct have a field for each right child attribute.
+  // Let the struct have a field for each right child attribute.
   util::RegionVector<ast::FieldDecl *> fields{codegen_->Region()};
   GetChildOutputFields(&fields, RIGHT_ATTR_NAME);
   decls->emplace_back(codegen_->MakeStruct(probe_struct_, std::move(fields)));
@@ -215,7 +439,8 @@ void HashJoinRightTranslator::InitializeHelperFunctions(util::RegionVector<ast::
 
   // Then make probe_row: *ProbeRow depending on whether the previous operator is a materializer.
   ast::FieldDecl *param2;
-  is_child_materializer_ = child_translator_->IsMaterializer(&is_child_ptr_);
+  // Joins that output unmatched build rows need a probe row they can fill with NULLs
+  is_child_materializer_ = !left_->EmitsUnmatchedBuildRows() && child_translator_->IsMaterializer(&is_child_ptr_);
   if (is_child_materializer_) {
     // Use the previous tuple's name and type
     auto prev_tuple = child_translator_->GetMaterializedTuple();
@@ -241,6 +466,58 @@ void HashJoinRightTranslator::InitializeHelperFunctions(util::RegionVector<ast::
   GenKeyCheck(&builder);
   // Add it to top level declarations
   decls->emplace_back(builder.Finish());
+
+  // The key check of spilled probe tuples reads them from a ProbeRow instead of the materialized child tuple
+  if (is_child_materializer_) {
+    util::RegionVector<ast::FieldDecl *> spilled_params(
+        {codegen_->MakeField(state_variable, codegen_->PointerType(codegen_->GetStateType())),
+         codegen_->MakeField(probe_row_, codegen_->PointerType(probe_struct_)),
+         codegen_->MakeField(left_->build_row_, codegen_->PointerType(left_->build_struct_))},
+        codegen_->Region());
+    FunctionBuilder spilled_builder(codegen_, spilled_key_check_, std::move(spilled_params),
+                                    codegen_->BuiltinType(ast::BuiltinType::Kind::Bool));
+    probe_from_row_ = true;
+    GenKeyCheck(&spilled_builder);
+    probe_from_row_ = false;
+    decls->emplace_back(spilled_builder.Finish());
+  }
+
+  // Declare the function hashing probe tuples in the bloom filter
+  if (left_->UseBloomFilter()) {
+    GenProbeHashFn(decls);
+  }
+}
+
+// Declare fn probeHashFn(pci: *ProjectedColumnsIterator) -> uint64 { return @hash(right_join_keys) }
+void HashJoinRightTranslator::GenProbeHashFn(util::RegionVector<ast::Decl *> *decls) {
+  // The parameter uses the child's name for its vector of tuples, so the join keys can be derived as usual
+  auto child_tuple = child_translator_->GetMaterializedTuple();
+  TERRIER_ASSERT(is_child_materializer_ && is_child_ptr_, "Probe side scan should materialize its tuples");
+  ast::Expr *pci_type = codegen_->PointerType(*child_tuple.second);
+  util::RegionVector<ast::FieldDecl *> params({codegen_->MakeField(*child_tuple.first, pci_type)}, codegen_->Region());
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Uint64);
+
+  FunctionBuilder builder(codegen_, probe_hash_fn_, std::move(params), ret_type);
+  builder.Append(codegen_->ReturnStmt(GenHashCall()));
+  decls->emplace_back(builder.Finish());
+}
+
+// Generate @pciHashColumn(pci, key_col_idx, key_col_type, combine) for every probe key
+void HashJoinRightTranslator::GenChildVectorHash(FunctionBuilder *builder) {
+  if (!HashesKeyVectors()) return;
+  dynamic_cast<SeqScanTranslator *>(child_translator_)->GenHashKeys(builder, GetProbeKeys());
+}
+
+// Generate @joinHTFilterProbe(&state.join_table, pci, probeHashFn), which reuses the hashes of the probe keys if they
+// were already hashed a vector at a time
+bool HashJoinRightTranslator::GenChildVectorFilter(FunctionBuilder *builder) {
+  if (!left_->UseBloomFilter()) return false;
+  auto child_tuple = child_translator_->GetMaterializedTuple();
+  std::vector<ast::Expr *> filter_args{codegen_->GetStateMemberPtr(left_->join_ht_),
+                                       codegen_->MakeExpr(*child_tuple.first), codegen_->MakeExpr(probe_hash_fn_)};
+  ast::Expr *filter_call = codegen_->BuiltinCall(ast::Builtin::JoinHashTableFilterProbe, std::move(filter_args));
+  builder->Append(codegen_->MakeStmt(filter_call));
+  return true;
 }
 
 void HashJoinRightTranslator::GenKeyCheck(FunctionBuilder *builder) {
@@ -259,19 +536,46 @@ void HashJoinRightTranslator::GenKeyCheck(FunctionBuilder *builder) {
   }
 }
 
-// Set var hash_val = @hash(right_join_keys)
+// Set var hash_val = @hash(right_join_keys), or var hash_val = @pciGetHash(pci) if the probe keys were hashed a vector
+// at a time, or the bloom filter already hashed the probe tuples
 void HashJoinRightTranslator::GenHashValue(FunctionBuilder *builder) {
-  // First create @hash(join_key1, join_key2, ...)
+  ast::Expr *hash_val;
+  if (left_->UseBloomFilter() || HashesKeyVectors()) {
+    auto child_tuple = child_translator_->GetMaterializedTuple();
+    hash_val = codegen_->OneArgCall(ast::Builtin::PCIGetHash, codegen_->MakeExpr(*child_tuple.first));
+  } else {
+    hash_val = GenHashCall();
+  }
+  // Create the variable declaration
+  builder->Append(codegen_->DeclareVariable(hash_val_, nullptr, hash_val));
+}
+
+// Create @hash(join_key1, join_key2, ...)
+ast::Expr *HashJoinRightTranslator::GenHashCall() {
   std::vector<ast::Expr *> hash_args{};
   for (const auto &key : op_->GetRightHashKeys()) {
     std::unique_ptr<ExpressionTranslator> key_translator =
         TranslatorFactory::CreateExpressionTranslator(key.Get(), codegen_);
     hash_args.emplace_back(key_translator->DeriveExpr(this));
   }
-  ast::Expr *hash_call = codegen_->BuiltinCall(ast::Builtin::Hash, std::move(hash_args));
+  return codegen_->BuiltinCall(ast::Builtin::Hash, std::move(hash_args));
+}
 
-  // Create the variable declaration
-  builder->Append(codegen_->DeclareVariable(hash_val_, nullptr, hash_call));
+std::vector<const terrier::parser::AbstractExpression *> HashJoinRightTranslator::GetProbeKeys() const {
+  // The keys reference the output of the probe side child, the join's second child
+  std::vector<const terrier::parser::AbstractExpression *> keys;
+  for (const auto &key : op_->GetRightHashKeys()) {
+    if (key->GetExpressionType() != terrier::parser::ExpressionType::VALUE_TUPLE) return {};
+    auto dve = dynamic_cast<const terrier::parser::DerivedValueExpression *>(key.Get());
+    if (dve->GetTupleIdx() != 1) return {};
+    keys.emplace_back(op_->GetChild(1)->GetOutputSchema()->GetColumn(dve->GetValueIdx()).GetExpr().Get());
+  }
+  return keys;
+}
+
+bool HashJoinRightTranslator::HashesKeyVectors() {
+  auto *scan = dynamic_cast<SeqScanTranslator *>(child_translator_);
+  return scan != nullptr && scan->CanHashKeys(GetProbeKeys());
 }
 
 void HashJoinRightTranslator::FillProbeRow(FunctionBuilder *builder) {
@@ -283,13 +587,19 @@ void HashJoinRightTranslator::FillProbeRow(FunctionBuilder *builder) {
   }
 }
 
+// var probe_row: ProbeRow
+void HashJoinRightTranslator::DeclareProbeRow(FunctionBuilder *builder) {
+  builder->Append(codegen_->DeclareVariable(probe_row_, codegen_->MakeExpr(probe_struct_), nullptr));
+}
+
 void HashJoinRightTranslator::DeclareIterator(FunctionBuilder *builder) {
   ast::Expr *iter_type = codegen_->BuiltinType(ast::BuiltinType::Kind::JoinHashTableIterator);
   builder->Append(codegen_->DeclareVariable(join_iter_, iter_type, nullptr));
 }
 
 // Loop to probe the hash table
-void HashJoinRightTranslator::GenProbeLoop(FunctionBuilder *builder) {
+void HashJoinRightTranslator::GenProbeLoop(FunctionBuilder *builder, ast::Identifier key_check,
+                                           ast::Expr *probe_tuple) {
   // for (@joinHTIterInit(&hti, &state.join_table, hash_val);
   //      @joinHTIterHasNext(&hti, checkJoinKey, execCtx, &lineitem_row);) {...}
   std::vector<ast::Expr *> init_args{codegen_->PointerTo(join_iter_), codegen_->GetStateMemberPtr(left_->join_ht_),
@@ -297,18 +607,8 @@ void HashJoinRightTranslator::GenProbeLoop(FunctionBuilder *builder) {
   ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::JoinHashTableIterInit, std::move(init_args));
   ast::Stmt *loop_init = codegen_->MakeStmt(init_call);
   // Loop condition
-  std::vector<ast::Expr *> has_next_args{codegen_->PointerTo(join_iter_), codegen_->MakeExpr(key_check_),
-                                         codegen_->MakeExpr(codegen_->GetExecCtxVar())};
-  if (is_child_materializer_) {
-    // If the child is a materializer, directly use its tuple as a probe.
-    auto child_tuple = child_translator_->GetMaterializedTuple();
-    TERRIER_ASSERT(child_tuple.first != nullptr && child_tuple.second != nullptr, "Materialize should have output");
-    has_next_args.emplace_back(is_child_ptr_ ? codegen_->MakeExpr(*child_tuple.first)
-                                             : codegen_->PointerTo(*child_tuple.first));
-  } else {
-    // Otherwise use the constructed probe row.
-    has_next_args.emplace_back(codegen_->PointerTo(probe_row_));
-  }
+  std::vector<ast::Expr *> has_next_args{codegen_->PointerTo(join_iter_), codegen_->MakeExpr(key_check),
+                                         codegen_->MakeExpr(codegen_->GetExecCtxVar()), probe_tuple};
   ast::Expr *has_next_call = codegen_->BuiltinCall(ast::Builtin::JoinHashTableIterHasNext, std::move(has_next_args));
   // Make the loop
   builder->StartForStmt(loop_init, has_next_call, nullptr);
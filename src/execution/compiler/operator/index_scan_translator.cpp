@@ -4,6 +4,8 @@
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/translator_factory.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
 #include "planner/plannodes/index_join_plan_node.h"
 
 namespace terrier::execution::compiler {
@@ -22,6 +24,7 @@ IndexScanTranslator::IndexScanTranslator(const planner::IndexScanPlanNode *op, C
       lo_index_pr_(codegen->NewIdentifier("lo_index_pr")),
       hi_index_pr_(codegen->NewIdentifier("hi_index_pr")),
       table_pr_(codegen->NewIdentifier("table_pr")),
+      key_pr_(codegen->NewIdentifier("key_pr")),
       pr_type_(codegen->Context()->GetIdentifier("ProjectedRow")),
       slot_(codegen->NewIdentifier("slot")) {}
 
@@ -30,6 +33,7 @@ void IndexScanTranslator::Produce(FunctionBuilder *builder) {
   SetOids(builder);
   // Declare an index iterator
   DeclareIterator(builder);
+  if (op_->IsIndexOnly()) SetIndexOnly(builder);
   // Get the index prs
   DeclareIndexPR(builder);
   // Let child produce
@@ -52,14 +56,20 @@ void IndexScanTranslator::Consume(FunctionBuilder *builder) {
   // Fill the key with table data
   if (op_->GetScanType() == planner::IndexScanType::Exact) {
     FillKey(builder, index_pr_, op_->GetIndexColumns());
+  } else if (op_->GetScanType() == planner::IndexScanType::AscendingRanges) {
+    AddKeyRanges(builder);
   } else {
     FillKey(builder, lo_index_pr_, op_->GetLoIndexColumns());
     FillKey(builder, hi_index_pr_, op_->GetHiIndexColumns());
   }
   // Generate the loop
   GenForLoop(builder);
-  // Get Table PR
-  DeclareTablePR(builder);
+  // Get the PR of the scanned columns
+  if (op_->IsIndexOnly()) {
+    DeclareKeyPR(builder);
+  } else {
+    DeclareTablePR(builder);
+  }
   DeclareSlot(builder);
   bool has_predicate = op_->GetScanPredicate() != nullptr;
   if (has_predicate) GenPredicate(builder);
@@ -83,6 +93,12 @@ ast::Expr *IndexScanTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr
 }
 
 ast::Expr *IndexScanTranslator::GetTableColumn(const catalog::col_oid_t &col_oid) {
+  if (op_->IsIndexOnly()) {
+    // Read the column from the key it is stored in
+    const auto &key_col = GetKeyColumn(col_oid);
+    uint16_t attr_idx = index_pm_.at(key_col.Oid());
+    return codegen_->PRGet(codegen_->MakeExpr(key_pr_), key_col.Type(), key_col.Nullable(), attr_idx);
+  }
   auto type = table_schema_.GetColumn(col_oid).Type();
   auto nullable = table_schema_.GetColumn(col_oid).Nullable();
   uint16_t attr_idx = table_pm_[col_oid];
@@ -128,6 +144,31 @@ void IndexScanTranslator::DeclareTablePR(terrier::execution::compiler::FunctionB
   builder->Append(codegen_->DeclareVariable(table_pr_, nullptr, get_pr_call));
 }
 
+void IndexScanTranslator::SetIndexOnly(FunctionBuilder *builder) {
+  // @indexIteratorSetIndexOnly(&index_iter)
+  ast::Expr *set_call = codegen_->OneArgCall(ast::Builtin::IndexIteratorSetIndexOnly, index_iter_, true);
+  builder->Append(codegen_->MakeStmt(set_call));
+}
+
+void IndexScanTranslator::DeclareKeyPR(FunctionBuilder *builder) {
+  ast::Expr *get_pr_call = codegen_->OneArgCall(ast::Builtin::IndexIteratorGetKeyPR, index_iter_, true);
+  builder->Append(codegen_->DeclareVariable(key_pr_, nullptr, get_pr_call));
+}
+
+const catalog::IndexSchema::Column &IndexScanTranslator::GetKeyColumn(const catalog::col_oid_t &col_oid) {
+  for (const auto &key_col : index_schema_.GetColumns()) {
+    auto expr = key_col.StoredExpression();
+    if (expr->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) continue;
+    auto cve = expr.CastManagedPointerTo<const parser::ColumnValueExpression>();
+    // Like the optimizer, match key columns that are not bound to an oid by name
+    auto key_col_oid = cve->GetColumnOid() != catalog::INVALID_COLUMN_OID
+                           ? cve->GetColumnOid()
+                           : table_schema_.GetColumn(cve->GetColumnName()).Oid();
+    if (key_col_oid == col_oid) return key_col;
+  }
+  UNREACHABLE("Index-only scans should only read the columns of the index keys");
+}
+
 void IndexScanTranslator::DeclareSlot(terrier::execution::compiler::FunctionBuilder *builder) {
   ast::Expr *get_slot_call = codegen_->OneArgCall(ast::Builtin::IndexIteratorGetSlot, index_iter_, true);
   builder->Append(codegen_->DeclareVariable(slot_, nullptr, get_slot_call));
@@ -138,16 +179,37 @@ void IndexScanTranslator::FillKey(
     const std::unordered_map<catalog::indexkeycol_oid_t, planner::IndexExpression> &index_exprs) {
   // Set key.attr_i = expr_i for each key attribute
   for (const auto &key : index_exprs) {
-    auto translator = TranslatorFactory::CreateExpressionTranslator(key.second.Get(), codegen_);
     uint16_t attr_offset = index_pm_.at(key.first);
     type::TypeId attr_type = index_schema_.GetColumn(!key.first - 1).Type();
     bool nullable = index_schema_.GetColumn(!key.first - 1).Nullable();
-    auto set_key_call =
-        codegen_->PRSet(codegen_->MakeExpr(pr), attr_type, nullable, attr_offset, translator->DeriveExpr(this));
+    ast::Expr *key_value;
+    if (key.second->GetExpressionType() == parser::ExpressionType::VALUE_CONSTANT &&
+        key.second.CastManagedPointerTo<parser::ConstantValueExpression>()->GetValue().Null()) {
+      // NULL bounds of key ranges cannot be written as constants, so they are read from a variable set to NULL
+      ast::Identifier null_key = codegen_->NewIdentifier("null_key");
+      builder->Append(codegen_->DeclareVariable(null_key, codegen_->TplType(attr_type), nullptr));
+      builder->Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::InitSqlNull, null_key, true)));
+      key_value = codegen_->MakeExpr(null_key);
+    } else {
+      auto translator = TranslatorFactory::CreateExpressionTranslator(key.second.Get(), codegen_);
+      key_value = translator->DeriveExpr(this);
+    }
+    auto set_key_call = codegen_->PRSet(codegen_->MakeExpr(pr), attr_type, nullable, attr_offset, key_value);
     builder->Append(codegen_->MakeStmt(set_key_call));
   }
 }
 
+void IndexScanTranslator::AddKeyRanges(FunctionBuilder *builder) {
+  // The iterator copies the bounds, so the same PRs are reused for every range
+  for (const auto &range : op_->GetKeyRanges()) {
+    FillKey(builder, lo_index_pr_, range.first);
+    FillKey(builder, hi_index_pr_, range.second);
+    // @indexIteratorAddRange(&index_iter)
+    ast::Expr *add_call = codegen_->OneArgCall(ast::Builtin::IndexIteratorAddRange, index_iter_, true);
+    builder->Append(codegen_->MakeStmt(add_call));
+  }
+}
+
 void IndexScanTranslator::GenForLoop(FunctionBuilder *builder) {
   // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);)
   // Loop Initialization
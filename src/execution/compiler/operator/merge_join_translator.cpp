@@ -0,0 +1,385 @@
+#include "execution/compiler/operator/merge_join_translator.h"
+#include <memory>
+#include <utility>
+#include <vector>
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/translator_factory.h"
+#include "planner/plannodes/merge_join_plan_node.h"
+
+namespace terrier::execution::compiler {
+MergeJoinLeftTranslator::MergeJoinLeftTranslator(const terrier::planner::MergeJoinPlanNode *op,
+                                                 execution::compiler::CodeGen *codegen)
+    : OperatorTranslator(codegen),
+      op_(op),
+      sorter_{codegen->NewIdentifier("merge_sorter")},
+      left_struct_{codegen->NewIdentifier("LeftRow")},
+      left_row_{codegen->NewIdentifier("left_row")},
+      comp_fn_{codegen->NewIdentifier("mergeJoinSortFn")},
+      comp_lhs_{codegen->NewIdentifier("lhs")},
+      comp_rhs_{codegen->NewIdentifier("rhs")} {}
+
+void MergeJoinLeftTranslator::Produce(FunctionBuilder *builder) {
+  // Produce the rest of the pipeline
+  child_translator_->Produce(builder);
+  // Call @sorterSort at the end of the pipeline. The optimizer leaves the sort of the left child to this sorter.
+  GenSorterSort(builder);
+}
+
+void MergeJoinLeftTranslator::Abort(FunctionBuilder *builder) { child_translator_->Abort(builder); }
+
+void MergeJoinLeftTranslator::Consume(FunctionBuilder *builder) {
+  // Rows with a NULL join key never match, so they are not materialized.
+  // if (left_key0 != nil and left_key1 != nil ...)
+  ast::Expr *non_null = nullptr;
+  for (const auto &key : op_->GetLeftMergeKeys()) {
+    auto key_translator = TranslatorFactory::CreateExpressionTranslator(key.Get(), codegen_);
+    ast::Expr *key_check =
+        codegen_->BinaryOp(parsing::Token::Type::BANG_EQUAL, codegen_->NilLiteral(), key_translator->DeriveExpr(this));
+    non_null = non_null == nullptr ? key_check : codegen_->BinaryOp(parsing::Token::Type::AND, non_null, key_check);
+  }
+  builder->StartIfStmt(non_null);
+  // Call @sorterInsert
+  GenSorterInsert(builder);
+  // Fill up the left row
+  FillLeftRow(builder);
+  builder->FinishBlockStmt();
+}
+
+// Declare the sorter
+void MergeJoinLeftTranslator::InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) {
+  // merge_sorter: Sorter
+  ast::Expr *sorter_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Sorter);
+  state_fields->emplace_back(codegen_->MakeField(sorter_, sorter_type));
+}
+
+// Declare the left row struct
+void MergeJoinLeftTranslator::InitializeStructs(util::RegionVector<ast::Decl *> *decls) {
+  util::RegionVector<ast::FieldDecl *> fields{codegen_->Region()};
+  GetChildOutputFields(&fields, LEFT_ATTR_NAME);
+  decls->emplace_back(codegen_->MakeStruct(left_struct_, std::move(fields)));
+}
+
+void MergeJoinLeftTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  // Make a function (lhs *LeftRow, rhs *LeftRow) -> int32
+  ast::FieldDecl *lhs = codegen_->MakeField(comp_lhs_, codegen_->PointerType(left_struct_));
+  ast::FieldDecl *rhs = codegen_->MakeField(comp_rhs_, codegen_->PointerType(left_struct_));
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Int32);
+  util::RegionVector<ast::FieldDecl *> params{{lhs, rhs}, codegen_->Region()};
+  FunctionBuilder builder{codegen_, comp_fn_, std::move(params), ret_type};
+  GenComparisons(&builder);
+  decls->push_back(builder.Finish());
+}
+
+// Call @sorterInit on the sorter
+void MergeJoinLeftTranslator::InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) {
+  // @sorterInit(&state.merge_sorter, @execCtxGetMem(execCtx), mergeJoinSortFn, @sizeOf(LeftRow))
+  ast::Expr *sizeof_call = codegen_->SizeOf(left_struct_);
+  std::vector<ast::Expr *> init_args{codegen_->GetStateMemberPtr(sorter_), codegen_->ExecCtxGetMem(),
+                                     codegen_->MakeExpr(comp_fn_), sizeof_call};
+  ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::SorterInit, std::move(init_args));
+  setup_stmts->emplace_back(codegen_->MakeStmt(init_call));
+}
+
+// Call @sorterFree on the sorter
+void MergeJoinLeftTranslator::InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) {
+  ast::Expr *free_call = codegen_->OneArgStateCall(ast::Builtin::SorterFree, sorter_);
+  teardown_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
+
+// var left_row = @ptrCast(*LeftRow, @sorterInsert(&state.merge_sorter))
+void MergeJoinLeftTranslator::GenSorterInsert(FunctionBuilder *builder) {
+  ast::Expr *insert_call = codegen_->OneArgStateCall(ast::Builtin::SorterInsert, sorter_);
+  ast::Expr *cast_call = codegen_->PtrCast(left_struct_, insert_call);
+  builder->Append(codegen_->DeclareVariable(left_row_, nullptr, cast_call));
+}
+
+// Fill up the left row
+void MergeJoinLeftTranslator::FillLeftRow(FunctionBuilder *builder) {
+  for (uint32_t attr_idx = 0; attr_idx < op_->GetChild(0)->GetOutputSchema()->GetColumns().size(); attr_idx++) {
+    ast::Expr *lhs = GetAttribute(left_row_, attr_idx);
+    ast::Expr *rhs = child_translator_->GetOutput(attr_idx);
+    builder->Append(codegen_->Assign(lhs, rhs));
+  }
+}
+
+// Call @sorterSort(&state.merge_sorter)
+void MergeJoinLeftTranslator::GenSorterSort(FunctionBuilder *builder) {
+  ast::Expr *sort_call = codegen_->OneArgStateCall(ast::Builtin::SorterSort, sorter_);
+  builder->Append(codegen_->MakeStmt(sort_call));
+}
+
+void MergeJoinLeftTranslator::GenComparisons(FunctionBuilder *builder) {
+  // For each join key, generate:
+  // if (lhs.key_i < rhs.key_i) {return -1}
+  // if (lhs.key_i > rhs.key_i) {return 1}
+  // ...
+  // return 0
+  for (const auto &key : op_->GetLeftMergeKeys()) {
+    auto key_translator = TranslatorFactory::CreateExpressionTranslator(key.Get(), codegen_);
+    int32_t ret_value = -1;
+    for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+      current_row_ = CurrentRow::Lhs;
+      ast::Expr *lhs_key = key_translator->DeriveExpr(this);
+      current_row_ = CurrentRow::Rhs;
+      ast::Expr *rhs_key = key_translator->DeriveExpr(this);
+      builder->StartIfStmt(codegen_->Compare(tok, lhs_key, rhs_key));
+      builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(ret_value)));
+      builder->FinishBlockStmt();
+      ret_value = -ret_value;
+    }
+  }
+  current_row_ = CurrentRow::Child;
+  builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(0)));
+}
+
+ast::Expr *MergeJoinLeftTranslator::GetAttribute(ast::Identifier object, uint32_t attr_idx) {
+  ast::Identifier member = codegen_->Context()->GetIdentifier(LEFT_ATTR_NAME + std::to_string(attr_idx));
+  return codegen_->MemberExpr(object, member);
+}
+
+ast::Expr *MergeJoinLeftTranslator::GetOutput(uint32_t attr_idx) { return GetAttribute(left_row_, attr_idx); }
+
+ast::Expr *MergeJoinLeftTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) {
+  // Pass through to the child in the pipeline
+  if (current_row_ == CurrentRow::Child) {
+    return child_translator_->GetOutput(attr_idx);
+  }
+  // Use the lhs or rhs in the comparison function
+  return GetAttribute(current_row_ == CurrentRow::Lhs ? comp_lhs_ : comp_rhs_, attr_idx);
+}
+
+////////////////////////////////////////
+//// Right translator
+////////////////////////////////////////
+
+MergeJoinRightTranslator::MergeJoinRightTranslator(const terrier::planner::MergeJoinPlanNode *op,
+                                                   execution::compiler::CodeGen *codegen,
+                                                   execution::compiler::OperatorTranslator *left)
+    : OperatorTranslator{codegen},
+      op_(op),
+      left_(dynamic_cast<MergeJoinLeftTranslator *>(left)),
+      probe_struct_{codegen->NewIdentifier("ProbeRow")},
+      probe_row_{codegen->NewIdentifier("probe_row")},
+      cmp_fn_{codegen->NewIdentifier("mergeJoinCmpFn")},
+      cursor_{codegen->NewIdentifier("mj_cursor")},
+      advance_{codegen->NewIdentifier("mj_advance")} {}
+
+void MergeJoinRightTranslator::Produce(FunctionBuilder *builder) {
+  // Declare the cursor over the sorted left rows
+  DeclareCursor(builder);
+  // Let right child produce its code
+  child_translator_->Produce(builder);
+  // Free the cursor
+  GenCursorFree(builder);
+}
+
+void MergeJoinRightTranslator::Abort(FunctionBuilder *builder) {
+  child_translator_->Abort(builder);
+  // Free the cursor
+  GenCursorFree(builder);
+}
+
+void MergeJoinRightTranslator::Consume(FunctionBuilder *builder) {
+  // Materialize the probe tuple. The comparison function reads the join keys from it.
+  FillProbeRow(builder);
+  // Probe tuples with a NULL join key never match
+  GenNonNullKeyCheck(builder);
+  // Move the cursor to the left rows with the same keys
+  GenAdvanceCursor(builder);
+  // Join the probe tuple with them
+  GenRunLoop(builder);
+  // Close the NULL check
+  builder->FinishBlockStmt();
+}
+
+// var mj_cursor: MergeJoinCursor
+// @mergeJoinCursorInit(&mj_cursor, &state.merge_sorter)
+void MergeJoinRightTranslator::DeclareCursor(FunctionBuilder *builder) {
+  ast::Expr *cursor_type = codegen_->BuiltinType(ast::BuiltinType::Kind::MergeJoinCursor);
+  builder->Append(codegen_->DeclareVariable(cursor_, cursor_type, nullptr));
+  std::vector<ast::Expr *> init_args{codegen_->PointerTo(cursor_), codegen_->GetStateMemberPtr(left_->sorter_)};
+  ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::MergeJoinCursorInit, std::move(init_args));
+  builder->Append(codegen_->MakeStmt(init_call));
+}
+
+// @mergeJoinCursorFree(&mj_cursor)
+void MergeJoinRightTranslator::GenCursorFree(FunctionBuilder *builder) {
+  ast::Expr *free_call = codegen_->OneArgCall(ast::Builtin::MergeJoinCursorFree, cursor_, true);
+  builder->Append(codegen_->MakeStmt(free_call));
+}
+
+// if (right_key0 != nil and right_key1 != nil ...) {
+void MergeJoinRightTranslator::GenNonNullKeyCheck(FunctionBuilder *builder) {
+  ast::Expr *non_null = nullptr;
+  for (const auto &key : op_->GetRightMergeKeys()) {
+    auto key_translator = TranslatorFactory::CreateExpressionTranslator(key.Get(), codegen_);
+    ast::Expr *key_check =
+        codegen_->BinaryOp(parsing::Token::Type::BANG_EQUAL, codegen_->NilLiteral(), key_translator->DeriveExpr(this));
+    non_null = non_null == nullptr ? key_check : codegen_->BinaryOp(parsing::Token::Type::AND, non_null, key_check);
+  }
+  builder->StartIfStmt(non_null);
+}
+
+// The probe tuples arrive in key order, so consecutive tuples with the same keys reuse the run.
+// var mj_advance = true
+// @mergeJoinCursorRunInit(&mj_cursor)
+// if (@mergeJoinCursorRunHasNext(&mj_cursor)) {
+//   mj_advance = mergeJoinCmpFn(@ptrCast(*LeftRow, @mergeJoinCursorRunGetRow(&mj_cursor)), &probe_row) != 0
+// }
+// if (mj_advance) {
+//   @mergeJoinCursorClearRun(&mj_cursor)
+//   for (; @mergeJoinCursorHasNext(&mj_cursor) and mergeJoinCmpFn(...GetRow...) < 0;
+//        @mergeJoinCursorNext(&mj_cursor)) {}
+//   for (; @mergeJoinCursorHasNext(&mj_cursor) and mergeJoinCmpFn(...GetRow...) == 0;) {
+//     @mergeJoinCursorAddToRun(&mj_cursor)
+//   }
+// }
+void MergeJoinRightTranslator::GenAdvanceCursor(FunctionBuilder *builder) {
+  builder->Append(codegen_->DeclareVariable(advance_, nullptr, codegen_->BoolLiteral(true)));
+  builder->Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorRunInit, cursor_, true)));
+  builder->StartIfStmt(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorRunHasNext, cursor_, true));
+  ast::Expr *run_cmp = GenCmpCall(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorRunGetRow, cursor_, true));
+  ast::Expr *differs = codegen_->Compare(parsing::Token::Type::BANG_EQUAL, run_cmp, codegen_->IntLiteral(0));
+  builder->Append(codegen_->Assign(codegen_->MakeExpr(advance_), differs));
+  builder->FinishBlockStmt();
+
+  builder->StartIfStmt(codegen_->MakeExpr(advance_));
+  builder->Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorClearRun, cursor_, true)));
+  // Skip the left rows with smaller keys
+  {
+    ast::Expr *has_next = codegen_->OneArgCall(ast::Builtin::MergeJoinCursorHasNext, cursor_, true);
+    ast::Expr *cmp = GenCmpCall(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorGetRow, cursor_, true));
+    ast::Expr *smaller = codegen_->Compare(parsing::Token::Type::LESS, cmp, codegen_->IntLiteral(0));
+    ast::Expr *cond = codegen_->BinaryOp(parsing::Token::Type::AND, has_next, smaller);
+    ast::Stmt *next = codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorNext, cursor_, true));
+    builder->StartForStmt(nullptr, cond, next);
+    builder->FinishBlockStmt();
+  }
+  // Copy the left rows with equal keys into the run
+  {
+    ast::Expr *has_next = codegen_->OneArgCall(ast::Builtin::MergeJoinCursorHasNext, cursor_, true);
+    ast::Expr *cmp = GenCmpCall(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorGetRow, cursor_, true));
+    ast::Expr *equal = codegen_->Compare(parsing::Token::Type::EQUAL_EQUAL, cmp, codegen_->IntLiteral(0));
+    ast::Expr *cond = codegen_->BinaryOp(parsing::Token::Type::AND, has_next, equal);
+    builder->StartForStmt(nullptr, cond, nullptr);
+    builder->Append(codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorAddToRun, cursor_, true)));
+    builder->FinishBlockStmt();
+  }
+  builder->FinishBlockStmt();
+}
+
+// for (@mergeJoinCursorRunInit(&mj_cursor); @mergeJoinCursorRunHasNext(&mj_cursor);
+//      @mergeJoinCursorRunNext(&mj_cursor)) {
+//   var left_row = @ptrCast(*LeftRow, @mergeJoinCursorRunGetRow(&mj_cursor))
+//   if (join_predicate) { parent consume }
+// }
+void MergeJoinRightTranslator::GenRunLoop(FunctionBuilder *builder) {
+  ast::Stmt *loop_init =
+      codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorRunInit, cursor_, true));
+  ast::Expr *has_next = codegen_->OneArgCall(ast::Builtin::MergeJoinCursorRunHasNext, cursor_, true);
+  ast::Stmt *loop_next =
+      codegen_->MakeStmt(codegen_->OneArgCall(ast::Builtin::MergeJoinCursorRunNext, cursor_, true));
+  builder->StartForStmt(loop_init, has_next, loop_next);
+
+  ast::Expr *get_row = codegen_->OneArgCall(ast::Builtin::MergeJoinCursorRunGetRow, cursor_, true);
+  ast::Expr *cast_call = codegen_->PtrCast(left_->left_struct_, get_row);
+  builder->Append(codegen_->DeclareVariable(left_->left_row_, nullptr, cast_call));
+
+  if (op_->GetJoinPredicate() != nullptr) {
+    auto pred_translator = TranslatorFactory::CreateExpressionTranslator(op_->GetJoinPredicate().Get(), codegen_);
+    builder->StartIfStmt(pred_translator->DeriveExpr(this));
+    parent_translator_->Consume(builder);
+    builder->FinishBlockStmt();
+  } else {
+    parent_translator_->Consume(builder);
+  }
+  builder->FinishBlockStmt();
+}
+
+// mergeJoinCmpFn(@ptrCast(*LeftRow, row), &probe_row)
+ast::Expr *MergeJoinRightTranslator::GenCmpCall(ast::Expr *row) {
+  ast::Expr *left_row = codegen_->PtrCast(left_->left_struct_, row);
+  util::RegionVector<ast::Expr *> args{{left_row, codegen_->PointerTo(probe_row_)}, codegen_->Region()};
+  return codegen_->Factory()->NewCallExpr(codegen_->MakeExpr(cmp_fn_), std::move(args));
+}
+
+ast::Expr *MergeJoinRightTranslator::GetOutput(uint32_t attr_idx) {
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  std::unique_ptr<ExpressionTranslator> translator =
+      TranslatorFactory::CreateExpressionTranslator(output_expr.Get(), codegen_);
+  return translator->DeriveExpr(this);
+}
+
+ast::Expr *MergeJoinRightTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx,
+                                                    terrier::type::TypeId type) {
+  TERRIER_ASSERT(child_idx <= 1, "A merge join can only have two children.");
+  // For the left child, get the attribute of the left row
+  if (child_idx == 0) {
+    return left_->GetOutput(attr_idx);
+  }
+  // Otherwise get the output from the probe row.
+  return GetProbeValue(attr_idx);
+}
+
+ast::Expr *MergeJoinRightTranslator::GetProbeValue(uint32_t idx) {
+  ast::Identifier member = codegen_->Context()->GetIdentifier(RIGHT_ATTR_NAME + std::to_string(idx));
+  return codegen_->MemberExpr(probe_row_, member);
+}
+
+// Make the probe struct
+void MergeJoinRightTranslator::InitializeStructs(util::RegionVector<ast::Decl *> *decls) {
+  util::RegionVector<ast::FieldDecl *> fields{codegen_->Region()};
+  GetChildOutputFields(&fields, RIGHT_ATTR_NAME);
+  decls->emplace_back(codegen_->MakeStruct(probe_struct_, std::move(fields)));
+}
+
+// Declare fn mergeJoinCmpFn(left_row: *LeftRow, probe_row: *ProbeRow) -> int32
+void MergeJoinRightTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  ast::FieldDecl *param1 = codegen_->MakeField(left_->left_row_, codegen_->PointerType(left_->left_struct_));
+  ast::FieldDecl *param2 = codegen_->MakeField(probe_row_, codegen_->PointerType(probe_struct_));
+  util::RegionVector<ast::FieldDecl *> params({param1, param2}, codegen_->Region());
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Int32);
+
+  FunctionBuilder builder(codegen_, cmp_fn_, std::move(params), ret_type);
+  GenComparisons(&builder);
+  decls->emplace_back(builder.Finish());
+}
+
+void MergeJoinRightTranslator::GenComparisons(FunctionBuilder *builder) {
+  // For each pair of join keys, generate:
+  // if (left_key_i < right_key_i) {return -1}
+  // if (left_key_i > right_key_i) {return 1}
+  // ...
+  // return 0
+  const auto &left_keys = op_->GetLeftMergeKeys();
+  const auto &right_keys = op_->GetRightMergeKeys();
+  TERRIER_ASSERT(left_keys.size() == right_keys.size(), "Merge join needs as many left keys as right keys");
+  // The left keys read the left row and the right keys read the probe row through GetChildOutput
+  for (uint32_t key_idx = 0; key_idx < left_keys.size(); key_idx++) {
+    auto left_translator = TranslatorFactory::CreateExpressionTranslator(left_keys[key_idx].Get(), codegen_);
+    auto right_translator = TranslatorFactory::CreateExpressionTranslator(right_keys[key_idx].Get(), codegen_);
+    int32_t ret_value = -1;
+    for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+      ast::Expr *if_cond =
+          codegen_->Compare(tok, left_translator->DeriveExpr(this), right_translator->DeriveExpr(this));
+      builder->StartIfStmt(if_cond);
+      builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(ret_value)));
+      builder->FinishBlockStmt();
+      ret_value = -ret_value;
+    }
+  }
+  builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(0)));
+}
+
+void MergeJoinRightTranslator::FillProbeRow(FunctionBuilder *builder) {
+  // var probe_row: ProbeRow
+  builder->Append(codegen_->DeclareVariable(probe_row_, codegen_->MakeExpr(probe_struct_), nullptr));
+  // Fill the ProbeRow.
+  for (uint32_t attr_idx = 0; attr_idx < op_->GetChild(1)->GetOutputSchema()->GetColumns().size(); attr_idx++) {
+    ast::Expr *lhs = GetProbeValue(attr_idx);
+    ast::Expr *rhs = child_translator_->GetOutput(attr_idx);
+    builder->Append(codegen_->Assign(lhs, rhs));
+  }
+}
+
+}  // namespace terrier::execution::compiler
@@ -1,16 +1,223 @@
 #include "execution/compiler/operator/seq_scan_translator.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
 #include <utility>
 #include "execution/ast/type.h"
 #include "execution/compiler/codegen.h"
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/translator_factory.h"
+#include "execution/sql/like_pattern.h"
 #include "parser/expression/constant_value_expression.h"
+#include "parser/expression/derived_value_expression.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
+#include "storage/sql_table.h"
+#include "storage/zone_map.h"
 
 namespace terrier::execution::compiler {
 
+namespace {
+
+// Compute the zone map key of the constant @em val as a value of a column of type @em col_type. Returns false if the
+// constant cannot be compared with the column's values through their keys.
+bool ZoneMapKey(const type::TransientValue &val, const type::TypeId col_type, int64_t *key) {
+  if (val.Null()) return false;
+  const storage::ZoneMapType zone_map_type = storage::SqlTable::ZoneMapTypeFor(col_type);
+  switch (val.Type()) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT: {
+      int64_t int_val;
+      switch (val.Type()) {
+        case type::TypeId::TINYINT:
+          int_val = type::TransientValuePeeker::PeekTinyInt(val);
+          break;
+        case type::TypeId::SMALLINT:
+          int_val = type::TransientValuePeeker::PeekSmallInt(val);
+          break;
+        case type::TypeId::INTEGER:
+          int_val = type::TransientValuePeeker::PeekInteger(val);
+          break;
+        default:
+          int_val = type::TransientValuePeeker::PeekBigInt(val);
+          break;
+      }
+      if (zone_map_type == storage::ZoneMapType::SIGNED_INTEGER && col_type != type::TypeId::BOOLEAN) {
+        *key = storage::ZoneMap::SignedIntegerKey(int_val);
+        return true;
+      }
+      if (zone_map_type == storage::ZoneMapType::FLOAT) {
+        *key = storage::ZoneMap::FloatKey(static_cast<double>(int_val));
+        return true;
+      }
+      return false;
+    }
+    case type::TypeId::DECIMAL: {
+      if (zone_map_type != storage::ZoneMapType::FLOAT) return false;
+      *key = storage::ZoneMap::FloatKey(type::TransientValuePeeker::PeekDecimal(val));
+      return true;
+    }
+    case type::TypeId::DATE: {
+      if (zone_map_type != storage::ZoneMapType::DATE) return false;
+      *key = storage::ZoneMap::DateKey(!type::TransientValuePeeker::PeekDate(val));
+      return true;
+    }
+    case type::TypeId::TIMESTAMP: {
+      if (zone_map_type != storage::ZoneMapType::UNSIGNED_INTEGER) return false;
+      *key = storage::ZoneMap::UnsignedIntegerKey(!type::TransientValuePeeker::PeekTimestamp(val));
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// Read the integer constant @em val as a filter value for a column of the integer type @em col_type. Returns false
+// if either is not an integer, or if the column cannot hold the constant, so that the filter value would be truncated.
+bool IntegerFilterValue(const type::TransientValue &val, const type::TypeId col_type, int64_t *filter_val) {
+  if (val.Null()) return false;
+  switch (val.Type()) {
+    case type::TypeId::TINYINT:
+      *filter_val = type::TransientValuePeeker::PeekTinyInt(val);
+      break;
+    case type::TypeId::SMALLINT:
+      *filter_val = type::TransientValuePeeker::PeekSmallInt(val);
+      break;
+    case type::TypeId::INTEGER:
+      *filter_val = type::TransientValuePeeker::PeekInteger(val);
+      break;
+    case type::TypeId::BIGINT:
+      *filter_val = type::TransientValuePeeker::PeekBigInt(val);
+      break;
+    default:
+      return false;
+  }
+  switch (col_type) {
+    case type::TypeId::TINYINT:
+      return *filter_val >= std::numeric_limits<int8_t>::min() && *filter_val <= std::numeric_limits<int8_t>::max();
+    case type::TypeId::SMALLINT:
+      return *filter_val >= std::numeric_limits<int16_t>::min() && *filter_val <= std::numeric_limits<int16_t>::max();
+    case type::TypeId::INTEGER:
+      return *filter_val >= std::numeric_limits<int32_t>::min() && *filter_val <= std::numeric_limits<int32_t>::max();
+    case type::TypeId::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether the PCI filters can compare a column of type @em col_type with the constant @em val
+bool IsFilterValue(const type::TransientValue &val, const type::TypeId col_type) {
+  if (val.Null()) return false;
+  switch (col_type) {
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+    case type::TypeId::DECIMAL:
+    case type::TypeId::VARCHAR:
+      return val.Type() == col_type;
+    default: {
+      int64_t filter_val;
+      return IntegerFilterValue(val, col_type, &filter_val);
+    }
+  }
+}
+
+// Whether the PCI filters can match a string column against the constant LIKE pattern @em val
+bool IsFilterLikePattern(const type::TransientValue &val) {
+  if (val.Null() || val.Type() != type::TypeId::VARCHAR) return false;
+  try {
+    sql::LikePattern pattern(type::TransientValuePeeker::PeekVarChar(val));
+  } catch (const std::runtime_error &) {
+    // Malformed patterns are left to the tuple-at-a-time matcher, which reports them if a string is ever matched
+    return false;
+  }
+  return true;
+}
+
+bool IsLikeComparison(const parser::ExpressionType type) {
+  return type == parser::ExpressionType::COMPARE_LIKE || type == parser::ExpressionType::COMPARE_NOT_LIKE;
+}
+
+// The type a sql::VectorExpression computes values of the given type in. Integers are widened to BIGINT, as in
+// tuple-at-a-time code, so that arithmetic overflows at the same values.
+bool VectorType(const type::TypeId type, type::TypeId *vector_type) {
+  switch (type) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      *vector_type = type::TypeId::BIGINT;
+      return true;
+    case type::TypeId::DECIMAL:
+      *vector_type = type::TypeId::DECIMAL;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The sql::VectorExpression operation of a comparison, arithmetic or logical expression, if there is one
+bool VectorOp(const parser::ExpressionType type, sql::VectorExpression::Op *op) {
+  switch (type) {
+    case parser::ExpressionType::OPERATOR_PLUS:
+      *op = sql::VectorExpression::Op::Add;
+      return true;
+    case parser::ExpressionType::OPERATOR_MINUS:
+      *op = sql::VectorExpression::Op::Subtract;
+      return true;
+    case parser::ExpressionType::OPERATOR_MULTIPLY:
+      *op = sql::VectorExpression::Op::Multiply;
+      return true;
+    case parser::ExpressionType::OPERATOR_DIVIDE:
+      *op = sql::VectorExpression::Op::Divide;
+      return true;
+    case parser::ExpressionType::OPERATOR_MOD:
+      *op = sql::VectorExpression::Op::Modulo;
+      return true;
+    case parser::ExpressionType::COMPARE_EQUAL:
+      *op = sql::VectorExpression::Op::Equal;
+      return true;
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+      *op = sql::VectorExpression::Op::NotEqual;
+      return true;
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      *op = sql::VectorExpression::Op::LessThan;
+      return true;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      *op = sql::VectorExpression::Op::LessThanEqual;
+      return true;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      *op = sql::VectorExpression::Op::GreaterThan;
+      return true;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      *op = sql::VectorExpression::Op::GreaterThanEqual;
+      return true;
+    case parser::ExpressionType::CONJUNCTION_AND:
+      *op = sql::VectorExpression::Op::And;
+      return true;
+    case parser::ExpressionType::CONJUNCTION_OR:
+      *op = sql::VectorExpression::Op::Or;
+      return true;
+    case parser::ExpressionType::OPERATOR_NOT:
+      *op = sql::VectorExpression::Op::Not;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsVectorArithmetic(const sql::VectorExpression::Op op) { return op <= sql::VectorExpression::Op::Modulo; }
+
+bool IsVectorLogic(const sql::VectorExpression::Op op) { return op >= sql::VectorExpression::Op::And; }
+
+}  // namespace
+
 SeqScanTranslator::SeqScanTranslator(const terrier::planner::SeqScanPlanNode *op, CodeGen *codegen)
     : OperatorTranslator(codegen),
       op_(op),
@@ -21,9 +228,81 @@ SeqScanTranslator::SeqScanTranslator(const terrier::planner::SeqScanPlanNode *op
       is_vectorizable_{IsVectorizable(op_->GetScanPredicate().Get())},
       tvi_(codegen->NewIdentifier("tvi")),
       col_oids_(codegen->NewIdentifier("col_oids")),
+      filter_col_oids_(codegen->NewIdentifier("filter_col_oids")),
       pci_(codegen->NewIdentifier("pci")),
       slot_(codegen->NewIdentifier("slot")),
-      pci_type_{codegen->Context()->GetIdentifier("ProjectedColumnsIterator")} {}
+      pci_type_{codegen->Context()->GetIdentifier("ProjectedColumnsIterator")},
+      filter_manager_(codegen->NewIdentifier("filter_manager")) {
+  // Run the conjuncts the PCI filters evaluate through a filter manager, if there are several of them
+  if (has_predicate_ && is_vectorizable_) {
+    SplitConjuncts(op_->GetScanPredicate().Get());
+    if (pci_conjuncts_.size() > 1) {
+      for (uint32_t clause_idx = 0; clause_idx < pci_conjuncts_.size(); clause_idx++) {
+        clause_fns_.emplace_back(codegen->NewIdentifier("filterClause"));
+      }
+    }
+  }
+  // Defer the columns the predicate does not read, if there are any
+  if (has_predicate_ && !is_vectorizable_) {
+    CollectColumnOids(op_->GetScanPredicate().Get(), &filter_oids_);
+    late_materialize_ = !filter_oids_.empty() && filter_oids_.size() < input_oids_.size();
+  }
+}
+
+void SeqScanTranslator::SplitConjuncts(const terrier::parser::AbstractExpression *predicate) {
+  if (predicate->GetExpressionType() == terrier::parser::ExpressionType::CONJUNCTION_AND) {
+    SplitConjuncts(predicate->GetChild(0).Get());
+    SplitConjuncts(predicate->GetChild(1).Get());
+    return;
+  }
+  if (IsPCIFilter(predicate)) {
+    pci_conjuncts_.emplace_back(predicate);
+  } else {
+    vector_conjuncts_.emplace_back(predicate);
+  }
+}
+
+// filter_manager : FilterManager
+void SeqScanTranslator::InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) {
+  if (clause_fns_.empty()) return;
+  ast::Expr *fm_type = codegen_->BuiltinType(ast::BuiltinType::Kind::FilterManager);
+  state_fields->emplace_back(codegen_->MakeField(filter_manager_, fm_type));
+}
+
+// fun filterClause(pci: *ProjectedColumnsIterator) -> uint32 { return @filterLt(pci, ...) } for each clause
+void SeqScanTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  for (uint32_t clause_idx = 0; clause_idx < clause_fns_.size(); clause_idx++) {
+    util::RegionVector<ast::FieldDecl *> params({codegen_->MakeField(pci_, codegen_->PointerType(pci_type_))},
+                                                codegen_->Region());
+    ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Uint32);
+    FunctionBuilder builder(codegen_, clause_fns_[clause_idx], std::move(params), ret_type);
+    builder.Append(codegen_->ReturnStmt(PCIFilterCall(pci_conjuncts_[clause_idx])));
+    decls->emplace_back(builder.Finish());
+  }
+}
+
+// @filterManagerInit(&state.filter_manager)
+// @filterManagerInsertFilter(&state.filter_manager, filterClause) for each clause
+// @filterManagerFinalize(&state.filter_manager)
+void SeqScanTranslator::InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) {
+  if (clause_fns_.empty()) return;
+  ast::Expr *init_call = codegen_->OneArgStateCall(ast::Builtin::FilterManagerInit, filter_manager_);
+  setup_stmts->emplace_back(codegen_->MakeStmt(init_call));
+  for (const auto &clause_fn : clause_fns_) {
+    std::vector<ast::Expr *> insert_args{codegen_->GetStateMemberPtr(filter_manager_), codegen_->MakeExpr(clause_fn)};
+    ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::FilterManagerInsertFilter, std::move(insert_args));
+    setup_stmts->emplace_back(codegen_->MakeStmt(insert_call));
+  }
+  ast::Expr *finalize_call = codegen_->OneArgStateCall(ast::Builtin::FilterManagerFinalize, filter_manager_);
+  setup_stmts->emplace_back(codegen_->MakeStmt(finalize_call));
+}
+
+// @filterManagerFree(&state.filter_manager)
+void SeqScanTranslator::InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) {
+  if (clause_fns_.empty()) return;
+  ast::Expr *free_call = codegen_->OneArgStateCall(ast::Builtin::FilterManagerFree, filter_manager_);
+  teardown_stmts->emplace_back(codegen_->MakeStmt(free_call));
+}
 
 void SeqScanTranslator::Produce(FunctionBuilder *builder) {
   SetOids(builder);
@@ -49,17 +328,26 @@ void SeqScanTranslator::Abort(FunctionBuilder *builder) {
 }
 
 void SeqScanTranslator::DoTableScan(FunctionBuilder *builder) {
+  if (parent_translator_->ConsumesVectors()) {
+    DoVectorScan(builder);
+    return;
+  }
   // Start looping over the table
   GenTVILoop(builder);
   DeclarePCI(builder);
   // The PCI loop depends on whether we vectorize or not.
   bool has_if_stmt = false;
   if (is_vectorizable_) {
-    if (has_predicate_) GenVectorizedPredicate(builder, op_->GetScanPredicate().Get());
+    if (has_predicate_) GenVectorizedPredicate(builder);
+    parent_translator_->GenChildVectorHash(builder);
+    is_filtered_ = parent_translator_->GenChildVectorFilter(builder) || has_predicate_;
     GenPCILoop(builder);
   } else {
+    if (late_materialize_) GenLateMaterializedFilter(builder);
+    parent_translator_->GenChildVectorHash(builder);
+    is_filtered_ = parent_translator_->GenChildVectorFilter(builder) || late_materialize_;
     GenPCILoop(builder);
-    if (has_predicate_) {
+    if (has_predicate_ && !late_materialize_) {
       GenScanCondition(builder);
       has_if_stmt = true;
     }
@@ -78,6 +366,22 @@ void SeqScanTranslator::DoTableScan(FunctionBuilder *builder) {
   builder->FinishBlockStmt();
 }
 
+void SeqScanTranslator::DoVectorScan(FunctionBuilder *builder) {
+  GenTVILoop(builder);
+  DeclarePCI(builder);
+  // Leave the PCI filtered
+  if (has_predicate_) {
+    if (is_vectorizable_) {
+      GenVectorizedPredicate(builder);
+    } else {
+      GenLateMaterializedFilter(builder);
+    }
+  }
+  parent_translator_->ConsumeVector(builder);
+  // Close TVI loop
+  builder->FinishBlockStmt();
+}
+
 void SeqScanTranslator::Consume(FunctionBuilder *builder) {
   // This is called in nested loop joins
   DoTableScan(builder);
@@ -91,6 +395,56 @@ ast::Expr *SeqScanTranslator::GetOutput(uint32_t attr_idx) {
   return translator->DeriveExpr(this);
 }
 
+bool SeqScanTranslator::GetColumnRef(const terrier::parser::AbstractExpression *expr, uint16_t *col_idx,
+                                     type::TypeId *col_type) {
+  // Look through references to the output
+  if (expr->GetExpressionType() == terrier::parser::ExpressionType::VALUE_TUPLE) {
+    auto dve = dynamic_cast<const terrier::parser::DerivedValueExpression *>(expr);
+    if (dve->GetTupleIdx() != 0) return false;
+    expr = op_->GetOutputSchema()->GetColumn(static_cast<uint32_t>(dve->GetValueIdx())).GetExpr().Get();
+  }
+  if (expr->GetExpressionType() != terrier::parser::ExpressionType::COLUMN_VALUE) return false;
+  auto col_oid = dynamic_cast<const terrier::parser::ColumnValueExpression *>(expr)->GetColumnOid();
+  auto it = pm_.find(col_oid);
+  if (it == pm_.end()) return false;
+  *col_idx = it->second;
+  *col_type = schema_.GetColumn(col_oid).Type();
+  return true;
+}
+
+bool SeqScanTranslator::CanHashKeys(const std::vector<const terrier::parser::AbstractExpression *> &keys) {
+  if (keys.empty()) return false;
+  for (const auto *key : keys) {
+    uint16_t col_idx;
+    type::TypeId col_type;
+    if (!GetColumnRef(key, &col_idx, &col_type)) return false;
+    // @hash() takes integers, reals and strings
+    switch (col_type) {
+      case type::TypeId::TINYINT:
+      case type::TypeId::SMALLINT:
+      case type::TypeId::INTEGER:
+      case type::TypeId::BIGINT:
+      case type::TypeId::DECIMAL:
+      case type::TypeId::VARCHAR:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+void SeqScanTranslator::GenHashKeys(FunctionBuilder *builder,
+                                    const std::vector<const terrier::parser::AbstractExpression *> &keys) {
+  TERRIER_ASSERT(CanHashKeys(keys), "Keys cannot be hashed a vector at a time");
+  for (uint32_t key_idx = 0; key_idx < keys.size(); key_idx++) {
+    uint16_t col_idx;
+    type::TypeId col_type;
+    GetColumnRef(keys[key_idx], &col_idx, &col_type);
+    builder->Append(codegen_->MakeStmt(codegen_->PCIHashColumn(pci_, col_idx, col_type, key_idx > 0)));
+  }
+}
+
 ast::Expr *SeqScanTranslator::GetTableColumn(const catalog::col_oid_t &col_oid) {
   // Call @pciGetType(pci, index)
   auto type = schema_.GetColumn(col_oid).Type();
@@ -107,6 +461,129 @@ void SeqScanTranslator::DeclareTVI(FunctionBuilder *builder) {
   // Call @tableIterInit(&tvi, execCtx, table_oid, col_oids)
   ast::Expr *init_call = codegen_->TableIterInit(tvi_, !op_->GetTableOid(), col_oids_);
   builder->Append(codegen_->MakeStmt(init_call));
+
+  // Let the iterator skip blocks that the predicate rules out
+  if (has_predicate_) GenZoneMapFilters(builder, op_->GetScanPredicate().Get());
+  if (late_materialize_) GenSetFilterColumns(builder);
+}
+
+void SeqScanTranslator::CollectColumnOids(const terrier::parser::AbstractExpression *expr,
+                                          std::vector<catalog::col_oid_t> *col_oids) {
+  if (expr->GetExpressionType() == terrier::parser::ExpressionType::COLUMN_VALUE) {
+    auto col_oid = dynamic_cast<const terrier::parser::ColumnValueExpression *>(expr)->GetColumnOid();
+    if (std::find(col_oids->begin(), col_oids->end(), col_oid) == col_oids->end()) col_oids->push_back(col_oid);
+    return;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectColumnOids(child.Get(), col_oids);
+  }
+}
+
+void SeqScanTranslator::GenSetFilterColumns(FunctionBuilder *builder) {
+  // Declare: var filter_col_oids: [num_filter_cols]uint32
+  ast::Expr *arr_type = codegen_->ArrayType(filter_oids_.size(), ast::BuiltinType::Kind::Uint32);
+  builder->Append(codegen_->DeclareVariable(filter_col_oids_, arr_type, nullptr));
+  for (uint16_t i = 0; i < filter_oids_.size(); i++) {
+    ast::Expr *lhs = codegen_->ArrayAccess(filter_col_oids_, i);
+    ast::Expr *rhs = codegen_->IntLiteral(!filter_oids_[i]);
+    builder->Append(codegen_->Assign(lhs, rhs));
+  }
+
+  // Call @tableIterSetFilterColumns(&tvi, filter_col_oids)
+  ast::Expr *set_call = codegen_->BuiltinCall(ast::Builtin::TableIterSetFilterColumns,
+                                              {codegen_->PointerTo(tvi_), codegen_->MakeExpr(filter_col_oids_)});
+  builder->Append(codegen_->MakeStmt(set_call));
+}
+
+void SeqScanTranslator::GenLateMaterializedFilter(FunctionBuilder *builder) {
+  // for (; @pciHasNext(pci); @pciAdvance(pci)) { @pciMatch(pci, cond) }
+  is_filtered_ = false;
+  GenPCILoop(builder);
+  auto predicate = op_->GetScanPredicate();
+  auto cond_translator = TranslatorFactory::CreateExpressionTranslator(predicate.Get(), codegen_);
+  ast::Expr *match_call =
+      codegen_->BuiltinCall(ast::Builtin::PCIMatch, {codegen_->MakeExpr(pci_), cond_translator->DeriveExpr(this)});
+  builder->Append(codegen_->MakeStmt(match_call));
+  builder->FinishBlockStmt();
+
+  // @pciResetFiltered(pci)
+  ast::Expr *reset_call = codegen_->OneArgCall(ast::Builtin::PCIResetFiltered, pci_, false);
+  builder->Append(codegen_->MakeStmt(reset_call));
+  if (!late_materialize_) return;
+
+  // @tableIterMaterialize(&tvi)
+  ast::Expr *materialize_call = codegen_->OneArgCall(ast::Builtin::TableIterMaterialize, tvi_, true);
+  builder->Append(codegen_->MakeStmt(materialize_call));
+}
+
+void SeqScanTranslator::GenZoneMapFilters(FunctionBuilder *builder,
+                                          const terrier::parser::AbstractExpression *predicate) {
+  auto expr_type = predicate->GetExpressionType();
+  if (expr_type == terrier::parser::ExpressionType::CONJUNCTION_AND) {
+    GenZoneMapFilters(builder, predicate->GetChild(0).Get());
+    GenZoneMapFilters(builder, predicate->GetChild(1).Get());
+    return;
+  }
+  if (predicate->GetChildrenSize() != 2) return;
+
+  // Look for (col op const) or (const op col), flipping the comparison in the latter case
+  auto col_idx = 0, const_idx = 1;
+  if (predicate->GetChild(0)->GetExpressionType() == terrier::parser::ExpressionType::VALUE_CONSTANT) {
+    std::swap(col_idx, const_idx);
+    switch (expr_type) {
+      case terrier::parser::ExpressionType::COMPARE_LESS_THAN:
+        expr_type = terrier::parser::ExpressionType::COMPARE_GREATER_THAN;
+        break;
+      case terrier::parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+        expr_type = terrier::parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO;
+        break;
+      case terrier::parser::ExpressionType::COMPARE_GREATER_THAN:
+        expr_type = terrier::parser::ExpressionType::COMPARE_LESS_THAN;
+        break;
+      case terrier::parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+        expr_type = terrier::parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO;
+        break;
+      default:
+        break;
+    }
+  }
+  auto col_expr = dynamic_cast<const terrier::parser::ColumnValueExpression *>(predicate->GetChild(col_idx).Get());
+  auto const_expr =
+      dynamic_cast<const terrier::parser::ConstantValueExpression *>(predicate->GetChild(const_idx).Get());
+  if (col_expr == nullptr || const_expr == nullptr) return;
+  int64_t key;
+  if (!ZoneMapKey(const_expr->GetValue(), schema_.GetColumn(col_expr->GetColumnOid()).Type(), &key)) return;
+
+  // Convert the comparison into a range of keys
+  int64_t min_key = std::numeric_limits<int64_t>::min(), max_key = std::numeric_limits<int64_t>::max();
+  switch (expr_type) {
+    case terrier::parser::ExpressionType::COMPARE_EQUAL:
+      min_key = max_key = key;
+      break;
+    case terrier::parser::ExpressionType::COMPARE_LESS_THAN:
+      if (key == min_key) return;
+      max_key = key - 1;
+      break;
+    case terrier::parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      max_key = key;
+      break;
+    case terrier::parser::ExpressionType::COMPARE_GREATER_THAN:
+      if (key == max_key) return;
+      min_key = key + 1;
+      break;
+    case terrier::parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      min_key = key;
+      break;
+    default:
+      return;
+  }
+
+  // Call @tableIterAddRangeFilter(&tvi, col_oid, min_key, max_key)
+  ast::Expr *col_oid = codegen_->IntLiteral(!col_expr->GetColumnOid());
+  ast::Expr *filter_call = codegen_->BuiltinCall(
+      ast::Builtin::TableIterAddRangeFilter,
+      {codegen_->PointerTo(tvi_), col_oid, codegen_->IntLiteral(min_key), codegen_->IntLiteral(max_key)});
+  builder->Append(codegen_->MakeStmt(filter_call));
 }
 
 void SeqScanTranslator::SetOids(FunctionBuilder *builder) {
@@ -144,12 +621,10 @@ void SeqScanTranslator::DeclareSlot(FunctionBuilder *builder) {
 void SeqScanTranslator::GenPCILoop(FunctionBuilder *builder) {
   // Generate for(; @pciHasNext(pci); @pciAdvance(pci)) {...} or the Filtered version
   // The HasNext call
-  ast::Builtin has_next_fn =
-      (is_vectorizable_ && has_predicate_) ? ast::Builtin::PCIHasNextFiltered : ast::Builtin::PCIHasNext;
+  ast::Builtin has_next_fn = is_filtered_ ? ast::Builtin::PCIHasNextFiltered : ast::Builtin::PCIHasNext;
   ast::Expr *has_next_call = codegen_->OneArgCall(has_next_fn, pci_, false);
   // The Advance call
-  ast::Builtin advance_fn =
-      (is_vectorizable_ && has_predicate_) ? ast::Builtin::PCIAdvanceFiltered : ast::Builtin::PCIAdvance;
+  ast::Builtin advance_fn = is_filtered_ ? ast::Builtin::PCIAdvanceFiltered : ast::Builtin::PCIAdvance;
   ast::Expr *advance_call = codegen_->OneArgCall(advance_fn, pci_, false);
   ast::Stmt *loop_advance = codegen_->MakeStmt(advance_call);
   // Make the for loop.
@@ -176,61 +651,221 @@ void SeqScanTranslator::GenTVIReset(execution::compiler::FunctionBuilder *builde
   builder->Append(codegen_->MakeStmt(reset_call));
 }
 
-bool SeqScanTranslator::IsVectorizable(const terrier::parser::AbstractExpression *predicate) {
-  // TODO(Amadou): Does not currently work with negative numbers so it's commented out.
-  // Once that bug is fixed, comment back in.
-  /*
-  // Recursively walks down the query plan to ensure that predicate has the form ((colX comp int) AND (colY comp int)
-  ...) if (predicate == nullptr) return true;
+bool SeqScanTranslator::IsVectorizable(const terrier::parser::AbstractExpression *predicate) const {
+  // The predicate must have the form ((colX comp const) AND (colY comp const) ...)
+  if (predicate == nullptr) return true;
 
   if (predicate->GetExpressionType() == terrier::parser::ExpressionType::CONJUNCTION_AND) {
     return IsVectorizable(predicate->GetChild(0).Get()) && IsVectorizable(predicate->GetChild(1).Get());
   }
-  if (TranslatorFactory::IsComparisonOp(predicate->GetExpressionType())) {
-    // left is TVE and right is constant integer.
-    // TODO(Amadou): Add support for floats here and in the SIMD code.
-    // TODO(Amadou): Support right TVE and left constant integers. Be sure to flip inequalities while codegening.
-    return predicate->GetChild(0)->GetExpressionType() == terrier::parser::ExpressionType::COLUMN_VALUE &&
-        predicate->GetChild(1)->GetExpressionType() == terrier::parser::ExpressionType::VALUE_CONSTANT &&
-        (predicate->GetChild(1)->GetReturnValueType() >= terrier::type::TypeId::TINYINT &&
-            predicate->GetChild(1)->GetReturnValueType() <= terrier::type::TypeId::BIGINT);
-  }*/
-  return false;
+  if (IsPCIFilter(predicate)) return true;
+  // Anything else is evaluated a batch at a time, if it reads a column
+  type::TypeId type;
+  bool reads_column = false;
+  return IsVectorExpression(predicate, &type, &reads_column) && type == type::TypeId::BOOLEAN && reads_column;
 }
 
-void SeqScanTranslator::GenVectorizedPredicate(FunctionBuilder *builder,
-                                               const terrier::parser::AbstractExpression *predicate) {
-  if (predicate->GetExpressionType() == terrier::parser::ExpressionType::CONJUNCTION_AND) {
-    GenVectorizedPredicate(builder, predicate->GetChild(0).Get());
-    GenVectorizedPredicate(builder, predicate->GetChild(1).Get());
-  } else if (TranslatorFactory::IsComparisonOp(predicate->GetExpressionType())) {
-    auto left_cve = dynamic_cast<const terrier::parser::ColumnValueExpression *>(predicate->GetChild(0).Get());
-    auto col_idx = pm_[left_cve->GetColumnOid()];
-    auto col_type = schema_.GetColumn(left_cve->GetColumnOid()).Type();
-    auto const_val = dynamic_cast<const terrier::parser::ConstantValueExpression *>(predicate->GetChild(1).Get());
-    auto trans_val = const_val->GetValue();
-    auto type = trans_val.Type();
-    ast::Expr *filter_val;
-    switch (type) {
-      case terrier::type::TypeId::TINYINT:
-        filter_val = codegen_->IntLiteral(terrier::type::TransientValuePeeker::PeekTinyInt(trans_val));
-        break;
-      case terrier::type::TypeId::SMALLINT:
-        filter_val = codegen_->IntLiteral(terrier::type::TransientValuePeeker::PeekSmallInt(trans_val));
-        break;
-      case terrier::type::TypeId::INTEGER:
-        filter_val = codegen_->IntLiteral(terrier::type::TransientValuePeeker::PeekInteger(trans_val));
-        break;
-      case terrier::type::TypeId::BIGINT:
-        filter_val =
-            codegen_->IntLiteral(static_cast<int32_t>(terrier::type::TransientValuePeeker::PeekBigInt(trans_val)));
-        break;
-      default:
-        UNREACHABLE("Impossible vectorized predicate!");
+bool SeqScanTranslator::IsPCIFilter(const terrier::parser::AbstractExpression *predicate) const {
+  if (predicate->GetExpressionType() == terrier::parser::ExpressionType::CONJUNCTION_OR) {
+    catalog::col_oid_t col_oid;
+    std::vector<std::string_view> values;
+    return IsStringInList(predicate, &col_oid, &values);
+  }
+  if (!TranslatorFactory::IsComparisonOp(predicate->GetExpressionType())) return false;
+  // TODO(Amadou): Support right TVE and left constant integers. Be sure to flip inequalities while codegening.
+  auto col_expr = dynamic_cast<const terrier::parser::ColumnValueExpression *>(predicate->GetChild(0).Get());
+  auto const_expr = dynamic_cast<const terrier::parser::ConstantValueExpression *>(predicate->GetChild(1).Get());
+  if (col_expr == nullptr || const_expr == nullptr || pm_.count(col_expr->GetColumnOid()) == 0) return false;
+  const type::TypeId col_type = schema_.GetColumn(col_expr->GetColumnOid()).Type();
+  if (IsLikeComparison(predicate->GetExpressionType())) {
+    return col_type == type::TypeId::VARCHAR && IsFilterLikePattern(const_expr->GetValue());
+  }
+  return IsFilterValue(const_expr->GetValue(), col_type);
+}
+
+bool SeqScanTranslator::IsStringInList(const terrier::parser::AbstractExpression *predicate,
+                                       catalog::col_oid_t *col_oid, std::vector<std::string_view> *values) const {
+  if (predicate->GetExpressionType() == terrier::parser::ExpressionType::CONJUNCTION_OR) {
+    return IsStringInList(predicate->GetChild(0).Get(), col_oid, values) &&
+           IsStringInList(predicate->GetChild(1).Get(), col_oid, values);
+  }
+  if (predicate->GetExpressionType() != terrier::parser::ExpressionType::COMPARE_EQUAL) return false;
+  auto col_expr = dynamic_cast<const terrier::parser::ColumnValueExpression *>(predicate->GetChild(0).Get());
+  auto const_expr = dynamic_cast<const terrier::parser::ConstantValueExpression *>(predicate->GetChild(1).Get());
+  if (col_expr == nullptr || const_expr == nullptr || pm_.count(col_expr->GetColumnOid()) == 0) return false;
+  if (schema_.GetColumn(col_expr->GetColumnOid()).Type() != type::TypeId::VARCHAR) return false;
+  const auto &const_val = const_expr->GetValue();
+  if (!IsFilterValue(const_val, type::TypeId::VARCHAR)) return false;
+  // Every equality must be on the same column
+  if (!values->empty() && *col_oid != col_expr->GetColumnOid()) return false;
+  *col_oid = col_expr->GetColumnOid();
+  values->emplace_back(type::TransientValuePeeker::PeekVarChar(const_val));
+  return true;
+}
+
+bool SeqScanTranslator::IsVectorExpression(const terrier::parser::AbstractExpression *expr, type::TypeId *type,
+                                           bool *reads_column) const {
+  switch (expr->GetExpressionType()) {
+    case terrier::parser::ExpressionType::COLUMN_VALUE: {
+      auto col_oid = dynamic_cast<const terrier::parser::ColumnValueExpression *>(expr)->GetColumnOid();
+      if (pm_.count(col_oid) == 0) return false;
+      *reads_column = true;
+      return VectorType(schema_.GetColumn(col_oid).Type(), type);
+    }
+    case terrier::parser::ExpressionType::VALUE_CONSTANT: {
+      const auto &val = dynamic_cast<const terrier::parser::ConstantValueExpression *>(expr)->GetValue();
+      return !val.Null() && VectorType(val.Type(), type);
+    }
+    default:
+      break;
+  }
+
+  sql::VectorExpression::Op op;
+  if (!VectorOp(expr->GetExpressionType(), &op)) return false;
+  if (expr->GetChildrenSize() != (op == sql::VectorExpression::Op::Not ? 1u : 2u)) return false;
+  // The operands of a binary operation must compute the same type, which is BOOLEAN for logical operations
+  type::TypeId left_type, right_type;
+  if (!IsVectorExpression(expr->GetChild(0).Get(), &left_type, reads_column)) return false;
+  if (op == sql::VectorExpression::Op::Not) {
+    *type = type::TypeId::BOOLEAN;
+    return left_type == type::TypeId::BOOLEAN;
+  }
+  if (!IsVectorExpression(expr->GetChild(1).Get(), &right_type, reads_column) || left_type != right_type) return false;
+  if (IsVectorLogic(op) != (left_type == type::TypeId::BOOLEAN)) return false;
+  *type = IsVectorArithmetic(op) ? left_type : type::TypeId::BOOLEAN;
+  return true;
+}
+
+std::unique_ptr<sql::VectorExpression> SeqScanTranslator::MakeVectorExpression(
+    const terrier::parser::AbstractExpression *expr, std::vector<uint16_t> *col_idxs,
+    std::vector<type::TypeId> *col_types) const {
+  switch (expr->GetExpressionType()) {
+    case terrier::parser::ExpressionType::COLUMN_VALUE: {
+      auto col_oid = dynamic_cast<const terrier::parser::ColumnValueExpression *>(expr)->GetColumnOid();
+      const uint16_t col_idx = pm_.at(col_oid);
+      const type::TypeId col_type = schema_.GetColumn(col_oid).Type();
+      // Read every column once, and widen it to the type it is computed in
+      auto pos = static_cast<uint32_t>(std::find(col_idxs->begin(), col_idxs->end(), col_idx) - col_idxs->begin());
+      if (pos == col_idxs->size()) {
+        col_idxs->push_back(col_idx);
+        col_types->push_back(col_type);
+      }
+      auto column = sql::VectorExpression::Column(pos, col_type);
+      type::TypeId vector_type;
+      VectorType(col_type, &vector_type);
+      if (vector_type == col_type) return column;
+      std::vector<std::unique_ptr<sql::VectorExpression>> operands;
+      operands.emplace_back(std::move(column));
+      return sql::VectorExpression::Operation(sql::VectorExpression::Op::Cast, vector_type, std::move(operands));
+    }
+    case terrier::parser::ExpressionType::VALUE_CONSTANT: {
+      const auto &val = dynamic_cast<const terrier::parser::ConstantValueExpression *>(expr)->GetValue();
+      if (val.Type() == type::TypeId::DECIMAL) {
+        return sql::VectorExpression::DecimalConstant(type::TransientValuePeeker::PeekDecimal(val));
+      }
+      int64_t int_val;
+      IntegerFilterValue(val, type::TypeId::BIGINT, &int_val);
+      return sql::VectorExpression::IntegerConstant(int_val);
+    }
+    default:
+      break;
+  }
+
+  sql::VectorExpression::Op op;
+  VectorOp(expr->GetExpressionType(), &op);
+  std::vector<std::unique_ptr<sql::VectorExpression>> operands;
+  for (const auto &child : expr->GetChildren()) {
+    operands.emplace_back(MakeVectorExpression(child.Get(), col_idxs, col_types));
+  }
+  const type::TypeId type = IsVectorArithmetic(op) ? operands[0]->GetType() : type::TypeId::BOOLEAN;
+  return sql::VectorExpression::Operation(op, type, std::move(operands));
+}
+
+void SeqScanTranslator::GenVectorizedPredicate(FunctionBuilder *builder) {
+  // Run the cheap PCI filters first, so that the other conjuncts are evaluated on fewer tuples
+  if (!clause_fns_.empty()) {
+    // @filtersRun(&state.filter_manager, pci)
+    std::vector<ast::Expr *> run_args{codegen_->GetStateMemberPtr(filter_manager_), codegen_->MakeExpr(pci_)};
+    ast::Expr *run_call = codegen_->BuiltinCall(ast::Builtin::FilterManagerRunFilters, std::move(run_args));
+    builder->Append(codegen_->MakeStmt(run_call));
+  } else {
+    for (const auto *conjunct : pci_conjuncts_) {
+      builder->Append(codegen_->MakeStmt(PCIFilterCall(conjunct)));
+    }
+  }
+  if (!vector_conjuncts_.empty()) GenVectorFilter(builder, vector_conjuncts_);
+}
+
+void SeqScanTranslator::GenVectorFilter(FunctionBuilder *builder,
+                                        const std::vector<const terrier::parser::AbstractExpression *> &conjuncts) {
+  std::vector<uint16_t> col_idxs;
+  std::vector<type::TypeId> col_types;
+  std::unique_ptr<sql::VectorExpression> predicate;
+  for (const auto *conjunct : conjuncts) {
+    auto expr = MakeVectorExpression(conjunct, &col_idxs, &col_types);
+    if (predicate == nullptr) {
+      predicate = std::move(expr);
+      continue;
+    }
+    std::vector<std::unique_ptr<sql::VectorExpression>> operands;
+    operands.emplace_back(std::move(predicate));
+    operands.emplace_back(std::move(expr));
+    predicate =
+        sql::VectorExpression::Operation(sql::VectorExpression::Op::And, type::TypeId::BOOLEAN, std::move(operands));
+  }
+
+  // The filter is owned by the compiled query, which hands it to the execution context that runs it
+  const uint32_t filter_id = codegen_->AddVectorFilter(
+      std::make_unique<sql::VectorFilter>(std::move(col_idxs), std::move(col_types), std::move(predicate)));
+  builder->Append(codegen_->MakeStmt(codegen_->PCIFilterVector(pci_, filter_id)));
+}
+
+ast::Expr *SeqScanTranslator::PCIFilterCall(const terrier::parser::AbstractExpression *predicate) {
+  if (predicate->GetExpressionType() == terrier::parser::ExpressionType::CONJUNCTION_OR) {
+    // The strings are matched against the dictionary of the column, when the scanned block has one
+    catalog::col_oid_t col_oid;
+    std::vector<std::string_view> values;
+    UNUSED_ATTRIBUTE bool in_list = IsStringInList(predicate, &col_oid, &values);
+    TERRIER_ASSERT(in_list, "Vectorized disjunctions are IN lists");
+    return codegen_->PCIFilterInList(pci_, pm_[col_oid], values);
+  }
+  auto left_cve = dynamic_cast<const terrier::parser::ColumnValueExpression *>(predicate->GetChild(0).Get());
+  auto col_idx = pm_[left_cve->GetColumnOid()];
+  auto col_type = schema_.GetColumn(left_cve->GetColumnOid()).Type();
+  const auto &const_val =
+      dynamic_cast<const terrier::parser::ConstantValueExpression *>(predicate->GetChild(1).Get())->GetValue();
+  if (IsLikeComparison(predicate->GetExpressionType())) {
+    // The pattern is compiled once, when the query is compiled
+    return codegen_->PCIFilterLike(pci_, predicate->GetExpressionType(), col_idx,
+                                   type::TransientValuePeeker::PeekVarChar(const_val));
+  }
+  TERRIER_ASSERT(IsFilterValue(const_val, col_type), "Vectorized predicates compare with constants of the column type");
+  // Pass the constant in the representation MakeFilterVal expects
+  ast::Expr *filter_val;
+  switch (col_type) {
+    case type::TypeId::DATE:
+      filter_val = codegen_->IntLiteral(!type::TransientValuePeeker::PeekDate(const_val));
+      break;
+    case type::TypeId::TIMESTAMP:
+      filter_val = codegen_->IntLiteral(static_cast<int64_t>(!type::TransientValuePeeker::PeekTimestamp(const_val)));
+      break;
+    case type::TypeId::DECIMAL: {
+      const double dec = type::TransientValuePeeker::PeekDecimal(const_val);
+      int64_t bits;
+      std::memcpy(&bits, &dec, sizeof(bits));
+      filter_val = codegen_->IntLiteral(bits);
+      break;
+    }
+    case type::TypeId::VARCHAR:
+      filter_val = codegen_->StringLiteral(type::TransientValuePeeker::PeekVarChar(const_val));
+      break;
+    default: {
+      int64_t val;
+      IntegerFilterValue(const_val, col_type, &val);
+      filter_val = codegen_->IntLiteral(val);
+      break;
     }
-    ast::Expr *filter_call = codegen_->PCIFilter(pci_, predicate->GetExpressionType(), col_idx, col_type, filter_val);
-    builder->Append(codegen_->MakeStmt(filter_call));
   }
-  UNREACHABLE("This function should not be called on non vectorized predicates!");
+  return codegen_->PCIFilter(pci_, predicate->GetExpressionType(), col_idx, col_type, filter_val);
 }
 }  // namespace terrier::execution::compiler
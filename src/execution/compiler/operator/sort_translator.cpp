@@ -116,6 +116,8 @@ ast::Expr *SortBottomTranslator::GetAttribute(execution::ast::Identifier object,
 
 void SortBottomTranslator::GenComparisons(FunctionBuilder *builder) {
   // For each order by expr generate this (or its inverse depending on the ordering type):
+  // if (@sqlToBool(@isValNull(lhs.col_i)) and !@sqlToBool(@isValNull(rhs.col_i))) {return 1}
+  // if (!@sqlToBool(@isValNull(lhs.col_i)) and @sqlToBool(@isValNull(rhs.col_i))) {return -1}
   // if (lhs.col_i < rhs.col_i) {return -1}
   // if (lhs.col_i > rhs.col_i) {return 1}
   // ...
@@ -131,6 +133,22 @@ void SortBottomTranslator::GenComparisons(FunctionBuilder *builder) {
     }
     std::unique_ptr<ExpressionTranslator> key_translator =
         TranslatorFactory::CreateExpressionTranslator(order.first.Get(), codegen_);
+    // NULLs compare above every value, so that they are contiguous: last when ascending and first when descending
+    auto is_null = [&](CurrentRow row, bool negate) {
+      current_row_ = row;
+      ast::Expr *sql_is_null = codegen_->OneArgCall(ast::Builtin::IsValNull, key_translator->DeriveExpr(this));
+      ast::Expr *is_null = codegen_->OneArgCall(ast::Builtin::SqlToBool, sql_is_null);
+      return negate ? codegen_->UnaryOp(parsing::Token::Type::BANG, is_null) : is_null;
+    };
+    for (const bool lhs_null : {true, false}) {
+      // Generate if (lhs.col_i IS [NOT] NULL and rhs.col_i IS [NOT] NULL) {return ret_value;}
+      ast::Expr *if_cond =
+          codegen_->BinaryOp(parsing::Token::Type::AND, is_null(CurrentRow::Lhs, !lhs_null),
+                             is_null(CurrentRow::Rhs, lhs_null));
+      builder->StartIfStmt(if_cond);
+      builder->Append(codegen_->ReturnStmt(codegen_->IntLiteral(lhs_null ? -ret_value : ret_value)));
+      builder->FinishBlockStmt();
+    }
     for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
       // Get lhs.col_i
       current_row_ = CurrentRow::Lhs;
@@ -19,6 +19,7 @@
 #include "execution/compiler/operator/index_join_translator.h"
 #include "execution/compiler/operator/index_scan_translator.h"
 #include "execution/compiler/operator/insert_translator.h"
+#include "execution/compiler/operator/merge_join_translator.h"
 #include "execution/compiler/operator/nested_loop_translator.h"
 #include "execution/compiler/operator/projection_translator.h"
 #include "execution/compiler/operator/seq_scan_translator.h"
@@ -90,6 +91,8 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateLeftTranslator(
   switch (op->GetPlanNodeType()) {
     case terrier::planner::PlanNodeType::HASHJOIN:
       return std::make_unique<HashJoinLeftTranslator>(static_cast<const planner::HashJoinPlanNode *>(op), codegen);
+    case terrier::planner::PlanNodeType::MERGEJOIN:
+      return std::make_unique<MergeJoinLeftTranslator>(static_cast<const planner::MergeJoinPlanNode *>(op), codegen);
     case terrier::planner::PlanNodeType::NESTLOOP:
       return std::make_unique<NestedLoopLeftTranslator>(static_cast<const planner::NestedLoopJoinPlanNode *>(op),
                                                         codegen);
@@ -104,6 +107,9 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateRightTranslator(
     case terrier::planner::PlanNodeType::HASHJOIN:
       return std::make_unique<HashJoinRightTranslator>(static_cast<const planner::HashJoinPlanNode *>(op), codegen,
                                                        left);
+    case terrier::planner::PlanNodeType::MERGEJOIN:
+      return std::make_unique<MergeJoinRightTranslator>(static_cast<const planner::MergeJoinPlanNode *>(op), codegen,
+                                                        left);
     case terrier::planner::PlanNodeType::NESTLOOP:
       return std::make_unique<NestedLoopRightTranslator>(static_cast<const planner::NestedLoopJoinPlanNode *>(op),
                                                          codegen, left);
@@ -1,5 +1,7 @@
 #include "execution/exec/execution_context.h"
 #include "execution/sql/value.h"
+#include "optimizer/statistics/stats_storage.h"
+#include "optimizer/statistics/table_stats_delta.h"
 
 namespace terrier::execution::exec {
 
@@ -15,4 +17,23 @@ uint32_t ExecutionContext::ComputeTupleSize(const planner::OutputSchema *schema)
   return tuple_size;
 }
 
+optimizer::TableStatsDelta *ExecutionContext::GetTableStatsDelta(const catalog::table_oid_t table_oid) {
+  if (stats_storage_ == nullptr) return nullptr;
+  const auto delta_it = stats_deltas_.find(table_oid);
+  if (delta_it != stats_deltas_.end()) return delta_it->second.get();
+
+  // Aborted writes must not reach the statistics, so the delta is only applied once the transaction commits
+  auto delta = std::make_shared<optimizer::TableStatsDelta>();
+  txn_->RegisterCommitAction([stats_storage = stats_storage_, db_oid = db_oid_, table_oid, delta] {
+    stats_storage->ApplyTableStatsDelta(db_oid, table_oid, *delta);
+  });
+  return stats_deltas_.emplace(table_oid, std::move(delta)).first->second.get();
+}
+
+void ExecutionContext::ReportRows(const uint32_t probe_id, const uint64_t num_rows) {
+  if (stats_storage_ == nullptr || cardinality_probes_ == nullptr || probe_id >= cardinality_probes_->size()) return;
+  const auto &probe = (*cardinality_probes_)[probe_id];
+  stats_storage_->GetCardinalityFeedback()->RecordRows(probe.fragment_key_, probe.estimated_rows_, num_rows);
+}
+
 }  // namespace terrier::execution::exec
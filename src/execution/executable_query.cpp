@@ -29,6 +29,8 @@ ExecutableQuery::ExecutableQuery(const common::ManagedPointer<planner::AbstractP
   tpl_module_ = std::make_unique<vm::Module>(std::move(bytecode_module));
   region_ = codegen.ReleaseRegion();
   ast_ctx_ = codegen.ReleaseContext();
+  cardinality_probes_ = codegen.ReleaseCardinalityProbes();
+  vector_filters_ = codegen.ReleaseVectorFilters();
 }
 
 void ExecutableQuery::Run(const common::ManagedPointer<exec::ExecutionContext> exec_ctx, const vm::ExecutionMode mode) {
@@ -41,7 +43,13 @@ void ExecutableQuery::Run(const common::ManagedPointer<exec::ExecutionContext> e
         "(*ExecutionContext)->int32");
     return;
   }
+  const common::ManagedPointer<const std::vector<exec::CardinalityProbe>> probes(&cardinality_probes_);
+  exec_ctx->SetCardinalityProbes(probes);
+  const common::ManagedPointer<const std::vector<std::unique_ptr<sql::VectorFilter>>> filters(&vector_filters_);
+  exec_ctx->SetVectorFilters(filters);
   auto result = main(exec_ctx.Get());
+  exec_ctx->SetCardinalityProbes(nullptr);
+  exec_ctx->SetVectorFilters(nullptr);
   EXECUTION_LOG_DEBUG("main() returned: {}", result);
 }
 
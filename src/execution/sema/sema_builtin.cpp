@@ -37,6 +37,35 @@ bool AreAllFunctions(const ArgTypes... type) {
 
 void Sema::CheckBuiltinMapCall(UNUSED_ATTRIBUTE ast::CallExpr *call) {}
 
+void Sema::CheckBuiltinInitSqlNull(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 1)) {
+    return;
+  }
+
+  // The only argument must be a pointer to a SQL value, which is set to NULL
+  auto *pointee_type = call->Arguments()[0]->GetType()->GetPointeeType();
+  if (pointee_type == nullptr || !pointee_type->IsSqlValueType()) {
+    ReportIncorrectCallArg(call, 0, "pointer to SQL value");
+    return;
+  }
+
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
+void Sema::CheckBuiltinIsValNullCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 1)) {
+    return;
+  }
+
+  // The only argument is a SQL value, and the result is a non-NULL SQL boolean
+  if (!call->Arguments()[0]->GetType()->IsSqlValueType()) {
+    ReportIncorrectCallArg(call, 0, "SQL value");
+    return;
+  }
+
+  call->SetType(GetBuiltinType(ast::BuiltinType::Boolean));
+}
+
 void Sema::CheckBuiltinSqlConversionCall(ast::CallExpr *call, ast::Builtin builtin) {
   if (builtin == ast::Builtin::DateToSql) {
     if (!CheckArgCountAtLeast(call, 3)) return;
@@ -147,6 +176,106 @@ void Sema::CheckBuiltinFilterCall(ast::CallExpr *call) {
     return;
   }
 
+  // The fourth call argument is the filter value: an integer literal, or a string literal for string columns
+  if (!args[3]->IsIntegerLiteral() && !args[3]->IsStringLiteral()) {
+    ReportIncorrectCallArg(call, 3, GetBuiltinType(ast::BuiltinType::Int64));
+    return;
+  }
+
+  // Set return type
+  call->SetType(GetBuiltinType(ast::BuiltinType::Int64));
+}
+
+void Sema::CheckBuiltinFilterLikeCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 3)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first call argument must be a pointer to a ProjectedColumnsIterator
+  const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), pci_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(pci_kind)->PointerTo());
+    return;
+  }
+
+  // The second call argument must be an integer for the column index
+  if (!args[1]->IsIntegerLiteral()) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Int32));
+    return;
+  }
+
+  // The third call argument is the pattern, which must be a string literal so that it can be compiled once
+  if (!args[2]->IsStringLiteral()) {
+    ReportIncorrectCallArg(call, 2, ast::StringType::Get(GetContext()));
+    return;
+  }
+
+  // Set return type
+  call->SetType(GetBuiltinType(ast::BuiltinType::Int64));
+}
+
+void Sema::CheckBuiltinFilterInListCall(ast::CallExpr *call) {
+  if (!CheckArgCountAtLeast(call, 3)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first call argument must be a pointer to a ProjectedColumnsIterator
+  const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), pci_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(pci_kind)->PointerTo());
+    return;
+  }
+
+  // The second call argument must be an integer for the column index
+  if (!args[1]->IsIntegerLiteral()) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Int32));
+    return;
+  }
+
+  // The remaining call arguments are the strings of the list, which must be string literals so that the list can be
+  // built once
+  for (uint32_t arg_idx = 2; arg_idx < args.size(); arg_idx++) {
+    if (!args[arg_idx]->IsStringLiteral()) {
+      ReportIncorrectCallArg(call, arg_idx, ast::StringType::Get(GetContext()));
+      return;
+    }
+  }
+
+  // Set return type
+  call->SetType(GetBuiltinType(ast::BuiltinType::Int64));
+}
+
+void Sema::CheckBuiltinFilterVectorCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 3)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first call argument must be the execution context holding the filter
+  const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), exec_ctx_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(exec_ctx_kind)->PointerTo());
+    return;
+  }
+
+  // The second call argument must be a pointer to a ProjectedColumnsIterator
+  const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
+  if (!IsPointerToSpecificBuiltin(args[1]->GetType(), pci_kind)) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(pci_kind)->PointerTo());
+    return;
+  }
+
+  // The third call argument must be an integer literal for the id of the filter
+  if (!args[2]->IsIntegerLiteral()) {
+    ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint32));
+    return;
+  }
+
   // Set return type
   call->SetType(GetBuiltinType(ast::BuiltinType::Int64));
 }
@@ -218,6 +347,35 @@ void Sema::CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builti
       call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
       break;
     }
+    case ast::Builtin::AggHashTableSetDenseRange: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // The bounds of the key range are integer literals
+      for (uint32_t arg_idx = 1; arg_idx < 3; arg_idx++) {
+        if (!args[arg_idx]->IsIntegerLiteral()) {
+          ReportIncorrectCallArg(call, arg_idx, GetBuiltinType(ast::BuiltinType::Int64));
+          return;
+        }
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::AggHashTableInsertDense:
+    case ast::Builtin::AggHashTableLookupDense: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is the SQL integer key
+      const auto key_kind = ast::BuiltinType::Integer;
+      if (!args[1]->GetType()->IsSpecificBuiltin(key_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(key_kind));
+        return;
+      }
+      // Return a byte pointer
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
     case ast::Builtin::AggHashTableProcessBatch: {
       if (!CheckArgCount(call, 7)) {
         return;
@@ -291,6 +449,30 @@ void Sema::CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builti
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::AggHashTableNextSpilledPartition: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is an opaque context pointer
+      if (!args[1]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(agg_ht_kind));
+        return;
+      }
+      // Third argument is the merging function
+      if (!args[2]->GetType()->IsFunctionType()) {
+        ReportIncorrectCallArg(call, 2, "function");
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::AggHashTableGetSpilledPartition: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(agg_ht_kind)->PointerTo());
+      break;
+    }
     case ast::Builtin::AggHashTableFree: {
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
@@ -434,6 +616,33 @@ void Sema::CheckBuiltinAggregatorCall(ast::CallExpr *call, ast::Builtin builtin)
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::AggAdvanceBatch: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // First argument to @aggAdvanceBatch() must be a SQL aggregator reading a column, second must be a PCI
+      const auto agg_type = args[0]->GetType();
+      if (!IsPointerToAggregatorValue(agg_type) ||
+          agg_type->GetPointeeType()->As<ast::BuiltinType>()->GetKind() == ast::BuiltinType::Kind::CountStarAggregate) {
+        GetErrorReporter()->Report(call->Position(), ErrorMessages::kNotASQLAggregate, agg_type);
+        return;
+      }
+      const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), pci_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(pci_kind)->PointerTo());
+        return;
+      }
+      // The index and type of the input column are integer literals
+      for (uint32_t idx = 2; idx < 4; idx++) {
+        if (!args[idx]->IsIntegerLiteral()) {
+          ReportIncorrectCallArg(call, idx, GetBuiltinType(ast::BuiltinType::Int32));
+          return;
+        }
+      }
+      // Advance returns nil
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::AggMerge: {
       if (!CheckArgCount(call, 2)) {
         return;
@@ -603,6 +812,150 @@ void Sema::CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin buil
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinJoinHashTableBloomFilter(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // The first argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableEnableBloomFilter: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      // This call returns nothing
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableFilterProbe: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument must be a pointer to a ProjectedColumnsIterator
+      const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
+      if (!IsPointerToSpecificBuiltin(call_args[1]->GetType(), pci_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(pci_kind)->PointerTo());
+        return;
+      }
+      // Third argument must be a function (*ProjectedColumnsIterator) -> uint64 computing the probe hash
+      // clang-format off
+      auto *hash_fn_type = call_args[2]->GetType()->SafeAs<ast::FunctionType>();
+      if (hash_fn_type == nullptr ||                                                 // not a function
+          !hash_fn_type->ReturnType()->IsSpecificBuiltin(ast::BuiltinType::Uint64) ||  // doesn't return a hash
+          hash_fn_type->NumParams() != 1 ||                                          // isn't a single-arg func
+          !IsPointerToSpecificBuiltin(hash_fn_type->Params()[0].type_, pci_kind)) {  // first arg isn't a *PCI
+        ReportIncorrectCallArg(call, 2, "(*ProjectedColumnsIterator)->uint64");
+        return;
+      }
+      // clang-format on
+      // This call returns the number of selected tuples
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint32));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table bloom filter call");
+    }
+  }
+}
+
+void Sema::CheckBuiltinJoinHashTableGetTupleCount(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 1)) {
+    return;
+  }
+
+  // The first and only argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(call->Arguments()[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  // This call returns the number of build tuples
+  call->SetType(GetBuiltinType(ast::BuiltinType::Uint64));
+}
+
+void Sema::CheckBuiltinJoinHashTableSpill(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableIsPartitionSpilled:
+    case ast::Builtin::JoinHashTableSpillProbe: {
+      const bool is_spill = builtin == ast::Builtin::JoinHashTableSpillProbe;
+      if (!CheckArgCount(call, is_spill ? 4 : 2)) {
+        return;
+      }
+      // The second argument is the hash value of the probe tuple
+      if (!args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      if (!is_spill) {
+        call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+        break;
+      }
+      // The third argument is a pointer to the probe tuple, and the fourth its size
+      if (!args[2]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 2, "pointer to probe tuple");
+        return;
+      }
+      if (!args[3]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint32)) {
+        ReportIncorrectCallArg(call, 3, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextSpilledPartition: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // The second argument tells whether partitions without probe tuples are loaded too
+      if (!args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Bool)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Bool));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextSpilledProbe: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::JoinHashTableGetSpilledProbe: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table spill call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinJoinHashTableFree(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -730,8 +1083,8 @@ void Sema::CheckBuiltinJoinHashTableIterClose(execution::ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
-void Sema::CheckBuiltinExecutionContextCall(ast::CallExpr *call, UNUSED_ATTRIBUTE ast::Builtin builtin) {
-  if (!CheckArgCount(call, 1)) {
+void Sema::CheckBuiltinExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
     return;
   }
 
@@ -743,8 +1096,37 @@ void Sema::CheckBuiltinExecutionContextCall(ast::CallExpr *call, UNUSED_ATTRIBUT
     return;
   }
 
-  auto mem_pool_kind = ast::BuiltinType::MemoryPool;
-  call->SetType(GetBuiltinType(mem_pool_kind)->PointerTo());
+  switch (builtin) {
+    case ast::Builtin::ExecutionContextGetMemoryPool: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      auto mem_pool_kind = ast::BuiltinType::MemoryPool;
+      call->SetType(GetBuiltinType(mem_pool_kind)->PointerTo());
+      break;
+    }
+    case ast::Builtin::ExecutionContextReportRows: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is the 32-bit id of the cardinality probe
+      if (!call_args[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      // Third argument is the 64-bit number of rows
+      if (!call_args[2]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      // This call returns nothing
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible execution context call");
+    }
+  }
 }
 
 void Sema::CheckBuiltinThreadStateContainerCall(ast::CallExpr *call, ast::Builtin builtin) {
@@ -892,6 +1274,52 @@ void Sema::CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin)
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::TableIterAddRangeFilter: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // The column oid and the bounds of the range are integer literals
+      for (uint32_t arg_idx = 1; arg_idx < 4; arg_idx++) {
+        if (!call_args[arg_idx]->IsIntegerLiteral()) {
+          ReportIncorrectCallArg(call, arg_idx, GetBuiltinType(ast::BuiltinType::Int64));
+          return;
+        }
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::TableIterSetFilterColumns: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // The second argument is a fixed length uint32_t array
+      const auto *arr_type = call_args[1]->GetType()->SafeAs<ast::ArrayType>();
+      if (arr_type == nullptr || !arr_type->ElementType()->IsSpecificBuiltin(ast::BuiltinType::Uint32) ||
+          !arr_type->HasKnownLength()) {
+        ReportIncorrectCallArg(call, 1, "Second argument should be a fixed length uint32 array");
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::TableIterMaterialize: {
+      // Return nothing
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::TableIterFetchRow: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // The second argument is a pointer to the tuple slot
+      const auto tuple_slot_kind = ast::BuiltinType::TupleSlot;
+      if (!IsPointerToSpecificBuiltin(call_args[1]->GetType(), tuple_slot_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(tuple_slot_kind)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::ProjectedRow)->PointerTo());
+      break;
+    }
     case ast::Builtin::TableIterAdvance: {
       // A single-arg builtin returning a boolean
       call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
@@ -1013,6 +1441,32 @@ void Sema::CheckBuiltinPCICall(ast::CallExpr *call, ast::Builtin builtin) {
       call->SetType(GetBuiltinType(ast::BuiltinType::TupleSlot));
       break;
     }
+    case ast::Builtin::PCIGetHash: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint64));
+      break;
+    }
+    case ast::Builtin::PCIHashColumn: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // The index and type of the key column are integer literals
+      for (uint32_t idx = 1; idx < 3; idx++) {
+        if (!call->Arguments()[idx]->IsIntegerLiteral()) {
+          ReportIncorrectCallArg(call, idx, GetBuiltinType(ast::BuiltinType::Int32));
+          return;
+        }
+      }
+      // Whether to combine with the hashes of earlier key columns is a boolean literal
+      if (!call->Arguments()[3]->IsBooleanLiteral()) {
+        ReportIncorrectCallArg(call, 3, GetBuiltinType(ast::BuiltinType::Bool));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::PCIGetBool:
     case ast::Builtin::PCIGetBoolNull: {
       call->SetType(GetBuiltinType(ast::BuiltinType::Boolean));
@@ -1167,6 +1621,24 @@ void Sema::CheckMathTrigCall(ast::CallExpr *call, ast::Builtin builtin) {
   call->SetType(GetBuiltinType(real_kind));
 }
 
+void Sema::CheckBuiltinLikeCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 2)) {
+    return;
+  }
+
+  // Both the input string and the pattern are SQL strings
+  const auto string_kind = ast::BuiltinType::StringVal;
+  for (uint32_t arg_idx = 0; arg_idx < 2; arg_idx++) {
+    if (!call->Arguments()[arg_idx]->GetType()->IsSpecificBuiltin(string_kind)) {
+      ReportIncorrectCallArg(call, arg_idx, GetBuiltinType(string_kind));
+      return;
+    }
+  }
+
+  // The result is a SQL boolean
+  call->SetType(GetBuiltinType(ast::BuiltinType::Boolean));
+}
+
 void Sema::CheckBuiltinSizeOfCall(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -1214,6 +1686,53 @@ void Sema::CheckBuiltinPtrCastCall(ast::CallExpr *call) {
   call->SetType(call->Arguments()[0]->GetType());
 }
 
+void Sema::CheckBuiltinJoinHashTableEntryIterCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first argument must be a pointer to a JoinHashTableEntryIterator
+  const auto iter_kind = ast::BuiltinType::JoinHashTableEntryIterator;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), iter_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(iter_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableEntryIterInit: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+
+      // The second argument is the join hash table to iterate over
+      const auto jht_kind = ast::BuiltinType::JoinHashTable;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), jht_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(jht_kind)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableEntryIterHasNext: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::JoinHashTableEntryIterNext: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableEntryIterGetRow: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table entry iteration call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinSorterInit(ast::CallExpr *call) {
   if (!CheckArgCount(call, 4)) {
     return;
@@ -1395,6 +1914,60 @@ void Sema::CheckBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin)
   }
 }
 
+void Sema::CheckBuiltinMergeJoinCursorCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first argument must be a pointer to a MergeJoinCursor
+  const auto cursor_kind = ast::BuiltinType::MergeJoinCursor;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), cursor_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(cursor_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::MergeJoinCursorInit: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+
+      // The second argument is the sorter holding the left input of the merge join
+      const auto sorter_kind = ast::BuiltinType::Sorter;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), sorter_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(sorter_kind)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorHasNext:
+    case ast::Builtin::MergeJoinCursorRunHasNext: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorGetRow:
+    case ast::Builtin::MergeJoinCursorRunGetRow: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorNext:
+    case ast::Builtin::MergeJoinCursorAddToRun:
+    case ast::Builtin::MergeJoinCursorClearRun:
+    case ast::Builtin::MergeJoinCursorRunInit:
+    case ast::Builtin::MergeJoinCursorRunNext:
+    case ast::Builtin::MergeJoinCursorFree: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible merge join cursor call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinOutputAlloc(execution::ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -1520,9 +2093,12 @@ void Sema::CheckBuiltinIndexIteratorScan(execution::ast::CallExpr *call, ast::Bu
   }
 
   switch (builtin) {
+    case ast::Builtin::IndexIteratorSetIndexOnly:
     case ast::Builtin::IndexIteratorScanKey:
     case ast::Builtin::IndexIteratorScanAscending:
-    case ast::Builtin::IndexIteratorScanDescending: {
+    case ast::Builtin::IndexIteratorScanDescending:
+    case ast::Builtin::IndexIteratorAddRange:
+    case ast::Builtin::IndexIteratorScanRanges: {
       if (!CheckArgCount(call, 1)) return;
       break;
     }
@@ -1589,6 +2165,7 @@ void Sema::CheckBuiltinIndexIteratorPRCall(ast::CallExpr *call, ast::Builtin bui
     case ast::Builtin::IndexIteratorGetLoPR:
     case ast::Builtin::IndexIteratorGetHiPR:
     case ast::Builtin::IndexIteratorGetTablePR:
+    case ast::Builtin::IndexIteratorGetKeyPR:
       call->SetType(GetBuiltinType(ast::BuiltinType::ProjectedRow)->PointerTo());
       break;
     case ast::Builtin::IndexIteratorGetSlot:
@@ -2001,6 +2578,14 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSqlConversionCall(call, builtin);
       break;
     }
+    case ast::Builtin::InitSqlNull: {
+      CheckBuiltinInitSqlNull(call);
+      break;
+    }
+    case ast::Builtin::IsValNull: {
+      CheckBuiltinIsValNullCall(call);
+      break;
+    }
     case ast::Builtin::FilterEq:
     case ast::Builtin::FilterGe:
     case ast::Builtin::FilterGt:
@@ -2010,7 +2595,21 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinFilterCall(call);
       break;
     }
-    case ast::Builtin::ExecutionContextGetMemoryPool: {
+    case ast::Builtin::FilterLike:
+    case ast::Builtin::FilterNotLike: {
+      CheckBuiltinFilterLikeCall(call);
+      break;
+    }
+    case ast::Builtin::FilterInList: {
+      CheckBuiltinFilterInListCall(call);
+      break;
+    }
+    case ast::Builtin::FilterVector: {
+      CheckBuiltinFilterVectorCall(call);
+      break;
+    }
+    case ast::Builtin::ExecutionContextGetMemoryPool:
+    case ast::Builtin::ExecutionContextReportRows: {
       CheckBuiltinExecutionContextCall(call, builtin);
       break;
     }
@@ -2023,6 +2622,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     }
     case ast::Builtin::TableIterInit:
     case ast::Builtin::TableIterInitBind:
+    case ast::Builtin::TableIterAddRangeFilter:
+    case ast::Builtin::TableIterSetFilterColumns:
+    case ast::Builtin::TableIterMaterialize:
+    case ast::Builtin::TableIterFetchRow:
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterReset:
     case ast::Builtin::TableIterGetPCI:
@@ -2040,6 +2643,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::PCIAdvance:
     case ast::Builtin::PCIAdvanceFiltered:
     case ast::Builtin::PCIGetSlot:
+    case ast::Builtin::PCIGetHash:
+    case ast::Builtin::PCIHashColumn:
     case ast::Builtin::PCIMatch:
     case ast::Builtin::PCIReset:
     case ast::Builtin::PCIResetFiltered:
@@ -2079,9 +2684,14 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::AggHashTableInit:
     case ast::Builtin::AggHashTableInsert:
     case ast::Builtin::AggHashTableLookup:
+    case ast::Builtin::AggHashTableSetDenseRange:
+    case ast::Builtin::AggHashTableInsertDense:
+    case ast::Builtin::AggHashTableLookupDense:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
+    case ast::Builtin::AggHashTableNextSpilledPartition:
+    case ast::Builtin::AggHashTableGetSpilledPartition:
     case ast::Builtin::AggHashTableFree: {
       CheckBuiltinAggHashTableCall(call, builtin);
       break;
@@ -2103,6 +2713,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     }
     case ast::Builtin::AggInit:
     case ast::Builtin::AggAdvance:
+    case ast::Builtin::AggAdvanceBatch:
     case ast::Builtin::AggMerge:
     case ast::Builtin::AggReset:
     case ast::Builtin::AggResult: {
@@ -2133,11 +2744,35 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinJoinHashTableIterClose(call);
       break;
     }
+    case ast::Builtin::JoinHashTableEntryIterInit:
+    case ast::Builtin::JoinHashTableEntryIterHasNext:
+    case ast::Builtin::JoinHashTableEntryIterNext:
+    case ast::Builtin::JoinHashTableEntryIterGetRow: {
+      CheckBuiltinJoinHashTableEntryIterCall(call, builtin);
+      break;
+    }
     case ast::Builtin::JoinHashTableBuild:
     case ast::Builtin::JoinHashTableBuildParallel: {
       CheckBuiltinJoinHashTableBuild(call, builtin);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableBloomFilter:
+    case ast::Builtin::JoinHashTableFilterProbe: {
+      CheckBuiltinJoinHashTableBloomFilter(call, builtin);
+      break;
+    }
+    case ast::Builtin::JoinHashTableGetTupleCount: {
+      CheckBuiltinJoinHashTableGetTupleCount(call);
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsPartitionSpilled:
+    case ast::Builtin::JoinHashTableSpillProbe:
+    case ast::Builtin::JoinHashTableNextSpilledPartition:
+    case ast::Builtin::JoinHashTableNextSpilledProbe:
+    case ast::Builtin::JoinHashTableGetSpilledProbe: {
+      CheckBuiltinJoinHashTableSpill(call, builtin);
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       CheckBuiltinJoinHashTableFree(call);
       break;
@@ -2168,6 +2803,20 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSorterIterCall(call, builtin);
       break;
     }
+    case ast::Builtin::MergeJoinCursorInit:
+    case ast::Builtin::MergeJoinCursorHasNext:
+    case ast::Builtin::MergeJoinCursorNext:
+    case ast::Builtin::MergeJoinCursorGetRow:
+    case ast::Builtin::MergeJoinCursorAddToRun:
+    case ast::Builtin::MergeJoinCursorClearRun:
+    case ast::Builtin::MergeJoinCursorRunInit:
+    case ast::Builtin::MergeJoinCursorRunHasNext:
+    case ast::Builtin::MergeJoinCursorRunNext:
+    case ast::Builtin::MergeJoinCursorRunGetRow:
+    case ast::Builtin::MergeJoinCursorFree: {
+      CheckBuiltinMergeJoinCursorCall(call, builtin);
+      break;
+    }
     case ast::Builtin::SizeOf: {
       CheckBuiltinSizeOfCall(call);
       break;
@@ -2185,11 +2834,14 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinIndexIteratorInit(call, builtin);
       break;
     }
+    case ast::Builtin::IndexIteratorSetIndexOnly:
     case ast::Builtin::IndexIteratorScanKey:
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitAscending:
-    case ast::Builtin::IndexIteratorScanLimitDescending: {
+    case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorAddRange:
+    case ast::Builtin::IndexIteratorScanRanges: {
       CheckBuiltinIndexIteratorScan(call, builtin);
       break;
     }
@@ -2201,7 +2853,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorGetLoPR:
     case ast::Builtin::IndexIteratorGetHiPR:
     case ast::Builtin::IndexIteratorGetSlot:
-    case ast::Builtin::IndexIteratorGetTablePR: {
+    case ast::Builtin::IndexIteratorGetTablePR:
+    case ast::Builtin::IndexIteratorGetKeyPR: {
       CheckBuiltinIndexIteratorPRCall(call, builtin);
       break;
     }
@@ -2220,6 +2873,11 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckMathTrigCall(call, builtin);
       break;
     }
+    case ast::Builtin::Like:
+    case ast::Builtin::NotLike: {
+      CheckBuiltinLikeCall(call);
+      break;
+    }
     case ast::Builtin::PRSetBool:
     case ast::Builtin::PRSetTinyInt:
     case ast::Builtin::PRSetSmallInt:
@@ -3,10 +3,13 @@
 #include <tbb/tbb.h>
 
 #include <algorithm>
+#include <limits>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "common/math_util.h"
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/projected_columns_iterator.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/bit_util.h"
@@ -33,7 +36,13 @@ AggregationHashTable::AggregationHashTable(MemoryPool *memory, const std::size_t
       partition_tails_(nullptr),
       partition_estimates_(nullptr),
       partition_tables_(nullptr),
-      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(K_DEFAULT_NUM_PARTITIONS) - 1)) {
+      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(K_DEFAULT_NUM_PARTITIONS) - 1)),
+      memory_budget_(MemoryTracker::K_UNLIMITED),
+      spill_threshold_(std::numeric_limits<uint64_t>::max()),
+      next_spilled_partition_(0),
+      spilled_partition_table_(nullptr),
+      dense_min_key_(0),
+      dense_groups_(memory_) {
   hash_table_.SetSize(initial_size);
   max_fill_ =
       static_cast<uint64_t>(std::llround(static_cast<float>(hash_table_.Capacity()) * hash_table_.LoadFactor()));
@@ -44,6 +53,10 @@ AggregationHashTable::AggregationHashTable(MemoryPool *memory, const std::size_t
   flush_threshold_ = static_cast<uint64_t>(
       std::llround(static_cast<float>(l2_size) / static_cast<float>(entries_.ElementSize()) * K_DEFAULT_LOAD_FACTOR));
   flush_threshold_ = std::max(static_cast<uint64_t>(256), common::MathUtil::PowerOf2Floor(flush_threshold_));
+
+  if (memory_->GetTracker() != nullptr) {
+    SetMemoryBudget(memory_->GetTracker()->GetMemoryLimit());
+  }
 }
 
 AggregationHashTable::~AggregationHashTable() {
@@ -74,6 +87,15 @@ AggregationHashTable::~AggregationHashTable() {
   }
 }
 
+void AggregationHashTable::SetMemoryBudget(const std::size_t memory_budget) {
+  memory_budget_ = memory_budget;
+  if (memory_budget == MemoryTracker::K_UNLIMITED) {
+    spill_threshold_ = std::numeric_limits<uint64_t>::max();
+  } else {
+    spill_threshold_ = std::max(uint64_t(1), memory_budget / entries_.ElementSize());
+  }
+}
+
 void AggregationHashTable::Grow() {
   // Resize table
   const uint64_t new_size = hash_table_.Capacity() * 2;
@@ -92,6 +114,13 @@ void AggregationHashTable::Grow() {
 }
 
 byte *AggregationHashTable::Insert(const hash_t hash) {
+  if (NeedsToSpillGroups()) {
+    SpillGroups();
+  }
+  return InsertEntry(hash);
+}
+
+byte *AggregationHashTable::InsertEntry(const hash_t hash) {
   // Grow if need be
   if (NeedsToGrow()) {
     Grow();
@@ -109,8 +138,36 @@ byte *AggregationHashTable::Insert(const hash_t hash) {
   return entry->payload_;
 }
 
+void AggregationHashTable::SetDenseKeyRange(const int64_t min_key, const int64_t max_key) {
+  TERRIER_ASSERT(NumElements() == 0, "Only empty tables can be made dense");
+  TERRIER_ASSERT(min_key <= max_key, "Invalid key range");
+  dense_min_key_ = min_key;
+  // One slot per key, plus one for the NULL key
+  dense_groups_.assign(static_cast<uint64_t>(max_key - min_key) + 2, nullptr);
+}
+
+byte *AggregationHashTable::InsertDense(const Integer &key) {
+  // The key serves as the hash, so that iteration and growth work as usual, and so that keys outside of the range can
+  // be found in the hash index
+  if (UNLIKELY(!InDenseRange(key))) {
+    TERRIER_ASSERT(LookupDenseOverflow(key.val_) == nullptr, "Group already exists");
+    return InsertEntry(static_cast<hash_t>(key.val_));
+  }
+  const uint64_t slot = DenseSlot(key);
+  TERRIER_ASSERT(dense_groups_[slot] == nullptr, "Group already exists");
+  byte *payload = InsertEntry(static_cast<hash_t>(key.is_null_ ? dense_min_key_ : key.val_));
+  dense_groups_[slot] = payload;
+  return payload;
+}
+
 byte *AggregationHashTable::InsertPartitioned(const hash_t hash) {
-  byte *ret = Insert(hash);
+  // The hash table is only empty right after a flush, at which point the last
+  // flushed entry has been filled in by the caller and it's safe to spill.
+  if (hash_table_.NumElements() == 0 && NeedsToSpill()) {
+    SpillOverflowPartitions();
+  }
+
+  byte *ret = InsertEntry(hash);
   if (hash_table_.NumElements() >= flush_threshold_) {
     FlushToOverflowPartitions();
   }
@@ -152,10 +209,115 @@ void AggregationHashTable::AllocateOverflowPartitions() {
   }
 }
 
+bool AggregationHashTable::NeedsToSpill() const {
+  if (partition_heads_ == nullptr || entries_.size() == 0) {
+    return false;
+  }
+  // Spill if we're over our own budget, or if the query as a whole is
+  return entries_.size() >= spill_threshold_ ||
+         (memory_->GetTracker() != nullptr && memory_->GetTracker()->IsOverLimit());
+}
+
+void AggregationHashTable::AllocateSpilledPartitions() {
+  if (spilled_partitions_.empty()) {
+    spilled_partitions_.reserve(K_DEFAULT_NUM_PARTITIONS);
+    for (uint32_t i = 0; i < K_DEFAULT_NUM_PARTITIONS; i++) {
+      spilled_partitions_.emplace_back(memory_, entries_.ElementSize(), K_SPILL_BUFFER_SIZE);
+    }
+  }
+}
+
+void AggregationHashTable::SpillOverflowPartitions() {
+  TERRIER_ASSERT(hash_table_.NumElements() == 0, "All entries must be flushed to overflow partitions before spilling");
+  TERRIER_ASSERT(owned_entries_.empty(), "Cannot spill entries owned by other tables");
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  AllocateSpilledPartitions();
+  if (spill_file_ == nullptr) {
+    spill_file_ = std::make_unique<SpillFile>();
+  }
+
+  // Append each overflow partition to its spilled counterpart. Partitions are
+  // written out one at a time so only a single write buffer is ever allocated.
+  for (uint32_t part_idx = 0; part_idx < K_DEFAULT_NUM_PARTITIONS; part_idx++) {
+    auto &spilled = spilled_partitions_[part_idx];
+    for (const HashTableEntry *entry = partition_heads_[part_idx]; entry != nullptr; entry = entry->next_) {
+      spilled.Append(spill_file_.get(), reinterpret_cast<const byte *>(entry));
+    }
+    spilled.Flush(spill_file_.get());
+  }
+
+  // All partial aggregates are on disk now, release their memory
+  const uint64_t num_spilled = entries_.size();
+  std::fill(partition_heads_, partition_heads_ + K_DEFAULT_NUM_PARTITIONS, nullptr);
+  std::fill(partition_tails_, partition_tails_ + K_DEFAULT_NUM_PARTITIONS, nullptr);
+  entries_ = decltype(entries_)(entries_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("AHT: spilled {} partial aggregates in {} ms", num_spilled, timer.Elapsed());
+
+  // Update stats
+  stats_.num_spills_++;
+}
+
+bool AggregationHashTable::NeedsToSpillGroups() const {
+  if (memory_budget_ == MemoryTracker::K_UNLIMITED || IsDense() || hash_table_.NumElements() == 0) {
+    return false;
+  }
+  if (entries_.size() >= spill_threshold_) {
+    return true;
+  }
+  // Summing up the query's memory usage visits every thread's counter, so only do it every so often
+  return entries_.size() % K_QUERY_LIMIT_CHECK_INTERVAL == 0 && memory_->GetTracker() != nullptr &&
+         memory_->GetTracker()->IsOverLimit();
+}
+
+void AggregationHashTable::SpillGroups() {
+  FlushToOverflowPartitions();
+  SpillOverflowPartitions();
+}
+
+bool AggregationHashTable::NextSpilledPartition(void *const query_state,
+                                                const AggregationHashTable::MergePartitionFn merge_partition_fn) {
+  if (!HasSpilled()) {
+    return false;
+  }
+
+  // Release the table of the previous partition
+  if (spilled_partition_table_ != nullptr) {
+    spilled_partition_table_->~AggregationHashTable();
+    memory_->Deallocate(spilled_partition_table_, sizeof(AggregationHashTable));
+    partition_tables_[next_spilled_partition_ - 1] = nullptr;
+    spilled_partition_table_ = nullptr;
+  }
+
+  // The groups in memory are partial aggregates of the spilled ones
+  if (hash_table_.NumElements() > 0) {
+    SpillGroups();
+  }
+
+  while (next_spilled_partition_ < K_DEFAULT_NUM_PARTITIONS && !IsPartitionNonEmpty(next_spilled_partition_)) {
+    next_spilled_partition_++;
+  }
+  if (next_spilled_partition_ == K_DEFAULT_NUM_PARTITIONS) {
+    return false;
+  }
+
+  merge_partition_fn_ = merge_partition_fn;
+  spilled_partition_table_ = BuildTableOverPartition(query_state, next_spilled_partition_++);
+  return true;
+}
+
 void AggregationHashTable::ProcessBatch(ProjectedColumnsIterator *iters[], AggregationHashTable::HashFn hash_fn,
                                         KeyEqFn key_eq_fn, AggregationHashTable::InitAggFn init_agg_fn,
                                         AggregationHashTable::AdvanceAggFn advance_agg_fn) {
   TERRIER_ASSERT(iters != nullptr, "Null input iterators!");
+  // Spill before the batch looks up its groups, so that they stay in memory until it's done
+  if (NeedsToSpillGroups()) {
+    SpillGroups();
+  }
   const uint32_t num_elems = iters[0]->NumSelected();
 
   // Temporary vector for the hash values and hash table entry pointers
@@ -169,6 +331,19 @@ void AggregationHashTable::ProcessBatch(ProjectedColumnsIterator *iters[], Aggre
   }
 }
 
+void AggregationHashTable::ProcessBatch(ProjectedColumnsIterator *iters[], const uint32_t key_col_idxs[],
+                                        const type::TypeId key_col_types[], const uint32_t num_key_cols,
+                                        AggregationHashTable::KeyEqFn key_eq_fn,
+                                        AggregationHashTable::InitAggFn init_agg_fn,
+                                        AggregationHashTable::AdvanceAggFn advance_agg_fn) {
+  TERRIER_ASSERT(iters != nullptr, "Null input iterators!");
+  iters[0]->HashColumns(key_col_idxs, key_col_types, num_key_cols);
+
+  // Read the hashes back from the iterator
+  const HashFn hash_fn = [](void *input) { return reinterpret_cast<ProjectedColumnsIterator **>(input)[0]->GetHash(); };
+  ProcessBatch(iters, hash_fn, key_eq_fn, init_agg_fn, advance_agg_fn);
+}
+
 template <bool PCIIsFiltered>
 void AggregationHashTable::ProcessBatchImpl(ProjectedColumnsIterator *iters[], uint32_t num_elems, hash_t hashes[],
                                             HashTableEntry *entries[], AggregationHashTable::HashFn hash_fn,
@@ -311,7 +486,7 @@ void AggregationHashTable::CreateMissingGroups(ProjectedColumnsIterator *iters[]
     }
 
     // Initialize
-    init_agg_fn(Insert(hash), iters);
+    init_agg_fn(InsertEntry(hash), iters);
   }
 }
 
@@ -360,6 +535,19 @@ void AggregationHashTable::TransferMemoryAndPartitions(
     // overflow partitions contain all partial aggregates
     table->FlushToOverflowPartitions();
 
+    // If the table is over budget, spill what it has buffered rather than
+    // taking it over, and then take over all the table's spilled partitions
+    if (table->NeedsToSpill()) {
+      table->SpillOverflowPartitions();
+    }
+    if (table->HasSpilled()) {
+      AllocateSpilledPartitions();
+      for (uint32_t part_idx = 0; part_idx < K_DEFAULT_NUM_PARTITIONS; part_idx++) {
+        spilled_partitions_[part_idx].Adopt(&table->spilled_partitions_[part_idx]);
+      }
+      owned_spill_files_.emplace_back(std::move(table->spill_file_));
+    }
+
     // Now, move over their memory
     owned_entries_.emplace_back(std::move(table->entries_));
 
@@ -376,9 +564,10 @@ void AggregationHashTable::TransferMemoryAndPartitions(
         if (partition_tails_[part_idx] == nullptr) {
           partition_tails_[part_idx] = table->partition_tails_[part_idx];
         }
-        // Update the partition's unique-count estimate
-        partition_estimates_[part_idx]->Merge(table->partition_estimates_[part_idx]);
       }
+      // Update the partition's unique-count estimate. The estimate also covers
+      // spilled aggregates, so merge it even if the partition list is empty.
+      partition_estimates_[part_idx]->Merge(table->partition_estimates_[part_idx]);
     }
   }
 }
@@ -386,8 +575,7 @@ void AggregationHashTable::TransferMemoryAndPartitions(
 AggregationHashTable *AggregationHashTable::BuildTableOverPartition(void *const query_state,
                                                                     const uint32_t partition_idx) {
   TERRIER_ASSERT(partition_idx < K_DEFAULT_NUM_PARTITIONS, "Out-of-bounds partition access");
-  TERRIER_ASSERT(partition_heads_[partition_idx] != nullptr,
-                 "Should not build aggregation table over empty partition!");
+  TERRIER_ASSERT(IsPartitionNonEmpty(partition_idx), "Should not build aggregation table over empty partition!");
 
   // If the table has already been built, return it
   if (partition_tables_[partition_idx] != nullptr) {
@@ -398,12 +586,19 @@ AggregationHashTable *AggregationHashTable::BuildTableOverPartition(void *const
   auto estimated_size = partition_estimates_[partition_idx]->Estimate();
   auto *agg_table = new (memory_->AllocateAligned(sizeof(AggregationHashTable), alignof(AggregationHashTable), false))
       AggregationHashTable(memory_, payload_size_, static_cast<uint32_t>(estimated_size));
+  // The merged partition is scanned straight away, so it has to stay in memory
+  agg_table->SetMemoryBudget(MemoryTracker::K_UNLIMITED);
 
   util::Timer<std::milli> timer;
   timer.Start();
 
-  // Build it
-  AggregationOverflowPartitionIterator iter(partition_heads_ + partition_idx, partition_heads_ + partition_idx + 1);
+  // Build it, reading back the spilled portion of the partition, if any
+  std::unique_ptr<SpillPartitionReader> spilled;
+  if (HasSpilled() && spilled_partitions_[partition_idx].NumEntries() > 0) {
+    spilled = std::make_unique<SpillPartitionReader>(&spilled_partitions_[partition_idx]);
+  }
+  AggregationOverflowPartitionIterator iter(partition_heads_ + partition_idx, partition_heads_ + partition_idx + 1,
+                                            spilled.get());
   merge_partition_fn_(query_state, agg_table, &iter);
 
   timer.Stop();
@@ -438,9 +633,18 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
 
   // Determine the non-empty overflow partitions
   alignas(common::Constants::CACHELINE_SIZE) uint32_t nonempty_parts[K_DEFAULT_NUM_PARTITIONS];
-  uint32_t num_nonempty_parts =
-      util::VectorUtil::FilterNe(reinterpret_cast<const intptr_t *>(partition_heads_), K_DEFAULT_NUM_PARTITIONS,
-                                 intptr_t(0), nonempty_parts, nullptr);
+  uint32_t num_nonempty_parts = 0;
+  if (HasSpilled()) {
+    for (uint32_t part_idx = 0; part_idx < K_DEFAULT_NUM_PARTITIONS; part_idx++) {
+      if (IsPartitionNonEmpty(part_idx)) {
+        nonempty_parts[num_nonempty_parts++] = part_idx;
+      }
+    }
+  } else {
+    num_nonempty_parts =
+        util::VectorUtil::FilterNe(reinterpret_cast<const intptr_t *>(partition_heads_), K_DEFAULT_NUM_PARTITIONS,
+                                   intptr_t(0), nonempty_parts, nullptr);
+  }
 
   tbb::parallel_for_each(nonempty_parts, nonempty_parts + num_nonempty_parts, [&](const uint32_t part_idx) {
     // Build a hash table over the given partition
@@ -451,6 +655,14 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
 
     // Scan the partition
     scan_fn(query_state, thread_state, agg_table_part);
+
+    // When spilling, the partitions may not all fit in memory together. Release
+    // each partition's table once it's been scanned.
+    if (HasSpilled()) {
+      agg_table_part->~AggregationHashTable();
+      memory_->Deallocate(agg_table_part, sizeof(AggregationHashTable));
+      partition_tables_[part_idx] = nullptr;
+    }
   });
 }
 
@@ -0,0 +1,283 @@
+#include "execution/sql/analyze_executor.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_accessor.h"
+#include "catalog/schema.h"
+#include "common/allocator.h"
+#include "common/constants.h"
+#include "execution/util/execution_common.h"
+#include "optimizer/statistics/column_stats.h"
+#include "optimizer/statistics/column_summary.h"
+#include "optimizer/statistics/histogram.h"
+#include "optimizer/statistics/stats_storage.h"
+#include "optimizer/statistics/top_k_elements.h"
+#include "planner/plannodes/analyze_plan_node.h"
+#include "storage/sql_table.h"
+#include "type/type_util.h"
+
+namespace terrier::execution::sql {
+
+namespace {
+
+// The width of the count-min sketch backing the most common values
+constexpr uint64_t K_SKETCH_WIDTH = 1024;
+// Samples are drawn from a fixed seed, so that analyzing unchanged data gives the same statistics
+constexpr uint64_t K_SAMPLE_SEED = 0xA7A1;
+// The number of blocks scanned by one task
+constexpr std::size_t K_BLOCKS_PER_TASK = 1;
+
+// A column to analyze
+struct AnalyzedColumn {
+  catalog::col_oid_t col_oid_;
+  type::TypeId type_;
+  // The index of the column in the scanned ProjectedColumns
+  uint16_t pc_index_;
+  // The size of a value in the scanned ProjectedColumns
+  uint32_t attr_size_;
+  // The index of the column among the sampled ones, if it is numeric
+  std::optional<uint32_t> sample_index_;
+};
+
+// The statistics of a range of blocks: a summary of every value of each column, and a uniform sample of up to
+// K_SAMPLE_SIZE rows holding the numeric columns. Only the histograms and most common values of numeric columns are
+// built from the sample. Analyses of adjacent ranges merge into the analysis of their union.
+class RangeAnalysis {
+ public:
+  RangeAnalysis(const std::size_t num_columns, const std::size_t num_sampled, const uint64_t seed)
+      : summaries_(num_columns), sample_(num_sampled), seed_(seed) {}
+
+  // Scan the blocks from @em begin up to @em stop, and sample their rows with reservoir sampling (Algorithm R): the
+  // first K_SAMPLE_SIZE rows fill the sample, and every later row replaces a random slot with a probability that keeps
+  // each row equally likely to be in the sample.
+  void Scan(const common::ManagedPointer<transaction::TransactionContext> txn,
+            const common::ManagedPointer<storage::SqlTable> table, const storage::ProjectedColumnsInitializer &pc_init,
+            const std::vector<AnalyzedColumn> &columns, storage::DataTable::SlotIterator begin,
+            const storage::DataTable::SlotIterator &stop) {
+    std::unique_ptr<byte[]> buffer(common::AllocationUtil::AllocateAligned(pc_init.ProjectedColumnsSize()));
+    storage::ProjectedColumns *const pc = pc_init.Initialize(buffer.get());
+    std::mt19937_64 generator(seed_);
+    std::vector<std::pair<uint32_t, uint32_t>> picks;
+    while (begin != stop && begin != table->end()) {
+      table->Scan(txn, &begin, pc, nullptr, &stop);
+
+      // The rows of the batch that enter the sample, as (position in batch, slot in sample) pairs
+      picks.clear();
+      for (uint32_t pos = 0; pos < pc->NumTuples(); pos++, num_rows_++) {
+        if (num_rows_ < AnalyzeExecutor::K_SAMPLE_SIZE) {
+          picks.emplace_back(pos, static_cast<uint32_t>(num_rows_));
+        } else if (const uint64_t slot = std::uniform_int_distribution<uint64_t>(0, num_rows_)(generator);
+                   slot < AnalyzeExecutor::K_SAMPLE_SIZE) {
+          picks.emplace_back(pos, static_cast<uint32_t>(slot));
+        }
+      }
+
+      for (uint32_t i = 0; i < columns.size(); i++) Consume(pc, columns[i], picks, &summaries_[i]);
+    }
+
+    // Merging takes sampled rows in order, so put them in a random one
+    const uint64_t num_sampled = std::min<uint64_t>(num_rows_, AnalyzeExecutor::K_SAMPLE_SIZE);
+    std::vector<uint32_t> order(num_sampled);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), generator);
+    for (auto &values : sample_) {
+      std::vector<double> shuffled(num_sampled);
+      for (uint64_t i = 0; i < num_sampled; i++) shuffled[i] = values[order[i]];
+      values = std::move(shuffled);
+    }
+  }
+
+  // Merge the analysis of an adjacent range into this one. The merged sample draws rows without replacement from the
+  // rows of both ranges, each of which is represented by its sample in random order. It is therefore a uniform sample
+  // of the union, itself in random order.
+  void Merge(RangeAnalysis &&other) {
+    for (uint32_t i = 0; i < summaries_.size(); i++) summaries_[i].Merge(other.summaries_[i]);
+
+    std::mt19937_64 generator(seed_ * 31 + other.seed_);
+    const uint64_t num_sampled = std::min<uint64_t>(num_rows_ + other.num_rows_, AnalyzeExecutor::K_SAMPLE_SIZE);
+    std::vector<std::vector<double>> merged(sample_.size());
+    for (auto &values : merged) values.reserve(num_sampled);
+    uint64_t taken = 0, other_taken = 0;
+    for (uint64_t i = 0; i < num_sampled; i++) {
+      const uint64_t remaining = num_rows_ - taken, other_remaining = other.num_rows_ - other_taken;
+      const bool take_own = std::uniform_int_distribution<uint64_t>(0, remaining + other_remaining - 1)(generator) <
+                            remaining;
+      for (uint32_t col = 0; col < merged.size(); col++) {
+        merged[col].push_back(take_own ? sample_[col][taken] : other.sample_[col][other_taken]);
+      }
+      (take_own ? taken : other_taken)++;
+    }
+    sample_ = std::move(merged);
+    num_rows_ += other.num_rows_;
+  }
+
+  // Summarize a column in a ColumnStats
+  optimizer::ColumnStats Finish(const catalog::db_oid_t database_oid, const catalog::table_oid_t table_oid,
+                                const AnalyzedColumn &column, const uint32_t col_index) const {
+    const auto &summary = summaries_[col_index];
+    const uint64_t num_nulls = summary.GetNumNulls();
+    const double frac_null = num_rows_ == 0 ? 0.0 : static_cast<double>(num_nulls) / static_cast<double>(num_rows_);
+    const auto cardinality = static_cast<double>(summary.EstimateCardinality());
+
+    std::vector<double> common_vals, common_freqs, histogram_bounds;
+    if (column.sample_index_.has_value()) {
+      const auto &sample = sample_[*column.sample_index_];
+      optimizer::Histogram<double> histogram(AnalyzeExecutor::K_HISTOGRAM_BINS);
+      optimizer::TopKElements<double> top_k(AnalyzeExecutor::K_NUM_COMMON_VALUES, K_SKETCH_WIDTH);
+      for (const double value : sample) {
+        if (std::isnan(value)) continue;
+        histogram.Increment(value);
+        top_k.Increment(value, 1);
+      }
+
+      // A histogram of a single distinct value has no inner bounds, so bound it by that value
+      histogram_bounds = histogram.Uniform();
+      if (histogram_bounds.empty() && histogram.GetTotalValueCount() > 0) {
+        histogram_bounds.push_back(histogram.GetMaxValue());
+      }
+
+      // Frequencies are in rows of the whole table, not of the sample
+      const double scale = sample.empty() ? 0.0 : static_cast<double>(num_rows_) / static_cast<double>(sample.size());
+      for (const double value : top_k.GetSortedTopKeys()) {
+        common_vals.push_back(value);
+        common_freqs.push_back(static_cast<double>(top_k.EstimateItemCount(value)) * scale);
+      }
+    }
+
+    return optimizer::ColumnStats(database_oid, table_oid, column.col_oid_, num_rows_, cardinality, frac_null,
+                                  std::move(common_vals), std::move(common_freqs), std::move(histogram_bounds), true);
+  }
+
+  // Hand over the summary of a column's values, after Finish
+  optimizer::ColumnSummary TakeSummary(const uint32_t col_index) { return std::move(summaries_[col_index]); }
+
+  uint64_t GetNumRows() const { return num_rows_; }
+
+ private:
+  // Marks NULLs in the sample
+  static constexpr double K_NULL_SAMPLE = std::numeric_limits<double>::quiet_NaN();
+
+  // Account for the values of a column in a scanned batch, and copy the picked ones into their slots of the sample
+  void Consume(storage::ProjectedColumns *const pc, const AnalyzedColumn &column,
+               const std::vector<std::pair<uint32_t, uint32_t>> &picks, optimizer::ColumnSummary *const summary) {
+    const byte *const values = pc->ColumnStart(column.pc_index_);
+    const common::RawBitmap *const valid = pc->ColumnNullBitmap(column.pc_index_);
+    for (uint32_t pos = 0; pos < pc->NumTuples(); pos++) {
+      if (!valid->Test(pos)) {
+        summary->AddNull();
+      } else {
+        summary->Add(column.type_, values + pos * column.attr_size_);
+      }
+    }
+
+    if (!column.sample_index_.has_value()) return;
+    auto &sample = sample_[*column.sample_index_];
+    for (const auto &[pos, slot] : picks) {
+      const double value = valid->Test(pos)
+                               ? optimizer::ColumnSummary::ReadNumeric(column.type_, values + pos * column.attr_size_)
+                               : K_NULL_SAMPLE;
+      if (slot == sample.size()) {
+        sample.push_back(value);
+      } else {
+        sample[slot] = value;
+      }
+    }
+  }
+
+  // Distinct values, NULLs and min/max of every scanned row, kept by the TableStats for later DML to merge into
+  std::vector<optimizer::ColumnSummary> summaries_;
+  // The values of each numeric column in the sampled rows
+  std::vector<std::vector<double>> sample_;
+  uint64_t num_rows_{0};
+  // Seeds the sampling of the range
+  uint64_t seed_;
+};
+
+}  // namespace
+
+bool AnalyzeExecutor::AnalyzeTableExecutor(const common::ManagedPointer<planner::AnalyzePlanNode> node,
+                                           const common::ManagedPointer<catalog::CatalogAccessor> accessor,
+                                           const common::ManagedPointer<transaction::TransactionContext> txn,
+                                           const common::ManagedPointer<optimizer::StatsStorage> stats_storage) {
+  const auto table = accessor->GetTable(node->GetTableOid());
+  if (table == nullptr) return false;
+  const auto &schema = accessor->GetSchema(node->GetTableOid());
+
+  // No columns means all of them
+  std::vector<catalog::col_oid_t> col_oids = node->GetColumnOids();
+  if (col_oids.empty()) {
+    for (const auto &column : schema.GetColumns()) col_oids.push_back(column.Oid());
+  }
+
+  auto table_stats = AnalyzeTable(txn, table, schema, node->GetDatabaseOid(), node->GetTableOid(), col_oids);
+  stats_storage->ReplaceTableStats(node->GetDatabaseOid(), node->GetTableOid(), std::move(table_stats));
+  return true;
+}
+
+optimizer::TableStats AnalyzeExecutor::AnalyzeTable(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                                    const common::ManagedPointer<storage::SqlTable> table,
+                                                    const catalog::Schema &schema,
+                                                    const catalog::db_oid_t database_oid,
+                                                    const catalog::table_oid_t table_oid,
+                                                    const std::vector<catalog::col_oid_t> &col_oids) {
+  const auto pc_init = table->InitializerForProjectedColumns(col_oids, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  const auto projection_map = table->ProjectionMapForOids(col_oids);
+
+  std::vector<AnalyzedColumn> columns;
+  columns.reserve(col_oids.size());
+  uint32_t num_sampled = 0;
+  for (const auto &col_oid : col_oids) {
+    const type::TypeId type = schema.GetColumn(col_oid).Type();
+    const bool is_varlen = type == type::TypeId::VARCHAR || type == type::TypeId::VARBINARY;
+    const uint32_t attr_size = is_varlen ? sizeof(storage::VarlenEntry) : type::TypeUtil::GetTypeSize(type);
+    std::optional<uint32_t> sample_index;
+    if (optimizer::ColumnSummary::IsNumeric(type)) sample_index = num_sampled++;
+    columns.push_back({col_oid, type, projection_map.at(col_oid), attr_size, sample_index});
+  }
+
+  // Every task scans a range of blocks, and the analyses of adjacent ranges are merged up to the whole table. The
+  // ranges and the order of merges only depend on the number of blocks, so that the sample is reproducible.
+  const std::vector<storage::DataTable::SlotIterator> blocks = table->BlockBegins();
+  const storage::DataTable::SlotIterator end = table->end();
+  RangeAnalysis analysis = tbb::parallel_deterministic_reduce(
+      tbb::blocked_range<std::size_t>(0, blocks.size(), K_BLOCKS_PER_TASK),
+      RangeAnalysis(columns.size(), num_sampled, K_SAMPLE_SEED),
+      [&](const tbb::blocked_range<std::size_t> &range, RangeAnalysis partial) {
+        RangeAnalysis scanned(columns.size(), num_sampled, K_SAMPLE_SEED + range.begin());
+        scanned.Scan(txn, table, pc_init, columns, blocks[range.begin()],
+                     range.end() == blocks.size() ? end : blocks[range.end()]);
+        partial.Merge(std::move(scanned));
+        return partial;
+      },
+      [](RangeAnalysis lhs, RangeAnalysis rhs) {
+        lhs.Merge(std::move(rhs));
+        return lhs;
+      });
+
+  std::vector<optimizer::ColumnStats> column_stats(columns.size());
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, columns.size()),
+                    [&](const tbb::blocked_range<std::size_t> &range) {
+                      for (std::size_t i = range.begin(); i != range.end(); i++) {
+                        column_stats[i] = analysis.Finish(database_oid, table_oid, columns[i], i);
+                      }
+                    });
+  optimizer::TableStats table_stats(database_oid, table_oid, analysis.GetNumRows(), true, column_stats);
+  for (uint32_t i = 0; i < columns.size(); i++) {
+    table_stats.SetColumnSummary(columns[i].col_oid_, analysis.TakeSummary(i));
+  }
+  return table_stats;
+}
+
+}  // namespace terrier::execution::sql
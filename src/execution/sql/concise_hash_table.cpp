@@ -22,6 +22,8 @@ void ConciseHashTable::SetSize(const uint32_t num_elems) {
   slot_mask_ = capacity - 1;
   num_groups_ = capacity >> K_LOG_SLOTS_PER_GROUP;
   slot_groups_ = util::MallocHugeArray<SlotGroup>(num_groups_);
+  num_overflow_ = 0;
+  built_ = false;
 }
 
 void ConciseHashTable::Build() {
@@ -1,5 +1,8 @@
 #include "execution/sql/filter_manager.h"
 
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -9,7 +12,6 @@
 #include "execution/bandit/multi_armed_bandit.h"
 #include "execution/bandit/policy.h"
 #include "execution/sql/projected_columns_iterator.h"
-#include "execution/util/timer.h"
 #include "loggers/execution_logger.h"
 
 namespace terrier::execution::sql {
@@ -40,9 +42,15 @@ std::unique_ptr<bandit::Policy> CreatePolicy(bandit::Policy::Kind policy_kind) {
   }
 }
 
+double SteadyClockMs() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration<double, std::milli>(now).count();
+}
+
 }  // namespace
 
-FilterManager::FilterManager(const bandit::Policy::Kind policy_kind) : policy_(CreatePolicy(policy_kind)) {}
+FilterManager::FilterManager(const bandit::Policy::Kind policy_kind, const ClockFn clock)
+    : policy_(CreatePolicy(policy_kind)), clock_(clock != nullptr ? clock : SteadyClockMs) {}
 
 FilterManager::~FilterManager() = default;
 
@@ -71,6 +79,7 @@ void FilterManager::Finalize() {
   for (uint32_t idx = 0; idx < clauses_.size(); idx++) {
     agents_.emplace_back(policy_.get(), ClauseAt(idx)->NumFlavors());
   }
+  clause_stats_.resize(clauses_.size());
 
   finalized_ = true;
 }
@@ -78,10 +87,18 @@ void FilterManager::Finalize() {
 void FilterManager::RunFilters(ProjectedColumnsIterator *const pci) {
   TERRIER_ASSERT(finalized_, "Must finalize the filter before it can be used");
 
-  // Execute the clauses in what we currently believe to be the optimal order
+  // Execute the clauses in what we currently believe to be the optimal order.
+  // Once no tuple remains, the remaining clauses cannot select anything.
   for (const uint32_t opt_clause_idx : optimal_clause_order_) {
+    if (pci->NumSelected() == 0) {
+      break;
+    }
     RunFilterClause(pci, opt_clause_idx);
   }
+
+  if (++num_runs_ % K_REORDER_INTERVAL == 0) {
+    ReorderClauses();
+  }
 }
 
 void FilterManager::RunFilterClause(ProjectedColumnsIterator *const pci, const uint32_t clause_index) {
@@ -102,9 +119,10 @@ void FilterManager::RunFilterClause(ProjectedColumnsIterator *const pci, const u
   const auto opt_match_func = ClauseAt(clause_index)->flavors_[opt_flavor_idx];
 
   // Run the filter
+  const uint32_t num_input = pci->NumSelected();
   // NOLINTNEXTLINE
-  auto [_, exec_ms] = RunFilterClauseImpl(pci, opt_match_func);
-  (void)_;
+  auto [num_output, exec_ms] = RunFilterClauseImpl(pci, opt_match_func);
+  UpdateClauseStats(clause_index, num_input, num_output, exec_ms);
 
   // Update the agent's state
   double reward = bandit::MultiArmedBandit::ExecutionTimeToReward(exec_ms);
@@ -116,11 +134,50 @@ std::pair<uint32_t, double> FilterManager::RunFilterClauseImpl(ProjectedColumnsI
                                                                const FilterManager::MatchFn func) {
   // Time and execute the match function, returning the number of selected
   // tuples and the execution time in milliseconds
-  util::Timer<> timer;
-  timer.Start();
+  const double start_ms = clock_();
   const uint32_t num_selected = func(pci);
-  timer.Stop();
-  return std::make_pair(num_selected, timer.Elapsed());
+  return std::make_pair(num_selected, clock_() - start_ms);
+}
+
+void FilterManager::UpdateClauseStats(const uint32_t clause_index, const uint32_t num_input,
+                                      const uint32_t num_output, const double exec_ms) {
+  ClauseStats &stats = clause_stats_[clause_index];
+  stats.last_run_ = num_runs_;
+  const double selectivity = static_cast<double>(num_output) / num_input;
+  const double cost = exec_ms * 1e6 / num_input;
+  if (stats.sampled_) {
+    stats.selectivity_ = (1.0 - K_STATS_DECAY) * stats.selectivity_ + K_STATS_DECAY * selectivity;
+    stats.cost_ = (1.0 - K_STATS_DECAY) * stats.cost_ + K_STATS_DECAY * cost;
+  } else {
+    stats.selectivity_ = selectivity;
+    stats.cost_ = cost;
+    stats.sampled_ = true;
+  }
+}
+
+void FilterManager::ReorderClauses() {
+  // A clause that was skipped on every batch since the last reordering, because
+  // the clauses before it emptied them, has statistics from before then. Drop
+  // them, so that the clause is run first and measured again.
+  for (ClauseStats &stats : clause_stats_) {
+    if (stats.sampled_ && stats.last_run_ + K_REORDER_INTERVAL < num_runs_) {
+      stats.sampled_ = false;
+    }
+  }
+
+  // Order the clauses by increasing cost per tuple they discard. This order
+  // minimizes the expected cost of the conjunction when the clauses are
+  // independent. Clauses that have not been measured have a rank of zero.
+  const auto rank = [this](const uint32_t clause_index) {
+    const ClauseStats &stats = clause_stats_[clause_index];
+    if (!stats.sampled_) return 0.0;
+    const double discarded = 1.0 - stats.selectivity_;
+    return discarded > 0.0 ? stats.cost_ / discarded : std::numeric_limits<double>::infinity();
+  };
+  std::stable_sort(optimal_clause_order_.begin(), optimal_clause_order_.end(),
+                   [&](const uint32_t l, const uint32_t r) { return rank(l) < rank(r); });
+  EXECUTION_LOG_TRACE("Filter clause order after {} batches starts with clause {}", num_runs_,
+                      optimal_clause_order_.empty() ? 0 : optimal_clause_order_[0]);
 }
 
 uint32_t FilterManager::GetOptimalFlavorForClause(const uint32_t clause_index) const {
@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include "execution/exec/execution_context.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/util/bit_util.h"
 
 namespace terrier::execution::sql {
@@ -201,6 +202,25 @@ void StringFunctions::Length(UNUSED_ATTRIBUTE exec::ExecutionContext *ctx, Integ
   result->val_ = str.len_;
 }
 
+void StringFunctions::Like(BoolVal *result, const StringVal &str, const StringVal &pattern) {
+  if (str.is_null_ || pattern.is_null_) {
+    *result = BoolVal::Null();
+    return;
+  }
+
+  *result = BoolVal(LikePattern::Match(std::string_view(str.Content(), str.len_),
+                                       std::string_view(pattern.Content(), pattern.len_)));
+}
+
+void StringFunctions::Like(BoolVal *result, const StringVal &str, const LikePattern &pattern) {
+  if (str.is_null_) {
+    *result = BoolVal::Null();
+    return;
+  }
+
+  *result = BoolVal(pattern.Matches(std::string_view(str.Content(), str.len_)));
+}
+
 void StringFunctions::Lower(exec::ExecutionContext *ctx, StringVal *result, const StringVal &str) {
   if (str.is_null_) {
     *result = StringVal::Null();
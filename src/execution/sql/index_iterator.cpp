@@ -1,4 +1,7 @@
 #include "execution/sql/index_iterator.h"
+#include <cstring>
+#include <utility>
+#include <vector>
 #include "execution/sql/value.h"
 
 namespace terrier::execution::sql {
@@ -30,6 +33,7 @@ void IndexIterator::Init() {
 void IndexIterator::ScanKey() {
   // Scan the index
   tuples_.clear();
+  key_rows_.clear();
   curr_index_ = 0;
   index_->ScanKey(*exec_ctx_->GetTxn(), *index_pr_, &tuples_);
 }
@@ -37,31 +41,76 @@ void IndexIterator::ScanKey() {
 void IndexIterator::ScanAscending() {
   // Scan the index
   tuples_.clear();
+  key_rows_.clear();
   curr_index_ = 0;
+  if (index_only_) {
+    index_->ScanWithKeys(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, true, 0, &tuples_, &key_rows_);
+    return;
+  }
   index_->ScanAscending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_);
 }
 
 void IndexIterator::ScanDescending() {
   // Scan the index
   tuples_.clear();
+  key_rows_.clear();
   curr_index_ = 0;
+  if (index_only_) {
+    index_->ScanWithKeys(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, false, 0, &tuples_, &key_rows_);
+    return;
+  }
   index_->ScanDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_);
 }
 
 void IndexIterator::ScanLimitDescending(uint32_t limit) {
   // Scan the index
   tuples_.clear();
+  key_rows_.clear();
   curr_index_ = 0;
+  if (index_only_) {
+    index_->ScanWithKeys(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, false, limit, &tuples_, &key_rows_);
+    return;
+  }
   index_->ScanLimitDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_, limit);
 }
 
 void IndexIterator::ScanLimitAscending(uint32_t limit) {
   // Scan the index
   tuples_.clear();
+  key_rows_.clear();
   curr_index_ = 0;
+  if (index_only_) {
+    index_->ScanWithKeys(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, true, limit, &tuples_, &key_rows_);
+    return;
+  }
   index_->ScanLimitAscending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_, limit);
 }
 
+void IndexIterator::AddRange() {
+  // Copy both bounds, so that the PRs can be filled with the next range
+  const uint32_t key_row_size = index_->KeyRowSize();
+  range_rows_.resize(range_rows_.size() + 2 * key_row_size);
+  byte *range_row = range_rows_.data() + range_rows_.size() - 2 * key_row_size;
+  std::memcpy(range_row, index_pr_, index_pr_->Size());
+  std::memcpy(range_row + key_row_size, hi_index_pr_, hi_index_pr_->Size());
+}
+
+void IndexIterator::ScanRanges() {
+  // Scan the index
+  tuples_.clear();
+  key_rows_.clear();
+  curr_index_ = 0;
+  const uint32_t key_row_size = index_->KeyRowSize();
+  std::vector<std::pair<const storage::ProjectedRow *, const storage::ProjectedRow *>> ranges;
+  ranges.reserve(range_rows_.size() / (2 * key_row_size));
+  for (uint32_t offset = 0; offset < range_rows_.size(); offset += 2 * key_row_size) {
+    ranges.emplace_back(reinterpret_cast<const storage::ProjectedRow *>(range_rows_.data() + offset),
+                        reinterpret_cast<const storage::ProjectedRow *>(range_rows_.data() + offset + key_row_size));
+  }
+  index_->ScanRanges(*exec_ctx_->GetTxn(), ranges, &tuples_, index_only_ ? &key_rows_ : nullptr);
+  range_rows_.clear();
+}
+
 bool IndexIterator::Advance() {
   if (curr_index_ < tuples_.size()) {
     ++curr_index_;
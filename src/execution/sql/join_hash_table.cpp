@@ -3,11 +3,17 @@
 #include <tbb/tbb.h>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <limits>
+#include <numeric>
 #include <utility>
 #include <vector>
 
+#include "common/math_util.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/memory_tracker.h"
+#include "execution/sql/projected_columns_iterator.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/cpu_info.h"
 #include "execution/util/memory.h"
@@ -21,24 +27,325 @@ JoinHashTable::JoinHashTable(MemoryPool *memory, uint32_t tuple_size, bool use_c
     : entries_(sizeof(HashTableEntry) + tuple_size, MemoryPoolAllocator<byte>(memory)),
       owned_(memory),
       concise_hash_table_(0),
+      use_bloom_filter_(false),
+      bloom_filter_built_(false),
+      bloom_filter_active_(false),
+      bloom_filter_num_probed_(0),
+      bloom_filter_num_passed_(0),
       hll_estimator_(libcount::HLL::Create(K_DEFAULT_HLL_PRECISION)),
       built_(false),
-      use_concise_ht_(use_concise_ht) {}
+      use_concise_ht_(use_concise_ht),
+      merge_strategy_(MergeStrategy::Adaptive),
+      memory_(memory),
+      memory_budget_(MemoryTracker::K_UNLIMITED),
+      spill_threshold_(std::numeric_limits<uint64_t>::max()),
+      spilled_partitions_(0),
+      next_spilled_partition_(0),
+      spilled_probe_tuple_(nullptr) {
+  static_assert(K_NUM_SPILL_PARTITIONS <= sizeof(spilled_partitions_) * 8, "Too many spill partitions for mask");
+  if (memory != nullptr && memory->GetTracker() != nullptr) {
+    SetMemoryBudget(memory->GetTracker()->GetMemoryLimit());
+  }
+}
 
 // Needed because we forward-declared HLL from libcount
 JoinHashTable::~JoinHashTable() = default;
 
+void JoinHashTable::SetMemoryBudget(const std::size_t memory_budget) {
+  memory_budget_ = memory_budget;
+  if (memory_budget == MemoryTracker::K_UNLIMITED) {
+    spill_threshold_ = std::numeric_limits<uint64_t>::max();
+  } else {
+    spill_threshold_ = std::max(uint64_t(1), memory_budget / entries_.ElementSize());
+  }
+}
+
 byte *JoinHashTable::AllocInputTuple(const hash_t hash) {
   // Add to unique_count estimation
   hll_estimator_->Update(hash);
 
-  // Allocate space for a new tuple
-  auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
+  // The previously allocated tuple has been filled by now, so it's safe to
+  // spill. Spilling may evict the partition this tuple belongs to. Besides our
+  // own budget, periodically check if the query as a whole is over its limit,
+  // unless the table must never spill.
+  if (!IsPartitionSpilled(hash)) {
+    if (entries_.size() >= spill_threshold_) {
+      SpillPartitions(spill_threshold_ / 2);
+    } else if (memory_budget_ != MemoryTracker::K_UNLIMITED &&
+               (entries_.size() % K_MEMORY_CHECK_INTERVAL) == K_MEMORY_CHECK_INTERVAL - 1 &&
+               memory_->GetTracker() != nullptr && memory_->GetTracker()->IsOverLimit()) {
+      SpillPartitions(entries_.size() / 2);
+    }
+  }
+
+  // Allocate space for a new tuple, either in memory or in its spilled partition
+  HashTableEntry *entry;
+  if (IsPartitionSpilled(hash)) {
+    entry = reinterpret_cast<HashTableEntry *>(build_partitions_[SpillPartitionOf(hash)].Append(GetSpillFile()));
+  } else {
+    entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
+  }
   entry->hash_ = hash;
   entry->next_ = nullptr;
   return entry->payload_;
 }
 
+// ---------------------------------------------------------
+// Spilling
+// ---------------------------------------------------------
+
+SpillFile *JoinHashTable::GetSpillFile() {
+  if (spill_file_ == nullptr) {
+    spill_file_ = std::make_unique<SpillFile>();
+  }
+  return spill_file_.get();
+}
+
+uint64_t JoinHashTable::NumSpilledElements() const noexcept {
+  uint64_t count = 0;
+  for (const auto &partition : build_partitions_) {
+    count += partition.NumEntries();
+  }
+  return count;
+}
+
+void JoinHashTable::SpillPartitions(const uint64_t max_resident) {
+  // Count the buffered tuples in each partition
+  std::array<uint64_t, K_NUM_SPILL_PARTITIONS> counts{};
+  for (uint64_t idx = 0; idx < entries_.size(); idx++) {
+    counts[SpillPartitionOf(EntryAt(idx)->hash_)]++;
+  }
+
+  // Spill the largest partitions until at most the requested number of tuples
+  // remain, leaving room to grow before the next round of spilling
+  std::array<uint32_t, K_NUM_SPILL_PARTITIONS> order;
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](uint32_t l, uint32_t r) { return counts[l] > counts[r]; });
+
+  uint64_t num_resident = entries_.size();
+  for (const uint32_t part_idx : order) {
+    if (num_resident <= max_resident || counts[part_idx] == 0) {
+      break;
+    }
+    spilled_partitions_ |= uint64_t(1) << part_idx;
+    num_resident -= counts[part_idx];
+  }
+
+  EXECUTION_LOG_DEBUG("JHT: spilling {} of {} buffered tuples", entries_.size() - num_resident, entries_.size());
+
+  EvictSpilledPartitions();
+}
+
+void JoinHashTable::EvictSpilledPartitions() {
+  if (build_partitions_.empty()) {
+    build_partitions_.reserve(K_NUM_SPILL_PARTITIONS);
+    for (uint32_t i = 0; i < K_NUM_SPILL_PARTITIONS; i++) {
+      build_partitions_.emplace_back(memory_, entries_.ElementSize(), K_SPILL_BUFFER_SIZE);
+    }
+  }
+
+  // Copy each buffered entry either to disk or into a new compacted buffer
+  decltype(entries_) resident(entries_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+  for (uint64_t idx = 0; idx < entries_.size(); idx++) {
+    const HashTableEntry *entry = EntryAt(idx);
+    if (IsPartitionSpilled(entry->hash_)) {
+      build_partitions_[SpillPartitionOf(entry->hash_)].Append(GetSpillFile(), reinterpret_cast<const byte *>(entry));
+    } else {
+      std::memcpy(resident.Append(), entry, entries_.ElementSize());
+    }
+  }
+  entries_ = std::move(resident);
+}
+
+void JoinHashTable::FlushBuildPartitions() {
+  for (auto &partition : build_partitions_) {
+    partition.Flush(spill_file_.get());
+  }
+}
+
+void JoinHashTable::SpillProbeTuple(const hash_t hash, const void *probe_tuple, const uint32_t probe_tuple_size) {
+  TERRIER_ASSERT(IsPartitionSpilled(hash), "Probe tuple does not belong to a spilled partition");
+  common::SpinLatch::ScopedSpinLatch latch(&probe_partitions_latch_);
+  if (probe_partitions_.empty()) {
+    probe_partitions_.reserve(K_NUM_SPILL_PARTITIONS);
+    for (uint32_t i = 0; i < K_NUM_SPILL_PARTITIONS; i++) {
+      probe_partitions_.emplace_back(memory_, sizeof(HashTableEntry) + probe_tuple_size, K_SPILL_BUFFER_SIZE);
+    }
+  }
+  auto &partition = probe_partitions_[SpillPartitionOf(hash)];
+  TERRIER_ASSERT(partition.GetEntrySize() == sizeof(HashTableEntry) + probe_tuple_size, "Mismatched probe tuples");
+  auto *entry = reinterpret_cast<HashTableEntry *>(partition.Append(GetSpillFile()));
+  entry->hash_ = hash;
+  entry->next_ = nullptr;
+  std::memcpy(entry->payload_, probe_tuple, probe_tuple_size);
+}
+
+bool JoinHashTable::NextSpilledPartition(const bool include_unprobed) {
+  if (!HasSpilled()) {
+    return false;
+  }
+
+  // Partitions without probe tuples are read back through empty probe partitions
+  if (include_unprobed && probe_partitions_.empty()) {
+    probe_partitions_.reserve(K_NUM_SPILL_PARTITIONS);
+    for (uint32_t i = 0; i < K_NUM_SPILL_PARTITIONS; i++) {
+      probe_partitions_.emplace_back(memory_, sizeof(HashTableEntry), K_SPILL_BUFFER_SIZE);
+    }
+  }
+
+  if (next_spilled_partition_ == 0) {
+    // First call, so the in-memory probe is complete
+    FlushBuildPartitions();
+    for (auto &partition : probe_partitions_) {
+      partition.Flush(spill_file_.get());
+    }
+  } else if (next_spilled_partition_ <= K_NUM_SPILL_PARTITIONS) {
+    // Release the partition we're done with
+    build_partitions_[next_spilled_partition_ - 1].Clear();
+    if (!probe_partitions_.empty()) {
+      probe_partitions_[next_spilled_partition_ - 1].Clear();
+    }
+  }
+
+  // Find the next partition that can produce join results
+  for (; next_spilled_partition_ < K_NUM_SPILL_PARTITIONS; next_spilled_partition_++) {
+    const uint32_t part_idx = next_spilled_partition_;
+    if ((spilled_partitions_ & (uint64_t(1) << part_idx)) == 0 || build_partitions_[part_idx].NumEntries() == 0 ||
+        probe_partitions_.empty() || (!include_unprobed && probe_partitions_[part_idx].NumEntries() == 0)) {
+      continue;
+    }
+
+    // Replace the in-memory contents of the table with the partition's build
+    // tuples. We assume a single partition fits in memory.
+    entries_.clear();
+    owned_.clear();
+    SpillPartitionReader reader(&build_partitions_[part_idx]);
+    for (const byte *entry = reader.Next(); entry != nullptr; entry = reader.Next()) {
+      std::memcpy(entries_.Append(), entry, entries_.ElementSize());
+    }
+
+    built_ = false;
+    Build();
+
+    next_spilled_partition_++;
+    spilled_probe_reader_ = std::make_unique<SpillPartitionReader>(ReadSpilledProbeTuples());
+    spilled_probe_tuple_ = nullptr;
+    return true;
+  }
+
+  // All partitions processed
+  next_spilled_partition_ = K_NUM_SPILL_PARTITIONS + 1;
+  entries_.clear();
+  owned_.clear();
+  spilled_probe_reader_.reset();
+  spilled_probe_tuple_ = nullptr;
+  return false;
+}
+
+bool JoinHashTable::NextSpilledProbeTuple() {
+  TERRIER_ASSERT(spilled_probe_reader_ != nullptr, "No spilled partition loaded");
+  const byte *entry = spilled_probe_reader_->Next();
+  spilled_probe_tuple_ = entry == nullptr ? nullptr : reinterpret_cast<const HashTableEntry *>(entry)->payload_;
+  return spilled_probe_tuple_ != nullptr;
+}
+
+SpillPartitionReader JoinHashTable::ReadSpilledProbeTuples() const {
+  TERRIER_ASSERT(next_spilled_partition_ > 0 && next_spilled_partition_ <= K_NUM_SPILL_PARTITIONS,
+                 "No spilled partition loaded");
+  return SpillPartitionReader(&probe_partitions_[next_spilled_partition_ - 1]);
+}
+
+void JoinHashTable::MergeSpilledPartitions(const std::vector<JoinHashTable *> &tl_join_tables) {
+  // Build the first set of partitions in order to adopt thread-local ones
+  EvictSpilledPartitions();
+
+  // A partition spilled by any thread-local table is spilled in all of them.
+  // Move the thread-local tuples belonging to such partitions to disk.
+  tbb::parallel_for_each(tl_join_tables.begin(), tl_join_tables.end(), [this](JoinHashTable *source) {
+    source->spilled_partitions_ = spilled_partitions_;
+    source->EvictSpilledPartitions();
+    source->FlushBuildPartitions();
+  });
+
+  // Take ownership of all spilled data
+  for (auto *source : tl_join_tables) {
+    for (uint32_t i = 0; i < K_NUM_SPILL_PARTITIONS; i++) {
+      build_partitions_[i].Adopt(&source->build_partitions_[i]);
+    }
+    if (source->spill_file_ != nullptr) {
+      owned_spill_files_.emplace_back(std::move(source->spill_file_));
+    }
+  }
+}
+
+// ---------------------------------------------------------
+// Bloom filter
+// ---------------------------------------------------------
+
+void JoinHashTable::BuildBloomFilter() {
+  if (!use_bloom_filter_ || bloom_filter_built_) {
+    return;
+  }
+
+  // After a parallel merge, the build tuples live in the owned entries
+  uint64_t num_elems = entries_.size();
+  for (const auto &entries : owned_) {
+    num_elems += entries.size();
+  }
+
+  bloom_filter_.Init(memory_, static_cast<uint32_t>(std::max(num_elems, uint64_t(1))));
+  for (uint64_t idx = 0; idx < entries_.size(); idx++) {
+    bloom_filter_.Add(EntryAt(idx)->hash_);
+  }
+  for (const auto &entries : owned_) {
+    for (uint64_t idx = 0; idx < entries.size(); idx++) {
+      bloom_filter_.Add(reinterpret_cast<const HashTableEntry *>(entries[idx])->hash_);
+    }
+  }
+
+  bloom_filter_built_ = true;
+  bloom_filter_active_ = true;
+
+  EXECUTION_LOG_DEBUG("JHT: built {} KB bloom filter over {} tuples", bloom_filter_.GetSizeInBytes() / 1024.0,
+                      num_elems);
+}
+
+uint32_t JoinHashTable::FilterProbeBatch(ProjectedColumnsIterator *pci, const ProbeHashFn hash_fn) {
+  // Hash the whole batch up front, unless the probe keys were already hashed a
+  // column at a time. The probe reuses these hashes rather than computing them
+  // a second time.
+  if (!pci->HasHashes()) {
+    pci->CacheHashes([&] { return hash_fn(pci); });
+  }
+
+  if (!bloom_filter_active_.load(std::memory_order_relaxed)) {
+    // Callers iterate over the selected tuples, so make sure there are some
+    if (!pci->IsFiltered()) {
+      pci->RunFilter([] { return true; });
+    }
+    return pci->NumSelected();
+  }
+
+  const uint32_t num_input = pci->NumSelected();
+  pci->RunFilter([&] { return MayContain(pci->GetHash()); });
+  const uint32_t num_output = pci->NumSelected();
+
+  // Sample the filter's selectivity, and stop applying it if it discards too
+  // few tuples to make up for the cost of an extra pass over the batch
+  if (bloom_filter_num_probed_.load(std::memory_order_relaxed) < K_BLOOM_FILTER_SAMPLE_SIZE) {
+    const uint64_t num_probed = bloom_filter_num_probed_.fetch_add(num_input) + num_input;
+    const uint64_t num_passed = bloom_filter_num_passed_.fetch_add(num_output) + num_output;
+    if (num_probed >= K_BLOOM_FILTER_SAMPLE_SIZE &&
+        static_cast<double>(num_passed) > static_cast<double>(num_probed) * K_BLOOM_FILTER_MAX_PASS_RATE) {
+      EXECUTION_LOG_DEBUG("JHT: disabling bloom filter passing {} of {} sampled probe tuples", num_passed,
+                          num_probed);
+      bloom_filter_active_ = false;
+    }
+  }
+
+  return num_output;
+}
+
 // ---------------------------------------------------------
 // Generic hash tables
 // ---------------------------------------------------------
@@ -62,7 +369,7 @@ void JoinHashTable::BuildGenericHashTableInternal() noexcept {
 
 void JoinHashTable::BuildGenericHashTable() noexcept {
   // Setup based on number of buffered build-size tuples
-  generic_hash_table_.SetSize(NumElements());
+  generic_hash_table_.SetSize(std::max(NumElements(), uint64_t(1)));
 
   // Dispatch to appropriate build code based on GHT size
   uint64_t l3_cache_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE);
@@ -576,6 +883,11 @@ void JoinHashTable::Build() {
 
   EXECUTION_LOG_DEBUG("Unique estimate: {}", hll_estimator_->Estimate());
 
+  // Spilled tuples are built partition-at-a-time later
+  if (HasSpilled()) {
+    FlushBuildPartitions();
+  }
+
   util::Timer<> timer;
   timer.Start();
 
@@ -590,6 +902,10 @@ void JoinHashTable::Build() {
   UNUSED_ATTRIBUTE double tps = (static_cast<double>(NumElements()) / timer.Elapsed()) / 1000.0;
   EXECUTION_LOG_DEBUG("JHT: built {} tuples in {} ms ({:.2f} tps)", NumElements(), timer.Elapsed(), tps);
 
+  // The filter only covers the partitions that are resident during the probe
+  // of the input. Spilled partitions loaded later pass it unconditionally.
+  BuildBloomFilter();
+
   built_ = true;
 }
 
@@ -686,6 +1002,65 @@ void JoinHashTable::MergeIncomplete(JoinHashTable *source) {
   }
 }
 
+void JoinHashTable::MergePartitioned(const std::vector<JoinHashTable *> &tl_join_tables) {
+  // Use enough partitions to keep all threads busy, and to make each
+  // partition's range of the directory fit in half the L2 cache. Each range
+  // must span at least a cache line so that no two threads write to one.
+  const uint64_t l2_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE);
+  const uint64_t buckets_per_line = common::Constants::CACHELINE_SIZE / sizeof(HashTableEntry *);
+  const uint64_t num_parts_for_threads = 4 * static_cast<uint64_t>(tbb::task_scheduler_init::default_num_threads());
+  const uint64_t num_parts_for_cache = generic_hash_table_.GetTotalMemoryUsage() / std::max(l2_size / 2, uint64_t(1));
+  const uint64_t max_parts = std::min(std::max(generic_hash_table_.Capacity() / buckets_per_line, uint64_t(1)),
+                                      uint64_t(1) << K_MAX_MERGE_PARTITION_BITS);
+  const uint64_t num_parts = std::min(
+      common::MathUtil::PowerOf2Ceil(std::max({num_parts_for_threads, num_parts_for_cache, uint64_t(1)})), max_parts);
+  uint32_t num_bits = 0;
+  while ((uint64_t(1) << num_bits) < num_parts) {
+    num_bits++;
+  }
+
+  EXECUTION_LOG_DEBUG("JHT: merging {} thread-local tables into {} partitions", tl_join_tables.size(), num_parts);
+
+  // Phase 1: Radix-partition the entries of each thread-local table. Partition
+  // 'p' of table 'i' occupies [offsets[i][p], offsets[i][p+1]) of entries[i].
+  std::vector<std::vector<HashTableEntry *>> entries(tl_join_tables.size());
+  std::vector<std::vector<uint64_t>> offsets(tl_join_tables.size());
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, tl_join_tables.size(), 1), [&](const auto &range) {
+    for (std::size_t i = range.begin(); i != range.end(); i++) {
+      JoinHashTable *source = tl_join_tables[i];
+      auto &part_offsets = offsets[i];
+      part_offsets.assign(num_parts + 1, 0);
+      for (uint64_t idx = 0; idx < source->NumElements(); idx++) {
+        part_offsets[generic_hash_table_.DirectoryRangeOf(source->EntryAt(idx)->hash_, num_bits) + 1]++;
+      }
+      std::partial_sum(part_offsets.begin(), part_offsets.end(), part_offsets.begin());
+
+      std::vector<uint64_t> write_pos(part_offsets.begin(), part_offsets.end() - 1);
+      auto &part_entries = entries[i];
+      part_entries.resize(source->NumElements());
+      for (uint64_t idx = 0; idx < source->NumElements(); idx++) {
+        HashTableEntry *entry = source->EntryAt(idx);
+        part_entries[write_pos[generic_hash_table_.DirectoryRangeOf(entry->hash_, num_bits)]++] = entry;
+      }
+    }
+  });
+
+  // Phase 2: Build each partition's range of the directory independently
+  tbb::parallel_for(tbb::blocked_range<uint64_t>(0, num_parts, 1), [&](const auto &range) {
+    for (uint64_t part = range.begin(); part != range.end(); part++) {
+      for (std::size_t i = 0; i < tl_join_tables.size(); i++) {
+        generic_hash_table_.InsertRange(entries[i].data() + offsets[i][part], offsets[i][part + 1] - offsets[i][part]);
+      }
+    }
+  });
+
+  // Finally, take ownership of the thread-local tables' memory
+  for (auto *source : tl_join_tables) {
+    generic_hash_table_.AddNumElements(source->NumElements());
+    owned_.emplace_back(std::move(source->entries_));
+  }
+}
+
 void JoinHashTable::MergeParallel(const ThreadStateContainer *thread_state_container, const uint32_t jht_offset) {
   // Collect thread-local hash tables
   std::vector<JoinHashTable *> tl_join_tables;
@@ -696,6 +1071,15 @@ void JoinHashTable::MergeParallel(const ThreadStateContainer *thread_state_conta
     hll_estimator_->Merge(jht->hll_estimator_.get());
   }
 
+  // Combine spilled partitions
+  tbb::task_scheduler_init sched;
+  for (auto *jht : tl_join_tables) {
+    spilled_partitions_ |= jht->spilled_partitions_;
+  }
+  if (HasSpilled()) {
+    MergeSpilledPartitions(tl_join_tables);
+  }
+
   uint64_t num_elem_estimate = hll_estimator_->Estimate();
   EXECUTION_LOG_DEBUG("Global unique count: {}", num_elem_estimate);
 
@@ -707,19 +1091,26 @@ void JoinHashTable::MergeParallel(const ThreadStateContainer *thread_state_conta
   // owned entries vector
   owned_.reserve(tl_join_tables.size());
 
-  // Is the global hash table out of cache? If so, we'll prefetch during build.
+  // Is the global hash table out of cache? If so, concurrent inserts contend
+  // on cache misses into the directory, so partition unless told otherwise.
   const uint64_t l3_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE);
   const bool out_of_cache = (generic_hash_table_.GetTotalMemoryUsage() > l3_size);
 
-  // Merge all in parallel
-  tbb::task_scheduler_init sched;
-  tbb::parallel_for_each(tl_join_tables.begin(), tl_join_tables.end(), [this, out_of_cache](JoinHashTable *source) {
-    if (out_of_cache) {
-      MergeIncomplete<true, true>(source);
-    } else {
-      MergeIncomplete<false, true>(source);
-    }
-  });
+  if (merge_strategy_ == MergeStrategy::Partitioned ||
+      (merge_strategy_ == MergeStrategy::Adaptive && out_of_cache)) {
+    MergePartitioned(tl_join_tables);
+  } else {
+    // Merge all in parallel, prefetching if we're out of cache
+    tbb::parallel_for_each(tl_join_tables.begin(), tl_join_tables.end(), [this, out_of_cache](JoinHashTable *source) {
+      if (out_of_cache) {
+        MergeIncomplete<true, true>(source);
+      } else {
+        MergeIncomplete<false, true>(source);
+      }
+    });
+  }
+
+  BuildBloomFilter();
 }
 
 }  // namespace terrier::execution::sql
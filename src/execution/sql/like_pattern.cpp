@@ -0,0 +1,303 @@
+#include "execution/sql/like_pattern.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace terrier::execution::sql {
+
+namespace {
+
+// The number of leading bytes of every string stored inline in its VarlenEntry
+constexpr uint32_t K_PREFIX_SIZE = storage::VarlenEntry::PrefixSize();
+
+// View the contents of a VarlenEntry as a string
+std::string_view AsStringView(const storage::VarlenEntry &str) {
+  return std::string_view(reinterpret_cast<const char *>(str.Content()), str.Size());
+}
+
+// Ensure the pattern does not end in an unescaped escape character
+void CheckPattern(const std::string_view pattern, const char escape) {
+  for (std::size_t i = 0; i < pattern.size(); i++) {
+    if (pattern[i] == escape && ++i == pattern.size()) {
+      throw std::runtime_error("LIKE pattern must not end with escape character");
+    }
+  }
+}
+
+// Search for @em needle in @em haystack. Both the first and last byte of the needle are compared
+// against 32 candidate positions at once, and only positions where both match are verified.
+bool ContainsSubstring(const std::string_view haystack, const std::string_view needle) {
+  const std::size_t n = needle.size();
+  if (n == 0) return true;
+  if (n > haystack.size()) return false;
+  if (n == 1) return std::memchr(haystack.data(), needle[0], haystack.size()) != nullptr;
+
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[n - 1]);
+  for (; i + n + 31 <= haystack.size(); i += 32) {
+    const auto *block = haystack.data() + i;
+    const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + n - 1));
+    const __m256i candidates =
+        _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(candidates));
+    for (; mask != 0; mask &= mask - 1) {
+      const auto pos = static_cast<uint32_t>(__builtin_ctz(mask));
+      if (std::memcmp(block + pos + 1, needle.data() + 1, n - 2) == 0) {
+        return true;
+      }
+    }
+  }
+#endif
+
+  return haystack.substr(i).find(needle) != std::string_view::npos;
+}
+
+}  // namespace
+
+LikePattern::LikePattern(const std::string_view pattern, const char escape)
+    : pattern_(pattern),
+      escape_(escape),
+      kind_(Kind::General),
+      char_masks_{},
+      loop_mask_(0),
+      accept_mask_(0),
+      leading_wildcard_(false),
+      use_nfa_(false) {
+  CheckPattern(pattern, escape);
+
+  // Break the pattern into its non-'%' characters, noting where the '%' wildcards are. Each
+  // character is paired with a flag that is set if it is an unescaped '_'.
+  std::vector<std::pair<char, bool>> chars;
+  std::vector<bool> wildcard_after;
+  bool has_any_char = false, has_inner_wildcard = false, pending_wildcard = false;
+  for (std::size_t i = 0; i < pattern.size(); i++) {
+    char c = pattern[i];
+    bool any = false;
+    if (c == escape) {
+      c = pattern[++i];
+    } else if (c == '%') {
+      pending_wildcard = true;
+      continue;
+    } else {
+      any = (c == '_');
+    }
+    if (pending_wildcard) {
+      if (chars.empty()) {
+        leading_wildcard_ = true;
+      } else {
+        wildcard_after.back() = true;
+        has_inner_wildcard = true;
+      }
+      pending_wildcard = false;
+    }
+    chars.emplace_back(c, any);
+    wildcard_after.push_back(false);
+    has_any_char |= any;
+  }
+  // A pattern of only wildcards is treated as a trailing wildcard, i.e., an empty prefix
+  const bool trailing_wildcard = pending_wildcard;
+
+  // Patterns made up of literal characters with wildcards only at the ends are specialized
+  if (!has_any_char && !has_inner_wildcard) {
+    for (const auto &[c, any] : chars) {
+      (void)any;
+      literal_.push_back(c);
+    }
+    if (leading_wildcard_ && trailing_wildcard) {
+      kind_ = Kind::Contains;
+    } else if (leading_wildcard_) {
+      kind_ = Kind::Suffix;
+    } else if (trailing_wildcard) {
+      kind_ = Kind::Prefix;
+    } else {
+      kind_ = Kind::Exact;
+    }
+    return;
+  }
+
+  // General patterns. Build the NFA if it fits in a machine word.
+  if (trailing_wildcard) {
+    wildcard_after.back() = true;
+  }
+  use_nfa_ = chars.size() <= 64;
+  if (use_nfa_) {
+    for (std::size_t i = 0; i < chars.size(); i++) {
+      const uint64_t bit = uint64_t{1} << i;
+      if (chars[i].second) {
+        for (auto &mask : char_masks_) mask |= bit;
+      } else {
+        char_masks_[static_cast<uint8_t>(chars[i].first)] |= bit;
+      }
+      if (wildcard_after[i]) {
+        loop_mask_ |= bit;
+      }
+    }
+    accept_mask_ = uint64_t{1} << (chars.size() - 1);
+  }
+}
+
+bool LikePattern::MatchExact(const storage::VarlenEntry &str) const {
+  const std::size_t n = literal_.size();
+  if (str.Size() != n) return false;
+  if (n <= K_PREFIX_SIZE) return std::memcmp(str.Prefix(), literal_.data(), n) == 0;
+  return std::memcmp(str.Prefix(), literal_.data(), K_PREFIX_SIZE) == 0 &&
+         std::memcmp(str.Content() + K_PREFIX_SIZE, literal_.data() + K_PREFIX_SIZE, n - K_PREFIX_SIZE) == 0;
+}
+
+bool LikePattern::MatchPrefix(const storage::VarlenEntry &str) const {
+  const std::size_t n = literal_.size();
+  if (str.Size() < n) return false;
+  if (n <= K_PREFIX_SIZE) return std::memcmp(str.Prefix(), literal_.data(), n) == 0;
+  return std::memcmp(str.Prefix(), literal_.data(), K_PREFIX_SIZE) == 0 &&
+         std::memcmp(str.Content() + K_PREFIX_SIZE, literal_.data() + K_PREFIX_SIZE, n - K_PREFIX_SIZE) == 0;
+}
+
+bool LikePattern::MatchSuffix(const std::string_view str) const {
+  const std::size_t n = literal_.size();
+  return str.size() >= n && std::memcmp(str.data() + str.size() - n, literal_.data(), n) == 0;
+}
+
+bool LikePattern::MatchContains(const std::string_view str) const { return ContainsSubstring(str, literal_); }
+
+bool LikePattern::MatchGeneral(const std::string_view str) const {
+  if (!use_nfa_) {
+    return Match(str, pattern_, escape_);
+  }
+
+  // Bit i of the state is set if the first i+1 pattern characters match a suffix of the input read
+  // so far. A new match may only begin at the first character, unless the pattern begins with '%'.
+  uint64_t state = 0;
+  for (std::size_t i = 0; i < str.size(); i++) {
+    const uint64_t start = static_cast<uint64_t>(i == 0 || leading_wildcard_);
+    state = (((state << 1u) | start) & char_masks_[static_cast<uint8_t>(str[i])]) | (state & loop_mask_);
+    if (state == 0 && !leading_wildcard_) {
+      return false;
+    }
+  }
+  return (state & accept_mask_) != 0;
+}
+
+bool LikePattern::Matches(const std::string_view str) const {
+  switch (kind_) {
+    case Kind::Exact:
+      return str == literal_;
+    case Kind::Prefix:
+      return str.substr(0, literal_.size()) == literal_;
+    case Kind::Suffix:
+      return MatchSuffix(str);
+    case Kind::Contains:
+      return MatchContains(str);
+    default:
+      return MatchGeneral(str);
+  }
+}
+
+bool LikePattern::Matches(const storage::VarlenEntry &str) const {
+  switch (kind_) {
+    case Kind::Exact:
+      return MatchExact(str);
+    case Kind::Prefix:
+      return MatchPrefix(str);
+    default:
+      return Matches(AsStringView(str));
+  }
+}
+
+template <typename Matcher>
+uint32_t LikePattern::FilterVectorImpl(const storage::VarlenEntry *input, const common::RawBitmap *null_bitmap,
+                                       const uint32_t in_count, const uint32_t *sel, uint32_t *out,
+                                       const bool negated, const Matcher &matcher) const {
+  uint32_t out_pos = 0;
+  if (sel == nullptr) {
+    for (uint32_t in_pos = 0; in_pos < in_count; in_pos++) {
+      out[out_pos] = in_pos;
+      out_pos += static_cast<uint32_t>(null_bitmap->Test(in_pos) && matcher(input[in_pos]) != negated);
+    }
+  } else {
+    for (uint32_t in_pos = 0; in_pos < in_count; in_pos++) {
+      const uint32_t idx = sel[in_pos];
+      out[out_pos] = idx;
+      out_pos += static_cast<uint32_t>(null_bitmap->Test(idx) && matcher(input[idx]) != negated);
+    }
+  }
+  return out_pos;
+}
+
+uint32_t LikePattern::FilterVector(const storage::VarlenEntry *input, const common::RawBitmap *null_bitmap,
+                                   const uint32_t in_count, const uint32_t *sel, uint32_t *out,
+                                   const bool negated) const {
+  switch (kind_) {
+    case Kind::Exact: {
+      return FilterVectorImpl(input, null_bitmap, in_count, sel, out, negated,
+                              [this](const storage::VarlenEntry &str) { return MatchExact(str); });
+    }
+    case Kind::Prefix: {
+      return FilterVectorImpl(input, null_bitmap, in_count, sel, out, negated,
+                              [this](const storage::VarlenEntry &str) { return MatchPrefix(str); });
+    }
+    case Kind::Suffix: {
+      return FilterVectorImpl(input, null_bitmap, in_count, sel, out, negated,
+                              [this](const storage::VarlenEntry &str) { return MatchSuffix(AsStringView(str)); });
+    }
+    case Kind::Contains: {
+      return FilterVectorImpl(input, null_bitmap, in_count, sel, out, negated,
+                              [this](const storage::VarlenEntry &str) { return MatchContains(AsStringView(str)); });
+    }
+    default: {
+      return FilterVectorImpl(input, null_bitmap, in_count, sel, out, negated,
+                              [this](const storage::VarlenEntry &str) { return MatchGeneral(AsStringView(str)); });
+    }
+  }
+}
+
+bool LikePattern::Match(const std::string_view str, const std::string_view pattern, const char escape) {
+  CheckPattern(pattern, escape);
+
+  // Greedy matching. On a mismatch, backtrack to the most recent '%' and let it consume one more
+  // character of the input.
+  constexpr std::size_t no_wildcard = std::string_view::npos;
+  std::size_t s = 0, p = 0, wildcard_p = no_wildcard, wildcard_s = 0;
+  while (s < str.size()) {
+    if (p < pattern.size()) {
+      const char c = pattern[p];
+      if (c == escape) {
+        if (pattern[p + 1] == str[s]) {
+          p += 2;
+          s++;
+          continue;
+        }
+      } else if (c == '%') {
+        wildcard_p = ++p;
+        wildcard_s = s;
+        continue;
+      } else if (c == '_' || c == str[s]) {
+        p++;
+        s++;
+        continue;
+      }
+    }
+    if (wildcard_p == no_wildcard) {
+      return false;
+    }
+    p = wildcard_p;
+    s = ++wildcard_s;
+  }
+
+  // The input is exhausted; the rest of the pattern must match the empty string
+  while (p < pattern.size() && pattern[p] == '%') {
+    p++;
+  }
+  return p == pattern.size();
+}
+
+}  // namespace terrier::execution::sql
@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "common/constants.h"
+#include "execution/sql/memory_tracker.h"
 #include "execution/util/memory.h"
 
 namespace terrier::execution::sql {
@@ -45,11 +46,20 @@ void *MemoryPool::AllocateAligned(const std::size_t size, const std::size_t alig
     }
   }
 
+  // Track
+  if (tracker_ != nullptr) {
+    tracker_->Increment(size);
+  }
+
   // Done
   return buf;
 }
 
 void MemoryPool::Deallocate(void *ptr, std::size_t size) {
+  if (tracker_ != nullptr) {
+    tracker_->Decrement(size);
+  }
+
   if (size >= k_mmap_threshold.load(std::memory_order_relaxed)) {
     util::FreeHuge(ptr, size);
   } else {
@@ -1,10 +1,80 @@
 #include "execution/sql/projected_columns_iterator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+#include "execution/sql/like_pattern.h"
+#include "execution/sql/storage_compare.h"
+#include "execution/sql/vector_expression.h"
+#include "execution/sql/vector_operations.h"
+#include "execution/sql/vector_projection.h"
+#include "execution/util/hash.h"
 #include "execution/util/vector_util.h"
+#include "storage/arrow_block_metadata.h"
 #include "storage/projected_columns.h"
 #include "type/type_id.h"
 
 namespace terrier::execution::sql {
 
+namespace {
+
+// Compute the sort keys of the first @em num_dates dates in @em dates
+inline void ComputeDateSortKeys(const uint32_t *RESTRICT dates, const uint32_t num_dates, int32_t *RESTRICT keys) {
+  for (uint32_t i = 0; i < num_dates; i++) {
+    keys[i] = StorageCompare::DateSortKey(dates[i]);
+  }
+}
+
+// Write the indexes of all elements in the input (or selection) vector satisfying the predicate
+// into @em out. The output may alias the selection vector.
+template <typename P>
+inline uint32_t SelectMatching(const uint32_t in_count, const uint32_t *sel, uint32_t *out, const P &pred) {
+  uint32_t out_pos = 0;
+  if (sel == nullptr) {
+    for (uint32_t in_pos = 0; in_pos < in_count; in_pos++) {
+      out[out_pos] = in_pos;
+      out_pos += static_cast<uint32_t>(pred(in_pos));
+    }
+  } else {
+    for (uint32_t in_pos = 0; in_pos < in_count; in_pos++) {
+      const uint32_t idx = sel[in_pos];
+      out[out_pos] = idx;
+      out_pos += static_cast<uint32_t>(pred(idx));
+    }
+  }
+  return out_pos;
+}
+
+// Call @em fn with the index of every element in the input (or selection) vector
+template <typename F>
+inline void ForEachSelected(const uint32_t in_count, const uint32_t *sel, const F &fn) {
+  if (sel == nullptr) {
+    for (uint32_t idx = 0; idx < in_count; idx++) {
+      fn(idx);
+    }
+  } else {
+    for (uint32_t in_pos = 0; in_pos < in_count; in_pos++) {
+      fn(sel[in_pos]);
+    }
+  }
+}
+
+// The word with the given code in a dictionary, as a string referencing the dictionary
+inline storage::VarlenEntry DictionaryWord(const storage::ArrowVarlenColumn &dictionary, const uint32_t code) {
+  const uint32_t offset = dictionary.Offsets()[code];
+  const uint32_t size = dictionary.Offsets()[code + 1] - offset;
+  const byte *content = dictionary.Values() + offset;
+  return size <= storage::VarlenEntry::InlineThreshold() ? storage::VarlenEntry::CreateInline(content, size)
+                                                         : storage::VarlenEntry::Create(content, size, false);
+}
+
+// The number of words in a dictionary
+inline uint32_t DictionarySize(const storage::ArrowVarlenColumn &dictionary) { return dictionary.OffsetsLength() - 1; }
+
+}  // namespace
+
 ProjectedColumnsIterator::ProjectedColumnsIterator() : selection_vector_{0} {
   selection_vector_[0] = ProjectedColumnsIterator::K_INVALID_POS;
 }
@@ -21,6 +91,49 @@ void ProjectedColumnsIterator::SetProjectedColumn(storage::ProjectedColumns *pro
   selection_vector_[0] = K_INVALID_POS;
   selection_vector_read_idx_ = 0;
   selection_vector_write_idx_ = 0;
+  hashes_valid_ = false;
+  dictionaries_.clear();
+}
+
+void ProjectedColumnsIterator::SetDictionaryCodes(const uint32_t col_idx, const uint32_t *const codes,
+                                                  const storage::ArrowVarlenColumn *const dictionary) {
+  if (dictionaries_.size() <= col_idx) dictionaries_.resize(col_idx + 1);
+  dictionaries_[col_idx] = {codes, dictionary};
+}
+
+const ProjectedColumnsIterator::DictionaryCodes *ProjectedColumnsIterator::ChooseDictionary(
+    const uint32_t col_idx) const {
+  if (!HasDictionaryCodes(col_idx)) return nullptr;
+  const DictionaryCodes &dict = dictionaries_[col_idx];
+  return DictionarySize(*dict.dictionary_) <= num_selected_ ? &dict : nullptr;
+}
+
+template <typename P>
+uint32_t ProjectedColumnsIterator::FilterByDictionary(const uint32_t col_idx, const DictionaryCodes &dict,
+                                                      const P &pred) {
+  const storage::ArrowVarlenColumn &dictionary = *dict.dictionary_;
+  const uint32_t num_words = DictionarySize(dictionary);
+  dictionary_matches_.resize(num_words);
+  for (uint32_t code = 0; code < num_words; code++) {
+    dictionary_matches_[code] = static_cast<uint8_t>(pred(DictionaryWord(dictionary, code)));
+  }
+
+  const auto *null_bitmap = projected_column_->ColumnNullBitmap(static_cast<uint16_t>(col_idx));
+  const uint32_t *codes = dict.codes_;
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+  selection_vector_write_idx_ = SelectMatching(num_selected_, sel_vec, selection_vector_, [&](const uint32_t idx) {
+    return null_bitmap->Test(idx) && dictionary_matches_[codes[idx]] != 0;
+  });
+  ResetFiltered();
+  return NumSelected();
+}
+
+void ProjectedColumnsIterator::DeselectNulls(const uint32_t col_idx) {
+  const auto *null_bitmap = projected_column_->ColumnNullBitmap(static_cast<uint16_t>(col_idx));
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+  selection_vector_write_idx_ = SelectMatching(num_selected_, sel_vec, selection_vector_,
+                                               [&](const uint32_t idx) { return null_bitmap->Test(idx); });
+  ResetFiltered();
 }
 
 template <typename T, template <typename> typename Op>
@@ -41,12 +154,124 @@ uint32_t ProjectedColumnsIterator::FilterColByColImpl(const uint32_t col_idx_1,
   // PCI, and subsequent filters operate only on valid tuples potentially
   // filtered out in this filter.
   ResetFiltered();
+  DeselectNulls(col_idx_1);
+  DeselectNulls(col_idx_2);
 
   // After the call to ResetFiltered(), num_selected_ should indicate the number
   // of valid tuples in the filter.
   return NumSelected();
 }
 
+uint32_t ProjectedColumnsIterator::FilterByVectorFilter(const VectorFilter &filter) {
+  VectorProjection input(filter.GetColumnTypes());
+  input.Reference(*this, filter.GetColumnIndexes());
+  std::vector<std::unique_ptr<Vector>> temps;
+  const Vector &matches = filter.GetPredicate().Evaluate(input, &temps);
+  selection_vector_write_idx_ = VectorOps::SelectTrue(matches, selection_vector_);
+  ResetFiltered();
+  return NumSelected();
+}
+
+template <typename T>
+void ProjectedColumnsIterator::HashColumnImpl(const uint32_t col_idx) {
+  const auto col = static_cast<uint16_t>(col_idx);
+  const auto *RESTRICT input = reinterpret_cast<const T *>(projected_column_->ColumnStart(col));
+  const common::RawBitmap *validity = projected_column_->ColumnNullBitmap(col);
+  hash_t *RESTRICT hashes = hashes_;
+  ForEachSelected(num_selected_, GetSelectionVector(), [&](const uint32_t idx) {
+    const hash_t hash = util::Hasher::Hash<util::HashMethod::Crc>(input[idx]);
+    hashes[idx] = util::Hasher::CombineHashes(hashes[idx], validity->Test(idx) ? hash : 0);
+  });
+}
+
+void ProjectedColumnsIterator::HashVarlenColumnImpl(const uint32_t col_idx) {
+  const auto col = static_cast<uint16_t>(col_idx);
+  const common::RawBitmap *validity = projected_column_->ColumnNullBitmap(col);
+  if (const DictionaryCodes *dict = ChooseDictionary(col_idx); dict != nullptr) {
+    // Hash every distinct word once, and look the hashes up by code
+    const storage::ArrowVarlenColumn &dictionary = *dict->dictionary_;
+    const uint32_t num_words = DictionarySize(dictionary);
+    dictionary_hashes_.resize(num_words);
+    for (uint32_t code = 0; code < num_words; code++) {
+      const uint32_t offset = dictionary.Offsets()[code];
+      const auto *content = reinterpret_cast<const uint8_t *>(dictionary.Values() + offset);
+      dictionary_hashes_[code] =
+          util::Hasher::Hash<util::HashMethod::xxHash3>(content, dictionary.Offsets()[code + 1] - offset);
+    }
+    const uint32_t *codes = dict->codes_;
+    ForEachSelected(num_selected_, GetSelectionVector(), [&](const uint32_t idx) {
+      const hash_t hash = validity->Test(idx) ? dictionary_hashes_[codes[idx]] : 0;
+      hashes_[idx] = util::Hasher::CombineHashes(hashes_[idx], hash);
+    });
+    return;
+  }
+
+  const auto *input = reinterpret_cast<const storage::VarlenEntry *>(projected_column_->ColumnStart(col));
+  ForEachSelected(num_selected_, GetSelectionVector(), [&](const uint32_t idx) {
+    const auto *content = reinterpret_cast<const uint8_t *>(input[idx].Content());
+    const hash_t hash =
+        validity->Test(idx) ? util::Hasher::Hash<util::HashMethod::xxHash3>(content, input[idx].Size()) : 0;
+    hashes_[idx] = util::Hasher::CombineHashes(hashes_[idx], hash);
+  });
+}
+
+void ProjectedColumnsIterator::HashColumns(const uint32_t col_idxs[], const type::TypeId col_types[],
+                                           const uint32_t num_cols) {
+  // @hash() starts from a seed of one
+  ForEachSelected(num_selected_, GetSelectionVector(), [this](const uint32_t idx) { hashes_[idx] = 1; });
+  for (uint32_t i = 0; i < num_cols; i++) {
+    HashColumn(col_idxs[i], col_types[i], true);
+  }
+  hashes_valid_ = true;
+}
+
+void ProjectedColumnsIterator::HashColumn(const uint32_t col_idx, const type::TypeId col_type, const bool combine) {
+  if (!combine) {
+    ForEachSelected(num_selected_, GetSelectionVector(), [this](const uint32_t idx) { hashes_[idx] = 1; });
+  }
+
+  switch (col_type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT: {
+      HashColumnImpl<int8_t>(col_idx);
+      break;
+    }
+    case type::TypeId::SMALLINT: {
+      HashColumnImpl<int16_t>(col_idx);
+      break;
+    }
+    case type::TypeId::INTEGER: {
+      HashColumnImpl<int32_t>(col_idx);
+      break;
+    }
+    case type::TypeId::BIGINT: {
+      HashColumnImpl<int64_t>(col_idx);
+      break;
+    }
+    case type::TypeId::DATE: {
+      HashColumnImpl<uint32_t>(col_idx);
+      break;
+    }
+    case type::TypeId::TIMESTAMP: {
+      HashColumnImpl<uint64_t>(col_idx);
+      break;
+    }
+    case type::TypeId::DECIMAL: {
+      HashColumnImpl<double>(col_idx);
+      break;
+    }
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      HashVarlenColumnImpl(col_idx);
+      break;
+    }
+    default: {
+      throw std::runtime_error("Hashing not supported on type");
+    }
+  }
+  hashes_valid_ = true;
+}
+
 // Filter an entire column's data by the provided constant value
 template <typename T, template <typename> typename Op>
 uint32_t ProjectedColumnsIterator::FilterColByValImpl(uint32_t col_idx, T val) {
@@ -65,16 +290,138 @@ uint32_t ProjectedColumnsIterator::FilterColByValImpl(uint32_t col_idx, T val) {
   // PCI, and subsequent filters operate only on valid tuples potentially
   // filtered out in this filter.
   ResetFiltered();
+  DeselectNulls(col_idx);
 
   // After the call to ResetFiltered(), num_selected_ should indicate the number
   // of valid tuples in the filter.
   return NumSelected();
 }
 
+template <template <typename> typename Op>
+uint32_t ProjectedColumnsIterator::FilterDateColByValImpl(const uint32_t col_idx, const uint32_t val) {
+  const auto *input =
+      reinterpret_cast<const uint32_t *>(projected_column_->ColumnStart(static_cast<uint16_t>(col_idx)));
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  // Convert the dates into sortable keys in one dense pass, then filter the keys
+  alignas(common::Constants::CACHELINE_SIZE) int32_t keys[common::Constants::K_DEFAULT_VECTOR_SIZE];
+  TERRIER_ASSERT(projected_column_->NumTuples() <= common::Constants::K_DEFAULT_VECTOR_SIZE, "Projection too large");
+  ComputeDateSortKeys(input, projected_column_->NumTuples(), keys);
+
+  selection_vector_write_idx_ = util::VectorUtil::FilterVectorByVal<int32_t, Op>(
+      keys, num_selected_, StorageCompare::DateSortKey(val), selection_vector_, sel_vec);
+  ResetFiltered();
+  DeselectNulls(col_idx);
+  return NumSelected();
+}
+
+template <template <typename> typename Op>
+uint32_t ProjectedColumnsIterator::FilterDateColByColImpl(const uint32_t col_idx_1, const uint32_t col_idx_2) {
+  const auto *input_1 =
+      reinterpret_cast<const uint32_t *>(projected_column_->ColumnStart(static_cast<uint16_t>(col_idx_1)));
+  const auto *input_2 =
+      reinterpret_cast<const uint32_t *>(projected_column_->ColumnStart(static_cast<uint16_t>(col_idx_2)));
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  alignas(common::Constants::CACHELINE_SIZE) int32_t keys_1[common::Constants::K_DEFAULT_VECTOR_SIZE];
+  alignas(common::Constants::CACHELINE_SIZE) int32_t keys_2[common::Constants::K_DEFAULT_VECTOR_SIZE];
+  TERRIER_ASSERT(projected_column_->NumTuples() <= common::Constants::K_DEFAULT_VECTOR_SIZE, "Projection too large");
+  ComputeDateSortKeys(input_1, projected_column_->NumTuples(), keys_1);
+  ComputeDateSortKeys(input_2, projected_column_->NumTuples(), keys_2);
+
+  selection_vector_write_idx_ = util::VectorUtil::FilterVectorByVector<int32_t, Op>(keys_1, keys_2, num_selected_,
+                                                                                     selection_vector_, sel_vec);
+  ResetFiltered();
+  DeselectNulls(col_idx_1);
+  DeselectNulls(col_idx_2);
+  return NumSelected();
+}
+
+template <template <typename> typename Op>
+uint32_t ProjectedColumnsIterator::FilterVarlenColByValImpl(const uint32_t col_idx,
+                                                            const storage::VarlenEntry &val) {
+  if (const DictionaryCodes *dict = ChooseDictionary(col_idx); dict != nullptr) {
+    return FilterByDictionary(col_idx, *dict, [&](const storage::VarlenEntry &word) {
+      return StorageCompare::VarlenCompareWith<Op>(word, val);
+    });
+  }
+
+  const auto col = static_cast<uint16_t>(col_idx);
+  const auto *input = reinterpret_cast<const storage::VarlenEntry *>(projected_column_->ColumnStart(col));
+  const auto *null_bitmap = projected_column_->ColumnNullBitmap(col);
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  // NULL strings never pass, and their (undefined) contents are never read
+  selection_vector_write_idx_ = SelectMatching(num_selected_, sel_vec, selection_vector_, [&](const uint32_t idx) {
+    return null_bitmap->Test(idx) && StorageCompare::VarlenCompareWith<Op>(input[idx], val);
+  });
+  ResetFiltered();
+  return NumSelected();
+}
+
+template <template <typename> typename Op>
+uint32_t ProjectedColumnsIterator::FilterVarlenColByColImpl(const uint32_t col_idx_1, const uint32_t col_idx_2) {
+  const auto col_1 = static_cast<uint16_t>(col_idx_1), col_2 = static_cast<uint16_t>(col_idx_2);
+  const auto *input_1 = reinterpret_cast<const storage::VarlenEntry *>(projected_column_->ColumnStart(col_1));
+  const auto *input_2 = reinterpret_cast<const storage::VarlenEntry *>(projected_column_->ColumnStart(col_2));
+  const auto *null_bitmap_1 = projected_column_->ColumnNullBitmap(col_1);
+  const auto *null_bitmap_2 = projected_column_->ColumnNullBitmap(col_2);
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  selection_vector_write_idx_ = SelectMatching(num_selected_, sel_vec, selection_vector_, [&](const uint32_t idx) {
+    return null_bitmap_1->Test(idx) && null_bitmap_2->Test(idx) &&
+           StorageCompare::VarlenCompareWith<Op>(input_1[idx], input_2[idx]);
+  });
+  ResetFiltered();
+  return NumSelected();
+}
+
+uint32_t ProjectedColumnsIterator::FilterColByLike(const uint32_t col_idx, const LikePattern &pattern,
+                                                   const bool negated) {
+  if (const DictionaryCodes *dict = ChooseDictionary(col_idx); dict != nullptr) {
+    return FilterByDictionary(col_idx, *dict,
+                              [&](const storage::VarlenEntry &word) { return pattern.Matches(word) != negated; });
+  }
+
+  const auto col = static_cast<uint16_t>(col_idx);
+  const auto *input = reinterpret_cast<const storage::VarlenEntry *>(projected_column_->ColumnStart(col));
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  selection_vector_write_idx_ = pattern.FilterVector(input, projected_column_->ColumnNullBitmap(col), num_selected_,
+                                                     sel_vec, selection_vector_, negated);
+  ResetFiltered();
+  return NumSelected();
+}
+
+uint32_t ProjectedColumnsIterator::FilterColByInList(const uint32_t col_idx, const storage::VarlenEntry values[],
+                                                     const uint32_t num_values) {
+  const auto in_list = [&](const storage::VarlenEntry &str) {
+    return std::any_of(values, values + num_values, [&](const storage::VarlenEntry &value) {
+      return StorageCompare::VarlenCompareWith<std::equal_to>(str, value);
+    });
+  };
+  if (const DictionaryCodes *dict = ChooseDictionary(col_idx); dict != nullptr) {
+    return FilterByDictionary(col_idx, *dict, in_list);
+  }
+
+  const auto col = static_cast<uint16_t>(col_idx);
+  const auto *input = reinterpret_cast<const storage::VarlenEntry *>(projected_column_->ColumnStart(col));
+  const auto *null_bitmap = projected_column_->ColumnNullBitmap(col);
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+  selection_vector_write_idx_ = SelectMatching(num_selected_, sel_vec, selection_vector_, [&](const uint32_t idx) {
+    return null_bitmap->Test(idx) && in_list(input[idx]);
+  });
+  ResetFiltered();
+  return NumSelected();
+}
+
 // Filter an entire column's data by the provided constant value
 template <template <typename> typename Op>
 uint32_t ProjectedColumnsIterator::FilterColByVal(uint32_t col_idx, type::TypeId type, FilterVal val) {
   switch (type) {
+    case type::TypeId::TINYINT: {
+      return FilterColByValImpl<int8_t, Op>(col_idx, val.ti_);
+    }
     case type::TypeId::SMALLINT: {
       return FilterColByValImpl<int16_t, Op>(col_idx, val.si_);
     }
@@ -84,6 +431,19 @@ uint32_t ProjectedColumnsIterator::FilterColByVal(uint32_t col_idx, type::TypeId
     case type::TypeId::BIGINT: {
       return FilterColByValImpl<int64_t, Op>(col_idx, val.bi_);
     }
+    case type::TypeId::DATE: {
+      return FilterDateColByValImpl<Op>(col_idx, val.date_);
+    }
+    case type::TypeId::TIMESTAMP: {
+      return FilterColByValImpl<uint64_t, Op>(col_idx, val.ts_);
+    }
+    case type::TypeId::DECIMAL: {
+      return FilterColByValImpl<double, Op>(col_idx, val.dec_);
+    }
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      return FilterVarlenColByValImpl<Op>(col_idx, val.str_);
+    }
     default: {
       throw std::runtime_error("Filter not supported on type");
     }
@@ -96,6 +456,9 @@ uint32_t ProjectedColumnsIterator::FilterColByCol(const uint32_t col_idx_1, type
   TERRIER_ASSERT(type_1 == type_2, "Incompatible column types for filter");
 
   switch (type_1) {
+    case type::TypeId::TINYINT: {
+      return FilterColByColImpl<int8_t, Op>(col_idx_1, col_idx_2);
+    }
     case type::TypeId::SMALLINT: {
       return FilterColByColImpl<int16_t, Op>(col_idx_1, col_idx_2);
     }
@@ -105,6 +468,19 @@ uint32_t ProjectedColumnsIterator::FilterColByCol(const uint32_t col_idx_1, type
     case type::TypeId::BIGINT: {
       return FilterColByColImpl<int64_t, Op>(col_idx_1, col_idx_2);
     }
+    case type::TypeId::DATE: {
+      return FilterDateColByColImpl<Op>(col_idx_1, col_idx_2);
+    }
+    case type::TypeId::TIMESTAMP: {
+      return FilterColByColImpl<uint64_t, Op>(col_idx_1, col_idx_2);
+    }
+    case type::TypeId::DECIMAL: {
+      return FilterColByColImpl<double, Op>(col_idx_1, col_idx_2);
+    }
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      return FilterVarlenColByColImpl<Op>(col_idx_1, col_idx_2);
+    }
     default: {
       throw std::runtime_error("Filter not supported on type");
     }
@@ -3,10 +3,15 @@
 #include <tbb/tbb.h>
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <queue>
 #include <utility>
 #include <vector>
 
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/stage_timer.h"
 #include "ips4o/ips4o.hpp"
@@ -20,17 +25,54 @@ Sorter::Sorter(MemoryPool *memory, ComparisonFunction cmp_fn, uint32_t tuple_siz
       owned_tuples_(memory),
       cmp_fn_(cmp_fn),
       tuples_(memory),
-      sorted_(false) {}
+      sorted_(false),
+      memory_(memory),
+      tuple_size_(tuple_size),
+      memory_budget_(MemoryTracker::K_UNLIMITED),
+      spill_threshold_(std::numeric_limits<uint64_t>::max()),
+      num_spilled_tuples_(0) {
+  if (memory != nullptr && memory->GetTracker() != nullptr) {
+    SetMemoryBudget(memory->GetTracker()->GetMemoryLimit());
+  }
+}
 
 Sorter::~Sorter() = default;
 
-byte *Sorter::AllocInputTuple() {
+void Sorter::SetMemoryBudget(const std::size_t memory_budget) {
+  memory_budget_ = memory_budget;
+  if (memory_budget == MemoryTracker::K_UNLIMITED) {
+    spill_threshold_ = std::numeric_limits<uint64_t>::max();
+  } else {
+    // Each buffered tuple costs its own size plus the pointer used to sort it
+    spill_threshold_ = std::max(uint64_t(1), memory_budget / (tuple_size_ + sizeof(const byte *)));
+  }
+}
+
+byte *Sorter::AllocInputTupleInternal() {
   byte *ret = tuple_storage_.Append();
   tuples_.push_back(ret);
   return ret;
 }
 
-byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTuple(); }
+byte *Sorter::AllocInputTuple() {
+  // The previously allocated tuple has been filled by now, so it's safe to spill
+  if (tuples_.size() >= spill_threshold_ || QueryOverLimit()) {
+    SpillRun();
+  }
+  return AllocInputTupleInternal();
+}
+
+bool Sorter::QueryOverLimit() const {
+  // Summing the tracker's thread-local counters is not free, so it is not done for every tuple
+  if (memory_budget_ == MemoryTracker::K_UNLIMITED || tuples_.empty() ||
+      tuples_.size() % K_QUERY_LIMIT_CHECK_INTERVAL != 0) {
+    return false;
+  }
+  return memory_ != nullptr && memory_->GetTracker() != nullptr && memory_->GetTracker()->IsOverLimit();
+}
+
+// TopK only ever buffers K tuples, so it never spills
+byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTupleInternal(); }
 
 void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
   // If the number of buffered tuples is less than top_k, we're done
@@ -103,6 +145,16 @@ void Sorter::Sort() {
     return;
   }
 
+  // If we've spilled, sort the in-memory tuples as the final run and reduce the
+  // number of spilled runs so they can all be merged at once during iteration
+  if (HasSpilled()) {
+    const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+    ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+    ReduceRuns();
+    sorted_ = true;
+    return;
+  }
+
   // Exit if there are no input tuples
   if (tuples_.empty()) {
     return;
@@ -112,9 +164,11 @@ void Sorter::Sort() {
   util::Timer<std::milli> timer;
   timer.Start();
 
-  // Sort the sucker
+  // Sort the sucker, unless it was fed in order (e.g., by an ordered index scan)
   const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
-  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  if (!std::is_sorted(tuples_.begin(), tuples_.end(), compare)) {
+    ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  }
 
   timer.Stop();
 
@@ -125,6 +179,138 @@ void Sorter::Sort() {
   sorted_ = true;
 }
 
+// Writes tuples sequentially to the end of a spill file as a single run,
+// gathering them into a buffer so that we issue large writes.
+class Sorter::RunWriter {
+ public:
+  RunWriter(SpillFile *file, MemoryPool *memory, const uint32_t tuple_size)
+      : file_(file),
+        tuple_size_(tuple_size),
+        buffer_(std::max<std::size_t>(K_MERGE_BUFFER_SIZE / tuple_size, 1) * tuple_size, memory),
+        buffered_(0),
+        run_{file, file->Size(), 0} {}
+
+  void Append(const byte *tuple) {
+    std::memcpy(buffer_.data() + buffered_, tuple, tuple_size_);
+    buffered_ += tuple_size_;
+    run_.num_tuples_++;
+    if (buffered_ == buffer_.size()) {
+      Flush();
+    }
+  }
+
+  SpilledRun Finish() {
+    Flush();
+    return run_;
+  }
+
+ private:
+  void Flush() {
+    if (buffered_ > 0) {
+      file_->Append(buffer_.data(), buffered_);
+      buffered_ = 0;
+    }
+  }
+
+ private:
+  SpillFile *file_;
+  uint32_t tuple_size_;
+  MemPoolVector<byte> buffer_;
+  std::size_t buffered_;
+  SpilledRun run_;
+};
+
+void Sorter::SpillRun() {
+  if (tuples_.empty()) {
+    return;
+  }
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  WriteRun(tuples_.data(), tuples_.data() + tuples_.size());
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("Spilled run of {} tuples in {} ms", tuples_.size(), timer.Elapsed());
+
+  // Release the memory of the in-memory tuples, so the query-wide total drops
+  tuples_ = MemPoolVector<const byte *>(memory_);
+  tuple_storage_ = util::ChunkedVector<MemoryPoolAllocator<byte>>(tuple_size_, MemoryPoolAllocator<byte>(memory_));
+}
+
+void Sorter::WriteRun(const byte *const *begin, const byte *const *end) {
+  RunWriter writer(CurrentSpillFile(), memory_, tuple_size_);
+  for (; begin != end; ++begin) {
+    writer.Append(*begin);
+  }
+  runs_.push_back(writer.Finish());
+  num_spilled_tuples_ += runs_.back().num_tuples_;
+}
+
+SpillFile *Sorter::CurrentSpillFile() {
+  if (spill_files_.empty()) {
+    spill_files_.emplace_back(std::make_unique<SpillFile>());
+  }
+  return spill_files_.back().get();
+}
+
+uint32_t Sorter::MergeFanIn() const {
+  if (memory_budget_ == MemoryTracker::K_UNLIMITED) {
+    return K_MAX_MERGE_FAN_IN;
+  }
+  const auto fan_in = static_cast<uint32_t>(
+      std::min(memory_budget_ / K_MERGE_BUFFER_SIZE, static_cast<std::size_t>(K_MAX_MERGE_FAN_IN)));
+  return std::max(fan_in, K_MIN_MERGE_FAN_IN);
+}
+
+void Sorter::ReduceRuns() {
+  // The in-memory tuples form one more input to the final merge
+  const uint32_t fan_in = MergeFanIn();
+  const uint32_t extra_inputs = tuples_.empty() ? 0 : 1;
+
+  // Repeatedly merge the oldest runs into a new run until the remaining runs
+  // (and the in-memory run) can all be merged at once
+  std::size_t next_run = 0;
+  while (runs_.size() - next_run + extra_inputs > fan_in) {
+    const std::size_t num_inputs = std::min<std::size_t>(fan_in, runs_.size() - next_run);
+
+    SortedRunMerger merger(memory_, cmp_fn_, tuple_size_);
+    UNUSED_ATTRIBUTE uint64_t num_tuples = 0;
+    for (std::size_t i = next_run; i < next_run + num_inputs; i++) {
+      const SpilledRun &run = runs_[i];
+      merger.AddRun(run.file_, run.offset_, run.num_tuples_, K_MERGE_BUFFER_SIZE);
+      num_tuples += run.num_tuples_;
+    }
+    merger.Init();
+    next_run += num_inputs;
+
+    // Stream the merged output into a new run at the end of the current file
+    RunWriter writer(CurrentSpillFile(), memory_, tuple_size_);
+    for (; merger.HasNext(); merger.Next()) {
+      writer.Append(merger.GetRow());
+    }
+    runs_.push_back(writer.Finish());
+    TERRIER_ASSERT(runs_.back().num_tuples_ == num_tuples, "Merge lost tuples");
+  }
+
+  // Drop runs that were merged into larger runs
+  runs_.erase(runs_.begin(), runs_.begin() + next_run);
+}
+
+std::unique_ptr<SortedRunMerger> Sorter::CreateMerger() {
+  auto merger = std::make_unique<SortedRunMerger>(memory_, cmp_fn_, tuple_size_);
+  for (const auto &run : runs_) {
+    merger->AddRun(run.file_, run.offset_, run.num_tuples_, K_MERGE_BUFFER_SIZE);
+  }
+  if (!tuples_.empty()) {
+    merger->AddRun(tuples_.data(), tuples_.data() + tuples_.size());
+  }
+  merger->Init();
+  return merger;
+}
+
 namespace {
 
 // Structure we use to track a package of merging work.
@@ -157,6 +343,12 @@ void Sorter::SortParallel(const ThreadStateContainer *thread_state_container, co
     return;
   }
 
+  // If any thread-local sorter spilled, the inputs can't be merged in memory
+  if (std::any_of(tl_sorters.begin(), tl_sorters.end(), [](const Sorter *sorter) { return sorter->HasSpilled(); })) {
+    SortParallelExternal(tl_sorters);
+    return;
+  }
+
   // -------------------------------------------------------
   // 1. Make room in this sorter for all result tuples
   // -------------------------------------------------------
@@ -329,13 +521,207 @@ void Sorter::SortParallel(const ThreadStateContainer *thread_state_container, co
   }
 }
 
+void Sorter::SortParallelExternal(const std::vector<Sorter *> &tl_sorters) {
+  // Spill the remaining in-memory tuples of each thread-local sorter in
+  // parallel, so every input is a sorted run on disk
+  tbb::task_scheduler_init sched;
+  tbb::parallel_for_each(tl_sorters.begin(), tl_sorters.end(), [](Sorter *const sorter) { sorter->SpillRun(); });
+
+  // Take ownership of all spilled runs and the files they live in
+  for (auto *tl_sorter : tl_sorters) {
+    for (auto &file : tl_sorter->spill_files_) {
+      spill_files_.emplace_back(std::move(file));
+    }
+    runs_.insert(runs_.end(), tl_sorter->runs_.begin(), tl_sorter->runs_.end());
+    num_spilled_tuples_ += tl_sorter->num_spilled_tuples_;
+    tl_sorter->spill_files_.clear();
+    tl_sorter->runs_.clear();
+    tl_sorter->num_spilled_tuples_ = 0;
+  }
+
+  ips4o::sort(tuples_.begin(), tuples_.end(), [this](const byte *l, const byte *r) { return cmp_fn_(l, r) < 0; });
+  ReduceRuns();
+  sorted_ = true;
+}
+
 void Sorter::SortTopKParallel(const ThreadStateContainer *thread_state_container, const uint32_t sorter_offset,
                               const uint64_t top_k) {
   // Parallel sort
   SortParallel(thread_state_container, sorter_offset);
 
-  // Trim to top-K
-  tuples_.resize(top_k);
+  // Trim to top-K. Thread-local top-K sorters never spill.
+  TERRIER_ASSERT(!HasSpilled(), "Top-K sorters should never spill");
+  tuples_.resize(std::min(top_k, static_cast<uint64_t>(tuples_.size())));
+}
+
+// ---------------------------------------------------------
+// Sorted Run Merger
+// ---------------------------------------------------------
+
+class SortedRunMerger::Source {
+ public:
+  // A run on disk
+  Source(MemoryPool *memory, const SpillFile *file, const uint64_t offset, const uint64_t num_tuples,
+         const uint32_t tuple_size, const std::size_t buffer_size)
+      : file_(file),
+        next_offset_(offset),
+        remaining_(num_tuples),
+        tuple_size_(tuple_size),
+        buffer_(std::max<std::size_t>(buffer_size / tuple_size, 1) * tuple_size, memory),
+        pos_(nullptr),
+        end_(nullptr),
+        mem_pos_(nullptr),
+        mem_end_(nullptr) {
+    Refill();
+  }
+
+  // A run in memory
+  Source(MemoryPool *memory, const byte *const *begin, const byte *const *end)
+      : file_(nullptr),
+        next_offset_(0),
+        remaining_(0),
+        tuple_size_(0),
+        buffer_(memory),
+        pos_(nullptr),
+        end_(nullptr),
+        mem_pos_(begin),
+        mem_end_(end) {}
+
+  bool Exhausted() const { return file_ == nullptr ? mem_pos_ == mem_end_ : pos_ == end_; }
+
+  const byte *Current() const { return file_ == nullptr ? *mem_pos_ : pos_; }
+
+  void Advance() {
+    if (file_ == nullptr) {
+      ++mem_pos_;
+      return;
+    }
+    pos_ += tuple_size_;
+    if (pos_ == end_ && remaining_ > 0) {
+      Refill();
+    }
+  }
+
+ private:
+  // Read the next block of the run into the buffer, and ask the OS to begin
+  // reading the block after it
+  void Refill() {
+    const uint64_t buffer_tuples = buffer_.size() / tuple_size_;
+    const uint64_t num_tuples = std::min(buffer_tuples, remaining_);
+    const std::size_t num_bytes = num_tuples * tuple_size_;
+    file_->Read(next_offset_, buffer_.data(), num_bytes);
+    next_offset_ += num_bytes;
+    remaining_ -= num_tuples;
+    pos_ = buffer_.data();
+    end_ = pos_ + num_bytes;
+    if (remaining_ > 0) {
+      file_->WillNeed(next_offset_, std::min(buffer_tuples, remaining_) * tuple_size_);
+    }
+  }
+
+ private:
+  // Disk-based run state
+  const SpillFile *file_;
+  uint64_t next_offset_;
+  uint64_t remaining_;
+  uint32_t tuple_size_;
+  MemPoolVector<byte> buffer_;
+  const byte *pos_;
+  const byte *end_;
+  // Memory-based run state
+  const byte *const *mem_pos_;
+  const byte *const *mem_end_;
+};
+
+SortedRunMerger::SortedRunMerger(MemoryPool *memory, Sorter::ComparisonFunction cmp_fn, uint32_t tuple_size)
+    : memory_(memory), cmp_fn_(cmp_fn), tuple_size_(tuple_size) {}
+
+SortedRunMerger::~SortedRunMerger() = default;
+
+void SortedRunMerger::AddRun(const SpillFile *file, const uint64_t offset, const uint64_t num_tuples,
+                             const std::size_t buffer_size) {
+  if (num_tuples == 0) {
+    return;
+  }
+  sources_.emplace_back(std::make_unique<Source>(memory_, file, offset, num_tuples, tuple_size_, buffer_size));
+}
+
+void SortedRunMerger::AddRun(const byte *const *begin, const byte *const *end) {
+  if (begin == end) {
+    return;
+  }
+  sources_.emplace_back(std::make_unique<Source>(memory_, begin, end));
+}
+
+void SortedRunMerger::Init() {
+  heap_.clear();
+  for (auto &source : sources_) {
+    if (!source->Exhausted()) {
+      heap_.push_back(source.get());
+    }
+  }
+  // std::make_heap builds a max-heap, so invert the comparison
+  std::make_heap(heap_.begin(), heap_.end(),
+                 [this](const Source *l, const Source *r) { return cmp_fn_(l->Current(), r->Current()) > 0; });
+}
+
+const byte *SortedRunMerger::GetRow() const {
+  TERRIER_ASSERT(HasNext(), "Reading from exhausted merger");
+  return heap_.front()->Current();
 }
 
+void SortedRunMerger::Next() {
+  TERRIER_ASSERT(HasNext(), "Advancing exhausted merger");
+  Source *top = heap_.front();
+  top->Advance();
+  if (top->Exhausted()) {
+    heap_.front() = heap_.back();
+    heap_.pop_back();
+  }
+  if (!heap_.empty()) {
+    SiftDown();
+  }
+}
+
+void SortedRunMerger::SiftDown() {
+  const std::size_t size = heap_.size();
+  std::size_t idx = 0;
+  Source *const top = heap_[idx];
+
+  while (true) {
+    std::size_t child = (2 * idx) + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size && cmp_fn_(heap_[child + 1]->Current(), heap_[child]->Current()) < 0) {
+      child++;
+    }
+    if (cmp_fn_(top->Current(), heap_[child]->Current()) <= 0) {
+      break;
+    }
+    heap_[idx] = heap_[child];
+    idx = child;
+  }
+
+  heap_[idx] = top;
+}
+
+// ---------------------------------------------------------
+// Sorter Iterator
+// ---------------------------------------------------------
+
+SorterIterator::SorterIterator(Sorter *sorter)
+    : iter_(sorter->tuples_.begin()),
+      end_(sorter->tuples_.end()),
+      merger_(sorter->HasSpilled() ? sorter->CreateMerger() : nullptr) {}
+
+SorterIterator::~SorterIterator() = default;
+
+// ---------------------------------------------------------
+// Merge Join Cursor
+// ---------------------------------------------------------
+
+MergeJoinCursor::MergeJoinCursor(Sorter *sorter)
+    : iter_(sorter), tuple_size_(sorter->tuple_size_), run_(sorter->memory_), run_pos_(0) {}
+
 }  // namespace terrier::execution::sql
@@ -0,0 +1,168 @@
+#include "execution/sql/spill_file.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "storage/write_ahead_log/log_io.h"
+
+namespace terrier::execution::sql {
+
+SpillFile::SpillFile(const std::string &directory) : fd_(-1), size_(0) {
+  std::string path_template = directory + "/terrier_spill_XXXXXX";
+  std::vector<char> path(path_template.begin(), path_template.end());
+  path.push_back('\0');
+
+  while (true) {
+    fd_ = mkstemp(path.data());
+    if (fd_ == -1) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Failed to create spill file with errno " + std::to_string(errno));
+    }
+    break;
+  }
+
+  // Unlink immediately so the storage is reclaimed when the descriptor is closed
+  unlink(path.data());
+}
+
+SpillFile::~SpillFile() {
+  if (fd_ != -1) {
+    storage::PosixIoWrappers::Close(fd_);
+  }
+}
+
+uint64_t SpillFile::Append(const void *data, const std::size_t size) {
+  const uint64_t offset = size_;
+  storage::PosixIoWrappers::WriteFully(fd_, data, size);
+  size_ += size;
+  return offset;
+}
+
+void SpillFile::Read(const uint64_t offset, void *dest, const std::size_t size) const {
+  TERRIER_ASSERT(offset + size <= size_, "Read beyond end of spill file");
+  std::size_t bytes_read = 0;
+  while (bytes_read < size) {
+    ssize_t ret = pread(fd_, reinterpret_cast<char *>(dest) + bytes_read, size - bytes_read,
+                        static_cast<off_t>(offset + bytes_read));
+    if (ret == -1) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Read from spill file failed with errno " + std::to_string(errno));
+    }
+    if (ret == 0) {
+      throw std::runtime_error("Unexpected end of spill file");
+    }
+    bytes_read += ret;
+  }
+}
+
+void SpillFile::WillNeed(UNUSED_ATTRIBUTE const uint64_t offset, UNUSED_ATTRIBUTE const std::size_t size) const {
+#ifdef POSIX_FADV_WILLNEED
+  posix_fadvise(fd_, static_cast<off_t>(offset), static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+#endif
+}
+
+std::string SpillFile::DefaultDirectory() {
+  const char *tmp_dir = std::getenv("TMPDIR");
+  return tmp_dir != nullptr && tmp_dir[0] != '\0' ? std::string(tmp_dir) : std::string("/tmp");
+}
+
+// ---------------------------------------------------------
+// Spill Partition
+// ---------------------------------------------------------
+
+SpillPartition::SpillPartition(MemoryPool *memory, const uint32_t entry_size, const std::size_t buffer_size)
+    : memory_(memory),
+      entry_size_(entry_size),
+      buffer_capacity_(static_cast<uint32_t>(std::max<std::size_t>(buffer_size / entry_size, 1))),
+      buffer_(memory),
+      num_buffered_(0),
+      num_flushed_(0) {}
+
+byte *SpillPartition::Append(SpillFile *file) {
+  if (num_buffered_ == buffer_capacity_) {
+    WriteBuffer(file);
+  }
+  if (buffer_.empty()) {
+    buffer_.resize(static_cast<std::size_t>(buffer_capacity_) * entry_size_);
+  }
+  return buffer_.data() + static_cast<std::size_t>(num_buffered_++) * entry_size_;
+}
+
+void SpillPartition::Append(SpillFile *file, const byte *entry) { std::memcpy(Append(file), entry, entry_size_); }
+
+void SpillPartition::WriteBuffer(SpillFile *file) {
+  if (num_buffered_ > 0) {
+    const uint64_t offset = file->Append(buffer_.data(), static_cast<std::size_t>(num_buffered_) * entry_size_);
+    chunks_.push_back(Chunk{file, offset, num_buffered_});
+    num_flushed_ += num_buffered_;
+    num_buffered_ = 0;
+  }
+}
+
+void SpillPartition::Flush(SpillFile *file) {
+  WriteBuffer(file);
+  MemPoolVector<byte>(memory_).swap(buffer_);
+}
+
+void SpillPartition::Adopt(SpillPartition *other) {
+  TERRIER_ASSERT(entry_size_ == other->entry_size_, "Mismatched entry sizes");
+  TERRIER_ASSERT(other->num_buffered_ == 0, "Adopted partition must be flushed");
+  chunks_.insert(chunks_.end(), other->chunks_.begin(), other->chunks_.end());
+  num_flushed_ += other->num_flushed_;
+  other->Clear();
+}
+
+void SpillPartition::Clear() {
+  MemPoolVector<byte>(memory_).swap(buffer_);
+  std::vector<Chunk>().swap(chunks_);
+  num_buffered_ = 0;
+  num_flushed_ = 0;
+}
+
+// ---------------------------------------------------------
+// Spill Partition Reader
+// ---------------------------------------------------------
+
+SpillPartitionReader::SpillPartitionReader(const SpillPartition *partition)
+    : partition_(partition), buffer_(partition->memory_), next_chunk_(0), pos_(nullptr), end_(nullptr) {
+  TERRIER_ASSERT(partition->num_buffered_ == 0, "Partition must be flushed before it is read");
+}
+
+void SpillPartitionReader::LoadChunk(const std::size_t idx) {
+  const auto &chunk = partition_->chunks_[idx];
+  const std::size_t size = static_cast<std::size_t>(chunk.num_entries_) * partition_->entry_size_;
+  if (buffer_.size() < size) {
+    buffer_.resize(size);
+  }
+  chunk.file_->Read(chunk.offset_, buffer_.data(), size);
+  pos_ = buffer_.data();
+  end_ = pos_ + size;
+
+  // Let the OS read ahead the next chunk while this one is consumed
+  if (idx + 1 < partition_->chunks_.size()) {
+    const auto &next = partition_->chunks_[idx + 1];
+    next.file_->WillNeed(next.offset_, static_cast<std::size_t>(next.num_entries_) * partition_->entry_size_);
+  }
+}
+
+const byte *SpillPartitionReader::Next() {
+  if (pos_ == end_) {
+    if (next_chunk_ == partition_->chunks_.size()) {
+      return nullptr;
+    }
+    LoadChunk(next_chunk_++);
+  }
+  const byte *entry = pos_;
+  pos_ += partition_->entry_size_;
+  return entry;
+}
+
+}  // namespace terrier::execution::sql
@@ -5,6 +5,7 @@
 
 #include "execution/exec/execution_context.h"
 #include "execution/util/execution_common.h"
+#include "optimizer/statistics/table_stats_delta.h"
 
 namespace terrier::execution::sql {
 
@@ -14,7 +15,16 @@ StorageInterface::StorageInterface(exec::ExecutionContext *exec_ctx, catalog::ta
       table_(exec_ctx->GetAccessor()->GetTable(table_oid)),
       exec_ctx_(exec_ctx),
       col_oids_(col_oids, col_oids + num_oids),
-      need_indexes_(need_indexes) {
+      need_indexes_(need_indexes),
+      stats_delta_(exec_ctx->GetTableStatsDelta(table_oid)) {
+  // Find the written columns whose values feed the table statistics
+  if (stats_delta_ != nullptr && !col_oids_.empty()) {
+    const auto &schema = exec_ctx->GetAccessor()->GetSchema(table_oid);
+    for (const auto &[col_oid, pr_index] : table_->ProjectionMapForOids(col_oids_)) {
+      stats_columns_.push_back({pr_index, schema.GetColumn(col_oid).Type(), stats_delta_->GetColumnSummary(col_oid)});
+    }
+  }
+
   // Initialize the index projected row if needed.
   if (need_indexes_) {
     // Get index pr size
@@ -49,20 +59,44 @@ storage::ProjectedRow *StorageInterface::GetIndexPR(catalog::index_oid_t index_o
 
 storage::TupleSlot StorageInterface::TableInsert() {
   exec_ctx_->RowsAffected()++;  // believe this should only happen in root plan nodes, so should reflect count of query
-  return table_->Insert(exec_ctx_->GetTxn(), table_redo_);
+  const auto slot = table_->Insert(exec_ctx_->GetTxn(), table_redo_);
+  if (stats_delta_ != nullptr) {
+    stats_delta_->RecordInsert();
+    RecordStats();
+  }
+  return slot;
 }
 
 bool StorageInterface::TableDelete(storage::TupleSlot table_tuple_slot) {
   exec_ctx_->RowsAffected()++;  // believe this should only happen in root plan nodes, so should reflect count of query
   auto txn = exec_ctx_->GetTxn();
   txn->StageDelete(exec_ctx_->DBOid(), table_oid_, table_tuple_slot);
-  return table_->Delete(exec_ctx_->GetTxn(), table_tuple_slot);
+  const bool result = table_->Delete(exec_ctx_->GetTxn(), table_tuple_slot);
+  if (result && stats_delta_ != nullptr) stats_delta_->RecordDelete();
+  return result;
 }
 
 bool StorageInterface::TableUpdate(storage::TupleSlot table_tuple_slot) {
   exec_ctx_->RowsAffected()++;  // believe this should only happen in root plan nodes, so should reflect count of query
   table_redo_->SetTupleSlot(table_tuple_slot);
-  return table_->Update(exec_ctx_->GetTxn(), table_redo_);
+  const bool result = table_->Update(exec_ctx_->GetTxn(), table_redo_);
+  if (result && stats_delta_ != nullptr) {
+    stats_delta_->RecordUpdate();
+    RecordStats();
+  }
+  return result;
+}
+
+void StorageInterface::RecordStats() {
+  const storage::ProjectedRow &row = *table_redo_->Delta();
+  for (const auto &column : stats_columns_) {
+    const byte *const value = row.AccessWithNullCheck(column.pr_index_);
+    if (value == nullptr) {
+      column.summary_->AddNull();
+    } else {
+      column.summary_->Add(column.type_, value);
+    }
+  }
 }
 
 bool StorageInterface::IndexInsert() {
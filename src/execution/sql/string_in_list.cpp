@@ -0,0 +1,27 @@
+#include "execution/sql/string_in_list.h"
+
+#include <cstring>
+#include <vector>
+
+namespace terrier::execution::sql {
+
+StringInList::StringInList(const std::vector<std::string_view> &values) {
+  std::size_t total_size = 0;
+  for (const auto &value : values) total_size += value.size();
+  contents_ = std::make_unique<byte[]>(total_size);
+
+  values_.reserve(values.size());
+  byte *pos = contents_.get();
+  for (const auto &value : values) {
+    const auto size = static_cast<uint32_t>(value.size());
+    std::memcpy(pos, value.data(), size);
+    if (size <= storage::VarlenEntry::InlineThreshold()) {
+      values_.emplace_back(storage::VarlenEntry::CreateInline(pos, size));
+    } else {
+      values_.emplace_back(storage::VarlenEntry::Create(pos, size, false));
+    }
+    pos += size;
+  }
+}
+
+}  // namespace terrier::execution::sql
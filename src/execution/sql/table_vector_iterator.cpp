@@ -4,11 +4,14 @@
 #include <tbb/parallel_for.h>
 #include <tbb/task_scheduler_init.h>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <vector>
 
 #include "execution/exec/execution_context.h"
 #include "execution/util/timer.h"
+#include "storage/storage_util.h"
 
 namespace terrier::execution::sql {
 TableVectorIterator::TableVectorIterator(exec::ExecutionContext *exec_ctx, uint32_t table_oid, uint32_t *col_oids,
@@ -17,6 +20,9 @@ TableVectorIterator::TableVectorIterator(exec::ExecutionContext *exec_ctx, uint3
 
 TableVectorIterator::~TableVectorIterator() {
   exec_ctx_->GetMemoryPool()->Deallocate(buffer_, projected_columns_->Size());
+  if (filter_columns_ != nullptr) exec_ctx_->GetMemoryPool()->Deallocate(filter_buffer_, filter_columns_->Size());
+  if (deferred_row_ != nullptr) exec_ctx_->GetMemoryPool()->Deallocate(deferred_buffer_, deferred_row_->Size());
+  if (fetch_row_ != nullptr) exec_ctx_->GetMemoryPool()->Deallocate(fetch_buffer_, fetch_row_->Size());
 }
 
 bool TableVectorIterator::Init() {
@@ -31,20 +37,150 @@ bool TableVectorIterator::Init() {
   projected_columns_ = pc_init.Initialize(buffer_);
   initialized_ = true;
 
+  // Find the string columns, which may be dictionary compressed
+  const auto &schema = exec_ctx_->GetAccessor()->GetSchema(table_oid_);
+  const auto projection_map = table_->ProjectionMapForOids(col_oids_);
+  for (const auto &col_oid : col_oids_) {
+    const type::TypeId type = schema.GetColumn(col_oid).Type();
+    if (type == type::TypeId::VARCHAR || type == type::TypeId::VARBINARY) {
+      varlen_cols_.push_back(projection_map.at(col_oid));
+    }
+  }
+  dictionary_codes_ = std::make_unique<uint32_t[]>(varlen_cols_.size() * common::Constants::K_DEFAULT_VECTOR_SIZE);
+
   // Begin iterating
   iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->begin());
   return true;
 }
 
+void TableVectorIterator::AddRangeFilter(const uint32_t col_oid, const int64_t min_key, const int64_t max_key) {
+  TERRIER_ASSERT(initialized_, "Iterator must be initialized before adding filters");
+  table_->AddZoneMapRange(&zone_map_filter_, catalog::col_oid_t(col_oid), min_key, max_key);
+}
+
+void TableVectorIterator::SetFilterColumns(const uint32_t *col_oids, const uint32_t num_oids) {
+  TERRIER_ASSERT(initialized_, "Iterator must be initialized before setting the filter columns");
+  std::vector<catalog::col_oid_t> filter_oids, deferred_oids;
+  for (const auto &col_oid : col_oids_) {
+    if (std::find(col_oids, col_oids + num_oids, !col_oid) != col_oids + num_oids) {
+      filter_oids.push_back(col_oid);
+    } else {
+      deferred_oids.push_back(col_oid);
+    }
+  }
+  TERRIER_ASSERT(filter_oids.size() == num_oids, "Filter columns must be scanned columns");
+  // Nothing to defer
+  if (filter_oids.empty() || deferred_oids.empty()) return;
+
+  // Columns are matched with their index in the PC through their ids
+  auto pc_index = [this](const storage::col_id_t col_id) {
+    const storage::col_id_t *pc_col_ids = projected_columns_->ColumnIds();
+    return static_cast<uint16_t>(std::find(pc_col_ids, pc_col_ids + projected_columns_->NumColumns(), col_id) -
+                                 pc_col_ids);
+  };
+
+  auto pc_init = table_->InitializerForProjectedColumns(filter_oids, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  filter_buffer_ =
+      exec_ctx_->GetMemoryPool()->AllocateAligned(pc_init.ProjectedColumnsSize(), alignof(uint64_t), false);
+  filter_columns_ = pc_init.Initialize(filter_buffer_);
+  for (uint16_t i = 0; i < filter_columns_->NumColumns(); i++) {
+    filter_cols_.push_back(pc_index(filter_columns_->ColumnIds()[i]));
+  }
+
+  auto pr_init = table_->InitializerForProjectedRow(deferred_oids);
+  deferred_buffer_ = exec_ctx_->GetMemoryPool()->AllocateAligned(pr_init.ProjectedRowSize(), alignof(uint64_t), false);
+  deferred_row_ = pr_init.InitializeRow(deferred_buffer_);
+  for (uint16_t i = 0; i < deferred_row_->NumColumns(); i++) {
+    deferred_cols_.push_back(pc_index(deferred_row_->ColumnIds()[i]));
+  }
+
+  for (uint16_t i = 0; i < projected_columns_->NumColumns(); i++) {
+    col_sizes_.push_back(static_cast<uint8_t>(projected_columns_->AttrSizeForColumn(i)));
+  }
+}
+
+void TableVectorIterator::ScanFilterColumns() {
+  table_->Scan(exec_ctx_->GetTxn(), iter_.get(), filter_columns_,
+               zone_map_filter_.Empty() ? nullptr : &zone_map_filter_);
+
+  // The PCI reads the filter columns from the PC, where they are found at the same indexes as in an eager scan
+  const uint32_t num_tuples = filter_columns_->NumTuples();
+  std::memcpy(projected_columns_->TupleSlots(), filter_columns_->TupleSlots(), num_tuples * sizeof(storage::TupleSlot));
+  for (uint16_t i = 0; i < filter_cols_.size(); i++) {
+    const uint16_t col = filter_cols_[i];
+    std::memcpy(projected_columns_->ColumnStart(col), filter_columns_->ColumnStart(i), num_tuples * col_sizes_[col]);
+    std::memcpy(static_cast<void *>(projected_columns_->ColumnNullBitmap(col)),
+                static_cast<void *>(filter_columns_->ColumnNullBitmap(i)), common::RawBitmap::SizeInBytes(num_tuples));
+  }
+  projected_columns_->SetNumTuples(num_tuples);
+}
+
+void TableVectorIterator::Materialize() {
+  if (materialized_) return;
+  materialized_ = true;
+
+  const uint32_t *sel = pci_.GetSelectionVector();
+  const uint32_t num_selected = sel == nullptr ? projected_columns_->NumTuples() : pci_.NumSelected();
+  const storage::TupleSlot *slots = projected_columns_->TupleSlots();
+  for (uint32_t i = 0; i < num_selected; i++) {
+    const uint32_t pos = sel == nullptr ? i : sel[i];
+    // The tuple was visible to the scan, so it is visible here too
+    UNUSED_ATTRIBUTE bool visible = table_->Select(exec_ctx_->GetTxn(), slots[pos], deferred_row_);
+    TERRIER_ASSERT(visible, "Scanned tuple must be visible");
+    storage::ProjectedColumns::RowView row = projected_columns_->InterpretAsRow(pos);
+    for (uint16_t j = 0; j < deferred_cols_.size(); j++) {
+      const uint16_t col = deferred_cols_[j];
+      storage::StorageUtil::CopyWithNullCheck(deferred_row_->AccessWithNullCheck(j), &row, col_sizes_[col], col);
+    }
+  }
+
+  // Stop deferring columns if the filter passes too many tuples for it to pay off
+  if (num_scanned_ < K_LATE_MATERIALIZATION_SAMPLE_SIZE) {
+    num_scanned_ += projected_columns_->NumTuples();
+    num_materialized_ += num_selected;
+    if (num_scanned_ >= K_LATE_MATERIALIZATION_SAMPLE_SIZE &&
+        static_cast<double>(num_materialized_) >
+            static_cast<double>(num_scanned_) * K_LATE_MATERIALIZATION_MAX_PASS_RATE) {
+      deferred_cols_.clear();
+    }
+  }
+}
+
+storage::ProjectedRow *TableVectorIterator::FetchRow(const storage::TupleSlot slot) {
+  TERRIER_ASSERT(initialized_, "Iterator must be initialized before fetching rows");
+  if (fetch_row_ == nullptr) {
+    auto pr_init = table_->InitializerForProjectedRow(col_oids_);
+    fetch_buffer_ = exec_ctx_->GetMemoryPool()->AllocateAligned(pr_init.ProjectedRowSize(), alignof(uint64_t), false);
+    fetch_row_ = pr_init.InitializeRow(fetch_buffer_);
+  }
+  UNUSED_ATTRIBUTE bool visible = table_->Select(exec_ctx_->GetTxn(), slot, fetch_row_);
+  TERRIER_ASSERT(visible, "Fetched tuple must be visible");
+  return fetch_row_;
+}
+
 bool TableVectorIterator::Advance() {
   if (!initialized_) return false;
   // First check if the iterator ended.
   if (*iter_ == table_->end()) {
     return false;
   }
-  // Scan the table to set the projected column.
-  table_->Scan(exec_ctx_->GetTxn(), iter_.get(), projected_columns_);
+  // Scan the table to set the projected column. With late materialization, only the filter columns are read now.
+  materialized_ = deferred_cols_.empty();
+  if (materialized_) {
+    table_->Scan(exec_ctx_->GetTxn(), iter_.get(), projected_columns_,
+                 zone_map_filter_.Empty() ? nullptr : &zone_map_filter_);
+  } else {
+    ScanFilterColumns();
+  }
   pci_.SetProjectedColumn(projected_columns_);
+
+  // Expose the dictionary codes of string columns, so that filters and hashing on them can work on the dictionary
+  for (uint32_t i = 0; i < varlen_cols_.size(); i++) {
+    uint32_t *codes = &dictionary_codes_[i * common::Constants::K_DEFAULT_VECTOR_SIZE];
+    const storage::ArrowVarlenColumn *dictionary =
+        table_->ReadDictionaryCodes(*projected_columns_, varlen_cols_[i], codes);
+    if (dictionary != nullptr) pci_.SetDictionaryCodes(varlen_cols_[i], codes, dictionary);
+  }
   return true;
 }
 
@@ -0,0 +1,74 @@
+#include "execution/sql/vector.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "type/type_util.h"
+
+namespace terrier::execution::sql {
+
+Vector::Vector(const type::TypeId type)
+    : type_(type),
+      count_(0),
+      is_constant_(false),
+      sel_vector_(nullptr),
+      data_(nullptr),
+      owned_data_(new byte[GetTypeSize(type) * common::Constants::K_DEFAULT_VECTOR_SIZE]) {
+  data_ = owned_data_.get();
+}
+
+Vector::Vector(const type::TypeId type, byte *const data, const uint32_t count)
+    : type_(type), count_(count), is_constant_(false), sel_vector_(nullptr), data_(data) {
+  TERRIER_ASSERT(count <= common::Constants::K_DEFAULT_VECTOR_SIZE, "Too many elements in vector");
+}
+
+void Vector::Reference(byte *const data, const uint32_t count) {
+  TERRIER_ASSERT(count <= common::Constants::K_DEFAULT_VECTOR_SIZE, "Too many elements in vector");
+  data_ = data;
+  count_ = count;
+  is_constant_ = false;
+  sel_vector_ = nullptr;
+  null_mask_.reset();
+  owned_data_.reset();
+}
+
+storage::VarlenEntry Vector::AddString(const std::string_view str) {
+  const auto size = static_cast<uint32_t>(str.size());
+  if (size <= storage::VarlenEntry::InlineThreshold()) {
+    return storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(str.data()), size);
+  }
+  if (string_heap_ == nullptr) {
+    string_heap_ = std::make_unique<util::Region>("vector-strings");
+  }
+  auto *content = static_cast<byte *>(string_heap_->Allocate(size, alignof(char)));
+  std::memcpy(content, str.data(), size);
+  return storage::VarlenEntry::Create(content, size, false);
+}
+
+std::size_t Vector::GetTypeSize(const type::TypeId type) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+      return sizeof(bool);
+    case type::TypeId::TINYINT:
+      return sizeof(int8_t);
+    case type::TypeId::SMALLINT:
+      return sizeof(int16_t);
+    case type::TypeId::INTEGER:
+      return sizeof(int32_t);
+    case type::TypeId::BIGINT:
+      return sizeof(int64_t);
+    case type::TypeId::DECIMAL:
+      return sizeof(double);
+    case type::TypeId::DATE:
+      return sizeof(uint32_t);
+    case type::TypeId::TIMESTAMP:
+      return sizeof(uint64_t);
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY:
+      return sizeof(storage::VarlenEntry);
+    default:
+      throw std::runtime_error("Type " + type::TypeUtil::TypeIdToString(type) + " not supported in vectors");
+  }
+}
+
+}  // namespace terrier::execution::sql
@@ -0,0 +1,107 @@
+#include "execution/sql/vector_expression.h"
+
+#include "execution/sql/vector_operations.h"
+#include "execution/sql/vector_projection.h"
+
+namespace terrier::execution::sql {
+
+std::unique_ptr<VectorExpression> VectorExpression::Column(const uint32_t col_idx, const type::TypeId type) {
+  std::unique_ptr<VectorExpression> expr(new VectorExpression(Kind::Column, type));
+  expr->col_idx_ = col_idx;
+  return expr;
+}
+
+std::unique_ptr<VectorExpression> VectorExpression::IntegerConstant(const int64_t val) {
+  std::unique_ptr<VectorExpression> expr(new VectorExpression(Kind::Constant, type::TypeId::BIGINT));
+  expr->int_val_ = val;
+  return expr;
+}
+
+std::unique_ptr<VectorExpression> VectorExpression::DecimalConstant(const double val) {
+  std::unique_ptr<VectorExpression> expr(new VectorExpression(Kind::Constant, type::TypeId::DECIMAL));
+  expr->decimal_val_ = val;
+  return expr;
+}
+
+std::unique_ptr<VectorExpression> VectorExpression::Operation(
+    const Op op, const type::TypeId type, std::vector<std::unique_ptr<VectorExpression>> &&children) {
+  TERRIER_ASSERT(children.size() == ((op == Op::Not || op == Op::Cast) ? 1 : 2), "Wrong number of operands");
+  std::unique_ptr<VectorExpression> expr(new VectorExpression(Kind::Operation, type));
+  expr->op_ = op;
+  expr->children_ = std::move(children);
+  return expr;
+}
+
+const Vector &VectorExpression::Evaluate(const VectorProjection &input,
+                                         std::vector<std::unique_ptr<Vector>> *temps) const {
+  if (kind_ == Kind::Column) {
+    return *input.GetColumn(col_idx_);
+  }
+
+  auto *result = temps->emplace_back(std::make_unique<Vector>(type_)).get();
+  if (kind_ == Kind::Constant) {
+    if (type_ == type::TypeId::BIGINT) {
+      result->SetConstant(int_val_);
+    } else {
+      result->SetConstant(decimal_val_);
+    }
+    return *result;
+  }
+
+  const Vector &left = children_[0]->Evaluate(input, temps);
+  const Vector *right = children_.size() > 1 ? &children_[1]->Evaluate(input, temps) : nullptr;
+  Apply(left, right, result);
+  return *result;
+}
+
+void VectorExpression::Apply(const Vector &left, const Vector *right, Vector *result) const {
+  switch (op_) {
+    case Op::Add:
+      VectorOps::Add(left, *right, result);
+      break;
+    case Op::Subtract:
+      VectorOps::Subtract(left, *right, result);
+      break;
+    case Op::Multiply:
+      VectorOps::Multiply(left, *right, result);
+      break;
+    case Op::Divide:
+      VectorOps::Divide(left, *right, result);
+      break;
+    case Op::Modulo:
+      VectorOps::Modulo(left, *right, result);
+      break;
+    case Op::Equal:
+      VectorOps::Equal(left, *right, result);
+      break;
+    case Op::NotEqual:
+      VectorOps::NotEqual(left, *right, result);
+      break;
+    case Op::LessThan:
+      VectorOps::LessThan(left, *right, result);
+      break;
+    case Op::LessThanEqual:
+      VectorOps::LessThanEqual(left, *right, result);
+      break;
+    case Op::GreaterThan:
+      VectorOps::GreaterThan(left, *right, result);
+      break;
+    case Op::GreaterThanEqual:
+      VectorOps::GreaterThanEqual(left, *right, result);
+      break;
+    case Op::And:
+      VectorOps::And(left, *right, result);
+      break;
+    case Op::Or:
+      VectorOps::Or(left, *right, result);
+      break;
+    case Op::Not:
+      VectorOps::Not(left, result);
+      break;
+    case Op::Cast:
+      VectorOps::Cast(left, result);
+      break;
+  }
+}
+
+}  // namespace terrier::execution::sql
@@ -0,0 +1,406 @@
+#include "execution/sql/vector_operations.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "execution/sql/like_pattern.h"
+#include "execution/sql/storage_compare.h"
+#include "type/type_util.h"
+
+namespace terrier::execution::sql {
+
+namespace {
+
+// Invoke f(i) on the position i of every active element of a vector with the given selection vector
+// and count
+template <typename F>
+inline void ForEachActive(const uint32_t *sel, const uint32_t count, F &&f) {
+  if (sel == nullptr) {
+    for (uint32_t i = 0; i < count; i++) f(i);
+  } else {
+    for (uint32_t i = 0; i < count; i++) f(sel[i]);
+  }
+}
+
+// Invoke f with a value of the storage type of the given SQL type, which must be numeric (or
+// BOOLEAN, if allowed)
+template <bool WithBoolean, typename F>
+inline void DispatchNumeric(const type::TypeId type, F &&f) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+      if constexpr (WithBoolean) {
+        f(bool{});
+        break;
+      }
+      throw std::runtime_error("Operation not supported on BOOLEAN vectors");
+    case type::TypeId::TINYINT:
+      f(int8_t{});
+      break;
+    case type::TypeId::SMALLINT:
+      f(int16_t{});
+      break;
+    case type::TypeId::INTEGER:
+      f(int32_t{});
+      break;
+    case type::TypeId::BIGINT:
+      f(int64_t{});
+      break;
+    case type::TypeId::DECIMAL:
+      f(double{});
+      break;
+    default:
+      throw std::runtime_error("Operation not supported on " + type::TypeUtil::TypeIdToString(type) + " vectors");
+  }
+}
+
+// Ensure the vector has the given type
+inline void CheckType(const Vector &vector, const type::TypeId expected) {
+  if (vector.GetTypeId() != expected) {
+    throw std::runtime_error("Expected " + type::TypeUtil::TypeIdToString(expected) + " vector, got " +
+                             type::TypeUtil::TypeIdToString(vector.GetTypeId()));
+  }
+}
+
+// Ensure the vector holds strings
+inline void CheckStringType(const Vector &vector) {
+  if (vector.GetTypeId() != type::TypeId::VARCHAR && vector.GetTypeId() != type::TypeId::VARBINARY) {
+    throw std::runtime_error("Expected string vector, got " + type::TypeUtil::TypeIdToString(vector.GetTypeId()));
+  }
+}
+
+// The NULL mask of a vector, with the NULL indication of constant vectors broadcast to all positions
+inline Vector::NullMask BroadcastNulls(const Vector &vector) {
+  if (vector.IsConstant()) {
+    return vector.IsNull(0) ? Vector::NullMask().set() : Vector::NullMask();
+  }
+  return vector.GetNullMask();
+}
+
+// Give the result of a unary kernel the active elements and NULL mask of its input
+inline void PrepareUnary(const Vector &input, Vector *result) {
+  result->SetShape(input);
+  *result->GetMutableNullMask() = input.GetNullMask();
+}
+
+// Ensure the inputs of a binary kernel line up, and give the result their active elements. An
+// element of the result is NULL if either input is.
+inline void PrepareBinary(const Vector &left, const Vector &right, Vector *result) {
+  if (left.GetTypeId() != right.GetTypeId()) {
+    throw std::runtime_error("Mismatched input types " + type::TypeUtil::TypeIdToString(left.GetTypeId()) + " and " +
+                             type::TypeUtil::TypeIdToString(right.GetTypeId()));
+  }
+  TERRIER_ASSERT(left.IsConstant() || right.IsConstant() ||
+                     (left.GetSelectionVector() == right.GetSelectionVector() && left.GetCount() == right.GetCount()),
+                 "Inputs must have the same active elements");
+  result->SetShape(left.IsConstant() ? right : left);
+  *result->GetMutableNullMask() = BroadcastNulls(left) | BroadcastNulls(right);
+}
+
+// Apply op to every active element of the input. If SkipNulls is set, NULL elements are not
+// touched; this is required for types whose garbage values cannot be safely read (i.e., strings).
+template <typename In, typename Out, bool SkipNulls = false, typename Op>
+inline void UnaryLoop(const Vector &input, Vector *result, Op &&op) {
+  const auto *RESTRICT in = input.GetDataAs<In>();
+  auto *RESTRICT out = result->GetDataAs<Out>();
+  const auto &nulls = result->GetNullMask();
+  ForEachActive(result->GetSelectionVector(), result->GetCount(), [&](const uint32_t i) {
+    if constexpr (SkipNulls) {
+      if (nulls[i]) return;
+    }
+    out[i] = op(in[i]);
+  });
+}
+
+// Apply op to every pair of active elements of the inputs, broadcasting constant inputs
+template <typename In, typename Out, bool SkipNulls = false, typename Op>
+inline void BinaryLoop(const Vector &left, const Vector &right, Vector *result, Op &&op) {
+  const auto *RESTRICT l = left.GetDataAs<In>();
+  const auto *RESTRICT r = right.GetDataAs<In>();
+  auto *RESTRICT out = result->GetDataAs<Out>();
+  const auto &nulls = result->GetNullMask();
+  const auto apply = [&](const uint32_t i, const uint32_t l_idx, const uint32_t r_idx) {
+    if constexpr (SkipNulls) {
+      if (nulls[i]) return;
+    }
+    out[i] = op(l[l_idx], r[r_idx]);
+  };
+
+  const uint32_t *sel = result->GetSelectionVector();
+  const uint32_t count = result->GetCount();
+  if (left.IsConstant() && right.IsConstant()) {
+    apply(0, 0, 0);
+  } else if (left.IsConstant()) {
+    ForEachActive(sel, count, [&](const uint32_t i) { apply(i, 0, i); });
+  } else if (right.IsConstant()) {
+    ForEachActive(sel, count, [&](const uint32_t i) { apply(i, i, 0); });
+  } else {
+    ForEachActive(sel, count, [&](const uint32_t i) { apply(i, i, i); });
+  }
+}
+
+// Arithmetic operators. Integer results wrap around on overflow.
+struct AddOp {
+  template <typename T>
+  static T Apply(const T a, const T b) {
+    return static_cast<T>(a + b);
+  }
+};
+
+struct SubtractOp {
+  template <typename T>
+  static T Apply(const T a, const T b) {
+    return static_cast<T>(a - b);
+  }
+};
+
+struct MultiplyOp {
+  template <typename T>
+  static T Apply(const T a, const T b) {
+    return static_cast<T>(a * b);
+  }
+};
+
+// Division and modulo. Division by zero produces a dummy value; the kernel marks the result NULL.
+// Dividing the smallest signed integer by -1 would trap, so negation is done without overflow.
+template <bool IsModulo>
+struct DivisionOp {
+  template <typename T>
+  static T Apply(const T a, const T b) {
+    if (b == T{0}) return T{0};
+    if constexpr (std::is_integral_v<T>) {
+      if (b == T{-1}) {
+        return IsModulo ? T{0} : static_cast<T>(-static_cast<std::make_unsigned_t<T>>(a));
+      }
+      return static_cast<T>(IsModulo ? a % b : a / b);
+    } else {
+      return IsModulo ? std::fmod(a, b) : a / b;
+    }
+  }
+};
+
+template <typename Op>
+void ArithmeticOperation(const Vector &left, const Vector &right, Vector *result) {
+  PrepareBinary(left, right, result);
+  CheckType(*result, left.GetTypeId());
+  DispatchNumeric<false>(left.GetTypeId(), [&](auto tag) {
+    using T = decltype(tag);
+    BinaryLoop<T, T>(left, right, result, [](const T a, const T b) { return Op::template Apply<T>(a, b); });
+  });
+}
+
+template <bool IsModulo>
+void DivisionOperation(const Vector &left, const Vector &right, Vector *result) {
+  ArithmeticOperation<DivisionOp<IsModulo>>(left, right, result);
+
+  // Division by zero yields NULL
+  DispatchNumeric<false>(left.GetTypeId(), [&](auto tag) {
+    using T = decltype(tag);
+    const auto *divisors = right.GetDataAs<T>();
+    auto *nulls = result->GetMutableNullMask();
+    if (right.IsConstant()) {
+      if (divisors[0] == T{0}) nulls->set();
+    } else {
+      ForEachActive(result->GetSelectionVector(), result->GetCount(),
+                    [&](const uint32_t i) { (*nulls)[i] = (*nulls)[i] || divisors[i] == T{0}; });
+    }
+  });
+}
+
+template <template <typename> typename Op>
+void ComparisonOperation(const Vector &left, const Vector &right, Vector *result) {
+  PrepareBinary(left, right, result);
+  CheckType(*result, type::TypeId::BOOLEAN);
+  switch (left.GetTypeId()) {
+    case type::TypeId::DATE: {
+      BinaryLoop<uint32_t, bool>(left, right, result, [](const uint32_t a, const uint32_t b) {
+        return Op<int32_t>()(StorageCompare::DateSortKey(a), StorageCompare::DateSortKey(b));
+      });
+      break;
+    }
+    case type::TypeId::TIMESTAMP: {
+      BinaryLoop<uint64_t, bool>(left, right, result, Op<uint64_t>());
+      break;
+    }
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      BinaryLoop<storage::VarlenEntry, bool, true>(left, right, result,
+                                                   StorageCompare::VarlenCompareWith<Op>);
+      break;
+    }
+    default: {
+      DispatchNumeric<true>(left.GetTypeId(), [&](auto tag) {
+        using T = decltype(tag);
+        BinaryLoop<T, bool>(left, right, result, Op<T>());
+      });
+      break;
+    }
+  }
+}
+
+// Convert every active string of the input with the character conversion function f
+template <typename F>
+void ConvertCase(const Vector &input, Vector *result, F &&f) {
+  CheckStringType(input);
+  CheckType(*result, input.GetTypeId());
+  PrepareUnary(input, result);
+  std::string buffer;
+  UnaryLoop<storage::VarlenEntry, storage::VarlenEntry, true>(input, result, [&](const storage::VarlenEntry &str) {
+    buffer.assign(reinterpret_cast<const char *>(str.Content()), str.Size());
+    for (auto &c : buffer) c = static_cast<char>(f(static_cast<unsigned char>(c)));
+    return result->AddString(buffer);
+  });
+}
+
+}  // namespace
+
+void VectorOps::Add(const Vector &left, const Vector &right, Vector *result) {
+  ArithmeticOperation<AddOp>(left, right, result);
+}
+
+void VectorOps::Subtract(const Vector &left, const Vector &right, Vector *result) {
+  ArithmeticOperation<SubtractOp>(left, right, result);
+}
+
+void VectorOps::Multiply(const Vector &left, const Vector &right, Vector *result) {
+  ArithmeticOperation<MultiplyOp>(left, right, result);
+}
+
+void VectorOps::Divide(const Vector &left, const Vector &right, Vector *result) {
+  DivisionOperation<false>(left, right, result);
+}
+
+void VectorOps::Modulo(const Vector &left, const Vector &right, Vector *result) {
+  DivisionOperation<true>(left, right, result);
+}
+
+void VectorOps::Equal(const Vector &left, const Vector &right, Vector *result) {
+  ComparisonOperation<std::equal_to>(left, right, result);
+}
+
+void VectorOps::NotEqual(const Vector &left, const Vector &right, Vector *result) {
+  ComparisonOperation<std::not_equal_to>(left, right, result);
+}
+
+void VectorOps::LessThan(const Vector &left, const Vector &right, Vector *result) {
+  ComparisonOperation<std::less>(left, right, result);
+}
+
+void VectorOps::LessThanEqual(const Vector &left, const Vector &right, Vector *result) {
+  ComparisonOperation<std::less_equal>(left, right, result);
+}
+
+void VectorOps::GreaterThan(const Vector &left, const Vector &right, Vector *result) {
+  ComparisonOperation<std::greater>(left, right, result);
+}
+
+void VectorOps::GreaterThanEqual(const Vector &left, const Vector &right, Vector *result) {
+  ComparisonOperation<std::greater_equal>(left, right, result);
+}
+
+void VectorOps::And(const Vector &left, const Vector &right, Vector *result) {
+  CheckType(left, type::TypeId::BOOLEAN);
+  PrepareBinary(left, right, result);
+  CheckType(*result, type::TypeId::BOOLEAN);
+  BinaryLoop<bool, bool>(left, right, result, [](const bool a, const bool b) { return a && b; });
+
+  // A NULL operand yields NULL, unless the other operand is FALSE
+  const auto l_false = ~BroadcastNulls(left), r_false = ~BroadcastNulls(right);
+  const auto *l = left.GetDataAs<bool>(), *r = right.GetDataAs<bool>();
+  auto *nulls = result->GetMutableNullMask();
+  ForEachActive(result->GetSelectionVector(), result->GetCount(), [&](const uint32_t i) {
+    const uint32_t l_idx = left.IsConstant() ? 0 : i, r_idx = right.IsConstant() ? 0 : i;
+    if ((l_false[i] && !l[l_idx]) || (r_false[i] && !r[r_idx])) (*nulls)[i] = false;
+  });
+}
+
+void VectorOps::Or(const Vector &left, const Vector &right, Vector *result) {
+  CheckType(left, type::TypeId::BOOLEAN);
+  PrepareBinary(left, right, result);
+  CheckType(*result, type::TypeId::BOOLEAN);
+  BinaryLoop<bool, bool>(left, right, result, [](const bool a, const bool b) { return a || b; });
+
+  // A NULL operand yields NULL, unless the other operand is TRUE
+  const auto l_valid = ~BroadcastNulls(left), r_valid = ~BroadcastNulls(right);
+  const auto *l = left.GetDataAs<bool>(), *r = right.GetDataAs<bool>();
+  auto *nulls = result->GetMutableNullMask();
+  auto *out = result->GetDataAs<bool>();
+  ForEachActive(result->GetSelectionVector(), result->GetCount(), [&](const uint32_t i) {
+    const uint32_t l_idx = left.IsConstant() ? 0 : i, r_idx = right.IsConstant() ? 0 : i;
+    if ((l_valid[i] && l[l_idx]) || (r_valid[i] && r[r_idx])) {
+      (*nulls)[i] = false;
+      out[i] = true;
+    }
+  });
+}
+
+void VectorOps::Not(const Vector &input, Vector *result) {
+  CheckType(input, type::TypeId::BOOLEAN);
+  CheckType(*result, type::TypeId::BOOLEAN);
+  PrepareUnary(input, result);
+  UnaryLoop<bool, bool>(input, result, [](const bool b) { return !b; });
+}
+
+uint32_t VectorOps::SelectTrue(const Vector &input, uint32_t *out_sel) {
+  CheckType(input, type::TypeId::BOOLEAN);
+  TERRIER_ASSERT(!input.IsConstant(), "Cannot select from a constant vector");
+  const auto *data = input.GetDataAs<bool>();
+  const auto &nulls = input.GetNullMask();
+  uint32_t out_pos = 0;
+  ForEachActive(input.GetSelectionVector(), input.GetCount(), [&](const uint32_t i) {
+    out_sel[out_pos] = i;
+    out_pos += static_cast<uint32_t>(!nulls[i] && data[i]);
+  });
+  return out_pos;
+}
+
+void VectorOps::Cast(const Vector &input, Vector *result) {
+  PrepareUnary(input, result);
+
+  if (input.GetTypeId() == result->GetTypeId()) {
+    const std::size_t size = Vector::GetTypeSize(input.GetTypeId());
+    ForEachActive(result->GetSelectionVector(), result->GetCount(), [&](const uint32_t i) {
+      std::memcpy(result->GetData() + i * size, input.GetData() + i * size, size);
+    });
+    return;
+  }
+
+  DispatchNumeric<true>(input.GetTypeId(), [&](auto in_tag) {
+    using In = decltype(in_tag);
+    DispatchNumeric<true>(result->GetTypeId(), [&](auto out_tag) {
+      using Out = decltype(out_tag);
+      UnaryLoop<In, Out>(input, result, [](const In val) {
+        if constexpr (std::is_same_v<Out, bool>) {
+          return val != In{0};
+        } else {
+          return static_cast<Out>(val);
+        }
+      });
+    });
+  });
+}
+
+void VectorOps::Length(const Vector &input, Vector *result) {
+  CheckStringType(input);
+  CheckType(*result, type::TypeId::INTEGER);
+  PrepareUnary(input, result);
+  UnaryLoop<storage::VarlenEntry, int32_t, true>(
+      input, result, [](const storage::VarlenEntry &str) { return static_cast<int32_t>(str.Size()); });
+}
+
+void VectorOps::Lower(const Vector &input, Vector *result) { ConvertCase(input, result, ::tolower); }
+
+void VectorOps::Upper(const Vector &input, Vector *result) { ConvertCase(input, result, ::toupper); }
+
+void VectorOps::Like(const Vector &input, const LikePattern &pattern, Vector *result) {
+  CheckStringType(input);
+  CheckType(*result, type::TypeId::BOOLEAN);
+  PrepareUnary(input, result);
+  UnaryLoop<storage::VarlenEntry, bool, true>(input, result,
+                                              [&](const storage::VarlenEntry &str) { return pattern.Matches(str); });
+}
+
+}  // namespace terrier::execution::sql
@@ -0,0 +1,57 @@
+#include "execution/sql/vector_projection.h"
+
+#include "execution/sql/projected_columns_iterator.h"
+
+namespace terrier::execution::sql {
+
+VectorProjection::VectorProjection(const std::vector<type::TypeId> &col_types) : sel_vector_(nullptr), count_(0) {
+  columns_.reserve(col_types.size());
+  for (const auto type : col_types) {
+    columns_.emplace_back(std::make_unique<Vector>(type, nullptr, 0));
+  }
+}
+
+void VectorProjection::Reference(storage::ProjectedColumns *projected_columns, const uint32_t *sel_vector,
+                                 const uint32_t count) {
+  TERRIER_ASSERT(projected_columns->NumColumns() == columns_.size(), "Mismatched number of columns");
+  for (uint16_t col_idx = 0; col_idx < columns_.size(); col_idx++) {
+    ReferenceColumn(projected_columns, col_idx, col_idx);
+  }
+  SetSelectionVector(sel_vector, count);
+}
+
+void VectorProjection::Reference(const ProjectedColumnsIterator &pci) {
+  Reference(pci.GetProjectedColumn(), pci.GetSelectionVector(), pci.NumSelected());
+}
+
+void VectorProjection::Reference(const ProjectedColumnsIterator &pci, const std::vector<uint16_t> &col_idxs) {
+  TERRIER_ASSERT(col_idxs.size() == columns_.size(), "Mismatched number of columns");
+  for (uint32_t i = 0; i < col_idxs.size(); i++) {
+    ReferenceColumn(pci.GetProjectedColumn(), col_idxs[i], i);
+  }
+  SetSelectionVector(pci.GetSelectionVector(), pci.NumSelected());
+}
+
+void VectorProjection::ReferenceColumn(storage::ProjectedColumns *const projected_columns, const uint16_t col_idx,
+                                       const uint32_t vector_idx) {
+  const uint32_t num_tuples = projected_columns->NumTuples();
+  Vector *column = columns_[vector_idx].get();
+  column->Reference(projected_columns->ColumnStart(col_idx), num_tuples);
+
+  // The storage layer marks valid values with a set bit; vectors mark NULL values
+  const common::RawBitmap *validity = projected_columns->ColumnNullBitmap(col_idx);
+  Vector::NullMask *nulls = column->GetMutableNullMask();
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    (*nulls)[i] = !validity->Test(i);
+  }
+}
+
+void VectorProjection::SetSelectionVector(const uint32_t *sel_vector, const uint32_t count) {
+  sel_vector_ = sel_vector;
+  count_ = count;
+  for (auto &column : columns_) {
+    column->SetSelectionVector(sel_vector, count);
+  }
+}
+
+}  // namespace terrier::execution::sql
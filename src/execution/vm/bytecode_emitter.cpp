@@ -260,6 +260,15 @@ void BytecodeEmitter::EmitTableIterInit(Bytecode bytecode, LocalVar iter, LocalV
   EmitAll(bytecode, iter, exec_ctx, table_oid, col_oids, num_oids);
 }
 
+void BytecodeEmitter::EmitTableIterAddRangeFilter(LocalVar iter, uint32_t col_oid, int64_t min_key,
+                                                  int64_t max_key) {
+  EmitAll(Bytecode::TableVectorIteratorAddRangeFilter, iter, col_oid, min_key, max_key);
+}
+
+void BytecodeEmitter::EmitTableIterSetFilterColumns(LocalVar iter, LocalVar col_oids, uint32_t num_oids) {
+  EmitAll(Bytecode::TableVectorIteratorSetFilterColumns, iter, col_oids, num_oids);
+}
+
 void BytecodeEmitter::EmitAddCol(Bytecode bytecode, LocalVar iter, uint32_t col_oid) {
   EmitAll(bytecode, iter, col_oid);
 }
@@ -278,6 +287,32 @@ void BytecodeEmitter::EmitPCIVectorFilter(Bytecode bytecode, LocalVar selected,
   EmitAll(bytecode, selected, pci, col_idx, type, val);
 }
 
+void BytecodeEmitter::EmitPCILikeFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx,
+                                        uintptr_t pattern) {
+  EmitAll(bytecode, selected, pci, col_idx, pattern);
+}
+
+void BytecodeEmitter::EmitPCIInListFilter(LocalVar selected, LocalVar pci, uint32_t col_idx, uintptr_t in_list) {
+  EmitAll(Bytecode::PCIFilterInList, selected, pci, col_idx, in_list);
+}
+
+void BytecodeEmitter::EmitPCIVectorExprFilter(LocalVar selected, LocalVar exec_ctx, LocalVar pci, uint32_t filter_id) {
+  EmitAll(Bytecode::PCIFilterVector, selected, exec_ctx, pci, filter_id);
+}
+
+void BytecodeEmitter::EmitLikeCompiled(Bytecode bytecode, LocalVar dest, LocalVar str, uintptr_t pattern) {
+  EmitAll(bytecode, dest, str, pattern);
+}
+
+void BytecodeEmitter::EmitAggAdvanceBatch(Bytecode bytecode, LocalVar agg, LocalVar pci, uint32_t col_idx,
+                                          int8_t type) {
+  EmitAll(bytecode, agg, pci, col_idx, type);
+}
+
+void BytecodeEmitter::EmitPCIHashColumn(LocalVar pci, uint32_t col_idx, int8_t type, bool combine) {
+  EmitAll(Bytecode::PCIHashColumn, pci, col_idx, type, static_cast<int8_t>(combine));
+}
+
 void BytecodeEmitter::EmitFilterManagerInsertFlavor(LocalVar fmb, FunctionId func) {
   EmitAll(Bytecode::FilterManagerInsertFlavor, fmb, func);
 }
@@ -287,6 +322,10 @@ void BytecodeEmitter::EmitAggHashTableLookup(LocalVar dest, LocalVar agg_ht, Loc
   EmitAll(Bytecode::AggregationHashTableLookup, dest, agg_ht, hash, key_eq_fn, arg);
 }
 
+void BytecodeEmitter::EmitAggHashTableSetDenseRange(LocalVar agg_ht, int64_t min_key, int64_t max_key) {
+  EmitAll(Bytecode::AggregationHashTableSetDenseRange, agg_ht, min_key, max_key);
+}
+
 void BytecodeEmitter::EmitAggHashTableProcessBatch(LocalVar agg_ht, LocalVar iters, FunctionId hash_fn,
                                                    FunctionId key_eq_fn, FunctionId init_agg_fn,
                                                    FunctionId merge_agg_fn) {
@@ -303,11 +342,21 @@ void BytecodeEmitter::EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, L
   EmitAll(Bytecode::AggregationHashTableParallelPartitionedScan, agg_ht, context, tls, scan_part_fn);
 }
 
+void BytecodeEmitter::EmitAggHashTableNextSpilledPartition(LocalVar has_more, LocalVar agg_ht, LocalVar context,
+                                                           FunctionId merge_part_fn) {
+  EmitAll(Bytecode::AggregationHashTableNextSpilledPartition, has_more, agg_ht, context, merge_part_fn);
+}
+
 void BytecodeEmitter::EmitJoinHashTableIterHasNext(LocalVar has_more, LocalVar iterator, FunctionId key_eq,
                                                    LocalVar opaque_ctx, LocalVar probe_tuple) {
   EmitAll(Bytecode::JoinHashTableIterHasNext, has_more, iterator, key_eq, opaque_ctx, probe_tuple);
 }
 
+void BytecodeEmitter::EmitJoinHashTableFilterProbe(LocalVar num_selected, LocalVar join_hash_table, LocalVar pci,
+                                                   FunctionId hash_fn) {
+  EmitAll(Bytecode::JoinHashTableFilterProbe, num_selected, join_hash_table, pci, hash_fn);
+}
+
 void BytecodeEmitter::EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar region, FunctionId cmp_fn,
                                      LocalVar tuple_size) {
   EmitAll(bytecode, sorter, region, cmp_fn, tuple_size);
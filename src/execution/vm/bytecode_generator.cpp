@@ -1,4 +1,6 @@
+#include <cstring>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -13,6 +15,7 @@
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/control_flow_builders.h"
 #include "loggers/execution_logger.h"
+#include "storage/storage_defs.h"
 
 namespace terrier::execution::vm {
 
@@ -492,6 +495,18 @@ void BytecodeGenerator::VisitSqlConversionCall(ast::CallExpr *call, ast::Builtin
       Emitter()->Emit(Bytecode::InitDate, dest, year, month, day);
       break;
     }
+    case ast::Builtin::InitSqlNull: {
+      auto input = VisitExpressionForRValue(call->Arguments()[0]);
+      Emitter()->Emit(Bytecode::InitSqlNull, input);
+      break;
+    }
+    case ast::Builtin::IsValNull: {
+      auto dest = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Boolean));
+      auto input = VisitExpressionForLValue(call->Arguments()[0]);
+      Emitter()->Emit(Bytecode::ValIsNull, dest, input);
+      ExecutionResult()->SetDestination(dest);
+      break;
+    }
     default: {
       UNREACHABLE("Impossible SQL conversion call");
     }
@@ -536,6 +551,30 @@ void BytecodeGenerator::VisitBuiltinTableIterCall(ast::CallExpr *call, ast::Buil
       Emitter()->Emit(Bytecode::TableVectorIteratorPerformInit, iter);
       break;
     }
+    case ast::Builtin::TableIterAddRangeFilter: {
+      auto col_oid = static_cast<uint32_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+      int64_t min_key = call->Arguments()[2]->As<ast::LitExpr>()->Int64Val();
+      int64_t max_key = call->Arguments()[3]->As<ast::LitExpr>()->Int64Val();
+      Emitter()->EmitTableIterAddRangeFilter(iter, col_oid, min_key, max_key);
+      break;
+    }
+    case ast::Builtin::TableIterSetFilterColumns: {
+      auto *arr_type = call->Arguments()[1]->GetType()->As<ast::ArrayType>();
+      LocalVar col_oids = VisitExpressionForLValue(call->Arguments()[1]);
+      Emitter()->EmitTableIterSetFilterColumns(iter, col_oids, static_cast<uint32_t>(arr_type->Length()));
+      break;
+    }
+    case ast::Builtin::TableIterMaterialize: {
+      Emitter()->Emit(Bytecode::TableVectorIteratorMaterialize, iter);
+      break;
+    }
+    case ast::Builtin::TableIterFetchRow: {
+      LocalVar slot = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar row = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      Emitter()->Emit(Bytecode::TableVectorIteratorFetchRow, row, iter, slot);
+      ExecutionResult()->SetDestination(row.ValueOf());
+      break;
+    }
     case ast::Builtin::TableIterAdvance: {
       LocalVar cond = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
       Emitter()->Emit(Bytecode::TableVectorIteratorNext, cond, iter);
@@ -613,6 +652,18 @@ void BytecodeGenerator::VisitBuiltinPCICall(ast::CallExpr *call, ast::Builtin bu
       Emitter()->Emit(Bytecode::PCIGetSlot, res, pci);
       break;
     }
+    case ast::Builtin::PCIGetHash: {
+      LocalVar res = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      Emitter()->Emit(Bytecode::PCIGetHash, res, pci);
+      break;
+    }
+    case ast::Builtin::PCIHashColumn: {
+      const auto &args = call->Arguments();
+      auto col_idx = static_cast<uint32_t>(args[1]->As<ast::LitExpr>()->Int64Val());
+      auto col_type = static_cast<int8_t>(args[2]->As<ast::LitExpr>()->Int64Val());
+      Emitter()->EmitPCIHashColumn(pci, col_idx, col_type, args[3]->As<ast::LitExpr>()->BoolVal());
+      break;
+    }
     case ast::Builtin::PCIGetBool: {
       LocalVar val = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Boolean));
       auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
@@ -820,8 +871,22 @@ void BytecodeGenerator::VisitBuiltinFilterCall(ast::CallExpr *call, ast::Builtin
   // Column index
   auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
   auto col_type = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
-  // Filter value
-  int64_t val = call->Arguments()[3]->As<ast::LitExpr>()->Int64Val();
+  // Filter value. A string is copied into the execution context's buffer, and passed by the address of its entry.
+  int64_t val;
+  if (call->Arguments()[3]->IsStringLiteral()) {
+    auto input = call->Arguments()[3]->As<ast::LitExpr>()->RawStringVal();
+    auto input_length = static_cast<uint32_t>(input.Length());
+    auto *allocator = exec_ctx_->GetStringAllocator();
+    auto *data = reinterpret_cast<byte *>(allocator->Allocate(input_length));
+    std::memcpy(data, input.Data(), input_length);
+    auto *entry = reinterpret_cast<storage::VarlenEntry *>(allocator->Allocate(sizeof(storage::VarlenEntry)));
+    *entry = input_length <= storage::VarlenEntry::InlineThreshold()
+                 ? storage::VarlenEntry::CreateInline(data, input_length)
+                 : storage::VarlenEntry::Create(data, input_length, false);
+    val = static_cast<int64_t>(reinterpret_cast<intptr_t>(entry));
+  } else {
+    val = call->Arguments()[3]->As<ast::LitExpr>()->Int64Val();
+  }
 
   Bytecode bytecode;
   switch (builtin) {
@@ -856,6 +921,61 @@ void BytecodeGenerator::VisitBuiltinFilterCall(ast::CallExpr *call, ast::Builtin
   Emitter()->EmitPCIVectorFilter(bytecode, ret_val, pci, col_idx, col_type, val);
 }
 
+void BytecodeGenerator::VisitBuiltinFilterLikeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  LocalVar ret_val;
+  if (ExecutionResult() != nullptr) {
+    ret_val = ExecutionResult()->GetOrCreateDestination(call->GetType());
+    ExecutionResult()->SetDestination(ret_val.ValueOf());
+  } else {
+    ret_val = CurrentFunction()->NewLocal(call->GetType());
+  }
+
+  LocalVar pci = VisitExpressionForRValue(call->Arguments()[0]);
+  auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+  const sql::LikePattern *pattern = CompileConstantLikePattern(call->Arguments()[2]);
+  if (pattern == nullptr) {
+    throw std::runtime_error("Malformed LIKE pattern: missing character after the escape character");
+  }
+  const Bytecode bytecode = builtin == ast::Builtin::FilterLike ? Bytecode::PCIFilterLike : Bytecode::PCIFilterNotLike;
+  Emitter()->EmitPCILikeFilter(bytecode, ret_val, pci, col_idx, reinterpret_cast<uintptr_t>(pattern));
+}
+
+void BytecodeGenerator::VisitBuiltinFilterInListCall(ast::CallExpr *call) {
+  LocalVar ret_val;
+  if (ExecutionResult() != nullptr) {
+    ret_val = ExecutionResult()->GetOrCreateDestination(call->GetType());
+    ExecutionResult()->SetDestination(ret_val.ValueOf());
+  } else {
+    ret_val = CurrentFunction()->NewLocal(call->GetType());
+  }
+
+  LocalVar pci = VisitExpressionForRValue(call->Arguments()[0]);
+  auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+  // The list is built once here, rather than from the literals for every vector
+  std::vector<std::string_view> values;
+  for (uint32_t arg_idx = 2; arg_idx < call->NumArgs(); arg_idx++) {
+    const ast::Identifier literal = call->Arguments()[arg_idx]->As<ast::LitExpr>()->RawStringVal();
+    values.emplace_back(literal.Data(), literal.Length());
+  }
+  in_lists_.emplace_back(std::make_unique<sql::StringInList>(values));
+  Emitter()->EmitPCIInListFilter(ret_val, pci, col_idx, reinterpret_cast<uintptr_t>(in_lists_.back().get()));
+}
+
+void BytecodeGenerator::VisitBuiltinFilterVectorCall(ast::CallExpr *call) {
+  LocalVar ret_val;
+  if (ExecutionResult() != nullptr) {
+    ret_val = ExecutionResult()->GetOrCreateDestination(call->GetType());
+    ExecutionResult()->SetDestination(ret_val.ValueOf());
+  } else {
+    ret_val = CurrentFunction()->NewLocal(call->GetType());
+  }
+
+  LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
+  LocalVar pci = VisitExpressionForRValue(call->Arguments()[1]);
+  auto filter_id = static_cast<uint32_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+  Emitter()->EmitPCIVectorExprFilter(ret_val, exec_ctx, pci, filter_id);
+}
+
 void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin) {
   switch (builtin) {
     case ast::Builtin::AggHashTableInit: {
@@ -881,6 +1001,24 @@ void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::B
       Emitter()->EmitAggHashTableLookup(dest, agg_ht, hash, key_eq_fn, arg);
       break;
     }
+    case ast::Builtin::AggHashTableSetDenseRange: {
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      int64_t min_key = call->Arguments()[1]->As<ast::LitExpr>()->Int64Val();
+      int64_t max_key = call->Arguments()[2]->As<ast::LitExpr>()->Int64Val();
+      Emitter()->EmitAggHashTableSetDenseRange(agg_ht, min_key, max_key);
+      break;
+    }
+    case ast::Builtin::AggHashTableInsertDense:
+    case ast::Builtin::AggHashTableLookupDense: {
+      LocalVar dest = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar key = VisitExpressionForLValue(call->Arguments()[1]);
+      const Bytecode bytecode = builtin == ast::Builtin::AggHashTableInsertDense
+                                    ? Bytecode::AggregationHashTableInsertDense
+                                    : Bytecode::AggregationHashTableLookupDense;
+      Emitter()->Emit(bytecode, dest, agg_ht, key);
+      break;
+    }
     case ast::Builtin::AggHashTableProcessBatch: {
       LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
       LocalVar iters = VisitExpressionForRValue(call->Arguments()[1]);
@@ -907,6 +1045,22 @@ void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::B
       Emitter()->EmitAggHashTableParallelPartitionedScan(agg_ht, ctx, tls, scan_part_fn);
       break;
     }
+    case ast::Builtin::AggHashTableNextSpilledPartition: {
+      LocalVar has_more = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar ctx = VisitExpressionForRValue(call->Arguments()[1]);
+      auto merge_part_fn = LookupFuncIdByName(call->Arguments()[2]->As<ast::IdentifierExpr>()->Name().Data());
+      Emitter()->EmitAggHashTableNextSpilledPartition(has_more, agg_ht, ctx, merge_part_fn);
+      ExecutionResult()->SetDestination(has_more.ValueOf());
+      break;
+    }
+    case ast::Builtin::AggHashTableGetSpilledPartition: {
+      LocalVar part_ht = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      Emitter()->Emit(Bytecode::AggregationHashTableGetSpilledPartition, part_ht, agg_ht);
+      ExecutionResult()->SetDestination(part_ht.ValueOf());
+      break;
+    }
     case ast::Builtin::AggHashTableFree: {
       LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
       Emitter()->Emit(Bytecode::AggregationHashTableFree, agg_ht);
@@ -1093,6 +1247,32 @@ Bytecode OpForAgg<AggOpKind::Reset>(const ast::BuiltinType::Kind agg_kind) {
 
 #undef AGG_CODES
 
+// Determine the bytecode advancing the given aggregate by a column of a vector of tuples
+Bytecode BatchAdvanceOpForAgg(const ast::BuiltinType::Kind agg_kind) {
+  switch (agg_kind) {
+    case ast::BuiltinType::CountAggregate:
+      return Bytecode::CountAggregateAdvanceBatch;
+    case ast::BuiltinType::IntegerAvgAggregate:
+    case ast::BuiltinType::RealAvgAggregate:
+      return Bytecode::AvgAggregateAdvanceBatch;
+    case ast::BuiltinType::IntegerMaxAggregate:
+      return Bytecode::IntegerMaxAggregateAdvanceBatch;
+    case ast::BuiltinType::IntegerMinAggregate:
+      return Bytecode::IntegerMinAggregateAdvanceBatch;
+    case ast::BuiltinType::IntegerSumAggregate:
+      return Bytecode::IntegerSumAggregateAdvanceBatch;
+    case ast::BuiltinType::RealMaxAggregate:
+      return Bytecode::RealMaxAggregateAdvanceBatch;
+    case ast::BuiltinType::RealMinAggregate:
+      return Bytecode::RealMinAggregateAdvanceBatch;
+    case ast::BuiltinType::RealSumAggregate:
+      return Bytecode::RealSumAggregateAdvanceBatch;
+    default: {
+      UNREACHABLE("Impossible aggregate type");
+    }
+  }
+}
+
 }  // namespace
 
 void BytecodeGenerator::VisitBuiltinAggregatorCall(ast::CallExpr *call, ast::Builtin builtin) {
@@ -1121,6 +1301,16 @@ void BytecodeGenerator::VisitBuiltinAggregatorCall(ast::CallExpr *call, ast::Bui
       Emitter()->Emit(bytecode, agg, input);
       break;
     }
+    case ast::Builtin::AggAdvanceBatch: {
+      const auto &args = call->Arguments();
+      const auto agg_kind = args[0]->GetType()->GetPointeeType()->As<ast::BuiltinType>()->GetKind();
+      LocalVar agg = VisitExpressionForRValue(args[0]);
+      LocalVar pci = VisitExpressionForRValue(args[1]);
+      auto col_idx = static_cast<uint32_t>(args[2]->As<ast::LitExpr>()->Int64Val());
+      auto col_type = static_cast<int8_t>(args[3]->As<ast::LitExpr>()->Int64Val());
+      Emitter()->EmitAggAdvanceBatch(BatchAdvanceOpForAgg(agg_kind), agg, pci, col_idx, col_type);
+      break;
+    }
     case ast::Builtin::AggMerge: {
       const auto &args = call->Arguments();
       const auto agg_kind = args[0]->GetType()->GetPointeeType()->As<ast::BuiltinType>()->GetKind();
@@ -1202,6 +1392,65 @@ void BytecodeGenerator::VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::
       Emitter()->Emit(Bytecode::JoinHashTableBuildParallel, join_hash_table, tls, jht_offset);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableBloomFilter: {
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
+      Emitter()->Emit(Bytecode::JoinHashTableEnableBloomFilter, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableFilterProbe: {
+      LocalVar num_selected = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar pci = VisitExpressionForRValue(call->Arguments()[1]);
+      const std::string hash_fn_name = call->Arguments()[2]->As<ast::IdentifierExpr>()->Name().Data();
+      Emitter()->EmitJoinHashTableFilterProbe(num_selected, join_hash_table, pci, LookupFuncIdByName(hash_fn_name));
+      ExecutionResult()->SetDestination(num_selected.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableGetTupleCount: {
+      LocalVar tuple_count = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
+      Emitter()->Emit(Bytecode::JoinHashTableGetTupleCount, tuple_count, join_hash_table);
+      ExecutionResult()->SetDestination(tuple_count.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsPartitionSpilled: {
+      LocalVar spilled = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      Emitter()->Emit(Bytecode::JoinHashTableIsPartitionSpilled, spilled, join_hash_table, hash);
+      ExecutionResult()->SetDestination(spilled.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableSpillProbe: {
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar probe_tuple = VisitExpressionForRValue(call->Arguments()[2]);
+      LocalVar probe_tuple_size = VisitExpressionForRValue(call->Arguments()[3]);
+      Emitter()->Emit(Bytecode::JoinHashTableSpillProbeTuple, join_hash_table, hash, probe_tuple, probe_tuple_size);
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextSpilledPartition: {
+      LocalVar loaded = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar include_unprobed = VisitExpressionForRValue(call->Arguments()[1]);
+      Emitter()->Emit(Bytecode::JoinHashTableNextSpilledPartition, loaded, join_hash_table, include_unprobed);
+      ExecutionResult()->SetDestination(loaded.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextSpilledProbe: {
+      LocalVar has_more = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
+      Emitter()->Emit(Bytecode::JoinHashTableNextSpilledProbeTuple, has_more, join_hash_table);
+      ExecutionResult()->SetDestination(has_more.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableGetSpilledProbe: {
+      LocalVar probe_tuple = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
+      Emitter()->Emit(Bytecode::JoinHashTableGetSpilledProbeTuple, probe_tuple, join_hash_table);
+      ExecutionResult()->SetDestination(probe_tuple.ValueOf());
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[0]);
       Emitter()->Emit(Bytecode::JoinHashTableFree, join_hash_table);
@@ -1301,21 +1550,132 @@ void BytecodeGenerator::VisitBuiltinSorterIterCall(ast::CallExpr *call, ast::Bui
   }
 }
 
-void BytecodeGenerator::VisitExecutionContextCall(ast::CallExpr *call, UNUSED_ATTRIBUTE ast::Builtin builtin) {
+void BytecodeGenerator::VisitBuiltinMergeJoinCursorCall(ast::CallExpr *call, ast::Builtin builtin) {
   ast::Context *ctx = call->GetType()->GetContext();
 
-  // The memory pool pointer
-  LocalVar mem_pool =
-      ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::MemoryPool)->PointerTo());
+  // The first argument to all calls is the cursor instance
+  const LocalVar cursor = VisitExpressionForRValue(call->Arguments()[0]);
 
-  // The execution context pointer
-  LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
+  switch (builtin) {
+    case ast::Builtin::MergeJoinCursorInit: {
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[1]);
+      Emitter()->Emit(Bytecode::MergeJoinCursorInit, cursor, sorter);
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorHasNext:
+    case ast::Builtin::MergeJoinCursorRunHasNext: {
+      const Bytecode bytecode = builtin == ast::Builtin::MergeJoinCursorHasNext ? Bytecode::MergeJoinCursorHasNext
+                                                                                : Bytecode::MergeJoinCursorRunHasNext;
+      LocalVar cond = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
+      Emitter()->Emit(bytecode, cond, cursor);
+      ExecutionResult()->SetDestination(cond.ValueOf());
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorGetRow:
+    case ast::Builtin::MergeJoinCursorRunGetRow: {
+      const Bytecode bytecode = builtin == ast::Builtin::MergeJoinCursorGetRow ? Bytecode::MergeJoinCursorGetRow
+                                                                               : Bytecode::MergeJoinCursorRunGetRow;
+      LocalVar row_ptr =
+          ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Uint8)->PointerTo());
+      Emitter()->Emit(bytecode, row_ptr, cursor);
+      ExecutionResult()->SetDestination(row_ptr.ValueOf());
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorNext: {
+      Emitter()->Emit(Bytecode::MergeJoinCursorNext, cursor);
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorAddToRun: {
+      Emitter()->Emit(Bytecode::MergeJoinCursorAddToRun, cursor);
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorClearRun: {
+      Emitter()->Emit(Bytecode::MergeJoinCursorClearRun, cursor);
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorRunInit: {
+      Emitter()->Emit(Bytecode::MergeJoinCursorRunInit, cursor);
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorRunNext: {
+      Emitter()->Emit(Bytecode::MergeJoinCursorRunNext, cursor);
+      break;
+    }
+    case ast::Builtin::MergeJoinCursorFree: {
+      Emitter()->Emit(Bytecode::MergeJoinCursorFree, cursor);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible merge join cursor call");
+    }
+  }
+}
+
+void BytecodeGenerator::VisitBuiltinJoinHashTableEntryIterCall(ast::CallExpr *call, ast::Builtin builtin) {
+  ast::Context *ctx = call->GetType()->GetContext();
+
+  // The first argument to all calls is the entry iterator instance
+  const LocalVar entry_iter = VisitExpressionForRValue(call->Arguments()[0]);
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableEntryIterInit: {
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[1]);
+      Emitter()->Emit(Bytecode::JoinHashTableEntryIteratorInit, entry_iter, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableEntryIterHasNext: {
+      LocalVar cond = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
+      Emitter()->Emit(Bytecode::JoinHashTableEntryIteratorHasNext, cond, entry_iter);
+      ExecutionResult()->SetDestination(cond.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableEntryIterNext: {
+      Emitter()->Emit(Bytecode::JoinHashTableEntryIteratorNext, entry_iter);
+      break;
+    }
+    case ast::Builtin::JoinHashTableEntryIterGetRow: {
+      LocalVar row_ptr =
+          ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Uint8)->PointerTo());
+      Emitter()->Emit(Bytecode::JoinHashTableEntryIteratorGetRow, row_ptr, entry_iter);
+      ExecutionResult()->SetDestination(row_ptr.ValueOf());
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table entry iteration call");
+    }
+  }
+}
+
+void BytecodeGenerator::VisitExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin) {
+  ast::Context *ctx = call->GetType()->GetContext();
+
+  switch (builtin) {
+    case ast::Builtin::ExecutionContextGetMemoryPool: {
+      // The memory pool pointer
+      LocalVar mem_pool = ExecutionResult()->GetOrCreateDestination(
+          ast::BuiltinType::Get(ctx, ast::BuiltinType::MemoryPool)->PointerTo());
 
-  // Emit bytecode
-  Emitter()->Emit(Bytecode::ExecutionContextGetMemoryPool, mem_pool, exec_ctx);
+      // The execution context pointer
+      LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
 
-  // Indicate where the result is
-  ExecutionResult()->SetDestination(mem_pool.ValueOf());
+      // Emit bytecode
+      Emitter()->Emit(Bytecode::ExecutionContextGetMemoryPool, mem_pool, exec_ctx);
+
+      // Indicate where the result is
+      ExecutionResult()->SetDestination(mem_pool.ValueOf());
+      break;
+    }
+    case ast::Builtin::ExecutionContextReportRows: {
+      LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar probe_id = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar num_rows = VisitExpressionForRValue(call->Arguments()[2]);
+      Emitter()->Emit(Bytecode::ExecutionContextReportRows, exec_ctx, probe_id, num_rows);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible execution context call");
+    }
+  }
 }
 
 void BytecodeGenerator::VisitBuiltinThreadStateContainerCall(ast::CallExpr *call, ast::Builtin builtin) {
@@ -1395,6 +1755,45 @@ void BytecodeGenerator::VisitBuiltinTrigCall(ast::CallExpr *call, ast::Builtin b
   ExecutionResult()->SetDestination(dest.ValueOf());
 }
 
+void BytecodeGenerator::VisitBuiltinLikeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  ast::Context *ctx = call->GetType()->GetContext();
+  LocalVar dest = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Boolean));
+  LocalVar str = VisitExpressionForLValue(call->Arguments()[0]);
+  // A constant pattern is compiled once here, rather than parsed again for every string
+  if (const sql::LikePattern *compiled = CompileConstantLikePattern(call->Arguments()[1]); compiled != nullptr) {
+    Emitter()->EmitLikeCompiled(builtin == ast::Builtin::Like ? Bytecode::LikeCompiled : Bytecode::NotLikeCompiled,
+                                dest, str, reinterpret_cast<uintptr_t>(compiled));
+  } else {
+    LocalVar pattern = VisitExpressionForLValue(call->Arguments()[1]);
+    Emitter()->Emit(builtin == ast::Builtin::Like ? Bytecode::Like : Bytecode::NotLike, dest, str, pattern);
+  }
+  ExecutionResult()->SetDestination(dest.ValueOf());
+}
+
+const sql::LikePattern *BytecodeGenerator::CompileConstantLikePattern(ast::Expr *pattern) {
+  if (auto *call = pattern->SafeAs<ast::CallExpr>(); call != nullptr) {
+    ast::Builtin builtin;
+    if (call->GetCallKind() != ast::CallExpr::CallKind::Builtin ||
+        !call->GetType()->GetContext()->IsBuiltinFunction(call->GetFuncName(), &builtin) ||
+        builtin != ast::Builtin::StringToSql) {
+      return nullptr;
+    }
+    pattern = call->Arguments()[0];
+  }
+  if (!pattern->IsStringLiteral()) {
+    return nullptr;
+  }
+
+  const ast::Identifier literal = pattern->As<ast::LitExpr>()->RawStringVal();
+  try {
+    like_patterns_.emplace_back(std::make_unique<sql::LikePattern>(std::string_view(literal.Data(), literal.Length())));
+  } catch (const std::runtime_error &) {
+    // Leave malformed patterns to the uncompiled matcher, which reports them if a string is ever matched
+    return nullptr;
+  }
+  return like_patterns_.back().get();
+}
+
 void BytecodeGenerator::VisitBuiltinSizeOfCall(ast::CallExpr *call) {
   ast::Type *target_type = call->Arguments()[0]->GetType();
   LocalVar size_var = ExecutionResult()->GetOrCreateDestination(
@@ -1463,6 +1862,10 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       Emitter()->Emit(Bytecode::IndexIteratorPerformInit, iterator);
       break;
     }
+    case ast::Builtin::IndexIteratorSetIndexOnly: {
+      Emitter()->Emit(Bytecode::IndexIteratorSetIndexOnly, iterator);
+      break;
+    }
     case ast::Builtin::IndexIteratorScanKey: {
       Emitter()->Emit(Bytecode::IndexIteratorScanKey, iterator);
       break;
@@ -1485,6 +1888,14 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       Emitter()->Emit(Bytecode::IndexIteratorScanLimitDescending, iterator, limit);
       break;
     }
+    case ast::Builtin::IndexIteratorAddRange: {
+      Emitter()->Emit(Bytecode::IndexIteratorAddRange, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorScanRanges: {
+      Emitter()->Emit(Bytecode::IndexIteratorScanRanges, iterator);
+      break;
+    }
     case ast::Builtin::IndexIteratorAdvance: {
       LocalVar cond = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
       Emitter()->Emit(Bytecode::IndexIteratorAdvance, cond, iterator);
@@ -1515,6 +1926,11 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       Emitter()->Emit(Bytecode::IndexIteratorGetTablePR, pr, iterator);
       break;
     }
+    case ast::Builtin::IndexIteratorGetKeyPR: {
+      LocalVar pr = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      Emitter()->Emit(Bytecode::IndexIteratorGetKeyPR, pr, iterator);
+      break;
+    }
     case ast::Builtin::IndexIteratorGetSlot: {
       LocalVar pr = ExecutionResult()->GetOrCreateDestination(call->GetType());
       Emitter()->Emit(Bytecode::IndexIteratorGetSlot, pr, iterator);
@@ -1899,7 +2315,9 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::DateToSql:
     case ast::Builtin::VarlenToSql:
     case ast::Builtin::StringToSql:
-    case ast::Builtin::SqlToBool: {
+    case ast::Builtin::SqlToBool:
+    case ast::Builtin::InitSqlNull:
+    case ast::Builtin::IsValNull: {
       VisitSqlConversionCall(call, builtin);
       break;
     }
@@ -1912,7 +2330,21 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinFilterCall(call, builtin);
       break;
     }
-    case ast::Builtin::ExecutionContextGetMemoryPool: {
+    case ast::Builtin::FilterLike:
+    case ast::Builtin::FilterNotLike: {
+      VisitBuiltinFilterLikeCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::FilterInList: {
+      VisitBuiltinFilterInListCall(call);
+      break;
+    }
+    case ast::Builtin::FilterVector: {
+      VisitBuiltinFilterVectorCall(call);
+      break;
+    }
+    case ast::Builtin::ExecutionContextGetMemoryPool:
+    case ast::Builtin::ExecutionContextReportRows: {
       VisitExecutionContextCall(call, builtin);
       break;
     }
@@ -1925,6 +2357,10 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     }
     case ast::Builtin::TableIterInit:
     case ast::Builtin::TableIterInitBind:
+    case ast::Builtin::TableIterAddRangeFilter:
+    case ast::Builtin::TableIterSetFilterColumns:
+    case ast::Builtin::TableIterMaterialize:
+    case ast::Builtin::TableIterFetchRow:
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterReset:
     case ast::Builtin::TableIterGetPCI:
@@ -1945,6 +2381,8 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::PCIReset:
     case ast::Builtin::PCIResetFiltered:
     case ast::Builtin::PCIGetSlot:
+    case ast::Builtin::PCIGetHash:
+    case ast::Builtin::PCIHashColumn:
     case ast::Builtin::PCIGetBool:
     case ast::Builtin::PCIGetBoolNull:
     case ast::Builtin::PCIGetTinyInt:
@@ -1981,9 +2419,14 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::AggHashTableInit:
     case ast::Builtin::AggHashTableInsert:
     case ast::Builtin::AggHashTableLookup:
+    case ast::Builtin::AggHashTableSetDenseRange:
+    case ast::Builtin::AggHashTableInsertDense:
+    case ast::Builtin::AggHashTableLookupDense:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
+    case ast::Builtin::AggHashTableNextSpilledPartition:
+    case ast::Builtin::AggHashTableGetSpilledPartition:
     case ast::Builtin::AggHashTableFree: {
       VisitBuiltinAggHashTableCall(call, builtin);
       break;
@@ -2005,6 +2448,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     }
     case ast::Builtin::AggInit:
     case ast::Builtin::AggAdvance:
+    case ast::Builtin::AggAdvanceBatch:
     case ast::Builtin::AggMerge:
     case ast::Builtin::AggReset:
     case ast::Builtin::AggResult: {
@@ -2019,10 +2463,25 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::JoinHashTableIterClose:
     case ast::Builtin::JoinHashTableBuild:
     case ast::Builtin::JoinHashTableBuildParallel:
+    case ast::Builtin::JoinHashTableEnableBloomFilter:
+    case ast::Builtin::JoinHashTableFilterProbe:
+    case ast::Builtin::JoinHashTableGetTupleCount:
+    case ast::Builtin::JoinHashTableIsPartitionSpilled:
+    case ast::Builtin::JoinHashTableSpillProbe:
+    case ast::Builtin::JoinHashTableNextSpilledPartition:
+    case ast::Builtin::JoinHashTableNextSpilledProbe:
+    case ast::Builtin::JoinHashTableGetSpilledProbe:
     case ast::Builtin::JoinHashTableFree: {
       VisitBuiltinJoinHashTableCall(call, builtin);
       break;
     }
+    case ast::Builtin::JoinHashTableEntryIterInit:
+    case ast::Builtin::JoinHashTableEntryIterHasNext:
+    case ast::Builtin::JoinHashTableEntryIterNext:
+    case ast::Builtin::JoinHashTableEntryIterGetRow: {
+      VisitBuiltinJoinHashTableEntryIterCall(call, builtin);
+      break;
+    }
     case ast::Builtin::SorterInit:
     case ast::Builtin::SorterInsert:
     case ast::Builtin::SorterSort:
@@ -2040,6 +2499,20 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinSorterIterCall(call, builtin);
       break;
     }
+    case ast::Builtin::MergeJoinCursorInit:
+    case ast::Builtin::MergeJoinCursorHasNext:
+    case ast::Builtin::MergeJoinCursorNext:
+    case ast::Builtin::MergeJoinCursorGetRow:
+    case ast::Builtin::MergeJoinCursorAddToRun:
+    case ast::Builtin::MergeJoinCursorClearRun:
+    case ast::Builtin::MergeJoinCursorRunInit:
+    case ast::Builtin::MergeJoinCursorRunHasNext:
+    case ast::Builtin::MergeJoinCursorRunNext:
+    case ast::Builtin::MergeJoinCursorRunGetRow:
+    case ast::Builtin::MergeJoinCursorFree: {
+      VisitBuiltinMergeJoinCursorCall(call, builtin);
+      break;
+    }
     case ast::Builtin::ACos:
     case ast::Builtin::ASin:
     case ast::Builtin::ATan:
@@ -2051,6 +2524,11 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinTrigCall(call, builtin);
       break;
     }
+    case ast::Builtin::Like:
+    case ast::Builtin::NotLike: {
+      VisitBuiltinLikeCall(call, builtin);
+      break;
+    }
     case ast::Builtin::SizeOf: {
       VisitBuiltinSizeOfCall(call);
       break;
@@ -2065,17 +2543,21 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       break;
     case ast::Builtin::IndexIteratorInit:
     case ast::Builtin::IndexIteratorInitBind:
+    case ast::Builtin::IndexIteratorSetIndexOnly:
     case ast::Builtin::IndexIteratorScanKey:
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitAscending:
     case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorAddRange:
+    case ast::Builtin::IndexIteratorScanRanges:
     case ast::Builtin::IndexIteratorAdvance:
     case ast::Builtin::IndexIteratorFree:
     case ast::Builtin::IndexIteratorGetPR:
     case ast::Builtin::IndexIteratorGetLoPR:
     case ast::Builtin::IndexIteratorGetHiPR:
     case ast::Builtin::IndexIteratorGetTablePR:
+    case ast::Builtin::IndexIteratorGetKeyPR:
     case ast::Builtin::IndexIteratorGetSlot:
       VisitBuiltinIndexIteratorCall(call, builtin);
       break;
@@ -2777,7 +3259,8 @@ std::unique_ptr<BytecodeModule> BytecodeGenerator::Compile(ast::AstNode *root, e
 
   // Create the bytecode module. Note that we move the bytecode and functions
   // array from the generator into the module.
-  return std::make_unique<BytecodeModule>(name, std::move(generator.bytecode_), std::move(generator.functions_));
+  return std::make_unique<BytecodeModule>(name, std::move(generator.bytecode_), std::move(generator.functions_),
+                                          std::move(generator.like_patterns_), std::move(generator.in_lists_));
 }
 
 }  // namespace terrier::execution::vm
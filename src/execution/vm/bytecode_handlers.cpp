@@ -84,6 +84,28 @@ void OpPCIFilterNotEqual(uint64_t *size, terrier::execution::sql::ProjectedColum
   *size = iter->FilterColByVal<std::not_equal_to>(col_idx, sql_type, v);
 }
 
+void OpPCIFilterLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                     uintptr_t pattern) {
+  *size = iter->FilterColByLike(col_idx, *reinterpret_cast<const terrier::execution::sql::LikePattern *>(pattern));
+}
+
+void OpPCIFilterNotLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                        uintptr_t pattern) {
+  *size =
+      iter->FilterColByLike(col_idx, *reinterpret_cast<const terrier::execution::sql::LikePattern *>(pattern), true);
+}
+
+void OpPCIFilterInList(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                       uintptr_t in_list) {
+  const auto *list = reinterpret_cast<const terrier::execution::sql::StringInList *>(in_list);
+  *size = iter->FilterColByInList(col_idx, list->GetValues(), list->GetNumValues());
+}
+
+void OpPCIFilterVector(uint64_t *size, terrier::execution::exec::ExecutionContext *exec_ctx,
+                       terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t filter_id) {
+  *size = iter->FilterByVectorFilter(exec_ctx->GetVectorFilter(filter_id));
+}
+
 // ---------------------------------------------------------
 // Filter Manager
 // ---------------------------------------------------------
@@ -119,6 +141,17 @@ void OpJoinHashTableInit(terrier::execution::sql::JoinHashTable *join_hash_table
   new (join_hash_table) terrier::execution::sql::JoinHashTable(memory, tuple_size);
 }
 
+void OpJoinHashTableSpillProbeTuple(terrier::execution::sql::JoinHashTable *join_hash_table,
+                                    const terrier::hash_t hash, const terrier::byte *probe_tuple,
+                                    const uint32_t probe_tuple_size) {
+  join_hash_table->SpillProbeTuple(hash, probe_tuple, probe_tuple_size);
+}
+
+void OpJoinHashTableNextSpilledPartition(bool *result, terrier::execution::sql::JoinHashTable *join_hash_table,
+                                         const bool include_unprobed) {
+  *result = join_hash_table->NextSpilledPartition(include_unprobed);
+}
+
 void OpJoinHashTableBuild(terrier::execution::sql::JoinHashTable *join_hash_table) { join_hash_table->Build(); }
 
 void OpJoinHashTableBuildParallel(terrier::execution::sql::JoinHashTable *join_hash_table,
@@ -127,6 +160,10 @@ void OpJoinHashTableBuildParallel(terrier::execution::sql::JoinHashTable *join_h
   join_hash_table->MergeParallel(thread_state_container, jht_offset);
 }
 
+void OpJoinHashTableEnableBloomFilter(terrier::execution::sql::JoinHashTable *join_hash_table) {
+  join_hash_table->EnableBloomFilter();
+}
+
 void OpJoinHashTableFree(terrier::execution::sql::JoinHashTable *join_hash_table) { join_hash_table->~JoinHashTable(); }
 
 // ---------------------------------------------------------
@@ -138,6 +175,13 @@ void OpAggregationHashTableInit(terrier::execution::sql::AggregationHashTable *c
   new (agg_hash_table) terrier::execution::sql::AggregationHashTable(memory, payload_size);
 }
 
+void OpAggregationHashTableNextSpilledPartition(
+    bool *const has_more, terrier::execution::sql::AggregationHashTable *const agg_hash_table,
+    void *const query_state,
+    const terrier::execution::sql::AggregationHashTable::MergePartitionFn merge_partition_fn) {
+  *has_more = agg_hash_table->NextSpilledPartition(query_state, merge_partition_fn);
+}
+
 void OpAggregationHashTableFree(terrier::execution::sql::AggregationHashTable *const agg_hash_table) {
   agg_hash_table->~AggregationHashTable();
 }
@@ -183,6 +227,12 @@ void OpSorterIteratorInit(terrier::execution::sql::SorterIterator *iter, terrier
 
 void OpSorterIteratorFree(terrier::execution::sql::SorterIterator *iter) { iter->~SorterIterator(); }
 
+void OpMergeJoinCursorInit(terrier::execution::sql::MergeJoinCursor *cursor, terrier::execution::sql::Sorter *sorter) {
+  new (cursor) terrier::execution::sql::MergeJoinCursor(sorter);
+}
+
+void OpMergeJoinCursorFree(terrier::execution::sql::MergeJoinCursor *cursor) { cursor->~MergeJoinCursor(); }
+
 // -------------------------------------------------------------
 // StorageInterface Calls
 // -------------------------------------------------------------
@@ -11,8 +11,14 @@
 
 namespace terrier::execution::vm {
 
-BytecodeModule::BytecodeModule(std::string name, std::vector<uint8_t> &&code, std::vector<FunctionInfo> &&functions)
-    : name_(std::move(name)), code_(std::move(code)), functions_(std::move(functions)) {}
+BytecodeModule::BytecodeModule(std::string name, std::vector<uint8_t> &&code, std::vector<FunctionInfo> &&functions,
+                               std::vector<std::unique_ptr<sql::LikePattern>> &&like_patterns,
+                               std::vector<std::unique_ptr<sql::StringInList>> &&in_lists)
+    : name_(std::move(name)),
+      code_(std::move(code)),
+      functions_(std::move(functions)),
+      like_patterns_(std::move(like_patterns)),
+      in_lists_(std::move(in_lists)) {}
 
 namespace {
 
@@ -469,6 +469,14 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(ExecutionContextReportRows) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto probe_id = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto num_rows = frame->LocalAt<uint64_t>(READ_LOCAL_ID());
+    OpExecutionContextReportRows(exec_ctx, probe_id, num_rows);
+    DISPATCH_NEXT();
+  }
+
   OP(ThreadStateContainerInit) : {
     auto *thread_state_container = frame->LocalAt<sql::ThreadStateContainer *>(READ_LOCAL_ID());
     auto *memory = frame->LocalAt<execution::sql::MemoryPool *>(READ_LOCAL_ID());
@@ -527,6 +535,37 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(TableVectorIteratorAddRangeFilter) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto col_oid = READ_UIMM4();
+    auto min_key = READ_IMM8();
+    auto max_key = READ_IMM8();
+    OpTableVectorIteratorAddRangeFilter(iter, col_oid, min_key, max_key);
+    DISPATCH_NEXT();
+  }
+
+  OP(TableVectorIteratorSetFilterColumns) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto col_oids = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
+    auto num_oids = READ_UIMM4();
+    OpTableVectorIteratorSetFilterColumns(iter, col_oids, num_oids);
+    DISPATCH_NEXT();
+  }
+
+  OP(TableVectorIteratorMaterialize) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    OpTableVectorIteratorMaterialize(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(TableVectorIteratorFetchRow) : {
+    auto *row = frame->LocalAt<storage::ProjectedRow **>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto *slot = frame->LocalAt<storage::TupleSlot *>(READ_LOCAL_ID());
+    OpTableVectorIteratorFetchRow(row, iter, slot);
+    DISPATCH_NEXT();
+  }
+
   OP(TableVectorIteratorNext) : {
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
@@ -628,6 +667,22 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(PCIGetHash) : {
+    auto *hash_val = frame->LocalAt<hash_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    OpPCIGetHash(hash_val, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(PCIHashColumn) : {
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM4();
+    auto type = READ_IMM1();
+    auto combine = READ_IMM1();
+    OpPCIHashColumn(iter, col_idx, type, combine);
+    DISPATCH_NEXT();
+  }
+
   // -------------------------------------------------------
   // PCI element access
   // -------------------------------------------------------
@@ -677,6 +732,42 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
   GEN_PCI_FILTER(NotEqual)
 #undef GEN_PCI_FILTER
 
+  OP(PCIFilterLike) : {
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM4();
+    auto pattern = static_cast<uintptr_t>(READ_IMM8());
+    OpPCIFilterLike(size, iter, col_idx, pattern);
+    DISPATCH_NEXT();
+  }
+
+  OP(PCIFilterNotLike) : {
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM4();
+    auto pattern = static_cast<uintptr_t>(READ_IMM8());
+    OpPCIFilterNotLike(size, iter, col_idx, pattern);
+    DISPATCH_NEXT();
+  }
+
+  OP(PCIFilterInList) : {
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM4();
+    auto in_list = static_cast<uintptr_t>(READ_IMM8());
+    OpPCIFilterInList(size, iter, col_idx, in_list);
+    DISPATCH_NEXT();
+  }
+
+  OP(PCIFilterVector) : {
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    auto filter_id = READ_UIMM4();
+    OpPCIFilterVector(size, exec_ctx, iter, filter_id);
+    DISPATCH_NEXT();
+  }
+
   // ------------------------------------------------------
   // Hashing
   // ------------------------------------------------------
@@ -808,6 +899,12 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(InitSqlNull) : {
+    auto *sql_val = frame->LocalAt<sql::Val *>(READ_LOCAL_ID());
+    OpInitSqlNull(sql_val);
+    DISPATCH_NEXT();
+  }
+
 #define GEN_CMP(op)                                                  \
   OP(op##BoolVal) : {                                                \
     auto *result = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());  \
@@ -928,6 +1025,30 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(AggregationHashTableSetDenseRange) : {
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto min_key = READ_IMM8();
+    auto max_key = READ_IMM8();
+    OpAggregationHashTableSetDenseRange(agg_hash_table, min_key, max_key);
+    DISPATCH_NEXT();
+  }
+
+  OP(AggregationHashTableInsertDense) : {
+    auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto *key = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID());
+    OpAggregationHashTableInsertDense(result, agg_hash_table, key);
+    DISPATCH_NEXT();
+  }
+
+  OP(AggregationHashTableLookupDense) : {
+    auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto *key = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID());
+    OpAggregationHashTableLookupDense(result, agg_hash_table, key);
+    DISPATCH_NEXT();
+  }
+
   OP(AggregationHashTableLookup) : {
     auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
     auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
@@ -983,6 +1104,25 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(AggregationHashTableNextSpilledPartition) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto merge_partition_fn_id = READ_FUNC_ID();
+
+    auto merge_partition_fn = reinterpret_cast<sql::AggregationHashTable::MergePartitionFn>(
+        module_->GetRawFunctionImpl(merge_partition_fn_id));
+    OpAggregationHashTableNextSpilledPartition(has_more, agg_hash_table, query_state, merge_partition_fn);
+    DISPATCH_NEXT();
+  }
+
+  OP(AggregationHashTableGetSpilledPartition) : {
+    auto *result = frame->LocalAt<sql::AggregationHashTable **>(READ_LOCAL_ID());
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    OpAggregationHashTableGetSpilledPartition(result, agg_hash_table);
+    DISPATCH_NEXT();
+  }
+
   OP(AggregationHashTableFree) : {
     auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
     OpAggregationHashTableFree(agg_hash_table);
@@ -1217,6 +1357,25 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+#define GEN_AGG_ADVANCE_BATCH(AGG)                                                 \
+  OP(AGG##AdvanceBatch) : {                                                        \
+    auto *agg = frame->LocalAt<sql::AGG *>(READ_LOCAL_ID());                       \
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID()); \
+    auto col_idx = READ_UIMM4();                                                   \
+    auto type = READ_IMM1();                                                       \
+    Op##AGG##AdvanceBatch(agg, iter, col_idx, type);                               \
+    DISPATCH_NEXT();                                                               \
+  }
+  GEN_AGG_ADVANCE_BATCH(CountAggregate)
+  GEN_AGG_ADVANCE_BATCH(IntegerSumAggregate)
+  GEN_AGG_ADVANCE_BATCH(IntegerMaxAggregate)
+  GEN_AGG_ADVANCE_BATCH(IntegerMinAggregate)
+  GEN_AGG_ADVANCE_BATCH(RealSumAggregate)
+  GEN_AGG_ADVANCE_BATCH(RealMaxAggregate)
+  GEN_AGG_ADVANCE_BATCH(RealMinAggregate)
+  GEN_AGG_ADVANCE_BATCH(AvgAggregate)
+#undef GEN_AGG_ADVANCE_BATCH
+
   // -------------------------------------------------------
   // Hash Joins
   // -------------------------------------------------------
@@ -1269,6 +1428,33 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableEntryIteratorInit) : {
+    auto *iterator = frame->LocalAt<sql::JoinHashTableEntryIterator *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableEntryIteratorInit(iterator, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableEntryIteratorHasNext) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *iterator = frame->LocalAt<sql::JoinHashTableEntryIterator *>(READ_LOCAL_ID());
+    OpJoinHashTableEntryIteratorHasNext(has_more, iterator);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableEntryIteratorNext) : {
+    auto *iterator = frame->LocalAt<sql::JoinHashTableEntryIterator *>(READ_LOCAL_ID());
+    OpJoinHashTableEntryIteratorNext(iterator);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableEntryIteratorGetRow) : {
+    auto **row = frame->LocalAt<byte **>(READ_LOCAL_ID());
+    auto *iterator = frame->LocalAt<sql::JoinHashTableEntryIterator *>(READ_LOCAL_ID());
+    OpJoinHashTableEntryIteratorGetRow(row, iterator);
+    DISPATCH_NEXT();
+  }
+
   OP(JoinHashTableBuild) : {
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
     OpJoinHashTableBuild(join_hash_table);
@@ -1283,6 +1469,68 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableEnableBloomFilter) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableEnableBloomFilter(join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableFilterProbe) : {
+    auto *num_selected = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto *pci = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    auto hash_fn_id = READ_FUNC_ID();
+    auto hash_fn = reinterpret_cast<sql::JoinHashTable::ProbeHashFn>(module_->GetRawFunctionImpl(hash_fn_id));
+    OpJoinHashTableFilterProbe(num_selected, join_hash_table, pci, hash_fn);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableGetTupleCount) : {
+    auto *result = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableGetTupleCount(result, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableIsPartitionSpilled) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    OpJoinHashTableIsPartitionSpilled(result, join_hash_table, hash);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableSpillProbeTuple) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    auto *probe_tuple = frame->LocalAt<const byte *>(READ_LOCAL_ID());
+    auto probe_tuple_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpJoinHashTableSpillProbeTuple(join_hash_table, hash, probe_tuple, probe_tuple_size);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableNextSpilledPartition) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto include_unprobed = frame->LocalAt<bool>(READ_LOCAL_ID());
+    OpJoinHashTableNextSpilledPartition(result, join_hash_table, include_unprobed);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableNextSpilledProbeTuple) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableNextSpilledProbeTuple(has_more, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableGetSpilledProbeTuple) : {
+    auto *result = frame->LocalAt<const byte **>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableGetSpilledProbeTuple(result, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
   OP(JoinHashTableFree) : {
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
     OpJoinHashTableFree(join_hash_table);
@@ -1388,6 +1636,77 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(MergeJoinCursorInit) : {
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    OpMergeJoinCursorInit(cursor, sorter);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorHasNext) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorHasNext(has_more, cursor);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorNext) : {
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorNext(cursor);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorGetRow) : {
+    const auto **row = frame->LocalAt<const byte **>(READ_LOCAL_ID());
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorGetRow(row, cursor);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorAddToRun) : {
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorAddToRun(cursor);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorClearRun) : {
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorClearRun(cursor);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorRunInit) : {
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorRunInit(cursor);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorRunHasNext) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorRunHasNext(has_more, cursor);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorRunNext) : {
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorRunNext(cursor);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorRunGetRow) : {
+    const auto **row = frame->LocalAt<const byte **>(READ_LOCAL_ID());
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorRunGetRow(row, cursor);
+    DISPATCH_NEXT();
+  }
+
+  OP(MergeJoinCursorFree) : {
+    auto *cursor = frame->LocalAt<sql::MergeJoinCursor *>(READ_LOCAL_ID());
+    OpMergeJoinCursorFree(cursor);
+    DISPATCH_NEXT();
+  }
+
   // -------------------------------------------------------
   // Output Calls
   // -------------------------------------------------------
@@ -1424,6 +1743,12 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorSetIndexOnly) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorSetIndexOnly(iter);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorScanKey) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorScanKey(iter);
@@ -1456,6 +1781,18 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorAddRange) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorAddRange(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorScanRanges) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorScanRanges(iter);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorFree) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorFree(iter);
@@ -1497,6 +1834,13 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorGetKeyPR) : {
+    auto *pr = frame->LocalAt<storage::ProjectedRow **>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorGetKeyPR(pr, iter);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorGetSlot) : {
     auto *slot = frame->LocalAt<storage::TupleSlot *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
@@ -1765,6 +2109,38 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(Like) : {
+    auto *result = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
+    auto *str = frame->LocalAt<const sql::StringVal *>(READ_LOCAL_ID());
+    auto *pattern = frame->LocalAt<const sql::StringVal *>(READ_LOCAL_ID());
+    OpLike(result, str, pattern);
+    DISPATCH_NEXT();
+  }
+
+  OP(NotLike) : {
+    auto *result = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
+    auto *str = frame->LocalAt<const sql::StringVal *>(READ_LOCAL_ID());
+    auto *pattern = frame->LocalAt<const sql::StringVal *>(READ_LOCAL_ID());
+    OpNotLike(result, str, pattern);
+    DISPATCH_NEXT();
+  }
+
+  OP(LikeCompiled) : {
+    auto *result = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
+    auto *str = frame->LocalAt<const sql::StringVal *>(READ_LOCAL_ID());
+    auto pattern = static_cast<uintptr_t>(READ_IMM8());
+    OpLikeCompiled(result, str, pattern);
+    DISPATCH_NEXT();
+  }
+
+  OP(NotLikeCompiled) : {
+    auto *result = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
+    auto *str = frame->LocalAt<const sql::StringVal *>(READ_LOCAL_ID());
+    auto pattern = static_cast<uintptr_t>(READ_IMM8());
+    OpNotLikeCompiled(result, str, pattern);
+    DISPATCH_NEXT();
+  }
+
   OP(Lower) : {
     auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
     auto *result = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());
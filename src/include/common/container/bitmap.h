@@ -77,6 +77,22 @@ class RawBitmap {
    */
   bool operator[](const uint32_t pos) const { return Test(pos); }
 
+  /**
+   * Test whether the bits in [0, num_bits) are all set. Whole bytes are tested at once.
+   * @param num_bits number of bits to test
+   * @return true if all of them are 1
+   */
+  bool AllSet(const uint32_t num_bits) const {
+    const uint32_t num_full_bytes = num_bits / BYTE_SIZE;
+    for (uint32_t i = 0; i < num_full_bytes; i++) {
+      if (bits_[i] != UINT8_MAX) return false;
+    }
+    for (uint32_t pos = num_full_bytes * BYTE_SIZE; pos < num_bits; pos++) {
+      if (!Test(pos)) return false;
+    }
+    return true;
+  }
+
   /**
    * Sets the bit value at position to be true.
    * @param pos position to test
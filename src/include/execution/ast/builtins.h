@@ -15,6 +15,8 @@ namespace terrier::execution::ast {
   F(StringToSql, stringToSql)                                           \
   F(VarlenToSql, varlenToSql)                                           \
   F(DateToSql, dateToSql)                                               \
+  F(InitSqlNull, initSqlNull)                                           \
+  F(IsValNull, isValNull)                                               \
                                                                         \
   /* Vectorized Filters */                                              \
   F(FilterEq, filterEq)                                                 \
@@ -23,9 +25,14 @@ namespace terrier::execution::ast {
   F(FilterLe, filterLe)                                                 \
   F(FilterLt, filterLt)                                                 \
   F(FilterNe, filterNe)                                                 \
+  F(FilterLike, filterLike)                                             \
+  F(FilterNotLike, filterNotLike)                                       \
+  F(FilterInList, filterInList)                                         \
+  F(FilterVector, filterVector)                                         \
                                                                         \
   /* Thread State Container */                                          \
   F(ExecutionContextGetMemoryPool, execCtxGetMem)                       \
+  F(ExecutionContextReportRows, execCtxReportRows)                      \
   F(ThreadStateContainerInit, tlsInit)                                  \
   F(ThreadStateContainerReset, tlsReset)                                \
   F(ThreadStateContainerIterate, tlsIterate)                            \
@@ -34,6 +41,10 @@ namespace terrier::execution::ast {
   /* Table scans */                                                     \
   F(TableIterInit, tableIterInit)                                       \
   F(TableIterInitBind, tableIterInitBind)                               \
+  F(TableIterAddRangeFilter, tableIterAddRangeFilter)                   \
+  F(TableIterSetFilterColumns, tableIterSetFilterColumns)               \
+  F(TableIterMaterialize, tableIterMaterialize)                         \
+  F(TableIterFetchRow, tableIterFetchRow)                               \
   F(TableIterAdvance, tableIterAdvance)                                 \
   F(TableIterGetPCI, tableIterGetPCI)                                   \
   F(TableIterClose, tableIterClose)                                     \
@@ -47,6 +58,8 @@ namespace terrier::execution::ast {
   F(PCIAdvance, pciAdvance)                                             \
   F(PCIAdvanceFiltered, pciAdvanceFiltered)                             \
   F(PCIGetSlot, pciGetSlot)                                             \
+  F(PCIGetHash, pciGetHash)                                             \
+  F(PCIHashColumn, pciHashColumn)                                       \
   F(PCIMatch, pciMatch)                                                 \
   F(PCIReset, pciReset)                                                 \
   F(PCIResetFiltered, pciResetFiltered)                                 \
@@ -83,9 +96,14 @@ namespace terrier::execution::ast {
   F(AggHashTableInit, aggHTInit)                                        \
   F(AggHashTableInsert, aggHTInsert)                                    \
   F(AggHashTableLookup, aggHTLookup)                                    \
+  F(AggHashTableSetDenseRange, aggHTSetDenseRange)                      \
+  F(AggHashTableInsertDense, aggHTInsertDense)                          \
+  F(AggHashTableLookupDense, aggHTLookupDense)                          \
   F(AggHashTableProcessBatch, aggHTProcessBatch)                        \
   F(AggHashTableMovePartitions, aggHTMoveParts)                         \
   F(AggHashTableParallelPartitionedScan, aggHTParallelPartScan)         \
+  F(AggHashTableNextSpilledPartition, aggHTNextSpilledPart)             \
+  F(AggHashTableGetSpilledPartition, aggHTGetSpilledPart)               \
   F(AggHashTableFree, aggHTFree)                                        \
   F(AggHashTableIterInit, aggHTIterInit)                                \
   F(AggHashTableIterHasNext, aggHTIterHasNext)                          \
@@ -98,6 +116,7 @@ namespace terrier::execution::ast {
   F(AggPartIterGetRow, aggPartIterGetRow)                               \
   F(AggInit, aggInit)                                                   \
   F(AggAdvance, aggAdvance)                                             \
+  F(AggAdvanceBatch, aggAdvanceBatch)                                   \
   F(AggMerge, aggMerge)                                                 \
   F(AggReset, aggReset)                                                 \
   F(AggResult, aggResult)                                               \
@@ -109,8 +128,20 @@ namespace terrier::execution::ast {
   F(JoinHashTableIterHasNext, joinHTIterHasNext)                        \
   F(JoinHashTableIterGetRow, joinHTIterGetRow)                          \
   F(JoinHashTableIterClose, joinHTIterClose)                            \
+  F(JoinHashTableEntryIterInit, joinHTEntryIterInit)                    \
+  F(JoinHashTableEntryIterHasNext, joinHTEntryIterHasNext)              \
+  F(JoinHashTableEntryIterNext, joinHTEntryIterNext)                    \
+  F(JoinHashTableEntryIterGetRow, joinHTEntryIterGetRow)                \
   F(JoinHashTableBuild, joinHTBuild)                                    \
   F(JoinHashTableBuildParallel, joinHTBuildParallel)                    \
+  F(JoinHashTableEnableBloomFilter, joinHTEnableBloomFilter)            \
+  F(JoinHashTableFilterProbe, joinHTFilterProbe)                        \
+  F(JoinHashTableGetTupleCount, joinHTGetTupleCount)                    \
+  F(JoinHashTableIsPartitionSpilled, joinHTIsPartitionSpilled)          \
+  F(JoinHashTableSpillProbe, joinHTSpillProbe)                          \
+  F(JoinHashTableNextSpilledPartition, joinHTNextSpilledPartition)      \
+  F(JoinHashTableNextSpilledProbe, joinHTNextSpilledProbe)              \
+  F(JoinHashTableGetSpilledProbe, joinHTGetSpilledProbe)                \
   F(JoinHashTableFree, joinHTFree)                                      \
                                                                         \
   /* Sorting */                                                         \
@@ -125,6 +156,17 @@ namespace terrier::execution::ast {
   F(SorterIterNext, sorterIterNext)                                     \
   F(SorterIterGetRow, sorterIterGetRow)                                 \
   F(SorterIterClose, sorterIterClose)                                   \
+  F(MergeJoinCursorInit, mergeJoinCursorInit)                           \
+  F(MergeJoinCursorHasNext, mergeJoinCursorHasNext)                     \
+  F(MergeJoinCursorNext, mergeJoinCursorNext)                           \
+  F(MergeJoinCursorGetRow, mergeJoinCursorGetRow)                       \
+  F(MergeJoinCursorAddToRun, mergeJoinCursorAddToRun)                   \
+  F(MergeJoinCursorClearRun, mergeJoinCursorClearRun)                   \
+  F(MergeJoinCursorRunInit, mergeJoinCursorRunInit)                     \
+  F(MergeJoinCursorRunHasNext, mergeJoinCursorRunHasNext)               \
+  F(MergeJoinCursorRunNext, mergeJoinCursorRunNext)                     \
+  F(MergeJoinCursorRunGetRow, mergeJoinCursorRunGetRow)                 \
+  F(MergeJoinCursorFree, mergeJoinCursorFree)                           \
                                                                         \
   /* Trig */                                                            \
   F(ACos, acos)                                                         \
@@ -136,6 +178,10 @@ namespace terrier::execution::ast {
   F(Sin, sin)                                                           \
   F(Tan, tan)                                                           \
                                                                         \
+  /* String functions */                                                \
+  F(Like, like)                                                         \
+  F(NotLike, notLike)                                                   \
+                                                                        \
   /* Generic */                                                         \
   F(SizeOf, sizeOf)                                                     \
   F(PtrCast, ptrCast)                                                   \
@@ -147,17 +193,21 @@ namespace terrier::execution::ast {
   /* Index */                                                           \
   F(IndexIteratorInit, indexIteratorInit)                               \
   F(IndexIteratorInitBind, indexIteratorInitBind)                       \
+  F(IndexIteratorSetIndexOnly, indexIteratorSetIndexOnly)               \
   F(IndexIteratorScanKey, indexIteratorScanKey)                         \
   F(IndexIteratorScanAscending, indexIteratorScanAscending)             \
   F(IndexIteratorScanDescending, indexIteratorScanDescending)           \
   F(IndexIteratorScanLimitAscending, indexIteratorScanLimitAscending)   \
   F(IndexIteratorScanLimitDescending, indexIteratorScanLimitDescending) \
+  F(IndexIteratorAddRange, indexIteratorAddRange)                       \
+  F(IndexIteratorScanRanges, indexIteratorScanRanges)                   \
   F(IndexIteratorAdvance, indexIteratorAdvance)                         \
   F(IndexIteratorGetPR, indexIteratorGetPR)                             \
   F(IndexIteratorGetLoPR, indexIteratorGetLoPR)                         \
   F(IndexIteratorGetHiPR, indexIteratorGetHiPR)                         \
   F(IndexIteratorGetSlot, indexIteratorGetSlot)                         \
   F(IndexIteratorGetTablePR, indexIteratorGetTablePR)                   \
+  F(IndexIteratorGetKeyPR, indexIteratorGetKeyPR)                       \
   F(IndexIteratorFree, indexIteratorFree)                               \
                                                                         \
   /* Projected Row Operations */                                        \
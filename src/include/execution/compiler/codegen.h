@@ -11,6 +11,7 @@
 #include "execution/ast/context.h"
 #include "execution/ast/type.h"
 #include "execution/compiler/compiler_defs.h"
+#include "execution/exec/execution_context.h"
 #include "execution/sema/error_reporter.h"
 #include "execution/util/region.h"
 #include "parser/expression_defs.h"
@@ -84,6 +85,37 @@ class CodeGen {
    */
   sema::ErrorReporter *Reporter() { return &error_reporter_; }
 
+  /**
+   * Registers a plan node whose rows the generated code reports with execCtxReportRows
+   * @param fragment_key key of the rows of the plan node in the CardinalityFeedback
+   * @param estimated_rows the number of rows the optimizer expected of the plan node
+   * @return the id to report the rows with
+   */
+  uint32_t AddCardinalityProbe(common::hash_t fragment_key, int64_t estimated_rows) {
+    cardinality_probes_.push_back({fragment_key, estimated_rows});
+    return static_cast<uint32_t>(cardinality_probes_.size() - 1);
+  }
+
+  /**
+   * @return release the plan nodes registered with AddCardinalityProbe, indexed by probe id
+   */
+  std::vector<exec::CardinalityProbe> ReleaseCardinalityProbes() { return std::move(cardinality_probes_); }
+
+  /**
+   * Registers a scan predicate that the generated code evaluates a batch at a time with filterVector
+   * @param filter the predicate
+   * @return the id to evaluate the predicate with
+   */
+  uint32_t AddVectorFilter(std::unique_ptr<sql::VectorFilter> filter) {
+    vector_filters_.push_back(std::move(filter));
+    return static_cast<uint32_t>(vector_filters_.size() - 1);
+  }
+
+  /**
+   * @return release the predicates registered with AddVectorFilter, indexed by filter id
+   */
+  std::vector<std::unique_ptr<sql::VectorFilter>> ReleaseVectorFilters() { return std::move(vector_filters_); }
+
   /**
    * @return the state's identifier
    */
@@ -310,6 +342,11 @@ class CodeGen {
    */
   ast::Expr *FloatLiteral(double num) { return Factory()->NewFloatLiteral(DUMMY_POS, num); }
 
+  /**
+   * @return The string literal representing str
+   */
+  ast::Expr *StringLiteral(std::string_view str);
+
   /**
    * @return The boolean literal with the given value.
    */
@@ -416,18 +453,65 @@ class CodeGen {
    * @param comp_type The type of comparison being performed.
    * @param col_idx Index of the column being filtered.
    * @param col_type The type of the column being filtered.
-   * @param filter_val The value to filter byc
+   * @param filter_val The value to filter by: an integer literal, holding the bits of the double for DECIMAL columns,
+   *                   or a string literal for VARCHAR columns
    * @return The expression corresponding to the builtin call.
    */
   ast::Expr *PCIFilter(ast::Identifier pci, terrier::parser::ExpressionType comp_type, uint32_t col_idx,
                        terrier::type::TypeId col_type, ast::Expr *filter_val);
 
+  /**
+   * Call filterLike(pci, col_idx, pattern) or filterNotLike(pci, col_idx, pattern)
+   * @param pci The identifier of the projected columns iterator
+   * @param comp_type COMPARE_LIKE or COMPARE_NOT_LIKE
+   * @param col_idx Index of the string column being filtered.
+   * @param pattern The constant LIKE pattern, compiled once when the query is compiled
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *PCIFilterLike(ast::Identifier pci, terrier::parser::ExpressionType comp_type, uint32_t col_idx,
+                           std::string_view pattern);
+
+  /**
+   * Call filterInList(pci, col_idx, value1, value2, ...)
+   * @param pci The identifier of the projected columns iterator
+   * @param col_idx Index of the string column being filtered.
+   * @param values The constant strings of the list, collected once when the query is compiled
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *PCIFilterInList(ast::Identifier pci, uint32_t col_idx, const std::vector<std::string_view> &values);
+
   /**
    * Call execCtxGetMem(execCtx)
    * @return The expression corresponding to the builtin call.
    */
   ast::Expr *ExecCtxGetMem();
 
+  /**
+   * Call execCtxReportRows(execCtx, probe_id, num_rows)
+   * @param probe_id id of the plan node returned by AddCardinalityProbe
+   * @param num_rows the number of rows the plan node produced
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *ExecCtxReportRows(uint32_t probe_id, ast::Expr *num_rows);
+
+  /**
+   * Call filterVector(execCtx, pci, filter_id)
+   * @param pci The identifier of the projected columns iterator
+   * @param filter_id id of the predicate returned by AddVectorFilter
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *PCIFilterVector(ast::Identifier pci, uint32_t filter_id);
+
+  /**
+   * Call pciHashColumn(pci, col_idx, col_type, combine)
+   * @param pci The identifier of the projected columns iterator
+   * @param col_idx Index of the key column
+   * @param col_type Type of the key column
+   * @param combine Whether to combine with the hashes of earlier key columns
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *PCIHashColumn(ast::Identifier pci, uint16_t col_idx, terrier::type::TypeId col_type, bool combine);
+
   /**
    * Call sizeOf(type)
    * @param type_name The type name of argument to sizeOf.
@@ -538,6 +622,10 @@ class CodeGen {
   std::unique_ptr<ast::Context> ast_ctx_;
   ast::AstNodeFactory factory_;
   exec::ExecutionContext *exec_ctx_;
+  // Plan nodes whose rows the generated code reports
+  std::vector<exec::CardinalityProbe> cardinality_probes_;
+  // Scan predicates the generated code evaluates a batch at a time
+  std::vector<std::unique_ptr<sql::VectorFilter>> vector_filters_;
 
   // Identifiers that are always needed
   // Identifier of the state struct
@@ -41,6 +41,17 @@ class FunctionBuilder {
    */
   void StartIfStmt(ast::Expr *condition);
 
+  /**
+   * Begins an IfStmt with an else branch. Statements go to the then branch until StartElseBlock is called.
+   * @param condition if condition
+   */
+  void StartIfElseStmt(ast::Expr *condition);
+
+  /**
+   * Finishes the then branch of an IfStmt begun with StartIfElseStmt and begins its else branch
+   */
+  void StartElseBlock();
+
   /**
    * Begins a ForStmt
    * @param init
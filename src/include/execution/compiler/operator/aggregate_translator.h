@@ -1,6 +1,7 @@
 #pragma once
 
 #include <utility>
+#include <vector>
 #include "execution/compiler/operator/operator_translator.h"
 #include "planner/plannodes/aggregate_plan_node.h"
 
@@ -11,7 +12,15 @@ class AggregateTopTranslator;
 
 /**
  * Aggregate Bottom Translator
- * This translator is responsible for the build phase.
+ * This translator is responsible for the build phase. Groups are usually kept in an aggregation
+ * hash table, with three exceptions:
+ *  - Without GROUP BY, the single group's aggregates live directly in the query state. If the child
+ *    is a sequential scan whose columns are aggregated as they are, each aggregate is advanced by a
+ *    whole vector at a time.
+ *  - With a single TINYINT grouping key, groups are addressed directly by the key.
+ *  - If the input is sorted on the GROUP BY terms (AggregateStrategyType::SORTED), only the current
+ *    group is kept, in a local variable. Both translators then belong to the child's pipeline, and
+ *    each group is handed to the top translator as soon as the first tuple of the next one arrives.
  */
 class AggregateBottomTranslator : public OperatorTranslator {
  public:
@@ -28,7 +37,7 @@ class AggregateBottomTranslator : public OperatorTranslator {
   // Declare payload and probe structs
   void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
 
-  // Create the key check function.
+  // Create the key check and partial aggregate merge functions.
   void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
 
   // Call @aggHTInit on the hash table
@@ -41,16 +50,25 @@ class AggregateBottomTranslator : public OperatorTranslator {
   void Abort(FunctionBuilder *builder) override;
   void Consume(FunctionBuilder *builder) override;
 
+  // Whole vectors are consumed when aggregating columns of a sequential scan without GROUP BY
+  bool ConsumesVectors() override;
+
+  // For each aggregate expression, call @aggAdvanceBatch(&state.agg_term_i, pci, col_idx, col_type)
+  void ConsumeVector(FunctionBuilder *builder) override;
+
+  // Hash the grouping keys of the child scan's vector of tuples a column at a time, if they are its columns
+  void GenChildVectorHash(FunctionBuilder *builder) override;
+
   // Pass through to the child
   ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
 
   // Return the attribute at idx
   ast::Expr *GetOutput(uint32_t attr_idx) override;
 
-  // This is materializer
+  // This is materializer, unless the groups are not kept in a hash table
   bool IsMaterializer(bool *is_ptr) override {
     *is_ptr = true;
-    return true;
+    return UsesHashTable();
   }
 
   // Return the payload and its type
@@ -89,9 +107,15 @@ class AggregateBottomTranslator : public OperatorTranslator {
   void GenValuesStruct(util::RegionVector<ast::Decl *> *decls);
 
   /*
-   * Generate the key check logic
+   * Generate the key check logic comparing the group by terms of agg_payload to those of the given object
+   */
+  void GenKeyCheck(FunctionBuilder *builder, ast::Identifier object);
+
+  /*
+   * Generate a condition that is true when the group by term at the given index differs between the two objects.
+   * Unlike SQL's !=, this is IS DISTINCT FROM: two NULLs belong to the same group, and NULL differs from any value.
    */
-  void GenKeyCheck(FunctionBuilder *builder);
+  ast::Expr *GenGroupByTermDistinct(ast::Identifier lhs, ast::Identifier rhs, uint32_t term_idx);
 
   /*
    * First declare var agg_values : AggValues
@@ -115,12 +139,38 @@ class AggregateBottomTranslator : public OperatorTranslator {
    */
   void GenAdvance(FunctionBuilder *builder);
 
-  // Generate var agg_hash_val = @hash(groub_by_term1, group_by_term2, ...)
+  // Generate var agg_hash_val = @hash(groub_by_term1, group_by_term2, ...), or @pciGetHash(pci) if the child scan
+  // hashed the grouping keys a vector at a time
   void GenHashCall(FunctionBuilder *builder);
 
+  // Whether the child scan hashes the grouping keys a vector at a time
+  bool HashesKeyVectors();
+
+  // The grouping keys as expressions over the output of the child
+  std::vector<const terrier::parser::AbstractExpression *> GetGroupByKeys() const;
+
   // Tuple at a time key check
   void GenSingleKeyCheckFn(util::RegionVector<ast::Decl *> *decls);
 
+  // Declare the functions merging the partial aggregates of a spilled partition into a table
+  void GenMergeFn(util::RegionVector<ast::Decl *> *decls);
+
+  // Whether the hash table may spill its groups, to be merged partition by partition when it is scanned
+  bool MaySpill() const { return UsesHashTable() && !is_dense_; }
+
+  /*
+   * If agg_has_group, and any group by term differs from agg_payload.term_i, pass the group to the
+   * parent and set agg_has_group = false.
+   * If !agg_has_group, start a new group: copy the group by terms, call @aggInit and set agg_has_group = true.
+   */
+  void GenStreamingGroupSwitch(FunctionBuilder *builder);
+
+  // Whether the groups are kept in the aggregation hash table
+  bool UsesHashTable() const { return !is_global_ && !is_streaming_; }
+
+  // Return the column of the child sequential scan that a term reads, if the term is just a column reference
+  bool GetScanColumn(const terrier::parser::AbstractExpression *term, uint16_t *col_idx, type::TypeId *col_type);
+
   // Make the top translator a friend class.
   friend class AggregateTopTranslator;
 
@@ -128,6 +178,15 @@ class AggregateBottomTranslator : public OperatorTranslator {
   // The number of group by terms.
   uint32_t num_group_by_terms_;
   const planner::AggregatePlanNode *op_;
+  // Whether there is no GROUP BY, so that the aggregates live in the query state
+  bool is_global_;
+  // Whether the input arrives sorted on the group by terms
+  bool is_streaming_;
+  // The range of keys that are directly addressed, set along with is_dense_
+  int64_t dense_min_key_{0};
+  int64_t dense_max_key_{0};
+  // Whether the hash table groups are directly addressed by a single integer key
+  bool is_dense_;
 
   // Structs, Functions, and local variables needed.
   // TODO(Amadou): This list is blowing up. Figure out a different to manage local variable names.
@@ -140,6 +199,16 @@ class AggregateBottomTranslator : public OperatorTranslator {
   ast::Identifier agg_payload_;
   ast::Identifier key_check_;
   ast::Identifier agg_ht_;
+  // The merge function of spilled partial aggregates, and its key check, table, iterator, and partial aggregate
+  ast::Identifier merge_fn_;
+  ast::Identifier merge_key_check_;
+  ast::Identifier part_ht_;
+  ast::Identifier part_iter_;
+  ast::Identifier agg_partial_;
+  // Whether the streaming aggregation has started a group
+  ast::Identifier has_group_;
+  // The query state fields of the aggregates without GROUP BY
+  std::vector<ast::Identifier> global_aggs_;
 };
 
 /**
@@ -183,10 +252,10 @@ class AggregateTopTranslator : public OperatorTranslator {
   ast::Expr *GetOutput(uint32_t attr_idx) override;
   ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
 
-  // This is a materializer
+  // This is a materializer, unless the groups are not kept in a hash table
   bool IsMaterializer(bool *is_ptr) override {
     *is_ptr = false;
-    return true;
+    return bottom_->UsesHashTable();
   }
 
   // Pass the call to the bottom translator.
@@ -200,8 +269,11 @@ class AggregateTopTranslator : public OperatorTranslator {
   // Declare var agg_iterator: *AggregationHashTableIterator
   void DeclareIterator(FunctionBuilder *builder);
 
-  // for (@aggHTIterInit(agg_iter, &state.table); @aggHTIterHasNext(&agg_iter); @aggHTIterNext(agg_iter)) {...}
-  void GenHTLoop(FunctionBuilder *builder);
+  // Let the parent consume the groups of the given table
+  void GenHTScan(FunctionBuilder *builder, ast::Expr *agg_ht);
+
+  // for (@aggHTIterInit(agg_iter, agg_ht); @aggHTIterHasNext(&agg_iter); @aggHTIterNext(agg_iter)) {...}
+  void GenHTLoop(FunctionBuilder *builder, ast::Expr *agg_ht);
 
   // Declare var agg_payload = @ptrCast(*AggPayload, @aggHTIterGetRow(&agg_iter))
   void DeclareResult(FunctionBuilder *builder);
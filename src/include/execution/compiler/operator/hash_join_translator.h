@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include "execution/compiler/expression/expression_translator.h"
 #include "execution/compiler/operator/operator_translator.h"
 #include "planner/plannodes/hash_join_plan_node.h"
@@ -65,15 +66,32 @@ class HashJoinLeftTranslator : public OperatorTranslator {
   // Build the hash table
   void GenBuildCall(FunctionBuilder *builder);
 
+  // Report the number of build rows to the optimizer
+  void GenReportBuildRows(FunctionBuilder *builder);
+
+  // Whether to build a bloom filter that the probe side scan applies to its input
+  bool UseBloomFilter() const;
+
+  // Whether the build rows record if a probe tuple matched them (left, outer, semi and anti joins)
+  bool HasMatchFlag() const;
+
+  // Whether the build rows no probe tuple matched are output (left, outer and anti joins)
+  bool EmitsUnmatchedBuildRows() const;
+
+  // Get the match flag of the build row
+  ast::Expr *GetMatchFlag();
+
   // The hash join plan node
   const planner::HashJoinPlanNode *op_;
 
   // Structs, functions, and locals
   static constexpr const char *LEFT_ATTR_NAME = "left_attr";
+  static constexpr const char *MATCH_NAME = "match";
   ast::Identifier hash_val_;
   ast::Identifier build_struct_;
   ast::Identifier build_row_;
   ast::Identifier join_ht_;
+  ast::Identifier match_;
 };
 
 /**
@@ -96,15 +114,21 @@ class HashJoinRightTranslator : public OperatorTranslator {
   // Does nothing
   void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
 
-  // Declare JoinProbe struct if the previous operator is not a materializer
+  // Declare the ProbeRow struct, which also holds the probe tuples of spilled partitions
   void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
 
-  // Declare the keyCheck function
+  // Declare the keyCheck functions
   void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
 
   // Does nothing (left operator already initialized the hash table)
   void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
 
+  // Hash the probe keys of the probe side scan's vector of tuples a column at a time, if they are its columns
+  void GenChildVectorHash(FunctionBuilder *builder) override;
+
+  // Filter the probe side scan's vector of tuples with the join's bloom filter
+  bool GenChildVectorFilter(FunctionBuilder *builder) override;
+
   // Does nothing (left operator already freed the hash table)
   void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
 
@@ -123,14 +147,56 @@ class HashJoinRightTranslator : public OperatorTranslator {
   // Make the probing hash value
   void GenHashValue(FunctionBuilder *builder);
 
+  // @hash(right_join_keys)
+  ast::Expr *GenHashCall();
+
+  // The probe keys as expressions over the output of the probe side child
+  std::vector<const terrier::parser::AbstractExpression *> GetProbeKeys() const;
+
+  // Whether the probe side scan hashes the probe keys a vector at a time
+  bool HashesKeyVectors();
+
+  // Declare the function computing the hash value of a probe tuple in the bloom filter
+  void GenProbeHashFn(util::RegionVector<ast::Decl *> *decls);
+
+  // Declare the probe row
+  void DeclareProbeRow(FunctionBuilder *builder);
+
   // Fill the probe row if necessary
   void FillProbeRow(FunctionBuilder *builder);
 
+  // Whether the probe tuples no build row matched are output (right and outer joins)
+  bool EmitsUnmatchedProbeRows() const;
+
+  // Record a match, and let the parent consume the joined tuple if the join type outputs it
+  void GenMatch(FunctionBuilder *builder);
+
+  // Let the parent consume the probe tuple with NULL build attributes if no build row matched it
+  void GenUnmatchedProbeRow(FunctionBuilder *builder);
+
+  // Loop over the build rows, and let the parent consume the unmatched ones with NULL probe attributes
+  void GenUnmatchedBuildLoop(FunctionBuilder *builder);
+
+  // Set a SQL value to NULL
+  void GenInitNull(FunctionBuilder *builder, ast::Expr *attr);
+
   // Declare the hash table iterator
   void DeclareIterator(FunctionBuilder *builder);
 
+  // The probe tuple the key check function of the in-memory probe takes
+  ast::Expr *GetProbeTuple();
+
+  // Write the probe tuple to its spilled partition
+  void GenSpillProbeRow(FunctionBuilder *builder);
+
+  // Probe the hash table with the probe tuple, and output the joined tuples
+  void GenProbe(FunctionBuilder *builder, ast::Identifier key_check, ast::Expr *probe_tuple);
+
+  // Loop over the spilled partitions, joining the probe tuples spilled to each with its build rows
+  void GenSpilledPartitionLoop(FunctionBuilder *builder);
+
   // Loop to probe the hash table
-  void GenProbeLoop(FunctionBuilder *builder);
+  void GenProbeLoop(FunctionBuilder *builder, ast::Identifier key_check, ast::Expr *probe_tuple);
 
   // Close the iterator after the loop
   void GenIteratorClose(FunctionBuilder *builder);
@@ -152,12 +218,20 @@ class HashJoinRightTranslator : public OperatorTranslator {
   bool is_child_materializer_{false};
   bool is_child_ptr_{false};
 
+  // Whether probe values are read from probe_row even if the right child is a materializer. The probe tuples of
+  // spilled partitions are always read back as ProbeRows.
+  bool probe_from_row_{false};
+
   // Structs, functions, and locals
   static constexpr const char *RIGHT_ATTR_NAME = "right_attr";
   ast::Identifier hash_val_;
   ast::Identifier probe_struct_;
   ast::Identifier probe_row_;
   ast::Identifier key_check_;
+  ast::Identifier spilled_key_check_;
+  ast::Identifier probe_hash_fn_;
   ast::Identifier join_iter_;
+  ast::Identifier entry_iter_;
+  ast::Identifier matched_;
 };
 }  // namespace terrier::execution::compiler
@@ -9,7 +9,8 @@
 namespace terrier::execution::compiler {
 
 /**
- * Index scan translator.
+ * Index scan translator. Index-only scans read the scanned columns from the keys of the index entries, and never fetch
+ * the tuples from the table.
  */
 class IndexScanTranslator : public OperatorTranslator {
  public:
@@ -46,7 +47,9 @@ class IndexScanTranslator : public OperatorTranslator {
   }
 
   // Return the projected row and its type
-  std::pair<ast::Identifier *, ast::Identifier *> GetMaterializedTuple() override { return {&table_pr_, &pr_type_}; }
+  std::pair<ast::Identifier *, ast::Identifier *> GetMaterializedTuple() override {
+    return {op_->IsIndexOnly() ? &key_pr_ : &table_pr_, &pr_type_};
+  }
 
   ast::Expr *GetOutput(uint32_t attr_idx) override;
   ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
@@ -64,6 +67,8 @@ class IndexScanTranslator : public OperatorTranslator {
   // Fill the key with table data
   void FillKey(FunctionBuilder *builder, ast::Identifier pr,
                const std::unordered_map<catalog::indexkeycol_oid_t, planner::IndexExpression> &index_exprs);
+  // Fill the bounds of every key range, and add them to the iterator
+  void AddKeyRanges(FunctionBuilder *builder);
   // Generate the index iteration loop
   void GenForLoop(FunctionBuilder *builder);
   // Generate the join predicate's if statement
@@ -74,6 +79,12 @@ class IndexScanTranslator : public OperatorTranslator {
   void DeclareIndexPR(FunctionBuilder *builder);
   // Get Table PR
   void DeclareTablePR(FunctionBuilder *builder);
+  // Make the iterator index-only
+  void SetIndexOnly(FunctionBuilder *builder);
+  // Get Key PR
+  void DeclareKeyPR(FunctionBuilder *builder);
+  // Return the index key column storing the given table column
+  const catalog::IndexSchema::Column &GetKeyColumn(const catalog::col_oid_t &col_oid);
   // Get Slot
   void DeclareSlot(FunctionBuilder *builder);
 
@@ -91,6 +102,7 @@ class IndexScanTranslator : public OperatorTranslator {
   ast::Identifier lo_index_pr_;
   ast::Identifier hi_index_pr_;
   ast::Identifier table_pr_;
+  ast::Identifier key_pr_;
   ast::Identifier pr_type_;
   ast::Identifier slot_;
 };
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "execution/compiler/expression/expression_translator.h"
+#include "execution/compiler/operator/operator_translator.h"
+#include "planner/plannodes/merge_join_plan_node.h"
+
+namespace terrier::execution::compiler {
+
+// Forward declare for friendship
+class MergeJoinRightTranslator;
+
+/**
+ * Left translator for merge joins. It materializes the left input in a sorter. The sorter does not reorder input that
+ * already arrives sorted on the join keys.
+ */
+class MergeJoinLeftTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op The plan node
+   * @param codegen The code generator
+   */
+  MergeJoinLeftTranslator(const terrier::planner::MergeJoinPlanNode *op, CodeGen *codegen);
+
+  // Insert tuples into the sorter
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+  void Consume(FunctionBuilder *builder) override;
+
+  // Add the sorter
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override;
+
+  // Declare LeftRow struct
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Create the function ordering left rows on the join keys
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Call @sorterInit on the sorter
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override;
+
+  // Call @sorterFree on the sorter
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
+
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  friend class MergeJoinRightTranslator;
+
+  // Insert into the sorter
+  void GenSorterInsert(FunctionBuilder *builder);
+
+  // Fill the left row
+  void FillLeftRow(FunctionBuilder *builder);
+
+  // Call @sorterSort
+  void GenSorterSort(FunctionBuilder *builder);
+
+  // Generate the comparisons in the comparison function
+  void GenComparisons(FunctionBuilder *builder);
+
+  // Return the member of the object at the given index
+  ast::Expr *GetAttribute(ast::Identifier object, uint32_t attr_idx);
+
+  // The merge join plan node
+  const planner::MergeJoinPlanNode *op_;
+
+  // Whether GetChildOutput reads from the child, or from the lhs or rhs of the comparison function
+  enum class CurrentRow { Child, Lhs, Rhs };
+  CurrentRow current_row_{CurrentRow::Child};
+
+  // Structs, functions, and locals
+  static constexpr const char *LEFT_ATTR_NAME = "left_attr";
+  ast::Identifier sorter_;
+  ast::Identifier left_struct_;
+  ast::Identifier left_row_;
+  ast::Identifier comp_fn_;
+  ast::Identifier comp_lhs_;
+  ast::Identifier comp_rhs_;
+};
+
+/**
+ * Right translator for merge joins. The right input streams in join key order, and is merged with the sorted left
+ * input. The left rows that match the current right tuple are kept in a run, so that the following right tuples with
+ * the same keys can be joined with them without moving the cursor backwards.
+ */
+class MergeJoinRightTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op The plan node
+   * @param codegen The code generator
+   * @param left The corresponding left translator
+   */
+  MergeJoinRightTranslator(const terrier::planner::MergeJoinPlanNode *op, CodeGen *codegen, OperatorTranslator *left);
+
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+  void Consume(FunctionBuilder *builder) override;
+
+  // Does nothing
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+
+  // Declare ProbeRow struct
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Declare the function comparing a left row with a probe row
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Does nothing (left operator already initialized the sorter)
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+
+  // Does nothing (left operator already freed the sorter)
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+
+  // Get the output at idx
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  // Dispatch the call to the correct child
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  // Returns a probe value
+  ast::Expr *GetProbeValue(uint32_t idx);
+
+  // Declare and fill the probe row
+  void FillProbeRow(FunctionBuilder *builder);
+
+  // Start an if statement that skips the probe tuple if one of its join keys is NULL
+  void GenNonNullKeyCheck(FunctionBuilder *builder);
+
+  // Declare the cursor over the left rows, and call @mergeJoinCursorInit
+  void DeclareCursor(FunctionBuilder *builder);
+
+  // Call @mergeJoinCursorFree
+  void GenCursorFree(FunctionBuilder *builder);
+
+  // Replace the run with the left rows matching the probe tuple, unless it already holds them
+  void GenAdvanceCursor(FunctionBuilder *builder);
+
+  // Loop over the run, and let the parent consume the joined tuples
+  void GenRunLoop(FunctionBuilder *builder);
+
+  // mergeJoinCmpFn(@ptrCast(*LeftRow, row), &probe_row)
+  ast::Expr *GenCmpCall(ast::Expr *row);
+
+  // Complete the comparison function
+  void GenComparisons(FunctionBuilder *builder);
+
+  // The merge join plan node
+  const planner::MergeJoinPlanNode *op_;
+  // The left translator
+  MergeJoinLeftTranslator *left_;
+
+  // Structs, functions, and locals
+  static constexpr const char *RIGHT_ATTR_NAME = "right_attr";
+  ast::Identifier probe_struct_;
+  ast::Identifier probe_row_;
+  ast::Identifier cmp_fn_;
+  ast::Identifier cursor_;
+  ast::Identifier advance_;
+};
+}  // namespace terrier::execution::compiler
@@ -99,6 +99,37 @@ class OperatorTranslator : public ExpressionEvaluator {
    */
   virtual bool IsParallelizable() { return false; }
 
+  /**
+   * Called by a child that produces vectors of tuples (i.e., a sequential scan) after each vector
+   * is produced and before its tuples are iterated over, so that this operator may discard tuples
+   * it is known not to need. The generated code must leave the child's vector in a filtered state.
+   * @param builder builder of the pipeline function
+   * @return Whether a filter was generated
+   */
+  virtual bool GenChildVectorFilter(FunctionBuilder *builder) { return false; }
+
+  /**
+   * Called by a child that produces vectors of tuples (i.e., a sequential scan) after it has applied
+   * its own filters to each vector, and before GenChildVectorFilter(), so that this operator may hash
+   * its keys a whole vector at a time (see SeqScanTranslator::GenHashKeys()).
+   * @param builder builder of the pipeline function
+   */
+  virtual void GenChildVectorHash(FunctionBuilder *builder) {}
+
+  /**
+   * Whether this operator consumes whole vectors of tuples at once. If so, a child that produces
+   * vectors of tuples (i.e., a sequential scan) applies its own filters to each vector and hands the
+   * filtered vector over through ConsumeVector(), instead of calling Consume() on each tuple.
+   * @return Whether this operator consumes vectors
+   */
+  virtual bool ConsumesVectors() { return false; }
+
+  /**
+   * Consume code for a whole filtered vector of tuples produced by the child
+   * @param builder builder of the pipeline function
+   */
+  virtual void ConsumeVector(FunctionBuilder *builder) { UNREACHABLE("This operator does not consume vectors"); }
+
   /**
    * Return a table column value.
    * @param col_oid oid of the column
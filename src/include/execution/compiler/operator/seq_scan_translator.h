@@ -1,8 +1,11 @@
 #pragma once
 
+#include <memory>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include "execution/compiler/operator/operator_translator.h"
+#include "execution/sql/vector_expression.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 
 namespace terrier::execution::compiler {
@@ -23,20 +26,20 @@ class SeqScanTranslator : public OperatorTranslator {
   void Abort(FunctionBuilder *builder) override;
   void Consume(FunctionBuilder *builder) override;
 
-  // Does nothing
-  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+  // Declare the filter manager, if the predicate has several conjuncts the PCI filters evaluate
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override;
 
   // Does nothing
   void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override {}
 
-  // Does nothing
-  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override {}
+  // Declare a function evaluating each clause of the filter manager
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
 
-  // Does nothing
-  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+  // Initialize the filter manager with its clauses
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override;
 
-  // Does nothing
-  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+  // Free the filter manager
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
 
   ast::Expr *GetOutput(uint32_t attr_idx) override;
 
@@ -54,11 +57,15 @@ class SeqScanTranslator : public OperatorTranslator {
   // This is vectorizable only if the predicate is vectorizable
   bool IsVectorizable() override { return is_vectorizable_; }
   /**
-   * Recursively walk down the predicate tree to check if it is vectorizable.
+   * Recursively walk down the predicate tree to check if it is vectorizable, i.e., if it is a conjunction of
+   * comparisons of columns with constants the PCI filters can compare them with: integers the column can hold, or
+   * DATE, TIMESTAMP, DECIMAL and VARCHAR constants of the column's own type, or LIKE patterns for VARCHAR columns.
+   * Conjuncts that do arithmetic, or combine comparisons of numeric columns with OR and NOT, are vectorizable too;
+   * they are evaluated a batch at a time by a sql::VectorFilter.
    * @param predicate The predicate to check
    * @return Whether the predicate is vectorizable or not.
    */
-  static bool IsVectorizable(const terrier::parser::AbstractExpression *predicate);
+  bool IsVectorizable(const terrier::parser::AbstractExpression *predicate) const;
 
   // Return the pci and its type
   std::pair<ast::Identifier *, ast::Identifier *> GetMaterializedTuple() override { return {&pci_, &pci_type_}; }
@@ -71,12 +78,59 @@ class SeqScanTranslator : public OperatorTranslator {
 
   const planner::AbstractPlanNode *Op() override { return op_; }
 
+  /**
+   * Find the scanned column that an expression over this scan's output reads, if the expression is
+   * nothing but a reference to a column.
+   * @param expr expression over the output of this scan
+   * @param[out] col_idx index of the column in the scan's PCI
+   * @param[out] col_type type of the column
+   * @return Whether the expression is a column reference
+   */
+  bool GetColumnRef(const terrier::parser::AbstractExpression *expr, uint16_t *col_idx, type::TypeId *col_type);
+
+  /**
+   * Whether hash keys over this scan's output can be hashed a whole vector at a time, i.e., every key is a reference
+   * to an integer, DECIMAL or VARCHAR column, which @pciHashColumn() hashes to the same value as @hash().
+   * @param keys the key expressions over the output of this scan
+   * @return Whether GenHashKeys() can hash the keys
+   */
+  bool CanHashKeys(const std::vector<const terrier::parser::AbstractExpression *> &keys);
+
+  /**
+   * Hash the keys of every selected tuple of the current vector, one column at a time, so that the parent reads each
+   * tuple's hash with @pciGetHash(pci) instead of calling @hash() on the keys:
+   * @pciHashColumn(pci, key_col_idx, key_col_type, combine) for every key
+   * @param builder builder of the pipeline function
+   * @param keys the key expressions, in the order they would be passed to @hash()
+   */
+  void GenHashKeys(FunctionBuilder *builder, const std::vector<const terrier::parser::AbstractExpression *> &keys);
+
  private:
   // var tvi : TableVectorIterator
   void DeclareTVI(FunctionBuilder *builder);
 
+  // @tableIterAddRangeFilter(&tvi, col_oid, min_key, max_key) for every conjunct comparing a column to a constant
+  void GenZoneMapFilters(FunctionBuilder *builder, const terrier::parser::AbstractExpression *predicate);
+
   void SetOids(FunctionBuilder *builder);
 
+  // Collect the columns read by the predicate
+  static void CollectColumnOids(const terrier::parser::AbstractExpression *expr,
+                                std::vector<catalog::col_oid_t> *col_oids);
+
+  // Let the TVI read only the predicate columns up front, and defer the rest until after filtering:
+  // @tableIterSetFilterColumns(&tvi, filter_col_oids)
+  void GenSetFilterColumns(FunctionBuilder *builder);
+
+  // Filter the vector, then read the deferred columns of the surviving tuples, if any:
+  // for (; @pciHasNext(pci); @pciAdvance(pci)) { @pciMatch(pci, cond) }
+  // @pciResetFiltered(pci)
+  // @tableIterMaterialize(&tvi)
+  void GenLateMaterializedFilter(FunctionBuilder *builder);
+
+  // Filter each vector and hand it over to a parent that consumes whole vectors
+  void DoVectorScan(FunctionBuilder *builder);
+
   void DoTableScan(FunctionBuilder *builder);
 
   // for (@tableIterInit(&tvi, ...); @tableIterAdvance(&tvi);) {...}
@@ -98,8 +152,37 @@ class SeqScanTranslator : public OperatorTranslator {
   // @tableIterReset(&tvi)
   void GenTVIReset(FunctionBuilder *builder);
 
-  // Generated vectorized filters
-  void GenVectorizedPredicate(FunctionBuilder *builder, const terrier::parser::AbstractExpression *predicate);
+  // Split a vectorizable predicate into the conjuncts the PCI filters evaluate, and those a sql::VectorFilter does
+  void SplitConjuncts(const terrier::parser::AbstractExpression *predicate);
+
+  // Generated vectorized filters: the PCI filters, run by the filter manager if there are several, then the
+  // sql::VectorFilter
+  void GenVectorizedPredicate(FunctionBuilder *builder);
+
+  // Whether the conjunct compares a column with a constant the PCI filters can compare it with, or is an IN list
+  bool IsPCIFilter(const terrier::parser::AbstractExpression *predicate) const;
+
+  // Whether the conjunct is a disjunction of equalities between the same string column and constant strings, which is
+  // how the parser rewrites IN lists. Adds the strings to values.
+  bool IsStringInList(const terrier::parser::AbstractExpression *predicate, catalog::col_oid_t *col_oid,
+                      std::vector<std::string_view> *values) const;
+
+  // Whether a sql::VectorExpression can compute the expression, and the type it computes: BIGINT for integers, DECIMAL
+  // or BOOLEAN. Sets reads_column if the expression reads a scanned column.
+  bool IsVectorExpression(const terrier::parser::AbstractExpression *expr, type::TypeId *type,
+                          bool *reads_column) const;
+
+  // Build the sql::VectorExpression of the expression, adding the scanned columns it reads to col_idxs and col_types
+  std::unique_ptr<sql::VectorExpression> MakeVectorExpression(const terrier::parser::AbstractExpression *expr,
+                                                              std::vector<uint16_t> *col_idxs,
+                                                              std::vector<type::TypeId> *col_types) const;
+
+  // @filterEq(pci, ...) etc. evaluating a conjunct the PCI filters evaluate
+  ast::Expr *PCIFilterCall(const terrier::parser::AbstractExpression *conjunct);
+
+  // @filterVector(execCtx, pci, filter_id) evaluating the conjunction of the given conjuncts a batch at a time
+  void GenVectorFilter(FunctionBuilder *builder,
+                       const std::vector<const terrier::parser::AbstractExpression *> &conjuncts);
 
  private:
   const planner::SeqScanPlanNode *op_;
@@ -108,13 +191,27 @@ class SeqScanTranslator : public OperatorTranslator {
   storage::ProjectionMap pm_;
   bool has_predicate_;
   bool is_vectorizable_;
+  // Whether the PCI is iterated over in filtered mode
+  bool is_filtered_{false};
+  // The columns read by the predicate. If these are only some of the scanned columns, the other columns are only read
+  // for tuples that pass the predicate.
+  std::vector<catalog::col_oid_t> filter_oids_;
+  bool late_materialize_{false};
+  // The conjuncts of a vectorized predicate the PCI filters evaluate, and those they do not
+  std::vector<const terrier::parser::AbstractExpression *> pci_conjuncts_;
+  std::vector<const terrier::parser::AbstractExpression *> vector_conjuncts_;
+  // If there are several PCI filter conjuncts, a filter manager runs them as its clauses, in the order it finds to be
+  // the cheapest. Each clause is evaluated by its own function.
+  std::vector<ast::Identifier> clause_fns_;
 
   // Structs, functions and locals
   ast::Identifier tvi_;
   ast::Identifier col_oids_;
+  ast::Identifier filter_col_oids_;
   ast::Identifier pci_;
   ast::Identifier slot_;
   ast::Identifier pci_type_;
+  ast::Identifier filter_manager_;
 };
 
 }  // namespace terrier::execution::compiler
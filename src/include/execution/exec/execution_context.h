@@ -1,19 +1,45 @@
 #pragma once
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
+#include "common/hash_util.h"
 #include "common/managed_pointer.h"
 #include "execution/exec/output.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/memory_tracker.h"
+#include "execution/sql/vector_expression.h"
 #include "execution/util/region.h"
 #include "planner/plannodes/output_schema.h"
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_manager.h"
 #include "type/transient_value.h"
 
+namespace terrier::optimizer {
+class StatsStorage;
+class TableStatsDelta;
+}  // namespace terrier::optimizer
+
 namespace terrier::execution::exec {
+
+/**
+ * A plan node whose rows a compiled query reports with ExecutionContext::ReportRows. The code generator registers the
+ * probes of a query, and the ExecutableQuery hands them to the ExecutionContext of each run.
+ */
+struct CardinalityProbe {
+  /**
+   * Key of the rows of the plan node in the CardinalityFeedback
+   */
+  common::hash_t fragment_key_;
+
+  /**
+   * Number of rows the optimizer expected of the plan node, or -1 if there was no estimate
+   */
+  int64_t estimated_rows_;
+};
+
 /**
  * Execution Context: Stores information handed in by upper layers.
  * TODO(Amadou): This class will change once we know exactly what we get from upper layers.
@@ -73,7 +99,8 @@ class EXPORT ExecutionContext {
                    const common::ManagedPointer<catalog::CatalogAccessor> accessor)
       : db_oid_(db_oid),
         txn_(txn),
-        mem_pool_(std::make_unique<sql::MemoryPool>(nullptr)),
+        mem_tracker_(std::make_unique<sql::MemoryTracker>()),
+        mem_pool_(std::make_unique<sql::MemoryPool>(mem_tracker_.get())),
         buffer_(schema == nullptr ? nullptr
                                   : std::make_unique<OutputBuffer>(mem_pool_.get(), schema->GetColumns().size(),
                                                                    ComputeTupleSize(schema), callback)),
@@ -89,6 +116,76 @@ class EXPORT ExecutionContext {
    */
   OutputBuffer *GetOutputBuffer() { return buffer_.get(); }
 
+  /**
+   * @return the memory tracker
+   */
+  sql::MemoryTracker *GetMemoryTracker() { return mem_tracker_.get(); }
+
+  /**
+   * Limit the memory this query may use. Operators that can spill (sorters, join hash
+   * tables and non-dense aggregation hash tables) read the limit when they are created,
+   * so it must be set before the query starts executing. The traffic cop sets it from the
+   * query_memory_limit setting.
+   * @param memory_limit The limit in bytes; sql::MemoryTracker::K_UNLIMITED for no limit
+   */
+  void SetMemoryLimit(std::size_t memory_limit) { mem_tracker_->SetMemoryLimit(memory_limit); }
+
+  /**
+   * Keep the statistics in the given storage current with the writes of this query. The writes of each table are
+   * summarized in a TableStatsDelta that is added to the storage when the transaction commits. The row counts the
+   * query reports with ReportRows go to the storage as well.
+   * @param stats_storage The storage of the table statistics
+   */
+  void SetStatsStorage(const common::ManagedPointer<optimizer::StatsStorage> stats_storage) {
+    stats_storage_ = stats_storage;
+  }
+
+  /**
+   * @return the storage of the table statistics, or nullptr if no statistics are maintained
+   */
+  common::ManagedPointer<optimizer::StatsStorage> GetStatsStorage() const { return stats_storage_; }
+
+  /**
+   * @param table_oid oid of a table this query writes to
+   * @return the summary of this query's writes to the table, or nullptr if no statistics are maintained
+   */
+  optimizer::TableStatsDelta *GetTableStatsDelta(catalog::table_oid_t table_oid);
+
+  /**
+   * Sets the plan nodes whose rows the running query reports with ReportRows
+   * @param cardinality_probes the probes of the query, indexed by probe id, or nullptr to drop the reports
+   */
+  void SetCardinalityProbes(const common::ManagedPointer<const std::vector<CardinalityProbe>> cardinality_probes) {
+    cardinality_probes_ = cardinality_probes;
+  }
+
+  /**
+   * Reports the number of rows a plan node produced. Reports go to the CardinalityFeedback of the statistics storage,
+   * where the optimizer picks them up when it plans the same fragment again. Pipeline breakers report them once their
+   * input is complete.
+   * @param probe_id index of the plan node in the probes of the running query
+   * @param num_rows the number of rows
+   */
+  void ReportRows(uint32_t probe_id, uint64_t num_rows);
+
+  /**
+   * Sets the scan predicates the running query evaluates a batch at a time
+   * @param vector_filters the filters of the query, indexed by filter id
+   */
+  void SetVectorFilters(
+      const common::ManagedPointer<const std::vector<std::unique_ptr<sql::VectorFilter>>> vector_filters) {
+    vector_filters_ = vector_filters;
+  }
+
+  /**
+   * @param filter_id index of the filter in the filters of the running query
+   * @return the filter
+   */
+  const sql::VectorFilter &GetVectorFilter(uint32_t filter_id) const {
+    TERRIER_ASSERT(vector_filters_ != nullptr && filter_id < vector_filters_->size(), "Unknown vector filter");
+    return *(*vector_filters_)[filter_id];
+  }
+
   /**
    * @return the memory pool
    */
@@ -142,11 +239,19 @@ class EXPORT ExecutionContext {
  private:
   catalog::db_oid_t db_oid_;
   common::ManagedPointer<transaction::TransactionContext> txn_;
+  std::unique_ptr<sql::MemoryTracker> mem_tracker_;
   std::unique_ptr<sql::MemoryPool> mem_pool_;
   std::unique_ptr<OutputBuffer> buffer_;
   StringAllocator string_allocator_;
   common::ManagedPointer<catalog::CatalogAccessor> accessor_;
   std::vector<type::TransientValue> params_;
   uint64_t rows_affected_ = 0;
+  common::ManagedPointer<optimizer::StatsStorage> stats_storage_ = nullptr;
+  // Shared with the commit actions that add them to stats_storage_
+  std::unordered_map<catalog::table_oid_t, std::shared_ptr<optimizer::TableStatsDelta>> stats_deltas_;
+  // The plan nodes whose rows the running query reports, owned by its ExecutableQuery
+  common::ManagedPointer<const std::vector<CardinalityProbe>> cardinality_probes_ = nullptr;
+  // The scan predicates of the running query, owned by its ExecutableQuery
+  common::ManagedPointer<const std::vector<std::unique_ptr<sql::VectorFilter>>> vector_filters_ = nullptr;
 };
 }  // namespace terrier::execution::exec
@@ -1,9 +1,11 @@
 #pragma once
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "common/managed_pointer.h"
 #include "execution/ast/context.h"
+#include "execution/exec/execution_context.h"
 
 namespace terrier::planner {
 class AbstractPlanNode;
@@ -11,10 +13,6 @@ class AbstractPlanNode;
 
 namespace terrier::execution {
 
-namespace exec {
-class ExecutionContext;
-}
-
 namespace vm {
 enum class ExecutionMode : uint8_t;
 class Module;
@@ -58,5 +56,11 @@ class ExecutableQuery {
   // together.
   std::unique_ptr<util::Region> region_;
   std::unique_ptr<ast::Context> ast_ctx_;
+
+  // Plan nodes whose rows the generated code reports, handed to the ExecutionContext of each run
+  std::vector<exec::CardinalityProbe> cardinality_probes_;
+
+  // Scan predicates the generated code evaluates a batch at a time, handed to the ExecutionContext of each run
+  std::vector<std::unique_ptr<sql::VectorFilter>> vector_filters_;
 };
 }  // namespace terrier::execution
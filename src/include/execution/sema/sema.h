@@ -118,7 +118,12 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinCall(ast::CallExpr *call);
   void CheckBuiltinMapCall(ast::CallExpr *call);
   void CheckBuiltinSqlConversionCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinInitSqlNull(ast::CallExpr *call);
+  void CheckBuiltinIsValNullCall(ast::CallExpr *call);
   void CheckBuiltinFilterCall(ast::CallExpr *call);
+  void CheckBuiltinFilterLikeCall(ast::CallExpr *call);
+  void CheckBuiltinFilterInListCall(ast::CallExpr *call);
+  void CheckBuiltinFilterVectorCall(ast::CallExpr *call);
   void CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinAggHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinAggPartIterCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -129,16 +134,22 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinJoinHashTableIterHasNext(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableIterGetRow(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableIterClose(ast::CallExpr *call);
+  void CheckBuiltinJoinHashTableEntryIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinJoinHashTableBloomFilter(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinJoinHashTableGetTupleCount(ast::CallExpr *call);
+  void CheckBuiltinJoinHashTableSpill(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinJoinHashTableFree(ast::CallExpr *call);
   void CheckBuiltinSorterInit(ast::CallExpr *call);
   void CheckBuiltinSorterInsert(ast::CallExpr *call);
   void CheckBuiltinSorterSort(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterFree(ast::CallExpr *call);
   void CheckBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinMergeJoinCursorCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinThreadStateContainerCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckMathTrigCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinLikeCall(ast::CallExpr *call);
   void CheckBuiltinSizeOfCall(ast::CallExpr *call);
   void CheckBuiltinPtrCastCall(ast::CallExpr *call);
   void CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include "execution/sql/generic_hash_table.h"
 #include "execution/sql/memory_pool.h"
 #include "execution/sql/projected_columns_iterator.h"
+#include "execution/sql/spill_file.h"
+#include "execution/sql/value.h"
 #include "execution/util/chunked_vector.h"
 
 namespace libcount {
@@ -19,7 +23,16 @@ class ThreadStateContainer;
 class AggregationOverflowPartitionIterator;
 
 /**
- * The hash table used when performing aggregations
+ * The hash table used when performing aggregations.
+ *
+ * Both serial and partitioned aggregations respect the memory budget.
+ * Partitioned aggregations (see @em InsertPartitioned()) spill their overflow
+ * partitions to disk. Serial aggregations spill all of their groups as partial
+ * aggregates once the table is over budget, and keep aggregating into an empty
+ * table; the partial aggregates are merged one partition at a time through
+ * @em NextSpilledPartition() when the table is scanned. Directly addressed
+ * (dense) tables never spill, since their size is bounded by the key range
+ * save for the rare keys that fall outside of it.
  */
 class EXPORT AggregationHashTable {
  public:
@@ -43,6 +56,17 @@ class EXPORT AggregationHashTable {
    */
   static constexpr uint32_t K_DEFAULT_HLL_PRECISION = 10;
 
+  /**
+   * The size of the write buffer used when spilling an overflow partition
+   */
+  static constexpr std::size_t K_SPILL_BUFFER_SIZE = 64 * 1024;
+
+  /**
+   * The number of groups a serial table creates between checks of the query's
+   * memory usage
+   */
+  static constexpr uint64_t K_QUERY_LIMIT_CHECK_INTERVAL = 1024;
+
   // -------------------------------------------------------
   // Callback functions to customize aggregations
   // -------------------------------------------------------
@@ -105,6 +129,11 @@ class EXPORT AggregationHashTable {
      * Number of flushes
      */
     uint64_t num_flushes_ = 0;
+
+    /**
+     * Number of times the overflow partitions were spilled to disk
+     */
+    uint64_t num_spills_ = 0;
   };
 
   // -------------------------------------------------------
@@ -141,6 +170,9 @@ class EXPORT AggregationHashTable {
 
   /**
    * Insert a new element with hash value @em hash into the aggregation table.
+   * If the table is over its memory budget, all of its groups are spilled
+   * first, so pointers to previously inserted or looked up payloads must not
+   * be held across this call.
    * @param hash The hash value of the element to insert
    * @return A pointer to a memory area where the element can be written to
    */
@@ -148,7 +180,8 @@ class EXPORT AggregationHashTable {
 
   /**
    * Insert a new element with hash value @em hash into this partitioned
-   * aggregation hash table.
+   * aggregation hash table. If the overflow partitions exceed the table's
+   * memory budget, they are spilled to disk.
    * @param hash The hash value of the element to insert
    * @return A pointer to a memory area where the input element can be written
    */
@@ -165,6 +198,39 @@ class EXPORT AggregationHashTable {
    */
   byte *Lookup(hash_t hash, KeyEqFn key_eq_fn, const void *probe_tuple);
 
+  /**
+   * Switch this table to direct addressing for a single integer grouping key whose non-NULL values
+   * mostly lie in the range [min_key, max_key]. Groups are then found by indexing an array with the
+   * key through LookupDense() and InsertDense(), without hashing or comparing keys. Keys outside of
+   * the range fall back to the hash index, with the key itself as the hash. The table must be
+   * empty, and must only be accessed through the dense methods afterwards. Iteration is unaffected.
+   * @param min_key The smallest key that is directly addressed
+   * @param max_key The largest key that is directly addressed
+   */
+  void SetDenseKeyRange(int64_t min_key, int64_t max_key);
+
+  /**
+   * @return True if groups are directly addressed by their key.
+   */
+  bool IsDense() const noexcept { return !dense_groups_.empty(); }
+
+  /**
+   * Lookup the group with the given key in a directly addressed table.
+   * @param key The grouping key. It may be NULL.
+   * @return A pointer to the group's payload; null if the group does not exist yet.
+   */
+  byte *LookupDense(const Integer &key) const {
+    if (UNLIKELY(!InDenseRange(key))) return LookupDenseOverflow(key.val_);
+    return dense_groups_[DenseSlot(key)];
+  }
+
+  /**
+   * Create the group with the given key in a directly addressed table. The group must not exist.
+   * @param key The grouping key. It may be NULL.
+   * @return A pointer to a memory area where the group's payload can be written to
+   */
+  byte *InsertDense(const Integer &key);
+
   /**
    * Process an entire vector of input.
    * @param iters The input vectors
@@ -177,6 +243,23 @@ class EXPORT AggregationHashTable {
   void ProcessBatch(ProjectedColumnsIterator *iters[], HashFn hash_fn, KeyEqFn key_eq_fn, InitAggFn init_agg_fn,
                     AdvanceAggFn advance_agg_fn);
 
+  /**
+   * Process an entire vector of input whose grouping keys are columns of the first input vector.
+   * The keys are hashed column-at-a-time (see ProjectedColumnsIterator::HashColumns()) rather than
+   * by calling a hash function on every tuple.
+   * @param iters The input vectors
+   * @param key_col_idxs The indexes of the grouping key columns in the first input vector
+   * @param key_col_types The types of the grouping key columns
+   * @param num_key_cols The number of grouping key columns
+   * @param key_eq_fn Function to determine key equality of an input element and
+   *                  an existing aggregate
+   * @param init_agg_fn Function to initialize a new aggregate
+   * @param advance_agg_fn Function to advance an existing aggregate
+   */
+  void ProcessBatch(ProjectedColumnsIterator *iters[], const uint32_t key_col_idxs[],
+                    const type::TypeId key_col_types[], uint32_t num_key_cols, KeyEqFn key_eq_fn,
+                    InitAggFn init_agg_fn, AdvanceAggFn advance_agg_fn);
+
   /**
    * Transfer all entries and overflow partitions stored in each thread-local
    * aggregation hash table (in the thread state container) into this table.
@@ -217,6 +300,47 @@ class EXPORT AggregationHashTable {
    */
   void ExecuteParallelPartitionedScan(void *query_state, ThreadStateContainer *thread_states, ScanPartitionFn scan_fn);
 
+  /**
+   * Merge the partial aggregates of the next spilled partition of a serial
+   * table into a table of their own, available through
+   * @em GetSpilledPartitionTable() until the next call. The first call also
+   * spills the groups still in memory, so that once all partitions have been
+   * returned, this table is empty. Tables that never spilled have no spilled
+   * partitions, and are scanned directly.
+   * @param query_state The (opaque) query state passed to the merge function.
+   * @param merge_partition_fn The function merging partial aggregates into a
+   *                           table.
+   * @return True if a partition was merged; false if all were.
+   */
+  bool NextSpilledPartition(void *query_state, MergePartitionFn merge_partition_fn);
+
+  /**
+   * @return The table holding the groups of the spilled partition merged by
+   *         the last call to @em NextSpilledPartition().
+   */
+  AggregationHashTable *GetSpilledPartitionTable() const noexcept { return spilled_partition_table_; }
+
+  /**
+   * Set the number of bytes the partial aggregates may occupy before they're
+   * spilled to disk. By default, this is the memory limit of the tracker
+   * attached to the table's memory pool, if any. Dense tables ignore the
+   * budget.
+   * @param memory_budget The budget in bytes; MemoryTracker::K_UNLIMITED to
+   *                      never spill.
+   */
+  void SetMemoryBudget(std::size_t memory_budget);
+
+  /**
+   * @return The number of bytes the partial aggregates may occupy before
+   *         they're spilled.
+   */
+  std::size_t GetMemoryBudget() const noexcept { return memory_budget_; }
+
+  /**
+   * Have any overflow partitions been spilled to disk?
+   */
+  bool HasSpilled() const noexcept { return !spilled_partitions_.empty(); }
+
   /**
    * How many aggregates are in this table?
    */
@@ -236,6 +360,41 @@ class EXPORT AggregationHashTable {
   // Grow the hash table
   void Grow();
 
+  // Whether the group with the given key is directly addressed
+  bool InDenseRange(const Integer &key) const {
+    // Unsigned arithmetic, so that keys far from the range do not overflow
+    return key.is_null_ || (key.val_ >= dense_min_key_ &&
+                            static_cast<uint64_t>(key.val_) - static_cast<uint64_t>(dense_min_key_) <
+                                dense_groups_.size() - 1);
+  }
+
+  // Compute the position of the group with the given key in the directly addressed groups
+  uint64_t DenseSlot(const Integer &key) const {
+    TERRIER_ASSERT(InDenseRange(key), "Key is not directly addressed");
+    // NULL keys take the last slot
+    if (key.is_null_) return dense_groups_.size() - 1;
+    return static_cast<uint64_t>(key.val_) - static_cast<uint64_t>(dense_min_key_);
+  }
+
+  // Find the group of a key outside of the dense key range in the hash index. Every group of a dense table is hashed
+  // by its key, and the NULL group by the smallest key, so a matching hash identifies the group.
+  byte *LookupDenseOverflow(int64_t key) const {
+    const auto hash = static_cast<hash_t>(key);
+    for (HashTableEntry *entry = hash_table_.FindChainHead(hash); entry != nullptr; entry = entry->next_) {
+      if (entry->hash_ == hash) return entry->payload_;
+    }
+    return nullptr;
+  }
+
+  // Allocate an entry and insert it into the hash index, without ever spilling
+  byte *InsertEntry(hash_t hash);
+
+  // Should a serial table spill its groups before the next insertion?
+  bool NeedsToSpillGroups() const;
+
+  // Move all groups of a serial table to the overflow partitions, and spill them
+  void SpillGroups();
+
   // Lookup a hash table entry internally
   HashTableEntry *LookupEntryInternal(hash_t hash, KeyEqFn key_eq_fn, const void *probe_tuple) const;
 
@@ -246,6 +405,21 @@ class EXPORT AggregationHashTable {
   // Allocate all overflow partition information if unallocated
   void AllocateOverflowPartitions();
 
+  // Should the overflow partitions be spilled before the next insertion?
+  bool NeedsToSpill() const;
+
+  // Write all overflow partitions to disk, releasing their memory
+  void SpillOverflowPartitions();
+
+  // Allocate the spilled partitions if unallocated
+  void AllocateSpilledPartitions();
+
+  // Does the overflow partition at the given index have any data?
+  bool IsPartitionNonEmpty(uint32_t partition_idx) const {
+    return partition_heads_[partition_idx] != nullptr ||
+           (HasSpilled() && spilled_partitions_[partition_idx].NumEntries() > 0);
+  }
+
   // Compute the hash value and perform the table lookup for all elements in the
   // input vector projections.
   template <bool PCIIsFiltered>
@@ -338,11 +512,32 @@ class EXPORT AggregationHashTable {
   // partition.
   uint64_t partition_shift_bits_;
 
+  // -------------------------------------------------------
+  // Spilled partitions
+  // -------------------------------------------------------
+
+  // The memory budget, and the corresponding maximum number of entries
+  std::size_t memory_budget_;
+  uint64_t spill_threshold_;
+  // The file this table spills to, and those taken over from other tables
+  std::unique_ptr<SpillFile> spill_file_;
+  std::vector<std::unique_ptr<SpillFile>> owned_spill_files_;
+  // The spilled portion of each overflow partition. Allocated on first spill.
+  std::vector<SpillPartition> spilled_partitions_;
+  // The next spilled partition a serial scan merges, and the table it merged last
+  uint32_t next_spilled_partition_;
+  AggregationHashTable *spilled_partition_table_;
+
   // Runtime stats.
   Stats stats_;
 
   // The maximum number of elements in the table before a resize.
   uint64_t max_fill_;
+
+  // The payloads of the directly addressed groups, indexed by key - dense_min_key_, with the NULL
+  // group last. Empty unless the table is dense.
+  int64_t dense_min_key_;
+  MemPoolVector<byte *> dense_groups_;
 };
 
 // ---------------------------------------------------------
@@ -412,7 +607,8 @@ class AggregationHashTableIterator {
  * An iterator over a range of overflow partition entries in an aggregation hash
  * table. The range is provided through the constructor. Each overflow entry's
  * hash value is accessible through @em GetHash(), along with the opaque payload
- * through @em GetPayload().
+ * through @em GetPayload(). If the partitions have been spilled, the entries
+ * read back from disk are produced after the in-memory ones.
  */
 class AggregationOverflowPartitionIterator {
  public:
@@ -420,9 +616,15 @@ class AggregationOverflowPartitionIterator {
    * Construct an iterator over the given partition range.
    * @param partitions_begin The beginning of the range.
    * @param partitions_end The end of the range.
-   */
-  AggregationOverflowPartitionIterator(HashTableEntry **partitions_begin, HashTableEntry **partitions_end)
-      : partitions_iter_(partitions_begin), partitions_end_(partitions_end), curr_(nullptr) {
+   * @param spilled A reader over the spilled entries of the range, if any.
+   */
+  AggregationOverflowPartitionIterator(HashTableEntry **partitions_begin, HashTableEntry **partitions_end,
+                                       SpillPartitionReader *spilled = nullptr)
+      : partitions_iter_(partitions_begin),
+        partitions_end_(partitions_end),
+        spilled_(spilled),
+        reading_spilled_(false),
+        curr_(nullptr) {
     Next();
   }
 
@@ -436,6 +638,12 @@ class AggregationOverflowPartitionIterator {
    * Move to the next overflow entry.
    */
   void Next() {
+    // Spilled entries are read back one at a time
+    if (reading_spilled_) {
+      curr_ = reinterpret_cast<const HashTableEntry *>(spilled_->Next());
+      return;
+    }
+
     // Try to move along current partition
     if (curr_ != nullptr) {
       curr_ = curr_->next_;
@@ -448,6 +656,12 @@ class AggregationOverflowPartitionIterator {
     while (curr_ == nullptr && partitions_iter_ != partitions_end_) {
       curr_ = *partitions_iter_++;
     }
+
+    // Move on to the spilled entries, if any
+    if (curr_ == nullptr && spilled_ != nullptr) {
+      reading_spilled_ = true;
+      curr_ = reinterpret_cast<const HashTableEntry *>(spilled_->Next());
+    }
   }
 
   /**
@@ -481,8 +695,11 @@ class AggregationOverflowPartitionIterator {
   HashTableEntry **partitions_iter_;
   // The ending position in the partitions array
   HashTableEntry **partitions_end_;
+  // The reader over spilled entries, and whether we're reading from it
+  SpillPartitionReader *spilled_;
+  bool reading_spilled_;
   // The current overflow entry
-  HashTableEntry *curr_;
+  const HashTableEntry *curr_;
 };
 
 }  // namespace terrier::execution::sql
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 
+#include "common/container/bitmap.h"
 #include "common/macros.h"
 #include "execution/sql/value.h"
 #include "execution/util/execution_common.h"
+#include "execution/util/vector_util.h"
 
 namespace terrier::execution::sql {
 
@@ -33,6 +36,19 @@ class CountAggregate {
    */
   void Advance(const Val &val) { count_ += static_cast<uint64_t>(!val.is_null_); }
 
+  /**
+   * Advance the count by the number of non-NULL values in the input (or selection) vector.
+   * @param values The input vector. Only the NULL-ness of its values matters.
+   * @param nulls The validity bitmap of the input vector. A set bit marks a non-NULL value.
+   * @param count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   */
+  template <typename T>
+  void AdvanceBatch(UNUSED_ATTRIBUTE const T *values, const common::RawBitmap *nulls, const uint32_t count,
+                    const uint32_t *sel) {
+    count_ += util::VectorUtil::CountNotNull(nulls, count, sel);
+  }
+
   /**
    * Merge this count with the @em that count.
    */
@@ -128,6 +144,23 @@ class IntegerSumAggregate {
     sum_ += val.val_;
   }
 
+  /**
+   * Advance the aggregate by all non-NULL values in the input (or selection) vector @em values.
+   * @param values The input vector.
+   * @param nulls The validity bitmap of the input vector. A set bit marks a non-NULL value.
+   * @param count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   */
+  template <typename T>
+  void AdvanceBatch(const T *values, const common::RawBitmap *nulls, const uint32_t count, const uint32_t *sel) {
+    int64_t partial;
+    if (util::VectorUtil::Reduce(values, nulls, count, sel, int64_t{0}, &partial, std::plus<int64_t>()) == 0) {
+      return;
+    }
+    null_ = false;
+    sum_ += partial;
+  }
+
   /**
    * Merge a partial sum aggregate into this aggregate.
    */
@@ -187,6 +220,23 @@ class RealSumAggregate {
     sum_ += val.val_;
   }
 
+  /**
+   * Advance the aggregate by all non-NULL values in the input (or selection) vector @em values.
+   * @param values The input vector.
+   * @param nulls The validity bitmap of the input vector. A set bit marks a non-NULL value.
+   * @param count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   */
+  template <typename T>
+  void AdvanceBatch(const T *values, const common::RawBitmap *nulls, const uint32_t count, const uint32_t *sel) {
+    double partial;
+    if (util::VectorUtil::Reduce(values, nulls, count, sel, double{0.0}, &partial, std::plus<double>()) == 0) {
+      return;
+    }
+    null_ = false;
+    sum_ += partial;
+  }
+
   /**
    * Merge a partial real-typed summation into this aggregate.
    */
@@ -250,6 +300,24 @@ class IntegerMaxAggregate {
     max_ = std::max(val.val_, max_);
   }
 
+  /**
+   * Advance the aggregate by all non-NULL values in the input (or selection) vector @em values.
+   * @param values The input vector.
+   * @param nulls The validity bitmap of the input vector. A set bit marks a non-NULL value.
+   * @param count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   */
+  template <typename T>
+  void AdvanceBatch(const T *values, const common::RawBitmap *nulls, const uint32_t count, const uint32_t *sel) {
+    int64_t partial;
+    auto max = [](int64_t a, int64_t b) { return std::max(a, b); };
+    if (util::VectorUtil::Reduce(values, nulls, count, sel, std::numeric_limits<int64_t>::min(), &partial, max) == 0) {
+      return;
+    }
+    max_ = null_ ? partial : std::max(partial, max_);
+    null_ = false;
+  }
+
   /**
    * Merge a partial max aggregate into this aggregate.
    */
@@ -309,6 +377,25 @@ class RealMaxAggregate {
     max_ = std::max(val.val_, max_);
   }
 
+  /**
+   * Advance the aggregate by all non-NULL values in the input (or selection) vector @em values.
+   * @param values The input vector.
+   * @param nulls The validity bitmap of the input vector. A set bit marks a non-NULL value.
+   * @param count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   */
+  template <typename T>
+  void AdvanceBatch(const T *values, const common::RawBitmap *nulls, const uint32_t count, const uint32_t *sel) {
+    double partial;
+    auto max = [](double a, double b) { return std::max(a, b); };
+    const double identity = std::numeric_limits<double>::lowest();
+    if (util::VectorUtil::Reduce(values, nulls, count, sel, identity, &partial, max) == 0) {
+      return;
+    }
+    max_ = null_ ? partial : std::max(partial, max_);
+    null_ = false;
+  }
+
   /**
    * Merge a partial real-typed max aggregate into this aggregate.
    */
@@ -372,6 +459,24 @@ class IntegerMinAggregate {
     min_ = std::min(val.val_, min_);
   }
 
+  /**
+   * Advance the aggregate by all non-NULL values in the input (or selection) vector @em values.
+   * @param values The input vector.
+   * @param nulls The validity bitmap of the input vector. A set bit marks a non-NULL value.
+   * @param count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   */
+  template <typename T>
+  void AdvanceBatch(const T *values, const common::RawBitmap *nulls, const uint32_t count, const uint32_t *sel) {
+    int64_t partial;
+    auto min = [](int64_t a, int64_t b) { return std::min(a, b); };
+    if (util::VectorUtil::Reduce(values, nulls, count, sel, std::numeric_limits<int64_t>::max(), &partial, min) == 0) {
+      return;
+    }
+    min_ = null_ ? partial : std::min(partial, min_);
+    null_ = false;
+  }
+
   /**
    * Merge a partial min aggregate into this aggregate.
    */
@@ -431,6 +536,24 @@ class RealMinAggregate {
     min_ = std::min(val.val_, min_);
   }
 
+  /**
+   * Advance the aggregate by all non-NULL values in the input (or selection) vector @em values.
+   * @param values The input vector.
+   * @param nulls The validity bitmap of the input vector. A set bit marks a non-NULL value.
+   * @param count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   */
+  template <typename T>
+  void AdvanceBatch(const T *values, const common::RawBitmap *nulls, const uint32_t count, const uint32_t *sel) {
+    double partial;
+    auto min = [](double a, double b) { return std::min(a, b); };
+    if (util::VectorUtil::Reduce(values, nulls, count, sel, std::numeric_limits<double>::max(), &partial, min) == 0) {
+      return;
+    }
+    min_ = null_ ? partial : std::min(partial, min_);
+    null_ = false;
+  }
+
   /**
    * Merge a partial real-typed min aggregate into this aggregate.
    */
@@ -495,6 +618,22 @@ class AvgAggregate {
     count_++;
   }
 
+  /**
+   * Advance the aggregate by all non-NULL values in the input (or selection) vector @em values.
+   * @param values The input vector.
+   * @param nulls The validity bitmap of the input vector. A set bit marks a non-NULL value.
+   * @param count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   */
+  template <typename T>
+  void AdvanceBatch(const T *values, const common::RawBitmap *nulls, const uint32_t count, const uint32_t *sel) {
+    double partial;
+    const uint32_t num_values =
+        util::VectorUtil::Reduce(values, nulls, count, sel, 0.0, &partial, std::plus<double>());
+    sum_ += partial;
+    count_ += num_values;
+  }
+
   /**
    * Merge a partial average aggregate into this aggregate.
    */
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/managed_pointer.h"
+#include "optimizer/statistics/table_stats.h"
+
+namespace terrier::planner {
+class AnalyzePlanNode;
+}  // namespace terrier::planner
+
+namespace terrier::catalog {
+class CatalogAccessor;
+class Schema;
+}  // namespace terrier::catalog
+
+namespace terrier::optimizer {
+class StatsStorage;
+}  // namespace terrier::optimizer
+
+namespace terrier::storage {
+class SqlTable;
+}  // namespace terrier::storage
+
+namespace terrier::transaction {
+class TransactionContext;
+}  // namespace terrier::transaction
+
+namespace terrier::execution::sql {
+
+/**
+ * Static utility class to execute ANALYZE plan nodes. Analyzing a table scans it once, with one task per range of
+ * blocks. Every row feeds a HyperLogLog sketch and a NULL count per column, and the numeric columns of a reservoir
+ * sample of K_SAMPLE_SIZE rows are kept alongside. The sketches and samples of the ranges are merged, and the
+ * histogram and the most common values of each numeric column are built from the merged sample and scaled up to the
+ * table size. Other columns only get a cardinality and a NULL fraction. The resulting TableStats replace whatever
+ * the StatsStorage held for the table.
+ */
+class AnalyzeExecutor {
+ public:
+  /**
+   * The number of rows sampled from a table
+   */
+  static constexpr uint32_t K_SAMPLE_SIZE = 30000;
+
+  /**
+   * The number of histogram bins built per column
+   */
+  static constexpr uint8_t K_HISTOGRAM_BINS = 64;
+
+  /**
+   * The number of most common values kept per column
+   */
+  static constexpr uint32_t K_NUM_COMMON_VALUES = 10;
+
+  AnalyzeExecutor() = delete;
+
+  /**
+   * @param node node to execute
+   * @param accessor accessor to use for execution
+   * @param txn transaction to scan the table in
+   * @param stats_storage storage to install the statistics into
+   * @return true if operation succeeded, false otherwise
+   */
+  static bool AnalyzeTableExecutor(common::ManagedPointer<planner::AnalyzePlanNode> node,
+                                   common::ManagedPointer<catalog::CatalogAccessor> accessor,
+                                   common::ManagedPointer<transaction::TransactionContext> txn,
+                                   common::ManagedPointer<optimizer::StatsStorage> stats_storage);
+
+  /**
+   * Compute the statistics of the given columns of a table, as visible to the transaction.
+   * @param txn transaction to scan the table in
+   * @param table table to analyze
+   * @param schema schema of the table
+   * @param database_oid database of the table
+   * @param table_oid oid of the table
+   * @param col_oids columns to analyze
+   * @return the statistics of the table
+   */
+  static optimizer::TableStats AnalyzeTable(common::ManagedPointer<transaction::TransactionContext> txn,
+                                            common::ManagedPointer<storage::SqlTable> table,
+                                            const catalog::Schema &schema, catalog::db_oid_t database_oid,
+                                            catalog::table_oid_t table_oid,
+                                            const std::vector<catalog::col_oid_t> &col_oids);
+};
+}  // namespace terrier::execution::sql
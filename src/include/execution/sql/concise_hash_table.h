@@ -68,7 +68,7 @@ class ConciseHashTable {
   /**
    * Set the size of the hash table to support at least @em num_elems entries.
    * The table will optimize itself in expectation of seeing at most @em
-   * num_elems elements without resizing.
+   * num_elems elements without resizing. Any existing contents are discarded.
    * @param num_elems The expected number of elements
    */
   void SetSize(uint32_t num_elems);
@@ -14,16 +14,49 @@ class ProjectedColumnsIterator;
 
 /**
  * An adaptive filter manager that tries to discover the optimal filter
- * configuration.
+ * configuration. A filter is a conjunction of clauses, each of which is run
+ * over the whole input vector in turn. The manager adapts the filter in two
+ * ways:
+ *  - Each clause comes in one or more flavors. A multi-armed bandit agent per
+ *    clause picks the flavor to run, based on the flavors' past execution times.
+ *  - The manager measures the selectivity of every clause and its cost per input
+ *    tuple as batches are filtered. Every K_REORDER_INTERVAL batches, it reorders
+ *    the clauses so that cheap, selective clauses run first and shrink the input
+ *    of the expensive ones. A clause that has not been measured yet is run first so
+ *    that it gets measured.
+ *
+ * The measured statistics are conditioned on the clauses that run before a clause,
+ * since it only sees the tuples they let through. They decay over time so that the
+ * order can follow changes in the data. A clause does not run on batches that the
+ * clauses before it emptied, so its statistics may go stale. Those of a clause that
+ * has not run for a whole reordering interval are dropped, and the clause is run
+ * first again to measure it afresh.
  */
 class EXPORT FilterManager {
  public:
+  /**
+   * The number of batches filtered between two reorderings of the clauses
+   */
+  static constexpr uint32_t K_REORDER_INTERVAL = 8;
+
+  /**
+   * The weight of the latest batch in the decaying averages of a clause's
+   * selectivity and cost
+   */
+  static constexpr double K_STATS_DECAY = 0.3;
+
   /**
    * A generic filtering function over an input projection. Returns the
    * number of tuples that pass the filter.
    */
   using MatchFn = uint32_t (*)(ProjectedColumnsIterator *);
 
+  /**
+   * A clock returning the current time in milliseconds. The manager times the
+   * clauses with it.
+   */
+  using ClockFn = double (*)();
+
   /**
    * A clause in a multi-clause filter. Clauses come in multiple flavors.
    * Flavors are logically equivalent, but may differ in implementation, and
@@ -44,8 +77,12 @@ class EXPORT FilterManager {
   /**
    * Construct the filter using the given adaptive policy
    * @param policy_kind
+   * @param clock The clock to time the clauses with, or nullptr for a steady
+   *              clock. Tests pass a clock that their clauses advance, so that
+   *              the measured costs are deterministic.
    */
-  explicit FilterManager(bandit::Policy::Kind policy_kind = bandit::Policy::Kind::EpsilonGreedy);
+  explicit FilterManager(bandit::Policy::Kind policy_kind = bandit::Policy::Kind::EpsilonGreedy,
+                         ClockFn clock = nullptr);
 
   /**
    * Destructor
@@ -87,7 +124,37 @@ class EXPORT FilterManager {
    */
   uint32_t GetOptimalFlavorForClause(uint32_t clause_index) const;
 
+  /**
+   * @return The indexes of the clauses in the order they are currently run
+   */
+  const std::vector<uint32_t> &GetClauseOrder() const { return optimal_clause_order_; }
+
+  /**
+   * @return The measured fraction of its input tuples that the clause at index
+   *         @em clause_index lets through
+   */
+  double GetClauseSelectivity(uint32_t clause_index) const { return clause_stats_[clause_index].selectivity_; }
+
  private:
+  // The measured behavior of a clause
+  struct ClauseStats {
+    // The fraction of input tuples passing the clause
+    double selectivity_{1.0};
+    // The execution time per input tuple, in nanoseconds
+    double cost_{0.0};
+    // Has the clause been measured yet?
+    bool sampled_{false};
+    // The number of batches filtered before the clause was last measured
+    uint64_t last_run_{0};
+  };
+
+  // Fold the measurements of one run of a clause into its statistics
+  void UpdateClauseStats(uint32_t clause_index, uint32_t num_input, uint32_t num_output, double exec_ms);
+
+  // Drop the statistics of the clauses that have not run since the last reordering,
+  // then reorder the clauses by their measured selectivity and cost
+  void ReorderClauses();
+
   // Run a specific clause of the filter
   void RunFilterClause(ProjectedColumnsIterator *pci, uint32_t clause_index);
 
@@ -108,8 +175,14 @@ class EXPORT FilterManager {
   std::vector<uint32_t> optimal_clause_order_;
   // The adaptive policy to use
   std::unique_ptr<bandit::Policy> policy_;
+  // The clock timing the clauses
+  ClockFn clock_;
   // The agents, one per clause
   std::vector<bandit::Agent> agents_;
+  // The measured statistics, one per clause
+  std::vector<ClauseStats> clause_stats_;
+  // The number of batches filtered so far
+  uint64_t num_runs_{0};
   // Has the manager's clauses been finalized?
   bool finalized_{false};
 };
@@ -10,6 +10,8 @@ class ExecutionContext;
 
 namespace terrier::execution::sql {
 
+class LikePattern;
+
 /**
  * Utility class to handle SQL string manipulations.
  */
@@ -37,6 +39,16 @@ class EXPORT StringFunctions {
    */
   static void Length(exec::ExecutionContext *ctx, Integer *result, const StringVal &str);
 
+  /**
+   * Check whether the string matches the SQL LIKE pattern, using a backslash as the escape character
+   */
+  static void Like(BoolVal *result, const StringVal &str, const StringVal &pattern);
+
+  /**
+   * Check whether the string matches the compiled SQL LIKE pattern
+   */
+  static void Like(BoolVal *result, const StringVal &str, const LikePattern &pattern);
+
   /**
    * Set the string to lower case
    */
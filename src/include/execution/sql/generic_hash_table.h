@@ -6,6 +6,7 @@
 #include "common/macros.h"
 #include "execution/sql/hash_table_entry.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/util/bit_util.h"
 #include "execution/util/execution_common.h"
 #include "execution/util/memory.h"
 
@@ -68,6 +69,41 @@ class GenericHashTable {
   template <bool Concurrent>
   void InsertTagged(HashTableEntry *new_entry, hash_t hash);
 
+  /**
+   * Split the directory into 2^@em num_bits equally-sized ranges of contiguous
+   * buckets, and return the index of the range the bucket for hash value
+   * @em hash falls into. Entries in different ranges never share a bucket, so
+   * ranges can be populated by different threads without synchronization using
+   * @em InsertRange().
+   * @param hash The hash value
+   * @param num_bits The log2 of the number of ranges. Must not exceed the log2
+   *                 of the table's capacity.
+   * @return The directory range of the hash value
+   */
+  uint64_t DirectoryRangeOf(hash_t hash, uint32_t num_bits) const noexcept {
+    TERRIER_ASSERT((uint64_t(1) << num_bits) <= Capacity(), "More directory ranges than buckets");
+    const auto capacity_bits =
+        static_cast<uint32_t>(sizeof(capacity_) * 8 - 1 - util::BitUtil::CountLeadingZeros(capacity_));
+    return (hash & mask_) >> (capacity_bits - num_bits);
+  }
+
+  /**
+   * Insert the @em num_entries entries in @em entries, ignoring tags, without
+   * synchronizing with any other thread. All entries must belong to the same
+   * directory range (see @em DirectoryRangeOf()), and no other thread may
+   * insert into that range concurrently. The element count is not updated; the
+   * caller must account for all entries through @em AddNumElements().
+   * @param entries The entries to insert
+   * @param num_entries The number of entries to insert
+   */
+  void InsertRange(HashTableEntry *const entries[], uint64_t num_entries) noexcept;
+
+  /**
+   * Account for @em num_elems elements inserted through @em InsertRange().
+   * @param num_elems The number of inserted elements
+   */
+  void AddNumElements(const uint64_t num_elems) noexcept { num_elems_ += num_elems; }
+
   /**
    * Explicitly set the size of the hash table to support at least @em new_size
    * elements with good performance.
@@ -254,6 +290,21 @@ inline void GenericHashTable::InsertTagged(HashTableEntry *new_entry, hash_t has
   num_elems_++;
 }
 
+inline void GenericHashTable::InsertRange(HashTableEntry *const entries[], const uint64_t num_entries) noexcept {
+  // The directory range is expected to be cache-resident, but the entries are
+  // scattered across memory. Prefetch the entries whose links we'll write.
+  for (uint64_t idx = 0, prefetch_idx = common::Constants::K_PREFETCH_DISTANCE; idx < num_entries;
+       idx++, prefetch_idx++) {
+    if (LIKELY(prefetch_idx < num_entries)) {
+      util::Prefetch<false, Locality::Low>(entries[prefetch_idx]);
+    }
+    HashTableEntry *entry = entries[idx];
+    std::atomic<HashTableEntry *> &loc = entries_[entry->hash_ & mask_];
+    entry->next_ = loc.load(std::memory_order_relaxed);
+    loc.store(entry, std::memory_order_relaxed);
+  }
+}
+
 template <typename F>
 inline void GenericHashTable::FlushEntries(const F &sink) {
   static_assert(std::is_invocable_v<F, HashTableEntry *>);
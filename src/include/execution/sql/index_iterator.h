@@ -5,6 +5,7 @@
 #include "catalog/catalog_defs.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/projected_columns_iterator.h"
+#include "storage/index/index.h"
 #include "storage/storage_defs.h"
 
 namespace terrier::execution::sql {
@@ -34,6 +35,14 @@ class EXPORT IndexIterator {
    */
   ~IndexIterator();
 
+  /**
+   * Make the scans of this iterator index-only. Range scans then collect the key of every value, which KeyPR returns.
+   */
+  void SetIndexOnly() {
+    TERRIER_ASSERT(index_->SupportsScanWithKeys(), "Range scans of this index cannot return their keys");
+    index_only_ = true;
+  }
+
   /**
    * Wrapper around the index's ScanKey
    */
@@ -59,6 +68,16 @@ class EXPORT IndexIterator {
    */
   void ScanLimitDescending(uint32_t limit);
 
+  /**
+   * Add the key range between the lower and upper bound PRs to the ranges of the next ScanRanges call
+   */
+  void AddRange();
+
+  /**
+   * Perform an ascending scan of all the added key ranges, and clear them
+   */
+  void ScanRanges();
+
   /**
    * Advances the iterator. Return true if successful
    * @return whether the iterator was advanced or not.
@@ -91,6 +110,17 @@ class EXPORT IndexIterator {
    */
   storage::TupleSlot CurrentSlot() { return tuples_[curr_index_ - 1]; }
 
+  /**
+   * Return the key of the current value, without reading the table.
+   * Requires SetIndexOnly to have been called before the scan.
+   * @return The projected row of the current key.
+   */
+  storage::ProjectedRow *KeyPR() {
+    // Every value found by an exact scan is stored under the searched key
+    if (key_rows_.empty()) return index_pr_;
+    return reinterpret_cast<storage::ProjectedRow *>(key_rows_.data() + (curr_index_ - 1) * index_->KeyRowSize());
+  }
+
  private:
   exec::ExecutionContext *exec_ctx_;
   std::vector<catalog::col_oid_t> col_oids_;
@@ -105,6 +135,11 @@ class EXPORT IndexIterator {
   storage::ProjectedRow *hi_index_pr_;
   storage::ProjectedRow *table_pr_;
   std::vector<storage::TupleSlot> tuples_{};
+  // Whether range scans collect the keys of their values in key_rows_
+  bool index_only_ = false;
+  std::vector<byte> key_rows_{};
+  // Copies of the lower and upper bounds of every range added since the last ScanRanges call
+  std::vector<byte> range_rows_{};
 };
 
 }  // namespace terrier::execution::sql
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -9,6 +10,7 @@
 #include "execution/sql/concise_hash_table.h"
 #include "execution/sql/generic_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace libcount {
@@ -21,13 +23,42 @@ class JoinHashTableTest;
 
 namespace terrier::execution::sql {
 
+class ProjectedColumnsIterator;
 class ThreadStateContainer;
 class JoinHashTableIterator;
+class JoinHashTableEntryIterator;
 
 /**
  * The main join hash table. Join hash tables are bulk-loaded through calls to
  * @em AllocInputTuple() and frozen after calling @em Build(). Thus, they're
  * write-once read-many (WORM) structures.
+ *
+ * Join hash tables operate as hybrid hash joins when given a memory budget.
+ * Build tuples are radix-partitioned on the high bits of their hash value. When
+ * the number of buffered tuples exceeds the budget, the largest partitions are
+ * evicted to a spill file and all subsequent build tuples that fall into them
+ * are written directly to disk. The table built by @em Build() only contains
+ * the partitions that remained in memory. Probe tuples that fall into a spilled
+ * partition (see @em IsPartitionSpilled()) must be handed to
+ * @em SpillProbeTuple() rather than looked up. Once the in-memory probe is
+ * complete, @em NextSpilledPartition() loads and builds the spilled partitions
+ * one at a time so that their spilled probe tuples can be joined using
+ * @em ReadSpilledProbeTuples().
+ *
+ * Join hash tables can optionally build a Bloom filter over the hash values of
+ * their in-memory build tuples (see @em EnableBloomFilter()). Probe pipelines
+ * use the filter through @em FilterProbeBatch() to discard tuples that cannot
+ * find a join partner before they are probed, so that selective joins avoid
+ * probing most of their probe input.
+ *
+ * After the probe, @em JoinHashTableEntryIterator visits every in-memory build
+ * tuple once. Outer, semi and anti joins use it to find the build tuples that
+ * never found a join partner.
+ *
+ * Thread-local tables are combined by @em MergeParallel() either by inserting
+ * all tuples concurrently into the shared directory, or by radix-partitioning
+ * the tuples on the directory range they fall into and building each range
+ * independently, without atomic operations (see @em MergeStrategy).
  */
 class EXPORT JoinHashTable {
  public:
@@ -36,6 +67,64 @@ class EXPORT JoinHashTable {
    */
   static constexpr uint32_t K_DEFAULT_HLL_PRECISION = 10;
 
+  /**
+   * The number of hash bits used to select a spill partition
+   */
+  static constexpr uint32_t K_SPILL_PARTITION_BITS = 6;
+
+  /**
+   * The number of spill partitions
+   */
+  static constexpr uint32_t K_NUM_SPILL_PARTITIONS = 1u << K_SPILL_PARTITION_BITS;
+
+  /**
+   * The size of the write buffer of each spilled partition
+   */
+  static constexpr std::size_t K_SPILL_BUFFER_SIZE = 32 * 1024;
+
+  /**
+   * The number of inserted tuples between checks of the query's memory usage
+   */
+  static constexpr uint64_t K_MEMORY_CHECK_INTERVAL = 4096;
+
+  /**
+   * The number of probe tuples run through the Bloom filter before deciding
+   * whether it filters enough to be worth applying
+   */
+  static constexpr uint64_t K_BLOOM_FILTER_SAMPLE_SIZE = 64 * 1024;
+
+  /**
+   * The fraction of sampled probe tuples that may pass the Bloom filter for it
+   * to remain in use
+   */
+  static constexpr double K_BLOOM_FILTER_MAX_PASS_RATE = 0.75;
+
+  /**
+   * Function computing the hash value of the join keys of the probe tuple the
+   * given iterator is currently positioned at
+   */
+  using ProbeHashFn = hash_t (*)(ProjectedColumnsIterator *);
+
+  /**
+   * The maximum number of hash bits used to partition tuples in a partitioned
+   * parallel merge
+   */
+  static constexpr uint32_t K_MAX_MERGE_PARTITION_BITS = 12;
+
+  /**
+   * How @em MergeParallel() builds the global table from thread-local tables
+   */
+  enum class MergeStrategy : uint8_t {
+    // Partitioned if the directory does not fit in the last-level cache, and
+    // concurrent otherwise
+    Adaptive,
+    // All threads insert into the shared directory using atomic operations
+    Concurrent,
+    // Tuples are radix-partitioned by the range of the directory they fall
+    // into, each of which is sized to fit in cache and built by one thread
+    Partitioned
+  };
+
   /**
    * Construct a join hash table. All memory allocations are sourced from the
    * injected @em memory, and thus, are ephemeral.
@@ -67,10 +156,109 @@ class EXPORT JoinHashTable {
 
   /**
    * Fully construct the join hash table. Nothing is done if the join hash table
-   * has already been built. After building, the table becomes read-only.
+   * has already been built. After building, the table becomes read-only. If the
+   * table has spilled, only the in-memory partitions are built.
    */
   void Build();
 
+  /**
+   * Set the number of bytes the buffered build tuples may occupy before
+   * partitions are spilled to disk. By default, this is the memory limit of the
+   * tracker attached to the table's memory pool, if any. Tables with a budget
+   * also spill when the query as a whole exceeds the limit of the tracker. Must
+   * be called before any tuples are inserted.
+   * @param memory_budget The budget in bytes; MemoryTracker::K_UNLIMITED to
+   *                      never spill.
+   */
+  void SetMemoryBudget(std::size_t memory_budget);
+
+  /**
+   * @return The number of bytes the buffered build tuples may occupy before
+   *         partitions are spilled.
+   */
+  std::size_t GetMemoryBudget() const noexcept { return memory_budget_; }
+
+  /**
+   * Have @em Build() (or @em MergeParallel()) also construct a Bloom filter over
+   * the hash values of all in-memory build tuples. Must be called before the
+   * table is built.
+   */
+  void EnableBloomFilter() noexcept { use_bloom_filter_ = true; }
+
+  /**
+   * Can a probe tuple whose hash value is @em hash find a match in this table?
+   * Tuples in spilled partitions always may. False positives are possible, but
+   * false negatives are not.
+   * @param hash The hash value of the probe tuple
+   * @return False if the tuple definitely has no match; true otherwise
+   */
+  bool MayContain(const hash_t hash) const {
+    return !bloom_filter_built_ || IsPartitionSpilled(hash) || bloom_filter_.Contains(hash);
+  }
+
+  /**
+   * Filter out all active tuples in @em pci that cannot find a match in this
+   * table according to its Bloom filter. The iterator is left in a filtered
+   * state, even if no tuple is removed, and the hashes of the remaining tuples
+   * are cached in it for the probe to read back (see
+   * @em ProjectedColumnsIterator::GetHash()). Hashes already cached in the
+   * iterator, e.g., by hashing the key columns, are used as they are rather
+   * than recomputed with @em hash_fn. If, after sampling the first
+   * K_BLOOM_FILTER_SAMPLE_SIZE probe tuples, the filter turns out to discard
+   * too few of them, it is no longer applied. This function is thread-safe.
+   * @param pci The probe-side vector of tuples
+   * @param hash_fn Function computing the join hash value of a probe tuple
+   * @return The number of tuples that remain selected
+   */
+  uint32_t FilterProbeBatch(ProjectedColumnsIterator *pci, ProbeHashFn hash_fn);
+
+  /**
+   * Copy the probe tuple @em probe_tuple whose hash value is @em hash into its
+   * spilled partition, to be joined after the in-memory probe completes. Must
+   * only be called for probe tuples in spilled partitions. This function is
+   * thread-safe.
+   * @param hash The hash value of the probe tuple
+   * @param probe_tuple The probe tuple
+   * @param probe_tuple_size The size of the probe tuple in bytes. All probe
+   *                         tuples must have the same size.
+   */
+  void SpillProbeTuple(hash_t hash, const void *probe_tuple, uint32_t probe_tuple_size);
+
+  /**
+   * Release the current spilled partition, and load and build the next spilled
+   * partition with a non-empty build and probe side. Must be called after all
+   * probe tuples have been processed. After the function returns true, the
+   * table only contains the build tuples of the loaded partition, and
+   * @em ReadSpilledProbeTuples() returns the probe tuples to join with them.
+   * @param include_unprobed Also load partitions that no probe tuple fell into,
+   *                         as joins that produce unmatched build tuples must.
+   * @return True if a partition was loaded; false if all partitions have been
+   *         processed.
+   */
+  bool NextSpilledPartition(bool include_unprobed = false);
+
+  /**
+   * @return A reader over the spilled probe tuples of the partition loaded by
+   *         the last call to @em NextSpilledPartition(). Each entry is laid out
+   *         as a HashTableEntry whose payload is the probe tuple.
+   */
+  SpillPartitionReader ReadSpilledProbeTuples() const;
+
+  /**
+   * Advance to the next spilled probe tuple of the partition loaded by the
+   * last call to @em NextSpilledPartition(). This is the cursor generated code
+   * reads the spilled probe tuples with; C++ callers may also use
+   * @em ReadSpilledProbeTuples().
+   * @return True if there is one; false if all of them have been read.
+   */
+  bool NextSpilledProbeTuple();
+
+  /**
+   * @return The probe tuple @em NextSpilledProbeTuple() advanced to. It is
+   *         valid until the next call to @em NextSpilledProbeTuple().
+   */
+  const byte *GetSpilledProbeTuple() const noexcept { return spilled_probe_tuple_; }
+
   /**
    * Lookup a single entry with hash value @em hash returning an iterator
    * @tparam UseCHT Should the lookup use the concise or general table
@@ -97,6 +285,12 @@ class EXPORT JoinHashTable {
    */
   void MergeParallel(const ThreadStateContainer *thread_state_container, uint32_t jht_offset);
 
+  /**
+   * Set the strategy @em MergeParallel() uses to build the global table.
+   * @param merge_strategy The strategy
+   */
+  void SetMergeStrategy(const MergeStrategy merge_strategy) noexcept { merge_strategy_ = merge_strategy; }
+
   // -------------------------------------------------------
   // Accessors
   // -------------------------------------------------------
@@ -121,10 +315,37 @@ class EXPORT JoinHashTable {
   uint64_t GetTotalMemoryUsage() const noexcept { return GetBufferedTupleMemoryUsage() + GetJoinIndexMemoryUsage(); }
 
   /**
-   * Return the total number of inserted elements, including duplicates
+   * Return the total number of in-memory elements, including duplicates
    */
   uint64_t NumElements() const noexcept { return entries_.size(); }
 
+  /**
+   * Return the total number of build tuples in spilled partitions
+   */
+  uint64_t NumSpilledElements() const noexcept;
+
+  /**
+   * Return the total number of build tuples, whether they are in memory or spilled
+   */
+  uint64_t GetTupleCount() const noexcept { return NumElements() + NumSpilledElements(); }
+
+  /**
+   * Have any partitions of this table been spilled to disk?
+   */
+  bool HasSpilled() const noexcept { return spilled_partitions_ != 0; }
+
+  /**
+   * Has the partition the hash value @em hash belongs to been spilled?
+   */
+  bool IsPartitionSpilled(const hash_t hash) const noexcept {
+    return (spilled_partitions_ & (uint64_t(1) << SpillPartitionOf(hash))) != 0;
+  }
+
+  /**
+   * Has a Bloom filter been built over the in-memory build tuples?
+   */
+  bool HasBloomFilter() const noexcept { return bloom_filter_built_; }
+
   /**
    * Has the hash table been built?
    */
@@ -137,6 +358,7 @@ class EXPORT JoinHashTable {
 
  private:
   friend class execution::sql::test::JoinHashTableTest;
+  friend class JoinHashTableEntryIterator;
 
   // Access a stored entry by index
   HashTableEntry *EntryAt(const uint64_t idx) noexcept { return reinterpret_cast<HashTableEntry *>(entries_[idx]); }
@@ -185,6 +407,34 @@ class EXPORT JoinHashTable {
   template <bool Prefetch, bool Concurrent>
   void MergeIncomplete(JoinHashTable *source);
 
+  // Merge all thread-local tables by radix-partitioning their tuples on the
+  // directory range they fall into, and building each range independently
+  void MergePartitioned(const std::vector<JoinHashTable *> &tl_join_tables);
+
+  // The spill partition the given hash value belongs to
+  static uint32_t SpillPartitionOf(const hash_t hash) noexcept {
+    return static_cast<uint32_t>(hash >> (sizeof(hash_t) * 8 - K_SPILL_PARTITION_BITS));
+  }
+
+  // Mark the largest in-memory partitions as spilled until at most
+  // @em max_resident buffered tuples remain, then evict them
+  void SpillPartitions(uint64_t max_resident);
+
+  // Move all buffered entries that belong to spilled partitions to disk
+  void EvictSpilledPartitions();
+
+  // The file to spill to, created on first use
+  SpillFile *GetSpillFile();
+
+  // Write out all buffered spilled build tuples
+  void FlushBuildPartitions();
+
+  // Take over the spilled partitions of all thread-local tables before merging
+  void MergeSpilledPartitions(const std::vector<JoinHashTable *> &tl_join_tables);
+
+  // Populate the Bloom filter with all in-memory build tuples, if enabled
+  void BuildBloomFilter();
+
  private:
   // The vector where we store the build-side input
   util::ChunkedVector<MemoryPoolAllocator<byte>> entries_;
@@ -203,6 +453,16 @@ class EXPORT JoinHashTable {
   // The bloom filter
   BloomFilter bloom_filter_;
 
+  // Should the bloom filter be built? Has it been?
+  bool use_bloom_filter_;
+  bool bloom_filter_built_;
+
+  // Is the bloom filter applied to probe batches? The number of probe tuples
+  // sampled so far, and how many of them passed the filter.
+  std::atomic<bool> bloom_filter_active_;
+  std::atomic<uint64_t> bloom_filter_num_probed_;
+  std::atomic<uint64_t> bloom_filter_num_passed_;
+
   // Estimator of unique elements
   std::unique_ptr<libcount::HLL> hll_estimator_;
 
@@ -211,6 +471,36 @@ class EXPORT JoinHashTable {
 
   // Should we use a concise hash table?
   bool use_concise_ht_;
+
+  // How to merge thread-local tables
+  MergeStrategy merge_strategy_;
+
+  // The memory pool
+  MemoryPool *memory_;
+
+  // The memory budget, and the corresponding maximum number of buffered tuples
+  std::size_t memory_budget_;
+  uint64_t spill_threshold_;
+
+  // Bit-mask of the partitions that have been spilled
+  uint64_t spilled_partitions_;
+
+  // The file this table spills to, and those taken over from merged tables
+  std::unique_ptr<SpillFile> spill_file_;
+  std::vector<std::unique_ptr<SpillFile>> owned_spill_files_;
+
+  // The spilled build and probe tuples of each partition. Allocated on demand.
+  std::vector<SpillPartition> build_partitions_;
+  common::SpinLatch probe_partitions_latch_;
+  std::vector<SpillPartition> probe_partitions_;
+
+  // The next spilled partition to load. The one before it is currently loaded.
+  uint32_t next_spilled_partition_;
+
+  // The reader over the spilled probe tuples of the loaded partition, and the
+  // one it returned last
+  std::unique_ptr<SpillPartitionReader> spilled_probe_reader_;
+  const byte *spilled_probe_tuple_;
 };
 
 /**
@@ -254,6 +544,59 @@ class EXPORT JoinHashTableIterator {
   hash_t hash_;
 };
 
+/**
+ * An iterator over all in-memory build tuples of a join hash table, including
+ * those taken over from thread-local tables, in no particular order. Build
+ * tuples in spilled partitions are not visited.
+ */
+class EXPORT JoinHashTableEntryIterator {
+ public:
+  /**
+   * Construct an iterator positioned at the first build tuple of @em table
+   * @param table The table to iterate over
+   */
+  explicit JoinHashTableEntryIterator(JoinHashTable *table) : table_(table), entries_(&table->entries_) {
+    SkipExhaustedEntries();
+  }
+
+  /**
+   * Is there a build tuple at the current position?
+   */
+  bool HasNext() const noexcept { return entries_ != nullptr; }
+
+  /**
+   * Advance to the next build tuple
+   */
+  void Next() noexcept {
+    idx_++;
+    SkipExhaustedEntries();
+  }
+
+  /**
+   * Return the build tuple at the current position
+   */
+  byte *GetRow() const noexcept { return reinterpret_cast<HashTableEntry *>((*entries_)[idx_])->payload_; }
+
+ private:
+  // Move on to the next non-empty vector of entries once the current one is
+  // exhausted
+  void SkipExhaustedEntries() noexcept {
+    while (entries_ != nullptr && idx_ == entries_->size()) {
+      entries_ = owned_idx_ < table_->owned_.size() ? &table_->owned_[owned_idx_++] : nullptr;
+      idx_ = 0;
+    }
+  }
+
+  // The table being iterated
+  JoinHashTable *table_;
+  // The vector of entries being iterated, or null once all have been
+  decltype(JoinHashTable::entries_) *entries_;
+  // The index of the next owned vector of entries
+  std::size_t owned_idx_{0};
+  // The position in the current vector of entries
+  std::size_t idx_{0};
+};
+
 // ---------------------------------------------------------
 // JoinHashTable implementation
 // ---------------------------------------------------------
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "common/container/bitmap.h"
+#include "common/macros.h"
+#include "execution/util/execution_common.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::execution::sql {
+
+/**
+ * A compiled SQL LIKE pattern. In a pattern, '%' matches any sequence of zero or more characters,
+ * '_' matches any single character, and the escape character makes the character following it
+ * match itself. Compiling a pattern classifies it by shape so that the common cases are matched by
+ * specialized routines rather than a general matcher:
+ *  - "abc": exact match. Strings of a different length are rejected without reading them.
+ *  - "abc%": prefix match. Prefixes of up to four bytes are checked against the prefix inlined in
+ *    every VarlenEntry, never touching out-of-line string contents.
+ *  - "%abc": suffix match.
+ *  - "%abc%": substring search. Uses a SIMD first/last-byte filter where available.
+ *  - Anything else: a bit-parallel (Shift-And) NFA with one state per non-'%' pattern character.
+ *    Patterns with more than 64 such characters fall back to a backtracking matcher.
+ *
+ * Patterns are compiled once per query and applied to whole vectors of strings through
+ * FilterVector(), so the shape dispatch is hoisted out of the per-string loop.
+ */
+class EXPORT LikePattern {
+ public:
+  /**
+   * The default escape character, as in Postgres.
+   */
+  static constexpr char K_DEFAULT_ESCAPE = '\\';
+
+  /**
+   * The shape of a pattern.
+   */
+  enum class Kind : uint8_t { Exact, Prefix, Suffix, Contains, General };
+
+  /**
+   * Compile the given pattern.
+   * @param pattern The LIKE pattern.
+   * @param escape The escape character.
+   * @throws std::runtime_error if the pattern ends with an unescaped escape character.
+   */
+  explicit LikePattern(std::string_view pattern, char escape = K_DEFAULT_ESCAPE);
+
+  /**
+   * @return The shape of this pattern.
+   */
+  Kind GetKind() const noexcept { return kind_; }
+
+  /**
+   * @return True if the string @em str matches this pattern.
+   */
+  bool Matches(std::string_view str) const;
+
+  /**
+   * @return True if the string stored in @em str matches this pattern.
+   */
+  bool Matches(const storage::VarlenEntry &str) const;
+
+  /**
+   * Match all strings in the input (or selection) vector against this pattern, and write the
+   * indexes of the strings that match (or that do not match, if @em negated) into @em out. NULL
+   * strings never pass. The output vector may alias the selection vector.
+   * @param input The input vector of strings.
+   * @param null_bitmap The validity bitmap of the input vector. A set bit marks a non-NULL string.
+   * @param in_count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   * @param[out] out The vector storing the indexes of the selected elements.
+   * @param negated If true, select the strings that do not match.
+   * @return The number of selected elements.
+   */
+  uint32_t FilterVector(const storage::VarlenEntry *input, const common::RawBitmap *null_bitmap, uint32_t in_count,
+                        const uint32_t *sel, uint32_t *out, bool negated) const;
+
+  /**
+   * Match the string @em str against the uncompiled pattern @em pattern. This does not allocate
+   * and is intended for one-off matches; compile the pattern when matching many strings.
+   * @param str The string to match.
+   * @param pattern The LIKE pattern.
+   * @param escape The escape character.
+   * @return True if the string matches the pattern.
+   * @throws std::runtime_error if the pattern ends with an unescaped escape character.
+   */
+  static bool Match(std::string_view str, std::string_view pattern, char escape = K_DEFAULT_ESCAPE);
+
+ private:
+  // Type-specialized matchers
+  bool MatchExact(const storage::VarlenEntry &str) const;
+  bool MatchPrefix(const storage::VarlenEntry &str) const;
+  bool MatchSuffix(std::string_view str) const;
+  bool MatchContains(std::string_view str) const;
+  bool MatchGeneral(std::string_view str) const;
+
+  // Run the matcher over a vector
+  template <typename Matcher>
+  uint32_t FilterVectorImpl(const storage::VarlenEntry *input, const common::RawBitmap *null_bitmap,
+                            uint32_t in_count, const uint32_t *sel, uint32_t *out, bool negated,
+                            const Matcher &matcher) const;
+
+ private:
+  // The original pattern and escape character, used by the fallback matcher
+  std::string pattern_;
+  char escape_;
+  // The shape of the pattern
+  Kind kind_;
+  // The unescaped literal of exact, prefix, suffix and substring patterns
+  std::string literal_;
+  // The NFA of general patterns. Bit i of char_masks_[c] is set if state i accepts character c.
+  // Bit i of loop_mask_ is set if a '%' follows the i-th pattern character.
+  std::array<uint64_t, 256> char_masks_;
+  uint64_t loop_mask_;
+  uint64_t accept_mask_;
+  bool leading_wildcard_;
+  bool use_nfa_;
+};
+
+}  // namespace terrier::execution::sql
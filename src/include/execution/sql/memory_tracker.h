@@ -2,17 +2,106 @@
 
 #include <tbb/enumerable_thread_specific.h>
 
+#include <atomic>
+#include <cstdint>
+
+#include "common/macros.h"
+
 namespace terrier::execution::sql {
 
 /**
- * TODO: track memory usage
+ * A memory tracker tracks the number of bytes allocated by all memory pools
+ * of a query. Each thread accumulates its allocations into a thread-local
+ * counter to avoid contention; the total is computed on demand. Counters are
+ * atomic since the total is read while other threads allocate, but all
+ * accesses are relaxed: the total is only a snapshot. A tracker may
+ * optionally carry a memory limit (i.e., a budget). Operators that can trade
+ * memory for disk I/O (e.g., sorters and hash tables) consult the limit to
+ * decide when to spill their contents to secondary storage.
  */
-class MemoryTracker {
+class EXPORT MemoryTracker {
  public:
-  // TODO(pmenon): Fill me in
+  /**
+   * Value of the memory limit when no limit is imposed.
+   */
+  static constexpr std::size_t K_UNLIMITED = 0;
+
+  /**
+   * Create a tracker with the given limit.
+   * @param memory_limit The maximum number of bytes the query should consume.
+   */
+  explicit MemoryTracker(std::size_t memory_limit = K_UNLIMITED) : memory_limit_(memory_limit) {}
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(MemoryTracker);
+
+  /**
+   * Reset all tracked allocation statistics.
+   */
+  void Reset() {
+    for (auto &stats : stats_) {
+      stats.allocated_bytes_.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @return The total number of bytes allocated through this tracker across all threads.
+   */
+  std::size_t GetAllocatedSize() const {
+    int64_t total = 0;
+    for (const auto &stats : stats_) {
+      total += stats.allocated_bytes_.load(std::memory_order_relaxed);
+    }
+    return total < 0 ? 0 : static_cast<std::size_t>(total);
+  }
+
+  /**
+   * Record an allocation of @em size bytes.
+   * @param size The number of allocated bytes.
+   */
+  void Increment(const std::size_t size) {
+    stats_.local().allocated_bytes_.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+  }
+
+  /**
+   * Record a deallocation of @em size bytes. Memory may be released by a thread other than the one
+   * that allocated it, so individual thread-local counters may go negative.
+   * @param size The number of released bytes.
+   */
+  void Decrement(const std::size_t size) {
+    stats_.local().allocated_bytes_.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+  }
+
+  /**
+   * @return The memory limit, in bytes. K_UNLIMITED if no limit is imposed.
+   */
+  std::size_t GetMemoryLimit() const { return memory_limit_.load(std::memory_order_relaxed); }
+
+  /**
+   * Set the memory limit.
+   * @param memory_limit The new memory limit in bytes; K_UNLIMITED to remove the limit.
+   */
+  void SetMemoryLimit(const std::size_t memory_limit) { memory_limit_ = memory_limit; }
+
+  /**
+   * @return True if a memory limit is set and the total allocated size exceeds it.
+   */
+  bool IsOverLimit() const {
+    const std::size_t limit = GetMemoryLimit();
+    return limit != K_UNLIMITED && GetAllocatedSize() > limit;
+  }
+
  private:
-  struct Stats {};
+  struct Stats {
+    std::atomic<int64_t> allocated_bytes_{0};
+  };
+
+  // Per-thread allocation statistics
   tbb::enumerable_thread_specific<Stats> stats_;
+  // The memory limit
+  std::atomic<std::size_t> memory_limit_;
 };
 
 }  // namespace terrier::execution::sql
@@ -1,15 +1,26 @@
 #pragma once
 
+#include <cstring>
 #include <limits>
 #include <type_traits>
+#include <vector>
 #include "storage/projected_columns.h"
+#include "storage/storage_defs.h"
 
 #include "common/macros.h"
 #include "execution/util/bit_util.h"
 #include "execution/util/execution_common.h"
 #include "type/type_id.h"
 
+namespace terrier::storage {
+class ArrowVarlenColumn;
+}  // namespace terrier::storage
+
 namespace terrier::execution::sql {
+
+class LikePattern;
+class VectorFilter;
+
 /**
  * An iterator over projections. A ProjectedColumnsIterator allows both
  * tuple-at-a-time iteration over a vector projection and vector-at-a-time
@@ -166,10 +177,28 @@ class EXPORT ProjectedColumnsIterator {
      * an int64_t filter value
      */
     int64_t bi_;
+    /**
+     * a date filter value, in its storage representation
+     */
+    uint32_t date_;
+    /**
+     * a timestamp filter value
+     */
+    uint64_t ts_;
+    /**
+     * a decimal filter value
+     */
+    double dec_;
+    /**
+     * a string filter value. The string's contents must outlive the filter.
+     */
+    storage::VarlenEntry str_;
   };
 
   /**
-   * Creates a filter value according to the given type.
+   * Creates a filter value according to the given type from the immediate operand of the PCI filter bytecodes.
+   * DECIMAL values are passed as the bits of the double, and VARCHAR values as the address of a VarlenEntry that
+   * outlives the filter.
    * @param val filter value
    * @param type type of the value
    * @return filter val of the given type
@@ -184,6 +213,17 @@ class EXPORT ProjectedColumnsIterator {
         return FilterVal{.i_ = static_cast<int32_t>(val)};
       case type::TypeId::BIGINT:
         return FilterVal{.bi_ = static_cast<int64_t>(val)};
+      case type::TypeId::DATE:
+        return FilterVal{.date_ = static_cast<uint32_t>(val)};
+      case type::TypeId::TIMESTAMP:
+        return FilterVal{.ts_ = static_cast<uint64_t>(val)};
+      case type::TypeId::DECIMAL: {
+        double dec;
+        std::memcpy(&dec, &val, sizeof(dec));
+        return FilterVal{.dec_ = dec};
+      }
+      case type::TypeId::VARCHAR:
+        return FilterVal{.str_ = *reinterpret_cast<const storage::VarlenEntry *>(static_cast<intptr_t>(val))};
       default:
         throw std::runtime_error("Filter not supported on type");
     }
@@ -213,11 +253,143 @@ class EXPORT ProjectedColumnsIterator {
   template <template <typename> typename Op>
   uint32_t FilterColByCol(uint32_t col_idx_1, type::TypeId type_1, uint32_t col_idx_2, type::TypeId type_2);
 
+  /**
+   * Filter the string column at index @em col_idx by the LIKE pattern @em pattern.
+   * @param col_idx The index of the column in the projection to filter.
+   * @param pattern The compiled pattern.
+   * @param negated If true, select the strings that do not match the pattern (i.e., NOT LIKE).
+   * @return The number of selected elements.
+   */
+  uint32_t FilterColByLike(uint32_t col_idx, const LikePattern &pattern, bool negated = false);
+
+  /**
+   * Filter the string column at index @em col_idx, selecting the strings equal to any of the given values (i.e., IN).
+   * @param col_idx The index of the column in the projection to filter.
+   * @param values The values to select.
+   * @param num_values The number of values.
+   * @return The number of selected elements.
+   */
+  uint32_t FilterColByInList(uint32_t col_idx, const storage::VarlenEntry values[], uint32_t num_values);
+
+  /**
+   * Filter the projection by a predicate evaluated a batch at a time, selecting the tuples for which it is TRUE.
+   * @param filter The predicate and the columns it reads.
+   * @return The number of selected elements.
+   */
+  uint32_t FilterByVectorFilter(const VectorFilter &filter);
+
+  // -------------------------------------------------------
+  // Dictionary-compressed columns
+  // -------------------------------------------------------
+
+  /**
+   * Attach the dictionary codes of the string column at index @em col_idx to the current projection. The codes remain
+   * attached until the iterator is reset to a new projection. String filters and hashing on the column then evaluate
+   * each distinct dictionary word once and apply the result to the tuples through their codes, whenever the
+   * dictionary has no more words than there are selected tuples. TableVectorIterator attaches the codes of every
+   * string column whose vector comes from a single dictionary-compressed frozen block.
+   * @param col_idx The index of the column in the projection.
+   * @param codes The dictionary code of every tuple in the projection, indexed by position in the projection. Must
+   *              outlive the projection.
+   * @param dictionary The dictionary the codes index into. @see storage::DataTable::ReadDictionaryCodes
+   */
+  void SetDictionaryCodes(uint32_t col_idx, const uint32_t *codes, const storage::ArrowVarlenColumn *dictionary);
+
+  /**
+   * @return True if dictionary codes are attached to the column at index @em col_idx.
+   */
+  bool HasDictionaryCodes(uint32_t col_idx) const {
+    return col_idx < dictionaries_.size() && dictionaries_[col_idx].codes_ != nullptr;
+  }
+
+  /**
+   * @return The dictionary code of the column at index @em col_idx for the tuple the iterator is currently positioned
+   *         at. Equal codes denote equal strings within the current projection.
+   */
+  uint32_t GetDictionaryCode(uint32_t col_idx) const {
+    TERRIER_ASSERT(HasDictionaryCodes(col_idx), "Column has no dictionary codes");
+    return dictionaries_[col_idx].codes_[curr_idx_];
+  }
+
+  // -------------------------------------------------------
+  // Hashing
+  // -------------------------------------------------------
+
+  /**
+   * Hash the given key columns of every selected tuple and cache the hashes in this iterator. Each
+   * column is hashed in one tight loop: fixed-width values with CRC and strings with xxHash3. The
+   * hashes of a tuple's columns are combined in the order the columns are given, and NULLs hash to
+   * zero, so the result is the same as @hash() over the same values.
+   * @param col_idxs The indexes of the key columns in the projection.
+   * @param col_types The types of the key columns.
+   * @param num_cols The number of key columns.
+   */
+  void HashColumns(const uint32_t col_idxs[], const type::TypeId col_types[], uint32_t num_cols);
+
+  /**
+   * Hash one key column of every selected tuple into the cached hashes, the way HashColumns() hashes each of its
+   * columns. Generated code calls this once per key column, in key order, before iterating over the tuples.
+   * @param col_idx The index of the key column in the projection.
+   * @param col_type The type of the key column.
+   * @param combine Whether to combine the column's hashes with the cached ones, for every key column but the first.
+   *                Otherwise, hashing starts over from the seed @hash() starts from.
+   */
+  void HashColumn(uint32_t col_idx, type::TypeId col_type, bool combine);
+
+  /**
+   * Hash every selected tuple with the given function and cache the hashes in this iterator.
+   * @tparam F The type of the hash function. It takes no arguments and hashes the tuple the
+   *           iterator is currently positioned at.
+   * @param hash_fn The hash function.
+   */
+  template <typename F>
+  void CacheHashes(const F &hash_fn);
+
+  /**
+   * Cached hashes remain valid until the iterator is reset to a new projection. Filtering the
+   * projection afterwards does not affect the hashes of the tuples that remain selected.
+   * @return True if the hashes of the selected tuples have been cached.
+   */
+  bool HasHashes() const { return hashes_valid_; }
+
+  /**
+   * @return The cached hash of the tuple the iterator is currently positioned at.
+   */
+  hash_t GetHash() const {
+    TERRIER_ASSERT(hashes_valid_, "Hashes have not been computed");
+    return hashes_[curr_idx_];
+  }
+
   /**
    * Return the number of selected tuples after any filters have been applied
    */
   uint32_t NumSelected() const { return num_selected_; }
 
+  /**
+   * @return The projection being iterated over.
+   */
+  storage::ProjectedColumns *GetProjectedColumn() const { return projected_column_; }
+
+  /**
+   * @return The selection vector, or NULL if the projection has not been filtered.
+   */
+  const uint32_t *GetSelectionVector() const { return IsFiltered() ? selection_vector_ : nullptr; }
+
+  /**
+   * Invoke @em fn once on the whole of a numeric column, passing the column's values in their
+   * storage type, its NULL bitmap, and the selected tuples, i.e., fn(values, nulls, NumSelected(),
+   * GetSelectionVector()). This lets batch operations, like aggregations, run over the column in
+   * one tight loop rather than one tuple at a time.
+   * @tparam F The type of the function. It must be invocable with a values array of every numeric
+   *           storage type.
+   * @param col_idx The index of the column in the projection.
+   * @param type The type of the column.
+   * @param fn The function to invoke.
+   * @throws std::runtime_error if the column is not numeric.
+   */
+  template <typename F>
+  void VisitNumericColumn(uint32_t col_idx, type::TypeId type, const F &fn) const;
+
  private:
   // Filter a column by a constant value
   template <typename T, template <typename> typename Op>
@@ -227,6 +399,47 @@ class EXPORT ProjectedColumnsIterator {
   template <typename T, template <typename> typename Op>
   uint32_t FilterColByColImpl(uint32_t col_idx_1, uint32_t col_idx_2);
 
+  // Filter a date column by a constant date
+  template <template <typename> typename Op>
+  uint32_t FilterDateColByValImpl(uint32_t col_idx, uint32_t val);
+
+  // Filter a date column by a second date column
+  template <template <typename> typename Op>
+  uint32_t FilterDateColByColImpl(uint32_t col_idx_1, uint32_t col_idx_2);
+
+  // Remove the tuples whose value in the given column is NULL from the selection. The fixed-width filters compare
+  // every value, including the (undefined) values of NULLs, and then mask out the NULLs with this.
+  void DeselectNulls(uint32_t col_idx);
+
+  // Filter a string column by a constant string
+  template <template <typename> typename Op>
+  uint32_t FilterVarlenColByValImpl(uint32_t col_idx, const storage::VarlenEntry &val);
+
+  // Filter a string column by a second string column
+  template <template <typename> typename Op>
+  uint32_t FilterVarlenColByColImpl(uint32_t col_idx_1, uint32_t col_idx_2);
+
+  // Combine the hashes of a fixed-width column into the cached hashes
+  template <typename T>
+  void HashColumnImpl(uint32_t col_idx);
+
+  // Combine the hashes of a string column into the cached hashes
+  void HashVarlenColumnImpl(uint32_t col_idx);
+
+  // The dictionary codes of a string column
+  struct DictionaryCodes {
+    const uint32_t *codes_{nullptr};
+    const storage::ArrowVarlenColumn *dictionary_{nullptr};
+  };
+
+  // Return the dictionary codes of the given column if working on the dictionary is no more work than working on the
+  // selected tuples, or NULL otherwise
+  const DictionaryCodes *ChooseDictionary(uint32_t col_idx) const;
+
+  // Filter a string column by evaluating the predicate once per dictionary word
+  template <typename P>
+  uint32_t FilterByDictionary(uint32_t col_idx, const DictionaryCodes &dict, const P &pred);
+
  private:
   // The selection vector used to filter the ProjectedColumns
   alignas(common::Constants::CACHELINE_SIZE) uint32_t selection_vector_[common::Constants::K_DEFAULT_VECTOR_SIZE];
@@ -245,6 +458,19 @@ class EXPORT ProjectedColumnsIterator {
 
   // The next slot in the selection vector to write into
   uint32_t selection_vector_write_idx_{0};
+
+  // The cached hashes of the selected tuples, indexed by their position in the projection
+  alignas(common::Constants::CACHELINE_SIZE) hash_t hashes_[common::Constants::K_DEFAULT_VECTOR_SIZE];
+
+  // Are the cached hashes valid for the current projection?
+  bool hashes_valid_{false};
+
+  // The dictionary codes attached to the current projection, indexed by column
+  std::vector<DictionaryCodes> dictionaries_;
+
+  // Scratch space for the result of evaluating a filter or hash on every word of a dictionary
+  std::vector<uint8_t> dictionary_matches_;
+  std::vector<hash_t> dictionary_hashes_;
 };
 
 // ---------------------------------------------------------
@@ -307,6 +533,33 @@ inline void ProjectedColumnsIterator::ResetFiltered() {
   selection_vector_write_idx_ = 0;
 }
 
+template <typename F>
+inline void ProjectedColumnsIterator::VisitNumericColumn(const uint32_t col_idx, const type::TypeId type,
+                                                         const F &fn) const {
+  const auto col = static_cast<uint16_t>(col_idx);
+  const byte *values = projected_column_->ColumnStart(col);
+  const common::RawBitmap *nulls = projected_column_->ColumnNullBitmap(col);
+  switch (type) {
+    case type::TypeId::TINYINT:
+      fn(reinterpret_cast<const int8_t *>(values), nulls, NumSelected(), GetSelectionVector());
+      break;
+    case type::TypeId::SMALLINT:
+      fn(reinterpret_cast<const int16_t *>(values), nulls, NumSelected(), GetSelectionVector());
+      break;
+    case type::TypeId::INTEGER:
+      fn(reinterpret_cast<const int32_t *>(values), nulls, NumSelected(), GetSelectionVector());
+      break;
+    case type::TypeId::BIGINT:
+      fn(reinterpret_cast<const int64_t *>(values), nulls, NumSelected(), GetSelectionVector());
+      break;
+    case type::TypeId::DECIMAL:
+      fn(reinterpret_cast<const double *>(values), nulls, NumSelected(), GetSelectionVector());
+      break;
+    default:
+      throw std::runtime_error("Batch operation not supported on type");
+  }
+}
+
 template <typename F>
 inline void ProjectedColumnsIterator::ForEach(const F &fn) {
   // Ensure function conforms to expected form
@@ -325,6 +578,13 @@ inline void ProjectedColumnsIterator::ForEach(const F &fn) {
   Reset();
 }
 
+template <typename F>
+inline void ProjectedColumnsIterator::CacheHashes(const F &hash_fn) {
+  static_assert(std::is_invocable_r_v<hash_t, F>, "Hash function must be a no-arg function returning a hash_t");
+  ForEach([&] { hashes_[curr_idx_] = hash_fn(); });
+  hashes_valid_ = true;
+}
+
 template <typename F>
 inline void ProjectedColumnsIterator::RunFilter(const F &filter) {
   // Ensure filter function conforms to expected form
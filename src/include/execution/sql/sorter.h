@@ -1,17 +1,31 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/macros.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace terrier::execution::sql {
 
+class SortedRunMerger;
 class ThreadStateContainer;
 
 /**
- * Sorters
+ * Sorters.
+ *
+ * A sorter buffers fixed-size tuples in memory until sorted. A sorter can optionally be given a
+ * memory budget. When the tuples buffered in memory exceed the budget, they are sorted into a
+ * "run" and spilled to a temporary file as a contiguous array of tuples. When the sorter is
+ * finally sorted, the remaining in-memory tuples form the last run, and all runs are merged in a
+ * streaming fashion while iterating with a SorterIterator. If there are more runs than can be
+ * merged at once within the budget, runs are first merged into larger runs on disk.
+ *
+ * Spilled tuples are copied byte-for-byte. Any out-of-line data they reference (e.g., varlens)
+ * must remain alive until iteration completes.
  */
 class EXPORT Sorter {
  public:
@@ -29,6 +43,26 @@ class EXPORT Sorter {
    */
   Sorter(MemoryPool *memory, ComparisonFunction cmp_fn, uint32_t tuple_size);
 
+  /**
+   * The size of the read buffer used for each run when merging spilled runs.
+   */
+  static constexpr std::size_t K_MERGE_BUFFER_SIZE = 256 * common::Constants::KB;
+
+  /**
+   * The smallest fan-in we permit during an external merge, regardless of the memory budget.
+   */
+  static constexpr uint32_t K_MIN_MERGE_FAN_IN = 2;
+
+  /**
+   * The largest fan-in we permit during an external merge.
+   */
+  static constexpr uint32_t K_MAX_MERGE_FAN_IN = 256;
+
+  /**
+   * The number of tuples between two checks of the query-wide memory limit while tuples are inserted.
+   */
+  static constexpr uint64_t K_QUERY_LIMIT_CHECK_INTERVAL = 1024;
+
   /**
    * Destructor
    */
@@ -92,16 +126,78 @@ class EXPORT Sorter {
   void SortTopKParallel(const ThreadStateContainer *thread_state_container, uint32_t sorter_offset, uint64_t top_k);
 
   /**
-   * Return the number of tuples currently in this sorter
+   * Set the memory budget of this sorter. Once the tuples buffered in memory exceed the budget,
+   * they are sorted and spilled to disk as a run. This must be called before any tuples are
+   * inserted. By default, the budget is the memory limit of the tracker attached to the sorter's
+   * memory pool, if any. The thread-local sorters of a parallel sort share that tracker, so a sorter
+   * also spills once the whole query is over the tracker's limit.
+   * @param memory_budget The memory budget in bytes; MemoryTracker::K_UNLIMITED for no budget.
+   */
+  void SetMemoryBudget(std::size_t memory_budget);
+
+  /**
+   * @return The memory budget of this sorter in bytes.
    */
-  uint64_t NumTuples() const { return tuples_.size(); }
+  std::size_t GetMemoryBudget() const { return memory_budget_; }
+
+  /**
+   * Return the number of tuples currently in this sorter, both in memory and spilled to disk
+   */
+  uint64_t NumTuples() const { return tuples_.size() + num_spilled_tuples_; }
 
   /**
    * Has this sorter's contents been sorted?
    */
   bool IsSorted() const { return sorted_; }
 
+  /**
+   * Has this sorter spilled any of its contents to disk?
+   */
+  bool HasSpilled() const { return !runs_.empty(); }
+
+  /**
+   * Return the number of runs spilled to disk
+   */
+  uint32_t NumSpilledRuns() const { return static_cast<uint32_t>(runs_.size()); }
+
  private:
+  // A sorted run of tuples stored contiguously in a spill file
+  struct SpilledRun {
+    const SpillFile *file_;
+    uint64_t offset_;
+    uint64_t num_tuples_;
+  };
+
+  // Buffered writer of a single run
+  class RunWriter;
+
+  // Allocate a tuple without checking the memory budget
+  byte *AllocInputTupleInternal();
+
+  // Is the query this sorter belongs to over its memory limit? Only checked every
+  // K_QUERY_LIMIT_CHECK_INTERVAL tuples.
+  bool QueryOverLimit() const;
+
+  // Sort the in-memory tuples, write them out as a new run and release their memory
+  void SpillRun();
+
+  // Write the given sorted run of tuples to the spill file
+  void WriteRun(const byte *const *begin, const byte *const *end);
+
+  // Return the file new runs are appended to, creating it if needed
+  SpillFile *CurrentSpillFile();
+
+  // Complete a parallel sort when some thread-local sorters have spilled
+  void SortParallelExternal(const std::vector<Sorter *> &tl_sorters);
+
+  // Merge spilled runs into larger runs until they can all be merged at once
+  void ReduceRuns();
+
+  // The maximum number of runs that can be merged at once within the budget
+  uint32_t MergeFanIn() const;
+
+  // Create a merger over all spilled runs and the in-memory tuples
+  std::unique_ptr<SortedRunMerger> CreateMerger();
   // Build a max heap from the tuples currently stored in the sorter instance
   void BuildHeap();
 
@@ -111,6 +207,7 @@ class EXPORT Sorter {
 
  private:
   friend class SorterIterator;
+  friend class MergeJoinCursor;
 
   // Vector of entries
   util::ChunkedVector<MemoryPoolAllocator<byte>> tuple_storage_;
@@ -126,6 +223,105 @@ class EXPORT Sorter {
 
   // Flag indicating if the contents of the sorter have been sorted
   bool sorted_;
+
+  // The memory pool
+  MemoryPool *memory_;
+
+  // The size of each tuple
+  uint32_t tuple_size_;
+
+  // The memory budget, and the number of in-memory tuples that trigger a spill
+  std::size_t memory_budget_;
+  uint64_t spill_threshold_;
+
+  // The files holding spilled runs. Thread-local sorters transfer their files
+  // to the main sorter during a parallel sort.
+  std::vector<std::unique_ptr<SpillFile>> spill_files_;
+
+  // All spilled runs
+  std::vector<SpilledRun> runs_;
+
+  // The total number of tuples in all spilled runs
+  uint64_t num_spilled_tuples_;
+};
+
+/**
+ * A streaming K-way merge over a set of sorted runs, some of which may reside on disk. Disk-based
+ * runs are read in large blocks, with the next block requested from the operating system before
+ * the current block is consumed.
+ */
+class EXPORT SortedRunMerger {
+ public:
+  /**
+   * A sorted input to the merge.
+   */
+  class Source;
+
+  /**
+   * Create an empty merger.
+   * @param memory The memory pool to allocate read buffers from.
+   * @param cmp_fn The comparison function used to order tuples.
+   * @param tuple_size The size of each tuple in bytes.
+   */
+  SortedRunMerger(MemoryPool *memory, Sorter::ComparisonFunction cmp_fn, uint32_t tuple_size);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(SortedRunMerger);
+
+  /**
+   * Destructor.
+   */
+  ~SortedRunMerger();
+
+  /**
+   * Add a run stored in a spill file.
+   * @param file The file the run is stored in.
+   * @param offset The offset of the first tuple in the run.
+   * @param num_tuples The number of tuples in the run.
+   * @param buffer_size The size of the read buffer to use for the run.
+   */
+  void AddRun(const SpillFile *file, uint64_t offset, uint64_t num_tuples, std::size_t buffer_size);
+
+  /**
+   * Add an in-memory run given as a sorted array of tuple pointers.
+   * @param begin The first tuple in the run.
+   * @param end One past the last tuple in the run.
+   */
+  void AddRun(const byte *const *begin, const byte *const *end);
+
+  /**
+   * Prepare the merge. Must be called after all runs have been added, and before iterating.
+   */
+  void Init();
+
+  /**
+   * @return True if there are more tuples in the merge.
+   */
+  bool HasNext() const { return !heap_.empty(); }
+
+  /**
+   * @return The current smallest tuple. Valid until the next call to Next().
+   */
+  const byte *GetRow() const;
+
+  /**
+   * Advance to the next tuple in the merge.
+   */
+  void Next();
+
+ private:
+  // Restore the heap property starting from the root
+  void SiftDown();
+
+ private:
+  MemoryPool *memory_;
+  Sorter::ComparisonFunction cmp_fn_;
+  uint32_t tuple_size_;
+  std::vector<std::unique_ptr<Source>> sources_;
+  // A min-heap of non-exhausted sources, ordered by their current tuple
+  std::vector<Source *> heap_;
 };
 
 /**
@@ -142,20 +338,34 @@ class EXPORT SorterIterator {
    * Constructor
    * @param sorter sorter to iterate over
    */
-  explicit SorterIterator(Sorter *sorter) noexcept : iter_(sorter->tuples_.begin()), end_(sorter->tuples_.end()) {}
+  explicit SorterIterator(Sorter *sorter);
+
+  /**
+   * Destructor
+   */
+  ~SorterIterator();
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(SorterIterator);
 
   /**
    * Dereference operator
    * @return A pointer to the current iteration row
    */
-  const byte *operator*() const noexcept { return *iter_; }
+  const byte *operator*() const noexcept { return merger_ == nullptr ? *iter_ : merger_->GetRow(); }
 
   /**
    * Pre-increment the iterator
    * @return A reference to this iterator after it's been advanced one row
    */
-  SorterIterator &operator++() noexcept {
-    ++iter_;
+  SorterIterator &operator++() {
+    if (merger_ == nullptr) {
+      ++iter_;
+    } else {
+      merger_->Next();
+    }
     return *this;
   }
 
@@ -163,7 +373,7 @@ class EXPORT SorterIterator {
    * Does this iterate have more data
    * @return True if the iterator has more data; false otherwise
    */
-  bool HasNext() const { return iter_ != end_; }
+  bool HasNext() const { return merger_ == nullptr ? iter_ != end_ : merger_->HasNext(); }
 
   /**
    * Advance the iterator
@@ -175,7 +385,7 @@ class EXPORT SorterIterator {
    * iterator is valid.
    */
   const byte *GetRow() const {
-    TERRIER_ASSERT(iter_ != end_, "Invalid iterator");
+    TERRIER_ASSERT(HasNext(), "Invalid iterator");
     return this->operator*();
   }
 
@@ -193,6 +403,91 @@ class EXPORT SorterIterator {
   IteratorType iter_;
   // The ending iterator position
   const IteratorType end_;
+  // The merger over all runs, if the sorter has spilled to disk
+  std::unique_ptr<SortedRunMerger> merger_;
+};
+
+/**
+ * A cursor over the sorted tuples of the left input of a merge join. The right input arrives sorted on the join keys,
+ * so the cursor only ever moves forward. The tuples whose keys equal those of the current right tuple are copied into
+ * a run, because the following right tuples may have the same keys and must be joined with them again.
+ */
+class EXPORT MergeJoinCursor {
+ public:
+  /**
+   * Constructor
+   * @param sorter The sorted left input
+   */
+  explicit MergeJoinCursor(Sorter *sorter);
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(MergeJoinCursor);
+
+  /**
+   * @return True if there are tuples past the run; false otherwise
+   */
+  bool HasNext() const { return iter_.HasNext(); }
+
+  /**
+   * Skip the current tuple
+   */
+  void Next() { iter_.Next(); }
+
+  /**
+   * @return A pointer to the current tuple
+   */
+  const byte *GetRow() const { return iter_.GetRow(); }
+
+  /**
+   * Copy the current tuple to the end of the run, and move to the next tuple
+   */
+  void AddToRun() {
+    const byte *row = iter_.GetRow();
+    run_.insert(run_.end(), row, row + tuple_size_);
+    iter_.Next();
+  }
+
+  /**
+   * Empty the run
+   */
+  void ClearRun() {
+    run_.clear();
+    run_pos_ = 0;
+  }
+
+  /**
+   * Start iterating over the tuples of the run
+   */
+  void RunInit() { run_pos_ = 0; }
+
+  /**
+   * @return True if the run iteration has more tuples; false otherwise
+   */
+  bool RunHasNext() const { return run_pos_ < run_.size(); }
+
+  /**
+   * Advance the run iteration
+   */
+  void RunNext() { run_pos_ += tuple_size_; }
+
+  /**
+   * @return A pointer to the current tuple of the run iteration
+   */
+  const byte *RunGetRow() const {
+    TERRIER_ASSERT(RunHasNext(), "Invalid run iterator");
+    return run_.data() + run_pos_;
+  }
+
+ private:
+  // The iterator over the tuples past the run
+  SorterIterator iter_;
+  // The size of each tuple
+  uint32_t tuple_size_;
+  // The copied tuples of the run, and the offset of the current tuple of the run iteration
+  MemPoolVector<byte> run_;
+  std::size_t run_pos_;
 };
 
 }  // namespace terrier::execution::sql
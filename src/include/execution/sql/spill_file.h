@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+#include "execution/sql/memory_pool.h"
+#include "execution/util/execution_common.h"
+
+namespace terrier::execution::sql {
+
+/**
+ * A SpillFile is an anonymous, append-only temporary file used by operators to spill intermediate
+ * state (e.g., sorted runs or hash table partitions) to secondary storage when their memory budget
+ * is exhausted. The file is unlinked immediately after creation so that it is reclaimed by the
+ * operating system when closed, even if the process crashes. Writes are always appended to the end
+ * of the file; reads are positional and may be issued at arbitrary offsets, allowing multiple
+ * readers to stream different regions of the same file concurrently.
+ */
+class EXPORT SpillFile {
+ public:
+  /**
+   * Create a new temporary spill file in the given directory.
+   * @param directory The directory to create the file in.
+   * @throws std::runtime_error if the file could not be created.
+   */
+  explicit SpillFile(const std::string &directory = DefaultDirectory());
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /**
+   * Destructor. Closes the file, releasing its storage.
+   */
+  ~SpillFile();
+
+  /**
+   * Append @em size bytes from @em data to the end of the file.
+   * @param data The data to write.
+   * @param size The number of bytes to write.
+   * @return The offset in the file the data was written to.
+   */
+  uint64_t Append(const void *data, std::size_t size);
+
+  /**
+   * Read @em size bytes starting at offset @em offset into @em dest.
+   * @param offset The position in the file to read from.
+   * @param dest The buffer to read into.
+   * @param size The number of bytes to read.
+   * @throws std::runtime_error if fewer than @em size bytes could be read.
+   */
+  void Read(uint64_t offset, void *dest, std::size_t size) const;
+
+  /**
+   * Hint to the operating system that the range [offset, offset+size) will be read soon, so that it
+   * may begin reading it in asynchronously.
+   * @param offset The start of the range.
+   * @param size The size of the range in bytes.
+   */
+  void WillNeed(uint64_t offset, std::size_t size) const;
+
+  /**
+   * @return The number of bytes written to this file.
+   */
+  uint64_t Size() const noexcept { return size_; }
+
+  /**
+   * @return The directory spill files are created in by default. This is the value of the TMPDIR
+   *         environment variable, if set, and "/tmp" otherwise.
+   */
+  static std::string DefaultDirectory();
+
+ private:
+  // The file descriptor
+  int fd_;
+  // The number of bytes written so far
+  uint64_t size_;
+};
+
+/**
+ * A SpillPartition is a sequence of fixed-size entries that is written out to one or more spill
+ * files in fixed-size chunks. Entries are staged in an in-memory buffer that is written out in a
+ * single sequential write when it fills up. Partitions are used by operators that hash-partition
+ * their input (e.g., hybrid hash joins and spilling aggregations) to send the contents of a
+ * partition to secondary storage and later stream them back with a SpillPartitionReader.
+ *
+ * Partitions are not thread-safe; callers must provide their own synchronization if a partition is
+ * shared between threads.
+ */
+class EXPORT SpillPartition {
+ public:
+  /**
+   * Create an empty partition. No memory is allocated until the first entry is appended.
+   * @param memory The memory pool to allocate the staging buffer from.
+   * @param entry_size The size of each entry in bytes.
+   * @param buffer_size The (approximate) size of the staging buffer in bytes.
+   */
+  SpillPartition(MemoryPool *memory, uint32_t entry_size, std::size_t buffer_size);
+
+  /**
+   * Allocate space for a new entry at the end of the partition. The returned pointer is valid until
+   * the next call to Append() or Flush(); the caller must write the entry before then. If the
+   * staging buffer is full it is first written out to @em file.
+   * @param file The file to write the staging buffer to, if full.
+   * @return A pointer to the space for the new entry.
+   */
+  byte *Append(SpillFile *file);
+
+  /**
+   * Append a copy of the @em entry_size bytes in @em entry to the end of the partition.
+   * @param file The file to write the staging buffer to, if full.
+   * @param entry The entry to copy.
+   */
+  void Append(SpillFile *file, const byte *entry);
+
+  /**
+   * Write out all buffered entries to @em file, and release the staging buffer.
+   * @param file The file to write to.
+   */
+  void Flush(SpillFile *file);
+
+  /**
+   * Move all flushed entries from @em other to the end of this partition. Both partitions must have
+   * the same entry size, and @em other must have been flushed. The files @em other wrote its
+   * entries to must outlive this partition.
+   * @param other The partition to take entries from.
+   */
+  void Adopt(SpillPartition *other);
+
+  /**
+   * Forget all entries in the partition and release its memory. The data is not removed from the
+   * underlying files.
+   */
+  void Clear();
+
+  /**
+   * @return The total number of entries in this partition, both buffered and written out.
+   */
+  uint64_t NumEntries() const noexcept { return num_flushed_ + num_buffered_; }
+
+  /**
+   * @return The size of each entry in bytes.
+   */
+  uint32_t GetEntrySize() const noexcept { return entry_size_; }
+
+ private:
+  friend class SpillPartitionReader;
+
+  // Write out the staging buffer, if non-empty, keeping the buffer for reuse
+  void WriteBuffer(SpillFile *file);
+
+  // A contiguous sequence of entries in a spill file
+  struct Chunk {
+    const SpillFile *file_;
+    uint64_t offset_;
+    uint32_t num_entries_;
+  };
+
+  // The memory pool
+  MemoryPool *memory_;
+  // The size of each entry
+  uint32_t entry_size_;
+  // The maximum number of entries in the staging buffer
+  uint32_t buffer_capacity_;
+  // The staging buffer
+  MemPoolVector<byte> buffer_;
+  // The number of entries in the staging buffer
+  uint32_t num_buffered_;
+  // The chunks written out so far
+  std::vector<Chunk> chunks_;
+  // The number of entries in all chunks
+  uint64_t num_flushed_;
+};
+
+/**
+ * An iterator over the entries of a flushed SpillPartition. Chunks are read back one at a time into
+ * a single buffer, and the operating system is asked to read ahead the following chunk while the
+ * current one is being consumed.
+ */
+class EXPORT SpillPartitionReader {
+ public:
+  /**
+   * Create a reader over all entries in @em partition, which must have been flushed.
+   * @param partition The partition to read.
+   */
+  explicit SpillPartitionReader(const SpillPartition *partition);
+
+  /**
+   * @return The next entry in the partition, or NULL if all entries have been read. The returned
+   *         pointer is valid until the next call to Next().
+   */
+  const byte *Next();
+
+ private:
+  // Read in the chunk at the given index
+  void LoadChunk(std::size_t idx);
+
+ private:
+  // The partition
+  const SpillPartition *partition_;
+  // The buffer chunks are read into
+  MemPoolVector<byte> buffer_;
+  // The index of the next chunk to read
+  std::size_t next_chunk_;
+  // The current position and the end of the loaded chunk
+  const byte *pos_;
+  const byte *end_;
+};
+
+}  // namespace terrier::execution::sql
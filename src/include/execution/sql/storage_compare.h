@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "storage/storage_defs.h"
+
+namespace terrier::execution::sql {
+
+/**
+ * Comparisons of SQL values in their storage representation, shared by the vectorized filters and
+ * expression kernels.
+ */
+class StorageCompare {
+ public:
+  /**
+   * Dates are stored as a packed date::year_month_day (a 16-bit signed year, followed by an 8-bit
+   * month and an 8-bit day) whose raw integer value does not sort chronologically. Rearrange the
+   * fields into a signed 32-bit key that does, so that dates can be compared as integers.
+   * @param date The date in its storage representation.
+   * @return A key that orders dates chronologically.
+   */
+  static int32_t DateSortKey(const uint32_t date) {
+    const auto year = static_cast<int16_t>(date & 0xFFFFu);
+    const uint32_t month = (date >> 16u) & 0xFFu;
+    const uint32_t day = date >> 24u;
+    return static_cast<int32_t>(year) * 65536 + static_cast<int32_t>((month << 8u) | day);
+  }
+
+  /**
+   * String equality. The lengths and inlined prefixes reject most mismatches without touching the
+   * out-of-line contents of either string.
+   * @return True if the two strings are equal.
+   */
+  static bool VarlenEqual(const storage::VarlenEntry &lhs, const storage::VarlenEntry &rhs) {
+    const uint32_t size = lhs.Size();
+    if (size != rhs.Size()) return false;
+    const uint32_t prefix_len = std::min(size, K_PREFIX_SIZE);
+    if (VarlenPrefixWord(lhs, prefix_len) != VarlenPrefixWord(rhs, prefix_len)) return false;
+    return size <= K_PREFIX_SIZE ||
+           std::memcmp(lhs.Content() + K_PREFIX_SIZE, rhs.Content() + K_PREFIX_SIZE, size - K_PREFIX_SIZE) == 0;
+  }
+
+  /**
+   * Three-way string comparison. Strings whose prefixes differ are ordered by the prefixes alone.
+   * @return A negative value, zero, or a positive value if @em lhs is less than, equal to, or
+   *         greater than @em rhs, respectively.
+   */
+  static int32_t VarlenCompare(const storage::VarlenEntry &lhs, const storage::VarlenEntry &rhs) {
+    const uint32_t min_size = std::min(lhs.Size(), rhs.Size());
+    const uint32_t prefix_len = std::min(min_size, K_PREFIX_SIZE);
+    const uint32_t lhs_prefix = VarlenPrefixWord(lhs, prefix_len), rhs_prefix = VarlenPrefixWord(rhs, prefix_len);
+    if (lhs_prefix != rhs_prefix) {
+      return lhs_prefix < rhs_prefix ? -1 : 1;
+    }
+    if (min_size > K_PREFIX_SIZE) {
+      const int32_t result =
+          std::memcmp(lhs.Content() + K_PREFIX_SIZE, rhs.Content() + K_PREFIX_SIZE, min_size - K_PREFIX_SIZE);
+      if (result != 0) return result;
+    }
+    return lhs.Size() < rhs.Size() ? -1 : static_cast<int32_t>(lhs.Size() > rhs.Size());
+  }
+
+  /**
+   * Apply the comparison operator Op (e.g., std::less) to two strings.
+   * @return The result of the comparison.
+   */
+  template <template <typename> typename Op>
+  static bool VarlenCompareWith(const storage::VarlenEntry &lhs, const storage::VarlenEntry &rhs) {
+    if constexpr (std::is_same_v<Op<int32_t>, std::equal_to<int32_t>>) {
+      return VarlenEqual(lhs, rhs);
+    } else if constexpr (std::is_same_v<Op<int32_t>, std::not_equal_to<int32_t>>) {
+      return !VarlenEqual(lhs, rhs);
+    } else {
+      return Op<int32_t>()(VarlenCompare(lhs, rhs), 0);
+    }
+  }
+
+ private:
+  // The number of leading bytes of every string stored inline in its VarlenEntry
+  static constexpr uint32_t K_PREFIX_SIZE = storage::VarlenEntry::PrefixSize();
+
+  // Load the first min(len, 4) bytes of the string's inlined prefix as a big-endian word. Unsigned
+  // comparison of two such words agrees with a bytewise comparison of the prefixes.
+  static uint32_t VarlenPrefixWord(const storage::VarlenEntry &str, const uint32_t len) {
+    uint32_t word;
+    std::memcpy(&word, str.Prefix(), sizeof(word));
+    return __builtin_bswap32(word) & static_cast<uint32_t>(~uint64_t{0} << (32u - 8u * len));
+  }
+};
+
+}  // namespace terrier::execution::sql
@@ -5,6 +5,10 @@
 #include "execution/exec/execution_context.h"
 #include "execution/util/execution_common.h"
 
+namespace terrier::optimizer {
+class ColumnSummary;
+}  // namespace terrier::optimizer
+
 namespace terrier::execution::sql {
 
 /**
@@ -122,5 +126,38 @@ class EXPORT StorageInterface {
    * Current index being accessed.
    */
   common::ManagedPointer<storage::index::Index> curr_index_{nullptr};
+
+ private:
+  /**
+   * A written column whose values are summarized for the table statistics.
+   */
+  struct StatsColumn {
+    /**
+     * Index of the column in the table PR.
+     */
+    uint16_t pr_index_;
+    /**
+     * Type of the column.
+     */
+    type::TypeId type_;
+    /**
+     * Summary of the values written to the column.
+     */
+    optimizer::ColumnSummary *summary_;
+  };
+
+  /**
+   * Add the values of the table PR to the column summaries.
+   */
+  void RecordStats();
+
+  /**
+   * Summary of this query's writes to the table, or nullptr if no statistics are maintained.
+   */
+  optimizer::TableStatsDelta *stats_delta_;
+  /**
+   * Columns of the table PR whose values are summarized.
+   */
+  std::vector<StatsColumn> stats_columns_;
 };
 }  // namespace terrier::execution::sql
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "common/macros.h"
+#include "execution/util/execution_common.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::execution::sql {
+
+/**
+ * The constant strings of an IN list, e.g. the strings in (s IN ('a', 'b')). The list owns the contents of its
+ * strings, and exposes them as VarlenEntry values for ProjectedColumnsIterator::FilterColByInList. Lists are built
+ * once per query, when the bytecode referencing them is generated.
+ */
+class EXPORT StringInList {
+ public:
+  /**
+   * Copy the given strings into a new list.
+   * @param values The strings of the list.
+   */
+  explicit StringInList(const std::vector<std::string_view> &values);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(StringInList);
+
+  /**
+   * @return The strings of the list.
+   */
+  const storage::VarlenEntry *GetValues() const noexcept { return values_.data(); }
+
+  /**
+   * @return The number of strings in the list.
+   */
+  uint32_t GetNumValues() const noexcept { return static_cast<uint32_t>(values_.size()); }
+
+ private:
+  // The contents of all strings, back to back. Entries of strings too long to inline point into it.
+  std::unique_ptr<byte[]> contents_;
+  std::vector<storage::VarlenEntry> values_;
+};
+
+}  // namespace terrier::execution::sql
@@ -47,6 +47,41 @@ class EXPORT TableVectorIterator {
    */
   bool Init();
 
+  /**
+   * Restrict the values of a column to those with zone map keys in [min_key, max_key], so that blocks
+   * holding no such values can be skipped. This only prunes whole blocks; tuples read from the blocks
+   * that are not skipped must still be filtered. Must be called after Init().
+   * @param col_oid oid of the column
+   * @param min_key smallest admissible key. @see storage::ZoneMap
+   * @param max_key largest admissible key
+   */
+  void AddRangeFilter(uint32_t col_oid, int64_t min_key, int64_t max_key);
+
+  /**
+   * Only read the given columns (the ones the scan predicate needs) when advancing. The remaining columns are deferred
+   * until Materialize() is called, and are then read only for the tuples that survived filtering. Must be called
+   * after Init(). If the filter turns out to pass most tuples, the iterator goes back to reading every column up
+   * front, since fetching tuples one at a time costs more than scanning them.
+   * @param col_oids array of the oids of the filter columns. Each must be one of the scanned columns.
+   * @param num_oids length of the array
+   */
+  void SetFilterColumns(const uint32_t *col_oids, uint32_t num_oids);
+
+  /**
+   * Read the deferred columns of the tuples selected in the current vector. Afterwards, every column of the selected
+   * tuples can be read through the PCI. This is a no-op if no columns are deferred.
+   */
+  void Materialize();
+
+  /**
+   * Read all scanned columns of the tuple in the given slot, e.g., to fetch payload columns after a join that only
+   * carried the slot along. The tuple must be visible to the iterator's transaction.
+   * @param slot the slot of the tuple
+   * @return a row holding the tuple's columns, laid out in the same order as the PCI's columns. The row is
+   *         overwritten by the next call.
+   */
+  storage::ProjectedRow *FetchRow(storage::TupleSlot slot);
+
   /**
    * Advance the iterator by a vector of input
    * @return True if there is more data in the iterator; false otherwise
@@ -88,6 +123,15 @@ class EXPORT TableVectorIterator {
   static bool ParallelScan(uint32_t db_oid, uint32_t table_oid, void *query_state, ThreadStateContainer *thread_states,
                            ScanFn scan_fn, uint32_t min_grain_size = K_MIN_BLOCK_RANGE_SIZE);
 
+ private:
+  // Late materialization is given up if more than this fraction of the first K_LATE_MATERIALIZATION_SAMPLE_SIZE
+  // scanned tuples survive filtering
+  static constexpr uint64_t K_LATE_MATERIALIZATION_SAMPLE_SIZE = 16 * common::Constants::K_DEFAULT_VECTOR_SIZE;
+  static constexpr double K_LATE_MATERIALIZATION_MAX_PASS_RATE = 0.5;
+
+  // Scan only the filter columns, and copy them into the PC
+  void ScanFilterColumns();
+
  private:
   exec::ExecutionContext *exec_ctx_;
   const catalog::table_oid_t table_oid_;
@@ -101,6 +145,31 @@ class EXPORT TableVectorIterator {
   storage::ProjectedColumns *projected_columns_ = nullptr;
   // Iterator of the slots in the PC
   std::unique_ptr<storage::DataTable::SlotIterator> iter_ = nullptr;
+  // Ranges pushed down from the scan predicate, used to skip blocks
+  storage::ZoneMapFilter zone_map_filter_;
+  // Indexes of the string columns in the PC, and a buffer for the dictionary codes of each. Codes are read whenever
+  // a vector comes from a single dictionary-compressed block.
+  std::vector<uint16_t> varlen_cols_;
+  std::unique_ptr<uint32_t[]> dictionary_codes_;
+
+  // Late materialization. A PC over the filter columns and its buffer, and the index in the PC of each of its columns.
+  void *filter_buffer_ = nullptr;
+  storage::ProjectedColumns *filter_columns_ = nullptr;
+  std::vector<uint16_t> filter_cols_;
+  // A row over the deferred columns and its buffer, and the index in the PC of each of its columns
+  void *deferred_buffer_ = nullptr;
+  storage::ProjectedRow *deferred_row_ = nullptr;
+  std::vector<uint16_t> deferred_cols_;
+  // A row over all scanned columns and its buffer, used by FetchRow()
+  void *fetch_buffer_ = nullptr;
+  storage::ProjectedRow *fetch_row_ = nullptr;
+  // The size of the values of each column in the PC
+  std::vector<uint8_t> col_sizes_;
+  // Whether the deferred columns of the current vector have been read
+  bool materialized_ = true;
+  // Number of tuples scanned and materialized while sampling the filter's pass rate
+  uint64_t num_scanned_ = 0;
+  uint64_t num_materialized_ = 0;
 
   bool initialized_ = false;
 };
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <bitset>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "execution/util/execution_common.h"
+#include "execution/util/region.h"
+#include "storage/storage_defs.h"
+#include "type/type_id.h"
+
+namespace terrier::execution::sql {
+
+/**
+ * A Vector is a batch of up to K_DEFAULT_VECTOR_SIZE values of a single SQL type, together with a
+ * NULL mask and an optional selection vector. Vectors are the operands and results of the kernels
+ * in VectorOps, each of which processes a whole batch in one tight loop. This amortizes the cost of
+ * interpreting an expression over the entire batch rather than paying it for every tuple.
+ *
+ * Values are stored in their storage representation (e.g., int32_t for INTEGER, double for
+ * DECIMAL, storage::VarlenEntry for VARCHAR) and are always addressed by their position in the
+ * batch. If the vector has a selection vector, only the positions it lists are active; otherwise,
+ * the first GetCount() positions are. Because positions are never compacted, vectors computed from
+ * the same batch line up with one another and share a selection vector.
+ *
+ * A vector either owns its data, or references data owned by someone else (e.g., a column in a
+ * ProjectedColumns). A constant vector holds a single value at position zero that is logically
+ * repeated at every position.
+ */
+class EXPORT Vector {
+ public:
+  /**
+   * A bitmask marking the NULL positions in a vector.
+   */
+  using NullMask = std::bitset<common::Constants::K_DEFAULT_VECTOR_SIZE>;
+
+  /**
+   * Create an empty vector of the given type that owns storage for a full batch.
+   * @param type The SQL type of the elements in the vector.
+   */
+  explicit Vector(type::TypeId type);
+
+  /**
+   * Create a vector of the given type referencing @em count elements in @em data. The data must
+   * outlive the vector.
+   * @param type The SQL type of the elements in the vector.
+   * @param data The data to reference.
+   * @param count The number of elements in the vector.
+   */
+  Vector(type::TypeId type, byte *data, uint32_t count);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(Vector);
+
+  /**
+   * @return The SQL type of the elements in this vector.
+   */
+  type::TypeId GetTypeId() const noexcept { return type_; }
+
+  /**
+   * @return The number of active elements in this vector. If the vector has a selection vector,
+   *         this is the number of elements in the selection vector.
+   */
+  uint32_t GetCount() const noexcept { return count_; }
+
+  /**
+   * @return The selection vector, or NULL if all of the first GetCount() positions are active.
+   */
+  const uint32_t *GetSelectionVector() const noexcept { return sel_vector_; }
+
+  /**
+   * @return True if this is a constant vector.
+   */
+  bool IsConstant() const noexcept { return is_constant_; }
+
+  /**
+   * @return The raw data of this vector.
+   */
+  byte *GetData() const noexcept { return data_; }
+
+  /**
+   * @return The data of this vector as an array of @em T.
+   */
+  template <typename T>
+  T *GetDataAs() const noexcept {
+    return reinterpret_cast<T *>(data_);
+  }
+
+  /**
+   * @return True if the element at position @em pos is NULL.
+   */
+  bool IsNull(const uint32_t pos) const { return null_mask_[pos]; }
+
+  /**
+   * Set the NULL indication of the element at position @em pos.
+   */
+  void SetNull(const uint32_t pos, const bool null) { null_mask_[pos] = null; }
+
+  /**
+   * @return The NULL mask of this vector.
+   */
+  const NullMask &GetNullMask() const noexcept { return null_mask_; }
+
+  /**
+   * @return The mutable NULL mask of this vector.
+   */
+  NullMask *GetMutableNullMask() noexcept { return &null_mask_; }
+
+  /**
+   * Set the active elements of this vector.
+   * @param sel_vector The selection vector, or NULL if the first @em count positions are active.
+   * @param count The number of active elements.
+   */
+  void SetSelectionVector(const uint32_t *sel_vector, uint32_t count) {
+    TERRIER_ASSERT(count <= common::Constants::K_DEFAULT_VECTOR_SIZE, "Too many elements in vector");
+    sel_vector_ = sel_vector;
+    count_ = count;
+    is_constant_ = false;
+  }
+
+  /**
+   * Give this vector the same active elements as @em other, i.e., the same count, selection vector,
+   * and constness. The data and NULL mask are not touched.
+   * @param other The vector whose active elements to copy.
+   */
+  void SetShape(const Vector &other) {
+    sel_vector_ = other.sel_vector_;
+    count_ = other.count_;
+    is_constant_ = other.is_constant_;
+  }
+
+  /**
+   * Reference @em count elements in @em data, which must outlive the vector. The NULL mask is
+   * cleared, and any selection vector is removed.
+   * @param data The data to reference.
+   * @param count The number of elements.
+   */
+  void Reference(byte *data, uint32_t count);
+
+  /**
+   * Make this owning vector a constant vector holding @em value.
+   * @tparam T The storage type of the vector's elements.
+   * @param value The constant value.
+   */
+  template <typename T>
+  void SetConstant(const T value) {
+    TERRIER_ASSERT(owned_data_ != nullptr, "Only owning vectors can be made constant");
+    *GetDataAs<T>() = value;
+    MakeConstant(false);
+  }
+
+  /**
+   * Make this vector a constant NULL vector.
+   */
+  void SetNullConstant() { MakeConstant(true); }
+
+  /**
+   * Copy the given string into memory owned by this vector.
+   * @param str The string to copy.
+   * @return An entry referencing the copy. The copy lives as long as this vector.
+   */
+  storage::VarlenEntry AddString(std::string_view str);
+
+  /**
+   * @return The size in bytes of the storage representation of values of the given type.
+   * @throws std::runtime_error if the type is not supported in vectors.
+   */
+  static std::size_t GetTypeSize(type::TypeId type);
+
+ private:
+  // Turn this vector into a constant vector
+  void MakeConstant(bool null) {
+    sel_vector_ = nullptr;
+    count_ = 1;
+    is_constant_ = true;
+    null_mask_.reset();
+    null_mask_[0] = null;
+  }
+
+ private:
+  // The type of the elements
+  type::TypeId type_;
+  // The number of active elements
+  uint32_t count_;
+  // Is this a constant vector?
+  bool is_constant_;
+  // The selection vector
+  const uint32_t *sel_vector_;
+  // The data
+  byte *data_;
+  // The NULL mask
+  NullMask null_mask_;
+  // The data, if owned by this vector
+  std::unique_ptr<byte[]> owned_data_;
+  // Memory for the contents of strings created in this vector, allocated on first use
+  std::unique_ptr<util::Region> string_heap_;
+};
+
+}  // namespace terrier::execution::sql
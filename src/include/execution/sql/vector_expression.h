@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+#include "execution/sql/vector.h"
+#include "execution/util/execution_common.h"
+#include "type/type_id.h"
+
+namespace terrier::execution::sql {
+
+class VectorProjection;
+
+/**
+ * A node of an expression tree that is evaluated a batch at a time with the kernels in VectorOps. Leaves are the
+ * columns of a VectorProjection or numeric constants; interior nodes apply one kernel to the results of their
+ * children. Every node has the SQL type of its result, and the operands of binary operations must have the same type,
+ * so that the code generator casts them to a common type up front.
+ *
+ * Expressions are immutable once built, and may be evaluated by several threads at once.
+ */
+class EXPORT VectorExpression {
+ public:
+  /**
+   * The operation of an interior node.
+   */
+  enum class Op : uint8_t {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Modulo,
+    Equal,
+    NotEqual,
+    LessThan,
+    LessThanEqual,
+    GreaterThan,
+    GreaterThanEqual,
+    And,
+    Or,
+    Not,
+    Cast
+  };
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(VectorExpression);
+
+  /**
+   * @param col_idx The index of the column in the projection the expression is evaluated on.
+   * @param type The SQL type of the column.
+   * @return A leaf reading the given column.
+   */
+  static std::unique_ptr<VectorExpression> Column(uint32_t col_idx, type::TypeId type);
+
+  /**
+   * @return A BIGINT leaf holding @em val.
+   */
+  static std::unique_ptr<VectorExpression> IntegerConstant(int64_t val);
+
+  /**
+   * @return A DECIMAL leaf holding @em val.
+   */
+  static std::unique_ptr<VectorExpression> DecimalConstant(double val);
+
+  /**
+   * @param op The operation to apply.
+   * @param type The SQL type of the result of the operation. This is BOOLEAN for comparisons and logical operations,
+   *             the type of the operands for arithmetic, and the target type for casts.
+   * @param children The operands: one for Not and Cast, two otherwise.
+   * @return A node applying @em op to the results of @em children.
+   */
+  static std::unique_ptr<VectorExpression> Operation(Op op, type::TypeId type,
+                                                     std::vector<std::unique_ptr<VectorExpression>> &&children);
+
+  /**
+   * @return The SQL type of the result of this expression.
+   */
+  type::TypeId GetType() const noexcept { return type_; }
+
+  /**
+   * Evaluate this expression on all selected tuples of @em input.
+   * @param input The batch to evaluate the expression on.
+   * @param[out] temps Receives the vectors holding intermediate results, which must outlive the returned result.
+   * @return The result of the expression. Columns of the input are returned as they are, without copying them.
+   */
+  const Vector &Evaluate(const VectorProjection &input, std::vector<std::unique_ptr<Vector>> *temps) const;
+
+ private:
+  enum class Kind : uint8_t { Column, Constant, Operation };
+
+  VectorExpression(Kind kind, type::TypeId type) : kind_(kind), type_(type) {}
+
+  // Apply the operation of this node to the evaluated children
+  void Apply(const Vector &left, const Vector *right, Vector *result) const;
+
+ private:
+  Kind kind_;
+  type::TypeId type_;
+  // The operation of an interior node
+  Op op_{Op::Add};
+  // The column index of a column leaf
+  uint32_t col_idx_{0};
+  // The value of a constant leaf, of its type
+  int64_t int_val_{0};
+  double decimal_val_{0.0};
+  // The operands of an interior node
+  std::vector<std::unique_ptr<VectorExpression>> children_;
+};
+
+/**
+ * A scan predicate evaluated a batch at a time. It reads the columns of the scanned ProjectedColumns listed in
+ * GetColumnIndexes(), which are referenced in that order by a VectorProjection, and keeps the tuples for which the
+ * BOOLEAN predicate is TRUE. The code generator builds one for every scan whose predicate has arithmetic the PCI
+ * filters cannot evaluate, and ProjectedColumnsIterator::FilterByVectorFilter applies it.
+ */
+class EXPORT VectorFilter {
+ public:
+  /**
+   * @param col_idxs The indexes of the columns the predicate reads in the scanned ProjectedColumns.
+   * @param col_types The SQL types of those columns.
+   * @param predicate The BOOLEAN predicate, whose column leaves index into @em col_idxs.
+   */
+  VectorFilter(std::vector<uint16_t> col_idxs, std::vector<type::TypeId> col_types,
+               std::unique_ptr<VectorExpression> predicate)
+      : col_idxs_(std::move(col_idxs)), col_types_(std::move(col_types)), predicate_(std::move(predicate)) {
+    TERRIER_ASSERT(col_idxs_.size() == col_types_.size(), "Every column needs a type");
+    TERRIER_ASSERT(predicate_->GetType() == type::TypeId::BOOLEAN, "Filters need a BOOLEAN predicate");
+  }
+
+  /**
+   * @return The indexes of the columns the predicate reads in the scanned ProjectedColumns.
+   */
+  const std::vector<uint16_t> &GetColumnIndexes() const noexcept { return col_idxs_; }
+
+  /**
+   * @return The SQL types of the columns the predicate reads.
+   */
+  const std::vector<type::TypeId> &GetColumnTypes() const noexcept { return col_types_; }
+
+  /**
+   * @return The predicate.
+   */
+  const VectorExpression &GetPredicate() const noexcept { return *predicate_; }
+
+ private:
+  std::vector<uint16_t> col_idxs_;
+  std::vector<type::TypeId> col_types_;
+  std::unique_ptr<VectorExpression> predicate_;
+};
+
+}  // namespace terrier::execution::sql
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+
+#include "execution/sql/vector.h"
+#include "execution/util/execution_common.h"
+
+namespace terrier::execution::sql {
+
+class LikePattern;
+
+/**
+ * Batch-at-a-time expression kernels over Vectors. Every kernel evaluates one operation over all
+ * active elements of its inputs in a single loop that is specialized for the types of the inputs,
+ * so that dispatching on types and operators happens once per batch rather than once per tuple.
+ *
+ * Kernels follow SQL semantics: an operation on a NULL input yields NULL, and division or modulo
+ * by zero yields NULL. The inputs of a kernel must have the same active elements (i.e., the same
+ * selection vector and count), except that constant vectors are broadcast to match the other
+ * input. The result must be an owning vector of the result type. It takes on the active elements
+ * of the inputs, and values are written only at the positions of those elements.
+ *
+ * All kernels throw std::runtime_error if given inputs of an unsupported type. Binary kernels
+ * require both inputs to have the same type; use Cast() to convert one of them first.
+ */
+class EXPORT VectorOps {
+ public:
+  // -------------------------------------------------------
+  // Arithmetic
+  // -------------------------------------------------------
+
+  /**
+   * result = left + right
+   */
+  static void Add(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left - right
+   */
+  static void Subtract(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left * right
+   */
+  static void Multiply(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left / right
+   */
+  static void Divide(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left % right
+   */
+  static void Modulo(const Vector &left, const Vector &right, Vector *result);
+
+  // -------------------------------------------------------
+  // Comparison. The result is a BOOLEAN vector.
+  // -------------------------------------------------------
+
+  /**
+   * result = left == right
+   */
+  static void Equal(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left != right
+   */
+  static void NotEqual(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left < right
+   */
+  static void LessThan(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left <= right
+   */
+  static void LessThanEqual(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left > right
+   */
+  static void GreaterThan(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left >= right
+   */
+  static void GreaterThanEqual(const Vector &left, const Vector &right, Vector *result);
+
+  // -------------------------------------------------------
+  // Boolean logic, with SQL's three-valued semantics
+  // -------------------------------------------------------
+
+  /**
+   * result = left AND right. FALSE AND NULL is FALSE.
+   */
+  static void And(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = left OR right. TRUE OR NULL is TRUE.
+   */
+  static void Or(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * result = NOT input
+   */
+  static void Not(const Vector &input, Vector *result);
+
+  /**
+   * Write the positions of all active elements of the BOOLEAN vector @em input that are TRUE (and
+   * hence not NULL) into @em out_sel. The result can be installed as the selection vector of the
+   * batch the input was computed from, restricting further evaluation to the selected tuples.
+   * @param input The BOOLEAN vector to select from. It cannot be a constant vector.
+   * @param[out] out_sel The selection vector to write into. It may alias the input's selection
+   *                     vector.
+   * @return The number of selected elements.
+   */
+  static uint32_t SelectTrue(const Vector &input, uint32_t *out_sel);
+
+  // -------------------------------------------------------
+  // Casting
+  // -------------------------------------------------------
+
+  /**
+   * Convert the elements of @em input to the type of @em result. Casts between the numeric types
+   * (TINYINT through BIGINT, and DECIMAL) and BOOLEAN are supported, as are casts between a type and
+   * itself. Narrowing integer casts truncate, as in C++.
+   * @param input The vector to convert.
+   * @param[out] result The vector to write the converted values into.
+   */
+  static void Cast(const Vector &input, Vector *result);
+
+  // -------------------------------------------------------
+  // String functions
+  // -------------------------------------------------------
+
+  /**
+   * Compute the length in bytes of every string in the VARCHAR vector @em input.
+   * @param input The strings.
+   * @param[out] result An INTEGER vector receiving the lengths.
+   */
+  static void Length(const Vector &input, Vector *result);
+
+  /**
+   * Convert every string in the VARCHAR vector @em input to lower case.
+   * @param input The strings.
+   * @param[out] result A VARCHAR vector receiving the converted strings, which are owned by it.
+   */
+  static void Lower(const Vector &input, Vector *result);
+
+  /**
+   * Convert every string in the VARCHAR vector @em input to upper case.
+   * @param input The strings.
+   * @param[out] result A VARCHAR vector receiving the converted strings, which are owned by it.
+   */
+  static void Upper(const Vector &input, Vector *result);
+
+  /**
+   * Match every string in the VARCHAR vector @em input against a LIKE pattern.
+   * @param input The strings.
+   * @param pattern The compiled pattern.
+   * @param[out] result A BOOLEAN vector receiving the results of the matches.
+   */
+  static void Like(const Vector &input, const LikePattern &pattern, Vector *result);
+};
+
+}  // namespace terrier::execution::sql
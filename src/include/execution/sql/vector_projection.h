@@ -0,0 +1,103 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/macros.h"
+#include "execution/sql/vector.h"
+#include "execution/util/execution_common.h"
+#include "storage/projected_columns.h"
+#include "type/type_id.h"
+
+namespace terrier::execution::sql {
+
+class ProjectedColumnsIterator;
+
+/**
+ * A VectorProjection is a batch of tuples stored as one Vector per column, all sharing a single
+ * selection vector. It is the input to batch-at-a-time expression evaluation. The columns of a
+ * ProjectedColumns can be referenced directly, without copying their data; the selection vector
+ * of a filtered ProjectedColumnsIterator carries over, so that expressions are only evaluated on
+ * the tuples that survived filtering.
+ */
+class EXPORT VectorProjection {
+ public:
+  /**
+   * Create an empty projection with columns of the given types.
+   * @param col_types The SQL types of the columns.
+   */
+  explicit VectorProjection(const std::vector<type::TypeId> &col_types);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(VectorProjection);
+
+  /**
+   * Reference the columns in @em projected_columns. The i-th column of this projection references
+   * the i-th column of @em projected_columns, which must have the same type and outlive the
+   * reference.
+   * @param projected_columns The columns to reference.
+   * @param sel_vector The selection vector, or NULL to select all tuples.
+   * @param count The number of selected tuples.
+   */
+  void Reference(storage::ProjectedColumns *projected_columns, const uint32_t *sel_vector, uint32_t count);
+
+  /**
+   * Reference the current projection of @em pci, selecting only the tuples it has selected.
+   * @param pci The iterator whose projection to reference.
+   */
+  void Reference(const ProjectedColumnsIterator &pci);
+
+  /**
+   * Reference some columns of the current projection of @em pci, selecting only the tuples it has selected. The i-th
+   * column of this projection references the column at index @em col_idxs[i] of the iterator's projection.
+   * @param pci The iterator whose projection to reference.
+   * @param col_idxs The indexes of the columns to reference.
+   */
+  void Reference(const ProjectedColumnsIterator &pci, const std::vector<uint16_t> &col_idxs);
+
+  /**
+   * Restrict the active tuples of all columns to those in @em sel_vector.
+   * @param sel_vector The selection vector, or NULL to select the first @em count tuples.
+   * @param count The number of selected tuples.
+   */
+  void SetSelectionVector(const uint32_t *sel_vector, uint32_t count);
+
+  /**
+   * @return The number of columns in the projection.
+   */
+  uint32_t GetNumColumns() const noexcept { return static_cast<uint32_t>(columns_.size()); }
+
+  /**
+   * @return The column at index @em col_idx.
+   */
+  Vector *GetColumn(const uint32_t col_idx) const {
+    TERRIER_ASSERT(col_idx < columns_.size(), "Out-of-bounds column access");
+    return columns_[col_idx].get();
+  }
+
+  /**
+   * @return The number of selected tuples.
+   */
+  uint32_t GetCount() const noexcept { return count_; }
+
+  /**
+   * @return The selection vector, or NULL if the first GetCount() tuples are selected.
+   */
+  const uint32_t *GetSelectionVector() const noexcept { return sel_vector_; }
+
+ private:
+  // Reference the column at index col_idx of projected_columns in the column at index vector_idx
+  void ReferenceColumn(storage::ProjectedColumns *projected_columns, uint16_t col_idx, uint32_t vector_idx);
+
+ private:
+  // The columns
+  std::vector<std::unique_ptr<Vector>> columns_;
+  // The selection vector shared by all columns
+  const uint32_t *sel_vector_;
+  // The number of selected tuples
+  uint32_t count_;
+};
+
+}  // namespace terrier::execution::sql
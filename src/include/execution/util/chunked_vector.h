@@ -399,7 +399,7 @@ class ChunkedVector {
     if (empty()) {
       return Iterator();
     }
-    return Iterator(chunks_.end() - 1, position_, ElementSize());
+    return Iterator(chunks_.begin() + active_chunk_idx_, position_, ElementSize());
   }
 
   // -------------------------------------------------------
@@ -508,6 +508,21 @@ class ChunkedVector {
     std::memcpy(dest, elem, ElementSize());
   }
 
+  /**
+   * Remove all elements from the vector. Allocated chunks are retained and
+   * reused by subsequent insertions.
+   */
+  void clear() noexcept {  // NOLINT
+    num_elements_ = 0;
+    active_chunk_idx_ = 0;
+    if (chunks_.empty()) {
+      position_ = end_ = nullptr;
+    } else {
+      position_ = chunks_[0];
+      end_ = position_ + ChunkAllocSize(ElementSize());
+    }
+  }
+
   /**
    * Remove the last element from the vector.
    */
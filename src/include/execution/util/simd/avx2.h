@@ -707,7 +707,7 @@ ALWAYS_INLINE inline Vec8Mask operator>(const Vec8 &a, const Vec8 &b) { return V
 ALWAYS_INLINE inline Vec8Mask operator==(const Vec8 &a, const Vec8 &b) { return Vec8Mask(_mm256_cmpeq_epi32(a, b)); }
 
 ALWAYS_INLINE inline Vec8Mask operator>=(const Vec8 &a, const Vec8 &b) {
-  __m256i max_a_b = _mm256_max_epu32(a, b);
+  __m256i max_a_b = _mm256_max_epi32(a, b);
   return Vec8Mask(_mm256_cmpeq_epi32(a, max_a_b));
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <type_traits>
 
+#include "common/container/bitmap.h"
 #include "execution/util/execution_common.h"
 #include "execution/util/simd.h"
 
@@ -37,10 +40,12 @@ class VectorUtil {
     static_assert(std::is_same_v<bool, std::invoke_result_t<Op<T>, T, T>>);
 
     uint32_t in_pos = 0;
-#if defined(__AVX2__) || defined(__AVX512F__)
-    uint32_t out_pos = simd::FilterVectorByVal<T, Op>(in, in_count, val, out, sel, &in_pos);
-#else
     uint32_t out_pos = 0;
+#if defined(__AVX2__) || defined(__AVX512F__)
+    // The SIMD kernels use signed integer comparisons; all other types go through the scalar loop
+    if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+      out_pos = simd::FilterVectorByVal<T, Op>(in, in_count, val, out, sel, &in_pos);
+    }
 #endif
 
     if (sel == nullptr) {
@@ -81,10 +86,11 @@ class VectorUtil {
     static_assert(std::is_same_v<bool, std::invoke_result_t<Op<T>, T, T>>);
 
     uint32_t in_pos = 0;
-#if defined(__AVX2__) || defined(__AVX512F__)
-    uint32_t out_pos = simd::FilterVectorByVector<T, Op>(in_1, in_2, in_count, out, sel, &in_pos);
-#else
     uint32_t out_pos = 0;
+#if defined(__AVX2__) || defined(__AVX512F__)
+    if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+      out_pos = simd::FilterVectorByVector<T, Op>(in_1, in_2, in_count, out, sel, &in_pos);
+    }
 #endif
 
     if (sel == nullptr) {
@@ -150,6 +156,89 @@ class VectorUtil {
   GEN_FILTER(Ne, std::not_equal_to)
 #undef GEN_FILTER
 
+  /**
+   * Count the non-NULL elements of the input (or selection) vector.
+   * @param null_bitmap The validity bitmap of the input vector. A set bit marks a non-NULL element.
+   * @param in_count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   * @return The number of non-NULL elements.
+   */
+  static uint32_t CountNotNull(const common::RawBitmap *null_bitmap, const uint32_t in_count,
+                               const uint32_t *RESTRICT sel) {
+    if (null_bitmap->AllSet(NumPositions(in_count, sel))) {
+      return in_count;
+    }
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < in_count; i++) {
+      count += static_cast<uint32_t>(null_bitmap->Test(sel == nullptr ? i : sel[i]));
+    }
+    return count;
+  }
+
+  /**
+   * Fold the non-NULL elements of the input (or selection) vector into a single value using the associative and
+   * commutative operation @em op, e.g., to compute their sum or minimum. When no element is NULL, the elements are
+   * folded into K_REDUCE_LANES independent partial results, which the compiler maps onto SIMD lanes, and the partial
+   * results are combined at the end.
+   * @tparam T The data type of the elements stored in the input vector.
+   * @tparam R The data type of the result.
+   * @tparam Op The folding operation, invocable as R(R, R).
+   * @param in The input vector.
+   * @param null_bitmap The validity bitmap of the input vector. A set bit marks a non-NULL element.
+   * @param in_count The number of elements in the input (or selection) vector.
+   * @param sel The selection vector storing indexes of elements to process, or NULL to process all.
+   * @param identity The identity of the operation, i.e., the result of folding no elements.
+   * @param[out] result The folded value.
+   * @param op The folding operation.
+   * @return The number of non-NULL elements that were folded.
+   */
+  template <typename T, typename R, typename Op>
+  static uint32_t Reduce(const T *RESTRICT in, const common::RawBitmap *null_bitmap, const uint32_t in_count,
+                         const uint32_t *RESTRICT sel, const R identity, R *result, const Op &op) {
+    if (!null_bitmap->AllSet(NumPositions(in_count, sel))) {
+      R acc = identity;
+      uint32_t count = 0;
+      for (uint32_t i = 0; i < in_count; i++) {
+        const uint32_t idx = (sel == nullptr ? i : sel[i]);
+        if (null_bitmap->Test(idx)) {
+          acc = op(acc, static_cast<R>(in[idx]));
+          count++;
+        }
+      }
+      *result = acc;
+      return count;
+    }
+
+    R lanes[K_REDUCE_LANES];
+    std::fill(lanes, lanes + K_REDUCE_LANES, identity);
+    uint32_t i = 0;
+    if (sel == nullptr) {
+      for (; i + K_REDUCE_LANES <= in_count; i += K_REDUCE_LANES) {
+        for (uint32_t lane = 0; lane < K_REDUCE_LANES; lane++) {
+          lanes[lane] = op(lanes[lane], static_cast<R>(in[i + lane]));
+        }
+      }
+      for (; i < in_count; i++) {
+        lanes[0] = op(lanes[0], static_cast<R>(in[i]));
+      }
+    } else {
+      for (; i + K_REDUCE_LANES <= in_count; i += K_REDUCE_LANES) {
+        for (uint32_t lane = 0; lane < K_REDUCE_LANES; lane++) {
+          lanes[lane] = op(lanes[lane], static_cast<R>(in[sel[i + lane]]));
+        }
+      }
+      for (; i < in_count; i++) {
+        lanes[0] = op(lanes[0], static_cast<R>(in[sel[i]]));
+      }
+    }
+    R acc = identity;
+    for (const R &lane : lanes) {
+      acc = op(acc, lane);
+    }
+    *result = acc;
+    return in_count;
+  }
+
   /**
    * Given a vector of pointers, insert the indexes of all null elements into
    * the selection vector @em out.
@@ -181,6 +270,17 @@ class VectorUtil {
                             uint32_t *RESTRICT sel) -> std::enable_if_t<std::is_pointer_v<T>, uint32_t> {
     return FilterNe(reinterpret_cast<const intptr_t *>(in), in_count, intptr_t(0), out, sel);
   }
+
+ private:
+  // The number of independent partial results kept by Reduce()
+  static constexpr uint32_t K_REDUCE_LANES = 8;
+
+  // The number of leading positions of the input vector covered by the input (or selection) vector. Selection vectors
+  // are sorted.
+  static uint32_t NumPositions(const uint32_t in_count, const uint32_t *sel) {
+    if (sel == nullptr || in_count == 0) return in_count;
+    return sel[in_count - 1] + 1;
+  }
 };
 
 }  // namespace terrier::execution::util
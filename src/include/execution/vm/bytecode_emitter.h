@@ -311,6 +311,23 @@ class BytecodeEmitter {
   void EmitTableIterInit(Bytecode bytecode, LocalVar iter, LocalVar exec_ctx, uint32_t table_oid, LocalVar col_oids,
                          uint32_t num_oids);
 
+  /**
+   * Emit bytecode to restrict the values of a column for skipping blocks in a table scan
+   * @param iter TVI
+   * @param col_oid oid of the column
+   * @param min_key smallest admissible zone map key
+   * @param max_key largest admissible zone map key
+   */
+  void EmitTableIterAddRangeFilter(LocalVar iter, uint32_t col_oid, int64_t min_key, int64_t max_key);
+
+  /**
+   * Emit bytecode to set the columns a table scan reads before filtering
+   * @param iter TVI
+   * @param col_oids array of oids of the filter columns
+   * @param num_oids length of the array
+   */
+  void EmitTableIterSetFilterColumns(LocalVar iter, LocalVar col_oids, uint32_t num_oids);
+
   /**
    * Emit bytecode to add a column for scanning
    * @param bytecode bytecode to emit
@@ -347,6 +364,62 @@ class BytecodeEmitter {
   void EmitPCIVectorFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx, int8_t type,
                            int64_t val);
 
+  /**
+   * Filter a string column in the iterator by a compiled LIKE pattern
+   * @param bytecode filter bytecode to emit
+   * @param selected output variable for the number of selected values
+   * @param pci PCI to filter
+   * @param col_idx index of the iterator to filter
+   * @param pattern address of the compiled pattern, which must outlive the bytecode
+   */
+  void EmitPCILikeFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx, uintptr_t pattern);
+
+  /**
+   * Filter a string column in the iterator by a list of constant strings
+   * @param selected output variable for the number of selected values
+   * @param pci PCI to filter
+   * @param col_idx index of the iterator to filter
+   * @param in_list address of the list, which must outlive the bytecode
+   */
+  void EmitPCIInListFilter(LocalVar selected, LocalVar pci, uint32_t col_idx, uintptr_t in_list);
+
+  /**
+   * Filter a vector by a predicate evaluated a batch at a time
+   * @param selected where to store the number of selected tuples
+   * @param exec_ctx the execution context holding the predicate
+   * @param pci the projected columns iterator to filter
+   * @param filter_id id of the predicate in the running query
+   */
+  void EmitPCIVectorExprFilter(LocalVar selected, LocalVar exec_ctx, LocalVar pci, uint32_t filter_id);
+
+  /**
+   * Match a string against a compiled LIKE pattern
+   * @param bytecode like bytecode to emit
+   * @param dest where to store the result
+   * @param str string to match
+   * @param pattern address of the compiled pattern, which must outlive the bytecode
+   */
+  void EmitLikeCompiled(Bytecode bytecode, LocalVar dest, LocalVar str, uintptr_t pattern);
+
+  /**
+   * Advance an aggregate by a column of all selected tuples in the iterator
+   * @param bytecode batch advance bytecode to emit
+   * @param agg aggregate to advance
+   * @param pci PCI to read the column from
+   * @param col_idx index of the column in the iterator
+   * @param type type of the column
+   */
+  void EmitAggAdvanceBatch(Bytecode bytecode, LocalVar agg, LocalVar pci, uint32_t col_idx, int8_t type);
+
+  /**
+   * Hash a key column of all selected tuples in the iterator into the iterator's cached hashes
+   * @param pci PCI to read the column from
+   * @param col_idx index of the column in the iterator
+   * @param type type of the column
+   * @param combine whether to combine with the hashes of earlier key columns
+   */
+  void EmitPCIHashColumn(LocalVar pci, uint32_t col_idx, int8_t type, bool combine);
+
   /**
    * Insert a filter flavor into the filter manager builder
    */
@@ -357,6 +430,11 @@ class BytecodeEmitter {
    */
   void EmitAggHashTableLookup(LocalVar dest, LocalVar agg_ht, LocalVar hash, FunctionId key_eq_fn, LocalVar arg);
 
+  /**
+   * Switch the aggregation hash table to directly addressing groups by a key in the given range
+   */
+  void EmitAggHashTableSetDenseRange(LocalVar agg_ht, int64_t min_key, int64_t max_key);
+
   /**
    * Process a batch of input into the aggregation hash table
    */
@@ -374,12 +452,28 @@ class BytecodeEmitter {
   void EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, LocalVar context, LocalVar tls,
                                                FunctionId scan_part_fn);
 
+  /**
+   * Emit code merging the next spilled partition of a serial aggregation
+   */
+  void EmitAggHashTableNextSpilledPartition(LocalVar has_more, LocalVar agg_ht, LocalVar context,
+                                            FunctionId merge_part_fn);
+
   /**
    * Emit join table iteration code
    */
   void EmitJoinHashTableIterHasNext(LocalVar has_more, LocalVar iterator, FunctionId key_eq, LocalVar opaque_ctx,
                                     LocalVar probe_tuple);
 
+  /**
+   * Emit code to filter a vector of probe tuples through a join hash table's Bloom filter
+   * @param num_selected where to store the number of remaining tuples
+   * @param join_hash_table the join hash table
+   * @param pci the iterator over the probe tuples
+   * @param hash_fn the function computing the hash of a probe tuple
+   */
+  void EmitJoinHashTableFilterProbe(LocalVar num_selected, LocalVar join_hash_table, LocalVar pci,
+                                    FunctionId hash_fn);
+
   /**
    * Initialize a sorter instance
    */
@@ -10,6 +10,8 @@
 #include "execution/ast/ast_visitor.h"
 #include "execution/ast/builtins.h"
 #include "execution/exec/execution_context.h"
+#include "execution/sql/like_pattern.h"
+#include "execution/sql/string_in_list.h"
 #include "execution/vm/bytecode_emitter.h"
 
 namespace terrier::execution::vm {
@@ -71,17 +73,27 @@ class BytecodeGenerator : public ast::AstVisitor<BytecodeGenerator> {
   void VisitBuiltinHashCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinFilterManagerCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinFilterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinFilterLikeCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinFilterInListCall(ast::CallExpr *call);
+  void VisitBuiltinFilterVectorCall(ast::CallExpr *call);
   void VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggPartIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggregatorCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinJoinHashTableEntryIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinMergeJoinCursorCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinThreadStateContainerCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSizeOfCall(ast::CallExpr *call);
   void VisitBuiltinTrigCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinLikeCall(ast::CallExpr *call, ast::Builtin builtin);
+
+  // Compile the LIKE pattern of a string literal, or of @stringToSql() of one, for the lifetime of the module. Returns
+  // the address of the compiled pattern, or nullptr if the pattern is not constant or is malformed.
+  const sql::LikePattern *CompileConstantLikePattern(ast::Expr *pattern);
   void VisitBuiltinOutputCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinPRCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -180,6 +192,12 @@ class BytecodeGenerator : public ast::AstVisitor<BytecodeGenerator> {
 
   // The execution context for catalog queries
   exec::ExecutionContext *exec_ctx_;
+
+  // The LIKE patterns compiled for the module, which its bytecode references by address
+  std::vector<std::unique_ptr<sql::LikePattern>> like_patterns_;
+
+  // The IN lists built for the module, which its bytecode references by address
+  std::vector<std::unique_ptr<sql::StringInList>> in_lists_;
 };
 
 }  // namespace terrier::execution::vm
@@ -14,9 +14,11 @@
 #include "execution/sql/functions/string_functions.h"
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/join_hash_table.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/sql/projected_columns_iterator.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/storage_interface.h"
+#include "execution/sql/string_in_list.h"
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/execution_common.h"
@@ -194,6 +196,11 @@ VM_OP_HOT void OpExecutionContextGetMemoryPool(terrier::execution::sql::MemoryPo
   *memory = exec_ctx->GetMemoryPool();
 }
 
+VM_OP_WARM void OpExecutionContextReportRows(terrier::execution::exec::ExecutionContext *const exec_ctx,
+                                             const uint32_t probe_id, const uint64_t num_rows) {
+  exec_ctx->ReportRows(probe_id, num_rows);
+}
+
 void OpThreadStateContainerInit(terrier::execution::sql::ThreadStateContainer *thread_state_container,
                                 terrier::execution::sql::MemoryPool *memory);
 
@@ -222,6 +229,26 @@ VM_OP void OpTableVectorIteratorInit(terrier::execution::sql::TableVectorIterato
 
 VM_OP void OpTableVectorIteratorPerformInit(terrier::execution::sql::TableVectorIterator *iter);
 
+VM_OP_WARM void OpTableVectorIteratorAddRangeFilter(terrier::execution::sql::TableVectorIterator *iter,
+                                                    uint32_t col_oid, int64_t min_key, int64_t max_key) {
+  iter->AddRangeFilter(col_oid, min_key, max_key);
+}
+
+VM_OP_WARM void OpTableVectorIteratorSetFilterColumns(terrier::execution::sql::TableVectorIterator *iter,
+                                                      uint32_t *col_oids, uint32_t num_oids) {
+  iter->SetFilterColumns(col_oids, num_oids);
+}
+
+VM_OP_HOT void OpTableVectorIteratorMaterialize(terrier::execution::sql::TableVectorIterator *iter) {
+  iter->Materialize();
+}
+
+VM_OP_HOT void OpTableVectorIteratorFetchRow(terrier::storage::ProjectedRow **row,
+                                             terrier::execution::sql::TableVectorIterator *iter,
+                                             terrier::storage::TupleSlot *slot) {
+  *row = iter->FetchRow(*slot);
+}
+
 VM_OP_HOT void OpTableVectorIteratorNext(bool *has_more, terrier::execution::sql::TableVectorIterator *iter) {
   *has_more = iter->Advance();
 }
@@ -271,6 +298,15 @@ VM_OP_HOT void OpPCIGetSlot(terrier::storage::TupleSlot *slot, terrier::executio
   *slot = pci->CurrentSlot();
 }
 
+VM_OP_HOT void OpPCIGetHash(terrier::hash_t *hash_val, terrier::execution::sql::ProjectedColumnsIterator *pci) {
+  *hash_val = pci->GetHash();
+}
+
+VM_OP_WARM void OpPCIHashColumn(terrier::execution::sql::ProjectedColumnsIterator *pci, uint32_t col_idx, int8_t type,
+                                int8_t combine) {
+  pci->HashColumn(col_idx, static_cast<terrier::type::TypeId>(type), combine != 0);
+}
+
 VM_OP_HOT void OpPCIGetBool(terrier::execution::sql::BoolVal *out,
                             terrier::execution::sql::ProjectedColumnsIterator *iter, uint16_t col_idx) {
   // Read
@@ -514,6 +550,21 @@ VM_OP void OpPCIFilterLessThanEqual(uint64_t *size, terrier::execution::sql::Pro
 VM_OP void OpPCIFilterNotEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
                                uint32_t col_idx, int8_t type, int64_t val);
 
+// The pattern is the address of a LikePattern that the bytecode module owns
+VM_OP void OpPCIFilterLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                           uintptr_t pattern);
+
+VM_OP void OpPCIFilterNotLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                              uint32_t col_idx, uintptr_t pattern);
+
+// The list is the address of a StringInList that the bytecode module owns
+VM_OP void OpPCIFilterInList(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                             uint32_t col_idx, uintptr_t in_list);
+
+// The filter is registered with the running query, which hands it to the execution context
+VM_OP void OpPCIFilterVector(uint64_t *size, terrier::execution::exec::ExecutionContext *exec_ctx,
+                             terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t filter_id);
+
 // ---------------------------------------------------------
 // Hashing
 // ---------------------------------------------------------
@@ -593,6 +644,8 @@ VM_OP_HOT void OpInitVarlen(terrier::execution::sql::StringVal *result, uintptr_
   *result = terrier::execution::sql::StringVal(reinterpret_cast<const char *>(varlen->Content()), varlen->Size());
 }
 
+VM_OP_HOT void OpInitSqlNull(terrier::execution::sql::Val *result) { result->is_null_ = true; }
+
 #define GEN_SQL_COMPARISONS(TYPE)                                                             \
   VM_OP_HOT void OpGreaterThan##TYPE(terrier::execution::sql::BoolVal *const result,          \
                                      const terrier::execution::sql::TYPE *const left,         \
@@ -720,6 +773,23 @@ VM_OP_HOT void OpAggregationHashTableInsert(terrier::byte **result,
   *result = agg_hash_table->Insert(hash_val);
 }
 
+VM_OP_HOT void OpAggregationHashTableSetDenseRange(terrier::execution::sql::AggregationHashTable *agg_hash_table,
+                                                   int64_t min_key, int64_t max_key) {
+  agg_hash_table->SetDenseKeyRange(min_key, max_key);
+}
+
+VM_OP_HOT void OpAggregationHashTableInsertDense(terrier::byte **result,
+                                                 terrier::execution::sql::AggregationHashTable *agg_hash_table,
+                                                 const terrier::execution::sql::Integer *key) {
+  *result = agg_hash_table->InsertDense(*key);
+}
+
+VM_OP_HOT void OpAggregationHashTableLookupDense(terrier::byte **result,
+                                                 const terrier::execution::sql::AggregationHashTable *agg_hash_table,
+                                                 const terrier::execution::sql::Integer *key) {
+  *result = agg_hash_table->LookupDense(*key);
+}
+
 VM_OP_HOT void OpAggregationHashTableLookup(terrier::byte **result,
                                             terrier::execution::sql::AggregationHashTable *const agg_hash_table,
                                             const terrier::hash_t hash_val,
@@ -752,6 +822,16 @@ VM_OP_HOT void OpAggregationHashTableParallelPartitionedScan(
   agg_hash_table->ExecuteParallelPartitionedScan(query_state, thread_state_container, scan_partition_fn);
 }
 
+VM_OP void OpAggregationHashTableNextSpilledPartition(
+    bool *has_more, terrier::execution::sql::AggregationHashTable *agg_hash_table, void *query_state,
+    terrier::execution::sql::AggregationHashTable::MergePartitionFn merge_partition_fn);
+
+VM_OP_HOT void OpAggregationHashTableGetSpilledPartition(
+    terrier::execution::sql::AggregationHashTable **const result,
+    terrier::execution::sql::AggregationHashTable *const agg_hash_table) {
+  *result = agg_hash_table->GetSpilledPartitionTable();
+}
+
 VM_OP void OpAggregationHashTableFree(terrier::execution::sql::AggregationHashTable *agg_hash_table);
 
 VM_OP void OpAggregationHashTableIteratorInit(terrier::execution::sql::AggregationHashTableIterator *iter,
@@ -1050,6 +1130,31 @@ VM_OP_HOT void OpAvgAggregateGetResult(terrier::execution::sql::Real *result,
 
 VM_OP_HOT void OpAvgAggregateFree(terrier::execution::sql::AvgAggregate *agg) { agg->~AvgAggregate(); }
 
+// ---------------------------------------------------------
+// Batch aggregates
+// ---------------------------------------------------------
+
+#define GEN_AGG_ADVANCE_BATCH(AGG)                                                                                 \
+  VM_OP_HOT void Op##AGG##AdvanceBatch(terrier::execution::sql::AGG *agg,                                          \
+                                       const terrier::execution::sql::ProjectedColumnsIterator *iter,              \
+                                       uint32_t col_idx, int8_t type) {                                            \
+    iter->VisitNumericColumn(                                                                                      \
+        col_idx, static_cast<terrier::type::TypeId>(type),                                                         \
+        [agg](const auto *values, const terrier::common::RawBitmap *nulls, uint32_t count, const uint32_t *sel) {  \
+          agg->AdvanceBatch(values, nulls, count, sel);                                                            \
+        });                                                                                                        \
+  }
+
+GEN_AGG_ADVANCE_BATCH(CountAggregate)
+GEN_AGG_ADVANCE_BATCH(IntegerSumAggregate)
+GEN_AGG_ADVANCE_BATCH(IntegerMaxAggregate)
+GEN_AGG_ADVANCE_BATCH(IntegerMinAggregate)
+GEN_AGG_ADVANCE_BATCH(RealSumAggregate)
+GEN_AGG_ADVANCE_BATCH(RealMaxAggregate)
+GEN_AGG_ADVANCE_BATCH(RealMinAggregate)
+GEN_AGG_ADVANCE_BATCH(AvgAggregate)
+#undef GEN_AGG_ADVANCE_BATCH
+
 // ---------------------------------------------------------
 // Hash Joins
 // ---------------------------------------------------------
@@ -1069,6 +1174,15 @@ VM_OP void OpJoinHashTableBuildParallel(terrier::execution::sql::JoinHashTable *
                                         terrier::execution::sql::ThreadStateContainer *thread_state_container,
                                         uint32_t jht_offset);
 
+VM_OP void OpJoinHashTableEnableBloomFilter(terrier::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP_HOT void OpJoinHashTableFilterProbe(uint32_t *num_selected,
+                                          terrier::execution::sql::JoinHashTable *join_hash_table,
+                                          terrier::execution::sql::ProjectedColumnsIterator *pci,
+                                          terrier::execution::sql::JoinHashTable::ProbeHashFn hash_fn) {
+  *num_selected = join_hash_table->FilterProbeBatch(pci, hash_fn);
+}
+
 VM_OP_HOT void OpJoinHashTableIterInit(terrier::execution::sql::JoinHashTableIterator *result,
                                        terrier::execution::sql::JoinHashTable *join_hash_table, terrier::hash_t hash) {
   *result = join_hash_table->Lookup<false>(hash);
@@ -1089,6 +1203,52 @@ VM_OP_HOT void OpJoinHashTableIterClose(terrier::execution::sql::JoinHashTableIt
   iterator->~JoinHashTableIterator();
 }
 
+VM_OP_HOT void OpJoinHashTableEntryIteratorInit(terrier::execution::sql::JoinHashTableEntryIterator *iterator,
+                                                terrier::execution::sql::JoinHashTable *join_hash_table) {
+  new (iterator) terrier::execution::sql::JoinHashTableEntryIterator(join_hash_table);
+}
+
+VM_OP_HOT void OpJoinHashTableEntryIteratorHasNext(bool *has_more,
+                                                   terrier::execution::sql::JoinHashTableEntryIterator *iterator) {
+  *has_more = iterator->HasNext();
+}
+
+VM_OP_HOT void OpJoinHashTableEntryIteratorNext(terrier::execution::sql::JoinHashTableEntryIterator *iterator) {
+  iterator->Next();
+}
+
+VM_OP_HOT void OpJoinHashTableEntryIteratorGetRow(terrier::byte **row,
+                                                  terrier::execution::sql::JoinHashTableEntryIterator *iterator) {
+  *row = iterator->GetRow();
+}
+
+VM_OP_HOT void OpJoinHashTableGetTupleCount(uint64_t *const result,
+                                            terrier::execution::sql::JoinHashTable *const join_hash_table) {
+  *result = join_hash_table->GetTupleCount();
+}
+
+VM_OP_HOT void OpJoinHashTableIsPartitionSpilled(bool *const result,
+                                                 terrier::execution::sql::JoinHashTable *const join_hash_table,
+                                                 const terrier::hash_t hash) {
+  *result = join_hash_table->IsPartitionSpilled(hash);
+}
+
+VM_OP void OpJoinHashTableSpillProbeTuple(terrier::execution::sql::JoinHashTable *join_hash_table, terrier::hash_t hash,
+                                          const terrier::byte *probe_tuple, uint32_t probe_tuple_size);
+
+VM_OP void OpJoinHashTableNextSpilledPartition(bool *result, terrier::execution::sql::JoinHashTable *join_hash_table,
+                                               bool include_unprobed);
+
+VM_OP_HOT void OpJoinHashTableNextSpilledProbeTuple(bool *const has_more,
+                                                    terrier::execution::sql::JoinHashTable *const join_hash_table) {
+  *has_more = join_hash_table->NextSpilledProbeTuple();
+}
+
+VM_OP_HOT void OpJoinHashTableGetSpilledProbeTuple(const terrier::byte **const result,
+                                                   terrier::execution::sql::JoinHashTable *const join_hash_table) {
+  *result = join_hash_table->GetSpilledProbeTuple();
+}
+
 VM_OP void OpJoinHashTableFree(terrier::execution::sql::JoinHashTable *join_hash_table);
 
 // ---------------------------------------------------------
@@ -1136,6 +1296,38 @@ VM_OP_HOT void OpSorterIteratorGetRow(const terrier::byte **row, terrier::execut
 
 VM_OP void OpSorterIteratorFree(terrier::execution::sql::SorterIterator *iter);
 
+VM_OP void OpMergeJoinCursorInit(terrier::execution::sql::MergeJoinCursor *cursor,
+                                 terrier::execution::sql::Sorter *sorter);
+
+VM_OP_HOT void OpMergeJoinCursorHasNext(bool *has_more, terrier::execution::sql::MergeJoinCursor *cursor) {
+  *has_more = cursor->HasNext();
+}
+
+VM_OP_HOT void OpMergeJoinCursorNext(terrier::execution::sql::MergeJoinCursor *cursor) { cursor->Next(); }
+
+VM_OP_HOT void OpMergeJoinCursorGetRow(const terrier::byte **row, terrier::execution::sql::MergeJoinCursor *cursor) {
+  *row = cursor->GetRow();
+}
+
+VM_OP_HOT void OpMergeJoinCursorAddToRun(terrier::execution::sql::MergeJoinCursor *cursor) { cursor->AddToRun(); }
+
+VM_OP_HOT void OpMergeJoinCursorClearRun(terrier::execution::sql::MergeJoinCursor *cursor) { cursor->ClearRun(); }
+
+VM_OP_HOT void OpMergeJoinCursorRunInit(terrier::execution::sql::MergeJoinCursor *cursor) { cursor->RunInit(); }
+
+VM_OP_HOT void OpMergeJoinCursorRunHasNext(bool *has_more, terrier::execution::sql::MergeJoinCursor *cursor) {
+  *has_more = cursor->RunHasNext();
+}
+
+VM_OP_HOT void OpMergeJoinCursorRunNext(terrier::execution::sql::MergeJoinCursor *cursor) { cursor->RunNext(); }
+
+VM_OP_HOT void OpMergeJoinCursorRunGetRow(const terrier::byte **row,
+                                          terrier::execution::sql::MergeJoinCursor *cursor) {
+  *row = cursor->RunGetRow();
+}
+
+VM_OP void OpMergeJoinCursorFree(terrier::execution::sql::MergeJoinCursor *cursor);
+
 // ---------------------------------------------------------
 // Trig functions
 // ---------------------------------------------------------
@@ -1289,6 +1481,30 @@ VM_OP_WARM void OpLength(terrier::execution::exec::ExecutionContext *ctx, terrie
   terrier::execution::sql::StringFunctions::Length(ctx, result, *str);
 }
 
+VM_OP_WARM void OpLike(terrier::execution::sql::BoolVal *result, const terrier::execution::sql::StringVal *str,
+                       const terrier::execution::sql::StringVal *pattern) {
+  terrier::execution::sql::StringFunctions::Like(result, *str, *pattern);
+}
+
+VM_OP_WARM void OpNotLike(terrier::execution::sql::BoolVal *result, const terrier::execution::sql::StringVal *str,
+                          const terrier::execution::sql::StringVal *pattern) {
+  terrier::execution::sql::StringFunctions::Like(result, *str, *pattern);
+  result->val_ = !result->val_;
+}
+
+VM_OP_WARM void OpLikeCompiled(terrier::execution::sql::BoolVal *result,
+                               const terrier::execution::sql::StringVal *str, uintptr_t pattern) {
+  const auto *like_pattern = reinterpret_cast<const terrier::execution::sql::LikePattern *>(pattern);
+  terrier::execution::sql::StringFunctions::Like(result, *str, *like_pattern);
+}
+
+VM_OP_WARM void OpNotLikeCompiled(terrier::execution::sql::BoolVal *result,
+                                  const terrier::execution::sql::StringVal *str, uintptr_t pattern) {
+  const auto *like_pattern = reinterpret_cast<const terrier::execution::sql::LikePattern *>(pattern);
+  terrier::execution::sql::StringFunctions::Like(result, *str, *like_pattern);
+  result->val_ = !result->val_;
+}
+
 VM_OP_WARM void OpLower(terrier::execution::exec::ExecutionContext *ctx, terrier::execution::sql::StringVal *result,
                         const terrier::execution::sql::StringVal *str) {
   terrier::execution::sql::StringFunctions::Lower(ctx, result, *str);
@@ -1365,6 +1581,8 @@ VM_OP void OpIndexIteratorFree(terrier::execution::sql::IndexIterator *iter);
 
 VM_OP void OpIndexIteratorPerformInit(terrier::execution::sql::IndexIterator *iter);
 
+VM_OP_WARM void OpIndexIteratorSetIndexOnly(terrier::execution::sql::IndexIterator *iter) { iter->SetIndexOnly(); }
+
 VM_OP_WARM void OpIndexIteratorScanKey(terrier::execution::sql::IndexIterator *iter) { iter->ScanKey(); }
 
 VM_OP_WARM void OpIndexIteratorScanAscending(terrier::execution::sql::IndexIterator *iter) { iter->ScanAscending(); }
@@ -1379,6 +1597,10 @@ VM_OP_WARM void OpIndexIteratorScanLimitDescending(terrier::execution::sql::Inde
   iter->ScanLimitDescending(limit);
 }
 
+VM_OP_WARM void OpIndexIteratorAddRange(terrier::execution::sql::IndexIterator *iter) { iter->AddRange(); }
+
+VM_OP_WARM void OpIndexIteratorScanRanges(terrier::execution::sql::IndexIterator *iter) { iter->ScanRanges(); }
+
 VM_OP_WARM void OpIndexIteratorAdvance(bool *has_more, terrier::execution::sql::IndexIterator *iter) {
   *has_more = iter->Advance();
 }
@@ -1403,6 +1625,11 @@ VM_OP_WARM void OpIndexIteratorGetTablePR(terrier::storage::ProjectedRow **pr,
   *pr = iter->TablePR();
 }
 
+VM_OP_WARM void OpIndexIteratorGetKeyPR(terrier::storage::ProjectedRow **pr,
+                                        terrier::execution::sql::IndexIterator *iter) {
+  *pr = iter->KeyPR();
+}
+
 VM_OP_WARM void OpIndexIteratorGetSlot(terrier::storage::TupleSlot *slot,
                                        terrier::execution::sql::IndexIterator *iter) {
   *slot = iter->CurrentSlot();
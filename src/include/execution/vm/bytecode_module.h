@@ -1,9 +1,12 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "execution/sql/like_pattern.h"
+#include "execution/sql/string_in_list.h"
 #include "execution/vm/bytecode_function_info.h"
 #include "execution/vm/bytecode_iterator.h"
 #include "execution/vm/vm.h"
@@ -21,8 +24,12 @@ class BytecodeModule {
    * @param name The name of the module
    * @param code The bytecode that makes up the module
    * @param functions The functions within the module
+   * @param like_patterns The LIKE patterns the bytecode references by address, compiled when generating it
+   * @param in_lists The IN lists the bytecode references by address, built when generating it
    */
-  BytecodeModule(std::string name, std::vector<uint8_t> &&code, std::vector<FunctionInfo> &&functions);
+  BytecodeModule(std::string name, std::vector<uint8_t> &&code, std::vector<FunctionInfo> &&functions,
+                 std::vector<std::unique_ptr<sql::LikePattern>> &&like_patterns = {},
+                 std::vector<std::unique_ptr<sql::StringInList>> &&in_lists = {});
 
   /**
    * This class cannot be copied or moved
@@ -102,6 +109,8 @@ class BytecodeModule {
   const std::string name_;
   const std::vector<uint8_t> code_;
   const std::vector<FunctionInfo> functions_;
+  const std::vector<std::unique_ptr<sql::LikePattern>> like_patterns_;
+  const std::vector<std::unique_ptr<sql::StringInList>> in_lists_;
 };
 
 }  // namespace terrier::execution::vm
@@ -99,6 +99,7 @@ namespace terrier::execution::vm {
                                                                                                                       \
   /* Execution Context */                                                                                             \
   F(ExecutionContextGetMemoryPool, OperandType::Local, OperandType::Local)                                            \
+  F(ExecutionContextReportRows, OperandType::Local, OperandType::Local, OperandType::Local)                           \
                                                                                                                       \
   /* Thread State Container */                                                                                        \
   F(ThreadStateContainerInit, OperandType::Local, OperandType::Local)                                                 \
@@ -111,6 +112,10 @@ namespace terrier::execution::vm {
   F(TableVectorIteratorInit, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local,          \
     OperandType::UImm4)                                                                                               \
   F(TableVectorIteratorPerformInit, OperandType::Local)                                                               \
+  F(TableVectorIteratorAddRangeFilter, OperandType::Local, OperandType::UImm4, OperandType::Imm8, OperandType::Imm8)  \
+  F(TableVectorIteratorSetFilterColumns, OperandType::Local, OperandType::Local, OperandType::UImm4)                  \
+  F(TableVectorIteratorMaterialize, OperandType::Local)                                                               \
+  F(TableVectorIteratorFetchRow, OperandType::Local, OperandType::Local, OperandType::Local)                          \
   F(TableVectorIteratorNext, OperandType::Local, OperandType::Local)                                                  \
   F(TableVectorIteratorReset, OperandType::Local)                                                                     \
   F(TableVectorIteratorFree, OperandType::Local)                                                                      \
@@ -128,6 +133,8 @@ namespace terrier::execution::vm {
   F(PCIReset, OperandType::Local)                                                                                     \
   F(PCIResetFiltered, OperandType::Local)                                                                             \
   F(PCIGetSlot, OperandType::Local, OperandType::Local)                                                               \
+  F(PCIGetHash, OperandType::Local, OperandType::Local)                                                               \
+  F(PCIHashColumn, OperandType::Local, OperandType::UImm4, OperandType::Imm1, OperandType::Imm1)                       \
   F(PCIGetBool, OperandType::Local, OperandType::Local, OperandType::UImm2)                                           \
   F(PCIGetTinyInt, OperandType::Local, OperandType::Local, OperandType::UImm2)                                        \
   F(PCIGetSmallInt, OperandType::Local, OperandType::Local, OperandType::UImm2)                                       \
@@ -159,6 +166,10 @@ namespace terrier::execution::vm {
     OperandType::Imm8)                                                                                                \
   F(PCIFilterNotEqual, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1,                 \
     OperandType::Imm8)                                                                                                \
+  F(PCIFilterLike, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8)                     \
+  F(PCIFilterNotLike, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8)                  \
+  F(PCIFilterInList, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8)                   \
+  F(PCIFilterVector, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::UImm4)                  \
                                                                                                                       \
   /* Filter Manager */                                                                                                \
   F(FilterManagerInit, OperandType::Local)                                                                            \
@@ -176,6 +187,7 @@ namespace terrier::execution::vm {
   F(InitDate, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                         \
   F(InitString, OperandType::Local, OperandType::Imm8, OperandType::Imm8)                                             \
   F(InitVarlen, OperandType::Local, OperandType::Local)                                                               \
+  F(InitSqlNull, OperandType::Local)                                                                                  \
   F(LessThanBoolVal, OperandType::Local, OperandType::Local, OperandType::Local)                                      \
   F(LessThanEqualBoolVal, OperandType::Local, OperandType::Local, OperandType::Local)                                 \
   F(GreaterThanBoolVal, OperandType::Local, OperandType::Local, OperandType::Local)                                   \
@@ -233,6 +245,9 @@ namespace terrier::execution::vm {
   /* Aggregation Hash Table */                                                                                        \
   F(AggregationHashTableInit, OperandType::Local, OperandType::Local, OperandType::Local)                             \
   F(AggregationHashTableInsert, OperandType::Local, OperandType::Local, OperandType::Local)                           \
+  F(AggregationHashTableSetDenseRange, OperandType::Local, OperandType::Imm8, OperandType::Imm8)                      \
+  F(AggregationHashTableInsertDense, OperandType::Local, OperandType::Local, OperandType::Local)                      \
+  F(AggregationHashTableLookupDense, OperandType::Local, OperandType::Local, OperandType::Local)                      \
   F(AggregationHashTableLookup, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId,  \
     OperandType::Local)                                                                                               \
   F(AggregationHashTableProcessBatch, OperandType::Local, OperandType::Local, OperandType::FunctionId,                \
@@ -241,6 +256,9 @@ namespace terrier::execution::vm {
     OperandType::FunctionId)                                                                                          \
   F(AggregationHashTableParallelPartitionedScan, OperandType::Local, OperandType::Local, OperandType::Local,          \
     OperandType::FunctionId)                                                                                          \
+  F(AggregationHashTableNextSpilledPartition, OperandType::Local, OperandType::Local, OperandType::Local,             \
+    OperandType::FunctionId)                                                                                          \
+  F(AggregationHashTableGetSpilledPartition, OperandType::Local, OperandType::Local)                                  \
   F(AggregationHashTableFree, OperandType::Local)                                                                     \
   F(AggregationHashTableIteratorInit, OperandType::Local, OperandType::Local)                                         \
   F(AggregationHashTableIteratorHasNext, OperandType::Local, OperandType::Local)                                      \
@@ -307,6 +325,14 @@ namespace terrier::execution::vm {
   F(RealMinAggregateReset, OperandType::Local)                                                                        \
   F(RealMinAggregateGetResult, OperandType::Local, OperandType::Local)                                                \
   F(RealMinAggregateFree, OperandType::Local)                                                                         \
+  F(CountAggregateAdvanceBatch, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1)        \
+  F(IntegerSumAggregateAdvanceBatch, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1)   \
+  F(IntegerMaxAggregateAdvanceBatch, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1)   \
+  F(IntegerMinAggregateAdvanceBatch, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1)   \
+  F(RealSumAggregateAdvanceBatch, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1)      \
+  F(RealMaxAggregateAdvanceBatch, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1)      \
+  F(RealMinAggregateAdvanceBatch, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1)      \
+  F(AvgAggregateAdvanceBatch, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1)          \
                                                                                                                       \
   /* Hash Joins */                                                                                                    \
   F(JoinHashTableInit, OperandType::Local, OperandType::Local, OperandType::Local)                                    \
@@ -316,8 +342,20 @@ namespace terrier::execution::vm {
     OperandType::Local)                                                                                               \
   F(JoinHashTableIterGetRow, OperandType::Local, OperandType::Local)                                                  \
   F(JoinHashTableIterClose, OperandType::Local)                                                                       \
+  F(JoinHashTableEntryIteratorInit, OperandType::Local, OperandType::Local)                                           \
+  F(JoinHashTableEntryIteratorHasNext, OperandType::Local, OperandType::Local)                                        \
+  F(JoinHashTableEntryIteratorNext, OperandType::Local)                                                               \
+  F(JoinHashTableEntryIteratorGetRow, OperandType::Local, OperandType::Local)                                         \
   F(JoinHashTableBuild, OperandType::Local)                                                                           \
   F(JoinHashTableBuildParallel, OperandType::Local, OperandType::Local, OperandType::Local)                           \
+  F(JoinHashTableEnableBloomFilter, OperandType::Local)                                                               \
+  F(JoinHashTableFilterProbe, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId)     \
+  F(JoinHashTableGetTupleCount, OperandType::Local, OperandType::Local)                                               \
+  F(JoinHashTableIsPartitionSpilled, OperandType::Local, OperandType::Local, OperandType::Local)                      \
+  F(JoinHashTableSpillProbeTuple, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)      \
+  F(JoinHashTableNextSpilledPartition, OperandType::Local, OperandType::Local, OperandType::Local)                    \
+  F(JoinHashTableNextSpilledProbeTuple, OperandType::Local, OperandType::Local)                                       \
+  F(JoinHashTableGetSpilledProbeTuple, OperandType::Local, OperandType::Local)                                        \
   F(JoinHashTableFree, OperandType::Local)                                                                            \
                                                                                                                       \
   /* Sorting */                                                                                                       \
@@ -334,6 +372,17 @@ namespace terrier::execution::vm {
   F(SorterIteratorHasNext, OperandType::Local, OperandType::Local)                                                    \
   F(SorterIteratorNext, OperandType::Local)                                                                           \
   F(SorterIteratorFree, OperandType::Local)                                                                           \
+  F(MergeJoinCursorInit, OperandType::Local, OperandType::Local)                                                      \
+  F(MergeJoinCursorHasNext, OperandType::Local, OperandType::Local)                                                   \
+  F(MergeJoinCursorNext, OperandType::Local)                                                                          \
+  F(MergeJoinCursorGetRow, OperandType::Local, OperandType::Local)                                                    \
+  F(MergeJoinCursorAddToRun, OperandType::Local)                                                                      \
+  F(MergeJoinCursorClearRun, OperandType::Local)                                                                      \
+  F(MergeJoinCursorRunInit, OperandType::Local)                                                                       \
+  F(MergeJoinCursorRunHasNext, OperandType::Local, OperandType::Local)                                                \
+  F(MergeJoinCursorRunNext, OperandType::Local)                                                                       \
+  F(MergeJoinCursorRunGetRow, OperandType::Local, OperandType::Local)                                                 \
+  F(MergeJoinCursorFree, OperandType::Local)                                                                          \
                                                                                                                       \
   /* Output */                                                                                                        \
   F(OutputAlloc, OperandType::Local, OperandType::Local)                                                              \
@@ -343,17 +392,21 @@ namespace terrier::execution::vm {
   F(IndexIteratorInit, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::UImm4,                \
     OperandType::Local, OperandType::UImm4)                                                                           \
   F(IndexIteratorPerformInit, OperandType::Local)                                                                     \
+  F(IndexIteratorSetIndexOnly, OperandType::Local)                                                                    \
   F(IndexIteratorScanKey, OperandType::Local)                                                                         \
   F(IndexIteratorScanAscending, OperandType::Local)                                                                   \
   F(IndexIteratorScanDescending, OperandType::Local)                                                                  \
   F(IndexIteratorScanLimitAscending, OperandType::Local, OperandType::Local)                                          \
   F(IndexIteratorScanLimitDescending, OperandType::Local, OperandType::Local)                                         \
+  F(IndexIteratorAddRange, OperandType::Local)                                                                        \
+  F(IndexIteratorScanRanges, OperandType::Local)                                                                      \
   F(IndexIteratorFree, OperandType::Local)                                                                            \
   F(IndexIteratorAdvance, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorGetPR, OperandType::Local, OperandType::Local)                                                       \
   F(IndexIteratorGetLoPR, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorGetHiPR, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorGetTablePR, OperandType::Local, OperandType::Local)                                                  \
+  F(IndexIteratorGetKeyPR, OperandType::Local, OperandType::Local)                                                    \
   F(IndexIteratorGetSlot, OperandType::Local, OperandType::Local)                                                     \
                                                                                                                       \
   /* ProjectedRow */                                                                                                  \
@@ -441,9 +494,13 @@ namespace terrier::execution::vm {
   /* String functions */                                                                                              \
   F(Left, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                             \
   F(Length, OperandType::Local, OperandType::Local, OperandType::Local)                                               \
+  F(Like, OperandType::Local, OperandType::Local, OperandType::Local)                                                 \
+  F(LikeCompiled, OperandType::Local, OperandType::Local, OperandType::Imm8)                                          \
   F(Lower, OperandType::Local, OperandType::Local, OperandType::Local)                                                \
   F(LPad, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)         \
   F(LTrim, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                            \
+  F(NotLike, OperandType::Local, OperandType::Local, OperandType::Local)                                              \
+  F(NotLikeCompiled, OperandType::Local, OperandType::Local, OperandType::Imm8)                                       \
   F(Repeat, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                           \
   F(Reverse, OperandType::Local, OperandType::Local, OperandType::Local)                                              \
   F(Right, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                            \
@@ -13,6 +13,7 @@
 #include "execution/execution_util.h"
 #include "metrics/metrics_thread.h"
 #include "network/terrier_server.h"
+#include "optimizer/cost_model/stats_cost_model.h"
 #include "optimizer/statistics/stats_storage.h"
 #include "settings/settings_manager.h"
 #include "settings/settings_param.h"
@@ -347,7 +348,8 @@ class DBMain {
         TERRIER_ASSERT(use_execution_ && execution_layer != DISABLED, "TrafficCopLayer needs ExecutionLayer.");
         traffic_cop = std::make_unique<trafficcop::TrafficCop>(
             txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(), DISABLED,
-            common::ManagedPointer(stats_storage), optimizer_timeout_);
+            common::ManagedPointer(stats_storage), optimizer_timeout_, optimizer_workers_, query_memory_limit_,
+            cost_model_params_);
       }
 
       std::unique_ptr<NetworkLayer> network_layer = DISABLED;
@@ -582,6 +584,33 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetOptimizerWorkers(const uint32_t value) {
+      optimizer_workers_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetQueryMemoryLimit(const uint64_t value) {
+      query_memory_limit_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetCostModelParameters(const optimizer::CostModelParameters &value) {
+      cost_model_params_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -621,6 +650,9 @@ class DBMain {
     bool use_execution_ = false;
     bool use_traffic_cop_ = false;
     uint64_t optimizer_timeout_ = 5000;
+    uint32_t optimizer_workers_ = 1;
+    uint64_t query_memory_limit_ = 0;
+    optimizer::CostModelParameters cost_model_params_;
     uint16_t network_port_ = 15721;
     bool use_network_ = false;
 
@@ -652,6 +684,18 @@ class DBMain {
 
       network_port_ = static_cast<uint16_t>(settings_manager->GetInt(settings::Param::port));
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
+      optimizer_workers_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::optimizer_workers));
+      query_memory_limit_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::query_memory_limit));
+      cost_model_params_.seq_tuple_cost_ = settings_manager->GetDouble(settings::Param::cost_seq_tuple);
+      cost_model_params_.cpu_operator_cost_ = settings_manager->GetDouble(settings::Param::cost_cpu_operator);
+      cost_model_params_.index_probe_cost_ = settings_manager->GetDouble(settings::Param::cost_index_probe);
+      cost_model_params_.index_tuple_cost_ = settings_manager->GetDouble(settings::Param::cost_index_tuple);
+      cost_model_params_.hash_build_cost_ = settings_manager->GetDouble(settings::Param::cost_hash_build);
+      cost_model_params_.hash_probe_cost_ = settings_manager->GetDouble(settings::Param::cost_hash_probe);
+      cost_model_params_.sort_compare_cost_ = settings_manager->GetDouble(settings::Param::cost_sort_compare);
+      cost_model_params_.output_tuple_cost_ = settings_manager->GetDouble(settings::Param::cost_output_tuple);
+      cost_model_params_.spill_tuple_cost_ = settings_manager->GetDouble(settings::Param::cost_spill_tuple);
+      cost_model_params_.tuple_width_ = settings_manager->GetDouble(settings::Param::cost_tuple_width);
 
       return settings_manager;
     }
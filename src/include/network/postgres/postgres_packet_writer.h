@@ -229,6 +229,9 @@ class PostgresPacketWriter : public PacketWriter {
       case QueryType::QUERY_SET:
         WriteCommandComplete("SET");
         break;
+      case QueryType::QUERY_ANALYZE:
+        WriteCommandComplete("ANALYZE");
+        break;
       default:
         WriteCommandComplete("This QueryType needs a completion message!");
         break;
@@ -134,6 +134,18 @@ class ChildPropertyDeriver : public OperatorVisitor {
    */
   void Visit(const OuterHashJoin *op) override;
 
+  /**
+   * Visitor function for SemiHashJoin
+   * @param op SemiHashJoin operator to visit
+   */
+  void Visit(const SemiHashJoin *op) override;
+
+  /**
+   * Visitor function for InnerMergeJoin
+   * @param op InnerMergeJoin operator to visit
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
   /**
    * Visitor function for Insert
    * @param op Insert operator to visit
@@ -262,8 +274,10 @@ class ChildPropertyDeriver : public OperatorVisitor {
  private:
   /**
    * Derives properties for a JOIN
+   * @param preserves_probe_order whether the join emits tuples in the order of its probe (right) child, so that a
+   *        sort on probe columns can be pushed down
    */
-  void DeriveForJoin();
+  void DeriveForJoin(bool preserves_probe_order);
 
   /**
    * Any property requirements
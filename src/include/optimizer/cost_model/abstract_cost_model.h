@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+
+#include "common/macros.h"
 #include "optimizer/operator_visitor.h"
 
 namespace terrier {
@@ -26,6 +29,24 @@ class AbstractCostModel : public OperatorVisitor {
    * @param gexpr GroupExpression to calculate cost for
    */
   virtual double CalculateCost(transaction::TransactionContext *txn, Memo *memo, GroupExpression *gexpr) = 0;
+
+  /**
+   * Estimates the cost of joining two inputs of the given sizes, without a GroupExpression, so that the join
+   * enumerator can price join orders before they are in the Memo. The left input is the build side of a hash join
+   * and the outer side of a nested loop join. Must be safe to call concurrently with CalculateCost.
+   * The default counts the tuples the join produces.
+   * @param left_rows estimated number of rows of the left input
+   * @param right_rows estimated number of rows of the right input
+   * @param output_rows estimated number of rows the join produces
+   * @param num_predicates number of join predicates evaluated by the join
+   * @param has_equi_keys whether an equality predicate lets the join be a hash join
+   * @returns estimated cost of the join, not including the costs of its inputs
+   */
+  virtual double EstimateJoinCost(UNUSED_ATTRIBUTE double left_rows, UNUSED_ATTRIBUTE double right_rows,
+                                  double output_rows, UNUSED_ATTRIBUTE size_t num_predicates,
+                                  UNUSED_ATTRIBUTE bool has_equi_keys) const {
+    return output_rows;
+  }
 };
 
 }  // namespace optimizer
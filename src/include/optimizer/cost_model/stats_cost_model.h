@@ -0,0 +1,290 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "common/managed_pointer.h"
+#include "optimizer/cost_model/abstract_cost_model.h"
+#include "optimizer/optimizer_defs.h"
+
+namespace terrier {
+
+namespace transaction {
+class TransactionContext;
+}
+
+namespace optimizer {
+
+class GroupExpression;
+class Memo;
+class StatsStorage;
+
+/**
+ * The unit costs the StatsCostModel combines, in nanoseconds. The defaults were measured on a development machine by
+ * benchmark/optimizer/cost_model_calibration_benchmark.cpp; rerun that benchmark to calibrate them for another host,
+ * and set the cost_* settings to its results.
+ */
+struct CostModelParameters {
+  /**
+   * Read one tuple in a sequential scan
+   */
+  double seq_tuple_cost_ = 4.0;
+
+  /**
+   * Evaluate one predicate (or compare one key) on one tuple
+   */
+  double cpu_operator_cost_ = 2.0;
+
+  /**
+   * Descend one level of an index, i.e. the cost of an index lookup is this times log2 of the table size
+   */
+  double index_probe_cost_ = 25.0;
+
+  /**
+   * Fetch one tuple from the table through a TupleSlot returned by an index
+   */
+  double index_tuple_cost_ = 90.0;
+
+  /**
+   * Insert one tuple into a join or aggregation hash table
+   */
+  double hash_build_cost_ = 30.0;
+
+  /**
+   * Probe a hash table with one tuple
+   */
+  double hash_probe_cost_ = 20.0;
+
+  /**
+   * One comparison of a sort, i.e. sorting n tuples costs this times n * log2(n)
+   */
+  double sort_compare_cost_ = 6.0;
+
+  /**
+   * Hand one tuple to the parent operator
+   */
+  double output_tuple_cost_ = 1.0;
+
+  /**
+   * Write one tuple to a spill file and read it back
+   */
+  double spill_tuple_cost_ = 250.0;
+
+  /**
+   * The assumed size of a materialized tuple, in bytes
+   */
+  double tuple_width_ = 64.0;
+
+  /**
+   * The memory a hash table or sort may use before it spills, in bytes. The TrafficCop sets it to the
+   * query_memory_limit setting.
+   */
+  double memory_budget_ = std::numeric_limits<double>::max();
+};
+
+/**
+ * Cost model that prices each physical operator by the CPU, memory and I/O work it does on the cardinalities that
+ * StatsCalculator derived for its group and its children's groups. Groups without an estimate (tables that were never
+ * analyzed) are assumed to hold K_DEFAULT_NUM_ROWS rows. The cost of a GroupExpression does not include the costs of
+ * its children, which the optimizer adds on top.
+ */
+class StatsCostModel : public AbstractCostModel {
+ public:
+  /**
+   * The number of rows assumed for tables and groups without statistics
+   */
+  static constexpr double K_DEFAULT_NUM_ROWS = 1000.0;
+
+  /**
+   * @param stats_storage storage to read base table sizes from
+   * @param params unit costs of the model
+   */
+  explicit StatsCostModel(common::ManagedPointer<StatsStorage> stats_storage, CostModelParameters params = {})
+      : stats_storage_(stats_storage), params_(params) {}
+
+  /**
+   * Costs a GroupExpression
+   * @param txn TransactionContext that query is generated under
+   * @param memo Memo object containing all relevant groups
+   * @param gexpr GroupExpression to calculate cost for
+   */
+  double CalculateCost(transaction::TransactionContext *txn, Memo *memo, GroupExpression *gexpr) override;
+
+  /**
+   * Estimates the cost of the cheaper of a nested loop join and, given equi keys, a hash join
+   * @param left_rows estimated number of rows of the left input
+   * @param right_rows estimated number of rows of the right input
+   * @param output_rows estimated number of rows the join produces
+   * @param num_predicates number of join predicates evaluated by the join
+   * @param has_equi_keys whether an equality predicate lets the join be a hash join
+   * @returns estimated cost of the join, not including the costs of its inputs
+   */
+  double EstimateJoinCost(double left_rows, double right_rows, double output_rows, size_t num_predicates,
+                          bool has_equi_keys) const override;
+
+  /**
+   * Visit a SeqScan operator
+   * @param op operator
+   */
+  void Visit(const SeqScan *op) override;
+
+  /**
+   * Visit a IndexScan operator
+   * @param op operator
+   */
+  void Visit(const IndexScan *op) override;
+
+  /**
+   * Visit a QueryDerivedScan operator
+   * @param op operator
+   */
+  void Visit(const QueryDerivedScan *op) override;
+
+  /**
+   * Visit a OrderBy operator
+   * @param op operator
+   */
+  void Visit(const OrderBy *op) override;
+
+  /**
+   * Visit a Limit operator
+   * @param op operator
+   */
+  void Visit(const Limit *op) override;
+
+  /**
+   * Visit a InnerNLJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerNLJoin *op) override;
+
+  /**
+   * Visit a LeftNLJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftNLJoin *op) override;
+
+  /**
+   * Visit a RightNLJoin operator
+   * @param op operator
+   */
+  void Visit(const RightNLJoin *op) override;
+
+  /**
+   * Visit a OuterNLJoin operator
+   * @param op operator
+   */
+  void Visit(const OuterNLJoin *op) override;
+
+  /**
+   * Visit a InnerHashJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerHashJoin *op) override;
+
+  /**
+   * Visit a LeftHashJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftHashJoin *op) override;
+
+  /**
+   * Visit a RightHashJoin operator
+   * @param op operator
+   */
+  void Visit(const RightHashJoin *op) override;
+
+  /**
+   * Visit a OuterHashJoin operator
+   * @param op operator
+   */
+  void Visit(const OuterHashJoin *op) override;
+
+  /**
+   * Visit a SemiHashJoin operator
+   * @param op operator
+   */
+  void Visit(const SemiHashJoin *op) override;
+
+  /**
+   * Visit a InnerMergeJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
+  /**
+   * Visit a HashGroupBy operator
+   * @param op operator
+   */
+  void Visit(const HashGroupBy *op) override;
+
+  /**
+   * Visit a SortGroupBy operator
+   * @param op operator
+   */
+  void Visit(const SortGroupBy *op) override;
+
+  /**
+   * Visit a Aggregate operator
+   * @param op operator
+   */
+  void Visit(const Aggregate *op) override;
+
+ private:
+  // The estimated number of rows of a group
+  double GroupRows(group_id_t group_id) const;
+
+  // The estimated number of rows of the group being costed and of its children
+  double OutputRows() const;
+  double ChildRows(int child_idx) const;
+
+  // The cost of writing out and reading back spilled_rows tuples if state_rows tuples overflow the memory budget, or 0
+  // if they fit
+  double SpillCost(double state_rows, double spilled_rows) const;
+
+  // The cost of sorting num_rows tuples that were already materialized, including their spill
+  double SortCost(double num_rows) const;
+
+  // Costs shared by the join flavors, which only differ in which unmatched tuples they emit
+  void CostNLJoin(size_t num_predicates);
+  void CostHashJoin();
+  double NLJoinCost(double outer_rows, double inner_rows, double output_rows, size_t num_predicates) const;
+  double HashJoinCost(double build_rows, double probe_rows, double output_rows) const;
+
+  // The number of distinct groups the given columns split the child into
+  double EstimateNumGroups(const std::vector<common::ManagedPointer<parser::AbstractExpression>> &columns) const;
+
+  /**
+   * Storage of the base table statistics
+   */
+  common::ManagedPointer<StatsStorage> stats_storage_;
+
+  /**
+   * Unit costs
+   */
+  CostModelParameters params_;
+
+  /**
+   * GroupExpression to cost
+   */
+  GroupExpression *gexpr_;
+
+  /**
+   * Memo table to use
+   */
+  Memo *memo_;
+
+  /**
+   * Transaction Context
+   */
+  transaction::TransactionContext *txn_;
+
+  /**
+   * Computed output cost
+   */
+  double output_cost_ = 0;
+};
+
+}  // namespace optimizer
+}  // namespace terrier
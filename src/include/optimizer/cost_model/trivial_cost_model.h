@@ -15,7 +15,8 @@ class GroupExpression;
  * This cost model is meant to just be a trivial cost model. The decisions it makes are as follows
  * Always choose index scan (cost of 0) over sequential scan (cost of 1)
  * Choose NL if left rows is a single record (for single record lookup queries), else choose hash join
- * Choose hash group by over sort group by
+ * Choose sort group by if the child already provides the sort order (cost of 0), else hash group by (cost of 1)
+ * over sort group by with an explicit sort (cost of 2)
  */
 class TrivialCostModel : public AbstractCostModel {
  public:
@@ -60,7 +61,7 @@ class TrivialCostModel : public AbstractCostModel {
    * Visit a OrderBy operator
    * @param op operator
    */
-  void Visit(UNUSED_ATTRIBUTE const OrderBy *op) override { output_cost_ = 0.f; }
+  void Visit(UNUSED_ATTRIBUTE const OrderBy *op) override { output_cost_ = 2.f; }
 
   /**
    * Visit a Limit operator
@@ -102,19 +103,31 @@ class TrivialCostModel : public AbstractCostModel {
    * Visit a LeftHashJoin operator
    * @param op operator
    */
-  void Visit(UNUSED_ATTRIBUTE const LeftHashJoin *op) override {}
+  void Visit(UNUSED_ATTRIBUTE const LeftHashJoin *op) override { output_cost_ = 1.f; }
 
   /**
    * Visit a RightHashJoin operator
    * @param op operator
    */
-  void Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) override {}
+  void Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) override { output_cost_ = 1.f; }
 
   /**
    * Visit a OuterHashJoin operator
    * @param op operator
    */
-  void Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) override {}
+  void Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) override { output_cost_ = 1.f; }
+
+  /**
+   * Visit a SemiHashJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const SemiHashJoin *op) override { output_cost_ = 1.f; }
+
+  /**
+   * Visit a InnerMergeJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const InnerMergeJoin *op) override { output_cost_ = 2.f; }
 
   /**
    * Visit a Insert operator
@@ -144,13 +157,13 @@ class TrivialCostModel : public AbstractCostModel {
    * Visit a HashGroupBy operator
    * @param op operator
    */
-  void Visit(UNUSED_ATTRIBUTE const HashGroupBy *op) override { output_cost_ = 0.f; }
+  void Visit(UNUSED_ATTRIBUTE const HashGroupBy *op) override { output_cost_ = 1.f; }
 
   /**
    * Visit a SortGroupBy operator
    * @param op operator
    */
-  void Visit(UNUSED_ATTRIBUTE const SortGroupBy *op) override { output_cost_ = 1.f; }
+  void Visit(UNUSED_ATTRIBUTE const SortGroupBy *op) override { output_cost_ = 0.f; }
 
   /**
    * Visit a Aggregate operator
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -8,6 +9,8 @@
 #include <utility>
 #include <vector>
 
+#include "common/hash_util.h"
+#include "common/spin_latch.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/operator_node.h"
 #include "optimizer/optimizer_defs.h"
@@ -19,10 +22,49 @@ namespace terrier::optimizer {
 
 class GroupExpression;
 
+/**
+ * Orders plans of equal cost, so that the chosen plan does not depend on the order in which the optimizer workers
+ * costed them. Plans closer to the query as stated come first, and the others are ordered by the hash of their
+ * operators.
+ */
+struct PlanKey {
+  /**
+   * Number of expressions of the plan that the optimizer derived
+   */
+  uint32_t derived_ = 0;
+
+  /**
+   * Hash of the operators of the plan
+   */
+  common::hash_t hash_ = 0;
+
+  /**
+   * Adds the key of an input of the plan
+   * @param input key of the input
+   * @returns this key
+   */
+  PlanKey &Append(const PlanKey &input) {
+    derived_ += input.derived_;
+    hash_ = common::HashUtil::CombineHashes(hash_, input.hash_);
+    return *this;
+  }
+
+  /**
+   * @param other key of another plan
+   * @returns whether this plan is preferred over the other
+   */
+  bool operator<(const PlanKey &other) const {
+    return derived_ < other.derived_ || (derived_ == other.derived_ && hash_ < other.hash_);
+  }
+};
+
 /**
  * Group collects together GroupExpressions that represent logically
  * equivalent expression trees.  A Group tracks both logical and
  * physical GroupExpressions.
+ *
+ * A Group may be accessed by several optimizer workers at once, so its
+ * expressions, costs and stats are protected by a latch.
  */
 class Group {
  public:
@@ -32,7 +74,7 @@ class Group {
    * @param table_aliases Set of table aliases used by the Group
    */
   Group(group_id_t id, std::unordered_set<std::string> table_aliases)
-      : id_(id), table_aliases_(std::move(table_aliases)), has_explored_(false) {}
+      : id_(id), table_aliases_(std::move(table_aliases)), exploration_state_(ExplorationState::UNEXPLORED) {}
 
   /**
    * Destructor
@@ -57,12 +99,13 @@ class Group {
    * @param expr GroupExpression whose metadata is to be updated
    * @param cost Cost
    * @param properties PropertySet satisfied by GroupExpression
+   * @param plan_key key of the plan rooted at expr, which breaks ties with plans of equal cost
    * @returns TRUE if expr recorded
    *
    * @note properties becomes owned by Group!
    * @note properties lifetime after not guaranteed
    */
-  bool SetExpressionCost(GroupExpression *expr, double cost, PropertySet *properties);
+  bool SetExpressionCost(GroupExpression *expr, double cost, PropertySet *properties, const PlanKey &plan_key);
 
   /**
    * Gets the best expression existing for a group satisfying
@@ -73,6 +116,13 @@ class Group {
    */
   GroupExpression *GetBestExpression(PropertySet *properties);
 
+  /**
+   * Gets the plan key of the best expression for a PropertySet
+   * @param properties PropertySet to use for search
+   * @returns the plan key passed to SetExpressionCost with the best expression
+   */
+  PlanKey GetBestPlanKey(PropertySet *properties);
+
   /**
    * Determines whether or not a lowest cost expression exists
    * for this group that satisfies a certain PropertySet.
@@ -89,15 +139,21 @@ class Group {
 
   /**
    * Gets the vector of all logical expressions
-   * @returns Logical expressions belonging to this group
+   * @returns Logical expressions belonging to this group, as of the call
    */
-  const std::vector<GroupExpression *> &GetLogicalExpressions() const { return logical_expressions_; }
+  std::vector<GroupExpression *> GetLogicalExpressions() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return logical_expressions_;
+  }
 
   /**
    * Gets the vector of all physical expressions
-   *@returns Physical expressions belonging to this group
+   *@returns Physical expressions belonging to this group, as of the call
    */
-  const std::vector<GroupExpression *> &GetPhysicalExpressions() const { return physical_expressions_; }
+  std::vector<GroupExpression *> GetPhysicalExpressions() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return physical_expressions_;
+  }
 
   /**
    * Gets the cost lower bound
@@ -106,16 +162,26 @@ class Group {
    */
   double GetCostLB() { return cost_lower_bound_; }
 
+  /**
+   * Claims the exploration of the group for the calling task, if no
+   * other task has claimed it.
+   * @returns TRUE if the caller has to explore the group
+   */
+  bool StartExploration() {
+    auto expected = ExplorationState::UNEXPLORED;
+    return exploration_state_.compare_exchange_strong(expected, ExplorationState::EXPLORING);
+  }
+
   /**
    * Sets a flag indicating the group has been explored
    */
-  void SetExplorationFlag() { has_explored_ = true; }
+  void SetExplorationFlag() { exploration_state_ = ExplorationState::EXPLORED; }
 
   /**
    * Checks whether this group has been explored yet.
-   * @returns TRUE if explored
+   * @returns TRUE if explored, FALSE if unexplored or being explored
    */
-  bool HasExplored() { return has_explored_; }
+  bool HasExplored() { return exploration_state_ == ExplorationState::EXPLORED; }
 
   /**
    * Sets Number of rows
@@ -129,11 +195,25 @@ class Group {
    */
   int GetNumRows() { return num_rows_; }
 
+  /**
+   * Sets the key under which the executor reports the rows of this group to the CardinalityFeedback
+   * @param fragment_key hash of the logical expression of the group and the keys of its children
+   */
+  void SetFragmentKey(common::hash_t fragment_key) { fragment_key_ = fragment_key; }
+
+  /**
+   * Gets the key of the part of the query this group computes. Groups with the same key in different queries produce
+   * the same rows.
+   * @returns the fragment key, or 0 if the rows of the group are not tracked
+   */
+  common::hash_t GetFragmentKey() { return fragment_key_; }
+
   /**
    * Get stats for a column
    * @param column_name Column to get stats for
    */
   common::ManagedPointer<ColumnStats> GetStats(const std::string &column_name) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     TERRIER_ASSERT(stats_.count(column_name) != 0U, "Column Stats missing");
     return common::ManagedPointer<ColumnStats>(stats_[column_name].get());
   }
@@ -142,7 +222,10 @@ class Group {
    * Checks if there are stats for a column
    * @param column_name Column to check
    */
-  bool HasColumnStats(const std::string &column_name) { return stats_.count(column_name) != 0U; }
+  bool HasColumnStats(const std::string &column_name) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return stats_.count(column_name) != 0U;
+  }
 
   /**
    * Add stats for a column
@@ -150,7 +233,11 @@ class Group {
    * @param stats Stats to add
    */
   void AddStats(const std::string &column_name, std::unique_ptr<ColumnStats> stats) {
-    stats_[column_name] = std::move(stats);
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    auto &entry = stats_[column_name];
+    // Another worker may still read the stats being replaced
+    if (entry != nullptr) retired_stats_.emplace_back(std::move(entry));
+    entry = std::move(stats);
   }
 
   /**
@@ -176,6 +263,11 @@ class Group {
   }
 
  private:
+  /**
+   * Progress of the exploration of the group's logical expressions
+   */
+  enum class ExplorationState : uint8_t { UNEXPLORED, EXPLORING, EXPLORED };
+
   /**
    * Group ID
    */
@@ -188,15 +280,20 @@ class Group {
   std::unordered_set<std::string> table_aliases_;
 
   /**
-   * Mapping from property requirements to a pair of (cost, GroupExpression)
+   * Mapping from property requirements to a tuple of (cost, GroupExpression, plan key)
    */
-  std::unordered_map<PropertySet *, std::tuple<double, GroupExpression *>, PropSetPtrHash, PropSetPtrEq>
+  std::unordered_map<PropertySet *, std::tuple<double, GroupExpression *, PlanKey>, PropSetPtrHash, PropSetPtrEq>
       lowest_cost_expressions_;
 
   /**
    * Whether equivalent logical expressions have been explored for this group
    */
-  bool has_explored_;
+  std::atomic<ExplorationState> exploration_state_;
+
+  /**
+   * Latch protecting the expressions, costs and stats of the group
+   */
+  mutable common::SpinLatch latch_;
 
   /**
    * Vector of equivalent logical expressions
@@ -221,10 +318,20 @@ class Group {
    */
   std::unordered_map<std::string, std::unique_ptr<ColumnStats>> stats_;
 
+  /**
+   * Stats replaced in stats_, kept alive until the group is freed
+   */
+  std::vector<std::unique_ptr<ColumnStats>> retired_stats_;
+
   /**
    * Number of rows
    */
-  int num_rows_ = -1;
+  std::atomic<int> num_rows_{-1};
+
+  /**
+   * Key of the rows of the group in the CardinalityFeedback
+   */
+  std::atomic<common::hash_t> fragment_key_{0};
 
   /**
    * Cost Lower Bound
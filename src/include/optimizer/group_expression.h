@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <bitset>
 #include <map>
 #include <tuple>
@@ -8,6 +9,7 @@
 #include <vector>
 
 #include "common/hash_util.h"
+#include "common/spin_latch.h"
 #include "optimizer/group.h"
 #include "optimizer/operator_node.h"
 #include "optimizer/optimizer_defs.h"
@@ -19,7 +21,8 @@ namespace terrier::optimizer {
 /**
  * GroupExpression used to represent a particular logical or physical
  * operator expression within a group that abstracts away the specific
- * OperatorExpression of a Group.
+ * OperatorExpression of a Group. The explored rules and the costs are
+ * protected by a latch, as optimizer workers may share the expression.
  */
 class GroupExpression {
  public:
@@ -27,9 +30,14 @@ class GroupExpression {
    * Constructor for GroupExpression
    * @param op Operator
    * @param child_groups Vector of children groups
+   * @param derived whether the optimizer derived the expression from others, rather than the query stating it
    */
-  GroupExpression(Operator op, std::vector<group_id_t> &&child_groups)
-      : group_id_(UNDEFINED_GROUP), op_(std::move(op)), child_groups_(child_groups), stats_derived_(false) {}
+  GroupExpression(Operator op, std::vector<group_id_t> &&child_groups, bool derived = false)
+      : group_id_(UNDEFINED_GROUP),
+        op_(std::move(op)),
+        child_groups_(child_groups),
+        derived_(derived),
+        stats_derived_(false) {}
 
   /**
    * Destructor. Deletes everything in the lowest_cost_table_
@@ -86,7 +94,10 @@ class GroupExpression {
    * @param requirements PropertySet that needs to be satisfied
    * @returns Lowest cost to satisfy that PropertySet
    */
-  double GetCost(PropertySet *requirements) const { return std::get<0>(lowest_cost_table_.find(requirements)->second); }
+  double GetCost(PropertySet *requirements) const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return std::get<0>(lowest_cost_table_.find(requirements)->second);
+  }
 
   /**
    * Gets the input properties needed for a given required properties
@@ -94,6 +105,7 @@ class GroupExpression {
    * @returns vector of children input properties required
    */
   std::vector<PropertySet *> GetInputProperties(PropertySet *requirements) const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     return std::get<1>(lowest_cost_table_.find(requirements)->second);
   }
 
@@ -128,14 +140,20 @@ class GroupExpression {
    * Marks a rule as having being explored in this GroupExpression
    * @param rule Rule to mark as explored
    */
-  void SetRuleExplored(Rule *rule) { rule_mask_.set(rule->GetRuleIdx(), true); }
+  void SetRuleExplored(Rule *rule) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    rule_mask_.set(rule->GetRuleIdx(), true);
+  }
 
   /**
    * Checks whether a rule has been explored
    * @param rule Rule to see if explored
    * @returns TRUE if the rule has been explored already
    */
-  bool HasRuleExplored(Rule *rule) { return rule_mask_.test(rule->GetRuleIdx()); }
+  bool HasRuleExplored(Rule *rule) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return rule_mask_.test(rule->GetRuleIdx());
+  }
 
   /**
    * Sets a flag indicating stats have been derived
@@ -153,6 +171,13 @@ class GroupExpression {
    */
   size_t GetChildrenGroupsSize() const { return child_groups_.size(); }
 
+  /**
+   * Checks whether the optimizer derived this expression from others, e.g. a reordered join or an implementation of
+   * a derived logical expression
+   * @returns TRUE if derived, FALSE if the query (after rewriting) states the expression
+   */
+  bool IsDerived() const { return derived_; }
+
  private:
   /**
    * Group's ID
@@ -169,6 +194,11 @@ class GroupExpression {
    */
   std::vector<group_id_t> child_groups_;
 
+  /**
+   * Whether the optimizer derived the expression from others
+   */
+  const bool derived_;
+
   /**
    * Mask of explored rules
    */
@@ -177,7 +207,12 @@ class GroupExpression {
   /**
    * Flag of whether stats are derived
    */
-  bool stats_derived_;
+  std::atomic<bool> stats_derived_;
+
+  /**
+   * Latch protecting rule_mask_ and lowest_cost_table_
+   */
+  mutable common::SpinLatch latch_;
 
   /**
    * Mapping from output properties to the corresponding best cost, statistics,
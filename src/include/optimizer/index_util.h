@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -10,6 +14,7 @@
 #include "catalog/index_schema.h"
 #include "optimizer/properties.h"
 #include "parser/expression_util.h"
+#include "storage/index/index.h"
 #include "type/transient_value_factory.h"
 
 namespace terrier::optimizer {
@@ -41,11 +46,19 @@ struct IndexUtilMetadata {
   std::vector<parser::ExpressionType> &GetPredicateExprTypes() { return predicate_expr_types_; }
 
   /**
-   * Returns the predicate TransientValue vector
+   * Returns the predicate TransientValue vector. A COMPARE_IN predicate, which is a disjunction of equalities on one
+   * column, has no single value, and is given a NULL INTEGER.
    * @returns vector of predicates TransientValue
    */
   std::vector<type::TransientValue> &GetPredicateValues() { return predicate_values_; }
 
+  /**
+   * Returns the number of values each predicate compares its column to. This is one, except for COMPARE_IN
+   * predicates, whose column is compared to every value of the list.
+   * @returns vector of predicates value counts
+   */
+  std::vector<uint32_t> &GetPredicateNumValues() { return predicate_num_values_; }
+
  private:
   /**
    * Sets the predicate_column_ids_ vector
@@ -65,6 +78,12 @@ struct IndexUtilMetadata {
    */
   void SetPredicateValues(std::vector<type::TransientValue> &&values) { predicate_values_ = std::move(values); }
 
+  /**
+   * Sets the predicate_num_values_ vector
+   * @param num_values Vector of value counts for predicates
+   */
+  void SetPredicateNumValues(std::vector<uint32_t> &&num_values) { predicate_num_values_ = std::move(num_values); }
+
   /**
    * Vector of predicate col_oid_t
    */
@@ -79,8 +98,20 @@ struct IndexUtilMetadata {
    * Vector of predicates values
    */
   std::vector<type::TransientValue> predicate_values_;
+
+  /**
+   * Vector of the number of values each predicate compares its column to
+   */
+  std::vector<uint32_t> predicate_num_values_;
 };
 
+/**
+ * Lower and upper bound of one key range of an index scan, with one value for every index column in key order.
+ * A nullptr bound leaves the column open on that side.
+ */
+using IndexKeyBounds = std::pair<std::vector<common::ManagedPointer<parser::AbstractExpression>>,
+                                 std::vector<common::ManagedPointer<parser::AbstractExpression>>>;
+
 /**
  * Collection of helper functions related to working with Indexes
  * within the scope of the optimizer.
@@ -174,35 +205,35 @@ class IndexUtil {
     // List of values compared against
     std::vector<type::TransientValue> value_list;
 
+    // List of the number of values compared against
+    std::vector<uint32_t> num_values_list;
+
     for (auto &pred : predicates) {
       auto expr = pred.GetExpr();
-      if (expr->GetChildrenSize() != 2) {
+
+      // A disjunction of equalities on one column (which is what IN lists are parsed into) probes several points
+      if (expr->GetExpressionType() == parser::ExpressionType::CONJUNCTION_OR) {
+        std::vector<common::ManagedPointer<parser::AbstractExpression>> points;
+        auto col_expr = GetPointList(expr, &points);
+        if (col_expr != nullptr) {
+          TERRIER_ASSERT(col_expr->GetColumnOid() != catalog::col_oid_t(-1),
+                         "ColumnValueExpression at scan should be bound");
+          key_column_id_list.push_back(col_expr->GetColumnOid());
+          expr_type_list.push_back(parser::ExpressionType::COMPARE_IN);
+          value_list.push_back(type::TransientValueFactory::GetNull(type::TypeId::INTEGER));
+          num_values_list.push_back(static_cast<uint32_t>(points.size()));
+        }
         continue;
       }
 
       // Fetch column reference and value
-      auto expr_type = expr->GetExpressionType();
-      common::ManagedPointer<parser::AbstractExpression> tv_expr;
+      parser::ExpressionType expr_type;
       common::ManagedPointer<parser::AbstractExpression> value_expr;
-      if (expr->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
-        auto r_type = expr->GetChild(1)->GetExpressionType();
-        if (r_type == parser::ExpressionType::VALUE_CONSTANT || r_type == parser::ExpressionType::VALUE_PARAMETER) {
-          tv_expr = expr->GetChild(0);
-          value_expr = expr->GetChild(1);
-        }
-      } else if (expr->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
-        auto l_type = expr->GetChild(0)->GetExpressionType();
-        if (l_type == parser::ExpressionType::VALUE_CONSTANT || l_type == parser::ExpressionType::VALUE_PARAMETER) {
-          tv_expr = expr->GetChild(1);
-          value_expr = expr->GetChild(0);
-          expr_type = parser::ExpressionUtil::ReverseComparisonExpressionType(expr_type);
-        }
-      }
+      auto col_expr = GetColumnComparison(expr, &expr_type, &value_expr);
 
       // If found valid tv_expr and value_expr, update col_id_list, expr_type_list and val_list
-      if (tv_expr != nullptr) {
+      if (col_expr != nullptr) {
         // Get the column's col_oid_t from catalog
-        auto col_expr = tv_expr.CastManagedPointerTo<parser::ColumnValueExpression>();
         auto col_oid = col_expr->GetColumnOid();
         TERRIER_ASSERT(col_oid != catalog::col_oid_t(-1), "ColumnValueExpression at scan should be bound");
         key_column_id_list.push_back(col_oid);
@@ -218,12 +249,14 @@ class IndexUtil {
           auto poe = value_expr.CastManagedPointerTo<parser::ParameterValueExpression>();
           value_list.push_back(type::TransientValueFactory::GetParameterOffset(poe->GetValueIdx()));
         }
+        num_values_list.push_back(1);
       }
     }
 
     metadata->SetPredicateColumnIds(std::move(key_column_id_list));
     metadata->SetPredicateExprTypes(std::move(expr_type_list));
     metadata->SetPredicateValues(std::move(value_list));
+    metadata->SetPredicateNumValues(std::move(num_values_list));
   }
 
   /**
@@ -258,12 +291,15 @@ class IndexUtil {
     std::vector<catalog::col_oid_t> output_col_list;
     std::vector<parser::ExpressionType> output_expr_list;
     std::vector<type::TransientValue> output_val_list;
+    std::vector<uint32_t> output_num_values_list;
 
     // From predicate maetadata
     auto &input_col_list = preds_metadata->GetPredicateColumnIds();
     auto &input_expr_list = preds_metadata->GetPredicateExprTypes();
     auto &input_val_list = preds_metadata->GetPredicateValues();
-    TERRIER_ASSERT(input_col_list.size() == input_expr_list.size() && input_col_list.size() == input_val_list.size(),
+    auto &input_num_values_list = preds_metadata->GetPredicateNumValues();
+    TERRIER_ASSERT(input_col_list.size() == input_expr_list.size() && input_col_list.size() == input_val_list.size() &&
+                       input_col_list.size() == input_num_values_list.size(),
                    "Predicate metadata should all be equal length vectors");
 
     for (size_t offset = 0; offset < input_col_list.size(); offset++) {
@@ -274,6 +310,7 @@ class IndexUtil {
 
         type::TransientValue val = input_val_list[offset];
         output_val_list.emplace_back(std::move(val));
+        output_num_values_list.push_back(input_num_values_list[offset]);
       }
     }
 
@@ -281,10 +318,267 @@ class IndexUtil {
     output_metadata->SetPredicateColumnIds(std::move(output_col_list));
     output_metadata->SetPredicateExprTypes(std::move(output_expr_list));
     output_metadata->SetPredicateValues(std::move(output_val_list));
+    output_metadata->SetPredicateNumValues(std::move(output_num_values_list));
     return !is_empty;
   }
 
+  /**
+   * Checks whether an index stores every column that a scan reads, so that an index-only scan
+   * can read them from the index keys without fetching the tuples from the table.
+   * @param accessor CatalogAccessor
+   * @param tbl_oid OID of the table
+   * @param index_oid OID of an index to check
+   * @param col_oids OIDs of the columns read by the scan
+   * @returns TRUE if an index-only scan of the index can read all the columns
+   */
+  static bool CoversColumnsWithIndex(catalog::CatalogAccessor *accessor, catalog::table_oid_t tbl_oid,
+                                     catalog::index_oid_t index_oid, const std::set<catalog::col_oid_t> &col_oids) {
+    // The index must be able to return the keys of the entries it finds
+    if (!accessor->GetIndex(index_oid)->SupportsScanWithKeys()) {
+      return false;
+    }
+
+    auto &index_schema = accessor->GetIndexSchema(index_oid);
+    if (!SatisfiesBaseColumnRequirement(index_schema)) {
+      return false;
+    }
+
+    std::vector<catalog::col_oid_t> mapped_cols;
+    if (!GetIndexColOid(accessor, tbl_oid, index_schema, &mapped_cols)) {
+      return false;
+    }
+
+    return std::all_of(col_oids.begin(), col_oids.end(), [&](const catalog::col_oid_t col_oid) {
+      return std::find(mapped_cols.begin(), mapped_cols.end(), col_oid) != mapped_cols.end();
+    });
+  }
+
+  /**
+   * Derives the key ranges that a scan of an index must read to find all the tuples satisfying a conjunction of
+   * predicates. Equalities and disjunctions of equalities on a prefix of the index columns give one point for every
+   * combination of their values, and the comparisons on the next column bound the ranges around these points. The
+   * remaining columns are left open. Strict comparisons are scanned as inclusive bounds, and the other predicates are
+   * ignored, so the scan must still evaluate the predicates on the tuples it finds.
+   * @param accessor CatalogAccessor
+   * @param tbl_oid OID of the table
+   * @param index_oid OID of the index
+   * @param predicates conjunction of predicates
+   * @param[out] key_ranges the key ranges, pointing into the predicates. MakeOpenBound fills the open bounds.
+   * @returns TRUE if the predicates bound the first index column, and MakeOpenBound can fill all the open bounds
+   */
+  static bool DeriveKeyRanges(catalog::CatalogAccessor *accessor, catalog::table_oid_t tbl_oid,
+                              catalog::index_oid_t index_oid, const std::vector<AnnotatedExpression> &predicates,
+                              std::vector<IndexKeyBounds> *key_ranges) {
+    auto &index_schema = accessor->GetIndexSchema(index_oid);
+    if (!SatisfiesBaseColumnRequirement(index_schema)) {
+      return false;
+    }
+
+    std::vector<catalog::col_oid_t> mapped_cols;
+    if (!GetIndexColOid(accessor, tbl_oid, index_schema, &mapped_cols)) {
+      return false;
+    }
+
+    const std::vector<common::ManagedPointer<parser::AbstractExpression>> open(mapped_cols.size(), nullptr);
+    std::vector<IndexKeyBounds> ranges{IndexKeyBounds(open, open)};
+    bool bounded = false;
+    for (size_t idx = 0; idx < mapped_cols.size(); idx++) {
+      // Collect the points and bounds of this column. Predicates repeating a column are left to the scan predicate.
+      std::vector<common::ManagedPointer<parser::AbstractExpression>> points;
+      common::ManagedPointer<parser::AbstractExpression> low = nullptr;
+      common::ManagedPointer<parser::AbstractExpression> high = nullptr;
+      for (auto &pred : predicates) {
+        std::vector<common::ManagedPointer<parser::AbstractExpression>> pred_points;
+        auto col_expr = GetPointList(pred.GetExpr(), &pred_points);
+        if (col_expr != nullptr) {
+          if (col_expr->GetColumnOid() == mapped_cols[idx] && points.empty()) points = std::move(pred_points);
+          continue;
+        }
+
+        parser::ExpressionType expr_type;
+        common::ManagedPointer<parser::AbstractExpression> value_expr;
+        col_expr = GetColumnComparison(pred.GetExpr(), &expr_type, &value_expr);
+        if (col_expr == nullptr || col_expr->GetColumnOid() != mapped_cols[idx]) continue;
+        if (low == nullptr && (expr_type == parser::ExpressionType::COMPARE_GREATER_THAN ||
+                               expr_type == parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO)) {
+          low = value_expr;
+        } else if (high == nullptr && (expr_type == parser::ExpressionType::COMPARE_LESS_THAN ||
+                                       expr_type == parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO)) {
+          high = value_expr;
+        }
+      }
+
+      if (!points.empty() && ranges.size() * points.size() <= MAX_KEY_RANGES) {
+        // Every range so far is split into one range per point
+        std::vector<IndexKeyBounds> point_ranges;
+        point_ranges.reserve(ranges.size() * points.size());
+        for (const auto &range : ranges) {
+          for (const auto &point : points) {
+            point_ranges.push_back(range);
+            point_ranges.back().first[idx] = point;
+            point_ranges.back().second[idx] = point;
+          }
+        }
+        ranges = std::move(point_ranges);
+        bounded = true;
+        continue;
+      }
+
+      if (low != nullptr || high != nullptr) {
+        for (auto &range : ranges) {
+          range.first[idx] = low;
+          range.second[idx] = high;
+        }
+        bounded = true;
+      }
+      break;
+    }
+
+    // All the ranges leave the same columns open
+    if (!bounded) return false;
+    for (size_t idx = 0; idx < mapped_cols.size(); idx++) {
+      if ((ranges[0].first[idx] == nullptr || ranges[0].second[idx] == nullptr) &&
+          !CanMakeOpenBound(index_schema.GetColumn(static_cast<uint32_t>(idx)))) {
+        return false;
+      }
+    }
+
+    *key_ranges = std::move(ranges);
+    return true;
+  }
+
+  /**
+   * Makes the value of an open bound of a key range from DeriveKeyRanges.
+   * @param column the index column of the bound
+   * @param is_low whether the bound is the lower one
+   * @param is_unbounded whether the range leaves both sides of the column open
+   * @returns the lowest or highest value of the column type, or NULL for the lower bound of an unbounded nullable
+   * column, since NULLs come first in the index
+   */
+  static std::unique_ptr<parser::ConstantValueExpression> MakeOpenBound(const catalog::IndexSchema::Column &column,
+                                                                        bool is_low, bool is_unbounded) {
+    TERRIER_ASSERT(CanMakeOpenBound(column), "The column type has no lowest and highest value");
+    if (is_low && is_unbounded && column.Nullable()) {
+      return std::make_unique<parser::ConstantValueExpression>(type::TransientValueFactory::GetNull(column.Type()));
+    }
+    switch (column.Type()) {
+      case type::TypeId::TINYINT:
+        return MakeLimitBound<int8_t>(is_low, &type::TransientValueFactory::GetTinyInt);
+      case type::TypeId::SMALLINT:
+        return MakeLimitBound<int16_t>(is_low, &type::TransientValueFactory::GetSmallInt);
+      case type::TypeId::INTEGER:
+        return MakeLimitBound<int32_t>(is_low, &type::TransientValueFactory::GetInteger);
+      default:
+        return MakeLimitBound<int64_t>(is_low, &type::TransientValueFactory::GetBigInt);
+    }
+  }
+
  private:
+  /**
+   * Most key ranges that DeriveKeyRanges splits a scan into. Points on the following columns are left to the scan
+   * predicate.
+   */
+  static constexpr size_t MAX_KEY_RANGES = 1024;
+
+  /**
+   * @param column an index column
+   * @returns whether MakeOpenBound can make the bounds of the column, which holds for integer columns
+   */
+  static bool CanMakeOpenBound(const catalog::IndexSchema::Column &column) {
+    switch (column.Type()) {
+      case type::TypeId::TINYINT:
+      case type::TypeId::SMALLINT:
+      case type::TypeId::INTEGER:
+      case type::TypeId::BIGINT:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * @tparam CppType the C++ type of the column
+   * @param is_low whether to make the lowest or the highest value
+   * @param make_value TransientValueFactory function for the column type
+   * @returns the lowest or highest value of the type
+   */
+  template <typename CppType>
+  static std::unique_ptr<parser::ConstantValueExpression> MakeLimitBound(bool is_low,
+                                                                         type::TransientValue (*make_value)(CppType)) {
+    const CppType value = is_low ? std::numeric_limits<CppType>::min() : std::numeric_limits<CppType>::max();
+    return std::make_unique<parser::ConstantValueExpression>(make_value(value));
+  }
+
+  /**
+   * @param expr expression to check
+   * @returns whether the expression is a constant or a parameter
+   */
+  static bool IsValue(common::ManagedPointer<parser::AbstractExpression> expr) {
+    auto type = expr->GetExpressionType();
+    return type == parser::ExpressionType::VALUE_CONSTANT || type == parser::ExpressionType::VALUE_PARAMETER;
+  }
+
+  /**
+   * Matches a comparison between a column and a constant or parameter, with the column on either side.
+   * @param expr expression to match
+   * @param[out] expr_type the comparison, reversed when the column is on the right side
+   * @param[out] value_expr the constant or parameter
+   * @returns the column, or nullptr if the expression is not such a comparison
+   */
+  static common::ManagedPointer<parser::ColumnValueExpression> GetColumnComparison(
+      common::ManagedPointer<parser::AbstractExpression> expr, parser::ExpressionType *expr_type,
+      common::ManagedPointer<parser::AbstractExpression> *value_expr) {
+    if (expr->GetChildrenSize() != 2) {
+      return nullptr;
+    }
+
+    if (expr->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE && IsValue(expr->GetChild(1))) {
+      *expr_type = expr->GetExpressionType();
+      *value_expr = expr->GetChild(1);
+      return expr->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
+    }
+    if (expr->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE && IsValue(expr->GetChild(0))) {
+      *expr_type = parser::ExpressionUtil::ReverseComparisonExpressionType(expr->GetExpressionType());
+      *value_expr = expr->GetChild(0);
+      return expr->GetChild(1).CastManagedPointerTo<parser::ColumnValueExpression>();
+    }
+    return nullptr;
+  }
+
+  /**
+   * Matches an equality, or a disjunction of equalities, between one column and constants or parameters.
+   * @param expr expression to match
+   * @param[out] points the values the column is compared to, only complete when a column is returned
+   * @returns the column, or nullptr if the expression is not such a predicate
+   */
+  static common::ManagedPointer<parser::ColumnValueExpression> GetPointList(
+      common::ManagedPointer<parser::AbstractExpression> expr,
+      std::vector<common::ManagedPointer<parser::AbstractExpression>> *points) {
+    if (expr->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL) {
+      parser::ExpressionType expr_type;
+      common::ManagedPointer<parser::AbstractExpression> value_expr;
+      auto col_expr = GetColumnComparison(expr, &expr_type, &value_expr);
+      if (col_expr != nullptr) points->push_back(value_expr);
+      return col_expr;
+    }
+
+    if (expr->GetExpressionType() == parser::ExpressionType::CONJUNCTION_OR) {
+      // Every disjunct must compare the same column
+      common::ManagedPointer<parser::ColumnValueExpression> col_expr = nullptr;
+      for (const auto &child : expr->GetChildren()) {
+        auto child_col_expr = GetPointList(child, points);
+        if (child_col_expr == nullptr ||
+            (col_expr != nullptr && child_col_expr->GetColumnOid() != col_expr->GetColumnOid())) {
+          return nullptr;
+        }
+        col_expr = child_col_expr;
+      }
+      return col_expr;
+    }
+
+    return nullptr;
+  }
+
   /**
    * Checks whether a Index satisfies the "base column" requirement.
    * The base column requirement (as defined from Peloton) is where
@@ -138,6 +138,18 @@ class InputColumnDeriver : public OperatorVisitor {
    */
   void Visit(const OuterHashJoin *op) override;
 
+  /**
+   * Visit function to derive input/output columns for SemiHashJoin
+   * @param op SemiHashJoin operator to visit
+   */
+  void Visit(const SemiHashJoin *op) override;
+
+  /**
+   * Visit function to derive input/output columns for InnerMergeJoin
+   * @param op InnerMergeJoin operator to visit
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
   /**
    * Visit function to derive input/output columns for TableFreeScan
    * @param op TableFreeScan operator to visit
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+
+namespace terrier::optimizer {
+
+class AbstractCostModel;
+
+/**
+ * Finds a cheap bushy join order for a connected join graph with DPhyp (Moerkotte and Neumann, "Dynamic Programming
+ * Strikes Back", SIGMOD 2008). Relations are numbered in the order they are added, and sets of relations are bitmasks
+ * of their numbers. Join predicates are hyperedges between two disjoint sets of relations. DPhyp only considers joins
+ * of connected subgraphs that a predicate connects, so the plans never contain cross products.
+ *
+ * The number of pairs of subgraphs DPhyp joins grows exponentially with the number of relations on dense graphs.
+ * When it exceeds K_MAX_CSG_CMP_PAIRS, the enumerator falls back to greedy operator ordering (GOO), which repeatedly
+ * joins the two connected subplans with the smallest result.
+ */
+class JoinEnumerator {
+ public:
+  /**
+   * A set of relations, one bit per relation
+   */
+  using RelationSet = uint64_t;
+
+  /**
+   * The largest number of relations a graph may have
+   */
+  static constexpr size_t K_MAX_RELATIONS = 64;
+
+  /**
+   * The number of pairs of subplans DPhyp may join before the enumerator falls back to GOO
+   */
+  static constexpr uint64_t K_MAX_CSG_CMP_PAIRS = 100000;
+
+  /**
+   * The cheapest plan found for a set of relations
+   */
+  struct Plan {
+    /**
+     * Relations of the left input, or 0 for a single relation
+     */
+    RelationSet left_ = 0;
+
+    /**
+     * Relations of the right input, or 0 for a single relation
+     */
+    RelationSet right_ = 0;
+
+    /**
+     * Estimated number of rows
+     */
+    double rows_ = 0;
+
+    /**
+     * Estimated cost of the joins of the plan
+     */
+    double cost_ = 0;
+  };
+
+  /**
+   * @param cost_model cost model pricing each join with EstimateJoinCost
+   */
+  explicit JoinEnumerator(common::ManagedPointer<AbstractCostModel> cost_model) : cost_model_(cost_model) {}
+
+  DISALLOW_COPY_AND_MOVE(JoinEnumerator)
+
+  /**
+   * Adds a relation to the graph
+   * @param num_rows estimated number of rows of the relation
+   * @returns the number of the relation
+   */
+  size_t AddRelation(double num_rows);
+
+  /**
+   * Adds a join predicate between two disjoint, nonempty sets of relations
+   * @param left relations referenced by one side of the predicate
+   * @param right relations referenced by the other side of the predicate
+   * @param selectivity fraction of the pairs of rows of both sides that satisfy the predicate
+   * @param is_equi whether the predicate is an equality a hash join can use as a key
+   */
+  void AddEdge(RelationSet left, RelationSet right, double selectivity, bool is_equi);
+
+  /**
+   * @returns the set of all the relations of the graph
+   */
+  RelationSet GetAllRelations() const {
+    return relation_rows_.size() == K_MAX_RELATIONS ? ~RelationSet{0} : (RelationSet{1} << relation_rows_.size()) - 1;
+  }
+
+  /**
+   * @returns whether the predicates connect all the relations
+   */
+  bool IsConnected() const;
+
+  /**
+   * Finds the cheapest plan joining all the relations of a connected graph
+   * @returns the plan of all the relations, whose inputs are found with GetPlan
+   */
+  const Plan &Enumerate();
+
+  /**
+   * @param relations a set of relations joined by the plan returned by Enumerate
+   * @returns the plan of the set
+   */
+  const Plan &GetPlan(RelationSet relations) const {
+    TERRIER_ASSERT(plans_.count(relations) != 0, "No plan for the relations");
+    return plans_.at(relations);
+  }
+
+  /**
+   * @returns whether Enumerate gave up on DPhyp and ordered the joins greedily
+   */
+  bool UsedGreedy() const { return used_greedy_; }
+
+  /**
+   * @returns number of pairs of subplans DPhyp joined
+   */
+  uint64_t GetNumPairs() const { return num_pairs_; }
+
+ private:
+  /**
+   * A join predicate
+   */
+  struct Edge {
+    /**
+     * Relations referenced by one side
+     */
+    RelationSet left_;
+
+    /**
+     * Relations referenced by the other side
+     */
+    RelationSet right_;
+
+    /**
+     * Fraction of the pairs of rows that satisfy the predicate
+     */
+    double selectivity_;
+
+    /**
+     * Whether a hash join can use the predicate as a key
+     */
+    bool is_equi_;
+  };
+
+  // The relations adjacent to relations, excluding excluded, each hyperedge contributing its lowest relation
+  RelationSet Neighborhood(RelationSet relations, RelationSet excluded) const;
+
+  // Whether a predicate connects the two sets of relations
+  bool IsConnected(RelationSet left, RelationSet right) const;
+
+  // The estimated number of rows of the join of the relations
+  double EstimateRows(RelationSet relations) const;
+
+  // The DPhyp procedures, which stop once the pair budget is exhausted
+  void EmitCsg(RelationSet csg);
+  void EnumerateCsgRec(RelationSet csg, RelationSet excluded);
+  void EnumerateCmpRec(RelationSet csg, RelationSet cmp, RelationSet excluded);
+  void EmitCsgCmp(RelationSet csg, RelationSet cmp);
+
+  // Record the join of two subplans in the plan of their union if it is cheaper, trying both orders of the inputs
+  void Join(RelationSet left, RelationSet right);
+
+  // Join the subplans greedily, after DPhyp gave up
+  void EnumerateGreedy();
+
+  /**
+   * Cost model pricing the joins
+   */
+  common::ManagedPointer<AbstractCostModel> cost_model_;
+
+  /**
+   * Estimated number of rows of each relation
+   */
+  std::vector<double> relation_rows_;
+
+  /**
+   * Join predicates
+   */
+  std::vector<Edge> edges_;
+
+  /**
+   * Cheapest plan of each connected set of relations enumerated so far
+   */
+  std::unordered_map<RelationSet, Plan> plans_;
+
+  /**
+   * Number of pairs of subplans DPhyp joined
+   */
+  uint64_t num_pairs_ = 0;
+
+  /**
+   * Whether the pair budget ran out
+   */
+  bool used_greedy_ = false;
+};
+
+}  // namespace terrier::optimizer
@@ -4,6 +4,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "common/shared_latch.h"
 #include "optimizer/group.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/operator_expression.h"
@@ -37,7 +38,8 @@ struct GExprPtrEq {
 
 /**
  * Memo class provides for tracking Groups and GroupExpressions and provides the
- * mechanisms by which we can do duplicate group detection.
+ * mechanisms by which we can do duplicate group detection. Optimizer workers
+ * may insert expressions and look up groups concurrently.
  */
 class Memo {
  public:
@@ -94,9 +96,8 @@ class Memo {
    * @returns Group with specified ID
    */
   Group *GetGroupByID(group_id_t id) const {
-    auto idx = !id;
-    TERRIER_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
-    return groups_[idx];
+    common::SharedLatch::ScopedSharedLatch guard(&latch_);
+    return GroupAt(id);
   }
 
   /**
@@ -106,15 +107,25 @@ class Memo {
    * @param group_id GroupID of Group to erase
    */
   void EraseExpression(group_id_t group_id) {
-    auto idx = !group_id;
-    TERRIER_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
-
-    auto gexpr = groups_[idx]->GetLogicalExpression();
+    common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+    auto group = GroupAt(group_id);
+    auto gexpr = group->GetLogicalExpression();
     group_expressions_.erase(gexpr);
-    groups_[idx]->EraseLogicalExpression();
+    group->EraseLogicalExpression();
   }
 
  private:
+  /**
+   * Gets the group with certain ID, without taking the latch
+   * @param id ID of the group to get
+   * @returns Group with specified ID
+   */
+  Group *GroupAt(group_id_t id) const {
+    auto idx = !id;
+    TERRIER_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
+    return groups_[idx];
+  }
+
   /**
    * Creates a new group
    * @param gexpr GroupExpression to collect metadata from
@@ -132,6 +143,11 @@ class Memo {
    * Vector of groups tracked
    */
   std::vector<Group *> groups_;
+
+  /**
+   * Latch protecting group_expressions_ and groups_
+   */
+  mutable common::SharedLatch latch_;
 };
 
 }  // namespace terrier::optimizer
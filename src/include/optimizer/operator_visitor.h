@@ -108,6 +108,18 @@ class OperatorVisitor {
    */
   virtual void Visit(const OuterHashJoin *outer_hash_join) {}
 
+  /**
+   * Visit a SemiHashJoin operator
+   * @param semi_hash_join operator
+   */
+  virtual void Visit(const SemiHashJoin *semi_hash_join) {}
+
+  /**
+   * Visit a InnerMergeJoin operator
+   * @param inner_merge_join operator
+   */
+  virtual void Visit(const InnerMergeJoin *inner_merge_join) {}
+
   /**
    * Visit a Insert operator
    * @param insert operator
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <limits>
 
 #include "optimizer/optimizer_task.h"
@@ -66,7 +67,7 @@ class OptimizationContext {
   /**
    * Cost Upper Bound (for pruning)
    */
-  double cost_upper_bound_;
+  std::atomic<double> cost_upper_bound_;
 };
 
 }  // namespace terrier::optimizer
@@ -4,6 +4,8 @@
 #include <utility>
 #include <vector>
 
+#include "common/managed_pointer.h"
+#include "common/worker_pool.h"
 #include "optimizer/abstract_optimizer.h"
 #include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/optimizer_context.h"
@@ -41,11 +43,15 @@ class Optimizer : public AbstractOptimizer {
    * Constructor for Optimizer with a cost_model
    * @param model Cost Model to use for the optimizer
    * @param task_execution_timeout time in ms to spend on a task
+   * @param threads threads running optimizer tasks alongside the calling thread, which may be shared by concurrent
+   * optimizers, or nullptr to run the tasks on the calling thread only
    */
-  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout)
+  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout,
+                     common::ManagedPointer<common::WorkerPool> threads = nullptr)
       : cost_model_(std::move(model)),
         context_(std::make_unique<OptimizerContext>(common::ManagedPointer(cost_model_))),
-        task_execution_timeout_(task_execution_timeout) {}
+        task_execution_timeout_(task_execution_timeout),
+        threads_(threads) {}
 
   /**
    * Build the plan tree for query execution
@@ -91,19 +97,20 @@ class Optimizer : public AbstractOptimizer {
       const std::vector<common::ManagedPointer<parser::AbstractExpression>> &required_cols);
 
   /**
-   * Execute elements of given optimization task stack and ensure that we
+   * Execute elements of given optimization task pool and ensure that we
    * do not go beyond the time limit (unless if one plan has not been
    * generated yet)
    *
-   * @param task_stack Optimizer's Task Stack to execute through
+   * @param task_pool Optimizer's Task Pool to execute through
    * @param root_group_id Root Group ID to check whether there is a plan or not
    * @param root_context OptimizerContext to use that maintains required properties
    */
-  void ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id, OptimizationContext *root_context);
+  void ExecuteTaskPool(OptimizerTaskPool *task_pool, group_id_t root_group_id, OptimizationContext *root_context);
 
   std::unique_ptr<AbstractCostModel> cost_model_;
   std::unique_ptr<OptimizerContext> context_;
   const uint64_t task_execution_timeout_;
+  const common::ManagedPointer<common::WorkerPool> threads_;
 };
 
 }  // namespace optimizer
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "common/settings.h"
+#include "common/spin_latch.h"
 #include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/memo.h"
@@ -79,7 +80,10 @@ class OptimizerContext {
    * Adds a OptimizationContext to the tracking list
    * @param ctx OptimizationContext to add to tracking
    */
-  void AddOptimizationContext(OptimizationContext *ctx) { track_list_.push_back(ctx); }
+  void AddOptimizationContext(OptimizationContext *ctx) {
+    common::SpinLatch::ScopedSpinLatch guard(&track_list_latch_);
+    track_list_.push_back(ctx);
+  }
 
   /**
    * Pushes a task to the task pool managed
@@ -87,12 +91,35 @@ class OptimizerContext {
    */
   void PushTask(OptimizerTask *task) { task_pool_->Push(task); }
 
+  /**
+   * Pushes independent tasks, which may run concurrently, to the task pool managed
+   * @param tasks Tasks to push
+   */
+  void PushParallelTasks(std::vector<OptimizerTask *> &&tasks) { task_pool_->PushParallel(std::move(tasks)); }
+
+  /**
+   * Pushes a task that waits for another worker to the task pool managed
+   * @param task Task to push
+   */
+  void PushDeferredTask(OptimizerTask *task) { task_pool_->PushDeferred(task); }
+
   /**
    * Gets the cost model
    * @returns Cost Model
    */
   AbstractCostModel *GetCostModel() { return cost_model_.Get(); }
 
+  /**
+   * Costs a group expression with the cost model. Cost models keep the
+   * expression being costed in their state, so workers take turns.
+   * @param gexpr GroupExpression to cost
+   * @returns Cost of the operator of the expression
+   */
+  double CalculateCost(GroupExpression *gexpr) {
+    common::SpinLatch::ScopedSpinLatch guard(&cost_model_latch_);
+    return cost_model_->CalculateCost(txn_, &memo_, gexpr);
+  }
+
   /**
    * Gets the transaction
    * @returns transaction
@@ -138,9 +165,10 @@ class OptimizerContext {
    * inserted into Memo.
    *
    * @param expr OperatorExpression to convert
+   * @param derived whether the optimizer derived the expression, rather than the query stating it
    * @returns GroupExpression representing OperatorExpression
    */
-  GroupExpression *MakeGroupExpression(common::ManagedPointer<OperatorExpression> expr) {
+  GroupExpression *MakeGroupExpression(common::ManagedPointer<OperatorExpression> expr, bool derived = false) {
     std::vector<group_id_t> child_groups;
     for (auto &child : expr->GetChildren()) {
       if (child->GetOp().GetType() == OpType::LEAF) {
@@ -150,7 +178,7 @@ class OptimizerContext {
         child_groups.push_back(child_group);
       } else {
         // Create a GroupExpression for the child
-        auto gexpr = MakeGroupExpression(child);
+        auto gexpr = MakeGroupExpression(child, derived);
 
         // Insert into the memo (this allows for duplicate detection)
         auto mexpr = memo_.InsertExpression(gexpr, false);
@@ -164,7 +192,7 @@ class OptimizerContext {
       }
     }
 
-    return new GroupExpression(expr->GetOp(), std::move(child_groups));
+    return new GroupExpression(expr->GetOp(), std::move(child_groups), derived);
   }
 
   /**
@@ -188,11 +216,12 @@ class OptimizerContext {
    * @param expr OperatorExpression to record into the group
    * @param gexpr Existing GroupExpression or new GroupExpression
    * @param target_group ID of the Group that the OperatorExpression belongs to
+   * @param derived whether the optimizer derived the expression, rather than the query stating it
    * @returns Whether the OperatorExpression has been added before
    */
   bool RecordOperatorExpressionIntoGroup(common::ManagedPointer<OperatorExpression> expr, GroupExpression **gexpr,
-                                         group_id_t target_group) {
-    auto new_gexpr = MakeGroupExpression(expr);
+                                         group_id_t target_group, bool derived = false) {
+    auto new_gexpr = MakeGroupExpression(expr, derived);
     auto ptr = memo_.InsertExpression(new_gexpr, target_group, false);
     TERRIER_ASSERT(ptr, "Root of expr should not fail insertion");
 
@@ -223,6 +252,8 @@ class OptimizerContext {
   StatsStorage *stats_storage_;
   transaction::TransactionContext *txn_;
   std::vector<OptimizationContext *> track_list_;
+  common::SpinLatch track_list_latch_;
+  common::SpinLatch cost_model_latch_;
 };
 
 }  // namespace optimizer
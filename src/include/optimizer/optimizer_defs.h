@@ -98,6 +98,8 @@ enum class OpType {
   LEFTHASHJOIN,
   RIGHTHASHJOIN,
   OUTERHASHJOIN,
+  SEMIHASHJOIN,
+  INNERMERGEJOIN,
   INSERT,
   INSERTSELECT,
   DELETE,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -32,10 +33,12 @@ enum class OptimizerTaskType {
   OPTIMIZE_GROUP,
   OPTIMIZE_EXPR,
   EXPLORE_GROUP,
+  FINISH_EXPLORATION,
   EXPLORE_EXPR,
   APPLY_RULE,
   OPTIMIZE_INPUTS,
   DERIVE_STATS,
+  ENUMERATE_JOINS,
   REWRITE_EXPR,
   APPLY_REWIRE_RULE,
   TOP_DOWN_REWRITE,
@@ -89,6 +92,19 @@ class OptimizerTask {
    */
   void PushTask(OptimizerTask *task);
 
+  /**
+   * Convenience to push independent tasks, which may run concurrently,
+   * onto same task pool
+   * @param tasks Tasks to push
+   */
+  void PushParallelTasks(std::vector<OptimizerTask *> &&tasks);
+
+  /**
+   * Convenience to push a task that waits for another worker onto same task pool
+   * @param task Task to push
+   */
+  void PushDeferredTask(OptimizerTask *task);
+
   /**
    * Trivial destructor
    */
@@ -188,6 +204,33 @@ class ExploreGroup : public OptimizerTask {
   Group *group_;
 };
 
+/**
+ * FinishExploration marks a group as explored. OptimizeGroup and ExploreGroup
+ * push it before the tasks exploring the group, so that it runs after them and
+ * tasks on other workers wait for the whole exploration.
+ */
+class FinishExploration : public OptimizerTask {
+ public:
+  /**
+   * Constructor for FinishExploration
+   * @param group Group being explored
+   * @param context Current optimize context
+   */
+  FinishExploration(Group *group, OptimizationContext *context)
+      : OptimizerTask(context, OptimizerTaskType::FINISH_EXPLORATION), group_(group) {}
+
+  /**
+   * Function to execute the task
+   */
+  void Execute() override;
+
+ private:
+  /**
+   * Group being explored
+   */
+  Group *group_;
+};
+
 /**
  * ExploreExpression applies logical transformation rules to a GroupExpression
  * until no more logical transformation rules can be applied. ExploreExpression
@@ -378,6 +421,50 @@ class DeriveStats : public OptimizerTask {
   ExprSet required_cols_;
 };
 
+/**
+ * EnumerateJoins orders the joins of every tree of inner joins over at least K_MIN_RELATIONS inputs with the
+ * JoinEnumerator, before the join rules run. The plan it finds is added to the group of the root of the tree,
+ * next to the original order, and the commutativity and associativity rules are marked explored on the joins of
+ * both, so that the Memo holds two join orders instead of all of them. Smaller trees are left to the rules.
+ * It relies on the stats derived for the inputs of the joins.
+ */
+class EnumerateJoins : public OptimizerTask {
+ public:
+  /**
+   * The smallest number of inputs of a tree of joins that the enumerator orders
+   */
+  static constexpr size_t K_MIN_RELATIONS = 5;
+
+  /**
+   * Constructor for EnumerateJoins
+   * @param group_id Group whose trees of joins to order
+   * @param context Current OptimizationContext
+   */
+  EnumerateJoins(group_id_t group_id, OptimizationContext *context)
+      : OptimizerTask(context, OptimizerTaskType::ENUMERATE_JOINS), group_id_(group_id) {}
+
+  /**
+   * Function to execute the task
+   */
+  void Execute() override;
+
+ private:
+  // Collect the joins of the tree of inner joins rooted at join, and the groups of its inputs
+  void CollectJoins(GroupExpression *join, std::vector<GroupExpression *> *joins, std::vector<group_id_t> *inputs);
+
+  // Order the joins of the tree rooted at the given group
+  void OrderJoins(group_id_t group_id, const std::vector<GroupExpression *> &joins,
+                  const std::vector<group_id_t> &inputs);
+
+  // Mark the join rules explored on the joins of a tree, down to its inputs
+  void MarkJoinsExplored(GroupExpression *join, const std::unordered_set<group_id_t> &inputs);
+
+  /**
+   * Group whose trees of joins to order
+   */
+  group_id_t group_id_;
+};
+
 /**
  * TopDownRewrite performs a top-down rewrite pass. A generally held assumption for
  * any RuleSet utilizing TopDownRewrite is that once a tree level has been saturated,
@@ -1,7 +1,20 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <stack>
+#include <vector>
+
+#include "common/managed_pointer.h"
+#include "common/spin_latch.h"
+#include "common/worker_pool.h"
 #include "optimizer/optimizer_task.h"
 
 namespace terrier::optimizer {
@@ -23,11 +36,35 @@ class OptimizerTaskPool {
    */
   virtual void Push(OptimizerTask *task) = 0;
 
+  /**
+   * Adds tasks that do not depend on each other, which a pool may run concurrently.
+   * Like tasks added by Push, they all finish before the tasks added earlier run.
+   * @param tasks OptimizerTasks to add to the pool
+   */
+  virtual void PushParallel(std::vector<OptimizerTask *> &&tasks) {
+    for (auto *task : tasks) Push(task);
+  }
+
+  /**
+   * Adds a task that waits for work running elsewhere in the pool, such as a group
+   * that another worker is exploring. A pool may run it after its other tasks.
+   * @param task OptimizerTask to add to the task pool
+   */
+  virtual void PushDeferred(OptimizerTask *task) { Push(task); }
+
   /**
    * Virtual interface function to check whether the pool is empty
    */
   virtual bool Empty() = 0;
 
+  /**
+   * Executes the tasks of the pool, and the tasks that they add, until the pool is empty
+   * or should_stop returns true. The tasks that did not run are discarded.
+   * @param should_stop called between tasks with the time in ms spent executing tasks
+   * @returns whether all the tasks ran
+   */
+  virtual bool ExecuteTasks(const std::function<bool(uint64_t)> &should_stop);
+
   /**
    * Trivial destructor
    */
@@ -83,4 +120,206 @@ class OptimizerTaskStack : public OptimizerTaskPool {
   std::stack<OptimizerTask *> task_stack_;
 };
 
+/**
+ * Multi-threaded implementation of the OptimizerTaskPool.
+ *
+ * The pool keeps the order that a stack gives the tasks: the tasks that a task pushes run
+ * after it, in the reverse order of their push, and all finish before the tasks pushed
+ * earlier. Only tasks pushed together by PushParallel run concurrently. Each worker keeps
+ * a deque of the tasks that are ready to run, takes its newest task and steals the
+ * oldest task of another worker when it has none. Deferred tasks wait in a shared queue
+ * until no worker has anything else to run.
+ *
+ * Between executions, the pool behaves like a stack of the tasks pushed to it.
+ */
+class ParallelOptimizerTaskPool : public OptimizerTaskPool {
+ public:
+  /**
+   * Constructor for ParallelOptimizerTaskPool. The tasks run on the calling thread and on one thread of the worker
+   * pool per worker of the pool. The worker pool may be shared with the pools of concurrent optimizations.
+   * @param threads threads executing tasks alongside the calling thread
+   */
+  explicit ParallelOptimizerTaskPool(common::ManagedPointer<common::WorkerPool> threads);
+
+  /**
+   * Destructor for ParallelOptimizerTaskPool
+   */
+  ~ParallelOptimizerTaskPool() override;
+
+  DISALLOW_COPY_AND_MOVE(ParallelOptimizerTaskPool)
+
+  /**
+   * Implementation of the Pop interface of OptimizerTaskPool.
+   * Only valid while the pool is not executing.
+   * @returns Most recently pushed OptimizerTask
+   */
+  OptimizerTask *Pop() override;
+
+  /**
+   * Implementation of the Push interface of OptimizerTaskPool
+   * @param task OptimizerTask to add to the task pool
+   */
+  void Push(OptimizerTask *task) override;
+
+  /**
+   * Implementation of the PushParallel interface of OptimizerTaskPool
+   * @param tasks OptimizerTasks to run concurrently
+   */
+  void PushParallel(std::vector<OptimizerTask *> &&tasks) override;
+
+  /**
+   * Implementation of the PushDeferred interface of OptimizerTaskPool
+   * @param task OptimizerTask to add to the task pool
+   */
+  void PushDeferred(OptimizerTask *task) override;
+
+  /**
+   * Checks whether the pool is empty or not.
+   * Only valid while the pool is not executing.
+   * @returns TRUE if empty
+   */
+  bool Empty() override;
+
+  /**
+   * Executes the tasks on all the workers. The time passed to should_stop is the wall
+   * time since the execution started.
+   * @param should_stop called between tasks with the time in ms spent executing tasks
+   * @returns whether all the tasks ran
+   */
+  bool ExecuteTasks(const std::function<bool(uint64_t)> &should_stop) override;
+
+ private:
+  struct TaskNode;
+
+  /**
+   * Ready tasks of a worker
+   */
+  struct WorkerQueue {
+    common::SpinLatch latch_;
+    std::deque<TaskNode *> nodes_;
+  };
+
+  /**
+   * Node whose task the thread is running, which receives the tasks that the task pushes
+   */
+  static thread_local TaskNode *running_node_;
+
+  /**
+   * Worker that the thread runs, whose deque receives the nodes that the thread schedules
+   */
+  static thread_local uint32_t running_worker_;
+
+  // Adds a node to the children of the running task, or of the root outside of execution
+  void AddChild(std::unique_ptr<TaskNode> node);
+
+  // Runs the task of a node and schedules its children
+  void Run(TaskNode *node);
+
+  // Makes a node ready to run
+  void Schedule(TaskNode *node);
+
+  // Frees a node whose task and children ran, and schedules what waited for it
+  void Finish(TaskNode *node);
+
+  // Takes a ready node for a worker, or returns nullptr
+  TaskNode *Take(uint32_t worker);
+
+  // Parks an idle worker until it takes a ready node, or returns nullptr once the execution finishes or stops
+  TaskNode *WaitAndTake(uint32_t worker);
+
+  // Wakes an idle worker, if any, after a node became ready
+  void WakeIdle();
+
+  // Wakes all idle workers after the execution finished or stopped
+  void WakeAll();
+
+  // Runs ready nodes until the execution finishes or stops
+  void Work(uint32_t worker, const std::function<bool(uint64_t)> &should_stop);
+
+  /**
+   * Number of threads executing tasks
+   */
+  const uint32_t num_workers_;
+
+  /**
+   * Parent of the tasks pushed outside of execution
+   */
+  std::unique_ptr<TaskNode> root_;
+
+  /**
+   * Ready tasks of each worker
+   */
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+  /**
+   * Deferred tasks, oldest first
+   */
+  std::deque<TaskNode *> deferred_;
+
+  /**
+   * Latch protecting deferred_
+   */
+  common::SpinLatch deferred_latch_;
+
+  /**
+   * Start of the current execution
+   */
+  std::chrono::steady_clock::time_point start_time_;
+
+  /**
+   * Whether all the tasks of the current execution ran
+   */
+  std::atomic<bool> done_{false};
+
+  /**
+   * Whether the current execution stopped early
+   */
+  std::atomic<bool> stopped_{false};
+
+  /**
+   * First exception thrown by a task of the current execution
+   */
+  std::exception_ptr error_;
+
+  /**
+   * Latch protecting error_
+   */
+  common::SpinLatch error_latch_;
+
+  /**
+   * Number of workers parked in WaitAndTake
+   */
+  std::atomic<uint32_t> num_idle_{0};
+
+  /**
+   * Latch that idle workers hold while they look for nodes and wait
+   */
+  std::mutex idle_latch_;
+
+  /**
+   * Notified when a node becomes ready, and when the execution finishes or stops
+   */
+  std::condition_variable idle_cv_;
+
+  /**
+   * Threads running the workers other than the calling thread
+   */
+  common::ManagedPointer<common::WorkerPool> threads_;
+
+  /**
+   * Number of workers other than the calling thread that did not return from the current execution
+   */
+  uint32_t running_helpers_ = 0;
+
+  /**
+   * Latch protecting running_helpers_
+   */
+  std::mutex helpers_latch_;
+
+  /**
+   * Notified when running_helpers_ drops to zero
+   */
+  std::condition_variable helpers_cv_;
+};
+
 }  // namespace terrier::optimizer
@@ -154,6 +154,8 @@ class IndexScan : public OperatorNode<IndexScan> {
    * @param key_column_oid_list OID of key columns
    * @param expr_type_list expression types
    * @param value_list values to be scanned
+   * @param num_values_list number of values each key column is compared to, which is more than one for IN lists.
+   *                        Key predicates past its end compare their column to a single value.
    * @return an IndexScan operator
    */
   static Operator Make(catalog::db_oid_t database_oid, catalog::namespace_oid_t namespace_oid,
@@ -161,7 +163,7 @@ class IndexScan : public OperatorNode<IndexScan> {
                        std::string table_alias, bool is_for_update,
                        std::vector<catalog::col_oid_t> &&key_column_oid_list,
                        std::vector<parser::ExpressionType> &&expr_type_list,
-                       std::vector<type::TransientValue> &&value_list);
+                       std::vector<type::TransientValue> &&value_list, std::vector<uint32_t> &&num_values_list = {});
 
   /**
    * Copy
@@ -218,6 +220,12 @@ class IndexScan : public OperatorNode<IndexScan> {
    */
   const std::vector<type::TransientValue> &GetValueList() const { return value_list_; }
 
+  /**
+   * @param idx index of a key predicate
+   * @return the number of values the key predicate compares its column to
+   */
+  uint32_t GetNumValues(const size_t idx) const { return idx < num_values_list_.size() ? num_values_list_[idx] : 1; }
+
  private:
   /**
    * OID of the database
@@ -263,6 +271,11 @@ class IndexScan : public OperatorNode<IndexScan> {
    * Parameter values
    */
   std::vector<type::TransientValue> value_list_;
+
+  /**
+   * Number of values each key column is compared to
+   */
+  std::vector<uint32_t> num_values_list_;
 };
 
 /**
@@ -706,10 +719,14 @@ class InnerHashJoin : public OperatorNode<InnerHashJoin> {
 class LeftHashJoin : public OperatorNode<LeftHashJoin> {
  public:
   /**
-   * @param join_predicate predicate for join
+   * @param join_predicates predicates for join
+   * @param left_keys left keys to join
+   * @param right_keys right keys to join
    * @return a LeftHashJoin operator
    */
-  static Operator Make(common::ManagedPointer<parser::AbstractExpression> join_predicate);
+  static Operator Make(std::vector<AnnotatedExpression> &&join_predicates,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys);
 
   /**
    * Copy
@@ -722,15 +739,35 @@ class LeftHashJoin : public OperatorNode<LeftHashJoin> {
   common::hash_t Hash() const override;
 
   /**
-   * @return Predicate for the join
+   * @return Left join keys
    */
-  const common::ManagedPointer<parser::AbstractExpression> &GetJoinPredicate() const { return join_predicate_; }
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetLeftKeys() const { return left_keys_; }
+
+  /**
+   * @return Right join keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetRightKeys() const { return right_keys_; }
+
+  /**
+   * @return Predicates for the Join
+   */
+  const std::vector<AnnotatedExpression> &GetJoinPredicates() const { return join_predicates_; }
 
  private:
+  /**
+   * Left join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys_;
+
+  /**
+   * Right join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys_;
+
   /**
    * Predicate for join
    */
-  common::ManagedPointer<parser::AbstractExpression> join_predicate_;
+  std::vector<AnnotatedExpression> join_predicates_;
 };
 
 /**
@@ -739,10 +776,14 @@ class LeftHashJoin : public OperatorNode<LeftHashJoin> {
 class RightHashJoin : public OperatorNode<RightHashJoin> {
  public:
   /**
-   * @param join_predicate predicate for join
+   * @param join_predicates predicates for join
+   * @param left_keys left keys to join
+   * @param right_keys right keys to join
    * @return a RightHashJoin operator
    */
-  static Operator Make(common::ManagedPointer<parser::AbstractExpression> join_predicate);
+  static Operator Make(std::vector<AnnotatedExpression> &&join_predicates,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys);
 
   /**
    * Copy
@@ -755,15 +796,35 @@ class RightHashJoin : public OperatorNode<RightHashJoin> {
   common::hash_t Hash() const override;
 
   /**
-   * @return Predicate for the join
+   * @return Left join keys
    */
-  const common::ManagedPointer<parser::AbstractExpression> &GetJoinPredicate() const { return join_predicate_; }
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetLeftKeys() const { return left_keys_; }
+
+  /**
+   * @return Right join keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetRightKeys() const { return right_keys_; }
+
+  /**
+   * @return Predicates for the Join
+   */
+  const std::vector<AnnotatedExpression> &GetJoinPredicates() const { return join_predicates_; }
 
  private:
+  /**
+   * Left join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys_;
+
+  /**
+   * Right join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys_;
+
   /**
    * Predicate for join
    */
-  common::ManagedPointer<parser::AbstractExpression> join_predicate_;
+  std::vector<AnnotatedExpression> join_predicates_;
 };
 
 /**
@@ -772,10 +833,14 @@ class RightHashJoin : public OperatorNode<RightHashJoin> {
 class OuterHashJoin : public OperatorNode<OuterHashJoin> {
  public:
   /**
-   * @param join_predicate predicate for join
+   * @param join_predicates predicates for join
+   * @param left_keys left keys to join
+   * @param right_keys right keys to join
    * @return a OuterHashJoin operator
    */
-  static Operator Make(common::ManagedPointer<parser::AbstractExpression> join_predicate);
+  static Operator Make(std::vector<AnnotatedExpression> &&join_predicates,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys);
 
   /**
    * Copy
@@ -788,15 +853,150 @@ class OuterHashJoin : public OperatorNode<OuterHashJoin> {
   common::hash_t Hash() const override;
 
   /**
-   * @return Predicate for the join
+   * @return Left join keys
    */
-  const common::ManagedPointer<parser::AbstractExpression> &GetJoinPredicate() const { return join_predicate_; }
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetLeftKeys() const { return left_keys_; }
+
+  /**
+   * @return Right join keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetRightKeys() const { return right_keys_; }
+
+  /**
+   * @return Predicates for the Join
+   */
+  const std::vector<AnnotatedExpression> &GetJoinPredicates() const { return join_predicates_; }
 
  private:
+  /**
+   * Left join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys_;
+
+  /**
+   * Right join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys_;
+
   /**
    * Predicate for join
    */
-  common::ManagedPointer<parser::AbstractExpression> join_predicate_;
+  std::vector<AnnotatedExpression> join_predicates_;
+};
+
+/**
+ * Physical operator for semi hash join, which outputs each left tuple with a matching right tuple once
+ */
+class SemiHashJoin : public OperatorNode<SemiHashJoin> {
+ public:
+  /**
+   * @param join_predicates predicates for join
+   * @param left_keys left keys to join
+   * @param right_keys right keys to join
+   * @return a SemiHashJoin operator
+   */
+  static Operator Make(std::vector<AnnotatedExpression> &&join_predicates,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys);
+
+  /**
+   * Copy
+   * @returns copy of this
+   */
+  BaseOperatorNode *Copy() const override;
+
+  bool operator==(const BaseOperatorNode &r) override;
+
+  common::hash_t Hash() const override;
+
+  /**
+   * @return Left join keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetLeftKeys() const { return left_keys_; }
+
+  /**
+   * @return Right join keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetRightKeys() const { return right_keys_; }
+
+  /**
+   * @return Predicates for the Join
+   */
+  const std::vector<AnnotatedExpression> &GetJoinPredicates() const { return join_predicates_; }
+
+ private:
+  /**
+   * Left join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys_;
+
+  /**
+   * Right join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys_;
+
+  /**
+   * Predicate for join
+   */
+  std::vector<AnnotatedExpression> join_predicates_;
+};
+
+/**
+ * Physical operator for inner merge join. The join sorts the left child itself; the right child arrives sorted in
+ * ascending order on its join keys.
+ */
+class InnerMergeJoin : public OperatorNode<InnerMergeJoin> {
+ public:
+  /**
+   * @param join_predicates predicates for join
+   * @param left_keys left keys to join, in sort order
+   * @param right_keys right keys to join, in sort order
+   * @return an InnerMergeJoin operator
+   */
+  static Operator Make(std::vector<AnnotatedExpression> &&join_predicates,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys);
+
+  /**
+   * Copy
+   * @returns copy of this
+   */
+  BaseOperatorNode *Copy() const override;
+
+  bool operator==(const BaseOperatorNode &r) override;
+
+  common::hash_t Hash() const override;
+
+  /**
+   * @return Left join keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetLeftKeys() const { return left_keys_; }
+
+  /**
+   * @return Right join keys
+   */
+  const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetRightKeys() const { return right_keys_; }
+
+  /**
+   * @return Predicates for the Join
+   */
+  const std::vector<AnnotatedExpression> &GetJoinPredicates() const { return join_predicates_; }
+
+ private:
+  /**
+   * Left join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys_;
+
+  /**
+   * Right join keys
+   */
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys_;
+
+  /**
+   * Predicate for join
+   */
+  std::vector<AnnotatedExpression> join_predicates_;
 };
 
 /**
@@ -13,6 +13,7 @@ namespace terrier {
 namespace planner {
 class AbstractPlanNode;
 class HashJoinPlanNode;
+class MergeJoinPlanNode;
 class NestedLoopJoinPlanNode;
 class ProjectionPlanNode;
 class SeqScanPlanNode;
@@ -153,6 +154,18 @@ class PlanGenerator : public OperatorVisitor {
    */
   void Visit(const OuterHashJoin *op) override;
 
+  /**
+   * Visitor function for a SemiHashJoin operator
+   * @param op SemiHashJoin operator being visited
+   */
+  void Visit(const SemiHashJoin *op) override;
+
+  /**
+   * Visitor function for a InnerMergeJoin operator
+   * @param op InnerMergeJoin operator being visited
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
   /**
    * Visitor function for a Insert operator
    * @param op Insert operator being visited
@@ -325,6 +338,17 @@ class PlanGenerator : public OperatorVisitor {
    */
   void CorrectOutputPlanWithProjection();
 
+  /**
+   * Constructs a HashJoin Plan
+   * @param join_type Type of the join
+   * @param join_predicates Predicates of the join
+   * @param left_keys Hash keys of the left (build) child
+   * @param right_keys Hash keys of the right (probe) child
+   */
+  void BuildHashJoinPlan(planner::LogicalJoinType join_type, const std::vector<AnnotatedExpression> &join_predicates,
+                         const std::vector<common::ManagedPointer<parser::AbstractExpression>> &left_keys,
+                         const std::vector<common::ManagedPointer<parser::AbstractExpression>> &right_keys);
+
   /**
    * Constructs an Aggregate Plan
    * @param aggr_type AggregateType
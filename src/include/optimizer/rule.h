@@ -32,9 +32,15 @@ enum class RuleType : uint32_t {
   INSERT_TO_PHYSICAL,
   INSERT_SELECT_TO_PHYSICAL,
   AGGREGATE_TO_HASH_AGGREGATE,
+  AGGREGATE_TO_SORT_AGGREGATE,
   AGGREGATE_TO_PLAIN_AGGREGATE,
   INNER_JOIN_TO_NL_JOIN,
   INNER_JOIN_TO_HASH_JOIN,
+  LEFT_JOIN_TO_HASH_JOIN,
+  RIGHT_JOIN_TO_HASH_JOIN,
+  OUTER_JOIN_TO_HASH_JOIN,
+  SEMI_JOIN_TO_HASH_JOIN,
+  INNER_JOIN_TO_MERGE_JOIN,
   IMPLEMENT_DISTINCT,
   IMPLEMENT_LIMIT,
   EXPORT_EXTERNAL_FILE_TO_PHYSICAL,
@@ -65,6 +71,7 @@ enum class RuleType : uint32_t {
   MARK_JOIN_GET_TO_INNER_JOIN,
   MARK_JOIN_INNER_JOIN_TO_INNER_JOIN,
   MARK_JOIN_FILTER_TO_INNER_JOIN,
+  MARK_JOIN_FILTER_TO_SEMI_JOIN,
   PULL_FILTER_THROUGH_MARK_JOIN,
   PULL_FILTER_THROUGH_AGGREGATION,
 
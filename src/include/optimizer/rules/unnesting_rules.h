@@ -8,9 +8,8 @@
 namespace terrier::optimizer {
 
 // TODO(boweic): MarkJoin and SingleJoin should not be transformed into inner
-// join. Sometimes MarkJoin could be transformed into semi-join, but for now we
-// do not have these operators in the llvm cogen engine. Once we have those, we
-// should not use the following rules in the rewrite phase
+// join. MarkJoins of IN and EXISTS subqueries with equi-join keys become
+// semi-joins, the others are still unnested into inner joins.
 
 /**
  *  Unnest Mark Join to Inner Join
@@ -48,6 +47,45 @@ class UnnestMarkJoinToInnerJoin : public Rule {
                  OptimizationContext *context) const override;
 };
 
+/**
+ * Unnest a Mark Join, whose IN or EXISTS predicate is in the filter above it,
+ * to a Semi Join. The correlated predicates of an EXISTS subquery become the
+ * predicates of the Semi Join. Must be applied before the Mark Join is
+ * unnested into an Inner Join.
+ */
+class UnnestMarkJoinToSemiJoin : public Rule {
+ public:
+  /**
+   * Constructor
+   */
+  UnnestMarkJoinToSemiJoin();
+
+  /**
+   * Gets the rule's promise to apply against a GroupExpression
+   * @param group_expr GroupExpression to compute promise from
+   * @returns The promise value of applying the rule for ordering
+   */
+  RulePromise Promise(GroupExpression *group_expr) const override;
+
+  /**
+   * Checks whether the given rule can be applied
+   * @param plan OperatorExpression to check
+   * @param context Current OptimizationContext executing under
+   * @returns Whether the input OperatorExpression passes the check
+   */
+  bool Check(common::ManagedPointer<OperatorExpression> plan, OptimizationContext *context) const override;
+
+  /**
+   * Transforms the input expression using the given rule
+   * @param input Input OperatorExpression to transform
+   * @param transformed Vector of transformed OperatorExpressions
+   * @param context Current OptimizationContext executing under
+   */
+  void Transform(common::ManagedPointer<OperatorExpression> input,
+                 std::vector<std::unique_ptr<OperatorExpression>> *transformed,
+                 OptimizationContext *context) const override;
+};
+
 /**
  * Unnest Single Join to Inner Join
  */
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "common/hash_util.h"
+#include "common/macros.h"
+#include "common/spin_latch.h"
+
+namespace terrier::optimizer {
+
+/**
+ * Row counts the executor observed for plan fragments, which the StatsCalculator uses in place of its estimates when
+ * the same fragments are optimized again. A fragment is the part of a query a memo group computes, identified by a
+ * hash of its logical operators and their predicates (see Group::GetFragmentKey), so that repeated queries find the
+ * counts of their earlier executions and get planned with them.
+ *
+ * Observations that are within K_MISESTIMATE_RATIO of the estimate the plan was chosen with are blended into the
+ * learned count with weight K_LEARNING_RATE, which smooths out the noise of parameters and concurrent writes. Grossly
+ * misestimated fragments take the observed count as is, so the next plan of the query is built from it.
+ */
+class CardinalityFeedback {
+ public:
+  /**
+   * The weight of a new observation in the learned count of a fragment
+   */
+  static constexpr double K_LEARNING_RATE = 0.5;
+
+  /**
+   * The factor between the estimated and the observed count of a fragment past which the estimate is discarded
+   */
+  static constexpr double K_MISESTIMATE_RATIO = 10.0;
+
+  /**
+   * The number of fragments whose counts are kept. Arbitrary fragments are forgotten to make room for new ones.
+   */
+  static constexpr size_t K_MAX_FRAGMENTS = 1 << 16;
+
+  /**
+   * Creates an empty store
+   */
+  CardinalityFeedback() = default;
+
+  DISALLOW_COPY_AND_MOVE(CardinalityFeedback)
+
+  /**
+   * Learns the number of rows a fragment produced in an execution
+   * @param fragment_key key of the fragment, or 0 for fragments that are not tracked
+   * @param estimated_rows the number of rows the plan was chosen with, or -1 if there was no estimate
+   * @param actual_rows the number of rows the fragment produced
+   * @return whether the estimate was off by more than K_MISESTIMATE_RATIO
+   */
+  bool RecordRows(common::hash_t fragment_key, int64_t estimated_rows, uint64_t actual_rows);
+
+  /**
+   * @param fragment_key key of the fragment
+   * @return the number of rows learned for the fragment, or -1 if it was never executed
+   */
+  int GetLearnedRows(common::hash_t fragment_key);
+
+  /**
+   * @param estimated_rows an estimated number of rows
+   * @param actual_rows an observed number of rows
+   * @return whether the estimate is off by more than K_MISESTIMATE_RATIO
+   */
+  static bool IsMisestimate(int64_t estimated_rows, uint64_t actual_rows);
+
+ private:
+  /**
+   * The learned number of rows of every fragment
+   */
+  std::unordered_map<common::hash_t, double> learned_rows_;
+
+  /**
+   * Protects learned_rows_, which is written by concurrently executing queries
+   */
+  common::SpinLatch latch_;
+};
+
+}  // namespace terrier::optimizer
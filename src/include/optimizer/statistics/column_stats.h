@@ -58,6 +58,12 @@ class ColumnStats {
    */
   size_t &GetNumRows() { return this->num_rows_; }
 
+  /**
+   * Gets the number of rows in the column
+   * @return the number of rows
+   */
+  size_t GetNumRows() const { return num_rows_; }
+
   /**
    * Sets the number of rows int he column
    * @param num_rows number of rows
@@ -70,6 +76,18 @@ class ColumnStats {
    */
   double &GetCardinality() { return this->cardinality_; }
 
+  /**
+   * Gets the cardinality of the column
+   * @return the cardinality
+   */
+  double GetCardinality() const { return cardinality_; }
+
+  /**
+   * Gets the fraction of null values in the column
+   * @return the fraction of nulls
+   */
+  double GetFracNull() const { return frac_null_; }
+
   /**
    * Gets the histogram bounds
    * @return histogram bounds
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "common/strong_typedef.h"
+#include "optimizer/statistics/hyperloglog.h"
+#include "type/type_id.h"
+
+namespace terrier::optimizer {
+
+/**
+ * A mergeable summary of the values of one column: an HLL sketch of the distinct non-NULL values, the number of NULL
+ * and non-NULL values, and the minimum and maximum of numeric columns. ANALYZE builds one for every column of a table,
+ * and DML builds one for the values it writes, which is merged into the table's summary when the transaction commits.
+ *
+ * Summaries of a handful of values keep the hashes of the values instead of an HLL, so that the many small DML
+ * statements of a transactional workload do not each allocate a full sketch.
+ */
+class ColumnSummary {
+ public:
+  /**
+   * The precision of the HLL sketch, giving a standard error of about 1%
+   */
+  static constexpr int K_HLL_PRECISION = 14;
+
+  /**
+   * The number of hashes a summary keeps before it switches to an HLL sketch
+   */
+  static constexpr uint32_t K_MAX_SPARSE_HASHES = 256;
+
+  /**
+   * @param type the type of the column's values
+   * @return whether the optimizer reads values of the type as doubles, for histograms, common values and min/max
+   */
+  static bool IsNumeric(type::TypeId type);
+
+  /**
+   * @param type a numeric type
+   * @param value the value in its storage format
+   * @return the value as a double
+   */
+  static double ReadNumeric(type::TypeId type, const byte *value);
+
+  /**
+   * Creates an empty summary
+   */
+  ColumnSummary() = default;
+
+  /**
+   * Copies a summary, including its sketch
+   * @param other the summary to copy
+   */
+  ColumnSummary(const ColumnSummary &other);
+
+  /**
+   * Move constructor
+   * @param other the summary to move from
+   */
+  ColumnSummary(ColumnSummary &&other) = default;
+
+  /**
+   * Move assignment
+   * @param other the summary to move from
+   * @return this summary
+   */
+  ColumnSummary &operator=(ColumnSummary &&other) = default;
+
+  /**
+   * Account for a NULL value
+   */
+  void AddNull() { num_nulls_++; }
+
+  /**
+   * Account for a non-NULL value
+   * @param type the type of the value
+   * @param value the value in its storage format; a VarlenEntry for variable-length types
+   */
+  void Add(type::TypeId type, const byte *value);
+
+  /**
+   * Add the values of another summary to this one
+   * @param other the summary to merge
+   */
+  void Merge(const ColumnSummary &other);
+
+  /**
+   * @return the estimated number of distinct non-NULL values
+   */
+  uint64_t EstimateCardinality() const;
+
+  /**
+   * @return the number of NULL values
+   */
+  uint64_t GetNumNulls() const { return num_nulls_; }
+
+  /**
+   * @return the number of non-NULL values
+   */
+  uint64_t GetNumValues() const { return num_values_; }
+
+  /**
+   * @return whether the summary saw a numeric value, i.e. whether GetMinValue and GetMaxValue are meaningful
+   */
+  bool HasMinMax() const { return min_value_ <= max_value_; }
+
+  /**
+   * @return the smallest numeric value
+   */
+  double GetMinValue() const { return min_value_; }
+
+  /**
+   * @return the largest numeric value
+   */
+  double GetMaxValue() const { return max_value_; }
+
+ private:
+  // Add a hashed value to the sparse hashes or the sketch
+  void AddHash(uint64_t hash);
+
+  // Replace the sparse hashes by a sketch
+  void Densify();
+
+  /**
+   * Hashes of the distinct values, until there are more than K_MAX_SPARSE_HASHES of them
+   */
+  std::vector<uint64_t> hashes_;
+
+  /**
+   * Sketch of the distinct values, or nullptr while the hashes are kept
+   */
+  std::unique_ptr<HyperLogLog<uint64_t>> hll_;
+
+  /**
+   * Number of NULL values
+   */
+  uint64_t num_nulls_ = 0;
+
+  /**
+   * Number of non-NULL values
+   */
+  uint64_t num_values_ = 0;
+
+  /**
+   * Smallest numeric value
+   */
+  double min_value_ = std::numeric_limits<double>::max();
+
+  /**
+   * Largest numeric value
+   */
+  double max_value_ = std::numeric_limits<double>::lowest();
+};
+
+}  // namespace terrier::optimizer
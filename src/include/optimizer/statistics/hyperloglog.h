@@ -36,6 +36,8 @@ class HyperLogLog {
    */
   ~HyperLogLog() { delete hll_; }
 
+  DISALLOW_COPY_AND_MOVE(HyperLogLog)
+
   /**
    * Update the existence of the given key in the HLL. Note that we only
    * need to keep track that we saw it and not the number of times that we saw it.
@@ -49,7 +51,23 @@ class HyperLogLog {
    * @param key a pointer to the underlying storage of the key
    * @param length the length of the key.
    */
-  void Update(const void *key, size_t length) { hll_->Update(XXH3_64bits(key, length)); }
+  void Update(const void *key, size_t length) { UpdateHash(XXH3_64bits(key, length)); }
+
+  /**
+   * Update the existence of a key that was already hashed with XXH3_64bits.
+   * @param hash the hash of the key
+   */
+  void UpdateHash(uint64_t hash) { hll_->Update(hash); }
+
+  /**
+   * Add the keys seen by another HLL of the same precision to this one, so that this HLL estimates
+   * the cardinality of the union of both key sets.
+   * @param other the HLL to merge
+   */
+  void Merge(const HyperLogLog &other) {
+    TERRIER_ASSERT(precision_ == other.precision_, "Only HLLs of the same precision can be merged");
+    hll_->Merge(other.hll_);
+  }
 
   /**
    * Compute the bias-corrected estimate using the HyperLogLog++ algorithm.
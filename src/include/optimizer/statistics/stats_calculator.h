@@ -15,7 +15,8 @@
 namespace terrier::optimizer {
 
 /**
- * Derive stats for the root group using a group expression's children's stats
+ * Derive stats for the root group using a group expression's children's stats. The row counts executed queries
+ * reported to the CardinalityFeedback take precedence over the estimates.
  */
 class StatsCalculator : public OperatorVisitor {
  public:
@@ -58,6 +59,20 @@ class StatsCalculator : public OperatorVisitor {
   void Visit(const LogicalLimit *op) override;
 
  private:
+  /**
+   * Computes the key of the group of gexpr_ in the CardinalityFeedback from the logical operator and the keys of the
+   * child groups
+   * @returns the fragment key, or 0 if a child group is not tracked
+   */
+  common::hash_t ComputeFragmentKey();
+
+  /**
+   * Replaces an estimate of the rows of the group of gexpr_ with the rows its executions produced, if there were any
+   * @param estimated_rows the estimated number of rows
+   * @returns the number of rows to plan the group with
+   */
+  int CorrectNumRows(int estimated_rows);
+
   /**
    * Add the base table stats if the base table maintain stats, or else
    * use default stats
@@ -65,8 +80,7 @@ class StatsCalculator : public OperatorVisitor {
    * @param table_stats Base table stats
    * @param stats The stats map to add
    */
-  void AddBaseTableStats(common::ManagedPointer<parser::AbstractExpression> col,
-                         common::ManagedPointer<TableStats> table_stats,
+  void AddBaseTableStats(common::ManagedPointer<parser::AbstractExpression> col, const TableStats &table_stats,
                          std::unordered_map<std::string, std::unique_ptr<ColumnStats>> *stats);
 
   /**
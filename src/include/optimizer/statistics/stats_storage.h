@@ -2,16 +2,30 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog_defs.h"
 #include "common/hash_util.h"
 #include "common/macros.h"
 #include "common/managed_pointer.h"
+#include "common/spin_latch.h"
 
+#include "optimizer/statistics/cardinality_feedback.h"
 #include "optimizer/statistics/column_stats.h"
 #include "optimizer/statistics/table_stats.h"
+#include "optimizer/statistics/table_stats_delta.h"
+
+namespace terrier::execution::sql {
+class AnalyzeExecutor;
+}  // namespace terrier::execution::sql
+
+namespace terrier::execution::compiler::test {
+class CompilerTest_StaleStatsDenseAggregateTest_Test;
+}  // namespace terrier::execution::compiler::test
 
 namespace terrier::optimizer {
 /**
@@ -61,17 +75,57 @@ namespace terrier::optimizer {
  * Manages all the existing table stats objects. Stores them in an
  * unordered map and keeps track of them using their database and table oids. Can
  * add, update, or delete table stats objects from the storage map.
+ *
+ * Committed DML keeps the statistics current between ANALYZE runs through ApplyTableStatsDelta. Once the rows modified
+ * since a table was analyzed exceed K_REFRESH_MIN_ROWS plus K_REFRESH_FRACTION of its rows (the rule of PostgreSQL's
+ * autovacuum), the table is reported by TakeStaleTables so that it gets analyzed again. Executed queries also report
+ * the row counts of their plan fragments to the CardinalityFeedback, which corrects the estimates of repeated queries.
  */
 class StatsStorage {
  public:
+  /**
+   * The fraction of a table's rows that must be modified before its statistics are refreshed
+   */
+  static constexpr double K_REFRESH_FRACTION = 0.1;
+
+  /**
+   * The number of modified rows, on top of K_REFRESH_FRACTION, before a table's statistics are refreshed
+   */
+  static constexpr size_t K_REFRESH_MIN_ROWS = 50;
+
   /**
    * Using given database and table ids,
    * select a pointer to the TableStats objects in the table stats storage map.
+   * The statistics are an immutable snapshot: later changes to the table's statistics publish a new TableStats, and
+   * the returned one stays valid for as long as the caller holds it.
+   * @param database_id - oid of database
+   * @param table_id - oid of table
+   * @return pointer to a TableStats object, or nullptr if the table has no statistics
+   */
+  std::shared_ptr<const TableStats> GetTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id);
+
+  /**
+   * Adds the changes a committed transaction made to a table to its statistics, and marks the table stale if enough
+   * of it was modified since it was analyzed. Tables that were never analyzed get no statistics, only a count of their
+   * modified rows.
    * @param database_id - oid of database
    * @param table_id - oid of table
-   * @return pointer to a TableStats object
+   * @param delta - changes made to the table
    */
-  common::ManagedPointer<TableStats> GetTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id);
+  void ApplyTableStatsDelta(catalog::db_oid_t database_id, catalog::table_oid_t table_id, const TableStatsDelta &delta);
+
+  /**
+   * Returns the tables that became stale since the last call, which the caller should analyze
+   * @return database and table oids of the stale tables
+   */
+  std::vector<StatsStorageKey> TakeStaleTables();
+
+  /**
+   * @return the row counts observed for the plan fragments of executed queries
+   */
+  common::ManagedPointer<CardinalityFeedback> GetCardinalityFeedback() {
+    return common::ManagedPointer(&cardinality_feedback_);
+  }
 
  protected:
   /**
@@ -95,18 +149,70 @@ class StatsStorage {
    */
   bool DeleteTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id);
 
+  /**
+   * Publishes freshly gathered statistics of a table in place of its current ones, if any, and forgets the table's
+   * modifications.
+   * @param database_id - oid of database
+   * @param table_id - oid of table
+   * @param table_stats - TableStats object to publish
+   */
+  void ReplaceTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id, TableStats table_stats);
+
  private:
+  /**
+   * ANALYZE replaces the statistics of the tables it scans.
+   */
+  friend class execution::sql::AnalyzeExecutor;
+
   /**
    * The following tests check to make sure the protected insert/delete functions work.
    */
   FRIEND_TEST(StatsStorageTests, GetTableStatsTest);
   FRIEND_TEST(StatsStorageTests, InsertTableStatsTest);
   FRIEND_TEST(StatsStorageTests, DeleteTableStatsTest);
+  FRIEND_TEST(StatsStorageTests, StaleTablesTest);
+  FRIEND_TEST(StatsStorageTests, SnapshotTest);
+
+  /**
+   * The cost model reads the sizes of analyzed tables.
+   */
+  FRIEND_TEST(StatsCostModelTests, ScanTest);
+
+  /**
+   * Generated code reads the key ranges of analyzed columns.
+   */
+  friend class execution::compiler::test::CompilerTest_StaleStatsDenseAggregateTest_Test;
 
   /**
    * An unordered map mapping StatsStorageKey objects (database_id and table_id) to
    * TableStats pointers. This represents the storage for TableStats objects.
    */
-  std::unordered_map<StatsStorageKey, std::unique_ptr<TableStats>> table_stats_storage_;
+  std::unordered_map<StatsStorageKey, std::shared_ptr<const TableStats>> table_stats_storage_;
+
+  /**
+   * The number of rows modified in tables that have no TableStats yet.
+   */
+  std::unordered_map<StatsStorageKey, size_t> unanalyzed_modified_rows_;
+
+  /**
+   * Tables whose statistics should be refreshed.
+   */
+  std::unordered_set<StatsStorageKey> stale_tables_;
+
+  /**
+   * Protects the maps above, which are written by committing transactions.
+   */
+  common::SpinLatch latch_;
+
+  /**
+   * Serializes the writers of the statistics, so that a delta applied to a copy of a table's statistics is not lost
+   * to another writer. Copies are made outside of latch_, which readers take.
+   */
+  std::mutex update_latch_;
+
+  /**
+   * The row counts observed for plan fragments. It has its own latch, since executing queries write it.
+   */
+  CardinalityFeedback cardinality_feedback_;
 };
 }  // namespace terrier::optimizer
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
@@ -9,8 +10,11 @@
 #include "common/managed_pointer.h"
 
 #include "optimizer/statistics/column_stats.h"
+#include "optimizer/statistics/column_summary.h"
 
 namespace terrier::optimizer {
+class TableStatsDelta;
+
 /**
  * Represents the statistics of a given table. Stores relevant oids and
  * other important information, as well as a list of all the ColumnStats objects for
@@ -39,6 +43,26 @@ class TableStats {
    */
   TableStats() = default;
 
+  /**
+   * Copies the statistics of a table, including its ColumnStats and column summaries. StatsStorage applies deltas
+   * to copies, since the optimizers of other queries may still read the original.
+   * @param other - statistics to copy
+   */
+  TableStats(const TableStats &other);
+
+  /**
+   * Move constructor
+   * @param other - statistics to move from
+   */
+  TableStats(TableStats &&other) = default;
+
+  /**
+   * Move assignment
+   * @param other - statistics to move from
+   * @return this object
+   */
+  TableStats &operator=(TableStats &&other) = default;
+
   /**
    * Updates the number of rows in the table and all of its columns
    * @param new_num_rows - the new number of rows to update to
@@ -84,6 +108,13 @@ class TableStats {
    */
   common::ManagedPointer<ColumnStats> GetColumnStats(catalog::col_oid_t column_id);
 
+  /**
+   * Retrieves the ColumnStats object for the given column oid in the ColumnStats map
+   * @param column_id - the oid of the column
+   * @return the pointer to the ColumnStats object, or nullptr if there is none
+   */
+  common::ManagedPointer<const ColumnStats> GetColumnStats(catalog::col_oid_t column_id) const;
+
   /**
    * Removes the ColumnStats object for the given column oid in the ColumnStats map
    * @param column_id - the oid of the column
@@ -103,6 +134,35 @@ class TableStats {
    */
   size_t GetNumRows() const { return num_rows_; }
 
+  /**
+   * Sets the summary of a column's values that later deltas are merged into. ANALYZE sets one for every column.
+   * @param column_id - oid of column
+   * @param summary - summary of the column's values
+   */
+  void SetColumnSummary(catalog::col_oid_t column_id, ColumnSummary &&summary) {
+    column_summaries_[column_id] = std::move(summary);
+  }
+
+  /**
+   * Gets the summary of a column's values
+   * @param column_id - oid of column
+   * @return pointer to the summary, or nullptr if the column was neither analyzed nor written to since
+   */
+  common::ManagedPointer<const ColumnSummary> GetColumnSummary(catalog::col_oid_t column_id) const;
+
+  /**
+   * Adds the changes a committed transaction made to the table: the row count moves by the inserted and deleted
+   * rows, and the written values are merged into the column summaries and the cardinalities of the ColumnStats.
+   * @param delta - changes made to the table
+   */
+  void ApplyDelta(const TableStatsDelta &delta);
+
+  /**
+   * Gets the number of rows inserted, deleted or updated since the statistics were gathered
+   * @return the number of modified rows
+   */
+  size_t GetNumModifiedRows() const { return num_modified_rows_; }
+
   /**
    * Serializes a table stats object
    * @return table stats object serialized to json
@@ -148,10 +208,20 @@ class TableStats {
    */
   bool is_base_table_;
 
+  /**
+   * number of rows modified since the statistics were gathered
+   */
+  size_t num_modified_rows_ = 0;
+
   /**
    * stores the ColumnStats objects for the columns in the table
    */
   std::unordered_map<catalog::col_oid_t, std::unique_ptr<ColumnStats>> column_stats_;
+
+  /**
+   * stores the mergeable summaries of the values of the columns in the table
+   */
+  std::unordered_map<catalog::col_oid_t, ColumnSummary> column_summaries_;
 };
 DEFINE_JSON_DECLARATIONS(TableStats)
 }  // namespace terrier::optimizer
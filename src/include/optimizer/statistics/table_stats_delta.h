@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "optimizer/statistics/column_summary.h"
+
+namespace terrier::optimizer {
+
+/**
+ * The changes a query made to one table, gathered by the executor as it writes and added to the table's TableStats
+ * when the transaction commits: the number of inserted, deleted and updated rows, and a summary of the written values
+ * of each column.
+ */
+class TableStatsDelta {
+ public:
+  /**
+   * Creates an empty delta
+   */
+  TableStatsDelta() = default;
+
+  DISALLOW_COPY_AND_MOVE(TableStatsDelta)
+
+  /**
+   * Account for an inserted row. Its values go to the column summaries.
+   */
+  void RecordInsert() { num_inserted_++; }
+
+  /**
+   * Account for a deleted row
+   */
+  void RecordDelete() { num_deleted_++; }
+
+  /**
+   * Account for an updated row. Its new values go to the column summaries.
+   */
+  void RecordUpdate() { num_updated_++; }
+
+  /**
+   * @param column_id oid of a column
+   * @return the summary of the values written to the column, which stays valid for the lifetime of the delta
+   */
+  ColumnSummary *GetColumnSummary(catalog::col_oid_t column_id) { return &column_summaries_[column_id]; }
+
+  /**
+   * @return the summaries of the values written to each column
+   */
+  const std::unordered_map<catalog::col_oid_t, ColumnSummary> &GetColumnSummaries() const { return column_summaries_; }
+
+  /**
+   * @return the number of inserted rows
+   */
+  uint64_t GetNumInserted() const { return num_inserted_; }
+
+  /**
+   * @return the number of deleted rows
+   */
+  uint64_t GetNumDeleted() const { return num_deleted_; }
+
+  /**
+   * @return the number of inserted, deleted and updated rows
+   */
+  uint64_t GetNumModifiedRows() const { return num_inserted_ + num_deleted_ + num_updated_; }
+
+ private:
+  /**
+   * Number of inserted rows
+   */
+  uint64_t num_inserted_ = 0;
+
+  /**
+   * Number of deleted rows
+   */
+  uint64_t num_deleted_ = 0;
+
+  /**
+   * Number of updated rows
+   */
+  uint64_t num_updated_ = 0;
+
+  /**
+   * Summaries of the written values of each column
+   */
+  std::unordered_map<catalog::col_oid_t, ColumnSummary> column_summaries_;
+};
+
+}  // namespace terrier::optimizer
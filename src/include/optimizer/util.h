@@ -37,7 +37,7 @@ class OptimizerUtil {
 
   /**
    * Walks through a vector of join predicates. Generates join keys based on the sets of left
-   * and right table aliases.
+   * and right table aliases. Equalities and unnested IN predicates between columns are keys.
    *
    * @param join_predicates vector of join predicates
    * @param left_keys output vector of left keys
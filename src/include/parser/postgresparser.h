@@ -173,6 +173,7 @@ class PostgresParser {
                                                                 char *alias);
   static std::unique_ptr<AbstractExpression> ConstTransform(ParseResult *parse_result, A_Const *root);
   static std::unique_ptr<AbstractExpression> FuncCallTransform(ParseResult *parse_result, FuncCall *root);
+  static std::unique_ptr<AbstractExpression> InListTransform(ParseResult *parse_result, A_Expr *root);
   static std::unique_ptr<AbstractExpression> NullTestTransform(ParseResult *parse_result, NullTest *root);
   static std::unique_ptr<AbstractExpression> ParamRefTransform(ParseResult *parse_result, ParamRef *root);
   static std::unique_ptr<AbstractExpression> SubqueryExprTransform(ParseResult *parse_result, SubLink *node);
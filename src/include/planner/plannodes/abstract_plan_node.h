@@ -124,6 +124,27 @@ class AbstractPlanNode {
    */
   common::ManagedPointer<OutputSchema> GetOutputSchema() const { return common::ManagedPointer(output_schema_); }
 
+  /**
+   * Records what the optimizer expected of the rows of this node, so that the executor can report how many there were.
+   * The estimate is not part of the plan, so hashing, comparing and serializing plans ignores it.
+   * @param fragment_key key of the rows in the optimizer's CardinalityFeedback, or 0 if they are not tracked
+   * @param estimated_rows the number of rows the plan was chosen with, or -1 if there was no estimate
+   */
+  void SetCardinalityEstimate(common::hash_t fragment_key, int64_t estimated_rows) {
+    fragment_key_ = fragment_key;
+    estimated_rows_ = estimated_rows;
+  }
+
+  /**
+   * @return key of the rows of this node in the optimizer's CardinalityFeedback, or 0 if they are not tracked
+   */
+  common::hash_t GetFragmentKey() const { return fragment_key_; }
+
+  /**
+   * @return the number of rows the optimizer expected this node to produce, or -1 if there was no estimate
+   */
+  int64_t GetEstimatedRows() const { return estimated_rows_; }
+
   //===--------------------------------------------------------------------===//
   // JSON Serialization/Deserialization
   //===--------------------------------------------------------------------===//
@@ -198,6 +219,8 @@ class AbstractPlanNode {
  private:
   std::vector<std::unique_ptr<AbstractPlanNode>> children_;
   std::unique_ptr<OutputSchema> output_schema_;
+  common::hash_t fragment_key_ = 0;
+  int64_t estimated_rows_ = -1;
 };
 
 DEFINE_JSON_DECLARATIONS(AbstractPlanNode);
@@ -20,6 +20,12 @@
 
 namespace terrier::planner {
 
+/**
+ * Lower and upper bound of one of the key ranges of an AscendingRanges index scan
+ */
+using IndexKeyRange = std::pair<std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression>,
+                                std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression>>;
+
 /**
  * Index Scan Predicate Description
  */
@@ -217,6 +223,18 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
       return *this;
     }
 
+    /**
+     * Adds a key range to an AscendingRanges scan.
+     * @param lo_index_cols lower bound of the range
+     * @param hi_index_cols upper bound of the range
+     * @return builder object
+     */
+    Builder &AddKeyRange(std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&lo_index_cols,
+                         std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&hi_index_cols) {
+      key_ranges_.emplace_back(std::move(lo_index_cols), std::move(hi_index_cols));
+      return *this;
+    }
+
     /**
      * @param column_oids OIDs of columns to scan
      * @return builder object
@@ -226,6 +244,15 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
       return *this;
     }
 
+    /**
+     * @param index_only whether the scanned columns are all read from the index keys, without fetching the tuples
+     * @return builder object
+     */
+    Builder &SetIndexOnly(bool index_only) {
+      index_only_ = index_only;
+      return *this;
+    }
+
     /**
      * @param desc IndexScanDescription for index scan
      * @return builder object
@@ -243,7 +270,8 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
       return std::unique_ptr<IndexScanPlanNode>(new IndexScanPlanNode(
           std::move(children_), std::move(output_schema_), scan_predicate_, std::move(column_oids_),
           std::move(index_scan_desc_), is_for_update_, database_oid_, namespace_oid_, index_oid_, table_oid_,
-          scan_type_, std::move(lo_index_cols_), std::move(hi_index_cols_), scan_limit_));
+          scan_type_, std::move(lo_index_cols_), std::move(hi_index_cols_), std::move(key_ranges_), scan_limit_,
+          index_only_));
     }
 
    private:
@@ -254,7 +282,9 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
     IndexScanDescription index_scan_desc_;
     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> lo_index_cols_{};
     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> hi_index_cols_{};
+    std::vector<IndexKeyRange> key_ranges_{};
     uint32_t scan_limit_{0};
+    bool index_only_{false};
   };
 
  private:
@@ -271,7 +301,9 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
    * @param scan_type Type of the scan
    * @param lo_index_cols lower bound of the scan (or exact key when scan type = Exact).
    * @param hi_index_cols upper bound of the scan
+   * @param key_ranges key ranges of the scan when scan type = AscendingRanges
    * @param scan_limit limit of the scan if any
+   * @param index_only whether the scanned columns are all read from the index keys
    */
   IndexScanPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
                     std::unique_ptr<OutputSchema> output_schema,
@@ -281,7 +313,7 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
                     catalog::index_oid_t index_oid, catalog::table_oid_t table_oid, IndexScanType scan_type,
                     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&lo_index_cols,
                     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&hi_index_cols,
-                    uint32_t scan_limit)
+                    std::vector<IndexKeyRange> &&key_ranges, uint32_t scan_limit, bool index_only)
       : AbstractScanPlanNode(std::move(children), std::move(output_schema), predicate, is_for_update, database_oid,
                              namespace_oid),
         scan_type_(scan_type),
@@ -291,7 +323,9 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
         index_scan_desc_(std::move(scan_desc)),
         lo_index_cols_(std::move(lo_index_cols)),
         hi_index_cols_(std::move(hi_index_cols)),
-        scan_limit_(scan_limit) {}
+        key_ranges_(std::move(key_ranges)),
+        scan_limit_(scan_limit),
+        index_only_(index_only) {}
 
  public:
   /**
@@ -342,6 +376,11 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
     return hi_index_cols_;
   }
 
+  /**
+   * @return the key ranges of an AscendingRanges scan
+   */
+  const std::vector<IndexKeyRange> &GetKeyRanges() const { return key_ranges_; }
+
   /**
    * @return The scan type
    */
@@ -352,6 +391,13 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
    */
   uint32_t ScanLimit() const { return scan_limit_; }
 
+  /**
+   * An index-only scan reads the scanned columns from the keys of the index entries, and never fetches the tuples from
+   * the table. The index already checks the visibility of every entry.
+   * @return whether this is an index-only scan
+   */
+  bool IsIndexOnly() const { return index_only_; }
+
   /**
    * @return the type of this plan node
    */
@@ -374,7 +420,9 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
   IndexScanDescription index_scan_desc_;
   std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> lo_index_cols_{};
   std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> hi_index_cols_{};
+  std::vector<IndexKeyRange> key_ranges_{};
   uint32_t scan_limit_;
+  bool index_only_{false};
 };
 
 DEFINE_JSON_DECLARATIONS(IndexScanDescription)
@@ -29,6 +29,7 @@ enum class PlanNodeType {
   NESTLOOP,
   HASHJOIN,
   INDEXNLJOIN,
+  MERGEJOIN,
 
   // Mutator Nodes
   UPDATE,
@@ -87,7 +88,8 @@ enum class LogicalJoinType {
   RIGHT = 2,                  // right
   INNER = 3,                  // inner
   OUTER = 4,                  // outer
-  SEMI = 5                    // IN+Subquery is SEMI
+  SEMI = 5,                   // IN+Subquery is SEMI
+  ANTI = 6                    // NOT IN+Subquery is ANTI
 };
 
 //===--------------------------------------------------------------------===//
@@ -110,8 +112,8 @@ enum class SetOpType { INVALID = INVALID_TYPE_ID, INTERSECT = 1, INTERSECT_ALL =
 //===--------------------------------------------------------------------===//
 
 using IndexExpression = common::ManagedPointer<parser::AbstractExpression>;
-/** Type of index scan. */
-enum class IndexScanType : uint8_t { Exact, Ascending, Descending, AscendingLimit, DescendingLimit };
+/** Type of index scan. AscendingRanges scans the union of several key ranges, like the ones of an IN list. */
+enum class IndexScanType : uint8_t { Exact, Ascending, Descending, AscendingLimit, DescendingLimit, AscendingRanges };
 
 // TODO(Gus,Wen) Tuple as a concept does not exist yet, someone need to define it in the storage layer, possibly a
 /**
@@ -114,6 +114,58 @@ SETTING_int(task_execution_timeout,
             "assuming one plan has been found (default 5000)",
             5000, 1000, 60000, false, terrier::settings::Callbacks::NoOp)
 
+// Optimizer workers
+SETTING_int(optimizer_workers,
+            "Number of threads that search for the plan of a query in the optimizer (default 1)",
+            1, 1, 64, false, terrier::settings::Callbacks::NoOp)
+
+// Query memory limit
+SETTING_int64(query_memory_limit,
+              "Maximum number of bytes a query may use before its sorts, hash joins and aggregations spill, "
+              "or 0 for no limit (default 0)",
+              0, 0, (1LL << 40) /* 1TB */, false, terrier::settings::Callbacks::NoOp)
+
+// Cost model unit costs, see optimizer::CostModelParameters and benchmark/optimizer/cost_model_calibration_benchmark
+SETTING_double(cost_seq_tuple,
+               "Nanoseconds the cost model charges to read one tuple in a sequential scan (default 4.0)",
+               4.0, 0.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
+SETTING_double(cost_cpu_operator,
+               "Nanoseconds the cost model charges to evaluate one predicate on one tuple (default 2.0)",
+               2.0, 0.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
+SETTING_double(cost_index_probe,
+               "Nanoseconds the cost model charges to descend one level of an index (default 25.0)",
+               25.0, 0.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
+SETTING_double(cost_index_tuple,
+               "Nanoseconds the cost model charges to fetch one tuple found through an index (default 90.0)",
+               90.0, 0.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
+SETTING_double(cost_hash_build,
+               "Nanoseconds the cost model charges to insert one tuple into a hash table (default 30.0)",
+               30.0, 0.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
+SETTING_double(cost_hash_probe,
+               "Nanoseconds the cost model charges to probe a hash table with one tuple (default 20.0)",
+               20.0, 0.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
+SETTING_double(cost_sort_compare,
+               "Nanoseconds the cost model charges for one comparison of a sort (default 6.0)",
+               6.0, 0.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
+SETTING_double(cost_output_tuple,
+               "Nanoseconds the cost model charges to hand one tuple to the parent operator (default 1.0)",
+               1.0, 0.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
+SETTING_double(cost_spill_tuple,
+               "Nanoseconds the cost model charges to write one tuple to a spill file and read it back (default 250.0)",
+               250.0, 0.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
+SETTING_double(cost_tuple_width,
+               "Bytes the cost model assumes for a materialized tuple (default 64.0)",
+               64.0, 1.0, 1000000.0, false, terrier::settings::Callbacks::NoOp)
+
 // Parallel Execution
 SETTING_bool(
     parallel_execution,
@@ -5,6 +5,7 @@
 #include "storage/block_layout.h"
 #include "storage/storage_defs.h"
 #include "storage/storage_util.h"
+#include "storage/zone_map.h"
 
 namespace terrier::storage {
 
@@ -164,11 +165,23 @@ class ArrowColumnInfo {
    * @return type of the Arrow Column
    */
   ArrowColumnType &Type() { return type_; }
+
+  /**
+   * @return type of the Arrow Column
+   */
+  ArrowColumnType Type() const { return type_; }
+
   /**
    * @return ArrowVarlenColumn object for the column
    */
   ArrowVarlenColumn &VarlenColumn() { return varlen_column_; }
 
+  /**
+   * @return ArrowVarlenColumn object for the column. If the column is dictionary compressed, this is the dictionary,
+   *         whose words are sorted in lexicographic order.
+   */
+  const ArrowVarlenColumn &VarlenColumn() const { return varlen_column_; }
+
   /**
    * Returns the indices array. This array is only meaningful if the column is dictionary compressed. The
    * size of this array is equal to the number of slots in a block.
@@ -180,6 +193,15 @@ class ArrowColumnInfo {
     return indices_;
   }
 
+  /**
+   * @return the indices array. @see Indices()
+   */
+  const uint32_t *Indices() const {
+    TERRIER_ASSERT(type_ == ArrowColumnType::DICTIONARY_COMPRESSED,
+                   "this array is only meaningful if the column is dicationary compressed");
+    return indices_;
+  }
+
   /**
    * Deallocates all associated buffers in the ArrowVarlenColumn
    */
@@ -217,7 +239,7 @@ class ArrowBlockMetadata {
    */
   static uint32_t Size(uint16_t num_cols) {
     return StorageUtil::PadUpToSize(sizeof(uint64_t), static_cast<uint32_t>(sizeof(uint32_t)) * (num_cols + 1)) +
-           num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo));
+           num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo) + sizeof(ZoneMap));
   }
 
   /**
@@ -274,9 +296,31 @@ class ArrowBlockMetadata {
     return reinterpret_cast<ArrowColumnInfo *>(null_count_end)[!col_id];
   }
 
+  /**
+   * @param layout layout object of the Block
+   * @param col_id the column of interest
+   * @return the zone map of the given column
+   */
+  ZoneMap &GetZoneMap(const BlockLayout &layout, col_id_t col_id) { return ZoneMaps(layout)[!col_id]; }
+
+  /**
+   * @param layout layout object of the Block
+   * @param col_id the column of interest
+   * @return the zone map of the given column
+   */
+  const ZoneMap &GetZoneMap(const BlockLayout &layout, col_id_t col_id) const { return ZoneMaps(layout)[!col_id]; }
+
  private:
+  // The zone maps follow the column infos
+  ZoneMap *ZoneMaps(const BlockLayout &layout) const {
+    byte *null_count_end =
+        storage::StorageUtil::AlignedPtr(sizeof(uint64_t), varlen_content_ + sizeof(uint32_t) * layout.NumColumns());
+    return reinterpret_cast<ZoneMap *>(reinterpret_cast<ArrowColumnInfo *>(null_count_end) + layout.NumColumns());
+  }
+
   uint32_t num_records_;  // number of actual records
   // null_count[num_cols] (32-bit) | padding up to 8 byte-aligned | arrow_varlen_buffers[num_cols] |
+  // zone_maps[num_cols] |
   byte varlen_content_[];
 };
 }  // namespace terrier::storage
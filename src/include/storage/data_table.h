@@ -8,6 +8,7 @@
 #include "storage/storage_defs.h"
 #include "storage/tuple_access_strategy.h"
 #include "storage/undo_record.h"
+#include "storage/zone_map.h"
 
 namespace terrier::transaction {
 class TransactionContext;
@@ -113,8 +114,11 @@ class DataTable {
    * @param store the Block store to use.
    * @param layout the initial layout of this DataTable. First 2 columns must be 8 bytes.
    * @param layout_version the layout version of this DataTable
+   * @param zone_map_types how to interpret the values of each column when building zone maps, indexed by col_id. If
+   *                       empty, no zone maps are built.
    */
-  DataTable(BlockStore *store, const BlockLayout &layout, layout_version_t layout_version);
+  DataTable(BlockStore *store, const BlockLayout &layout, layout_version_t layout_version,
+            std::vector<ZoneMapType> zone_map_types = {});
 
   /**
    * Destructs a DataTable, frees all its blocks and any potential varlen entries.
@@ -149,9 +153,29 @@ class DataTable {
    * @param start_pos iterator to the starting location for the sequential scan
    * @param out_buffer output buffer. The object should already contain projection list information. This buffer is
    *                   always cleared of old values.
+   * @param filter if given, blocks whose zone maps show that none of their tuples satisfy the filter are skipped
+   *               without being read. Tuples in other blocks are returned whether or not they satisfy it.
+   * @param stop_pos if given, the scan stops at this slot (exclusive) instead of at end(). Together with BlockBegins,
+   *                 this lets several threads scan disjoint ranges of blocks.
    */
   void Scan(common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *start_pos,
-            ProjectedColumns *out_buffer) const;
+            ProjectedColumns *out_buffer, const ZoneMapFilter *filter = nullptr,
+            const SlotIterator *stop_pos = nullptr) const;
+
+  /**
+   * Reads the dictionary codes of a varlen column for the tuples materialized into a buffer by Scan. Codes are only
+   * available if every tuple in the buffer came from the same block, the block is frozen, and the column is dictionary
+   * compressed in it. The varlen entries in the buffer then point into the words of the returned dictionary, which
+   * live as long as they do.
+   *
+   * @param columns buffer filled by Scan
+   * @param projection_list_index index of the varlen column in the buffer
+   * @param[out] codes the dictionary code of the i-th tuple in the buffer is written at position i. Codes of NULL
+   *                   values are undefined.
+   * @return the dictionary of the block, or nullptr if codes are not available
+   */
+  const ArrowVarlenColumn *ReadDictionaryCodes(const ProjectedColumns &columns, uint16_t projection_list_index,
+                                               uint32_t *codes) const;
 
   /**
    * @return the first tuple slot contained in the data table
@@ -170,6 +194,12 @@ class DataTable {
    */
   SlotIterator end() const;  // NOLINT for STL name compability
 
+  /**
+   * @return an iterator to the first slot of every block in the table, in scan order. The blocks between two of them
+   *         can be scanned by passing the later one as the stop position of Scan.
+   */
+  std::vector<SlotIterator> BlockBegins() const;
+
   /**
    * Update the tuple according to the redo buffer given, and update the version chain to link to an
    * undo record that is allocated in the txn. The undo record is populated with a before-image of the tuple in the
@@ -234,6 +264,8 @@ class DataTable {
   BlockStore *const block_store_;
   const layout_version_t layout_version_;
   const TupleAccessStrategy accessor_;
+  // How to build the zone map of each column, indexed by col_id. Empty if zone maps are not built.
+  const std::vector<ZoneMapType> zone_map_types_;
 
   // TODO(Tianyu): For now, on insertion, we simply sequentially go through a block and allocate a
   // new one when the current one is full. Needless to say, we will need to revisit this when extending GC to handle
@@ -252,6 +284,8 @@ class DataTable {
   // Check if we need to advance the insertion_head_
   // This function uses header_latch_ to ensure correctness
   void CheckMoveHead(std::list<RawBlock *>::iterator block);
+  // Advance the iterator to the first slot of the next block
+  void SkipBlock(SlotIterator *pos) const;
   mutable DataTableCounter data_table_counter_;
 
   // A templatized version for select, so that we can use the same code for both row and column access.
@@ -292,7 +326,7 @@ class DataTable {
   /**
    * Determine if a Tuple is visible (present and not deleted) to the given transaction. It's effectively Select's logic
    * (follow a version chain if present) without the materialization. If the logic of Select changes, this should change
-   * with it and vice versa.
+   * with it and vice versa. Tuples in frozen blocks are checked without reading their version pointers.
    * @param txn the calling transaction
    * @param slot the slot of the tuple to check visibility on
    * @return true if tuple is visible to this txn, false otherwise
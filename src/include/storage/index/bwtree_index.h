@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -221,6 +222,104 @@ class BwTreeIndex final : public Index {
       scan_itr--;
     }
   }
+
+  bool SupportsScanWithKeys() const final { return KeyType::CanWriteToProjectedRow(metadata_); }
+
+  void ScanWithKeys(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                    const ProjectedRow &high_key, const bool ascending, const uint32_t limit,
+                    std::vector<TupleSlot> *value_list, std::vector<byte> *key_rows) final {
+    TERRIER_ASSERT(value_list->empty() && key_rows->empty(), "Result sets should begin empty.");
+    TERRIER_ASSERT(SupportsScanWithKeys(), "The keys of this index cannot be written back into ProjectedRows.");
+
+    // Build search keys
+    KeyType index_low_key, index_high_key;
+    index_low_key.SetFromProjectedRow(low_key, metadata_);
+    index_high_key.SetFromProjectedRow(high_key, metadata_);
+
+    const auto &key_initializer = metadata_.GetProjectedRowInitializer();
+    const uint32_t key_row_size = KeyRowSize();
+    const auto below_limit = [&] { return limit == 0 || value_list->size() < limit; };
+    // Perform visibility check on result, and write the key of visible values
+    const auto add_result = [&](const KeyType &key, const TupleSlot slot) {
+      if (!IsVisible(txn, slot)) return;
+      value_list->emplace_back(slot);
+      key_rows->resize(key_rows->size() + key_row_size);
+      key.WriteToProjectedRow(key_initializer.InitializeRow(key_rows->data() + key_rows->size() - key_row_size),
+                              metadata_);
+    };
+
+    // Perform lookup in BwTree
+    if (ascending) {
+      auto scan_itr = bwtree_->Begin(index_low_key);
+      while (below_limit() && !scan_itr.IsEnd() && (bwtree_->KeyCmpLessEqual(scan_itr->first, index_high_key))) {
+        add_result(scan_itr->first, scan_itr->second);
+        scan_itr++;
+      }
+    } else {
+      auto scan_itr = bwtree_->Begin(index_high_key);
+      // Back up one element if we didn't match the high key, see comment in ScanDescending.
+      if (scan_itr.IsEnd() || bwtree_->KeyCmpGreater(scan_itr->first, index_high_key)) scan_itr--;
+      while (below_limit() && !scan_itr.IsREnd() && (bwtree_->KeyCmpGreaterEqual(scan_itr->first, index_low_key))) {
+        add_result(scan_itr->first, scan_itr->second);
+        scan_itr--;
+      }
+    }
+  }
+
+  void ScanRanges(const transaction::TransactionContext &txn,
+                  const std::vector<std::pair<const ProjectedRow *, const ProjectedRow *>> &ranges,
+                  std::vector<TupleSlot> *value_list, std::vector<byte> *key_rows) final {
+    TERRIER_ASSERT(value_list->empty() && (key_rows == nullptr || key_rows->empty()),
+                   "Result sets should begin empty.");
+    TERRIER_ASSERT(key_rows == nullptr || SupportsScanWithKeys(),
+                   "The keys of this index cannot be written back into ProjectedRows.");
+
+    // Build search keys, dropping the empty ranges
+    std::vector<std::pair<KeyType, KeyType>> key_ranges;
+    key_ranges.reserve(ranges.size());
+    for (const auto &range : ranges) {
+      KeyType index_low_key, index_high_key;
+      index_low_key.SetFromProjectedRow(*range.first, metadata_);
+      index_high_key.SetFromProjectedRow(*range.second, metadata_);
+      if (bwtree_->KeyCmpGreater(index_low_key, index_high_key)) continue;
+      key_ranges.emplace_back(index_low_key, index_high_key);
+    }
+    if (key_ranges.empty()) return;
+
+    // Probe the tree in key order, so that the results come out sorted and consecutive probes touch nearby leaves
+    std::sort(key_ranges.begin(), key_ranges.end(),
+              [&](const auto &lhs, const auto &rhs) { return bwtree_->KeyCmpLess(lhs.first, rhs.first); });
+
+    const auto &key_initializer = metadata_.GetProjectedRowInitializer();
+    const uint32_t key_row_size = KeyRowSize();
+    const auto scan_range = [&](const KeyType &index_low_key, const KeyType &index_high_key) {
+      auto scan_itr = bwtree_->Begin(index_low_key);
+      while (!scan_itr.IsEnd() && (bwtree_->KeyCmpLessEqual(scan_itr->first, index_high_key))) {
+        // Perform visibility check on result
+        if (IsVisible(txn, scan_itr->second)) {
+          value_list->emplace_back(scan_itr->second);
+          if (key_rows != nullptr) {
+            key_rows->resize(key_rows->size() + key_row_size);
+            scan_itr->first.WriteToProjectedRow(
+                key_initializer.InitializeRow(key_rows->data() + key_rows->size() - key_row_size), metadata_);
+          }
+        }
+        scan_itr++;
+      }
+    };
+
+    // Merge overlapping ranges, so that no value is returned twice
+    auto curr = key_ranges.begin();
+    for (auto next = curr + 1; next != key_ranges.end(); ++next) {
+      if (bwtree_->KeyCmpLessEqual(next->first, curr->second)) {
+        if (bwtree_->KeyCmpGreater(next->second, curr->second)) curr->second = next->second;
+        continue;
+      }
+      scan_range(curr->first, curr->second);
+      curr = next;
+    }
+    scan_range(curr->first, curr->second);
+  }
 };
 
 extern template class BwTreeIndex<CompactIntsKey<8>>;
@@ -91,6 +91,29 @@ class CompactIntsKey {
     }
   }
 
+  /**
+   * Write the CompactIntsKey's data back into a ProjectedRow, the inverse of SetFromProjectedRow
+   * @param to ProjectedRow initialized with the index's ProjectedRowInitializer to write the key attributes to
+   * @param metadata index information, primarily attribute sizes and the precomputed offsets to translate PR layout to
+   * CompactIntsKey
+   */
+  void WriteToProjectedRow(storage::ProjectedRow *const to, const IndexMetadata &metadata) const {
+    const auto &attr_sizes = metadata.GetAttributeSizes();
+    const auto &compact_ints_offsets = metadata.GetCompactIntsOffsets();
+
+    TERRIER_ASSERT(attr_sizes.size() == to->NumColumns(), "attr_sizes and ProjectedRow must be equal in size.");
+
+    for (uint8_t i = 0; i < to->NumColumns(); i++) {
+      CopyAttrToProjection(to, static_cast<uint16_t>(to->ColumnIds()[i]), attr_sizes[i], compact_ints_offsets[i]);
+    }
+  }
+
+  /**
+   * @param metadata index information
+   * @return whether WriteToProjectedRow restores the attributes of keys with this metadata. Integers always are.
+   */
+  static bool CanWriteToProjectedRow(UNUSED_ATTRIBUTE const IndexMetadata &metadata) { return true; }
+
  private:
   byte key_data_[KeySize];
 
@@ -124,6 +147,31 @@ class CompactIntsKey {
     }
   }
 
+  void CopyAttrToProjection(storage::ProjectedRow *const to, const uint16_t projection_list_offset,
+                            const uint8_t attr_size, const uint8_t compact_ints_offset) const {
+    byte *const stored_attr = to->AccessForceNotNull(projection_list_offset);
+    switch (attr_size) {
+      case sizeof(int8_t): {
+        *reinterpret_cast<int8_t *>(stored_attr) = GetInteger<int8_t>(compact_ints_offset);
+        break;
+      }
+      case sizeof(int16_t): {
+        *reinterpret_cast<int16_t *>(stored_attr) = GetInteger<int16_t>(compact_ints_offset);
+        break;
+      }
+      case sizeof(int32_t): {
+        *reinterpret_cast<int32_t *>(stored_attr) = GetInteger<int32_t>(compact_ints_offset);
+        break;
+      }
+      case sizeof(int64_t): {
+        *reinterpret_cast<int64_t *>(stored_attr) = GetInteger<int64_t>(compact_ints_offset);
+        break;
+      }
+      default:
+        throw std::runtime_error("Invalid attribute size.");
+    }
+  }
+
   /*
    * TwoBytesToBigEndian() - Change 2 bytes to big endian
    *
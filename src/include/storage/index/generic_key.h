@@ -81,6 +81,25 @@ class GenericKey {
     }
   }
 
+  /**
+   * Write the GenericKey's data back into a ProjectedRow, the inverse of SetFromProjectedRow
+   * @param to ProjectedRow initialized with the index's ProjectedRowInitializer to write the key attributes to
+   * @param metadata index information, key_schema used to interpret PR data correctly
+   */
+  void WriteToProjectedRow(storage::ProjectedRow *const to, const IndexMetadata &metadata) const {
+    TERRIER_ASSERT(CanWriteToProjectedRow(metadata), "Inlined varlens cannot be written back into a ProjectedRow.");
+    TERRIER_ASSERT(to->Size() == GetProjectedRow()->Size(), "ProjectedRows should have the same layout.");
+    // We recast to as a workaround for -Wclass-memaccess
+    std::memcpy(static_cast<void *>(to), GetProjectedRow(), GetProjectedRow()->Size());
+  }
+
+  /**
+   * @param metadata index information
+   * @return whether WriteToProjectedRow restores the attributes of keys with this metadata. Keys that had to inline
+   * their varlens no longer hold VarlenEntrys, so they cannot be.
+   */
+  static bool CanWriteToProjectedRow(const IndexMetadata &metadata) { return !metadata.MustInlineVarlen(); }
+
   /**
    * @return Aligned pointer to the key's internal ProjectedRow, exposed for hasher and comparators
    */
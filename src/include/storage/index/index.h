@@ -10,6 +10,7 @@
 #include "storage/index/index_defs.h"
 #include "storage/index/index_metadata.h"
 #include "storage/storage_defs.h"
+#include "storage/storage_util.h"
 #include "transaction/transaction_context.h"
 
 namespace terrier::storage::index {
@@ -155,6 +156,53 @@ class Index {
     TERRIER_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
   }
 
+  /**
+   * @return whether ScanWithKeys is implemented for this index, which is what index-only range scans need
+   */
+  virtual bool SupportsScanWithKeys() const { return false; }
+
+  /**
+   * Finds the first limit # of values between the given keys in our index like the other range scans, and also writes
+   * the key that each value is stored under. Index-only scans read the key attributes from these rows instead of
+   * fetching the tuples from the table.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param low_key the lowest key to return
+   * @param high_key the highest key to return
+   * @param ascending whether the values are sorted in ascending or descending order
+   * @param limit upper bound of number of values to return, or 0 for no limit
+   * @param[out] value_list the values associated with the keys
+   * @param[out] key_rows the key of every value in value_list, as rows of KeyRowSize() bytes initialized with
+   * GetProjectedRowInitializer()
+   */
+  virtual void ScanWithKeys(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                            const ProjectedRow &high_key, bool ascending, uint32_t limit,
+                            std::vector<TupleSlot> *value_list, std::vector<byte> *key_rows) {
+    TERRIER_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
+  }
+
+  /**
+   * Finds all the values in any of the given key ranges, sorted in ascending order. The ranges are probed in the order
+   * of their low keys, and overlapping ranges are merged first, so that every value is returned at most once. This is
+   * what IN lists and disjunctions over index columns are scanned with.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param ranges the lowest and highest key of every range, in any order. Ranges with low_key > high_key are empty.
+   * @param[out] value_list the values associated with the keys
+   * @param[out] key_rows if not nullptr, the key of every value in value_list like ScanWithKeys writes them. This
+   * requires SupportsScanWithKeys().
+   */
+  virtual void ScanRanges(const transaction::TransactionContext &txn,
+                          const std::vector<std::pair<const ProjectedRow *, const ProjectedRow *>> &ranges,
+                          std::vector<TupleSlot> *value_list, std::vector<byte> *key_rows) {
+    TERRIER_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
+  }
+
+  /**
+   * @return the size of the rows written by ScanWithKeys, padded so that every row stays aligned
+   */
+  uint32_t KeyRowSize() const {
+    return StorageUtil::PadUpToSize(sizeof(uint64_t), GetProjectedRowInitializer().ProjectedRowSize());
+  }
+
   /**
    * @return mapping from key oid to projected row offset
    */
@@ -140,7 +140,7 @@ class PACKED ProjectedColumns {
    * @return the actual number of tuples this ProjectedColumns holds. These tuples are guaranteed to be laid out in
    * offsets 0 to NumTuples() - 1
    */
-  uint32_t NumTuples() { return num_tuples_; }
+  uint32_t NumTuples() const { return num_tuples_; }
 
   /**
    * Set the number of tuples in the ProjectedColumns to be the given value
@@ -172,6 +172,13 @@ class PACKED ProjectedColumns {
     return StorageUtil::AlignedPtr<storage::TupleSlot>(AttrValueOffsets() + num_cols_);
   }
 
+  /**
+   * @return Head of the array that holds the tuple slots of the tuples currently materialized in the ProjectedColumns
+   */
+  const storage::TupleSlot *TupleSlots() const {
+    return StorageUtil::AlignedPtr<const storage::TupleSlot>(AttrValueOffsets() + num_cols_);
+  }
+
   /**
    * @param projection_list_index index of the desired column in the projection list
    * @return pointer to the column presence bitmap for the given projection list column
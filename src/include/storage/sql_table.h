@@ -144,12 +144,47 @@ class SqlTable {
    * @param start_pos iterator to the starting location for the sequential scan
    * @param out_buffer output buffer. The object should already contain projection list information. This buffer is
    *                   always cleared of old values.
+   * @param filter if given, blocks whose zone maps rule out every tuple are skipped. @see AddZoneMapRange
+   * @param stop_pos if given, the scan stops at this slot (exclusive) instead of at end(). @see BlockBegins
    */
   void Scan(const common::ManagedPointer<transaction::TransactionContext> txn, DataTable::SlotIterator *const start_pos,
-            ProjectedColumns *const out_buffer) const {
-    return table_.data_table_->Scan(txn, start_pos, out_buffer);
+            ProjectedColumns *const out_buffer, const ZoneMapFilter *const filter = nullptr,
+            const DataTable::SlotIterator *const stop_pos = nullptr) const {
+    return table_.data_table_->Scan(txn, start_pos, out_buffer, filter, stop_pos);
   }
 
+  /**
+   * Reads the dictionary codes of a varlen column for the tuples materialized into a buffer by Scan.
+   * @see DataTable::ReadDictionaryCodes
+   * @param columns buffer filled by Scan
+   * @param projection_list_index index of the varlen column in the buffer
+   * @param[out] codes the dictionary code of the i-th tuple in the buffer is written at position i
+   * @return the dictionary of the block the tuples came from, or nullptr if codes are not available
+   */
+  const ArrowVarlenColumn *ReadDictionaryCodes(const ProjectedColumns &columns, const uint16_t projection_list_index,
+                                               uint32_t *const codes) const {
+    return table_.data_table_->ReadDictionaryCodes(columns, projection_list_index, codes);
+  }
+
+  /**
+   * Restrict the values of a column for the purpose of skipping blocks in scans.
+   * @param filter the filter to add the range to
+   * @param col_oid the column to restrict
+   * @param min_key the smallest admissible zone map key. @see ZoneMap
+   * @param max_key the largest admissible zone map key
+   */
+  void AddZoneMapRange(ZoneMapFilter *const filter, const catalog::col_oid_t col_oid, const int64_t min_key,
+                       const int64_t max_key) const {
+    TERRIER_ASSERT(table_.column_map_.count(col_oid) > 0, "Provided col_oid does not exist in the table.");
+    filter->AddRange(table_.column_map_.at(col_oid), min_key, max_key);
+  }
+
+  /**
+   * @param type a SQL type
+   * @return how the zone maps of columns of the given type are built
+   */
+  static ZoneMapType ZoneMapTypeFor(type::TypeId type);
+
   /**
    * @return the first tuple slot contained in the underlying DataTable
    */
@@ -160,6 +195,11 @@ class SqlTable {
    */
   DataTable::SlotIterator end() const { return table_.data_table_->end(); }  // NOLINT for STL name compability
 
+  /**
+   * @return an iterator to the first slot of every block in the underlying DataTable, in scan order
+   */
+  std::vector<DataTable::SlotIterator> BlockBegins() const { return table_.data_table_->BlockBegins(); }
+
   /**
    * Generates an ProjectedColumnsInitializer for the execution layer to use. This performs the translation from col_oid
    * to col_id for the Initializer's constructor so that the execution layer doesn't need to know anything about col_id.
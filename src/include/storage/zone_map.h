@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "common/container/concurrent_bitmap.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::storage {
+
+class TupleAccessStrategy;
+
+/**
+ * How the bytes of a column are interpreted when ordering its values for a zone map. The storage layer
+ * knows nothing about SQL types, so the owner of a table must pick the interpretation for each column.
+ * Columns of type NONE have no zone map.
+ */
+enum class ZoneMapType : uint8_t {
+  NONE = 0,
+  /** Two's complement integers of the column's attribute size */
+  SIGNED_INTEGER,
+  /** Unsigned integers of the column's attribute size */
+  UNSIGNED_INTEGER,
+  /** Dates packed as a 16-bit year, an 8-bit month and an 8-bit day, lowest bytes first */
+  DATE,
+  /** IEEE-754 floating point numbers of the column's attribute size */
+  FLOAT
+};
+
+/**
+ * A zone map summarizes the values of one column in one block: the smallest and largest value, and the
+ * number of non-NULL values. Values are summarized by their key, a 64-bit signed integer whose order
+ * agrees with the order of the values themselves, so that zone maps of every type can be compared with
+ * plain integer comparisons.
+ *
+ * Zone maps are computed when a block is frozen and are only meaningful while the block remains frozen;
+ * updating a tuple in a frozen block turns the block hot and leaves a stale zone map behind.
+ */
+class ZoneMap {
+ public:
+  /**
+   * Compute the zone map of the first @em num_records values of a column.
+   * @param type The interpretation of the column's values.
+   * @param values The start of the column.
+   * @param attr_size The size of each value in bytes.
+   * @param null_bitmap The null bitmap of the column. A set bit marks a non-NULL value.
+   * @param num_records The number of values to summarize.
+   */
+  void Compute(ZoneMapType type, const byte *values, uint16_t attr_size, const common::RawConcurrentBitmap *null_bitmap,
+               uint32_t num_records);
+
+  /**
+   * @return True if this zone map has been computed.
+   */
+  bool IsValid() const { return valid_; }
+
+  /**
+   * @return The key of the smallest non-NULL value.
+   */
+  int64_t GetMinKey() const { return min_key_; }
+
+  /**
+   * @return The key of the largest non-NULL value.
+   */
+  int64_t GetMaxKey() const { return max_key_; }
+
+  /**
+   * @return The number of non-NULL values.
+   */
+  uint32_t NumValues() const { return num_values_; }
+
+  /**
+   * @return False if no value with a key in [min_key, max_key] can be present; true otherwise. Zone maps
+   *         that have not been computed may contain anything.
+   */
+  bool MayContain(const int64_t min_key, const int64_t max_key) const {
+    return !valid_ || (num_values_ > 0 && min_key_ <= max_key && max_key_ >= min_key);
+  }
+
+  /**
+   * @return The key of the value of the given type and size stored at @em value.
+   */
+  static int64_t Key(ZoneMapType type, const byte *value, uint16_t attr_size);
+
+  /**
+   * @return The key of a signed integer.
+   */
+  static int64_t SignedIntegerKey(const int64_t value) { return value; }
+
+  /**
+   * @return The key of an unsigned integer.
+   */
+  static int64_t UnsignedIntegerKey(const uint64_t value) {
+    return static_cast<int64_t>(value ^ (uint64_t{1} << 63u));
+  }
+
+  /**
+   * @return The key of a packed date.
+   */
+  static int64_t DateKey(const uint32_t value) {
+    const auto year = static_cast<int16_t>(value & 0xFFFFu);
+    return static_cast<int64_t>(year) * 65536 + static_cast<int64_t>(value >> 16u & 0xFFu) * 256 + (value >> 24u);
+  }
+
+  /**
+   * @return The key of a floating point number. Positive and negative zero share a key.
+   */
+  static int64_t FloatKey(double value) {
+    if (value == 0.0) value = 0.0;
+    int64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits >= 0 ? bits : bits ^ std::numeric_limits<int64_t>::max();
+  }
+
+ private:
+  int64_t min_key_;
+  int64_t max_key_;
+  uint32_t num_values_;
+  bool valid_;
+};
+
+/**
+ * A conjunction of key ranges on the columns of a table, used to skip whole blocks during sequential
+ * scans. A frozen block is skipped if the zone map of some column proves that none of its values fall in
+ * that column's range; hot blocks are always scanned.
+ */
+class ZoneMapFilter {
+ public:
+  /**
+   * Require the values of column @em col_id to have keys in [min_key, max_key].
+   */
+  void AddRange(const col_id_t col_id, const int64_t min_key, const int64_t max_key) {
+    ranges_.push_back({col_id, min_key, max_key});
+  }
+
+  /**
+   * @return True if the filter has no ranges.
+   */
+  bool Empty() const { return ranges_.empty(); }
+
+  /**
+   * @return True if no tuple in @em block can satisfy the filter.
+   */
+  bool CanSkip(const TupleAccessStrategy &accessor, RawBlock *block) const;
+
+ private:
+  struct Range {
+    col_id_t col_id_;
+    int64_t min_key_;
+    int64_t max_key_;
+  };
+  std::vector<Range> ranges_;
+};
+
+}  // namespace terrier::storage
@@ -1,12 +1,19 @@
 #pragma once
+#include <condition_variable>  // NOLINT
+#include <limits>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "common/worker_pool.h"
 #include "network/network_defs.h"
 #include "network/postgres/postgres_protocol_utils.h"
+#include "optimizer/cost_model/stats_cost_model.h"
+#include "parser/analyze_statement.h"
 #include "parser/create_statement.h"
 #include "parser/drop_statement.h"
 #include "parser/transaction_statement.h"
@@ -43,18 +50,36 @@ class TrafficCop {
    * @param replication_log_provider if given, the tcop will forward replication logs to this provider
    * @param stats_storage for optimizer calls
    * @param optimizer_timeout for optimizer calls
+   * @param optimizer_workers number of threads searching for the plan of each optimizer call, which are shared by
+   * concurrent calls
+   * @param query_memory_limit bytes each query may use before it spills, 0 for no limit
+   * @param cost_model_params unit costs of the optimizer's cost model, whose memory budget is the query_memory_limit
    */
   TrafficCop(common::ManagedPointer<transaction::TransactionManager> txn_manager,
              common::ManagedPointer<catalog::Catalog> catalog,
              common::ManagedPointer<storage::ReplicationLogProvider> replication_log_provider,
-             common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout)
+             common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
+             uint32_t optimizer_workers = 1, uint64_t query_memory_limit = 0,
+             optimizer::CostModelParameters cost_model_params = {})
       : txn_manager_(txn_manager),
         catalog_(catalog),
         replication_log_provider_(replication_log_provider),
         stats_storage_(stats_storage),
-        optimizer_timeout_(optimizer_timeout) {}
+        optimizer_timeout_(optimizer_timeout),
+        query_memory_limit_(query_memory_limit),
+        cost_model_params_(cost_model_params) {
+    SetQueryMemoryLimit(query_memory_limit);
+    // The calling thread of each optimizer call is one of its workers
+    if (optimizer_workers > 1) {
+      optimizer_threads_ = std::make_unique<common::WorkerPool>(optimizer_workers - 1, common::TaskQueue{});
+    }
+    if (stats_storage_ != DISABLED) stats_refresh_thread_ = std::thread([this] { StatsRefreshLoop(); });
+  }
 
-  virtual ~TrafficCop() = default;
+  /**
+   * Stops the thread that refreshes stale statistics
+   */
+  virtual ~TrafficCop();
 
   /**
    * Hands a buffer of logs to replication
@@ -107,6 +132,17 @@ class TrafficCop {
    */
   void SetOptimizerTimeout(const uint64_t optimizer_timeout) { optimizer_timeout_ = optimizer_timeout; }
 
+  /**
+   * Adjust the number of bytes each query may use before its sorts, hash joins and aggregations spill
+   * @param query_memory_limit the limit in bytes, 0 for no limit @see execution::exec::ExecutionContext::SetMemoryLimit
+   */
+  void SetQueryMemoryLimit(const uint64_t query_memory_limit) {
+    query_memory_limit_ = query_memory_limit;
+    // The cost model prices the spills of the hash tables and sorts that overflow the limit
+    cost_model_params_.memory_budget_ = query_memory_limit == 0 ? std::numeric_limits<double>::max()
+                                                                : static_cast<double>(query_memory_limit);
+  }
+
  private:
   // Internal method to handle the logic of beginning a txn. Is not responsible for outputting results, only meant to be
   // called by ExecuteTransactionStatement
@@ -140,6 +176,19 @@ class TrafficCop {
                             common::ManagedPointer<planner::AbstractPlanNode> physical_plan,
                             terrier::network::QueryType query_type, bool single_statement_txn) const;
 
+  // Contains the logic to reason about ANALYZE execution. Responsible for outputting results.
+  void ExecuteAnalyzeStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                               common::ManagedPointer<network::PostgresPacketWriter> out,
+                               common::ManagedPointer<parser::ParseResult> parse_result) const;
+
+  // Wakes the statistics refresh thread after a commit, which may have made the statistics of some tables stale. The
+  // committing connection does not wait for the refresh.
+  void RefreshStaleStatistics() const;
+
+  // Body of stats_refresh_thread_. Analyzes the tables whose statistics went stale through committed DML, each in its
+  // own transaction, whenever a commit wakes it.
+  void StatsRefreshLoop();
+
   // Contains the logic to reason about DML execution. Responsible for outputting results.
   void CodegenAndRunPhysicalPlan(common::ManagedPointer<network::ConnectionContext> connection_ctx,
                                  common::ManagedPointer<network::PostgresPacketWriter> out,
@@ -152,6 +201,18 @@ class TrafficCop {
   common::ManagedPointer<storage::ReplicationLogProvider> replication_log_provider_;
   common::ManagedPointer<optimizer::StatsStorage> stats_storage_;
   uint64_t optimizer_timeout_;
+  // Threads that help the calling threads of optimizer calls, nullptr if the calls run on their calling threads only
+  std::unique_ptr<common::WorkerPool> optimizer_threads_;
+  uint64_t query_memory_limit_;
+  optimizer::CostModelParameters cost_model_params_;
+
+  // Refreshes stale statistics in the background, if there is a StatsStorage
+  std::thread stats_refresh_thread_;
+  // Protects the flags below, which wake stats_refresh_thread_ through stats_refresh_cv_
+  mutable std::mutex stats_refresh_latch_;
+  mutable std::condition_variable stats_refresh_cv_;
+  mutable bool stats_refresh_pending_ = false;
+  bool stop_stats_refresh_ = false;
 };
 
 }  // namespace terrier::trafficcop
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "common/managed_pointer.h"
+#include "common/worker_pool.h"
 #include "network/network_defs.h"
 
 namespace terrier::catalog {
@@ -21,7 +22,8 @@ class AbstractPlanNode;
 
 namespace terrier::optimizer {
 class StatsStorage;
-}
+struct CostModelParameters;
+}  // namespace terrier::optimizer
 
 namespace terrier::transaction {
 class TransactionContext;
@@ -42,12 +44,16 @@ class TrafficCopUtil {
    * @param query bound ParseResult
    * @param stats_storage used by optimizer
    * @param optimizer_timeout used by optimizer
+   * @param cost_model_params unit costs of the optimizer's cost model
+   * @param optimizer_threads used by optimizer, nullptr to optimize on the calling thread only
    * @return physical plan that can be executed
    */
   static std::unique_ptr<planner::AbstractPlanNode> Optimize(
       common::ManagedPointer<transaction::TransactionContext> txn,
       common::ManagedPointer<catalog::CatalogAccessor> accessor, common::ManagedPointer<parser::ParseResult> query,
-      common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout);
+      common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
+      const optimizer::CostModelParameters &cost_model_params,
+      common::ManagedPointer<common::WorkerPool> optimizer_threads = nullptr);
 
   /**
    * Converts parser statement types (which rely on multiple enums) to a single QueryType enum from the network layer
@@ -108,15 +108,28 @@ void ChildPropertyDeriver::Visit(const Limit *op) {
 }
 
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const OrderBy *op) {}
-void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const InnerNLJoin *op) { DeriveForJoin(); }
+void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const InnerNLJoin *op) { DeriveForJoin(true); }
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const LeftNLJoin *op) {}
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const RightNLJoin *op) {}
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const OuterNLJoin *op) {}
-void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const InnerHashJoin *op) { DeriveForJoin(); }
-
-void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const LeftHashJoin *op) {}
-void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) {}
-void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) {}
+void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const InnerHashJoin *op) { DeriveForJoin(true); }
+
+// Unmatched build tuples are emitted after the probe finishes, which breaks the probe order
+void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const LeftHashJoin *op) { DeriveForJoin(false); }
+void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) { DeriveForJoin(true); }
+void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) { DeriveForJoin(false); }
+void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const SemiHashJoin *op) { DeriveForJoin(false); }
+
+void ChildPropertyDeriver::Visit(const InnerMergeJoin *op) {
+  // The join sorts the left child itself while materializing it, so only the right child must be sorted on its join
+  // keys. The right child streams through the join, so its order is kept.
+  const auto &right_keys = op->GetRightKeys();
+  auto right_sort =
+      new PropertySort(right_keys, std::vector<OrderByOrderingType>(right_keys.size(), OrderByOrderingType::ASC));
+  auto left_prop = new PropertySet();
+  auto right_prop = new PropertySet(std::vector<Property *>{right_sort});
+  output_.emplace_back(right_prop->Copy(), std::vector<PropertySet *>{left_prop, right_prop});
+}
 
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const Insert *op) {
   std::vector<PropertySet *> child_input_properties;
@@ -152,8 +165,11 @@ void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const ExportExternalFile *op)
   output_.emplace_back(requirements_->Copy(), std::move(child_input_properties));
 }
 
-void ChildPropertyDeriver::DeriveForJoin() {
+void ChildPropertyDeriver::DeriveForJoin(bool preserves_probe_order) {
   output_.emplace_back(new PropertySet(), std::vector<PropertySet *>{new PropertySet(), new PropertySet()});
+  if (!preserves_probe_order) {
+    return;
+  }
 
   // If there is sort property and all the sort columns are from the probe
   // table (currently right table), we can push down the sort property
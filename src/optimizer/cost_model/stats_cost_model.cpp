@@ -0,0 +1,236 @@
+#include "optimizer/cost_model/stats_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/logical_operators.h"
+#include "optimizer/memo.h"
+#include "optimizer/physical_operators.h"
+#include "optimizer/statistics/stats_storage.h"
+#include "optimizer/statistics/table_stats.h"
+#include "parser/expression/column_value_expression.h"
+
+namespace terrier::optimizer {
+
+namespace {
+
+// Selectivities of index key predicates on tables without statistics, the same guesses PostgreSQL makes
+constexpr double K_DEFAULT_EQ_SELECTIVITY = 0.005;
+constexpr double K_DEFAULT_INEQ_SELECTIVITY = 1.0 / 3.0;
+
+// The fraction of its input rows a GROUP BY on columns without statistics is assumed to produce
+constexpr double K_DEFAULT_GROUP_FRACTION = 0.1;
+
+// Comparisons needed to sort num_rows tuples
+double NumSortComparisons(const double num_rows) { return num_rows * std::log2(std::max(num_rows, 2.0)); }
+
+}  // namespace
+
+double StatsCostModel::CalculateCost(transaction::TransactionContext *txn, Memo *memo, GroupExpression *gexpr) {
+  gexpr_ = gexpr;
+  memo_ = memo;
+  txn_ = txn;
+  output_cost_ = 0;
+  gexpr_->Op().Accept(common::ManagedPointer<OperatorVisitor>(this));
+  return output_cost_;
+}
+
+double StatsCostModel::GroupRows(const group_id_t group_id) const {
+  const int num_rows = memo_->GetGroupByID(group_id)->GetNumRows();
+  return num_rows < 0 ? K_DEFAULT_NUM_ROWS : static_cast<double>(num_rows);
+}
+
+double StatsCostModel::OutputRows() const { return GroupRows(gexpr_->GetGroupID()); }
+
+double StatsCostModel::ChildRows(const int child_idx) const { return GroupRows(gexpr_->GetChildGroupId(child_idx)); }
+
+double StatsCostModel::SpillCost(const double state_rows, const double spilled_rows) const {
+  if (state_rows * params_.tuple_width_ <= params_.memory_budget_) return 0.0;
+  return spilled_rows * params_.spill_tuple_cost_;
+}
+
+double StatsCostModel::SortCost(const double num_rows) const {
+  return NumSortComparisons(num_rows) * params_.sort_compare_cost_ + SpillCost(num_rows, num_rows);
+}
+
+void StatsCostModel::Visit(const SeqScan *op) {
+  // Every tuple of the table is read and filtered, whatever the predicates let through
+  const auto table_stats = stats_storage_->GetTableStats(op->GetDatabaseOID(), op->GetTableOID());
+  const double table_rows =
+      table_stats == nullptr ? K_DEFAULT_NUM_ROWS : static_cast<double>(table_stats->GetNumRows());
+  const auto num_predicates = static_cast<double>(op->GetPredicates().size());
+  output_cost_ = table_rows * (params_.seq_tuple_cost_ + num_predicates * params_.cpu_operator_cost_) +
+                 OutputRows() * params_.output_tuple_cost_;
+}
+
+void StatsCostModel::Visit(const IndexScan *op) {
+  // The table of the index is the one the group's LogicalGet reads
+  const auto &logical_exprs = memo_->GetGroupByID(gexpr_->GetGroupID())->GetLogicalExpressions();
+  std::shared_ptr<const TableStats> table_stats = nullptr;
+  if (!logical_exprs.empty()) {
+    const auto get = logical_exprs[0]->Op().As<LogicalGet>();
+    if (get != nullptr) table_stats = stats_storage_->GetTableStats(get->GetDatabaseOid(), get->GetTableOid());
+  }
+  const bool has_stats = table_stats != nullptr && table_stats->GetColumnCount() > 0;
+  const double table_rows =
+      table_stats == nullptr ? K_DEFAULT_NUM_ROWS : static_cast<double>(table_stats->GetNumRows());
+
+  // Without key predicates the whole index is walked. Otherwise the key predicates select the group's rows, or a
+  // default fraction of the table for each predicate when the table was not analyzed. The values of an IN list are
+  // each probed separately.
+  const auto &key_types = op->GetExprTypeList();
+  double key_rows = table_rows;
+  double lookup_cost = 0.0;
+  if (!key_types.empty()) {
+    double num_probes = 1.0;
+    for (size_t idx = 0; idx < key_types.size(); idx++) num_probes *= op->GetNumValues(idx);
+    lookup_cost = num_probes * std::log2(std::max(table_rows, 2.0)) * params_.index_probe_cost_;
+    if (has_stats) {
+      key_rows = std::min(OutputRows(), table_rows);
+    } else {
+      for (size_t idx = 0; idx < key_types.size(); idx++) {
+        switch (key_types[idx]) {
+          case parser::ExpressionType::COMPARE_EQUAL:
+            key_rows *= K_DEFAULT_EQ_SELECTIVITY;
+            break;
+          case parser::ExpressionType::COMPARE_IN:
+            key_rows *= std::min(op->GetNumValues(idx) * K_DEFAULT_EQ_SELECTIVITY, 1.0);
+            break;
+          default:
+            key_rows *= K_DEFAULT_INEQ_SELECTIVITY;
+        }
+      }
+      key_rows = std::max(key_rows, 1.0);
+    }
+  }
+
+  // Every matching key fetches its tuple from the table, which is then filtered by all the predicates
+  const auto num_predicates = static_cast<double>(op->GetPredicates().size());
+  output_cost_ = lookup_cost + key_rows * (params_.index_tuple_cost_ + num_predicates * params_.cpu_operator_cost_) +
+                 OutputRows() * params_.output_tuple_cost_;
+}
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const QueryDerivedScan *op) {
+  output_cost_ = OutputRows() * params_.output_tuple_cost_;
+}
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const OrderBy *op) {
+  // An enforced sort lives in the group of its input
+  const double num_rows = OutputRows();
+  output_cost_ = SortCost(num_rows) + num_rows * params_.output_tuple_cost_;
+}
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const Limit *op) {
+  output_cost_ = OutputRows() * params_.output_tuple_cost_;
+}
+
+double StatsCostModel::NLJoinCost(const double outer_rows, const double inner_rows, const double output_rows,
+                                  const size_t num_predicates) const {
+  // The inner child is rescanned for every outer tuple, and the predicates are checked on every pair
+  const double num_pairs = outer_rows * inner_rows;
+  return num_pairs * (params_.seq_tuple_cost_ +
+                      static_cast<double>(std::max<size_t>(num_predicates, 1)) * params_.cpu_operator_cost_) +
+         output_rows * params_.output_tuple_cost_;
+}
+
+double StatsCostModel::HashJoinCost(const double build_rows, const double probe_rows, const double output_rows) const {
+  // The left child builds the hash table and the right child probes it. A build side that does not fit in memory is
+  // partitioned, and both sides then go through disk once.
+  return build_rows * params_.hash_build_cost_ + probe_rows * params_.hash_probe_cost_ +
+         output_rows * params_.output_tuple_cost_ + SpillCost(build_rows, build_rows + probe_rows);
+}
+
+void StatsCostModel::CostNLJoin(const size_t num_predicates) {
+  output_cost_ = NLJoinCost(ChildRows(0), ChildRows(1), OutputRows(), num_predicates);
+}
+
+void StatsCostModel::CostHashJoin() { output_cost_ = HashJoinCost(ChildRows(0), ChildRows(1), OutputRows()); }
+
+double StatsCostModel::EstimateJoinCost(const double left_rows, const double right_rows, const double output_rows,
+                                        const size_t num_predicates, const bool has_equi_keys) const {
+  const double nl_cost = NLJoinCost(left_rows, right_rows, output_rows, num_predicates);
+  if (!has_equi_keys) return nl_cost;
+  return std::min(nl_cost, HashJoinCost(left_rows, right_rows, output_rows));
+}
+
+void StatsCostModel::Visit(const InnerNLJoin *op) { CostNLJoin(op->GetJoinPredicates().size()); }
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const LeftNLJoin *op) { CostNLJoin(1); }
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const RightNLJoin *op) { CostNLJoin(1); }
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const OuterNLJoin *op) { CostNLJoin(1); }
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const InnerHashJoin *op) { CostHashJoin(); }
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const LeftHashJoin *op) { CostHashJoin(); }
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) { CostHashJoin(); }
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) { CostHashJoin(); }
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const SemiHashJoin *op) { CostHashJoin(); }
+
+void StatsCostModel::Visit(const InnerMergeJoin *op) {
+  // The left child is copied into the join's sorter and sorted there, which is its only sort. The right child streams
+  // in the order of its keys, which the OrderBy enforcing it prices unless the child delivers it for free. Both are
+  // merged with a key comparison per tuple.
+  const double left_rows = ChildRows(0);
+  const double right_rows = ChildRows(1);
+  const auto num_keys = static_cast<double>(std::max<size_t>(op->GetLeftKeys().size(), 1));
+  output_cost_ = left_rows * params_.seq_tuple_cost_ + SortCost(left_rows) +
+                 (left_rows + right_rows) * num_keys * params_.cpu_operator_cost_ +
+                 OutputRows() * params_.output_tuple_cost_;
+}
+
+double StatsCostModel::EstimateNumGroups(
+    const std::vector<common::ManagedPointer<parser::AbstractExpression>> &columns) const {
+  // Assume the columns are independent, so that the groups are the product of their distinct values
+  const double child_rows = ChildRows(0);
+  const auto child_group = memo_->GetGroupByID(gexpr_->GetChildGroupId(0));
+  double num_groups = 1.0;
+  for (const auto &column : columns) {
+    double distinct = child_rows * K_DEFAULT_GROUP_FRACTION;
+    if (column->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+      const auto col_name = column.CastManagedPointerTo<parser::ColumnValueExpression>()->GetFullName();
+      // Default statistics of columns that were never analyzed have no cardinality
+      if (child_group->HasColumnStats(col_name) && child_group->GetStats(col_name)->GetCardinality() > 0) {
+        distinct = child_group->GetStats(col_name)->GetCardinality();
+      }
+    }
+    num_groups *= std::max(distinct, 1.0);
+  }
+  return std::min(num_groups, std::max(child_rows, 1.0));
+}
+
+void StatsCostModel::Visit(const HashGroupBy *op) {
+  // Every input tuple probes the hash table, and each group is inserted once. A table of more groups than the memory
+  // holds spills the input it could not aggregate in memory, except when a single TINYINT or SMALLINT key addresses
+  // the groups directly, since those tables never spill.
+  const double child_rows = ChildRows(0);
+  const auto &columns = op->GetColumns();
+  const double num_groups = EstimateNumGroups(columns);
+  const bool is_dense = columns.size() == 1 && (columns[0]->GetReturnValueType() == type::TypeId::TINYINT ||
+                                                columns[0]->GetReturnValueType() == type::TypeId::SMALLINT);
+  output_cost_ = child_rows * params_.hash_probe_cost_ + num_groups * params_.hash_build_cost_ +
+                 num_groups * params_.output_tuple_cost_ + (is_dense ? 0.0 : SpillCost(num_groups, child_rows));
+}
+
+void StatsCostModel::Visit(const SortGroupBy *op) {
+  // The input arrives sorted on the group keys, so every tuple is compared with the current group only. The sort itself
+  // is priced by the OrderBy that enforces it, if the child does not deliver the order for free.
+  const double child_rows = ChildRows(0);
+  const auto num_keys = static_cast<double>(std::max<size_t>(op->GetColumns().size(), 1));
+  output_cost_ = child_rows * num_keys * params_.cpu_operator_cost_ +
+                 EstimateNumGroups(op->GetColumns()) * params_.output_tuple_cost_;
+}
+
+void StatsCostModel::Visit(UNUSED_ATTRIBUTE const Aggregate *op) {
+  output_cost_ = ChildRows(0) * params_.cpu_operator_cost_ + params_.output_tuple_cost_;
+}
+
+}  // namespace terrier::optimizer
@@ -28,6 +28,7 @@ void Group::EraseLogicalExpression() {
 void Group::AddExpression(GroupExpression *expr, bool enforced) {
   // Do duplicate detection
   expr->SetGroupID(id_);
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
   if (enforced)
     enforced_exprs_.push_back(expr);
   else if (expr->Op().IsPhysical())
@@ -36,20 +37,22 @@ void Group::AddExpression(GroupExpression *expr, bool enforced) {
     logical_expressions_.push_back(expr);
 }
 
-bool Group::SetExpressionCost(GroupExpression *expr, double cost, PropertySet *properties) {
+bool Group::SetExpressionCost(GroupExpression *expr, double cost, PropertySet *properties,
+                              const PlanKey &plan_key) {
   OPTIMIZER_LOG_TRACE("Adding expression cost on group {0} with op {1}", expr->GetGroupID(),
                       expr->Op().GetName().c_str());
 
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
   auto it = lowest_cost_expressions_.find(properties);
   if (it == lowest_cost_expressions_.end()) {
     // not exist so insert
-    lowest_cost_expressions_[properties] = std::make_tuple(cost, expr);
+    lowest_cost_expressions_[properties] = std::make_tuple(cost, expr, plan_key);
     return true;
   }
 
-  if (std::get<0>(it->second) > cost) {
-    // this is lower cost
-    lowest_cost_expressions_[properties] = std::make_tuple(cost, expr);
+  if (std::get<0>(it->second) > cost || (std::get<0>(it->second) == cost && plan_key < std::get<2>(it->second))) {
+    // this is lower cost, or the same cost and a lower key
+    lowest_cost_expressions_[properties] = std::make_tuple(cost, expr, plan_key);
     delete properties;
     return true;
   }
@@ -59,6 +62,7 @@ bool Group::SetExpressionCost(GroupExpression *expr, double cost, PropertySet *p
 }
 
 GroupExpression *Group::GetBestExpression(PropertySet *properties) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
   auto it = lowest_cost_expressions_.find(properties);
   if (it != lowest_cost_expressions_.end()) {
     return std::get<1>(it->second);
@@ -67,7 +71,18 @@ GroupExpression *Group::GetBestExpression(PropertySet *properties) {
   return nullptr;
 }
 
+PlanKey Group::GetBestPlanKey(PropertySet *properties) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  auto it = lowest_cost_expressions_.find(properties);
+  if (it != lowest_cost_expressions_.end()) {
+    return std::get<2>(it->second);
+  }
+
+  return {};
+}
+
 bool Group::HasExpressions(PropertySet *properties) const {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
   const auto &it = lowest_cost_expressions_.find(properties);
   return (it != lowest_cost_expressions_.end());
 }
@@ -0,0 +1,230 @@
+#include "optimizer/join_enumerator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "optimizer/cost_model/abstract_cost_model.h"
+
+namespace terrier::optimizer {
+
+namespace {
+
+using RelationSet = JoinEnumerator::RelationSet;
+
+bool IsSubset(const RelationSet subset, const RelationSet set) { return (subset & ~set) == 0; }
+
+RelationSet LowestRelation(const RelationSet relations) { return relations & (~relations + 1); }
+
+// The relations numbered up to the given one, which it includes
+RelationSet RelationsUpTo(const RelationSet relation) { return relation | (relation - 1); }
+
+// The next nonempty subset of set after subset in ascending order, or 0 after the last one. Smaller subsets come
+// first, as DPhyp needs.
+RelationSet NextSubset(const RelationSet subset, const RelationSet set) { return (subset - set) & set; }
+
+}  // namespace
+
+size_t JoinEnumerator::AddRelation(const double num_rows) {
+  TERRIER_ASSERT(relation_rows_.size() < K_MAX_RELATIONS, "Too many relations");
+  relation_rows_.push_back(std::max(num_rows, 1.0));
+  return relation_rows_.size() - 1;
+}
+
+void JoinEnumerator::AddEdge(const RelationSet left, const RelationSet right, const double selectivity,
+                             const bool is_equi) {
+  TERRIER_ASSERT(left != 0 && right != 0 && (left & right) == 0, "Sides of an edge must be disjoint and nonempty");
+  TERRIER_ASSERT(IsSubset(left | right, GetAllRelations()), "Edge references unknown relations");
+  edges_.push_back({left, right, selectivity, is_equi});
+}
+
+bool JoinEnumerator::IsConnected() const {
+  if (relation_rows_.empty()) return true;
+
+  // Grow the relations reachable from the first one until no predicate reaches further
+  RelationSet reached = 1;
+  bool grew = true;
+  while (grew) {
+    grew = false;
+    for (const auto &edge : edges_) {
+      const RelationSet both = edge.left_ | edge.right_;
+      if ((IsSubset(edge.left_, reached) || IsSubset(edge.right_, reached)) && !IsSubset(both, reached)) {
+        reached |= both;
+        grew = true;
+      }
+    }
+  }
+  return reached == GetAllRelations();
+}
+
+RelationSet JoinEnumerator::Neighborhood(const RelationSet relations, const RelationSet excluded) const {
+  const RelationSet forbidden = relations | excluded;
+  RelationSet neighbors = 0;
+  for (const auto &edge : edges_) {
+    if (IsSubset(edge.left_, relations) && (edge.right_ & forbidden) == 0) {
+      neighbors |= LowestRelation(edge.right_);
+    } else if (IsSubset(edge.right_, relations) && (edge.left_ & forbidden) == 0) {
+      neighbors |= LowestRelation(edge.left_);
+    }
+  }
+  return neighbors;
+}
+
+bool JoinEnumerator::IsConnected(const RelationSet left, const RelationSet right) const {
+  return std::any_of(edges_.begin(), edges_.end(), [&](const Edge &edge) {
+    return (IsSubset(edge.left_, left) && IsSubset(edge.right_, right)) ||
+           (IsSubset(edge.left_, right) && IsSubset(edge.right_, left));
+  });
+}
+
+double JoinEnumerator::EstimateRows(const RelationSet relations) const {
+  // Every relation contributes its rows and every predicate among the relations its selectivity, whatever the order
+  double rows = 1.0;
+  for (size_t relation = 0; relation < relation_rows_.size(); relation++) {
+    if ((relations & (RelationSet{1} << relation)) != 0) rows *= relation_rows_[relation];
+  }
+  for (const auto &edge : edges_) {
+    if (IsSubset(edge.left_ | edge.right_, relations)) rows *= edge.selectivity_;
+  }
+  return std::max(rows, 1.0);
+}
+
+void JoinEnumerator::Join(const RelationSet left, const RelationSet right) {
+  const Plan left_plan = plans_.at(left);
+  const Plan right_plan = plans_.at(right);
+  const RelationSet relations = left | right;
+
+  // The predicates the join evaluates are the ones between its inputs
+  size_t num_predicates = 0;
+  bool has_equi_keys = false;
+  for (const auto &edge : edges_) {
+    const RelationSet both = edge.left_ | edge.right_;
+    if (IsSubset(both, relations) && !IsSubset(both, left) && !IsSubset(both, right)) {
+      num_predicates++;
+      has_equi_keys = has_equi_keys || edge.is_equi_;
+    }
+  }
+
+  auto it = plans_.find(relations);
+  const double rows = it == plans_.end() ? EstimateRows(relations) : it->second.rows_;
+  const double inputs_cost = left_plan.cost_ + right_plan.cost_;
+  const double cost = inputs_cost + cost_model_->EstimateJoinCost(left_plan.rows_, right_plan.rows_, rows,
+                                                                  num_predicates, has_equi_keys);
+  const double swapped_cost = inputs_cost + cost_model_->EstimateJoinCost(right_plan.rows_, left_plan.rows_, rows,
+                                                                          num_predicates, has_equi_keys);
+
+  Plan plan{left, right, rows, cost};
+  if (swapped_cost < cost) plan = {right, left, rows, swapped_cost};
+  if (it == plans_.end()) {
+    plans_.emplace(relations, plan);
+  } else if (plan.cost_ < it->second.cost_) {
+    it->second = plan;
+  }
+}
+
+const JoinEnumerator::Plan &JoinEnumerator::Enumerate() {
+  TERRIER_ASSERT(!relation_rows_.empty(), "Nothing to join");
+  TERRIER_ASSERT(IsConnected(), "The join graph must be connected");
+  plans_.clear();
+  num_pairs_ = 0;
+  used_greedy_ = false;
+  for (size_t relation = 0; relation < relation_rows_.size(); relation++) {
+    plans_[RelationSet{1} << relation] = {0, 0, relation_rows_[relation], 0};
+  }
+
+  // Each connected subgraph is grown from its lowest relation, so that every pair is enumerated once
+  for (size_t relation = relation_rows_.size(); relation-- > 0 && !used_greedy_;) {
+    const RelationSet start = RelationSet{1} << relation;
+    EmitCsg(start);
+    EnumerateCsgRec(start, RelationsUpTo(start));
+  }
+
+  if (used_greedy_) EnumerateGreedy();
+  return plans_.at(GetAllRelations());
+}
+
+void JoinEnumerator::EnumerateCsgRec(const RelationSet csg, const RelationSet excluded) {
+  const RelationSet neighbors = Neighborhood(csg, excluded);
+  if (neighbors == 0) return;
+
+  // Subsets of the neighbors only yield a connected subgraph if a predicate connects them, i.e. if it has a plan
+  for (RelationSet subset = LowestRelation(neighbors); subset != 0 && !used_greedy_;
+       subset = NextSubset(subset, neighbors)) {
+    if (plans_.count(csg | subset) != 0) EmitCsg(csg | subset);
+  }
+  for (RelationSet subset = LowestRelation(neighbors); subset != 0 && !used_greedy_;
+       subset = NextSubset(subset, neighbors)) {
+    EnumerateCsgRec(csg | subset, excluded | neighbors);
+  }
+}
+
+void JoinEnumerator::EmitCsg(const RelationSet csg) {
+  // Complements only hold relations above the lowest one of the subgraph, so that each pair is found once
+  const RelationSet excluded = csg | RelationsUpTo(LowestRelation(csg));
+  const RelationSet neighbors = Neighborhood(csg, excluded);
+
+  for (size_t relation = relation_rows_.size(); relation-- > 0 && !used_greedy_;) {
+    const RelationSet cmp = RelationSet{1} << relation;
+    if ((neighbors & cmp) == 0) continue;
+    if (IsConnected(csg, cmp)) EmitCsgCmp(csg, cmp);
+    EnumerateCmpRec(csg, cmp, excluded | (neighbors & RelationsUpTo(cmp)));
+  }
+}
+
+void JoinEnumerator::EnumerateCmpRec(const RelationSet csg, const RelationSet cmp, const RelationSet excluded) {
+  const RelationSet neighbors = Neighborhood(cmp, excluded);
+  if (neighbors == 0) return;
+
+  for (RelationSet subset = LowestRelation(neighbors); subset != 0 && !used_greedy_;
+       subset = NextSubset(subset, neighbors)) {
+    if (plans_.count(cmp | subset) != 0 && IsConnected(csg, cmp | subset)) EmitCsgCmp(csg, cmp | subset);
+  }
+  for (RelationSet subset = LowestRelation(neighbors); subset != 0 && !used_greedy_;
+       subset = NextSubset(subset, neighbors)) {
+    EnumerateCmpRec(csg, cmp | subset, excluded | neighbors);
+  }
+}
+
+void JoinEnumerator::EmitCsgCmp(const RelationSet csg, const RelationSet cmp) {
+  if (++num_pairs_ > K_MAX_CSG_CMP_PAIRS) {
+    used_greedy_ = true;
+    return;
+  }
+  Join(csg, cmp);
+}
+
+void JoinEnumerator::EnumerateGreedy() {
+  // Start over from the single relations, and keep joining the two connected subplans with the smallest result
+  plans_.clear();
+  std::vector<RelationSet> subplans;
+  for (size_t relation = 0; relation < relation_rows_.size(); relation++) {
+    const RelationSet single = RelationSet{1} << relation;
+    plans_[single] = {0, 0, relation_rows_[relation], 0};
+    subplans.push_back(single);
+  }
+
+  while (subplans.size() > 1) {
+    size_t best_left = 0;
+    size_t best_right = 0;
+    double best_rows = std::numeric_limits<double>::max();
+    for (size_t left = 0; left < subplans.size(); left++) {
+      for (size_t right = left + 1; right < subplans.size(); right++) {
+        if (!IsConnected(subplans[left], subplans[right])) continue;
+        const double rows = EstimateRows(subplans[left] | subplans[right]);
+        if (rows < best_rows) {
+          best_rows = rows;
+          best_left = left;
+          best_right = right;
+        }
+      }
+    }
+    TERRIER_ASSERT(best_left != best_right, "A connected graph always has a connected pair of subplans");
+
+    Join(subplans[best_left], subplans[best_right]);
+    subplans[best_left] |= subplans[best_right];
+    subplans.erase(subplans.begin() + static_cast<std::ptrdiff_t>(best_right));
+  }
+}
+
+}  // namespace terrier::optimizer
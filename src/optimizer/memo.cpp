@@ -22,6 +22,7 @@ GroupExpression *Memo::InsertExpression(GroupExpression *gexpr, group_id_t targe
   }
 
   // Lookup in hash table
+  common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
   auto it = group_expressions_.find(gexpr);
   if (it != group_expressions_.end()) {
     TERRIER_ASSERT(*gexpr == *(*it), "GroupExpression should be equal");
@@ -40,7 +41,7 @@ GroupExpression *Memo::InsertExpression(GroupExpression *gexpr, group_id_t targe
     group_id = target_group;
   }
 
-  Group *group = GetGroupByID(group_id);
+  Group *group = GroupAt(group_id);
   group->AddExpression(gexpr, enforced);
   return gexpr;
 }
@@ -61,7 +62,7 @@ group_id_t Memo::AddNewGroup(GroupExpression *gexpr) {
   } else {
     // For other groups, need to aggregate the table alias from children
     for (auto child_group_id : gexpr->GetChildGroupIDs()) {
-      Group *child_group = GetGroupByID(child_group_id);
+      Group *child_group = GroupAt(child_group_id);
       for (auto &table_alias : child_group->GetTableAliases()) {
         table_aliases.insert(table_alias);
       }
@@ -5,7 +5,6 @@
 #include <vector>
 
 #include "common/exception.h"
-#include "common/scoped_timer.h"
 #include "optimizer/binding.h"
 #include "optimizer/input_column_deriver.h"
 #include "optimizer/operator_visitor.h"
@@ -112,53 +111,53 @@ std::unique_ptr<planner::AbstractPlanNode> Optimizer::ChooseBestPlan(
                                             std::move(children_plans), std::move(children_expr_map));
   OPTIMIZER_LOG_TRACE("Finish Choosing best plan for group {0}", id);
 
+  // The executor reports the rows of the plan against the estimate it was chosen with
+  plan->SetCardinalityEstimate(group->GetFragmentKey(), group->GetNumRows());
+
   delete op;
   return plan;
 }
 
 void Optimizer::OptimizeLoop(group_id_t root_group_id, PropertySet *required_props) {
   auto root_context = new OptimizationContext(context_.get(), required_props->Copy());
-  auto task_stack = new OptimizerTaskStack();
-  context_->SetTaskPool(task_stack);
+  OptimizerTaskPool *task_pool;
+  if (threads_ != nullptr && threads_->NumWorkers() > 0) {
+    task_pool = new ParallelOptimizerTaskPool(threads_);
+  } else {
+    task_pool = new OptimizerTaskStack();
+  }
+  context_->SetTaskPool(task_pool);
   context_->AddOptimizationContext(root_context);
 
   // Perform rewrite first
-  task_stack->Push(new TopDownRewrite(root_group_id, root_context, RuleSetName::PREDICATE_PUSH_DOWN));
-  task_stack->Push(new BottomUpRewrite(root_group_id, root_context, RuleSetName::UNNEST_SUBQUERY, false));
-  ExecuteTaskStack(task_stack, root_group_id, root_context);
+  task_pool->Push(new TopDownRewrite(root_group_id, root_context, RuleSetName::PREDICATE_PUSH_DOWN));
+  task_pool->Push(new BottomUpRewrite(root_group_id, root_context, RuleSetName::UNNEST_SUBQUERY, false));
+  ExecuteTaskPool(task_pool, root_group_id, root_context);
 
   // Perform optimization after the rewrite
   Memo &memo = context_->GetMemo();
-  task_stack->Push(new OptimizeGroup(memo.GetGroupByID(root_group_id), root_context));
+  task_pool->Push(new OptimizeGroup(memo.GetGroupByID(root_group_id), root_context));
+
+  // Order large trees of joins once their inputs have stats, before the join rules run
+  task_pool->Push(new EnumerateJoins(root_group_id, root_context));
 
   // Derive stats for the only one logical expression before optimizing
-  task_stack->Push(new DeriveStats(memo.GetGroupByID(root_group_id)->GetLogicalExpression(), ExprSet{}, root_context));
-  ExecuteTaskStack(task_stack, root_group_id, root_context);
+  task_pool->Push(new DeriveStats(memo.GetGroupByID(root_group_id)->GetLogicalExpression(), ExprSet{}, root_context));
+  ExecuteTaskPool(task_pool, root_group_id, root_context);
 }
 
-void Optimizer::ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id,
-                                 OptimizationContext *root_context) {
+void Optimizer::ExecuteTaskPool(OptimizerTaskPool *task_pool, group_id_t root_group_id,
+                                OptimizationContext *root_context) {
   auto root_group = context_->GetMemo().GetGroupByID(root_group_id);
   const auto &required_props = root_context->GetRequiredProperties();
 
-  uint64_t elapsed_time = 0;
-
-  // Iterate through the task stack
-  while (!task_stack->Empty()) {
-    // Check to see if we have at least one plan, and if we have exceeded our
-    // timeout limit
-    if (elapsed_time >= task_execution_timeout_ && root_group->HasExpressions(required_props)) {
-      throw OPTIMIZER_EXCEPTION("Optimizer task execution timed out");
-    }
-
-    uint64_t task_runtime = 0;
-    auto task = task_stack->Pop();
-    {
-      common::ScopedTimer<std::chrono::milliseconds> timer(&task_runtime);
-      task->Execute();
-    }
-    delete task;
-    elapsed_time += task_runtime;
+  // Check to see if we have at least one plan, and if we have exceeded our
+  // timeout limit
+  auto timed_out = [&](uint64_t elapsed_time) {
+    return elapsed_time >= task_execution_timeout_ && root_group->HasExpressions(required_props);
+  };
+  if (!task_pool->ExecuteTasks(timed_out)) {
+    throw OPTIMIZER_EXCEPTION("Optimizer task execution timed out");
   }
 }
 
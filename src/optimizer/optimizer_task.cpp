@@ -1,16 +1,25 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "loggers/optimizer_logger.h"
 #include "optimizer/binding.h"
 #include "optimizer/child_property_deriver.h"
+#include "optimizer/cost_model/stats_cost_model.h"
+#include "optimizer/join_enumerator.h"
+#include "optimizer/logical_operators.h"
+#include "optimizer/operator_expression.h"
 #include "optimizer/optimizer_context.h"
 #include "optimizer/optimizer_task.h"
 #include "optimizer/property_enforcer.h"
 #include "optimizer/statistics/child_stats_deriver.h"
 #include "optimizer/statistics/stats_calculator.h"
+#include "parser/expression/column_value_expression.h"
 
 namespace terrier::optimizer {
 
@@ -41,6 +50,12 @@ void OptimizerTask::ConstructValidRules(GroupExpression *group_expr, const std::
 
 void OptimizerTask::PushTask(OptimizerTask *task) { context_->GetOptimizerContext()->PushTask(task); }
 
+void OptimizerTask::PushParallelTasks(std::vector<OptimizerTask *> &&tasks) {
+  context_->GetOptimizerContext()->PushParallelTasks(std::move(tasks));
+}
+
+void OptimizerTask::PushDeferredTask(OptimizerTask *task) { context_->GetOptimizerContext()->PushDeferredTask(task); }
+
 Memo &OptimizerTask::GetMemo() const { return context_->GetOptimizerContext()->GetMemo(); }
 
 RuleSet &OptimizerTask::GetRuleSet() const { return context_->GetOptimizerContext()->GetRuleSet(); }
@@ -54,19 +69,32 @@ void OptimizeGroup::Execute() {
       group_->GetBestExpression(context_->GetRequiredProperties()) != nullptr)  // Has optimized given the context
     return;
 
+  // If another worker is exploring the group, wait for it to finish
+  bool explore = group_->StartExploration();
+  if (!explore && !group_->HasExplored()) {
+    PushDeferredTask(new OptimizeGroup(group_, context_));
+    return;
+  }
+
   // Push explore task first for logical expressions if the group has not been explored
-  if (!group_->HasExplored()) {
-    for (auto &logical_expr : group_->GetLogicalExpressions()) PushTask(new OptimizeExpression(logical_expr, context_));
+  if (explore) {
+    // Since there is no cycle in the tree, the exploration of the group only
+    // depends on the tasks pushed here, which all run before the flag is set
+    PushTask(new FinishExploration(group_, context_));
+
+    std::vector<OptimizerTask *> explore_tasks;
+    for (auto &logical_expr : group_->GetLogicalExpressions()) {
+      explore_tasks.push_back(new OptimizeExpression(logical_expr, context_));
+    }
+    PushParallelTasks(std::move(explore_tasks));
   }
 
   // Push implement tasks to ensure that they are run first (for early pruning)
+  std::vector<OptimizerTask *> implement_tasks;
   for (auto &physical_expr : group_->GetPhysicalExpressions()) {
-    PushTask(new OptimizeExpressionCostWithEnforcedProperty(physical_expr, context_));
+    implement_tasks.push_back(new OptimizeExpressionCostWithEnforcedProperty(physical_expr, context_));
   }
-
-  // Since there is no cycle in the tree, it is safe to set the flag even before
-  // all expressions are explored
-  group_->SetExplorationFlag();
+  PushParallelTasks(std::move(implement_tasks));
 }
 
 //===--------------------------------------------------------------------===//
@@ -88,16 +116,18 @@ void OptimizeExpression::Execute() {
   for (auto &r : valid_rules) {
     PushTask(new ApplyRule(group_expr_, r.GetRule(), context_));
     int child_group_idx = 0;
+    std::vector<OptimizerTask *> explore_tasks;
     for (auto &child_pattern : r.GetRule()->GetMatchPattern()->Children()) {
       // If child_pattern has any more children (i.e non-leaf), then we will explore the
       // child before applying the rule. (assumes task pool is effectively a stack)
       if (child_pattern->GetChildPatternsSize() > 0) {
         Group *group = GetMemo().GetGroupByID(group_expr_->GetChildGroupIDs()[child_group_idx]);
-        PushTask(new ExploreGroup(group, context_));
+        explore_tasks.push_back(new ExploreGroup(group, context_));
       }
 
       child_group_idx++;
     }
+    PushParallelTasks(std::move(explore_tasks));
   }
 }
 
@@ -105,15 +135,29 @@ void OptimizeExpression::Execute() {
 // ExploreGroup
 //===--------------------------------------------------------------------===//
 void ExploreGroup::Execute() {
-  if (group_->HasExplored()) return;
+  if (!group_->StartExploration()) {
+    // If another worker is exploring the group, wait for it to finish
+    if (!group_->HasExplored()) PushDeferredTask(new ExploreGroup(group_, context_));
+    return;
+  }
   OPTIMIZER_LOG_TRACE("ExploreGroup::Execute() ");
 
+  // Since there is no cycle in the tree, the exploration of the group only
+  // depends on the tasks pushed here, which all run before the flag is set
+  PushTask(new FinishExploration(group_, context_));
+
+  std::vector<OptimizerTask *> explore_tasks;
   for (auto &logical_expr : group_->GetLogicalExpressions()) {
-    PushTask(new ExploreExpression(logical_expr, context_));
+    explore_tasks.push_back(new ExploreExpression(logical_expr, context_));
   }
+  PushParallelTasks(std::move(explore_tasks));
+}
 
-  // Since there is no cycle in the tree, it is safe to set the flag even before
-  // all expressions are explored
+//===--------------------------------------------------------------------===//
+// FinishExploration
+//===--------------------------------------------------------------------===//
+void FinishExploration::Execute() {
+  OPTIMIZER_LOG_TRACE("FinishExploration::Execute() group {0}", group_->GetID());
   group_->SetExplorationFlag();
 }
 
@@ -133,16 +177,18 @@ void ExploreExpression::Execute() {
   for (auto &r : valid_rules) {
     PushTask(new ApplyRule(group_expr_, r.GetRule(), context_, true));
     int child_group_idx = 0;
+    std::vector<OptimizerTask *> explore_tasks;
     for (auto &child_pattern : r.GetRule()->GetMatchPattern()->Children()) {
       // Only need to explore non-leaf children before applying rule to the
       // current group. this condition is important for early-pruning
       if (child_pattern->GetChildPatternsSize() > 0) {
         Group *group = GetMemo().GetGroupByID(group_expr_->GetChildGroupIDs()[child_group_idx]);
-        PushTask(new ExploreGroup(group, context_));
+        explore_tasks.push_back(new ExploreGroup(group, context_));
       }
 
       child_group_idx++;
     }
+    PushParallelTasks(std::move(explore_tasks));
   }
 }
 
@@ -166,8 +212,10 @@ void ApplyRule::Execute() {
     for (const auto &new_expr : after) {
       GroupExpression *new_gexpr = nullptr;
       auto g_id = group_expr_->GetGroupID();
+      // Transformations derive new logical expressions, implementations inherit from the logical expression
+      const bool derived = new_expr->GetOp().IsLogical() || group_expr_->IsDerived();
       if (context_->GetOptimizerContext()->RecordOperatorExpressionIntoGroup(common::ManagedPointer(new_expr.get()),
-                                                                             &new_gexpr, g_id)) {
+                                                                             &new_gexpr, g_id, derived)) {
         // A new group expression is generated
         if (new_gexpr->Op().IsLogical()) {
           // Derive stats for the *logical expression*
@@ -205,6 +253,7 @@ void DeriveStats::Execute() {
   // If we haven't got enough stats to compute the current stats, derive them
   // from the child first
   TERRIER_ASSERT(children_required_stats.size() == gexpr_->GetChildrenGroupsSize(), "Stats size mismatch");
+  std::vector<OptimizerTask *> child_tasks;
   for (size_t idx = 0; idx < children_required_stats.size(); ++idx) {
     auto &child_required_stats = children_required_stats[idx];
     auto child_group_id = gexpr_->GetChildGroupId(static_cast<int>(idx));
@@ -221,12 +270,13 @@ void DeriveStats::Execute() {
         // Derive stats for root later
         PushTask(new DeriveStats(this));
       }
-      PushTask(new DeriveStats(child_group_gexpr, child_required_stats, context_));
+      child_tasks.push_back(new DeriveStats(child_group_gexpr, child_required_stats, context_));
     }
   }
 
   if (derive_children) {
     // We'll derive for the current group after deriving stats of children
+    PushParallelTasks(std::move(child_tasks));
     return;
   }
 
@@ -235,6 +285,210 @@ void DeriveStats::Execute() {
   gexpr_->SetDerivedStats();
 }
 
+//===--------------------------------------------------------------------===//
+// EnumerateJoins
+//===--------------------------------------------------------------------===//
+namespace {
+
+using RelationSet = JoinEnumerator::RelationSet;
+
+// The selectivity of predicates other than equalities, the same guess the cost model makes for range predicates
+constexpr double K_DEFAULT_JOIN_SELECTIVITY = 1.0 / 3.0;
+
+// The relations producing the given aliases, or 0 if an alias belongs to none of them
+RelationSet RelationsOf(const std::unordered_set<std::string> &aliases,
+                        const std::unordered_map<std::string, size_t> &alias_relations) {
+  RelationSet relations = 0;
+  for (const auto &alias : aliases) {
+    const auto it = alias_relations.find(alias);
+    if (it == alias_relations.end()) return 0;
+    relations |= RelationSet{1} << it->second;
+  }
+  return relations;
+}
+
+// The relations whose columns an expression reads
+RelationSet RelationsOf(const common::ManagedPointer<parser::AbstractExpression> expr,
+                        const std::unordered_map<std::string, size_t> &alias_relations) {
+  if (expr->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+    const auto it = alias_relations.find(expr.CastManagedPointerTo<parser::ColumnValueExpression>()->GetTableName());
+    return it == alias_relations.end() ? 0 : RelationSet{1} << it->second;
+  }
+  RelationSet relations = 0;
+  for (const auto &child : expr->GetChildren()) relations |= RelationsOf(child, alias_relations);
+  return relations;
+}
+
+}  // namespace
+
+void EnumerateJoins::Execute() {
+  // Follow the first logical expression of each group, as DeriveStats does, and order every tree of joins found
+  std::unordered_set<group_id_t> visited;
+  std::vector<group_id_t> to_visit{group_id_};
+  while (!to_visit.empty()) {
+    const group_id_t group_id = to_visit.back();
+    to_visit.pop_back();
+    if (!visited.insert(group_id).second) continue;
+
+    const auto logical_exprs = GetMemo().GetGroupByID(group_id)->GetLogicalExpressions();
+    if (logical_exprs.empty()) continue;
+    auto *gexpr = logical_exprs[0];
+    if (gexpr->Op().GetType() != OpType::LOGICALINNERJOIN) {
+      for (const auto child_group_id : gexpr->GetChildGroupIDs()) to_visit.push_back(child_group_id);
+      continue;
+    }
+
+    std::vector<GroupExpression *> joins;
+    std::vector<group_id_t> inputs;
+    CollectJoins(gexpr, &joins, &inputs);
+    if (inputs.size() >= K_MIN_RELATIONS && inputs.size() <= JoinEnumerator::K_MAX_RELATIONS) {
+      OrderJoins(group_id, joins, inputs);
+    }
+    to_visit.insert(to_visit.end(), inputs.begin(), inputs.end());
+  }
+}
+
+void EnumerateJoins::CollectJoins(GroupExpression *join, std::vector<GroupExpression *> *joins,
+                                  std::vector<group_id_t> *inputs) {
+  joins->push_back(join);
+  for (const auto child_group_id : join->GetChildGroupIDs()) {
+    const auto logical_exprs = GetMemo().GetGroupByID(child_group_id)->GetLogicalExpressions();
+    if (!logical_exprs.empty() && logical_exprs[0]->Op().GetType() == OpType::LOGICALINNERJOIN) {
+      CollectJoins(logical_exprs[0], joins, inputs);
+    } else {
+      inputs->push_back(child_group_id);
+    }
+  }
+}
+
+void EnumerateJoins::OrderJoins(const group_id_t group_id, const std::vector<GroupExpression *> &joins,
+                                const std::vector<group_id_t> &inputs) {
+  auto *optimizer_context = context_->GetOptimizerContext();
+  auto &memo = GetMemo();
+  JoinEnumerator enumerator(common::ManagedPointer(optimizer_context->GetCostModel()));
+
+  // Each input is a relation of the join graph, and predicates find their relations by table alias
+  std::unordered_map<std::string, size_t> alias_relations;
+  std::vector<double> input_rows;
+  for (const auto input : inputs) {
+    auto *group = memo.GetGroupByID(input);
+    const int num_rows = group->GetNumRows();
+    input_rows.push_back(num_rows < 0 ? StatsCostModel::K_DEFAULT_NUM_ROWS : static_cast<double>(num_rows));
+    const size_t relation = enumerator.AddRelation(input_rows.back());
+    for (const auto &alias : group->GetTableAliases()) {
+      // An alias produced by two inputs cannot tell which one a predicate refers to
+      if (!alias_relations.emplace(alias, relation).second) return;
+    }
+  }
+
+  // Predicates over fewer than two inputs, or over aliases from outside the tree, are evaluated by the top join
+  const RelationSet all_relations = enumerator.GetAllRelations();
+  std::vector<std::pair<RelationSet, AnnotatedExpression>> predicates;
+  for (auto *join : joins) {
+    for (const auto &predicate : join->Op().As<LogicalInnerJoin>()->GetJoinPredicates()) {
+      RelationSet relations = RelationsOf(predicate.GetTableAliasSet(), alias_relations);
+      if (relations == 0 || (relations & (relations - 1)) == 0) {
+        predicates.emplace_back(all_relations, predicate);
+        continue;
+      }
+      predicates.emplace_back(relations, predicate);
+
+      // The sides of a comparison are the sides of its hyperedge. Other predicates need their first relation
+      // joined with all the others.
+      auto expr = predicate.GetExpr();
+      RelationSet left = 0;
+      RelationSet right = 0;
+      if (expr->GetChildrenSize() == 2) {
+        left = RelationsOf(expr->GetChild(0), alias_relations);
+        right = RelationsOf(expr->GetChild(1), alias_relations);
+      }
+      if (left == 0 || right == 0 || (left & right) != 0 || (left | right) != relations) {
+        left = relations & (~relations + 1);
+        right = relations & ~left;
+      }
+
+      // An equality on two columns keeps one row per distinct value of the column with the most of them. Without
+      // column stats, it keeps one row per row of the largest input, as StatsCalculator assumes.
+      const bool is_equi = expr->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL;
+      double selectivity = K_DEFAULT_JOIN_SELECTIVITY;
+      if (is_equi) {
+        double num_distinct = 0.0;
+        double max_rows = 1.0;
+        for (size_t relation = 0; relation < inputs.size(); relation++) {
+          if ((relations & (RelationSet{1} << relation)) != 0) max_rows = std::max(max_rows, input_rows[relation]);
+        }
+        for (size_t child_idx = 0; child_idx < expr->GetChildrenSize(); child_idx++) {
+          auto child = expr->GetChild(child_idx);
+          if (child->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) continue;
+          auto column = child.CastManagedPointerTo<parser::ColumnValueExpression>();
+          const auto it = alias_relations.find(column->GetTableName());
+          if (it == alias_relations.end()) continue;
+          auto *group = memo.GetGroupByID(inputs[it->second]);
+          if (group->HasColumnStats(column->GetFullName())) {
+            num_distinct = std::max(num_distinct, group->GetStats(column->GetFullName())->GetCardinality());
+          }
+        }
+        selectivity = 1.0 / (num_distinct >= 1.0 ? num_distinct : max_rows);
+      }
+      enumerator.AddEdge(left, right, selectivity, is_equi);
+    }
+  }
+
+  // Cross products are left to the rules
+  if (!enumerator.IsConnected()) return;
+  enumerator.Enumerate();
+  OPTIMIZER_LOG_TRACE("EnumerateJoins::OrderJoins() group {0}: {1} inputs, {2} pairs, greedy {3}", group_id,
+                      inputs.size(), enumerator.GetNumPairs(), enumerator.UsedGreedy());
+
+  // Each join of the plan evaluates the predicates between its inputs
+  std::function<std::unique_ptr<OperatorExpression>(RelationSet)> build = [&](const RelationSet relations) {
+    const auto &plan = enumerator.GetPlan(relations);
+    if (plan.left_ == 0) {
+      const auto relation = static_cast<size_t>(__builtin_ctzll(relations));
+      return std::make_unique<OperatorExpression>(LeafOperator::Make(inputs[relation]),
+                                                  std::vector<std::unique_ptr<OperatorExpression>>{});
+    }
+    std::vector<AnnotatedExpression> join_predicates;
+    for (const auto &[predicate_relations, predicate] : predicates) {
+      if ((predicate_relations & ~relations) == 0 && (predicate_relations & ~plan.left_) != 0 &&
+          (predicate_relations & ~plan.right_) != 0) {
+        join_predicates.push_back(predicate);
+      }
+    }
+    std::vector<std::unique_ptr<OperatorExpression>> children;
+    children.emplace_back(build(plan.left_));
+    children.emplace_back(build(plan.right_));
+    return std::make_unique<OperatorExpression>(LogicalInnerJoin::Make(std::move(join_predicates)),
+                                                std::move(children));
+  };
+  auto plan_expr = build(all_relations);
+
+  GroupExpression *plan_gexpr = nullptr;
+  if (optimizer_context->RecordOperatorExpressionIntoGroup(common::ManagedPointer(plan_expr.get()), &plan_gexpr,
+                                                           group_id, true)) {
+    // The joins of the plan that were not in the Memo have no stats yet
+    PushTask(new DeriveStats(plan_gexpr, ExprSet{}, context_));
+  }
+
+  const std::unordered_set<group_id_t> input_set(inputs.begin(), inputs.end());
+  MarkJoinsExplored(joins[0], input_set);
+  MarkJoinsExplored(plan_gexpr, input_set);
+}
+
+void EnumerateJoins::MarkJoinsExplored(GroupExpression *join, const std::unordered_set<group_id_t> &inputs) {
+  for (auto *rule : GetRuleSet().GetRulesByName(RuleSetName::LOGICAL_TRANSFORMATION)) {
+    if (rule->GetType() == RuleType::INNER_JOIN_COMMUTE || rule->GetType() == RuleType::INNER_JOIN_ASSOCIATE) {
+      join->SetRuleExplored(rule);
+    }
+  }
+  for (const auto child_group_id : join->GetChildGroupIDs()) {
+    if (inputs.count(child_group_id) != 0) continue;
+    for (auto *child : GetMemo().GetGroupByID(child_group_id)->GetLogicalExpressions()) {
+      if (child->Op().GetType() == OpType::LOGICALINNERJOIN) MarkJoinsExplored(child, inputs);
+    }
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // OptimizeExpressionCostWithEnforcedProperty
 //===--------------------------------------------------------------------===//
@@ -275,8 +529,7 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
       // Compute the cost of the root operator
       // 1. Collect stats needed and cache them in the group
       // 2. Calculate cost based on children's stats
-      cur_total_cost_ += context_->GetOptimizerContext()->GetCostModel()->CalculateCost(
-          context_->GetOptimizerContext()->GetTxn(), &context_->GetOptimizerContext()->GetMemo(), group_expr_);
+      cur_total_cost_ += context_->GetOptimizerContext()->CalculateCost(group_expr_);
     }
 
     for (; cur_child_idx_ < static_cast<int>(group_expr_->GetChildrenGroupsSize()); cur_child_idx_++) {
@@ -316,9 +569,16 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
         input_props_copy.push_back(i_prop->Copy());
       }
 
+      // The key of the plan is built from the best plans of the children, which are final by now
+      PlanKey plan_key{group_expr_->IsDerived() ? 1U : 0U, group_expr_->Op().Hash()};
+      for (size_t child = 0; child < group_expr_->GetChildrenGroupsSize(); child++) {
+        auto child_group = GetMemo().GetGroupByID(group_expr_->GetChildGroupId(child));
+        plan_key.Append(child_group->GetBestPlanKey(input_props[child]));
+      }
+
       group_expr_->SetLocalHashTable(output_prop->Copy(), input_props_copy, cur_total_cost_);
       auto cur_group = GetMemo().GetGroupByID(group_expr_->GetGroupID());
-      cur_group->SetExpressionCost(group_expr_, cur_total_cost_, output_prop->Copy());
+      cur_group->SetExpressionCost(group_expr_, cur_total_cost_, output_prop->Copy(), plan_key);
 
       // Enforce property if the requirement does not meet
       PropertyEnforcer prop_enforcer;
@@ -347,13 +607,12 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
           // Cost the enforced expression
           auto extended_prop_set = output_prop->Copy();
           extended_prop_set->AddProperty(prop->Copy());
-          cur_total_cost_ += context_->GetOptimizerContext()->GetCostModel()->CalculateCost(
-              context_->GetOptimizerContext()->GetTxn(), &context_->GetOptimizerContext()->GetMemo(),
-              memo_enforced_expr);
+          cur_total_cost_ += context_->GetOptimizerContext()->CalculateCost(memo_enforced_expr);
 
           // Update hash tables for group and group expression
           memo_enforced_expr->SetLocalHashTable(extended_prop_set, {pre_output_prop_set}, cur_total_cost_);
-          cur_group->SetExpressionCost(memo_enforced_expr, cur_total_cost_, output_prop->Copy());
+          plan_key = PlanKey{0, memo_enforced_expr->Op().Hash()}.Append(plan_key);
+          cur_group->SetExpressionCost(memo_enforced_expr, cur_total_cost_, output_prop->Copy(), plan_key);
         }
       }
 
@@ -362,10 +621,12 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
         // If the cost is smaller than the winner, update the context upper bound
         context_->SetCostUpperBound(context_->GetCostUpperBound() - cur_total_cost_);
         if (memo_enforced_expr != nullptr) {  // Enforcement takes place
-          cur_group->SetExpressionCost(memo_enforced_expr, cur_total_cost_, context_->GetRequiredProperties()->Copy());
+          cur_group->SetExpressionCost(memo_enforced_expr, cur_total_cost_, context_->GetRequiredProperties()->Copy(),
+                                       plan_key);
         } else if (output_prop->Properties().size() != context_->GetRequiredProperties()->Properties().size()) {
           // The original output property is a super set of the requirement
-          cur_group->SetExpressionCost(group_expr_, cur_total_cost_, context_->GetRequiredProperties()->Copy());
+          cur_group->SetExpressionCost(group_expr_, cur_total_cost_, context_->GetRequiredProperties()->Copy(),
+                                       plan_key);
         }
       }
     }
@@ -0,0 +1,332 @@
+#include "optimizer/optimizer_task_pool.h"
+
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/scoped_timer.h"
+
+namespace terrier::optimizer {
+
+//===--------------------------------------------------------------------===//
+// OptimizerTaskPool
+//===--------------------------------------------------------------------===//
+bool OptimizerTaskPool::ExecuteTasks(const std::function<bool(uint64_t)> &should_stop) {
+  uint64_t elapsed_time = 0;
+
+  while (!Empty()) {
+    if (should_stop(elapsed_time)) {
+      while (!Empty()) delete Pop();
+      return false;
+    }
+
+    uint64_t task_runtime = 0;
+    std::unique_ptr<OptimizerTask> task(Pop());
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&task_runtime);
+      task->Execute();
+    }
+    elapsed_time += task_runtime;
+  }
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// ParallelOptimizerTaskPool
+//===--------------------------------------------------------------------===//
+
+/**
+ * A task with the tasks it pushed. The children of a task run one at a time, the last
+ * one first, and the children of a batch pushed by PushParallel run concurrently. A node
+ * finishes once its task and all its children ran.
+ */
+struct ParallelOptimizerTaskPool::TaskNode {
+  TaskNode(OptimizerTask *task, bool parallel, bool deferred) : task_(task), parallel_(parallel), deferred_(deferred) {}
+
+  /**
+   * Task to run, or nullptr for the root and batches
+   */
+  std::unique_ptr<OptimizerTask> task_;
+
+  /**
+   * Whether the children run concurrently
+   */
+  const bool parallel_;
+
+  /**
+   * Whether the task runs once no worker has anything else to run
+   */
+  const bool deferred_;
+
+  /**
+   * Node that pushed this one
+   */
+  TaskNode *parent_ = nullptr;
+
+  /**
+   * Position in the children of the parent
+   */
+  size_t index_ = 0;
+
+  /**
+   * Nodes pushed by the task, which are freed as they finish
+   */
+  std::vector<std::unique_ptr<TaskNode>> children_;
+
+  /**
+   * Position of the running child, if the children run one at a time
+   */
+  size_t next_child_ = 0;
+
+  /**
+   * Number of running children, if the children run concurrently
+   */
+  std::atomic<size_t> pending_{0};
+};
+
+ParallelOptimizerTaskPool::ParallelOptimizerTaskPool(const common::ManagedPointer<common::WorkerPool> threads)
+    : num_workers_(threads->NumWorkers() + 1),
+      root_(std::make_unique<TaskNode>(nullptr, false, false)),
+      threads_(threads) {
+  for (uint32_t worker = 0; worker < num_workers_; worker++) queues_.emplace_back(std::make_unique<WorkerQueue>());
+}
+
+ParallelOptimizerTaskPool::~ParallelOptimizerTaskPool() = default;
+
+thread_local ParallelOptimizerTaskPool::TaskNode *ParallelOptimizerTaskPool::running_node_ = nullptr;
+
+thread_local uint32_t ParallelOptimizerTaskPool::running_worker_ = 0;
+
+OptimizerTask *ParallelOptimizerTaskPool::Pop() {
+  TERRIER_ASSERT(!Empty(), "Pop from an empty pool");
+  auto &children = root_->children_;
+  auto node = std::move(children.back());
+  children.pop_back();
+  if (node->task_ != nullptr) return node->task_.release();
+
+  // The newest task of a batch comes first, and the rest of the batch stays
+  auto *task = node->children_.back()->task_.release();
+  node->children_.pop_back();
+  if (!node->children_.empty()) children.emplace_back(std::move(node));
+  return task;
+}
+
+bool ParallelOptimizerTaskPool::Empty() { return root_->children_.empty(); }
+
+void ParallelOptimizerTaskPool::AddChild(std::unique_ptr<TaskNode> node) {
+  auto *parent = running_node_ == nullptr ? root_.get() : running_node_;
+  node->parent_ = parent;
+  node->index_ = parent->children_.size();
+  parent->children_.emplace_back(std::move(node));
+}
+
+void ParallelOptimizerTaskPool::Push(OptimizerTask *task) { AddChild(std::make_unique<TaskNode>(task, false, false)); }
+
+void ParallelOptimizerTaskPool::PushParallel(std::vector<OptimizerTask *> &&tasks) {
+  if (tasks.size() <= 1) {
+    for (auto *task : tasks) Push(task);
+    return;
+  }
+
+  auto batch = std::make_unique<TaskNode>(nullptr, true, false);
+  for (auto *task : tasks) {
+    auto node = std::make_unique<TaskNode>(task, false, false);
+    node->parent_ = batch.get();
+    node->index_ = batch->children_.size();
+    batch->children_.emplace_back(std::move(node));
+  }
+  AddChild(std::move(batch));
+}
+
+void ParallelOptimizerTaskPool::PushDeferred(OptimizerTask *task) {
+  AddChild(std::make_unique<TaskNode>(task, false, true));
+}
+
+void ParallelOptimizerTaskPool::Run(TaskNode *node) {
+  if (node->task_ != nullptr) {
+    running_node_ = node;
+    node->task_->Execute();
+    running_node_ = nullptr;
+    node->task_.reset();
+
+    // A deferred task that has to wait again is retried in place, instead of under itself
+    if (node->deferred_ && node->children_.size() == 1 && node->children_[0]->deferred_) {
+      node->task_ = std::move(node->children_[0]->task_);
+      node->children_.clear();
+      Schedule(node);
+      return;
+    }
+  }
+
+  auto &children = node->children_;
+  if (children.empty()) {
+    Finish(node);
+  } else if (node->parallel_) {
+    node->pending_ = children.size();
+    for (auto &child : children) Schedule(child.get());
+  } else {
+    node->next_child_ = children.size() - 1;
+    Schedule(children.back().get());
+  }
+}
+
+void ParallelOptimizerTaskPool::Schedule(TaskNode *node) {
+  if (node->deferred_) {
+    {
+      common::SpinLatch::ScopedSpinLatch guard(&deferred_latch_);
+      deferred_.push_back(node);
+    }
+    WakeIdle();
+    return;
+  }
+
+  {
+    auto &queue = *queues_[running_worker_];
+    common::SpinLatch::ScopedSpinLatch guard(&queue.latch_);
+    queue.nodes_.push_back(node);
+  }
+  WakeIdle();
+}
+
+void ParallelOptimizerTaskPool::WakeIdle() {
+  // An idle worker counts itself before looking for nodes under idle_latch_, so it either finds the node or is woken
+  if (num_idle_ == 0) return;
+  std::lock_guard<std::mutex> guard(idle_latch_);
+  idle_cv_.notify_one();
+}
+
+void ParallelOptimizerTaskPool::WakeAll() {
+  std::lock_guard<std::mutex> guard(idle_latch_);
+  idle_cv_.notify_all();
+}
+
+void ParallelOptimizerTaskPool::Finish(TaskNode *node) {
+  while (node != root_.get()) {
+    auto *parent = node->parent_;
+    parent->children_[node->index_].reset();
+
+    if (parent->parallel_) {
+      // The last child of a batch to finish finishes the batch
+      if (parent->pending_.fetch_sub(1) != 1) return;
+    } else if (parent->next_child_ > 0) {
+      Schedule(parent->children_[--parent->next_child_].get());
+      return;
+    }
+    node = parent;
+  }
+
+  root_->children_.clear();
+  done_ = true;
+  WakeAll();
+}
+
+ParallelOptimizerTaskPool::TaskNode *ParallelOptimizerTaskPool::Take(const uint32_t worker) {
+  // Newest task of the worker first, as a stack would
+  {
+    auto &queue = *queues_[worker];
+    common::SpinLatch::ScopedSpinLatch guard(&queue.latch_);
+    if (!queue.nodes_.empty()) {
+      auto *node = queue.nodes_.back();
+      queue.nodes_.pop_back();
+      return node;
+    }
+  }
+
+  // Oldest task of another worker, which is likely to push the most tasks
+  for (uint32_t offset = 1; offset < num_workers_; offset++) {
+    auto &queue = *queues_[(worker + offset) % num_workers_];
+    common::SpinLatch::ScopedSpinLatch guard(&queue.latch_);
+    if (!queue.nodes_.empty()) {
+      auto *node = queue.nodes_.front();
+      queue.nodes_.pop_front();
+      return node;
+    }
+  }
+
+  common::SpinLatch::ScopedSpinLatch guard(&deferred_latch_);
+  if (deferred_.empty()) return nullptr;
+  auto *node = deferred_.front();
+  deferred_.pop_front();
+  return node;
+}
+
+ParallelOptimizerTaskPool::TaskNode *ParallelOptimizerTaskPool::WaitAndTake(const uint32_t worker) {
+  std::unique_lock<std::mutex> lock(idle_latch_);
+  num_idle_++;
+  TaskNode *node;
+  while ((node = Take(worker)) == nullptr && !done_ && !stopped_) idle_cv_.wait(lock);
+  num_idle_--;
+  return node;
+}
+
+void ParallelOptimizerTaskPool::Work(const uint32_t worker, const std::function<bool(uint64_t)> &should_stop) {
+  running_worker_ = worker;
+  while (!done_ && !stopped_) {
+    auto *node = Take(worker);
+    if (node == nullptr) node = WaitAndTake(worker);
+    if (node == nullptr) continue;
+
+    const bool deferred = node->deferred_;
+    try {
+      Run(node);
+    } catch (...) {
+      running_node_ = nullptr;
+      common::SpinLatch::ScopedSpinLatch guard(&error_latch_);
+      if (error_ == nullptr) error_ = std::current_exception();
+      stopped_ = true;
+      WakeAll();
+    }
+    // A deferred task likely waits for a task running on another worker
+    if (deferred) std::this_thread::yield();
+
+    const auto elapsed = std::chrono::steady_clock::now() - start_time_;
+    if (should_stop(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count())) {
+      stopped_ = true;
+      WakeAll();
+    }
+  }
+  running_worker_ = 0;
+}
+
+bool ParallelOptimizerTaskPool::ExecuteTasks(const std::function<bool(uint64_t)> &should_stop) {
+  if (Empty()) return true;
+
+  start_time_ = std::chrono::steady_clock::now();
+  done_ = false;
+  stopped_ = false;
+  error_ = nullptr;
+
+  Run(root_.get());
+  {
+    std::lock_guard<std::mutex> guard(helpers_latch_);
+    running_helpers_ = num_workers_ - 1;
+  }
+  for (uint32_t worker = 1; worker < num_workers_; worker++) {
+    threads_->SubmitTask([this, worker, &should_stop] {
+      Work(worker, should_stop);
+      std::lock_guard<std::mutex> guard(helpers_latch_);
+      if (--running_helpers_ == 0) helpers_cv_.notify_all();
+    });
+  }
+  Work(0, should_stop);
+
+  // The worker pool may be busy with other optimizations, so wait for our own workers rather than for the pool.
+  // Workers that start after the execution finished return right away.
+  {
+    std::unique_lock<std::mutex> lock(helpers_latch_);
+    helpers_cv_.wait(lock, [this] { return running_helpers_ == 0; });
+  }
+
+  // Discard the tasks that did not run
+  const bool finished = done_;
+  root_->children_.clear();
+  for (auto &queue : queues_) queue->nodes_.clear();
+  deferred_.clear();
+
+  if (error_ != nullptr) std::rethrow_exception(error_);
+  return finished;
+}
+
+}  // namespace terrier::optimizer
@@ -100,7 +100,8 @@ Operator IndexScan::Make(catalog::db_oid_t database_oid, catalog::namespace_oid_
                          std::string table_alias, bool is_for_update,
                          std::vector<catalog::col_oid_t> &&key_column_oid_list,
                          std::vector<parser::ExpressionType> &&expr_type_list,
-                         std::vector<type::TransientValue> &&value_list) {
+                         std::vector<type::TransientValue> &&value_list,
+                         std::vector<uint32_t> &&num_values_list) {
   auto scan = std::make_unique<IndexScan>();
   scan->database_oid_ = database_oid;
   scan->namespace_oid_ = namespace_oid;
@@ -111,6 +112,7 @@ Operator IndexScan::Make(catalog::db_oid_t database_oid, catalog::namespace_oid_
   scan->key_column_oid_list_ = std::move(key_column_oid_list);
   scan->expr_type_list_ = std::move(expr_type_list);
   scan->value_list_ = std::move(value_list);
+  scan->num_values_list_ = std::move(num_values_list);
 
   return Operator(std::move(scan));
 }
@@ -131,6 +133,7 @@ bool IndexScan::operator==(const BaseOperatorNode &r) {
   if (key_column_oid_list_ != node.key_column_oid_list_) return false;
   if (expr_type_list_ != node.expr_type_list_) return false;
   if (value_list_ != node.value_list_) return false;
+  if (num_values_list_ != node.num_values_list_) return false;
   return true;
 }
 
@@ -153,6 +156,8 @@ common::hash_t IndexScan::Hash() const {
   for (const auto &expr_type : expr_type_list_)
     hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(expr_type));
   for (auto &val : value_list_) hash = common::HashUtil::CombineHashes(hash, val.Hash());
+  for (const auto num_values : num_values_list_)
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(num_values));
   return hash;
 }
 
@@ -438,22 +443,44 @@ bool InnerHashJoin::operator==(const BaseOperatorNode &r) {
 //===--------------------------------------------------------------------===//
 BaseOperatorNode *LeftHashJoin::Copy() const { return new LeftHashJoin(*this); }
 
-Operator LeftHashJoin::Make(common::ManagedPointer<parser::AbstractExpression> join_predicate) {
+Operator LeftHashJoin::Make(std::vector<AnnotatedExpression> &&join_predicates,
+                            std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                            std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys) {
   auto join = std::make_unique<LeftHashJoin>();
-  join->join_predicate_ = join_predicate;
+  join->join_predicates_ = std::move(join_predicates);
+  join->left_keys_ = std::move(left_keys);
+  join->right_keys_ = std::move(right_keys);
   return Operator(std::move(join));
 }
 
 common::hash_t LeftHashJoin::Hash() const {
   common::hash_t hash = BaseOperatorNode::Hash();
-  hash = common::HashUtil::CombineHashes(hash, join_predicate_->Hash());
+  for (auto &expr : left_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &expr : right_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &pred : join_predicates_) {
+    auto expr = pred.GetExpr();
+    if (expr)
+      hash = common::HashUtil::SumHashes(hash, expr->Hash());
+    else
+      hash = common::HashUtil::SumHashes(hash, BaseOperatorNode::Hash());
+  }
   return hash;
 }
 
 bool LeftHashJoin::operator==(const BaseOperatorNode &r) {
   if (r.GetType() != OpType::LEFTHASHJOIN) return false;
   const LeftHashJoin &node = *static_cast<const LeftHashJoin *>(&r);
-  return (*join_predicate_ == *(node.join_predicate_));
+  if (left_keys_.size() != node.left_keys_.size() || right_keys_.size() != node.right_keys_.size() ||
+      join_predicates_.size() != node.join_predicates_.size())
+    return false;
+  if (join_predicates_ != node.join_predicates_) return false;
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    if (*(left_keys_[i]) != *(node.left_keys_[i])) return false;
+  }
+  for (size_t i = 0; i < right_keys_.size(); i++) {
+    if (*(right_keys_[i]) != *(node.right_keys_[i])) return false;
+  }
+  return true;
 }
 
 //===--------------------------------------------------------------------===//
@@ -461,22 +488,44 @@ bool LeftHashJoin::operator==(const BaseOperatorNode &r) {
 //===--------------------------------------------------------------------===//
 BaseOperatorNode *RightHashJoin::Copy() const { return new RightHashJoin(*this); }
 
-Operator RightHashJoin::Make(common::ManagedPointer<parser::AbstractExpression> join_predicate) {
+Operator RightHashJoin::Make(std::vector<AnnotatedExpression> &&join_predicates,
+                             std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                             std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys) {
   auto join = std::make_unique<RightHashJoin>();
-  join->join_predicate_ = join_predicate;
+  join->join_predicates_ = std::move(join_predicates);
+  join->left_keys_ = std::move(left_keys);
+  join->right_keys_ = std::move(right_keys);
   return Operator(std::move(join));
 }
 
 common::hash_t RightHashJoin::Hash() const {
   common::hash_t hash = BaseOperatorNode::Hash();
-  hash = common::HashUtil::CombineHashes(hash, join_predicate_->Hash());
+  for (auto &expr : left_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &expr : right_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &pred : join_predicates_) {
+    auto expr = pred.GetExpr();
+    if (expr)
+      hash = common::HashUtil::SumHashes(hash, expr->Hash());
+    else
+      hash = common::HashUtil::SumHashes(hash, BaseOperatorNode::Hash());
+  }
   return hash;
 }
 
 bool RightHashJoin::operator==(const BaseOperatorNode &r) {
   if (r.GetType() != OpType::RIGHTHASHJOIN) return false;
   const RightHashJoin &node = *static_cast<const RightHashJoin *>(&r);
-  return (*join_predicate_ == *(node.join_predicate_));
+  if (left_keys_.size() != node.left_keys_.size() || right_keys_.size() != node.right_keys_.size() ||
+      join_predicates_.size() != node.join_predicates_.size())
+    return false;
+  if (join_predicates_ != node.join_predicates_) return false;
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    if (*(left_keys_[i]) != *(node.left_keys_[i])) return false;
+  }
+  for (size_t i = 0; i < right_keys_.size(); i++) {
+    if (*(right_keys_[i]) != *(node.right_keys_[i])) return false;
+  }
+  return true;
 }
 
 //===--------------------------------------------------------------------===//
@@ -484,22 +533,134 @@ bool RightHashJoin::operator==(const BaseOperatorNode &r) {
 //===--------------------------------------------------------------------===//
 BaseOperatorNode *OuterHashJoin::Copy() const { return new OuterHashJoin(*this); }
 
-Operator OuterHashJoin::Make(common::ManagedPointer<parser::AbstractExpression> join_predicate) {
+Operator OuterHashJoin::Make(std::vector<AnnotatedExpression> &&join_predicates,
+                             std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                             std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys) {
   auto join = std::make_unique<OuterHashJoin>();
-  join->join_predicate_ = join_predicate;
+  join->join_predicates_ = std::move(join_predicates);
+  join->left_keys_ = std::move(left_keys);
+  join->right_keys_ = std::move(right_keys);
   return Operator(std::move(join));
 }
 
 common::hash_t OuterHashJoin::Hash() const {
   common::hash_t hash = BaseOperatorNode::Hash();
-  hash = common::HashUtil::CombineHashes(hash, join_predicate_->Hash());
+  for (auto &expr : left_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &expr : right_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &pred : join_predicates_) {
+    auto expr = pred.GetExpr();
+    if (expr)
+      hash = common::HashUtil::SumHashes(hash, expr->Hash());
+    else
+      hash = common::HashUtil::SumHashes(hash, BaseOperatorNode::Hash());
+  }
   return hash;
 }
 
 bool OuterHashJoin::operator==(const BaseOperatorNode &r) {
   if (r.GetType() != OpType::OUTERHASHJOIN) return false;
   const OuterHashJoin &node = *static_cast<const OuterHashJoin *>(&r);
-  return (*join_predicate_ == *(node.join_predicate_));
+  if (left_keys_.size() != node.left_keys_.size() || right_keys_.size() != node.right_keys_.size() ||
+      join_predicates_.size() != node.join_predicates_.size())
+    return false;
+  if (join_predicates_ != node.join_predicates_) return false;
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    if (*(left_keys_[i]) != *(node.left_keys_[i])) return false;
+  }
+  for (size_t i = 0; i < right_keys_.size(); i++) {
+    if (*(right_keys_[i]) != *(node.right_keys_[i])) return false;
+  }
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// SemiHashJoin
+//===--------------------------------------------------------------------===//
+BaseOperatorNode *SemiHashJoin::Copy() const { return new SemiHashJoin(*this); }
+
+Operator SemiHashJoin::Make(std::vector<AnnotatedExpression> &&join_predicates,
+                            std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                            std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys) {
+  auto join = std::make_unique<SemiHashJoin>();
+  join->join_predicates_ = std::move(join_predicates);
+  join->left_keys_ = std::move(left_keys);
+  join->right_keys_ = std::move(right_keys);
+  return Operator(std::move(join));
+}
+
+common::hash_t SemiHashJoin::Hash() const {
+  common::hash_t hash = BaseOperatorNode::Hash();
+  for (auto &expr : left_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &expr : right_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &pred : join_predicates_) {
+    auto expr = pred.GetExpr();
+    if (expr)
+      hash = common::HashUtil::SumHashes(hash, expr->Hash());
+    else
+      hash = common::HashUtil::SumHashes(hash, BaseOperatorNode::Hash());
+  }
+  return hash;
+}
+
+bool SemiHashJoin::operator==(const BaseOperatorNode &r) {
+  if (r.GetType() != OpType::SEMIHASHJOIN) return false;
+  const SemiHashJoin &node = *static_cast<const SemiHashJoin *>(&r);
+  if (left_keys_.size() != node.left_keys_.size() || right_keys_.size() != node.right_keys_.size() ||
+      join_predicates_.size() != node.join_predicates_.size())
+    return false;
+  if (join_predicates_ != node.join_predicates_) return false;
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    if (*(left_keys_[i]) != *(node.left_keys_[i])) return false;
+  }
+  for (size_t i = 0; i < right_keys_.size(); i++) {
+    if (*(right_keys_[i]) != *(node.right_keys_[i])) return false;
+  }
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// InnerMergeJoin
+//===--------------------------------------------------------------------===//
+BaseOperatorNode *InnerMergeJoin::Copy() const { return new InnerMergeJoin(*this); }
+
+Operator InnerMergeJoin::Make(std::vector<AnnotatedExpression> &&join_predicates,
+                              std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_keys,
+                              std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_keys) {
+  auto join = std::make_unique<InnerMergeJoin>();
+  join->join_predicates_ = std::move(join_predicates);
+  join->left_keys_ = std::move(left_keys);
+  join->right_keys_ = std::move(right_keys);
+  return Operator(std::move(join));
+}
+
+common::hash_t InnerMergeJoin::Hash() const {
+  common::hash_t hash = BaseOperatorNode::Hash();
+  for (auto &expr : left_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &expr : right_keys_) hash = common::HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &pred : join_predicates_) {
+    auto expr = pred.GetExpr();
+    if (expr)
+      hash = common::HashUtil::SumHashes(hash, expr->Hash());
+    else
+      hash = common::HashUtil::SumHashes(hash, BaseOperatorNode::Hash());
+  }
+  return hash;
+}
+
+bool InnerMergeJoin::operator==(const BaseOperatorNode &r) {
+  if (r.GetType() != OpType::INNERMERGEJOIN) return false;
+  const InnerMergeJoin &node = *static_cast<const InnerMergeJoin *>(&r);
+  if (left_keys_.size() != node.left_keys_.size() || right_keys_.size() != node.right_keys_.size() ||
+      join_predicates_.size() != node.join_predicates_.size())
+    return false;
+  if (join_predicates_ != node.join_predicates_) return false;
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    if (*(left_keys_[i]) != *(node.left_keys_[i])) return false;
+  }
+  for (size_t i = 0; i < right_keys_.size(); i++) {
+    if (*(right_keys_[i]) != *(node.right_keys_[i])) return false;
+  }
+  return true;
 }
 
 //===--------------------------------------------------------------------===//
@@ -1263,6 +1424,10 @@ const char *OperatorNode<RightHashJoin>::name = "RightHashJoin";
 template <>
 const char *OperatorNode<OuterHashJoin>::name = "OuterHashJoin";
 template <>
+const char *OperatorNode<SemiHashJoin>::name = "SemiHashJoin";
+template <>
+const char *OperatorNode<InnerMergeJoin>::name = "InnerMergeJoin";
+template <>
 const char *OperatorNode<Insert>::name = "Insert";
 template <>
 const char *OperatorNode<InsertSelect>::name = "InsertSelect";
@@ -1337,6 +1502,10 @@ OpType OperatorNode<RightHashJoin>::type = OpType::RIGHTHASHJOIN;
 template <>
 OpType OperatorNode<OuterHashJoin>::type = OpType::OUTERHASHJOIN;
 template <>
+OpType OperatorNode<SemiHashJoin>::type = OpType::SEMIHASHJOIN;
+template <>
+OpType OperatorNode<InnerMergeJoin>::type = OpType::INNERMERGEJOIN;
+template <>
 OpType OperatorNode<Insert>::type = OpType::INSERT;
 template <>
 OpType OperatorNode<InsertSelect>::type = OpType::INSERTSELECT;
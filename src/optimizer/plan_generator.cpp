@@ -1,6 +1,7 @@
 #include "optimizer/plan_generator.h"
 
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -9,11 +10,13 @@
 
 #include "catalog/catalog_accessor.h"
 #include "common/exception.h"
+#include "optimizer/index_util.h"
 #include "optimizer/operator_expression.h"
 #include "optimizer/properties.h"
 #include "optimizer/property_set.h"
 #include "optimizer/util.h"
 #include "parser/expression/abstract_expression.h"
+#include "parser/expression/comparison_expression.h"
 #include "parser/expression/constant_value_expression.h"
 #include "parser/expression_util.h"
 #include "planner/plannodes/aggregate_plan_node.h"
@@ -37,6 +40,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/projection_plan_node.h"
@@ -212,17 +216,66 @@ void PlanGenerator::Visit(const IndexScan *op) {
 
   auto index_desc = planner::IndexScanDescription(std::move(tuple_oids), std::move(expr_list), std::move(value_list));
 
-  output_plan_ = planner::IndexScanPlanNode::Builder()
-                     .SetOutputSchema(std::move(output_schema))
-                     .SetScanPredicate(common::ManagedPointer(predicate))
-                     .SetIsForUpdateFlag(op->GetIsForUpdate())
-                     .SetDatabaseOid(op->GetDatabaseOID())
-                     .SetNamespaceOid(op->GetNamespaceOID())
-                     .SetIndexOid(op->GetIndexOID())
-                     .SetTableOid(tbl_oid)
-                     .SetColumnOids(std::move(column_ids))
-                     .SetIndexScanDescription(std::move(index_desc))
-                     .Build();
+  // When the index keys hold every column the scan outputs or filters on, the tuples need not be fetched from the
+  // table. Scans for updates still fetch them, since their parents modify the tuples in place.
+  std::set<catalog::col_oid_t> scanned_cols(column_ids.begin(), column_ids.end());
+  if (predicate != nullptr) parser::ExpressionUtil::GetColumnOids(&scanned_cols, common::ManagedPointer(predicate));
+  bool index_only = !op->GetIsForUpdate() &&
+                    IndexUtil::CoversColumnsWithIndex(accessor_, tbl_oid, op->GetIndexOID(), scanned_cols);
+
+  planner::IndexScanPlanNode::Builder builder;
+  builder.SetOutputSchema(std::move(output_schema))
+      .SetScanPredicate(common::ManagedPointer(predicate))
+      .SetIsForUpdateFlag(op->GetIsForUpdate())
+      .SetDatabaseOid(op->GetDatabaseOID())
+      .SetNamespaceOid(op->GetNamespaceOID())
+      .SetIndexOid(op->GetIndexOID())
+      .SetTableOid(tbl_oid)
+      .SetColumnOids(std::move(column_ids))
+      .SetIndexScanDescription(std::move(index_desc))
+      .SetIndexOnly(index_only);
+
+  // Only read the key ranges that the predicates select. A single point on the whole key is an exact lookup, and
+  // several ranges (from disjunctions of equalities) are probed in key order by one scan.
+  std::vector<IndexKeyBounds> key_ranges;
+  if (IndexUtil::DeriveKeyRanges(accessor_, tbl_oid, op->GetIndexOID(), op->GetPredicates(), &key_ranges)) {
+    const auto &index_schema = accessor_->GetIndexSchema(op->GetIndexOID());
+    const auto num_key_cols = static_cast<uint32_t>(index_schema.GetColumns().size());
+    // Copy the bounds into the plan, and make the values of the open bounds
+    const auto make_bounds = [&](const IndexKeyBounds &range, const bool is_low) {
+      std::unordered_map<catalog::indexkeycol_oid_t, planner::IndexExpression> bounds;
+      for (uint32_t idx = 0; idx < num_key_cols; idx++) {
+        const auto &column = index_schema.GetColumn(idx);
+        const auto bound = is_low ? range.first[idx] : range.second[idx];
+        const bool is_unbounded = range.first[idx] == nullptr && range.second[idx] == nullptr;
+        auto *value = bound != nullptr ? bound->Copy().release()
+                                       : IndexUtil::MakeOpenBound(column, is_low, is_unbounded).release();
+        RegisterPointerCleanup<parser::AbstractExpression>(value, true, true);
+        bounds.emplace(column.Oid(), planner::IndexExpression(value));
+      }
+      return bounds;
+    };
+
+    const auto &range = key_ranges[0];
+    bool is_point = key_ranges.size() == 1;
+    for (uint32_t idx = 0; idx < num_key_cols; idx++) {
+      is_point = is_point && range.first[idx] != nullptr && range.first[idx] == range.second[idx];
+    }
+    if (is_point) {
+      builder.SetScanType(planner::IndexScanType::Exact);
+      for (auto &bound : make_bounds(range, true)) builder.AddIndexColumn(bound.first, bound.second);
+    } else if (key_ranges.size() == 1) {
+      builder.SetScanType(planner::IndexScanType::Ascending);
+      for (auto &bound : make_bounds(range, true)) builder.AddLoIndexColumn(bound.first, bound.second);
+      for (auto &bound : make_bounds(range, false)) builder.AddHiIndexColumn(bound.first, bound.second);
+    } else {
+      builder.SetScanType(planner::IndexScanType::AscendingRanges);
+      for (const auto &key_range : key_ranges) {
+        builder.AddKeyRange(make_bounds(key_range, true), make_bounds(key_range, false));
+      }
+    }
+  }
+  output_plan_ = builder.Build();
 }
 
 void PlanGenerator::Visit(const ExternalFileScan *op) {
@@ -494,28 +547,54 @@ void PlanGenerator::Visit(UNUSED_ATTRIBUTE const OuterNLJoin *op) { TERRIER_ASSE
 // A hashjoin B (what you should do for large relations.....)
 ///////////////////////////////////////////////////////////////////////////////
 
-void PlanGenerator::Visit(const InnerHashJoin *op) {
+void PlanGenerator::BuildHashJoinPlan(
+    planner::LogicalJoinType join_type, const std::vector<AnnotatedExpression> &join_predicates,
+    const std::vector<common::ManagedPointer<parser::AbstractExpression>> &left_keys,
+    const std::vector<common::ManagedPointer<parser::AbstractExpression>> &right_keys) {
   auto proj_schema = GenerateProjectionForJoin();
 
-  auto comb_pred = parser::ExpressionUtil::JoinAnnotatedExprs(op->GetJoinPredicates());
-  auto eval_pred =
-      parser::ExpressionUtil::EvaluateExpression(children_expr_map_, common::ManagedPointer(comb_pred.get()));
-  auto join_predicate =
-      parser::ExpressionUtil::ConvertExprCVNodes(common::ManagedPointer(eval_pred.get()), children_expr_map_).release();
-  RegisterPointerCleanup<parser::AbstractExpression>(join_predicate, true, true);
-
   auto builder = planner::HashJoinPlanNode::Builder();
   builder.SetOutputSchema(std::move(proj_schema));
+  builder.SetJoinType(join_type);
+
+  // The hash keys only narrow the matches down to tuples with equal hashes, so the IN predicates of unnested
+  // subqueries are checked as the equalities they are. This also keeps NULLs from matching.
+  std::vector<AnnotatedExpression> residual_predicates;
+  std::vector<std::unique_ptr<parser::AbstractExpression>> in_equalities;
+  for (auto &pred : join_predicates) {
+    if (pred.GetExpr()->GetExpressionType() != parser::ExpressionType::COMPARE_IN) {
+      residual_predicates.push_back(pred);
+      continue;
+    }
+    std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+    children.emplace_back(pred.GetExpr()->GetChild(0)->Copy());
+    children.emplace_back(pred.GetExpr()->GetChild(1)->Copy());
+    in_equalities.emplace_back(
+        std::make_unique<parser::ComparisonExpression>(parser::ExpressionType::COMPARE_EQUAL, std::move(children)));
+    auto aliases = pred.GetTableAliasSet();
+    residual_predicates.emplace_back(common::ManagedPointer(in_equalities.back()), std::move(aliases));
+  }
+
+  if (!residual_predicates.empty()) {
+    auto comb_pred = parser::ExpressionUtil::JoinAnnotatedExprs(residual_predicates);
+    auto eval_pred =
+        parser::ExpressionUtil::EvaluateExpression(children_expr_map_, common::ManagedPointer(comb_pred.get()));
+    auto join_predicate =
+        parser::ExpressionUtil::ConvertExprCVNodes(common::ManagedPointer(eval_pred.get()), children_expr_map_)
+            .release();
+    RegisterPointerCleanup<parser::AbstractExpression>(join_predicate, true, true);
+    builder.SetJoinPredicate(common::ManagedPointer(join_predicate));
+  }
 
   std::vector<ExprMap> l_child_map{std::move(children_expr_map_[0])};
   std::vector<ExprMap> r_child_map{std::move(children_expr_map_[1])};
-  for (auto &expr : op->GetLeftKeys()) {
+  for (auto &expr : left_keys) {
     auto left_key = parser::ExpressionUtil::EvaluateExpression(l_child_map, expr).release();
     RegisterPointerCleanup<parser::AbstractExpression>(left_key, true, true);
     builder.AddLeftHashKey(common::ManagedPointer(left_key));
   }
 
-  for (auto &expr : op->GetRightKeys()) {
+  for (auto &expr : right_keys) {
     auto right_key = parser::ExpressionUtil::EvaluateExpression(r_child_map, expr).release();
     RegisterPointerCleanup<parser::AbstractExpression>(right_key, true, true);
     builder.AddRightHashKey(common::ManagedPointer(right_key));
@@ -526,16 +605,60 @@ void PlanGenerator::Visit(const InnerHashJoin *op) {
   output_plan_ = builder.Build();
 }
 
-void PlanGenerator::Visit(UNUSED_ATTRIBUTE const LeftHashJoin *op) {
-  TERRIER_ASSERT(0, "LeftHashJoin not implemented");
+void PlanGenerator::Visit(const InnerHashJoin *op) {
+  BuildHashJoinPlan(planner::LogicalJoinType::INNER, op->GetJoinPredicates(), op->GetLeftKeys(), op->GetRightKeys());
+}
+
+void PlanGenerator::Visit(const LeftHashJoin *op) {
+  BuildHashJoinPlan(planner::LogicalJoinType::LEFT, op->GetJoinPredicates(), op->GetLeftKeys(), op->GetRightKeys());
+}
+
+void PlanGenerator::Visit(const RightHashJoin *op) {
+  BuildHashJoinPlan(planner::LogicalJoinType::RIGHT, op->GetJoinPredicates(), op->GetLeftKeys(), op->GetRightKeys());
 }
 
-void PlanGenerator::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) {
-  TERRIER_ASSERT(0, "RightHashJoin not implemented");
+void PlanGenerator::Visit(const OuterHashJoin *op) {
+  BuildHashJoinPlan(planner::LogicalJoinType::OUTER, op->GetJoinPredicates(), op->GetLeftKeys(), op->GetRightKeys());
 }
 
-void PlanGenerator::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) {
-  TERRIER_ASSERT(0, "OuterHashJoin not implemented");
+void PlanGenerator::Visit(const SemiHashJoin *op) {
+  BuildHashJoinPlan(planner::LogicalJoinType::SEMI, op->GetJoinPredicates(), op->GetLeftKeys(), op->GetRightKeys());
+}
+
+void PlanGenerator::Visit(const InnerMergeJoin *op) {
+  auto proj_schema = GenerateProjectionForJoin();
+
+  auto builder = planner::MergeJoinPlanNode::Builder();
+  builder.SetOutputSchema(std::move(proj_schema));
+  builder.SetJoinType(planner::LogicalJoinType::INNER);
+
+  if (!op->GetJoinPredicates().empty()) {
+    auto comb_pred = parser::ExpressionUtil::JoinAnnotatedExprs(op->GetJoinPredicates());
+    auto eval_pred =
+        parser::ExpressionUtil::EvaluateExpression(children_expr_map_, common::ManagedPointer(comb_pred.get()));
+    auto join_predicate =
+        parser::ExpressionUtil::ConvertExprCVNodes(common::ManagedPointer(eval_pred.get()), children_expr_map_)
+            .release();
+    RegisterPointerCleanup<parser::AbstractExpression>(join_predicate, true, true);
+    builder.SetJoinPredicate(common::ManagedPointer(join_predicate));
+  }
+
+  // The keys are evaluated against both children, so that the right keys read the right child's output
+  for (auto &expr : op->GetLeftKeys()) {
+    auto left_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
+    RegisterPointerCleanup<parser::AbstractExpression>(left_key, true, true);
+    builder.AddLeftMergeKey(common::ManagedPointer(left_key));
+  }
+
+  for (auto &expr : op->GetRightKeys()) {
+    auto right_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
+    RegisterPointerCleanup<parser::AbstractExpression>(right_key, true, true);
+    builder.AddRightMergeKey(common::ManagedPointer(right_key));
+  }
+
+  builder.AddChild(std::move(children_plans_[0]));
+  builder.AddChild(std::move(children_plans_[1]));
+  output_plan_ = builder.Build();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -617,7 +740,7 @@ void PlanGenerator::Visit(const HashGroupBy *op) {
 }
 
 void PlanGenerator::Visit(const SortGroupBy *op) {
-  // Don't think this is ever visited since rule_impls.cpp does not create SortGroupBy
+  // The child provides tuples sorted on the group by columns
   auto having_predicates = parser::ExpressionUtil::JoinAnnotatedExprs(op->GetHaving());
   BuildAggregatePlan(planner::AggregateStrategyType::SORTED, &op->GetColumns(),
                      common::ManagedPointer(having_predicates.get()));
@@ -155,7 +155,7 @@ void LogicalGetToPhysicalIndexScan::Transform(common::ManagedPointer<OperatorExp
         auto result = std::make_unique<OperatorExpression>(
             IndexScan::Make(db_oid, ns_oid, index, std::move(preds), std::move(tbl_alias), is_update,
                             std::move(output.GetPredicateColumnIds()), std::move(output.GetPredicateExprTypes()),
-                            std::move(output.GetPredicateValues())),
+                            std::move(output.GetPredicateValues()), std::move(output.GetPredicateNumValues())),
             std::move(c));
         transformed->emplace_back(std::move(result));
       }
@@ -408,6 +408,42 @@ void LogicalGroupByToPhysicalHashGroupBy::Transform(common::ManagedPointer<Opera
   transformed->emplace_back(std::move(result));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalAggregateAndGroupByToSortGroupBy
+///////////////////////////////////////////////////////////////////////////////
+LogicalGroupByToPhysicalSortGroupBy::LogicalGroupByToPhysicalSortGroupBy() {
+  type_ = RuleType::AGGREGATE_TO_SORT_AGGREGATE;
+  match_pattern_ = new Pattern(OpType::LOGICALAGGREGATEANDGROUPBY);
+
+  auto child = new Pattern(OpType::LEAF);
+  match_pattern_->AddChild(child);
+}
+
+bool LogicalGroupByToPhysicalSortGroupBy::Check(common::ManagedPointer<OperatorExpression> plan,
+                                                OptimizationContext *context) const {
+  (void)context;
+  const auto agg_op = plan->GetOp().As<LogicalAggregateAndGroupBy>();
+  return !agg_op->GetColumns().empty();
+}
+
+void LogicalGroupByToPhysicalSortGroupBy::Transform(common::ManagedPointer<OperatorExpression> input,
+                                                    std::vector<std::unique_ptr<OperatorExpression>> *transformed,
+                                                    UNUSED_ATTRIBUTE OptimizationContext *context) const {
+  const auto agg_op = input->GetOp().As<LogicalAggregateAndGroupBy>();
+  TERRIER_ASSERT(input->GetChildren().size() == 1, "LogicalAggregateAndGroupBy should have 1 child");
+
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> cols = agg_op->GetColumns();
+  std::vector<AnnotatedExpression> having = agg_op->GetHaving();
+
+  std::vector<std::unique_ptr<OperatorExpression>> c;
+  auto child = input->GetChildren()[0]->Copy();
+  c.emplace_back(std::move(child));
+
+  auto result =
+      std::make_unique<OperatorExpression>(SortGroupBy::Make(std::move(cols), std::move(having)), std::move(c));
+  transformed->emplace_back(std::move(result));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LogicalAggregateToPhysicalAggregate
 ///////////////////////////////////////////////////////////////////////////////
@@ -544,6 +580,164 @@ void LogicalInnerJoinToPhysicalInnerHashJoin::Transform(common::ManagedPointer<O
   }
 }
 
+namespace {
+
+/**
+ * Implement a logical join as a physical join of the same type that matches tuples on equi-join keys: outer and semi
+ * joins as hash joins, and inner joins as merge joins. Such joins are only implemented when their predicates contain
+ * equi-join keys.
+ */
+template <typename LogicalJoin, typename PhysicalJoin>
+void TransformToEquiJoin(common::ManagedPointer<OperatorExpression> input,
+                         std::vector<std::unique_ptr<OperatorExpression>> *transformed,
+                         OptimizationContext *context) {
+  const auto join = input->GetOp().As<LogicalJoin>();
+
+  auto children = input->GetChildren();
+  TERRIER_ASSERT(children.size() == 2, "Join should have two child");
+  auto left_group_id = children[0]->GetOp().As<LeafOperator>()->GetOriginGroup();
+  auto right_group_id = children[1]->GetOp().As<LeafOperator>()->GetOriginGroup();
+  auto &left_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(left_group_id)->GetTableAliases();
+  auto &right_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(right_group_id)->GetTableAliases();
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys;
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
+
+  std::vector<AnnotatedExpression> join_preds = join->GetJoinPredicates();
+  OptimizerUtil::ExtractEquiJoinKeys(join_preds, &left_keys, &right_keys, left_group_alias, right_group_alias);
+
+  TERRIER_ASSERT(right_keys.size() == left_keys.size(), "# left/right keys should equal");
+  if (left_keys.empty()) return;
+
+  std::vector<std::unique_ptr<OperatorExpression>> child;
+  child.emplace_back(children[0]->Copy());
+  child.emplace_back(children[1]->Copy());
+  auto result = std::make_unique<OperatorExpression>(
+      PhysicalJoin::Make(std::move(join_preds), std::move(left_keys), std::move(right_keys)), std::move(child));
+  transformed->emplace_back(std::move(result));
+}
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalLeftJoinToPhysicalLeftHashJoin
+///////////////////////////////////////////////////////////////////////////////
+LogicalLeftJoinToPhysicalLeftHashJoin::LogicalLeftJoinToPhysicalLeftHashJoin() {
+  type_ = RuleType::LEFT_JOIN_TO_HASH_JOIN;
+
+  match_pattern_ = new Pattern(OpType::LOGICALLEFTJOIN);
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+}
+
+bool LogicalLeftJoinToPhysicalLeftHashJoin::Check(common::ManagedPointer<OperatorExpression> plan,
+                                                  OptimizationContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+void LogicalLeftJoinToPhysicalLeftHashJoin::Transform(common::ManagedPointer<OperatorExpression> input,
+                                                      std::vector<std::unique_ptr<OperatorExpression>> *transformed,
+                                                      OptimizationContext *context) const {
+  TransformToEquiJoin<LogicalLeftJoin, LeftHashJoin>(input, transformed, context);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalRightJoinToPhysicalRightHashJoin
+///////////////////////////////////////////////////////////////////////////////
+LogicalRightJoinToPhysicalRightHashJoin::LogicalRightJoinToPhysicalRightHashJoin() {
+  type_ = RuleType::RIGHT_JOIN_TO_HASH_JOIN;
+
+  match_pattern_ = new Pattern(OpType::LOGICALRIGHTJOIN);
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+}
+
+bool LogicalRightJoinToPhysicalRightHashJoin::Check(common::ManagedPointer<OperatorExpression> plan,
+                                                    OptimizationContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+void LogicalRightJoinToPhysicalRightHashJoin::Transform(common::ManagedPointer<OperatorExpression> input,
+                                                        std::vector<std::unique_ptr<OperatorExpression>> *transformed,
+                                                        OptimizationContext *context) const {
+  TransformToEquiJoin<LogicalRightJoin, RightHashJoin>(input, transformed, context);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalOuterJoinToPhysicalOuterHashJoin
+///////////////////////////////////////////////////////////////////////////////
+LogicalOuterJoinToPhysicalOuterHashJoin::LogicalOuterJoinToPhysicalOuterHashJoin() {
+  type_ = RuleType::OUTER_JOIN_TO_HASH_JOIN;
+
+  match_pattern_ = new Pattern(OpType::LOGICALOUTERJOIN);
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+}
+
+bool LogicalOuterJoinToPhysicalOuterHashJoin::Check(common::ManagedPointer<OperatorExpression> plan,
+                                                    OptimizationContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+void LogicalOuterJoinToPhysicalOuterHashJoin::Transform(common::ManagedPointer<OperatorExpression> input,
+                                                        std::vector<std::unique_ptr<OperatorExpression>> *transformed,
+                                                        OptimizationContext *context) const {
+  TransformToEquiJoin<LogicalOuterJoin, OuterHashJoin>(input, transformed, context);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalSemiJoinToPhysicalSemiHashJoin
+///////////////////////////////////////////////////////////////////////////////
+LogicalSemiJoinToPhysicalSemiHashJoin::LogicalSemiJoinToPhysicalSemiHashJoin() {
+  type_ = RuleType::SEMI_JOIN_TO_HASH_JOIN;
+
+  match_pattern_ = new Pattern(OpType::LOGICALSEMIJOIN);
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+}
+
+bool LogicalSemiJoinToPhysicalSemiHashJoin::Check(common::ManagedPointer<OperatorExpression> plan,
+                                                  OptimizationContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+void LogicalSemiJoinToPhysicalSemiHashJoin::Transform(common::ManagedPointer<OperatorExpression> input,
+                                                      std::vector<std::unique_ptr<OperatorExpression>> *transformed,
+                                                      OptimizationContext *context) const {
+  TransformToEquiJoin<LogicalSemiJoin, SemiHashJoin>(input, transformed, context);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalInnerJoinToPhysicalInnerMergeJoin
+///////////////////////////////////////////////////////////////////////////////
+LogicalInnerJoinToPhysicalInnerMergeJoin::LogicalInnerJoinToPhysicalInnerMergeJoin() {
+  type_ = RuleType::INNER_JOIN_TO_MERGE_JOIN;
+
+  match_pattern_ = new Pattern(OpType::LOGICALINNERJOIN);
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+  match_pattern_->AddChild(new Pattern(OpType::LEAF));
+}
+
+bool LogicalInnerJoinToPhysicalInnerMergeJoin::Check(common::ManagedPointer<OperatorExpression> plan,
+                                                     OptimizationContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+void LogicalInnerJoinToPhysicalInnerMergeJoin::Transform(common::ManagedPointer<OperatorExpression> input,
+                                                         std::vector<std::unique_ptr<OperatorExpression>> *transformed,
+                                                         OptimizationContext *context) const {
+  TransformToEquiJoin<LogicalInnerJoin, InnerMergeJoin>(input, transformed, context);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LogicalLimitToPhysicalLimit
 ///////////////////////////////////////////////////////////////////////////////
@@ -60,6 +60,123 @@ void UnnestMarkJoinToInnerJoin::Transform(common::ManagedPointer<OperatorExpress
   transformed->emplace_back(std::move(output));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// UnnestMarkJoinToSemiJoin
+///////////////////////////////////////////////////////////////////////////////
+UnnestMarkJoinToSemiJoin::UnnestMarkJoinToSemiJoin() {
+  type_ = RuleType::MARK_JOIN_FILTER_TO_SEMI_JOIN;
+
+  auto mark_join = new Pattern(OpType::LOGICALMARKJOIN);
+  mark_join->AddChild(new Pattern(OpType::LEAF));
+  mark_join->AddChild(new Pattern(OpType::LEAF));
+  match_pattern_ = new Pattern(OpType::LOGICALFILTER);
+  match_pattern_->AddChild(mark_join);
+}
+
+RulePromise UnnestMarkJoinToSemiJoin::Promise(GroupExpression *group_expr) const {
+  return RulePromise::UNNEST_PROMISE_HIGH;
+}
+
+bool UnnestMarkJoinToSemiJoin::Check(common::ManagedPointer<OperatorExpression> plan,
+                                     OptimizationContext *context) const {
+  (void)context;
+  (void)plan;
+
+  UNUSED_ATTRIBUTE auto children = plan->GetChildren();
+  TERRIER_ASSERT(children.size() == 1, "LogicalFilter should have 1 child");
+  TERRIER_ASSERT(children[0]->GetChildren().size() == 2, "LogicalMarkJoin should have 2 children");
+  return true;
+}
+
+void UnnestMarkJoinToSemiJoin::Transform(common::ManagedPointer<OperatorExpression> input,
+                                         std::vector<std::unique_ptr<OperatorExpression>> *transformed,
+                                         OptimizationContext *context) const {
+  OPTIMIZER_LOG_TRACE("UnnestMarkJoinToSemiJoin::Transform");
+  auto &memo = context->GetOptimizerContext()->GetMemo();
+  auto mark_join_expr = input->GetChildren()[0];
+  UNUSED_ATTRIBUTE auto mark_join = mark_join_expr->GetOp().As<LogicalMarkJoin>();
+  TERRIER_ASSERT(mark_join->GetJoinPredicates().empty(), "MarkJoin should have 0 predicates");
+
+  auto join_children = mark_join_expr->GetChildren();
+  auto left_group_id = join_children[0]->GetOp().As<LeafOperator>()->GetOriginGroup();
+  auto right_group_id = join_children[1]->GetOp().As<LeafOperator>()->GetOriginGroup();
+  const auto &left_aliases = memo.GetGroupByID(left_group_id)->GetTableAliases();
+  const auto &right_aliases = memo.GetGroupByID(right_group_id)->GetTableAliases();
+
+  // Split the filter into the predicates on the outer query, which stay in the filter, and the IN or EXISTS
+  // predicates on the subquery output
+  std::vector<AnnotatedExpression> filter_predicates;
+  std::vector<AnnotatedExpression> semi_predicates;
+  bool has_subquery_predicate = false;
+  for (auto &predicate : input->GetOp().As<LogicalFilter>()->GetPredicates()) {
+    const auto &aliases = predicate.GetTableAliasSet();
+    auto expr_type = predicate.GetExpr()->GetExpressionType();
+    if (expr_type == parser::ExpressionType::OPERATOR_IS_NOT_NULL && OptimizerUtil::IsSubset(right_aliases, aliases)) {
+      // (EXISTS (SELECT b ...)) was rewritten to (b IS NOT NULL). Any tuple of the subquery satisfies EXISTS, even
+      // one where b is NULL.
+      has_subquery_predicate = true;
+    } else if (OptimizerUtil::IsSubset(left_aliases, aliases)) {
+      filter_predicates.emplace_back(predicate);
+    } else if (expr_type == parser::ExpressionType::COMPARE_IN) {
+      // (a IN (SELECT b ...)) was rewritten to (a IN b), which joins a with b
+      semi_predicates.emplace_back(predicate);
+      has_subquery_predicate = true;
+    } else {
+      // The predicate reads the output of the subquery, which a semi join does not produce
+      return;
+    }
+  }
+  if (!has_subquery_predicate) return;
+
+  // The correlated predicates of the subquery join it with the outer query
+  auto right_child = join_children[1]->Copy();
+  auto right_group_expr = memo.GetGroupByID(right_group_id)->GetLogicalExpression();
+  if (right_group_expr->Op().GetType() == OpType::LOGICALFILTER) {
+    std::vector<AnnotatedExpression> subquery_predicates;
+    for (auto &predicate : right_group_expr->Op().As<LogicalFilter>()->GetPredicates()) {
+      if (OptimizerUtil::IsSubset(right_aliases, predicate.GetTableAliasSet())) {
+        subquery_predicates.emplace_back(predicate);
+      } else {
+        semi_predicates.emplace_back(predicate);
+      }
+    }
+
+    if (subquery_predicates.size() != right_group_expr->Op().As<LogicalFilter>()->GetPredicates().size()) {
+      right_child = std::make_unique<OperatorExpression>(LeafOperator::Make(right_group_expr->GetChildGroupId(0)),
+                                                         std::vector<std::unique_ptr<OperatorExpression>>{});
+      if (!subquery_predicates.empty()) {
+        std::vector<std::unique_ptr<OperatorExpression>> c;
+        c.emplace_back(std::move(right_child));
+        right_child =
+            std::make_unique<OperatorExpression>(LogicalFilter::Make(std::move(subquery_predicates)), std::move(c));
+      }
+    }
+  }
+
+  // Predicates correlated with queries further out cannot be evaluated by the join, and semi joins are only
+  // implemented as hash joins
+  std::unordered_set<std::string> join_aliases(left_aliases);
+  join_aliases.insert(right_aliases.begin(), right_aliases.end());
+  for (auto &predicate : semi_predicates) {
+    if (!OptimizerUtil::IsSubset(join_aliases, predicate.GetTableAliasSet())) return;
+  }
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys;
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
+  OptimizerUtil::ExtractEquiJoinKeys(semi_predicates, &left_keys, &right_keys, left_aliases, right_aliases);
+  if (left_keys.empty()) return;
+
+  std::vector<std::unique_ptr<OperatorExpression>> c;
+  c.emplace_back(join_children[0]->Copy());
+  c.emplace_back(std::move(right_child));
+  auto output = std::make_unique<OperatorExpression>(LogicalSemiJoin::Make(std::move(semi_predicates)), std::move(c));
+  if (!filter_predicates.empty()) {
+    std::vector<std::unique_ptr<OperatorExpression>> cc;
+    cc.emplace_back(std::move(output));
+    output = std::make_unique<OperatorExpression>(LogicalFilter::Make(std::move(filter_predicates)), std::move(cc));
+  }
+  transformed->emplace_back(std::move(output));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// SingleJoinGetToInnerJoin
 ///////////////////////////////////////////////////////////////////////////////
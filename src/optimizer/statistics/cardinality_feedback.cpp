@@ -0,0 +1,49 @@
+#include "optimizer/statistics/cardinality_feedback.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "loggers/optimizer_logger.h"
+
+namespace terrier::optimizer {
+
+bool CardinalityFeedback::IsMisestimate(const int64_t estimated_rows, const uint64_t actual_rows) {
+  if (estimated_rows < 0) return true;
+  // Off by one, so that empty results compare with small estimates
+  const double estimated = static_cast<double>(estimated_rows) + 1.0;
+  const double actual = static_cast<double>(actual_rows) + 1.0;
+  return std::max(estimated, actual) > K_MISESTIMATE_RATIO * std::min(estimated, actual);
+}
+
+bool CardinalityFeedback::RecordRows(const common::hash_t fragment_key, const int64_t estimated_rows,
+                                     const uint64_t actual_rows) {
+  if (fragment_key == 0) return false;
+  const bool misestimate = IsMisestimate(estimated_rows, actual_rows);
+  const auto actual = static_cast<double>(actual_rows);
+
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  auto learned_it = learned_rows_.find(fragment_key);
+  if (learned_it == learned_rows_.end()) {
+    if (learned_rows_.size() >= K_MAX_FRAGMENTS) learned_rows_.erase(learned_rows_.begin());
+    learned_rows_.emplace(fragment_key, actual);
+  } else if (misestimate) {
+    learned_it->second = actual;
+  } else {
+    learned_it->second += K_LEARNING_RATE * (actual - learned_it->second);
+  }
+
+  if (misestimate) {
+    OPTIMIZER_LOG_DEBUG("Fragment {0} produced {1} rows, estimated {2}", fragment_key, actual_rows, estimated_rows);
+  }
+  return misestimate;
+}
+
+int CardinalityFeedback::GetLearnedRows(const common::hash_t fragment_key) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  const auto learned_it = learned_rows_.find(fragment_key);
+  if (learned_it == learned_rows_.end()) return -1;
+  const double max_rows = std::numeric_limits<int>::max();
+  return static_cast<int>(std::min(learned_it->second + 0.5, max_rows));
+}
+
+}  // namespace terrier::optimizer
@@ -0,0 +1,114 @@
+#include "optimizer/statistics/column_summary.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "common/exception.h"
+#include "storage/storage_defs.h"
+#include "type/type_util.h"
+
+namespace terrier::optimizer {
+
+bool ColumnSummary::IsNumeric(const type::TypeId type) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+    case type::TypeId::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+double ColumnSummary::ReadNumeric(const type::TypeId type, const byte *const value) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+      return *reinterpret_cast<const int8_t *>(value);
+    case type::TypeId::SMALLINT:
+      return *reinterpret_cast<const int16_t *>(value);
+    case type::TypeId::INTEGER:
+      return *reinterpret_cast<const int32_t *>(value);
+    case type::TypeId::BIGINT:
+      return static_cast<double>(*reinterpret_cast<const int64_t *>(value));
+    case type::TypeId::DECIMAL:
+      return *reinterpret_cast<const double *>(value);
+    case type::TypeId::TIMESTAMP:
+      return static_cast<double>(*reinterpret_cast<const uint64_t *>(value));
+    default:
+      throw OPTIMIZER_EXCEPTION("Not a numeric type");
+  }
+}
+
+ColumnSummary::ColumnSummary(const ColumnSummary &other)
+    : hashes_(other.hashes_),
+      num_nulls_(other.num_nulls_),
+      num_values_(other.num_values_),
+      min_value_(other.min_value_),
+      max_value_(other.max_value_) {
+  // An empty sketch that took in the other one estimates the same keys
+  if (other.hll_ != nullptr) {
+    hll_ = std::make_unique<HyperLogLog<uint64_t>>(K_HLL_PRECISION);
+    hll_->Merge(*other.hll_);
+  }
+}
+
+void ColumnSummary::Add(const type::TypeId type, const byte *const value) {
+  num_values_++;
+  if (type == type::TypeId::VARCHAR || type == type::TypeId::VARBINARY) {
+    const auto *const entry = reinterpret_cast<const storage::VarlenEntry *>(value);
+    AddHash(XXH3_64bits(entry->Content(), entry->Size()));
+    return;
+  }
+
+  AddHash(XXH3_64bits(value, type::TypeUtil::GetTypeSize(type)));
+  if (IsNumeric(type)) {
+    const double numeric = ReadNumeric(type, value);
+    min_value_ = std::min(min_value_, numeric);
+    max_value_ = std::max(max_value_, numeric);
+  }
+}
+
+void ColumnSummary::AddHash(const uint64_t hash) {
+  if (hll_ != nullptr) {
+    hll_->UpdateHash(hash);
+    return;
+  }
+
+  // The hashes are kept sorted and distinct, so that their count is the cardinality
+  const auto it = std::lower_bound(hashes_.begin(), hashes_.end(), hash);
+  if (it != hashes_.end() && *it == hash) return;
+  hashes_.insert(it, hash);
+  if (hashes_.size() > K_MAX_SPARSE_HASHES) Densify();
+}
+
+void ColumnSummary::Densify() {
+  hll_ = std::make_unique<HyperLogLog<uint64_t>>(K_HLL_PRECISION);
+  for (const uint64_t hash : hashes_) hll_->UpdateHash(hash);
+  hashes_.clear();
+  hashes_.shrink_to_fit();
+}
+
+void ColumnSummary::Merge(const ColumnSummary &other) {
+  if (other.hll_ != nullptr) {
+    if (hll_ == nullptr) Densify();
+    hll_->Merge(*other.hll_);
+  } else {
+    for (const uint64_t hash : other.hashes_) AddHash(hash);
+  }
+  num_nulls_ += other.num_nulls_;
+  num_values_ += other.num_values_;
+  min_value_ = std::min(min_value_, other.min_value_);
+  max_value_ = std::max(max_value_, other.max_value_);
+}
+
+uint64_t ColumnSummary::EstimateCardinality() const {
+  const uint64_t estimate = hll_ == nullptr ? hashes_.size() : hll_->EstimateCardinality();
+  return std::min(estimate, num_values_);
+}
+
+}  // namespace terrier::optimizer
@@ -52,7 +52,10 @@ double Selectivity::LessThan(common::ManagedPointer<TableStats> table_stats, con
   // Use histogram to estimate selectivity
   auto histogram = column_stats->GetHistogramBounds();
   size_t n = histogram.size();
-  TERRIER_ASSERT(n > 0, "Histogram must have some bounds");
+  // A column of only NULLs has no bounds
+  if (n == 0) {
+    return DEFAULT_SELECTIVITY;
+  }
 
   // find correspond bin using binary search
   auto it = std::lower_bound(histogram.begin(), histogram.end(), v);
@@ -9,6 +9,7 @@
 #include "catalog/catalog_accessor.h"
 #include "optimizer/memo.h"
 #include "optimizer/optimizer_context.h"
+#include "optimizer/statistics/cardinality_feedback.h"
 #include "optimizer/statistics/column_stats.h"
 #include "optimizer/statistics/selectivity.h"
 #include "optimizer/statistics/stats_calculator.h"
@@ -25,9 +26,34 @@ void StatsCalculator::CalculateStats(GroupExpression *gexpr, ExprSet required_co
   gexpr_ = gexpr;
   required_cols_ = std::move(required_cols);
   context_ = context;
+
+  // The first logical expression of a group keys it, which is the one the query was written as
+  auto group = context_->GetMemo().GetGroupByID(gexpr->GetGroupID());
+  if (group->GetFragmentKey() == 0) {
+    group->SetFragmentKey(ComputeFragmentKey());
+  }
+
   gexpr->Op().Accept(common::ManagedPointer<OperatorVisitor>(this));
 }
 
+common::hash_t StatsCalculator::ComputeFragmentKey() {
+  // The children are summed, so that commuted joins get the same key
+  common::hash_t children_key = 0;
+  for (const auto child_group_id : gexpr_->GetChildGroupIDs()) {
+    const common::hash_t child_key = context_->GetMemo().GetGroupByID(child_group_id)->GetFragmentKey();
+    if (child_key == 0) return 0;
+    children_key = common::HashUtil::SumHashes(children_key, child_key);
+  }
+  return common::HashUtil::CombineHashes(gexpr_->Op().Hash(), children_key);
+}
+
+int StatsCalculator::CorrectNumRows(const int estimated_rows) {
+  const auto fragment_key = context_->GetMemo().GetGroupByID(gexpr_->GetGroupID())->GetFragmentKey();
+  if (fragment_key == 0 || context_->GetStatsStorage() == nullptr) return estimated_rows;
+  const int learned_rows = context_->GetStatsStorage()->GetCardinalityFeedback()->GetLearnedRows(fragment_key);
+  return learned_rows < 0 ? estimated_rows : learned_rows;
+}
+
 void StatsCalculator::Visit(const LogicalGet *op) {
   if (op->GetTableOid() == catalog::INVALID_TABLE_OID) {
     // Dummy scan
@@ -44,6 +70,8 @@ void StatsCalculator::Visit(const LogicalGet *op) {
       auto tv_expr = col.CastManagedPointerTo<parser::ColumnValueExpression>();
       root_group->AddStats(tv_expr->GetFullName(), CreateDefaultStats(tv_expr));
     }
+    // Executions of the scan are the only estimate there is
+    root_group->SetNumRows(CorrectNumRows(root_group->GetNumRows()));
     return;
   }
 
@@ -51,7 +79,7 @@ void StatsCalculator::Visit(const LogicalGet *op) {
   std::unordered_map<std::string, std::unique_ptr<ColumnStats>> required_stats;
   for (auto &col : required_cols_) {
     // Make a copy for required stats since we may want to modify later
-    AddBaseTableStats(col, table_stats, &required_stats);
+    AddBaseTableStats(col, *table_stats, &required_stats);
   }
 
   // Compute selectivity at the first time
@@ -62,16 +90,16 @@ void StatsCalculator::Visit(const LogicalGet *op) {
       auto predicate = annotated_expr.GetExpr();
       parser::ExpressionUtil::GetTupleValueExprs(&expr_set, predicate);
       for (auto &col : expr_set) {
-        AddBaseTableStats(col, table_stats, &predicate_stats);
+        AddBaseTableStats(col, *table_stats, &predicate_stats);
       }
     }
 
     // Use predicates to estimate cardinality. If we were unable to find any column stats from the catalog, default to 0
     if (table_stats->GetColumnCount() == 0) {
-      root_group->SetNumRows(0);
+      root_group->SetNumRows(CorrectNumRows(0));
     } else {
       auto est = EstimateCardinalityForFilter(table_stats->GetNumRows(), predicate_stats, op->GetPredicates());
-      root_group->SetNumRows(static_cast<int>(est));
+      root_group->SetNumRows(CorrectNumRows(static_cast<int>(est)));
     }
   }
 
@@ -120,7 +148,7 @@ void StatsCalculator::Visit(const LogicalInnerJoin *op) {
         }
       }
     }
-    root_group->SetNumRows(static_cast<int>(curr_rows));
+    root_group->SetNumRows(CorrectNumRows(static_cast<int>(curr_rows)));
   }
 
   size_t num_rows = root_group->GetNumRows();
@@ -152,7 +180,7 @@ void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalAggregateAndGroupBy *o
 
   // First, set num rows
   auto child_group = context_->GetMemo().GetGroupByID(gexpr_->GetChildGroupId(0));
-  context_->GetMemo().GetGroupByID(gexpr_->GetGroupID())->SetNumRows(child_group->GetNumRows());
+  context_->GetMemo().GetGroupByID(gexpr_->GetGroupID())->SetNumRows(CorrectNumRows(child_group->GetNumRows()));
   for (auto &col : required_cols_) {
     TERRIER_ASSERT(col->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE, "CVE expected");
     auto col_name = col.CastManagedPointerTo<parser::ColumnValueExpression>()->GetFullName();
@@ -168,7 +196,7 @@ void StatsCalculator::Visit(const LogicalLimit *op) {
   TERRIER_ASSERT(gexpr_->GetChildrenGroupsSize() == 1, "Limit must have 1 child");
   auto child_group = context_->GetMemo().GetGroupByID(gexpr_->GetChildGroupId(0));
   auto group = context_->GetMemo().GetGroupByID(gexpr_->GetGroupID());
-  group->SetNumRows(std::min(static_cast<int>(op->GetLimit()), child_group->GetNumRows()));
+  group->SetNumRows(CorrectNumRows(std::min(static_cast<int>(op->GetLimit()), child_group->GetNumRows())));
   for (auto &col : required_cols_) {
     TERRIER_ASSERT(col->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE, "CVE expected");
     auto col_name = col.CastManagedPointerTo<parser::ColumnValueExpression>()->GetFullName();
@@ -181,16 +209,16 @@ void StatsCalculator::Visit(const LogicalLimit *op) {
 }
 
 void StatsCalculator::AddBaseTableStats(common::ManagedPointer<parser::AbstractExpression> col,
-                                        common::ManagedPointer<TableStats> table_stats,
+                                        const TableStats &table_stats,
                                         std::unordered_map<std::string, std::unique_ptr<ColumnStats>> *stats) {
   TERRIER_ASSERT(col->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE, "Expected ColumnValue");
   auto tv_expr = col.CastManagedPointerTo<parser::ColumnValueExpression>();
-  if (table_stats->GetColumnCount() == 0 || !table_stats->HasColumnStats(tv_expr->GetColumnOid())) {
+  if (table_stats.GetColumnCount() == 0 || !table_stats.HasColumnStats(tv_expr->GetColumnOid())) {
     // We do not have stats for the table yet, use default value
     stats->insert(std::make_pair(tv_expr->GetFullName(), CreateDefaultStats(tv_expr)));
   } else {
     stats->insert(std::make_pair(tv_expr->GetFullName(),
-                                 std::make_unique<ColumnStats>(*table_stats->GetColumnStats(tv_expr->GetColumnOid()))));
+                                 std::make_unique<ColumnStats>(*table_stats.GetColumnStats(tv_expr->GetColumnOid()))));
   }
 }
 
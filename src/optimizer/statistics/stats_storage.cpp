@@ -1,24 +1,30 @@
 #include <memory>
+#include <mutex>  // NOLINT
 #include <utility>
+#include <vector>
 
 #include "loggers/optimizer_logger.h"
 
 #include "optimizer/statistics/stats_storage.h"
 
 namespace terrier::optimizer {
-common::ManagedPointer<TableStats> StatsStorage::GetTableStats(catalog::db_oid_t database_id,
-                                                               catalog::table_oid_t table_id) {
+std::shared_ptr<const TableStats> StatsStorage::GetTableStats(catalog::db_oid_t database_id,
+                                                              catalog::table_oid_t table_id) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
   StatsStorageKey stats_storage_key = std::make_pair(database_id, table_id);
   auto table_it = table_stats_storage_.find(stats_storage_key);
 
   if (table_it != table_stats_storage_.end()) {
-    return common::ManagedPointer<TableStats>(table_it->second);
+    return table_it->second;
   }
-  return common::ManagedPointer<TableStats>(nullptr);
+  return nullptr;
 }
 
 bool StatsStorage::InsertTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
                                     TableStats table_stats) {
+  std::lock_guard<std::mutex> update_guard(update_latch_);
+  auto table_stats_ptr = std::make_shared<const TableStats>(std::move(table_stats));
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
   StatsStorageKey stats_storage_key = std::make_pair(database_id, table_id);
   auto table_it = table_stats_storage_.find(stats_storage_key);
 
@@ -26,12 +32,16 @@ bool StatsStorage::InsertTableStats(catalog::db_oid_t database_id, catalog::tabl
     OPTIMIZER_LOG_TRACE("There already exists a TableStats object with the given oids.")
     return false;
   }
-  std::unique_ptr<TableStats> table_stats_ptr = std::make_unique<TableStats>(std::move(table_stats));
+  // Fresh statistics have no modifications to refresh
+  unanalyzed_modified_rows_.erase(stats_storage_key);
+  stale_tables_.erase(stats_storage_key);
   table_stats_storage_.emplace(stats_storage_key, std::move(table_stats_ptr));
   return true;
 }
 
 bool StatsStorage::DeleteTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id) {
+  std::lock_guard<std::mutex> update_guard(update_latch_);
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
   StatsStorageKey stats_storage_key = std::make_pair(database_id, table_id);
   auto table_it = table_stats_storage_.find(stats_storage_key);
 
@@ -41,4 +51,53 @@ bool StatsStorage::DeleteTableStats(catalog::db_oid_t database_id, catalog::tabl
   }
   return false;
 }
+
+void StatsStorage::ReplaceTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
+                                     TableStats table_stats) {
+  std::lock_guard<std::mutex> update_guard(update_latch_);
+  auto table_stats_ptr = std::make_shared<const TableStats>(std::move(table_stats));
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  StatsStorageKey stats_storage_key = std::make_pair(database_id, table_id);
+  // Fresh statistics have no modifications to refresh
+  unanalyzed_modified_rows_.erase(stats_storage_key);
+  stale_tables_.erase(stats_storage_key);
+  table_stats_storage_[stats_storage_key] = std::move(table_stats_ptr);
+}
+
+void StatsStorage::ApplyTableStatsDelta(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
+                                        const TableStatsDelta &delta) {
+  std::lock_guard<std::mutex> update_guard(update_latch_);
+  StatsStorageKey stats_storage_key = std::make_pair(database_id, table_id);
+  std::shared_ptr<const TableStats> table_stats = GetTableStats(database_id, table_id);
+
+  // Optimizers may be reading the published statistics, so the delta is applied to a copy that replaces them
+  std::shared_ptr<TableStats> updated_stats = nullptr;
+  if (table_stats != nullptr) {
+    updated_stats = std::make_shared<TableStats>(*table_stats);
+    updated_stats->ApplyDelta(delta);
+  }
+
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  size_t num_rows = 0;
+  size_t num_modified_rows;
+  if (updated_stats != nullptr) {
+    num_rows = updated_stats->GetNumRows();
+    num_modified_rows = updated_stats->GetNumModifiedRows();
+    table_stats_storage_[stats_storage_key] = std::move(updated_stats);
+  } else {
+    num_modified_rows = unanalyzed_modified_rows_[stats_storage_key] += delta.GetNumModifiedRows();
+  }
+
+  if (static_cast<double>(num_modified_rows) >
+      static_cast<double>(K_REFRESH_MIN_ROWS) + K_REFRESH_FRACTION * static_cast<double>(num_rows)) {
+    stale_tables_.insert(stats_storage_key);
+  }
+}
+
+std::vector<StatsStorageKey> StatsStorage::TakeStaleTables() {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  std::vector<StatsStorageKey> stale_tables(stale_tables_.begin(), stale_tables_.end());
+  stale_tables_.clear();
+  return stale_tables;
+}
 }  // namespace terrier::optimizer
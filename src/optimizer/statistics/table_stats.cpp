@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -5,9 +6,22 @@
 
 #include "optimizer/statistics/column_stats.h"
 #include "optimizer/statistics/table_stats.h"
+#include "optimizer/statistics/table_stats_delta.h"
 
 namespace terrier::optimizer {
 
+TableStats::TableStats(const TableStats &other)
+    : database_id_(other.database_id_),
+      table_id_(other.table_id_),
+      num_rows_(other.num_rows_),
+      is_base_table_(other.is_base_table_),
+      num_modified_rows_(other.num_modified_rows_),
+      column_summaries_(other.column_summaries_) {
+  for (const auto &[column_id, col_stats] : other.column_stats_) {
+    column_stats_.emplace(column_id, std::make_unique<ColumnStats>(*col_stats));
+  }
+}
+
 void TableStats::UpdateNumRows(size_t new_num_rows) {
   num_rows_ = new_num_rows;
   for (auto &col_to_stats_pair : column_stats_) {
@@ -44,6 +58,38 @@ common::ManagedPointer<ColumnStats> TableStats::GetColumnStats(catalog::col_oid_
   return common::ManagedPointer<ColumnStats>(col_it->second);
 }
 
+common::ManagedPointer<const ColumnStats> TableStats::GetColumnStats(catalog::col_oid_t column_id) const {
+  auto col_it = column_stats_.find(column_id);
+  if (col_it == column_stats_.end()) return nullptr;
+  return common::ManagedPointer<const ColumnStats>(col_it->second.get());
+}
+
+common::ManagedPointer<const ColumnSummary> TableStats::GetColumnSummary(catalog::col_oid_t column_id) const {
+  auto summary_it = column_summaries_.find(column_id);
+  if (summary_it == column_summaries_.end()) return nullptr;
+  return common::ManagedPointer<const ColumnSummary>(&summary_it->second);
+}
+
+void TableStats::ApplyDelta(const TableStatsDelta &delta) {
+  // Deletes of rows that were inserted before the statistics were gathered may outnumber the counted rows
+  const size_t num_inserted = delta.GetNumInserted();
+  const size_t num_deleted = std::min<size_t>(delta.GetNumDeleted(), num_rows_ + num_inserted);
+  UpdateNumRows(num_rows_ + num_inserted - num_deleted);
+  num_modified_rows_ += delta.GetNumModifiedRows();
+
+  for (const auto &[column_id, delta_summary] : delta.GetColumnSummaries()) {
+    auto &summary = column_summaries_[column_id];
+    summary.Merge(delta_summary);
+
+    // A sketch cannot forget the values of deleted rows, so the cardinality only grows until the next ANALYZE
+    auto col_stats = GetColumnStats(column_id);
+    if (col_stats == nullptr) continue;
+    const auto cardinality = static_cast<double>(summary.EstimateCardinality());
+    col_stats->GetCardinality() =
+        std::min(std::max(col_stats->GetCardinality(), cardinality), static_cast<double>(num_rows_));
+  }
+}
+
 bool TableStats::RemoveColumnStats(catalog::col_oid_t column_id) {
   auto col_it = column_stats_.find(column_id);
 
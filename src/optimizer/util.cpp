@@ -16,7 +16,9 @@ void OptimizerUtil::ExtractEquiJoinKeys(const std::vector<AnnotatedExpression> &
                                         const std::unordered_set<std::string> &right_alias) {
   for (auto &expr_unit : join_predicates) {
     auto expr = expr_unit.GetExpr();
-    if (expr->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL) {
+    // An unnested IN subquery compares a column to the output column of the subquery, just like an equality
+    if (expr->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL ||
+        expr->GetExpressionType() == parser::ExpressionType::COMPARE_IN) {
       auto l_expr = expr->GetChild(0);
       auto r_expr = expr->GetChild(1);
       TERRIER_ASSERT(l_expr->GetExpressionType() != parser::ExpressionType::VALUE_TUPLE &&
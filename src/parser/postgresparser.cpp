@@ -398,6 +398,10 @@ std::unique_ptr<AbstractExpression> PostgresParser::AExprTransform(ParseResult *
   ExpressionType target_type;
   std::vector<std::unique_ptr<AbstractExpression>> children;
 
+  if (root->kind_ == AEXPR_IN) {
+    return InListTransform(parse_result, root);
+  }
+
   if (root->kind_ == AEXPR_DISTINCT) {
     target_type = ExpressionType::COMPARE_IS_DISTINCT_FROM;
     children.emplace_back(ExprTransform(parse_result, root->lexpr_, nullptr));
@@ -447,6 +451,34 @@ std::unique_ptr<AbstractExpression> PostgresParser::AExprTransform(ParseResult *
   }
 }
 
+// Postgres.A_Expr (AEXPR_IN) -> terrier.ConjunctionExpression
+std::unique_ptr<AbstractExpression> PostgresParser::InListTransform(ParseResult *parse_result, A_Expr *root) {
+  // (a IN (1, 2)) is rewritten to (a = 1 OR a = 2), and (a NOT IN (1, 2)) to (a <> 1 AND a <> 2). The optimizer scans
+  // such disjunctions of equalities as point lookups in an index on a.
+  auto name = (reinterpret_cast<value *>(root->name_->head->data.ptr_value))->val_.str_;
+  const bool negated = std::string(name) == "<>";
+  const auto compare_type = negated ? ExpressionType::COMPARE_NOT_EQUAL : ExpressionType::COMPARE_EQUAL;
+  const auto conjunction_type = negated ? ExpressionType::CONJUNCTION_AND : ExpressionType::CONJUNCTION_OR;
+
+  std::unique_ptr<AbstractExpression> result;
+  for (auto cell = reinterpret_cast<List *>(root->rexpr_)->head; cell != nullptr; cell = cell->next) {
+    std::vector<std::unique_ptr<AbstractExpression>> children;
+    children.emplace_back(ExprTransform(parse_result, root->lexpr_, nullptr));
+    children.emplace_back(ExprTransform(parse_result, reinterpret_cast<Node *>(cell->data.ptr_value), nullptr));
+    auto comparison = std::make_unique<ComparisonExpression>(compare_type, std::move(children));
+    if (result == nullptr) {
+      result = std::move(comparison);
+      continue;
+    }
+    // Conjunctions are binary
+    std::vector<std::unique_ptr<AbstractExpression>> terms;
+    terms.emplace_back(std::move(result));
+    terms.emplace_back(std::move(comparison));
+    result = std::make_unique<ConjunctionExpression>(conjunction_type, std::move(terms));
+  }
+  return result;
+}
+
 // Postgres.BoolExpr -> terrier.ConjunctionExpression
 std::unique_ptr<AbstractExpression> PostgresParser::BoolExprTransform(ParseResult *parse_result, BoolExpr *root) {
   std::unique_ptr<AbstractExpression> result;
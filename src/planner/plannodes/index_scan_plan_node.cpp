@@ -14,6 +14,7 @@ common::hash_t IndexScanPlanNode::Hash() const {
 
   hash = common::HashUtil::CombineHashInRange(hash, column_oids_.begin(), column_oids_.end());
   hash = common::HashUtil::CombineHashes(hash, index_scan_desc_.Hash());
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(index_only_));
 
   return hash;
 }
@@ -25,6 +26,7 @@ bool IndexScanPlanNode::operator==(const AbstractPlanNode &rhs) const {
 
   if (column_oids_ != other.column_oids_) return false;
   if (index_scan_desc_ != other.index_scan_desc_) return false;
+  if (index_only_ != other.index_only_) return false;
 
   // Index Oid
   return (index_oid_ == other.index_oid_);
@@ -35,6 +37,7 @@ nlohmann::json IndexScanPlanNode::ToJson() const {
   j["index_oid"] = index_oid_;
   j["column_oids"] = column_oids_;
   j["index_scan_desc"] = index_scan_desc_;
+  j["index_only"] = index_only_;
   return j;
 }
 
@@ -45,6 +48,7 @@ std::vector<std::unique_ptr<parser::AbstractExpression>> IndexScanPlanNode::From
   index_oid_ = j.at("index_oid").get<catalog::index_oid_t>();
   column_oids_ = j.at("column_oids").get<std::vector<catalog::col_oid_t>>();
   index_scan_desc_ = j.at("index_scan_desc").get<IndexScanDescription>();
+  index_only_ = j.at("index_only").get<bool>();
   return exprs;
 }
 
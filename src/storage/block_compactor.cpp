@@ -249,6 +249,12 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
       // Only need to count null for non-varlens
       for (uint32_t i = 0; i < metadata.NumRecords(); i++)
         if (!column_bitmap->Test(i)) metadata.NullCount(col_id)++;
+      // Summarize the values of the now read-only column for pruning scans
+      if (!table->zone_map_types_.empty() && table->zone_map_types_[!col_id] != ZoneMapType::NONE) {
+        metadata.GetZoneMap(layout, col_id)
+            .Compute(table->zone_map_types_[!col_id], accessor.ColumnStart(block, col_id), layout.AttrSize(col_id),
+                     column_bitmap, metadata.NumRecords());
+      }
       continue;
     }
 
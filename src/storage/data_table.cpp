@@ -1,6 +1,8 @@
 #include "storage/data_table.h"
 
 #include <list>
+#include <utility>
+#include <vector>
 
 #include "common/allocator.h"
 #include "storage/block_access_controller.h"
@@ -9,8 +11,14 @@
 #include "transaction/transaction_util.h"
 
 namespace terrier::storage {
-DataTable::DataTable(BlockStore *const store, const BlockLayout &layout, const layout_version_t layout_version)
-    : block_store_(store), layout_version_(layout_version), accessor_(layout) {
+DataTable::DataTable(BlockStore *const store, const BlockLayout &layout, const layout_version_t layout_version,
+                     std::vector<ZoneMapType> zone_map_types)
+    : block_store_(store),
+      layout_version_(layout_version),
+      accessor_(layout),
+      zone_map_types_(std::move(zone_map_types)) {
+  TERRIER_ASSERT(zone_map_types_.empty() || zone_map_types_.size() == layout.NumColumns(),
+                 "There must be a zone map type for every column.");
   TERRIER_ASSERT(layout.AttrSize(VERSION_POINTER_COLUMN_ID) == 8,
                  "First column must have size 8 for the version chain.");
   TERRIER_ASSERT(layout.NumColumns() > NUM_RESERVED_COLUMNS,
@@ -40,14 +48,20 @@ bool DataTable::Select(const common::ManagedPointer<transaction::TransactionCont
 }
 
 void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *const start_pos,
-                     ProjectedColumns *const out_buffer) const {
+                     ProjectedColumns *const out_buffer, const ZoneMapFilter *const filter,
+                     const SlotIterator *const stop_pos) const {
   // TODO(Tianyu): So far this is not that much better than tuple-at-a-time access,
   // but can be improved if block is read-only, or if we implement version synopsis, to just use std::memcpy when it's
   // safe
   uint32_t filled = 0;
-  while (filled < out_buffer->MaxTuples() && *start_pos != end()) {
-    ProjectedColumns::RowView row = out_buffer->InterpretAsRow(filled);
+  while (filled < out_buffer->MaxTuples() && *start_pos != end() && (stop_pos == nullptr || *start_pos != *stop_pos)) {
     const TupleSlot slot = **start_pos;
+    // Skip over whole blocks the filter rules out when entering them
+    if (filter != nullptr && slot.GetOffset() == 0 && filter->CanSkip(accessor_, slot.GetBlock())) {
+      SkipBlock(start_pos);
+      continue;
+    }
+    ProjectedColumns::RowView row = out_buffer->InterpretAsRow(filled);
     // Only fill the buffer with valid, visible tuples
     if (SelectIntoBuffer(txn, slot, &row)) {
       out_buffer->TupleSlots()[filled] = slot;
@@ -58,6 +72,45 @@ void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContex
   out_buffer->SetNumTuples(filled);
 }
 
+const ArrowVarlenColumn *DataTable::ReadDictionaryCodes(const ProjectedColumns &columns,
+                                                        const uint16_t projection_list_index,
+                                                        uint32_t *const codes) const {
+  const uint32_t num_tuples = columns.NumTuples();
+  const col_id_t col_id = columns.ColumnIds()[projection_list_index];
+  if (num_tuples == 0 || !accessor_.GetBlockLayout().IsVarlen(col_id)) return nullptr;
+  // Scans visit blocks in order, so the buffer holds a single block if its first and last tuples do
+  const TupleSlot *slots = columns.TupleSlots();
+  RawBlock *const block = slots[0].GetBlock();
+  if (slots[num_tuples - 1].GetBlock() != block) return nullptr;
+
+  // A frozen block holds no versions, so its in-place contents are what every running transaction sees. Holding the
+  // in-place read lock keeps writers from thawing the block while the codes are copied.
+  if (!block->controller_.TryAcquireInPlaceRead()) return nullptr;
+  const ArrowColumnInfo &col_info =
+      accessor_.GetArrowBlockMetadata(block).GetColumnInfo(accessor_.GetBlockLayout(), col_id);
+  const ArrowVarlenColumn *dictionary = nullptr;
+  if (col_info.Type() == ArrowColumnType::DICTIONARY_COMPRESSED) {
+    const uint32_t *indices = col_info.Indices();
+    for (uint32_t i = 0; i < num_tuples; i++) codes[i] = indices[slots[i].GetOffset()];
+    dictionary = &col_info.VarlenColumn();
+  }
+  block->controller_.ReleaseInPlaceRead();
+  return dictionary;
+}
+
+void DataTable::SkipBlock(SlotIterator *const pos) const {
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+    ++pos->block_;
+    if (pos->block_ != blocks_.end()) {
+      pos->current_slot_ = {*pos->block_, 0};
+      return;
+    }
+  }
+  // Skipped past the last block
+  *pos = end();
+}
+
 DataTable::SlotIterator &DataTable::SlotIterator::operator++() {
   common::SpinLatch::ScopedSpinLatch guard(&table_->blocks_latch_);
   // Jump to the next block if already the last slot in the block.
@@ -71,6 +124,14 @@ DataTable::SlotIterator &DataTable::SlotIterator::operator++() {
   return *this;
 }
 
+std::vector<DataTable::SlotIterator> DataTable::BlockBegins() const {
+  common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+  std::vector<SlotIterator> begins;
+  begins.reserve(blocks_.size());
+  for (auto block = blocks_.begin(); block != blocks_.end(); ++block) begins.push_back({this, block, 0});
+  return begins;
+}
+
 DataTable::SlotIterator DataTable::end() const {  // NOLINT for STL name compability
   common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
   // TODO(Tianyu): Need to look in detail at how this interacts with compaction when that gets in.
@@ -391,6 +452,14 @@ bool DataTable::HasConflict(const transaction::TransactionContext &txn, const Tu
 }
 
 bool DataTable::IsVisible(const transaction::TransactionContext &txn, const TupleSlot slot) const {
+  // Writers turn a frozen block hot before they install a version, so the tuples of a frozen block have no version
+  // chains and their version pointers need not be read. If the block turned hot while we checked, fall through.
+  std::atomic<BlockState> *const block_state = slot.GetBlock()->controller_.GetBlockState();
+  if (block_state->load() == BlockState::FROZEN) {
+    const bool frozen_visible = Visible(slot, accessor_);
+    if (block_state->load() == BlockState::FROZEN) return frozen_visible;
+  }
+
   UndoRecord *version_ptr;
   bool visible;
   do {
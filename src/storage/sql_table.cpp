@@ -1,6 +1,7 @@
 #include "storage/sql_table.h"
 #include <map>
 #include <set>
+#include <utility>
 #include <vector>
 #include "common/macros.h"
 #include "storage/storage_util.h"
@@ -49,8 +50,34 @@ SqlTable::SqlTable(BlockStore *const store, const catalog::Schema &schema) : blo
     }
   }
 
+  // Build zone maps for every column whose values have a meaningful order
+  std::vector<ZoneMapType> zone_map_types(attr_sizes.size(), ZoneMapType::NONE);
+  for (const auto &column : schema.GetColumns()) {
+    zone_map_types[!col_oid_to_id[column.Oid()]] = ZoneMapTypeFor(column.Type());
+  }
+
   auto layout = storage::BlockLayout(attr_sizes);
-  table_ = {new DataTable(block_store_, layout, layout_version_t(0)), layout, col_oid_to_id};
+  table_ = {new DataTable(block_store_, layout, layout_version_t(0), std::move(zone_map_types)), layout,
+            col_oid_to_id};
+}
+
+ZoneMapType SqlTable::ZoneMapTypeFor(const type::TypeId type) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      return ZoneMapType::SIGNED_INTEGER;
+    case type::TypeId::TIMESTAMP:
+      return ZoneMapType::UNSIGNED_INTEGER;
+    case type::TypeId::DATE:
+      return ZoneMapType::DATE;
+    case type::TypeId::DECIMAL:
+      return ZoneMapType::FLOAT;
+    default:
+      return ZoneMapType::NONE;
+  }
 }
 
 std::vector<col_id_t> SqlTable::ColIdsForOids(const std::vector<catalog::col_oid_t> &col_oids) const {
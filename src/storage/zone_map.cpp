@@ -0,0 +1,71 @@
+#include "storage/zone_map.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage/arrow_block_metadata.h"
+#include "storage/block_access_controller.h"
+#include "storage/tuple_access_strategy.h"
+
+namespace terrier::storage {
+
+int64_t ZoneMap::Key(const ZoneMapType type, const byte *const value, const uint16_t attr_size) {
+  switch (type) {
+    case ZoneMapType::SIGNED_INTEGER:
+      switch (attr_size) {
+        case 1:
+          return SignedIntegerKey(*reinterpret_cast<const int8_t *>(value));
+        case 2:
+          return SignedIntegerKey(*reinterpret_cast<const int16_t *>(value));
+        case 4:
+          return SignedIntegerKey(*reinterpret_cast<const int32_t *>(value));
+        default:
+          return SignedIntegerKey(*reinterpret_cast<const int64_t *>(value));
+      }
+    case ZoneMapType::UNSIGNED_INTEGER:
+      switch (attr_size) {
+        case 1:
+          return UnsignedIntegerKey(*reinterpret_cast<const uint8_t *>(value));
+        case 2:
+          return UnsignedIntegerKey(*reinterpret_cast<const uint16_t *>(value));
+        case 4:
+          return UnsignedIntegerKey(*reinterpret_cast<const uint32_t *>(value));
+        default:
+          return UnsignedIntegerKey(*reinterpret_cast<const uint64_t *>(value));
+      }
+    case ZoneMapType::DATE:
+      return DateKey(*reinterpret_cast<const uint32_t *>(value));
+    case ZoneMapType::FLOAT:
+      return attr_size == sizeof(float) ? FloatKey(*reinterpret_cast<const float *>(value))
+                                         : FloatKey(*reinterpret_cast<const double *>(value));
+    default:
+      throw std::runtime_error("unexpected zone map type");
+  }
+}
+
+void ZoneMap::Compute(const ZoneMapType type, const byte *const values, const uint16_t attr_size,
+                      const common::RawConcurrentBitmap *const null_bitmap, const uint32_t num_records) {
+  min_key_ = std::numeric_limits<int64_t>::max();
+  max_key_ = std::numeric_limits<int64_t>::min();
+  num_values_ = 0;
+  for (uint32_t i = 0; i < num_records; i++) {
+    if (!null_bitmap->Test(i)) continue;
+    const int64_t key = Key(type, values + i * attr_size, attr_size);
+    min_key_ = std::min(min_key_, key);
+    max_key_ = std::max(max_key_, key);
+    num_values_++;
+  }
+  valid_ = true;
+}
+
+bool ZoneMapFilter::CanSkip(const TupleAccessStrategy &accessor, RawBlock *const block) const {
+  // The zone maps of hot blocks are not maintained
+  if (block->controller_.GetBlockState()->load() != BlockState::FROZEN) return false;
+  const ArrowBlockMetadata &metadata = accessor.GetArrowBlockMetadata(block);
+  const BlockLayout &layout = accessor.GetBlockLayout();
+  return std::any_of(ranges_.begin(), ranges_.end(), [&](const Range &range) {
+    return !metadata.GetZoneMap(layout, range.col_id_).MayContain(range.min_key_, range.max_key_);
+  });
+}
+
+}  // namespace terrier::storage
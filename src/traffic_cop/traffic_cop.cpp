@@ -2,8 +2,10 @@
 
 #include <future>  // NOLINT
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "binder/bind_node_visitor.h"
 #include "catalog/catalog.h"
@@ -12,6 +14,7 @@
 #include "execution/exec/execution_context.h"
 #include "execution/exec/output.h"
 #include "execution/executable_query.h"
+#include "execution/sql/analyze_executor.h"
 #include "execution/sql/ddl_executors.h"
 #include "execution/vm/module.h"
 #include "network/connection_context.h"
@@ -19,6 +22,7 @@
 #include "optimizer/statistics/stats_storage.h"
 #include "parser/postgresparser.h"
 #include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/analyze_plan_node.h"
 #include "traffic_cop/traffic_cop_defs.h"
 #include "traffic_cop/traffic_cop_util.h"
 #include "transaction/transaction_manager.h"
@@ -30,6 +34,16 @@ static void CommitCallback(void *const callback_arg) {
   promise->set_value(true);
 }
 
+TrafficCop::~TrafficCop() {
+  if (!stats_refresh_thread_.joinable()) return;
+  {
+    std::lock_guard<std::mutex> guard(stats_refresh_latch_);
+    stop_stats_refresh_ = true;
+  }
+  stats_refresh_cv_.notify_one();
+  stats_refresh_thread_.join();
+}
+
 void TrafficCop::BeginTransaction(const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
   TERRIER_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::IDLE,
                  "Invalid ConnectionContext state, already in a transaction.");
@@ -60,6 +74,8 @@ void TrafficCop::EndTransaction(const common::ManagedPointer<network::Connection
   }
   connection_ctx->SetTransaction(nullptr);
   connection_ctx->SetAccessor(nullptr);
+
+  if (query_type == network::QueryType::QUERY_COMMIT) RefreshStaleStatistics();
 }
 
 void TrafficCop::HandBufferToReplication(std::unique_ptr<network::ReadBuffer> buffer) {
@@ -227,6 +243,94 @@ void TrafficCop::ExecuteDropStatement(const common::ManagedPointer<network::Conn
   connection_ctx->Transaction()->SetMustAbort();
 }
 
+void TrafficCop::ExecuteAnalyzeStatement(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                         const common::ManagedPointer<network::PostgresPacketWriter> out,
+                                         const common::ManagedPointer<parser::ParseResult> parse_result) const {
+  const auto analyze_stmt = parse_result->GetStatement(0).CastManagedPointerTo<parser::AnalyzeStatement>();
+  const auto table_ref = analyze_stmt->GetAnalyzeTable();
+  if (table_ref == nullptr) {
+    out->WriteErrorResponse("ERROR:  ANALYZE without a table is not supported");
+    connection_ctx->Transaction()->SetMustAbort();
+    return;
+  }
+
+  // Resolve the table and columns to analyze
+  const auto accessor = connection_ctx->Accessor();
+  const auto ns_oid = table_ref->GetNamespaceName().empty() ? accessor->GetDefaultNamespace()
+                                                            : accessor->GetNamespaceOid(table_ref->GetNamespaceName());
+  const auto table_oid = ns_oid == catalog::INVALID_NAMESPACE_OID
+                             ? catalog::INVALID_TABLE_OID
+                             : accessor->GetTableOid(ns_oid, table_ref->GetTableName());
+  if (table_oid == catalog::INVALID_TABLE_OID) {
+    out->WriteErrorResponse("ERROR:  relation \"" + table_ref->GetTableName() + "\" does not exist");
+    connection_ctx->Transaction()->SetMustAbort();
+    return;
+  }
+  std::vector<catalog::col_oid_t> col_oids;
+  if (analyze_stmt->GetAnalyzeColumns() != nullptr) {
+    const auto &schema = accessor->GetSchema(table_oid);
+    try {
+      for (const auto &col_name : *analyze_stmt->GetAnalyzeColumns()) {
+        col_oids.push_back(schema.GetColumn(col_name).Oid());
+      }
+    } catch (const std::out_of_range &) {
+      out->WriteErrorResponse("ERROR:  column of relation \"" + table_ref->GetTableName() + "\" does not exist");
+      connection_ctx->Transaction()->SetMustAbort();
+      return;
+    }
+  }
+
+  const auto analyze_plan = planner::AnalyzePlanNode::Builder()
+                                .SetDatabaseOid(connection_ctx->GetDatabaseOid())
+                                .SetNamespaceOid(ns_oid)
+                                .SetTableOid(table_oid)
+                                .SetColumnOIDs(std::move(col_oids))
+                                .Build();
+  if (execution::sql::AnalyzeExecutor::AnalyzeTableExecutor(common::ManagedPointer(analyze_plan), accessor,
+                                                            connection_ctx->Transaction(), stats_storage_)) {
+    out->WriteCommandComplete(network::QueryType::QUERY_ANALYZE, 0);
+    return;
+  }
+  out->WriteErrorResponse("ERROR:  failed to execute ANALYZE");
+  connection_ctx->Transaction()->SetMustAbort();
+}
+
+void TrafficCop::RefreshStaleStatistics() const {
+  if (stats_storage_ == DISABLED) return;
+  {
+    std::lock_guard<std::mutex> guard(stats_refresh_latch_);
+    stats_refresh_pending_ = true;
+  }
+  stats_refresh_cv_.notify_one();
+}
+
+void TrafficCop::StatsRefreshLoop() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(stats_refresh_latch_);
+      stats_refresh_cv_.wait(lock, [this] { return stats_refresh_pending_ || stop_stats_refresh_; });
+      if (stop_stats_refresh_) return;
+      stats_refresh_pending_ = false;
+    }
+
+    for (const auto &[db_oid, table_oid] : stats_storage_->TakeStaleTables()) {
+      auto *const txn = txn_manager_->BeginTransaction();
+      const auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_oid);
+      const auto analyze_plan =
+          planner::AnalyzePlanNode::Builder().SetDatabaseOid(db_oid).SetTableOid(table_oid).Build();
+      // The table or its database may have been dropped since it was modified
+      if (accessor != nullptr &&
+          execution::sql::AnalyzeExecutor::AnalyzeTableExecutor(common::ManagedPointer(analyze_plan),
+                                                                common::ManagedPointer(accessor),
+                                                                common::ManagedPointer(txn), stats_storage_)) {
+        txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      } else {
+        txn_manager_->Abort(txn);
+      }
+    }
+  }
+}
+
 std::unique_ptr<parser::ParseResult> TrafficCop::ParseQuery(
     const std::string &query, const common::ManagedPointer<network::ConnectionContext> connection_ctx,
     const common::ManagedPointer<network::PostgresPacketWriter> out) const {
@@ -276,8 +380,8 @@ void TrafficCop::ExecuteStatement(const common::ManagedPointer<network::Connecti
     return;
   }
 
-  if (query_type >= network::QueryType::QUERY_RENAME) {
-    // We don't yet support query types with values greater than this
+  if (query_type >= network::QueryType::QUERY_RENAME && query_type != network::QueryType::QUERY_ANALYZE) {
+    // We don't yet support query types with values greater than this, except for ANALYZE
     // TODO(Matt): add a TRAFFIC_COP_LOG_INFO here
     out->WriteCommandComplete(query_type, 0);
     return;
@@ -291,10 +395,17 @@ void TrafficCop::ExecuteStatement(const common::ManagedPointer<network::Connecti
   }
 
   // Try to bind the parsed statement
-  if (BindStatement(connection_ctx, out, parse_result, query_type)) {
+  if (query_type == network::QueryType::QUERY_ANALYZE) {
+    // ANALYZE does not need the optimizer, there is only one way to execute it
+    if (BindStatement(connection_ctx, out, parse_result, query_type)) {
+      ExecuteAnalyzeStatement(connection_ctx, out, parse_result);
+    }
+  } else if (BindStatement(connection_ctx, out, parse_result, query_type)) {
     // Binding succeeded, optimize to generate a physical plan and then execute
-    auto physical_plan = trafficcop::TrafficCopUtil::Optimize(connection_ctx->Transaction(), connection_ctx->Accessor(),
-                                                              parse_result, stats_storage_, optimizer_timeout_);
+    auto physical_plan =
+        trafficcop::TrafficCopUtil::Optimize(connection_ctx->Transaction(), connection_ctx->Accessor(), parse_result,
+                                             stats_storage_, optimizer_timeout_, cost_model_params_,
+                                             common::ManagedPointer(optimizer_threads_));
 
     // This logic relies on ordering of values in the enum's definition and is documented there as well.
     if (query_type <= network::QueryType::QUERY_DELETE) {
@@ -329,6 +440,8 @@ void TrafficCop::CodegenAndRunPhysicalPlan(const common::ManagedPointer<network:
   auto exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
       connection_ctx->GetDatabaseOid(), connection_ctx->Transaction(), writer, physical_plan->GetOutputSchema().Get(),
       connection_ctx->Accessor());
+  exec_ctx->SetStatsStorage(stats_storage_);
+  exec_ctx->SetMemoryLimit(query_memory_limit_);
 
   auto exec_query = execution::ExecutableQuery(common::ManagedPointer(physical_plan), common::ManagedPointer(exec_ctx));
 
@@ -345,6 +458,12 @@ void TrafficCop::CodegenAndRunPhysicalPlan(const common::ManagedPointer<network:
       // iteration can happen in multiple pipelines
       out->WriteCommandComplete(query_type, writer.NumRows());
 
+      // The optimizer plans the next execution of the query with the number of rows this one produced
+      if (stats_storage_ != DISABLED) {
+        stats_storage_->GetCardinalityFeedback()->RecordRows(physical_plan->GetFragmentKey(),
+                                                             physical_plan->GetEstimatedRows(), writer.NumRows());
+      }
+
     } else {
       // Other queries (INSERT, UPDATE, DELETE) retrieve rows affected from the execution context since other queries
       // might not have any output otherwise
@@ -5,7 +5,7 @@
 
 #include "catalog/catalog_accessor.h"
 #include "optimizer/abstract_optimizer.h"
-#include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/cost_model/stats_cost_model.h"
 #include "optimizer/operator_expression.h"
 #include "optimizer/optimizer.h"
 #include "optimizer/properties.h"
@@ -21,13 +21,16 @@ std::unique_ptr<planner::AbstractPlanNode> TrafficCopUtil::Optimize(
     const common::ManagedPointer<transaction::TransactionContext> txn,
     const common::ManagedPointer<catalog::CatalogAccessor> accessor,
     const common::ManagedPointer<parser::ParseResult> query,
-    const common::ManagedPointer<optimizer::StatsStorage> stats_storage, const uint64_t optimizer_timeout) {
+    const common::ManagedPointer<optimizer::StatsStorage> stats_storage, const uint64_t optimizer_timeout,
+    const optimizer::CostModelParameters &cost_model_params,
+    const common::ManagedPointer<common::WorkerPool> optimizer_threads) {
   // Optimizer transforms annotated ParseResult to logical expressions (ephemeral Optimizer structure)
   optimizer::QueryToOperatorTransformer transformer(accessor);
   auto logical_exprs = transformer.ConvertToOpExpression(query->GetStatement(0), query.Get());
 
   // TODO(Matt): is the cost model to use going to become an arg to this function eventually?
-  optimizer::Optimizer optimizer(std::make_unique<optimizer::TrivialCostModel>(), optimizer_timeout);
+  optimizer::Optimizer optimizer(std::make_unique<optimizer::StatsCostModel>(stats_storage, cost_model_params),
+                                 optimizer_timeout, optimizer_threads);
   optimizer::PropertySet property_set;
   std::vector<common::ManagedPointer<parser::AbstractExpression>> output;
 
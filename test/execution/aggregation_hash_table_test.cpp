@@ -1,4 +1,6 @@
 #include <atomic>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <random>
 #include <unordered_map>
@@ -465,4 +467,191 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
   EXPECT_EQ(num_aggs, qstate.row_count_.load(std::memory_order_seq_cst));
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, ParallelSpillingAggregationTest) {
+  const uint32_t num_aggs = 50000;
+  const uint32_t num_inputs_per_table = 2 * num_aggs;
+
+  // Limit the query's memory so that every thread-local table spills
+  exec_ctx_->SetMemoryLimit(256 * 1024);
+
+  auto init_ht = [](void *ctx, void *aht) {
+    auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+    new (aht) AggregationHashTable(exec_ctx->GetMemoryPool(), sizeof(AggTuple));
+  };
+
+  auto destroy_ht = [](void *ctx, void *aht) {
+    reinterpret_cast<AggregationHashTable *>(aht)->~AggregationHashTable();
+  };
+
+  // Each table sees every group twice
+  auto build_agg_table = [&](AggregationHashTable *agg_table) {
+    for (uint32_t idx = 0; idx < num_inputs_per_table; idx++) {
+      InputTuple input(idx % num_aggs, 1);
+      auto *existing = reinterpret_cast<AggTuple *>(
+          agg_table->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+      if (existing != nullptr) {
+        existing->Advance(input);
+      } else {
+        auto *new_agg = agg_table->InsertPartitioned(input.Hash());
+        new (new_agg) AggTuple(input);
+      }
+    }
+    EXPECT_TRUE(agg_table->HasSpilled());
+  };
+
+  auto merge = [](void *ctx, AggregationHashTable *table, AggregationOverflowPartitionIterator *iter) {
+    for (; iter->HasNext(); iter->Next()) {
+      auto *partial_agg = iter->GetPayloadAs<AggTuple>();
+      auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetHash(), AggAggKeyEq, partial_agg));
+      if (existing != nullptr) {
+        existing->Merge(*partial_agg);
+      } else {
+        auto *new_agg = table->Insert(iter->GetHash());
+        new (new_agg) AggTuple(*partial_agg);
+      }
+    }
+  };
+
+  struct QS {
+    std::atomic<uint32_t> row_count_;
+    std::atomic<uint64_t> input_count_;
+  };
+
+  auto scan = [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+    auto *qs = reinterpret_cast<QS *>(query_state);
+    qs->row_count_ += static_cast<uint32_t>(agg_table->NumElements());
+    for (AggregationHashTableIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+      qs->input_count_ += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+    }
+  };
+
+  QS qstate{0, 0};
+  ThreadStateContainer container(exec_ctx_->GetMemoryPool());
+
+  // Build thread-local tables
+  container.Reset(sizeof(AggregationHashTable), init_ht, destroy_ht, exec_ctx_.get());
+  auto aggs = {0, 1, 2, 3};
+  tbb::task_scheduler_init sched;
+  tbb::parallel_for_each(aggs.begin(), aggs.end(), [&](UNUSED_ATTRIBUTE auto x) {
+    auto aht = container.AccessThreadStateOfCurrentThreadAs<AggregationHashTable>();
+    build_agg_table(aht);
+  });
+
+  AggregationHashTable main_table(exec_ctx_->GetMemoryPool(), sizeof(AggTuple));
+
+  // Move memory and spilled partitions
+  main_table.TransferMemoryAndPartitions(&container, 0, merge);
+  container.Clear();
+  EXPECT_TRUE(main_table.HasSpilled());
+
+  // Scan
+  main_table.ExecuteParallelPartitionedScan(&qstate, &container, scan);
+
+  // Every group is produced exactly once, and every input is accounted for
+  EXPECT_EQ(num_aggs, qstate.row_count_.load(std::memory_order_seq_cst));
+  EXPECT_EQ(uint64_t(aggs.size()) * num_inputs_per_table, qstate.input_count_.load(std::memory_order_seq_cst));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, SerialSpillingAggregationTest) {
+  const uint32_t num_aggs = 50000;
+  const uint32_t num_inputs = 3 * num_aggs;
+
+  // Limit the query's memory so that the table spills several times
+  exec_ctx_->SetMemoryLimit(256 * 1024);
+  AggregationHashTable agg_table(exec_ctx_->GetMemoryPool(), sizeof(AggTuple));
+
+  for (uint32_t idx = 0; idx < num_inputs; idx++) {
+    InputTuple input(idx % num_aggs, 1);
+    auto *existing = reinterpret_cast<AggTuple *>(
+        agg_table.Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+    if (existing != nullptr) {
+      existing->Advance(input);
+    } else {
+      new (agg_table.Insert(input.Hash())) AggTuple(input);
+    }
+  }
+  EXPECT_TRUE(agg_table.HasSpilled());
+  EXPECT_LT(agg_table.NumElements(), num_aggs);
+
+  auto merge = [](void *ctx, AggregationHashTable *table, AggregationOverflowPartitionIterator *iter) {
+    for (; iter->HasNext(); iter->Next()) {
+      auto *partial_agg = iter->GetPayloadAs<AggTuple>();
+      auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetHash(), AggAggKeyEq, partial_agg));
+      if (existing != nullptr) {
+        existing->Merge(*partial_agg);
+      } else {
+        new (table->Insert(iter->GetHash())) AggTuple(*partial_agg);
+      }
+    }
+  };
+
+  // Every group is produced exactly once, by exactly one partition, with all of its inputs
+  std::vector<bool> seen(num_aggs, false);
+  uint32_t num_groups = 0;
+  while (agg_table.NextSpilledPartition(nullptr, merge)) {
+    for (AggregationHashTableIterator iter(*agg_table.GetSpilledPartitionTable()); iter.HasNext(); iter.Next()) {
+      auto *agg_tuple = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
+      ASSERT_LT(agg_tuple->key_, num_aggs);
+      EXPECT_FALSE(seen[agg_tuple->key_]);
+      seen[agg_tuple->key_] = true;
+      EXPECT_EQ(num_inputs / num_aggs, agg_tuple->count1_);
+      num_groups++;
+    }
+  }
+  EXPECT_EQ(num_aggs, num_groups);
+
+  // All groups went through the spilled partitions
+  EXPECT_EQ(0u, agg_table.NumElements());
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, DenseAggregationTest) {
+  AggregationHashTable agg_table(Memory(), sizeof(AggTuple));
+  agg_table.SetDenseKeyRange(-10, 10);
+  EXPECT_TRUE(agg_table.IsDense());
+
+  // Keys inside the range, and near and far outside of it on both sides
+  const int64_t keys[] = {-10, 0, 10, 11, -11, 3, std::numeric_limits<int64_t>::min(),
+                          std::numeric_limits<int64_t>::max(), 1000, -1000};
+  const uint32_t num_rounds = 3;
+  for (uint32_t round = 0; round < num_rounds; round++) {
+    for (const int64_t key : keys) {
+      const Integer sql_key(key);
+      auto *existing = reinterpret_cast<AggTuple *>(agg_table.LookupDense(sql_key));
+      if (existing != nullptr) {
+        existing->Advance(InputTuple(key, 1));
+      } else {
+        new (agg_table.InsertDense(sql_key)) AggTuple(InputTuple(key, 1));
+      }
+    }
+    const Integer null_key = Integer::Null();
+    auto *existing = reinterpret_cast<AggTuple *>(agg_table.LookupDense(null_key));
+    if (existing != nullptr) {
+      existing->count1_++;
+    } else {
+      new (agg_table.InsertDense(null_key)) AggTuple(InputTuple(0, 1));
+    }
+  }
+
+  // Every key has its own group, which saw all of its inputs
+  EXPECT_EQ(std::size(keys) + 1, agg_table.NumElements());
+  for (const int64_t key : keys) {
+    auto *agg_tuple = reinterpret_cast<const AggTuple *>(agg_table.LookupDense(Integer(key)));
+    ASSERT_NE(nullptr, agg_tuple);
+    EXPECT_EQ(static_cast<uint64_t>(key), agg_tuple->key_);
+    EXPECT_EQ(num_rounds, agg_tuple->count1_);
+  }
+  auto *null_tuple = reinterpret_cast<const AggTuple *>(agg_table.LookupDense(Integer::Null()));
+  ASSERT_NE(nullptr, null_tuple);
+  EXPECT_EQ(num_rounds, null_tuple->count1_);
+  EXPECT_EQ(nullptr, agg_table.LookupDense(Integer(12)));
+
+  // Iteration sees every group
+  uint32_t num_groups = 0;
+  for (AggregationHashTableIterator iter(agg_table); iter.HasNext(); iter.Next()) num_groups++;
+  EXPECT_EQ(std::size(keys) + 1, num_groups);
+}
+
 }  // namespace terrier::execution::sql::test
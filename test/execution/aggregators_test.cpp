@@ -1,3 +1,5 @@
+#include <vector>
+
 #include "execution/tpl_test.h"
 
 #include "execution/sql/aggregators.h"
@@ -489,4 +491,77 @@ TEST_F(AggregatorsTest, Avg) {
   EXPECT_DOUBLE_EQ(0.0, avg1.GetResultAvg().val_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregatorsTest, AdvanceBatch) {
+  constexpr uint32_t num_elems = 1000;
+
+  // Every seventh value is NULL in the nullable column
+  std::vector<int32_t> ints(num_elems);
+  std::vector<double> reals(num_elems);
+  common::RawBitmap *nulls = common::RawBitmap::Allocate(num_elems);
+  common::RawBitmap *no_nulls = common::RawBitmap::Allocate(num_elems);
+  for (uint32_t i = 0; i < num_elems; i++) {
+    ints[i] = static_cast<int32_t>(i * 37 % 1001) - 500;
+    reals[i] = -1.0 - static_cast<double>(i % 97);
+    nulls->Set(i, i % 7 != 0);
+    no_nulls->Set(i, true);
+  }
+
+  // Only every third element is selected
+  std::vector<uint32_t> sel;
+  for (uint32_t i = 0; i < num_elems; i += 3) sel.push_back(i);
+  const std::vector<const uint32_t *> sel_vectors = {nullptr, sel.data()};
+
+  for (const auto *bitmap : {nulls, no_nulls}) {
+    for (const uint32_t *sel_vector : sel_vectors) {
+      const uint32_t count = sel_vector == nullptr ? num_elems : static_cast<uint32_t>(sel.size());
+
+      // Batch aggregates must match tuple-at-a-time aggregates
+      CountAggregate count_agg, expected_count;
+      IntegerSumAggregate sum, expected_sum;
+      IntegerMaxAggregate max, expected_max;
+      RealMinAggregate min, expected_min;
+      AvgAggregate avg, expected_avg;
+      count_agg.AdvanceBatch(ints.data(), bitmap, count, sel_vector);
+      sum.AdvanceBatch(ints.data(), bitmap, count, sel_vector);
+      max.AdvanceBatch(ints.data(), bitmap, count, sel_vector);
+      min.AdvanceBatch(reals.data(), bitmap, count, sel_vector);
+      avg.AdvanceBatch(ints.data(), bitmap, count, sel_vector);
+      for (uint32_t i = 0; i < count; i++) {
+        const uint32_t idx = sel_vector == nullptr ? i : sel_vector[i];
+        Integer int_val = bitmap->Test(idx) ? Integer(ints[idx]) : Integer::Null();
+        Real real_val = bitmap->Test(idx) ? Real(reals[idx]) : Real::Null();
+        expected_count.Advance(int_val);
+        expected_sum.Advance(int_val);
+        expected_max.Advance(int_val);
+        expected_min.Advance(real_val);
+        expected_avg.Advance(int_val);
+      }
+
+      EXPECT_EQ(expected_count.GetCountResult().val_, count_agg.GetCountResult().val_);
+      EXPECT_EQ(expected_sum.GetResultSum().val_, sum.GetResultSum().val_);
+      EXPECT_EQ(expected_max.GetResultMax().val_, max.GetResultMax().val_);
+      EXPECT_DOUBLE_EQ(expected_min.GetResultMin().val_, min.GetResultMin().val_);
+      EXPECT_DOUBLE_EQ(expected_avg.GetResultAvg().val_, avg.GetResultAvg().val_);
+    }
+  }
+
+  // A batch of only NULLs leaves the aggregates NULL
+  common::RawBitmap *all_nulls = common::RawBitmap::Allocate(num_elems);
+  IntegerSumAggregate sum;
+  RealMaxAggregate max;
+  sum.AdvanceBatch(ints.data(), all_nulls, num_elems, nullptr);
+  max.AdvanceBatch(reals.data(), all_nulls, num_elems, nullptr);
+  EXPECT_TRUE(sum.GetResultSum().is_null_);
+  EXPECT_TRUE(max.GetResultMax().is_null_);
+
+  // Negative reals have a maximum below zero
+  max.AdvanceBatch(reals.data(), no_nulls, num_elems, nullptr);
+  EXPECT_DOUBLE_EQ(-1.0, max.GetResultMax().val_);
+
+  common::RawBitmap::Deallocate(nulls);
+  common::RawBitmap::Deallocate(no_nulls);
+  common::RawBitmap::Deallocate(all_nulls);
+}
+
 }  // namespace terrier::execution::sql::test
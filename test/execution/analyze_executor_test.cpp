@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "execution/sql_test.h"
+
+#include "catalog/catalog_accessor.h"
+#include "execution/sql/analyze_executor.h"
+#include "optimizer/statistics/stats_storage.h"
+#include "planner/plannodes/analyze_plan_node.h"
+
+namespace terrier::execution::sql::test {
+
+class AnalyzeExecutorTest : public SqlBasedTest {
+  void SetUp() override {
+    SqlBasedTest::SetUp();
+    exec_ctx_ = MakeExecCtx();
+    GenerateTestTables(exec_ctx_.get());
+  }
+
+ protected:
+  // Analyze the given columns of a table, or all of them if none are given
+  bool Analyze(const catalog::table_oid_t table_oid, std::vector<catalog::col_oid_t> col_oids = {}) {
+    auto plan = planner::AnalyzePlanNode::Builder()
+                    .SetDatabaseOid(exec_ctx_->DBOid())
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid)
+                    .SetColumnOIDs(std::move(col_oids))
+                    .Build();
+    return AnalyzeExecutor::AnalyzeTableExecutor(common::ManagedPointer(plan),
+                                                 common::ManagedPointer(exec_ctx_->GetAccessor()), exec_ctx_->GetTxn(),
+                                                 common::ManagedPointer(&stats_storage_));
+  }
+
+  std::unique_ptr<exec::ExecutionContext> exec_ctx_;
+  optimizer::StatsStorage stats_storage_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(AnalyzeExecutorTest, AnalyzeTable) {
+  const auto accessor = exec_ctx_->GetAccessor();
+  const auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  const auto &schema = accessor->GetSchema(table_oid);
+  ASSERT_TRUE(Analyze(table_oid));
+
+  const auto table_stats = stats_storage_.GetTableStats(exec_ctx_->DBOid(), table_oid);
+  ASSERT_NE(table_stats, nullptr);
+  EXPECT_EQ(sql::TEST1_SIZE, table_stats->GetNumRows());
+  EXPECT_EQ(schema.GetColumns().size(), table_stats->GetColumnCount());
+
+  // colA holds the distinct values [0, TEST1_SIZE), so its histogram splits that range evenly
+  const auto col_a = table_stats->GetColumnStats(schema.GetColumn("colA").Oid());
+  EXPECT_NEAR(sql::TEST1_SIZE, col_a->GetCardinality(), 0.03 * sql::TEST1_SIZE);
+  EXPECT_EQ(0.0, col_a->GetFracNull());
+  const auto &bounds = col_a->GetHistogramBounds();
+  ASSERT_FALSE(bounds.empty());
+  EXPECT_TRUE(std::is_sorted(bounds.begin(), bounds.end()));
+  const double bin_width = static_cast<double>(sql::TEST1_SIZE) / AnalyzeExecutor::K_HISTOGRAM_BINS;
+  for (uint32_t i = 0; i < bounds.size(); i++) {
+    EXPECT_NEAR((i + 1) * bin_width, bounds[i], bin_width);
+  }
+
+  // colB holds ten values, all of which are common
+  const auto col_b = table_stats->GetColumnStats(schema.GetColumn("colB").Oid());
+  EXPECT_NEAR(10, col_b->GetCardinality(), 1);
+  const auto &common_vals = col_b->GetCommonVals();
+  const auto &common_freqs = col_b->GetCommonFreqs();
+  ASSERT_EQ(10, common_vals.size());
+  for (const double val : common_vals) {
+    EXPECT_TRUE(val >= 0 && val <= 9);
+  }
+  EXPECT_NEAR(sql::TEST1_SIZE, std::accumulate(common_freqs.begin(), common_freqs.end(), 0.0), 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AnalyzeExecutorTest, NullsAndReanalyze) {
+  const auto accessor = exec_ctx_->GetAccessor();
+  const auto table_oid = accessor->GetTableOid(NSOid(), "test_2");
+  const auto &schema = accessor->GetSchema(table_oid);
+  ASSERT_TRUE(Analyze(table_oid));
+
+  // About a tenth of the values of nullable columns are NULL
+  auto table_stats = stats_storage_.GetTableStats(exec_ctx_->DBOid(), table_oid);
+  ASSERT_NE(table_stats, nullptr);
+  EXPECT_EQ(sql::TEST2_SIZE, table_stats->GetNumRows());
+  const auto col2 = table_stats->GetColumnStats(schema.GetColumn("col2").Oid());
+  EXPECT_NEAR(0.1, col2->GetFracNull(), 0.03);
+  EXPECT_NEAR(10, col2->GetCardinality(), 1);
+
+  // Analyzing again replaces the statistics of the table
+  ASSERT_TRUE(Analyze(table_oid, {schema.GetColumn("col1").Oid()}));
+  table_stats = stats_storage_.GetTableStats(exec_ctx_->DBOid(), table_oid);
+  ASSERT_NE(table_stats, nullptr);
+  EXPECT_EQ(1, table_stats->GetColumnCount());
+  EXPECT_TRUE(table_stats->HasColumnStats(schema.GetColumn("col1").Oid()));
+}
+
+}  // namespace terrier::execution::sql::test
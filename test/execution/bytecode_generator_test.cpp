@@ -1,5 +1,7 @@
 #include <string>
+#include <utility>
 
+#include "execution/sql/value.h"
 #include "execution/tpl_test.h"
 
 // From test
@@ -320,4 +322,30 @@ TEST_F(BytecodeGeneratorTest, FunctionTest) {
   EXPECT_EQ(20, s.b_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodeGeneratorTest, ConstantLikePatternTest) {
+  // The constant patterns are compiled with the module, which has no execution context to evaluate @stringToSql() in
+  auto src = R"(
+    fun like(str: *StringVal) -> bool {
+      return @sqlToBool(@like(*str, @stringToSql("ab%c")))
+    }
+    fun notLike(str: *StringVal) -> bool {
+      return @sqlToBool(@notLike(*str, @stringToSql("ab%c")))
+    })";
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(src);
+  ASSERT_TRUE(module != nullptr);
+
+  std::function<bool(sql::StringVal *)> like, not_like;
+  ASSERT_TRUE(module->GetFunction("like", ExecutionMode::Interpret, &like));
+  ASSERT_TRUE(module->GetFunction("notLike", ExecutionMode::Interpret, &not_like));
+
+  const std::pair<const char *, bool> cases[] = {{"abc", true}, {"abxyzc", true}, {"abx", false}, {"xabc", false}};
+  for (const auto &[str, matches] : cases) {
+    sql::StringVal input(str);
+    EXPECT_EQ(matches, like(&input)) << str;
+    EXPECT_NE(matches, not_like(&input)) << str;
+  }
+}
+
 }  // namespace terrier::execution::vm::test
@@ -22,12 +22,14 @@
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/llvm_engine.h"
 #include "execution/vm/module.h"
+#include "optimizer/statistics/stats_storage.h"
 #include "planner/plannodes/aggregate_plan_node.h"
 #include "planner/plannodes/delete_plan_node.h"
 #include "planner/plannodes/hash_join_plan_node.h"
 #include "planner/plannodes/index_join_plan_node.h"
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
@@ -108,6 +110,166 @@ TEST_F(CompilerTest, SimpleSeqScanTest) {
   multi_checker.CheckCorrectness();
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, VectorizedSeqScanTest) {
+  // SELECT col1 FROM test_1 WHERE col1 >= -5 AND col1 < 500 AND col2 > -1;
+  // The predicate compares integer columns with integer constants, so it is evaluated by the vectorized filters.
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  ExpressionMaker expr_maker;
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto colb_oid = table_schema.GetColumn("colB").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", col1);
+    auto schema = seq_scan_out.MakeSchema();
+    // Make predicate
+    auto comp1 = expr_maker.ComparisonGe(col1, expr_maker.Constant(-5));
+    auto comp2 = expr_maker.ComparisonLt(col1, expr_maker.Constant(500));
+    auto comp3 = expr_maker.ComparisonGt(col2, expr_maker.Constant(-1));
+    auto predicate = expr_maker.ConjunctionAnd(expr_maker.ConjunctionAnd(comp1, comp2), comp3);
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid, colb_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetNamespaceOid(NSOid())
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  // Make the output checkers
+  // Negative constants are compared as signed values, so that every row with col1 < 500 passes
+  NumChecker num_checker{500};
+  SingleIntComparisonChecker col1_checker(std::less<>(), 0, 500);
+  MultiChecker multi_checker{std::vector<OutputChecker *>{&num_checker, &col1_checker}};
+
+  // Create the execution context
+  OutputStore store{&multi_checker, seq_scan->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(seq_scan->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), seq_scan->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(seq_scan), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  multi_checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, NullableVectorizedSeqScanTest) {
+  // SELECT col2 FROM test_2 WHERE col2 < 5;
+  // col2 is nullable, so the vectorized filter has to drop NULLs like the tuple-at-a-time predicate
+  // col2 < -(-5), which is not vectorized, does. Run both and compare.
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_2");
+  auto table_schema = accessor->GetSchema(table_oid);
+  const auto run_scan = [&](const bool vectorized) {
+    ExpressionMaker expr_maker;
+    OutputSchemaHelper seq_scan_out{0, &expr_maker};
+    auto col2_oid = table_schema.GetColumn("col2").Oid();
+    auto col2 = expr_maker.CVE(col2_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col2", col2);
+    auto schema = seq_scan_out.MakeSchema();
+    auto bound = vectorized ? expr_maker.Constant(5) : expr_maker.OpNeg(expr_maker.Constant(-5));
+    auto predicate = expr_maker.ComparisonLt(col2, bound);
+    planner::SeqScanPlanNode::Builder builder;
+    std::unique_ptr<planner::AbstractPlanNode> seq_scan = builder.SetOutputSchema(std::move(schema))
+                                                              .SetColumnOids({col2_oid})
+                                                              .SetScanPredicate(predicate)
+                                                              .SetIsForUpdateFlag(false)
+                                                              .SetNamespaceOid(NSOid())
+                                                              .SetTableOid(table_oid)
+                                                              .Build();
+
+    int64_t num_rows = 0;
+    GenericChecker checker(
+        [&](const std::vector<sql::Val *> &vals) {
+          auto col2_val = static_cast<const sql::Integer *>(vals[0]);
+          EXPECT_FALSE(col2_val->is_null_);
+          EXPECT_LT(col2_val->val_, 5);
+          num_rows++;
+        },
+        nullptr);
+    OutputStore store{&checker, seq_scan->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(seq_scan->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), seq_scan->GetOutputSchema().Get());
+    auto executable = ExecutableQuery(common::ManagedPointer(seq_scan), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    return num_rows;
+  };
+
+  const int64_t num_rows = run_scan(true);
+  EXPECT_GT(num_rows, 0);
+  EXPECT_EQ(run_scan(false), num_rows);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, VectorFilterSeqScanTest) {
+  // SELECT col1, col2 FROM test_tinyint WHERE col1 < 2000 AND (col1 % 3 = 0 OR col2 * 2 > 10);
+  // The PCI filters evaluate col1 < 2000, and a VectorFilter evaluates the rest a batch at a time. NULL values of
+  // col2 only pass if col1 % 3 = 0. Compare with the tuple-at-a-time predicate, which comparing with -(-10) instead of
+  // 10 keeps from being vectorized.
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_tinyint");
+  auto table_schema = accessor->GetSchema(table_oid);
+  const auto run_scan = [&](const bool vectorized) {
+    ExpressionMaker expr_maker;
+    OutputSchemaHelper seq_scan_out{0, &expr_maker};
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto colb_oid = table_schema.GetColumn("colB").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::TINYINT);
+    seq_scan_out.AddOutput("col1", col1);
+    seq_scan_out.AddOutput("col2", col2);
+    auto schema = seq_scan_out.MakeSchema();
+    auto col1_mod = expr_maker.Operator(parser::ExpressionType::OPERATOR_MOD, type::TypeId::INTEGER, col1,
+                                        expr_maker.Constant(3));
+    auto col2_double = expr_maker.OpMul(col2, expr_maker.Constant(2));
+    auto bound = vectorized ? expr_maker.Constant(10) : expr_maker.OpNeg(expr_maker.Constant(-10));
+    auto either = expr_maker.ConjunctionOr(expr_maker.ComparisonEq(col1_mod, expr_maker.Constant(0)),
+                                           expr_maker.ComparisonGt(col2_double, bound));
+    auto predicate = expr_maker.ConjunctionAnd(expr_maker.ComparisonLt(col1, expr_maker.Constant(2000)), either);
+    planner::SeqScanPlanNode::Builder builder;
+    std::unique_ptr<planner::AbstractPlanNode> seq_scan = builder.SetOutputSchema(std::move(schema))
+                                                              .SetColumnOids({cola_oid, colb_oid})
+                                                              .SetScanPredicate(predicate)
+                                                              .SetIsForUpdateFlag(false)
+                                                              .SetNamespaceOid(NSOid())
+                                                              .SetTableOid(table_oid)
+                                                              .Build();
+
+    int64_t num_rows = 0;
+    GenericChecker checker(
+        [&](const std::vector<sql::Val *> &vals) {
+          auto col1_val = static_cast<const sql::Integer *>(vals[0]);
+          auto col2_val = static_cast<const sql::Integer *>(vals[1]);
+          EXPECT_LT(col1_val->val_, 2000);
+          EXPECT_TRUE(col1_val->val_ % 3 == 0 || (!col2_val->is_null_ && col2_val->val_ * 2 > 10));
+          num_rows++;
+        },
+        nullptr);
+    OutputStore store{&checker, seq_scan->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(seq_scan->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), seq_scan->GetOutputSchema().Get());
+    auto executable = ExecutableQuery(common::ManagedPointer(seq_scan), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    return num_rows;
+  };
+
+  const int64_t num_rows = run_scan(true);
+  EXPECT_GT(num_rows, 0);
+  EXPECT_EQ(run_scan(false), num_rows);
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleSeqScanWithProjectionTest) {
   // SELECT col1, col2, col1 * col2, col1 >= 100*col2 FROM test_1 WHERE col1 < 500 AND col2 >= 3;
@@ -571,6 +733,150 @@ TEST_F(CompilerTest, SimpleIndexScanLimitDesendingTest) {
   checker.CheckCorrectness();
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, IndexOnlyScanTest) {
+  // SELECT colA FROM test_1 WHERE colA BETWEEN 495 AND 505 AND colA <> 500 ORDER BY colA DESC;
+  // index_1 covers colA, so the scan never fetches the tuples from the table.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto index_oid = accessor->GetIndexOid(NSOid(), "index_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> index_scan;
+  OutputSchemaHelper index_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    index_scan_out.AddOutput("col1", col1);
+    auto schema = index_scan_out.MakeSchema();
+    // Predicate, also read from the index key
+    auto predicate = expr_maker.ComparisonNeq(col1, expr_maker.Constant(500));
+    planner::IndexScanPlanNode::Builder builder;
+    index_scan = builder.SetTableOid(table_oid)
+                     .SetColumnOids({cola_oid})
+                     .SetIndexOid(index_oid)
+                     .AddLoIndexColumn(catalog::indexkeycol_oid_t(1), expr_maker.Constant(495))
+                     .AddHiIndexColumn(catalog::indexkeycol_oid_t(1), expr_maker.Constant(505))
+                     .SetNamespaceOid(NSOid())
+                     .SetOutputSchema(std::move(schema))
+                     .SetScanType(planner::IndexScanType::Descending)
+                     .SetScanLimit(0)
+                     .SetScanPredicate(predicate)
+                     .SetIndexOnly(true)
+                     .Build();
+  }
+
+  // Make the checker
+  uint32_t num_output_rows = 0;
+  uint32_t num_expected_rows = 10;
+  int64_t curr_col1{std::numeric_limits<int64_t>::max()};
+  RowChecker row_checker = [&num_output_rows, num_expected_rows, &curr_col1](const std::vector<sql::Val *> &vals) {
+    // Read cols
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    ASSERT_FALSE(col1->is_null_);
+    // Check col1 and number of outputs
+    ASSERT_GE(col1->val_, 495);
+    ASSERT_LE(col1->val_, 505);
+    ASSERT_NE(col1->val_, 500);
+    num_output_rows++;
+    ASSERT_LE(num_output_rows, num_expected_rows);
+
+    // Check that output is sorted by col1 DESC
+    ASSERT_GT(curr_col1, col1->val_);
+    curr_col1 = col1->val_;
+  };
+  CorrectnessFn correcteness_fn = [&num_output_rows, num_expected_rows]() {
+    ASSERT_EQ(num_output_rows, num_expected_rows);
+  };
+
+  GenericChecker checker(row_checker, correcteness_fn);
+  // Create the execution context
+  OutputStore store{&checker, index_scan->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(index_scan->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), index_scan->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(index_scan), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, IndexScanRangesTest) {
+  // SELECT col1, col2 FROM test_2 WHERE col1 IN (30, 10, 20, 10) OR col1 BETWEEN 40 AND 42;
+  // index_2_multi is on (col1, col2). col2 is left open, and its NULLs come before every other value.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_2");
+  auto index_oid = accessor->GetIndexOid(NSOid(), "index_2_multi");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> index_scan;
+  OutputSchemaHelper index_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto col1_oid = table_schema.GetColumn("col1").Oid();
+    auto col2_oid = table_schema.GetColumn("col2").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(col1_oid, type::TypeId::SMALLINT);
+    auto col2 = expr_maker.CVE(col2_oid, type::TypeId::INTEGER);
+    index_scan_out.AddOutput("col1", col1);
+    index_scan_out.AddOutput("col2", col2);
+    auto schema = index_scan_out.MakeSchema();
+    // Key ranges
+    auto null_col2 = expr_maker.MakeManaged(
+        std::make_unique<parser::ConstantValueExpression>(type::TransientValueFactory::GetNull(type::TypeId::INTEGER)));
+    auto max_col2 = expr_maker.Constant(std::numeric_limits<int32_t>::max());
+    const std::vector<std::pair<int32_t, int32_t>> col1_bounds{{30, 30}, {10, 10}, {40, 42}, {20, 20}, {10, 10}};
+    planner::IndexScanPlanNode::Builder builder;
+    for (const auto &bounds : col1_bounds) {
+      builder.AddKeyRange({{catalog::indexkeycol_oid_t(1), expr_maker.Constant(bounds.first)},
+                           {catalog::indexkeycol_oid_t(2), null_col2}},
+                          {{catalog::indexkeycol_oid_t(1), expr_maker.Constant(bounds.second)},
+                           {catalog::indexkeycol_oid_t(2), max_col2}});
+    }
+    index_scan = builder.SetTableOid(table_oid)
+                     .SetColumnOids({col1_oid, col2_oid})
+                     .SetIndexOid(index_oid)
+                     .SetNamespaceOid(NSOid())
+                     .SetOutputSchema(std::move(schema))
+                     .SetScanType(planner::IndexScanType::AscendingRanges)
+                     .SetScanLimit(0)
+                     .SetScanPredicate(nullptr)
+                     .Build();
+  }
+
+  // Make the checker
+  const std::vector<int64_t> expected_col1{10, 20, 30, 40, 41, 42};
+  uint32_t num_output_rows = 0;
+  RowChecker row_checker = [&num_output_rows, &expected_col1](const std::vector<sql::Val *> &vals) {
+    // Read cols
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    ASSERT_FALSE(col1->is_null_);
+    // Every key is found once, in key order
+    ASSERT_LT(num_output_rows, expected_col1.size());
+    ASSERT_EQ(col1->val_, expected_col1[num_output_rows]);
+    num_output_rows++;
+  };
+  CorrectnessFn correcteness_fn = [&num_output_rows, &expected_col1]() {
+    ASSERT_EQ(num_output_rows, expected_col1.size());
+  };
+
+  GenericChecker checker(row_checker, correcteness_fn);
+  // Create the execution context
+  OutputStore store{&checker, index_scan->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(index_scan->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), index_scan->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(index_scan), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleAggregateTest) {
   // SELECT col2, SUM(col1) FROM test_1 WHERE col1 < 1000 GROUP BY col2;
@@ -735,70 +1041,615 @@ TEST_F(CompilerTest, SimpleAggregateHavingTest) {
 }
 
 // NOLINTNEXTLINE
-TEST_F(CompilerTest, SimpleHashJoinTest) {
-  // SELECT t1.col1, t2.col1, t2.col2, t1.col1 + t2.col2 FROM t1 INNER JOIN t2 ON t1.col1=t2.col1
-  // WHERE t1.col1 < 500 AND t2.col1 < 80
-  // TODO(Amadou): Simple join tests are very similar. Some refactoring is possible.
+TEST_F(CompilerTest, SimpleSortedAggregateTest) {
+  // SELECT col2, SUM(col1) FROM (SELECT col1, col2 FROM test_1 WHERE col1 < 1000 ORDER BY col2) GROUP BY col2;
   // Get accessor
   auto accessor = MakeAccessor();
   ExpressionMaker expr_maker;
-  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
-  auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
-  auto table_schema1 = accessor->GetSchema(table_oid1);
-  auto table_schema2 = accessor->GetSchema(table_oid2);
-
-  std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
-  OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
   {
     // OIDs
-    auto cola_oid = table_schema1.GetColumn("colA").Oid();
-    auto colb_oid = table_schema1.GetColumn("colB").Oid();
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto colb_oid = table_schema.GetColumn("colB").Oid();
     // Get Table columns
     auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
     auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
-    seq_scan_out1.AddOutput("col1", col1);
-    seq_scan_out1.AddOutput("col2", col2);
-    auto schema = seq_scan_out1.MakeSchema();
+    seq_scan_out.AddOutput("col1", col1);
+    seq_scan_out.AddOutput("col2", col2);
+    auto schema = seq_scan_out.MakeSchema();
     // Make predicate
     auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(1000));
     // Build
     planner::SeqScanPlanNode::Builder builder;
-    seq_scan1 = builder.SetOutputSchema(std::move(schema))
-                    .SetColumnOids({cola_oid, colb_oid})
-                    .SetScanPredicate(predicate)
-                    .SetIsForUpdateFlag(false)
-                    .SetNamespaceOid(NSOid())
-                    .SetTableOid(table_oid1)
-                    .Build();
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid, colb_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetNamespaceOid(NSOid())
+                   .SetTableOid(table_oid)
+                   .Build();
   }
-  // Make the second seq scan
-  std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
-  OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+  // Sort on the group by term
+  std::unique_ptr<planner::AbstractPlanNode> order_by;
+  OutputSchemaHelper order_by_out{0, &expr_maker};
   {
-    // OIDs
-    auto cola_oid = table_schema2.GetColumn("col1").Oid();
-    auto colb_oid = table_schema2.GetColumn("col2").Oid();
-    // Get Table columns
-    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::SMALLINT);
-    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
-    seq_scan_out2.AddOutput("col1", col1);
-    seq_scan_out2.AddOutput("col2", col2);
-    auto schema = seq_scan_out2.MakeSchema();
-    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(80));
+    auto col1 = seq_scan_out.GetOutput("col1");
+    auto col2 = seq_scan_out.GetOutput("col2");
+    order_by_out.AddOutput("col1", col1);
+    order_by_out.AddOutput("col2", col2);
+    auto schema = order_by_out.MakeSchema();
     // Build
-    planner::SeqScanPlanNode::Builder builder;
-    seq_scan2 = builder.SetOutputSchema(std::move(schema))
-                    .SetColumnOids({cola_oid, colb_oid})
-                    .SetScanPredicate(predicate)
-                    .SetIsForUpdateFlag(false)
-                    .SetNamespaceOid(NSOid())
-                    .SetTableOid(table_oid2)
-                    .Build();
+    planner::OrderByPlanNode::Builder builder;
+    order_by = builder.SetOutputSchema(std::move(schema))
+                   .AddChild(std::move(seq_scan))
+                   .AddSortKey(col2, optimizer::OrderByOrderingType::ASC)
+                   .Build();
   }
-  // Make hash join
-  std::unique_ptr<planner::AbstractPlanNode> hash_join;
-  OutputSchemaHelper hash_join_out{0, &expr_maker};
-  {
+  // Make the aggregate
+  std::unique_ptr<planner::AbstractPlanNode> agg;
+  OutputSchemaHelper agg_out{0, &expr_maker};
+  {
+    // Read previous output
+    auto col1 = order_by_out.GetOutput("col1");
+    auto col2 = order_by_out.GetOutput("col2");
+    // Add group by term
+    agg_out.AddGroupByTerm("col2", col2);
+    // Add aggregates
+    auto sum_col1 = expr_maker.AggSum(col1);
+    agg_out.AddAggTerm("sum_col1", sum_col1);
+    // Make the output expressions
+    agg_out.AddOutput("col2", agg_out.GetGroupByTermForOutput("col2"));
+    agg_out.AddOutput("sum_col1", agg_out.GetAggTermForOutput("sum_col1"));
+    auto schema = agg_out.MakeSchema();
+    // Build
+    planner::AggregatePlanNode::Builder builder;
+    agg = builder.SetOutputSchema(std::move(schema))
+              .AddGroupByTerm(agg_out.GetGroupByTerm("col2"))
+              .AddAggregateTerm(agg_out.GetAggTerm("col1"))
+              .AddChild(std::move(order_by))
+              .SetAggregateStrategyType(planner::AggregateStrategyType::SORTED)
+              .SetHavingClausePredicate(nullptr)
+              .Build();
+  }
+  // Make the checkers
+  // Groups are emitted once each, in the order of the input
+  int64_t prev_col2{std::numeric_limits<int64_t>::min()};
+  RowChecker row_checker = [&prev_col2](const std::vector<sql::Val *> &vals) {
+    auto col2 = static_cast<sql::Integer *>(vals[0]);
+    ASSERT_FALSE(col2->is_null_);
+    ASSERT_LT(prev_col2, col2->val_);
+    prev_col2 = col2->val_;
+  };
+  CorrectnessFn correcteness_fn;
+  GenericChecker order_checker(row_checker, correcteness_fn);
+  NumChecker num_checker{10};
+  SingleIntSumChecker sum_checker{1, (1000 * 999) / 2};
+  MultiChecker multi_checker{std::vector<OutputChecker *>{&order_checker, &num_checker, &sum_checker}};
+
+  // Compile and Run
+  OutputStore store{&multi_checker, agg->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(agg->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), agg->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(agg), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  multi_checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SortedAggregateNullKeyTest) {
+  // SELECT col2, COUNT(col1) FROM (SELECT col1, col2 FROM test_tinyint ORDER BY col2) GROUP BY col2;
+  // The NULL keys sort last and form one group of their own instead of merging into their neighbours.
+  // Get accessor
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_tinyint");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto colb_oid = table_schema.GetColumn("colB").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::TINYINT);
+    seq_scan_out.AddOutput("col1", col1);
+    seq_scan_out.AddOutput("col2", col2);
+    auto schema = seq_scan_out.MakeSchema();
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid, colb_oid})
+                   .SetScanPredicate(nullptr)
+                   .SetIsForUpdateFlag(false)
+                   .SetNamespaceOid(NSOid())
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  // Sort on the group by term
+  std::unique_ptr<planner::AbstractPlanNode> order_by;
+  OutputSchemaHelper order_by_out{0, &expr_maker};
+  {
+    auto col1 = seq_scan_out.GetOutput("col1");
+    auto col2 = seq_scan_out.GetOutput("col2");
+    order_by_out.AddOutput("col1", col1);
+    order_by_out.AddOutput("col2", col2);
+    auto schema = order_by_out.MakeSchema();
+    // Build
+    planner::OrderByPlanNode::Builder builder;
+    order_by = builder.SetOutputSchema(std::move(schema))
+                   .AddChild(std::move(seq_scan))
+                   .AddSortKey(col2, optimizer::OrderByOrderingType::ASC)
+                   .Build();
+  }
+  // Make the aggregate
+  std::unique_ptr<planner::AbstractPlanNode> agg;
+  OutputSchemaHelper agg_out{0, &expr_maker};
+  {
+    // Read previous output
+    auto col1 = order_by_out.GetOutput("col1");
+    auto col2 = order_by_out.GetOutput("col2");
+    // Add group by term
+    agg_out.AddGroupByTerm("col2", col2);
+    // Add aggregates
+    agg_out.AddAggTerm("count_col1", expr_maker.AggCount(col1));
+    // Make the output expressions
+    agg_out.AddOutput("col2", agg_out.GetGroupByTermForOutput("col2"));
+    agg_out.AddOutput("count_col1", agg_out.GetAggTermForOutput("count_col1"));
+    auto schema = agg_out.MakeSchema();
+    // Build
+    planner::AggregatePlanNode::Builder builder;
+    agg = builder.SetOutputSchema(std::move(schema))
+              .AddGroupByTerm(agg_out.GetGroupByTerm("col2"))
+              .AddAggregateTerm(agg_out.GetAggTerm("count_col1"))
+              .AddChild(std::move(order_by))
+              .SetAggregateStrategyType(planner::AggregateStrategyType::SORTED)
+              .SetHavingClausePredicate(nullptr)
+              .Build();
+  }
+  // Make the checkers
+  // Each key in [0, 9] is a group of its own in ascending order, followed by the single NULL group
+  int64_t prev_col2{-1};
+  int64_t num_null_groups{0};
+  int64_t total_count{0};
+  RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+    auto col2 = static_cast<sql::Integer *>(vals[0]);
+    auto count_col1 = static_cast<sql::Integer *>(vals[1]);
+    ASSERT_FALSE(count_col1->is_null_);
+    ASSERT_GT(count_col1->val_, 0);
+    total_count += count_col1->val_;
+    if (col2->is_null_) {
+      num_null_groups++;
+      return;
+    }
+    ASSERT_EQ(num_null_groups, 0);
+    ASSERT_LT(prev_col2, col2->val_);
+    ASSERT_LT(col2->val_, 10);
+    prev_col2 = col2->val_;
+  };
+  CorrectnessFn correcteness_fn = [&]() {
+    EXPECT_EQ(num_null_groups, 1);
+    EXPECT_EQ(total_count, sql::TEST2_SIZE);
+  };
+  GenericChecker checker(row_checker, correcteness_fn);
+
+  // Compile and Run
+  OutputStore store{&checker, agg->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(agg->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), agg->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(agg), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, GlobalAggregateTest) {
+  // SELECT COUNT(col1), SUM(col1), MIN(col1), MAX(col1), AVG(col1) FROM test_1 WHERE col1 < 1000;
+  // The aggregates read a column of the scan as it is, so they are advanced a vector at a time.
+  // Get accessor
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", col1);
+    auto schema = seq_scan_out.MakeSchema();
+    // Make predicate
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(1000));
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetNamespaceOid(NSOid())
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  // Make the aggregate
+  std::unique_ptr<planner::AbstractPlanNode> agg;
+  OutputSchemaHelper agg_out{0, &expr_maker};
+  {
+    // Read previous output
+    auto col1 = seq_scan_out.GetOutput("col1");
+    // Add aggregates
+    agg_out.AddAggTerm("count_col1", expr_maker.AggCount(col1));
+    agg_out.AddAggTerm("sum_col1", expr_maker.AggSum(col1));
+    agg_out.AddAggTerm("min_col1", expr_maker.AggregateTerm(parser::ExpressionType::AGGREGATE_MIN, col1));
+    agg_out.AddAggTerm("max_col1", expr_maker.AggregateTerm(parser::ExpressionType::AGGREGATE_MAX, col1));
+    agg_out.AddAggTerm("avg_col1", expr_maker.AggAvg(col1));
+    // Make the output expressions
+    agg_out.AddOutput("count_col1", agg_out.GetAggTermForOutput("count_col1"));
+    agg_out.AddOutput("sum_col1", agg_out.GetAggTermForOutput("sum_col1"));
+    agg_out.AddOutput("min_col1", agg_out.GetAggTermForOutput("min_col1"));
+    agg_out.AddOutput("max_col1", agg_out.GetAggTermForOutput("max_col1"));
+    agg_out.AddOutput("avg_col1", expr_maker.DVE(type::TypeId::DECIMAL, 0, 4));
+    auto schema = agg_out.MakeSchema();
+    // Build
+    planner::AggregatePlanNode::Builder builder;
+    agg = builder.SetOutputSchema(std::move(schema))
+              .AddAggregateTerm(agg_out.GetAggTerm("count_col1"))
+              .AddAggregateTerm(agg_out.GetAggTerm("sum_col1"))
+              .AddAggregateTerm(agg_out.GetAggTerm("min_col1"))
+              .AddAggregateTerm(agg_out.GetAggTerm("max_col1"))
+              .AddAggregateTerm(agg_out.GetAggTerm("avg_col1"))
+              .AddChild(std::move(seq_scan))
+              .SetAggregateStrategyType(planner::AggregateStrategyType::HASH)
+              .SetHavingClausePredicate(nullptr)
+              .Build();
+  }
+  // Make the checkers
+  RowChecker row_checker = [](const std::vector<sql::Val *> &vals) {
+    for (const auto *val : vals) ASSERT_FALSE(val->is_null_);
+    EXPECT_EQ(static_cast<sql::Integer *>(vals[0])->val_, 1000);
+    EXPECT_EQ(static_cast<sql::Integer *>(vals[1])->val_, (1000 * 999) / 2);
+    EXPECT_EQ(static_cast<sql::Integer *>(vals[2])->val_, 0);
+    EXPECT_EQ(static_cast<sql::Integer *>(vals[3])->val_, 999);
+    EXPECT_DOUBLE_EQ(static_cast<sql::Real *>(vals[4])->val_, 499.5);
+  };
+  CorrectnessFn correcteness_fn;
+  GenericChecker row_values_checker(row_checker, correcteness_fn);
+  NumChecker num_checker{1};
+  MultiChecker multi_checker{std::vector<OutputChecker *>{&row_values_checker, &num_checker}};
+
+  // Compile and Run
+  OutputStore store{&multi_checker, agg->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(agg->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), agg->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(agg), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  multi_checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, GlobalAggregateEmptyTest) {
+  // SELECT COUNT(colA), SUM(colA + 1) FROM empty_table;
+  // The sum reads an expression, so the aggregates are advanced a tuple at a time.
+  // Get accessor
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "empty_table");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", col1);
+    auto schema = seq_scan_out.MakeSchema();
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetScanPredicate(nullptr)
+                   .SetIsForUpdateFlag(false)
+                   .SetNamespaceOid(NSOid())
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  // Make the aggregate
+  std::unique_ptr<planner::AbstractPlanNode> agg;
+  OutputSchemaHelper agg_out{0, &expr_maker};
+  {
+    // Read previous output
+    auto col1 = seq_scan_out.GetOutput("col1");
+    // Add aggregates
+    agg_out.AddAggTerm("count_col1", expr_maker.AggCount(col1));
+    agg_out.AddAggTerm("sum_col1", expr_maker.AggSum(expr_maker.OpSum(col1, expr_maker.Constant(1))));
+    // Make the output expressions
+    agg_out.AddOutput("count_col1", agg_out.GetAggTermForOutput("count_col1"));
+    agg_out.AddOutput("sum_col1", agg_out.GetAggTermForOutput("sum_col1"));
+    auto schema = agg_out.MakeSchema();
+    // Build
+    planner::AggregatePlanNode::Builder builder;
+    agg = builder.SetOutputSchema(std::move(schema))
+              .AddAggregateTerm(agg_out.GetAggTerm("count_col1"))
+              .AddAggregateTerm(agg_out.GetAggTerm("sum_col1"))
+              .AddChild(std::move(seq_scan))
+              .SetAggregateStrategyType(planner::AggregateStrategyType::HASH)
+              .SetHavingClausePredicate(nullptr)
+              .Build();
+  }
+  // Make the checkers
+  // Without input, there is still one row: the count is zero and the sum is NULL
+  RowChecker row_checker = [](const std::vector<sql::Val *> &vals) {
+    auto count_col1 = static_cast<sql::Integer *>(vals[0]);
+    ASSERT_FALSE(count_col1->is_null_);
+    EXPECT_EQ(count_col1->val_, 0);
+    EXPECT_TRUE(vals[1]->is_null_);
+  };
+  CorrectnessFn correcteness_fn;
+  GenericChecker row_values_checker(row_checker, correcteness_fn);
+  NumChecker num_checker{1};
+  MultiChecker multi_checker{std::vector<OutputChecker *>{&row_values_checker, &num_checker}};
+
+  // Compile and Run
+  OutputStore store{&multi_checker, agg->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(agg->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), agg->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(agg), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  multi_checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, DenseAggregateTest) {
+  // SELECT col2, COUNT(col1) FROM test_tinyint GROUP BY col2;
+  // The TINYINT key addresses the groups directly, and the NULL key has a slot of its own.
+  // Get accessor
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_tinyint");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto colb_oid = table_schema.GetColumn("colB").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::TINYINT);
+    seq_scan_out.AddOutput("col1", col1);
+    seq_scan_out.AddOutput("col2", col2);
+    auto schema = seq_scan_out.MakeSchema();
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid, colb_oid})
+                   .SetScanPredicate(nullptr)
+                   .SetIsForUpdateFlag(false)
+                   .SetNamespaceOid(NSOid())
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  // Make the aggregate
+  std::unique_ptr<planner::AbstractPlanNode> agg;
+  OutputSchemaHelper agg_out{0, &expr_maker};
+  {
+    // Read previous output
+    auto col1 = seq_scan_out.GetOutput("col1");
+    auto col2 = seq_scan_out.GetOutput("col2");
+    // Add group by term
+    agg_out.AddGroupByTerm("col2", col2);
+    // Add aggregates
+    agg_out.AddAggTerm("count_col1", expr_maker.AggCount(col1));
+    // Make the output expressions
+    agg_out.AddOutput("col2", agg_out.GetGroupByTermForOutput("col2"));
+    agg_out.AddOutput("count_col1", agg_out.GetAggTermForOutput("count_col1"));
+    auto schema = agg_out.MakeSchema();
+    // Build
+    planner::AggregatePlanNode::Builder builder;
+    agg = builder.SetOutputSchema(std::move(schema))
+              .AddGroupByTerm(agg_out.GetGroupByTerm("col2"))
+              .AddAggregateTerm(agg_out.GetAggTerm("count_col1"))
+              .AddChild(std::move(seq_scan))
+              .SetAggregateStrategyType(planner::AggregateStrategyType::HASH)
+              .SetHavingClausePredicate(nullptr)
+              .Build();
+  }
+  // Make the checkers
+  // Each key in [0, 9] and NULL is a group of its own, and every row is counted once
+  std::vector<bool> seen_keys(10, false);
+  int64_t num_null_groups{0};
+  int64_t total_count{0};
+  RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+    auto col2 = static_cast<sql::Integer *>(vals[0]);
+    auto count_col1 = static_cast<sql::Integer *>(vals[1]);
+    ASSERT_FALSE(count_col1->is_null_);
+    ASSERT_GT(count_col1->val_, 0);
+    total_count += count_col1->val_;
+    if (col2->is_null_) {
+      num_null_groups++;
+      return;
+    }
+    ASSERT_GE(col2->val_, 0);
+    ASSERT_LT(col2->val_, 10);
+    ASSERT_FALSE(seen_keys[col2->val_]);
+    seen_keys[col2->val_] = true;
+  };
+  CorrectnessFn correcteness_fn = [&]() {
+    EXPECT_EQ(num_null_groups, 1);
+    EXPECT_EQ(total_count, sql::TEST2_SIZE);
+  };
+  GenericChecker checker(row_checker, correcteness_fn);
+
+  // Compile and Run
+  OutputStore store{&checker, agg->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(agg->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), agg->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(agg), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, StaleStatsDenseAggregateTest) {
+  // SELECT col1, COUNT(col1) FROM test_1 GROUP BY col1;
+  // The statistics of col1 cover only half of its values, so that the other half falls outside of the directly
+  // addressed key range and is hashed.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  auto cola_oid = table_schema.GetColumn("colA").Oid();
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", col1);
+    auto schema = seq_scan_out.MakeSchema();
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetScanPredicate(nullptr)
+                   .SetIsForUpdateFlag(false)
+                   .SetNamespaceOid(NSOid())
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  std::unique_ptr<planner::AbstractPlanNode> agg;
+  OutputSchemaHelper agg_out{0, &expr_maker};
+  {
+    auto col1 = seq_scan_out.GetOutput("col1");
+    agg_out.AddGroupByTerm("col1", col1);
+    agg_out.AddAggTerm("count_col1", expr_maker.AggCount(col1));
+    agg_out.AddOutput("col1", agg_out.GetGroupByTermForOutput("col1"));
+    agg_out.AddOutput("count_col1", agg_out.GetAggTermForOutput("count_col1"));
+    auto schema = agg_out.MakeSchema();
+    planner::AggregatePlanNode::Builder builder;
+    agg = builder.SetOutputSchema(std::move(schema))
+              .AddGroupByTerm(agg_out.GetGroupByTerm("col1"))
+              .AddAggregateTerm(agg_out.GetAggTerm("count_col1"))
+              .AddChild(std::move(seq_scan))
+              .SetAggregateStrategyType(planner::AggregateStrategyType::HASH)
+              .SetHavingClausePredicate(nullptr)
+              .Build();
+  }
+  // Every key is a group of its own, counted once
+  std::vector<bool> seen_keys(sql::TEST1_SIZE, false);
+  uint32_t num_groups{0};
+  RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto count_col1 = static_cast<sql::Integer *>(vals[1]);
+    ASSERT_FALSE(col1->is_null_);
+    ASSERT_GE(col1->val_, 0);
+    ASSERT_LT(col1->val_, sql::TEST1_SIZE);
+    ASSERT_FALSE(seen_keys[col1->val_]);
+    seen_keys[col1->val_] = true;
+    ASSERT_EQ(count_col1->val_, 1);
+    num_groups++;
+  };
+  CorrectnessFn correcteness_fn = [&]() { EXPECT_EQ(num_groups, sql::TEST1_SIZE); };
+  GenericChecker checker(row_checker, correcteness_fn);
+
+  // Compile and Run, with statistics that cover [0, TEST1_SIZE / 2)
+  OutputStore store{&checker, agg->GetOutputSchema().Get()};
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), agg->GetOutputSchema().Get());
+  optimizer::StatsStorage stats_storage;
+  const double max_bound = sql::TEST1_SIZE / 2 - 1;
+  optimizer::ColumnStats col_stats(exec_ctx->DBOid(), table_oid, cola_oid, sql::TEST1_SIZE, sql::TEST1_SIZE, 0.0, {},
+                                   {}, {0.0, max_bound / 2, max_bound}, true);
+  optimizer::TableStats table_stats(exec_ctx->DBOid(), table_oid, sql::TEST1_SIZE, true, {col_stats});
+  stats_storage.InsertTableStats(exec_ctx->DBOid(), table_oid, std::move(table_stats));
+  exec_ctx->SetStatsStorage(common::ManagedPointer(&stats_storage));
+  auto executable = ExecutableQuery(common::ManagedPointer(agg), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleHashJoinTest) {
+  // SELECT t1.col1, t2.col1, t2.col2, t1.col1 + t2.col2 FROM t1 INNER JOIN t2 ON t1.col1=t2.col1
+  // WHERE t1.col1 < 500 AND t2.col1 < 80
+  // TODO(Amadou): Simple join tests are very similar. Some refactoring is possible.
+  // Get accessor
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
+  auto table_schema1 = accessor->GetSchema(table_oid1);
+  auto table_schema2 = accessor->GetSchema(table_oid2);
+
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
+  OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema1.GetColumn("colA").Oid();
+    auto colb_oid = table_schema1.GetColumn("colB").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    seq_scan_out1.AddOutput("col1", col1);
+    seq_scan_out1.AddOutput("col2", col2);
+    auto schema = seq_scan_out1.MakeSchema();
+    // Make predicate
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(1000));
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan1 = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({cola_oid, colb_oid})
+                    .SetScanPredicate(predicate)
+                    .SetIsForUpdateFlag(false)
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid1)
+                    .Build();
+  }
+  // Make the second seq scan
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
+  OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema2.GetColumn("col1").Oid();
+    auto colb_oid = table_schema2.GetColumn("col2").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::SMALLINT);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    seq_scan_out2.AddOutput("col1", col1);
+    seq_scan_out2.AddOutput("col2", col2);
+    auto schema = seq_scan_out2.MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(80));
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan2 = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({cola_oid, colb_oid})
+                    .SetScanPredicate(predicate)
+                    .SetIsForUpdateFlag(false)
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid2)
+                    .Build();
+  }
+  // Make hash join
+  std::unique_ptr<planner::AbstractPlanNode> hash_join;
+  OutputSchemaHelper hash_join_out{0, &expr_maker};
+  {
     // t1.col1, and t1.col2
     auto t1_col1 = seq_scan_out1.GetOutput("col1");
     // t2.col1 and t2.col2
@@ -863,6 +1714,430 @@ TEST_F(CompilerTest, SimpleHashJoinTest) {
   checker.CheckCorrectness();
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, OuterAndSemiHashJoinTest) {
+  // SELECT t1.col1, t2.col1 FROM t1 <JOIN> t2 ON t1.col1=t2.col1
+  // WHERE t1.col1 >= 40 AND t1.col1 < 120 AND t2.col1 < 80
+  // Keys 40..79 match, build keys 80..119 and probe keys 0..39 do not.
+  // Semi and anti joins only output t1.col1.
+  auto accessor = MakeAccessor();
+  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
+  auto table_schema1 = accessor->GetSchema(table_oid1);
+  auto table_schema2 = accessor->GetSchema(table_oid2);
+
+  const std::vector<std::pair<planner::LogicalJoinType, uint32_t>> join_types{
+      {planner::LogicalJoinType::LEFT, 80}, {planner::LogicalJoinType::RIGHT, 80},
+      {planner::LogicalJoinType::OUTER, 120}, {planner::LogicalJoinType::SEMI, 40},
+      {planner::LogicalJoinType::ANTI, 40}};
+  for (const auto &[join_type, num_expected_rows] : join_types) {
+    ExpressionMaker expr_maker;
+    std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
+    OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+    {
+      auto cola_oid = table_schema1.GetColumn("colA").Oid();
+      auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+      seq_scan_out1.AddOutput("col1", col1);
+      auto schema = seq_scan_out1.MakeSchema();
+      auto predicate = expr_maker.ConjunctionAnd(expr_maker.ComparisonGe(col1, expr_maker.Constant(40)),
+                                                 expr_maker.ComparisonLt(col1, expr_maker.Constant(120)));
+      planner::SeqScanPlanNode::Builder builder;
+      seq_scan1 = builder.SetOutputSchema(std::move(schema))
+                      .SetColumnOids({cola_oid})
+                      .SetScanPredicate(predicate)
+                      .SetIsForUpdateFlag(false)
+                      .SetNamespaceOid(NSOid())
+                      .SetTableOid(table_oid1)
+                      .Build();
+    }
+    std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
+    OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+    {
+      auto col1_oid = table_schema2.GetColumn("col1").Oid();
+      auto col1 = expr_maker.CVE(col1_oid, type::TypeId::SMALLINT);
+      seq_scan_out2.AddOutput("col1", col1);
+      auto schema = seq_scan_out2.MakeSchema();
+      auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(80));
+      planner::SeqScanPlanNode::Builder builder;
+      seq_scan2 = builder.SetOutputSchema(std::move(schema))
+                      .SetColumnOids({col1_oid})
+                      .SetScanPredicate(predicate)
+                      .SetIsForUpdateFlag(false)
+                      .SetNamespaceOid(NSOid())
+                      .SetTableOid(table_oid2)
+                      .Build();
+    }
+    const bool build_side_only = join_type == planner::LogicalJoinType::SEMI ||
+                                 join_type == planner::LogicalJoinType::ANTI;
+    std::unique_ptr<planner::AbstractPlanNode> hash_join;
+    OutputSchemaHelper hash_join_out{0, &expr_maker};
+    {
+      auto t1_col1 = seq_scan_out1.GetOutput("col1");
+      auto t2_col1 = seq_scan_out2.GetOutput("col1");
+      hash_join_out.AddOutput("t1.col1", t1_col1);
+      if (!build_side_only) hash_join_out.AddOutput("t2.col1", t2_col1);
+      auto schema = hash_join_out.MakeSchema();
+      planner::HashJoinPlanNode::Builder builder;
+      hash_join = builder.AddChild(std::move(seq_scan1))
+                      .AddChild(std::move(seq_scan2))
+                      .SetOutputSchema(std::move(schema))
+                      .AddLeftHashKey(t1_col1)
+                      .AddRightHashKey(t2_col1)
+                      .SetJoinType(join_type)
+                      .SetJoinPredicate(expr_maker.ComparisonEq(t1_col1, t2_col1))
+                      .Build();
+    }
+
+    // Matched rows have equal join columns, unmatched rows have a NULL on the side without a match
+    uint32_t num_output_rows{0};
+    RowChecker row_checker = [&num_output_rows, num_expected_rows = num_expected_rows, join_type = join_type,
+                              build_side_only](const std::vector<sql::Val *> &vals) {
+      auto t1_col1 = static_cast<sql::Integer *>(vals[0]);
+      if (build_side_only) {
+        ASSERT_FALSE(t1_col1->is_null_);
+        if (join_type == planner::LogicalJoinType::SEMI) {
+          ASSERT_LT(t1_col1->val_, 80);
+        } else {
+          ASSERT_GE(t1_col1->val_, 80);
+        }
+      } else {
+        auto t2_col1 = static_cast<sql::Integer *>(vals[1]);
+        ASSERT_FALSE(t1_col1->is_null_ && t2_col1->is_null_);
+        if (t1_col1->is_null_) {
+          ASSERT_NE(join_type, planner::LogicalJoinType::LEFT);
+          ASSERT_LT(t2_col1->val_, 40);
+        } else if (t2_col1->is_null_) {
+          ASSERT_NE(join_type, planner::LogicalJoinType::RIGHT);
+          ASSERT_GE(t1_col1->val_, 80);
+        } else {
+          ASSERT_EQ(t1_col1->val_, t2_col1->val_);
+        }
+      }
+      num_output_rows++;
+      ASSERT_LE(num_output_rows, num_expected_rows);
+    };
+    CorrectnessFn correcteness_fn = [&num_output_rows, num_expected_rows = num_expected_rows]() {
+      ASSERT_EQ(num_output_rows, num_expected_rows);
+    };
+
+    GenericChecker checker(row_checker, correcteness_fn);
+
+    OutputStore store{&checker, hash_join->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(hash_join->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), hash_join->GetOutputSchema().Get());
+
+    // Run & Check
+    auto executable = ExecutableQuery(common::ManagedPointer(hash_join), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    checker.CheckCorrectness();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SpillingHashJoinTest) {
+  // SELECT t1.col1, t2.col1 FROM t1 <JOIN> t2 ON t1.col1=t2.col1
+  // The 10000 build rows do not fit in the query's memory limit, so most partitions spill along with their probe
+  // tuples. Keys 0..999 match, build keys 1000..9999 do not.
+  auto accessor = MakeAccessor();
+  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
+  auto table_schema1 = accessor->GetSchema(table_oid1);
+  auto table_schema2 = accessor->GetSchema(table_oid2);
+
+  const std::vector<std::pair<planner::LogicalJoinType, uint32_t>> join_types{
+      {planner::LogicalJoinType::INNER, sql::TEST2_SIZE},
+      {planner::LogicalJoinType::LEFT, sql::TEST1_SIZE},
+      {planner::LogicalJoinType::RIGHT, sql::TEST2_SIZE},
+      {planner::LogicalJoinType::SEMI, sql::TEST2_SIZE}};
+  for (const auto &[join_type, num_expected_rows] : join_types) {
+    ExpressionMaker expr_maker;
+    std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
+    OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+    {
+      auto cola_oid = table_schema1.GetColumn("colA").Oid();
+      auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+      seq_scan_out1.AddOutput("col1", col1);
+      auto schema = seq_scan_out1.MakeSchema();
+      planner::SeqScanPlanNode::Builder builder;
+      seq_scan1 = builder.SetOutputSchema(std::move(schema))
+                      .SetColumnOids({cola_oid})
+                      .SetScanPredicate(expr_maker.ComparisonGe(col1, expr_maker.Constant(0)))
+                      .SetIsForUpdateFlag(false)
+                      .SetNamespaceOid(NSOid())
+                      .SetTableOid(table_oid1)
+                      .Build();
+    }
+    std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
+    OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+    {
+      auto col1_oid = table_schema2.GetColumn("col1").Oid();
+      auto col1 = expr_maker.CVE(col1_oid, type::TypeId::SMALLINT);
+      seq_scan_out2.AddOutput("col1", col1);
+      auto schema = seq_scan_out2.MakeSchema();
+      planner::SeqScanPlanNode::Builder builder;
+      seq_scan2 = builder.SetOutputSchema(std::move(schema))
+                      .SetColumnOids({col1_oid})
+                      .SetScanPredicate(expr_maker.ComparisonGe(col1, expr_maker.Constant(0)))
+                      .SetIsForUpdateFlag(false)
+                      .SetNamespaceOid(NSOid())
+                      .SetTableOid(table_oid2)
+                      .Build();
+    }
+    const bool build_side_only = join_type == planner::LogicalJoinType::SEMI;
+    std::unique_ptr<planner::AbstractPlanNode> hash_join;
+    OutputSchemaHelper hash_join_out{0, &expr_maker};
+    {
+      auto t1_col1 = seq_scan_out1.GetOutput("col1");
+      auto t2_col1 = seq_scan_out2.GetOutput("col1");
+      hash_join_out.AddOutput("t1.col1", t1_col1);
+      if (!build_side_only) hash_join_out.AddOutput("t2.col1", t2_col1);
+      auto schema = hash_join_out.MakeSchema();
+      planner::HashJoinPlanNode::Builder builder;
+      hash_join = builder.AddChild(std::move(seq_scan1))
+                      .AddChild(std::move(seq_scan2))
+                      .SetOutputSchema(std::move(schema))
+                      .AddLeftHashKey(t1_col1)
+                      .AddRightHashKey(t2_col1)
+                      .SetJoinType(join_type)
+                      .SetJoinPredicate(expr_maker.ComparisonEq(t1_col1, t2_col1))
+                      .Build();
+    }
+
+    // Every key is output exactly once, matched to itself or, for unmatched build keys, to NULL
+    std::vector<bool> seen(sql::TEST1_SIZE, false);
+    uint32_t num_output_rows{0};
+    RowChecker row_checker = [&seen, &num_output_rows, num_expected_rows = num_expected_rows,
+                              build_side_only](const std::vector<sql::Val *> &vals) {
+      auto t1_col1 = static_cast<sql::Integer *>(vals[0]);
+      ASSERT_FALSE(t1_col1->is_null_);
+      ASSERT_LT(t1_col1->val_, static_cast<int64_t>(sql::TEST1_SIZE));
+      if (!build_side_only) {
+        auto t2_col1 = static_cast<sql::Integer *>(vals[1]);
+        if (t2_col1->is_null_) {
+          ASSERT_GE(t1_col1->val_, static_cast<int64_t>(sql::TEST2_SIZE));
+        } else {
+          ASSERT_EQ(t1_col1->val_, t2_col1->val_);
+        }
+      }
+      ASSERT_FALSE(seen[t1_col1->val_]);
+      seen[t1_col1->val_] = true;
+      num_output_rows++;
+      ASSERT_LE(num_output_rows, num_expected_rows);
+    };
+    CorrectnessFn correcteness_fn = [&num_output_rows, num_expected_rows = num_expected_rows]() {
+      ASSERT_EQ(num_output_rows, num_expected_rows);
+    };
+
+    GenericChecker checker(row_checker, correcteness_fn);
+
+    OutputStore store{&checker, hash_join->GetOutputSchema().Get()};
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), hash_join->GetOutputSchema().Get());
+    exec_ctx->SetMemoryLimit(64 * 1024);
+
+    // Run & Check
+    auto executable = ExecutableQuery(common::ManagedPointer(hash_join), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    checker.CheckCorrectness();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, HashJoinReportBuildRowsTest) {
+  // SELECT t1.col1 FROM t1 INNER JOIN t2 ON t1.col1=t2.col1 WHERE t1.col1 < 500 AND t2.col1 < 80
+  // The join reports the 500 rows of its build side under the fragment key of the build child, to the statistics of
+  // the execution context that runs the query rather than the one that compiled it.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
+  auto table_schema1 = accessor->GetSchema(table_oid1);
+  auto table_schema2 = accessor->GetSchema(table_oid2);
+  const common::hash_t build_key = 0xb1d;
+  const common::hash_t probe_key = 0x960be;
+
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
+  OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+  {
+    auto cola_oid = table_schema1.GetColumn("colA").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out1.AddOutput("col1", col1);
+    auto schema = seq_scan_out1.MakeSchema();
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan1 = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({cola_oid})
+                    .SetScanPredicate(expr_maker.ComparisonLt(col1, expr_maker.Constant(500)))
+                    .SetIsForUpdateFlag(false)
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid1)
+                    .Build();
+    seq_scan1->SetCardinalityEstimate(build_key, 10);
+  }
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
+  OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+  {
+    auto col1_oid = table_schema2.GetColumn("col1").Oid();
+    auto col1 = expr_maker.CVE(col1_oid, type::TypeId::SMALLINT);
+    seq_scan_out2.AddOutput("col1", col1);
+    auto schema = seq_scan_out2.MakeSchema();
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan2 = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({col1_oid})
+                    .SetScanPredicate(expr_maker.ComparisonLt(col1, expr_maker.Constant(80)))
+                    .SetIsForUpdateFlag(false)
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid2)
+                    .Build();
+    seq_scan2->SetCardinalityEstimate(probe_key, 10);
+  }
+  std::unique_ptr<planner::AbstractPlanNode> hash_join;
+  OutputSchemaHelper hash_join_out{0, &expr_maker};
+  {
+    auto t1_col1 = seq_scan_out1.GetOutput("col1");
+    auto t2_col1 = seq_scan_out2.GetOutput("col1");
+    hash_join_out.AddOutput("t1.col1", t1_col1);
+    auto schema = hash_join_out.MakeSchema();
+    planner::HashJoinPlanNode::Builder builder;
+    hash_join = builder.AddChild(std::move(seq_scan1))
+                    .AddChild(std::move(seq_scan2))
+                    .SetOutputSchema(std::move(schema))
+                    .AddLeftHashKey(t1_col1)
+                    .AddRightHashKey(t2_col1)
+                    .SetJoinType(planner::LogicalJoinType::INNER)
+                    .SetJoinPredicate(expr_maker.ComparisonEq(t1_col1, t2_col1))
+                    .Build();
+  }
+
+  // Compile
+  auto compile_ctx = MakeExecCtx();
+  auto executable = ExecutableQuery(common::ManagedPointer(hash_join), common::ManagedPointer(compile_ctx));
+
+  // Run & Check
+  optimizer::StatsStorage stats_storage;
+  NumChecker checker{80};
+  OutputStore store{&checker, hash_join->GetOutputSchema().Get()};
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), hash_join->GetOutputSchema().Get());
+  exec_ctx->SetStatsStorage(common::ManagedPointer(&stats_storage));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+
+  // Only the build side is a pipeline breaker that counts its rows
+  auto feedback = stats_storage.GetCardinalityFeedback();
+  EXPECT_EQ(feedback->GetLearnedRows(build_key), 500);
+  EXPECT_EQ(feedback->GetLearnedRows(probe_key), -1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleMergeJoinTest) {
+  // SELECT t1.colA, t1.colB, t2.col1 FROM test_1 AS t1 INNER JOIN test_2 AS t2 ON t1.colB=t2.col1
+  // WHERE t1.colA < 1000 AND t2.col1 BETWEEN 0 AND 19
+  // t1 is sorted by the join on colB, whose values 0..9 repeat. t2 arrives sorted by an ascending index scan.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
+  auto index_oid2 = accessor->GetIndexOid(NSOid(), "index_2");
+  auto table_schema1 = accessor->GetSchema(table_oid1);
+  auto table_schema2 = accessor->GetSchema(table_oid2);
+
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
+  OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+  {
+    auto cola_oid = table_schema1.GetColumn("colA").Oid();
+    auto colb_oid = table_schema1.GetColumn("colB").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    seq_scan_out1.AddOutput("col1", col1);
+    seq_scan_out1.AddOutput("col2", col2);
+    auto schema = seq_scan_out1.MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(1000));
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan1 = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({cola_oid, colb_oid})
+                    .SetScanPredicate(predicate)
+                    .SetIsForUpdateFlag(false)
+                    .SetNamespaceOid(NSOid())
+                    .SetTableOid(table_oid1)
+                    .Build();
+  }
+  // Make the ordered index scan
+  std::unique_ptr<planner::AbstractPlanNode> index_scan2;
+  OutputSchemaHelper index_scan_out2{1, &expr_maker};
+  {
+    auto col1_oid = table_schema2.GetColumn("col1").Oid();
+    auto col1 = expr_maker.CVE(col1_oid, type::TypeId::SMALLINT);
+    index_scan_out2.AddOutput("col1", col1);
+    auto schema = index_scan_out2.MakeSchema();
+    planner::IndexScanPlanNode::Builder builder;
+    index_scan2 = builder.SetTableOid(table_oid2)
+                      .SetColumnOids({col1_oid})
+                      .SetIndexOid(index_oid2)
+                      .AddLoIndexColumn(catalog::indexkeycol_oid_t(1), expr_maker.Constant(0))
+                      .AddHiIndexColumn(catalog::indexkeycol_oid_t(1), expr_maker.Constant(19))
+                      .SetNamespaceOid(NSOid())
+                      .SetOutputSchema(std::move(schema))
+                      .SetScanType(planner::IndexScanType::Ascending)
+                      .SetScanLimit(0)
+                      .SetScanPredicate(nullptr)
+                      .Build();
+  }
+  // Make merge join
+  std::unique_ptr<planner::AbstractPlanNode> merge_join;
+  OutputSchemaHelper merge_join_out{0, &expr_maker};
+  {
+    auto t1_col1 = seq_scan_out1.GetOutput("col1");
+    auto t1_col2 = seq_scan_out1.GetOutput("col2");
+    auto t2_col1 = index_scan_out2.GetOutput("col1");
+    merge_join_out.AddOutput("t1.col1", t1_col1);
+    merge_join_out.AddOutput("t1.col2", t1_col2);
+    merge_join_out.AddOutput("t2.col1", t2_col1);
+    auto schema = merge_join_out.MakeSchema();
+    auto predicate = expr_maker.ComparisonEq(t1_col2, t2_col1);
+    planner::MergeJoinPlanNode::Builder builder;
+    merge_join = builder.AddChild(std::move(seq_scan1))
+                     .AddChild(std::move(index_scan2))
+                     .SetOutputSchema(std::move(schema))
+                     .AddLeftMergeKey(t1_col2)
+                     .AddRightMergeKey(t2_col1)
+                     .SetJoinType(planner::LogicalJoinType::INNER)
+                     .SetJoinPredicate(predicate)
+                     .Build();
+  }
+  // Every t1 row matches one of the t2 keys 0..9, so all 1000 of them are output, in join key order.
+  uint32_t num_output_rows{0};
+  uint32_t num_expected_rows{1000};
+  int64_t curr_key{std::numeric_limits<int64_t>::min()};
+  RowChecker row_checker = [&num_output_rows, num_expected_rows, &curr_key](const std::vector<sql::Val *> &vals) {
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto col2 = static_cast<sql::Integer *>(vals[1]);
+    auto col3 = static_cast<sql::Integer *>(vals[2]);
+    ASSERT_FALSE(col1->is_null_ || col2->is_null_ || col3->is_null_);
+    // Check join cols
+    ASSERT_EQ(col2->val_, col3->val_);
+    // Check that the output is sorted on the join key
+    ASSERT_LE(curr_key, col3->val_);
+    curr_key = col3->val_;
+    num_output_rows++;
+    ASSERT_LE(num_output_rows, num_expected_rows);
+  };
+  CorrectnessFn correcteness_fn = [&num_output_rows, num_expected_rows]() {
+    ASSERT_EQ(num_output_rows, num_expected_rows);
+  };
+  GenericChecker checker(row_checker, correcteness_fn);
+
+  OutputStore store{&checker, merge_join->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(merge_join->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), merge_join->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(merge_join), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleSortTest) {
   // SELECT col1, col2, col1 + col2 FROM test_1 WHERE col1 < 500 ORDER BY col2 ASC, col1 - col2 DESC
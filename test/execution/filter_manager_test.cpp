@@ -1,9 +1,7 @@
-#include <chrono>  // NOLINT
 #include <limits>
 #include <memory>
 #include <numeric>
 #include <random>
-#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -34,6 +32,12 @@ class FilterManagerTest : public SqlBasedTest {
 
 enum Col : uint8_t { A = 0, B = 1, C = 2, D = 3 };
 
+// The clauses below advance this clock by the milliseconds they pretend to take, so that the costs the filter
+// manager measures with FakeClock() are deterministic
+double fake_clock_ms = 0.0;
+
+double FakeClock() { return fake_clock_ms; }
+
 uint32_t TaaTLt500(ProjectedColumnsIterator *pci) {
   pci->RunFilter([pci]() -> bool {
     auto cola = *pci->Get<int32_t, false>(Col::A, nullptr);
@@ -43,15 +47,41 @@ uint32_t TaaTLt500(ProjectedColumnsIterator *pci) {
 }
 
 uint32_t HobbledTaaTLt500(ProjectedColumnsIterator *pci) {
-  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  fake_clock_ms += 50.0;
   return TaaTLt500(pci);
 }
 
 uint32_t VectorizedLt500(ProjectedColumnsIterator *pci) {
+  fake_clock_ms += 0.01;
   ProjectedColumnsIterator::FilterVal param{.i_ = 500};
   return pci->FilterColByVal<std::less>(Col::A, type::TypeId ::INTEGER, param);
 }
 
+uint32_t HobbledTaaTGe0(ProjectedColumnsIterator *pci) {
+  fake_clock_ms += 1.0;
+  pci->RunFilter([pci]() -> bool {
+    auto cola = *pci->Get<int32_t, false>(Col::A, nullptr);
+    return cola >= 0;
+  });
+  return pci->NumSelected();
+}
+
+uint32_t VectorizedLt0(ProjectedColumnsIterator *pci) {
+  fake_clock_ms += 0.01;
+  ProjectedColumnsIterator::FilterVal param{.i_ = 0};
+  return pci->FilterColByVal<std::less>(Col::A, type::TypeId ::INTEGER, param);
+}
+
+// Lets every tuple through at a high cost until the data "changes", after which it cheaply discards every tuple
+bool drifted = false;
+
+uint32_t DriftingGe0(ProjectedColumnsIterator *pci) {
+  if (!drifted) return HobbledTaaTGe0(pci);
+  fake_clock_ms += 0.001;
+  ProjectedColumnsIterator::FilterVal param{.i_ = 0};
+  return pci->FilterColByVal<std::less>(Col::A, type::TypeId ::INTEGER, param);
+}
+
 // NOLINTNEXTLINE
 TEST_F(FilterManagerTest, SimpleFilterManagerTest) {
   FilterManager filter(bandit::Policy::Kind::FixedAction);
@@ -78,7 +108,7 @@ TEST_F(FilterManagerTest, SimpleFilterManagerTest) {
 
 // NOLINTNEXTLINE
 TEST_F(FilterManagerTest, AdaptiveFilterManagerTest) {
-  FilterManager filter(bandit::Policy::Kind::EpsilonGreedy);
+  FilterManager filter(bandit::Policy::Kind::EpsilonGreedy, FakeClock);
   filter.StartNewClause();
   filter.InsertClauseFlavor(HobbledTaaTLt500);
   filter.InsertClauseFlavor(VectorizedLt500);
@@ -103,4 +133,79 @@ TEST_F(FilterManagerTest, AdaptiveFilterManagerTest) {
   EXPECT_EQ(1u, filter.GetOptimalFlavorForClause(0));
 }
 
+// NOLINTNEXTLINE
+TEST_F(FilterManagerTest, ClauseReorderingTest) {
+  // The first clause is expensive and lets every tuple through; the second is
+  // cheap and selective, so it should be moved to the front
+  FilterManager filter(bandit::Policy::Kind::FixedAction, FakeClock);
+  filter.StartNewClause();
+  filter.InsertClauseFlavor(HobbledTaaTGe0);
+  filter.StartNewClause();
+  filter.InsertClauseFlavor(VectorizedLt500);
+  filter.Finalize();
+  EXPECT_EQ(std::vector<uint32_t>({0, 1}), filter.GetClauseOrder());
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  std::array<uint32_t, 1> col_oids{1};
+  for (uint32_t pass = 0; pass < 4; pass++) {
+    TableVectorIterator tvi(exec_ctx_.get(), !table_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size()));
+    uint32_t num_selected = 0;
+    for (tvi.Init(); tvi.Advance();) {
+      auto *pci = tvi.GetProjectedColumnsIterator();
+
+      // Run the filters
+      filter.RunFilters(pci);
+
+      // Check
+      pci->ForEach([pci, &num_selected]() {
+        auto cola = *pci->Get<int32_t, false>(Col::A, nullptr);
+        EXPECT_LT(cola, 500);
+        num_selected++;
+      });
+    }
+    // Reordering must not change the result
+    EXPECT_EQ(500u, num_selected);
+  }
+
+  EXPECT_EQ(std::vector<uint32_t>({1, 0}), filter.GetClauseOrder());
+  EXPECT_DOUBLE_EQ(1.0, filter.GetClauseSelectivity(0));
+  EXPECT_LT(filter.GetClauseSelectivity(1), 1.0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(FilterManagerTest, StaleClauseStatsTest) {
+  // The first clause discards every tuple, so the second one only runs when it
+  // is moved to the front to be measured. Once the second clause becomes the
+  // cheaper of the two, it must be measured again and moved to the front.
+  FilterManager filter(bandit::Policy::Kind::FixedAction, FakeClock);
+  filter.StartNewClause();
+  filter.InsertClauseFlavor(VectorizedLt0);
+  filter.StartNewClause();
+  filter.InsertClauseFlavor(DriftingGe0);
+  filter.Finalize();
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  std::array<uint32_t, 1> col_oids{1};
+  const auto run_passes = [&](uint32_t num_passes) {
+    for (uint32_t pass = 0; pass < num_passes; pass++) {
+      TableVectorIterator tvi(exec_ctx_.get(), !table_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size()));
+      for (tvi.Init(); tvi.Advance();) {
+        auto *pci = tvi.GetProjectedColumnsIterator();
+        filter.RunFilters(pci);
+        EXPECT_EQ(0u, pci->NumSelected());
+      }
+    }
+  };
+
+  drifted = false;
+  run_passes(4);
+  EXPECT_EQ(std::vector<uint32_t>({0, 1}), filter.GetClauseOrder());
+  EXPECT_DOUBLE_EQ(1.0, filter.GetClauseSelectivity(1));
+
+  drifted = true;
+  run_passes(2);
+  EXPECT_EQ(std::vector<uint32_t>({1, 0}), filter.GetClauseOrder());
+  EXPECT_DOUBLE_EQ(0.0, filter.GetClauseSelectivity(1));
+}
+
 }  // namespace terrier::execution::sql::test
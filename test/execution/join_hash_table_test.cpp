@@ -6,6 +6,7 @@
 #include <tbb/tbb.h>  // NOLINT
 
 #include "execution/sql/join_hash_table.h"
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/hash.h"
 
@@ -189,6 +190,209 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
   main_jht.MergeParallel(&container, 0);
 }
 
+/**
+ * Probe every key in [0, num_tuples) against a possibly spilled join hash
+ * table, and check that each key finds exactly @em dup_scale_factor matches.
+ */
+template <bool UseConciseHashTable>
+void ProbeSpilledJoinHashTable(JoinHashTable *jht, uint32_t num_tuples, uint32_t dup_scale_factor) {
+  std::vector<uint32_t> counts(num_tuples, 0);
+
+  const auto probe = [&](hash_t hash_val, Tuple *probe_tuple) {
+    for (auto iter = jht->Lookup<UseConciseHashTable>(hash_val);
+         iter.HasNext(TupleKeyEq, nullptr, reinterpret_cast<void *>(probe_tuple));) {
+      auto *matched = reinterpret_cast<const Tuple *>(iter.NextMatch()->payload_);
+      EXPECT_EQ(probe_tuple->a_, matched->a_);
+      counts[probe_tuple->a_]++;
+    }
+  };
+
+  // In-memory probe, spilling probe tuples that belong to spilled partitions
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    auto hash_val = util::Hasher::Hash(reinterpret_cast<const uint8_t *>(&i), sizeof(i));
+    Tuple probe_tuple = {i, 0, 0, 0};
+    if (jht->IsPartitionSpilled(hash_val)) {
+      jht->SpillProbeTuple(hash_val, &probe_tuple, sizeof(Tuple));
+    } else {
+      probe(hash_val, &probe_tuple);
+    }
+  }
+
+  // Join spilled partitions one at a time
+  while (jht->NextSpilledPartition()) {
+    EXPECT_TRUE(jht->IsBuilt());
+    auto reader = jht->ReadSpilledProbeTuples();
+    for (auto *entry = reinterpret_cast<const HashTableEntry *>(reader.Next()); entry != nullptr;
+         entry = reinterpret_cast<const HashTableEntry *>(reader.Next())) {
+      Tuple probe_tuple = *reinterpret_cast<const Tuple *>(entry->payload_);
+      probe(entry->hash_, &probe_tuple);
+    }
+  }
+
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    EXPECT_EQ(dup_scale_factor, counts[i]) << "Key [" << i << "] found " << counts[i] << " matches";
+  }
+}
+
+template <bool UseConciseHashTable>
+void SpillBuildAndProbeTest(uint32_t num_tuples, uint32_t dup_scale_factor) {
+  MemoryPool memory(nullptr);
+  JoinHashTable join_hash_table(&memory, sizeof(Tuple), UseConciseHashTable);
+
+  // Allow only a tenth of the input to stay in memory
+  const uint64_t entry_size = sizeof(HashTableEntry) + sizeof(Tuple);
+  join_hash_table.SetMemoryBudget(num_tuples * dup_scale_factor * entry_size / 10);
+
+  PopulateJoinHashTable(&join_hash_table, num_tuples, dup_scale_factor);
+  join_hash_table.Build();
+
+  EXPECT_TRUE(join_hash_table.HasSpilled());
+  EXPECT_EQ(num_tuples * dup_scale_factor, join_hash_table.NumElements() + join_hash_table.NumSpilledElements());
+  EXPECT_LE(join_hash_table.NumElements(), num_tuples * dup_scale_factor / 10);
+
+  ProbeSpilledJoinHashTable<UseConciseHashTable>(&join_hash_table, num_tuples, dup_scale_factor);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillTest) { SpillBuildAndProbeTest<false>(20000, 3); }
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillConciseTableTest) { SpillBuildAndProbeTest<true>(20000, 3); }
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillUnprobedPartitionsTest) {
+  const uint32_t num_tuples = 20000;
+  MemoryPool memory(nullptr);
+  JoinHashTable join_hash_table(&memory, sizeof(Tuple), false);
+  join_hash_table.SetMemoryBudget(num_tuples * (sizeof(HashTableEntry) + sizeof(Tuple)) / 10);
+  PopulateJoinHashTable(&join_hash_table, num_tuples, 1);
+  join_hash_table.Build();
+  ASSERT_TRUE(join_hash_table.HasSpilled());
+
+  // Without probe tuples, only joins producing unmatched build tuples visit the spilled partitions
+  const uint64_t num_spilled = join_hash_table.NumSpilledElements();
+  uint64_t num_visited = 0;
+  while (join_hash_table.NextSpilledPartition(true)) {
+    EXPECT_EQ(nullptr, join_hash_table.ReadSpilledProbeTuples().Next());
+    for (JoinHashTableEntryIterator iter(&join_hash_table); iter.HasNext(); iter.Next()) {
+      num_visited++;
+    }
+  }
+  EXPECT_EQ(num_spilled, num_visited);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, UnlimitedBudgetTest) {
+  const uint32_t num_tuples = 20000;
+
+  // The query is over its limit long before the table is populated, but the table must not spill
+  MemoryTracker tracker(num_tuples * (sizeof(HashTableEntry) + sizeof(Tuple)) / 10);
+  MemoryPool memory(&tracker);
+  JoinHashTable join_hash_table(&memory, sizeof(Tuple), false);
+  join_hash_table.SetMemoryBudget(MemoryTracker::K_UNLIMITED);
+  PopulateJoinHashTable(&join_hash_table, num_tuples, 1);
+  join_hash_table.Build();
+
+  EXPECT_FALSE(join_hash_table.HasSpilled());
+  EXPECT_EQ(num_tuples, join_hash_table.NumElements());
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, ParallelSpillTest) {
+  const uint32_t num_tuples = 100000;
+  const uint32_t num_thread_tables = 4;
+
+  // Limit the query's memory so that each thread-local table spills
+  MemoryTracker tracker(num_tuples * (sizeof(HashTableEntry) + sizeof(Tuple)) / 4);
+  MemoryPool memory(&tracker);
+  ThreadStateContainer container(&memory);
+
+  container.Reset(
+      sizeof(JoinHashTable),
+      [](auto *ctx, auto *s) { new (s) JoinHashTable(reinterpret_cast<MemoryPool *>(ctx), sizeof(Tuple)); },
+      [](auto *ctx, auto *s) { reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable(); }, &memory);
+
+  // Each table receives a disjoint range of the keys
+  tbb::task_scheduler_init sched;
+  tbb::parallel_for(tbb::blocked_range<uint32_t>(0, num_thread_tables, 1), [&](const auto &range) {
+    auto *jht = container.AccessThreadStateOfCurrentThreadAs<JoinHashTable>();
+    for (uint32_t t = range.begin(); t != range.end(); t++) {
+      for (uint32_t i = t; i < num_tuples; i += num_thread_tables) {
+        auto hash_val = util::Hasher::Hash(reinterpret_cast<const uint8_t *>(&i), sizeof(i));
+        reinterpret_cast<Tuple *>(jht->AllocInputTuple(hash_val))->a_ = i;
+      }
+    }
+  });
+
+  JoinHashTable main_jht(&memory, sizeof(Tuple), false);
+  main_jht.MergeParallel(&container, 0);
+  EXPECT_TRUE(main_jht.HasSpilled());
+
+  ProbeSpilledJoinHashTable<false>(&main_jht, num_tuples, 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, PartitionedParallelBuildTest) {
+  const uint32_t num_tuples = 100000;
+  const uint32_t num_thread_tables = 4;
+
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+
+  container.Reset(
+      sizeof(JoinHashTable),
+      [](auto *ctx, auto *s) { new (s) JoinHashTable(reinterpret_cast<MemoryPool *>(ctx), sizeof(Tuple)); },
+      [](auto *ctx, auto *s) { reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable(); }, &memory);
+
+  // Each key is inserted once per thread-local table
+  tbb::task_scheduler_init sched;
+  tbb::parallel_for(tbb::blocked_range<uint32_t>(0, num_thread_tables, 1), [&](const auto &range) {
+    auto *jht = container.AccessThreadStateOfCurrentThreadAs<JoinHashTable>();
+    for (uint32_t t = range.begin(); t != range.end(); t++) {
+      PopulateJoinHashTable(jht, num_tuples, 1);
+    }
+  });
+
+  JoinHashTable main_jht(&memory, sizeof(Tuple), false);
+  main_jht.SetMergeStrategy(JoinHashTable::MergeStrategy::Partitioned);
+  main_jht.MergeParallel(&container, 0);
+  EXPECT_EQ(num_tuples * num_thread_tables, GenericTableFor(&main_jht)->NumElements());
+
+  ProbeSpilledJoinHashTable<false>(&main_jht, num_tuples, num_thread_tables);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, BloomFilterTest) {
+  const uint32_t num_tuples = 20000;
+
+  for (const bool spill : {false, true}) {
+    MemoryPool memory(nullptr);
+    JoinHashTable join_hash_table(&memory, sizeof(Tuple));
+    if (spill) {
+      join_hash_table.SetMemoryBudget(num_tuples * (sizeof(HashTableEntry) + sizeof(Tuple)) / 4);
+    }
+    join_hash_table.EnableBloomFilter();
+    PopulateJoinHashTable(&join_hash_table, num_tuples, 1);
+    join_hash_table.Build();
+
+    EXPECT_TRUE(join_hash_table.HasBloomFilter());
+    EXPECT_EQ(spill, join_hash_table.HasSpilled());
+
+    // No false negatives, whether the key's partition is in memory or not. Few
+    // false positives for keys that aren't in the table.
+    uint32_t false_positives = 0;
+    for (uint32_t i = 0; i < num_tuples * 2; i++) {
+      auto hash_val = util::Hasher::Hash(reinterpret_cast<const uint8_t *>(&i), sizeof(i));
+      if (i < num_tuples) {
+        EXPECT_TRUE(join_hash_table.MayContain(hash_val)) << "Key [" << i << "] filtered out";
+      } else if (!join_hash_table.IsPartitionSpilled(hash_val) && join_hash_table.MayContain(hash_val)) {
+        false_positives++;
+      }
+    }
+    EXPECT_LT(false_positives, num_tuples / 10);
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, DISABLED_PerfTest) {
   const uint32_t num_tuples = 10000000;
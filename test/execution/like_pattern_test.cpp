@@ -0,0 +1,164 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "execution/tpl_test.h"
+
+#include "execution/sql/like_pattern.h"
+
+namespace terrier::execution::sql::test {
+
+class LikePatternTest : public TplTest {};
+
+namespace {
+
+// A straightforward recursive LIKE matcher to check against
+bool ReferenceMatch(std::string_view str, std::string_view pattern) {
+  if (pattern.empty()) return str.empty();
+  if (pattern[0] == '%') {
+    for (std::size_t i = 0; i <= str.size(); i++) {
+      if (ReferenceMatch(str.substr(i), pattern.substr(1))) return true;
+    }
+    return false;
+  }
+  std::size_t consumed = 1;
+  char c = pattern[0];
+  bool any = (c == '_');
+  if (c == '\\') {
+    c = pattern[1];
+    consumed = 2;
+  }
+  if (str.empty() || (!any && str[0] != c)) return false;
+  return ReferenceMatch(str.substr(1), pattern.substr(consumed));
+}
+
+storage::VarlenEntry MakeVarlen(const std::string &str) {
+  const auto *content = reinterpret_cast<const byte *>(str.data());
+  if (str.size() <= storage::VarlenEntry::InlineThreshold()) {
+    return storage::VarlenEntry::CreateInline(content, str.size());
+  }
+  return storage::VarlenEntry::Create(content, str.size(), false);
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, Classification) {
+  EXPECT_EQ(LikePattern::Kind::Exact, LikePattern("abc").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Exact, LikePattern("").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Exact, LikePattern("a\\%c").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Prefix, LikePattern("abc%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Prefix, LikePattern("abc%%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Prefix, LikePattern("%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Suffix, LikePattern("%abc").GetKind());
+  EXPECT_EQ(LikePattern::Kind::Contains, LikePattern("%abc%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::General, LikePattern("a%c").GetKind());
+  EXPECT_EQ(LikePattern::Kind::General, LikePattern("a_c%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::General, LikePattern("%a%b%").GetKind());
+
+  EXPECT_THROW(LikePattern("abc\\"), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, SimpleMatch) {
+  EXPECT_TRUE(LikePattern("abc").Matches("abc"));
+  EXPECT_FALSE(LikePattern("abc").Matches("abcd"));
+  EXPECT_TRUE(LikePattern("ab%").Matches("ab"));
+  EXPECT_TRUE(LikePattern("ab%").Matches("abcdefghijklmnopq"));
+  EXPECT_FALSE(LikePattern("ab%").Matches("a"));
+  EXPECT_TRUE(LikePattern("%yz").Matches("xyz"));
+  EXPECT_FALSE(LikePattern("%yz").Matches("yzx"));
+  EXPECT_TRUE(LikePattern("%needle%").Matches("a haystack containing a needle somewhere in the middle of it"));
+  EXPECT_FALSE(LikePattern("%needle%").Matches("a haystack containing a needl somewhere in the middle of it"));
+  EXPECT_TRUE(LikePattern("a_c").Matches("abc"));
+  EXPECT_FALSE(LikePattern("a_c").Matches("ac"));
+  EXPECT_TRUE(LikePattern("%a%b%c%").Matches("xxaxxbxxcxx"));
+  EXPECT_FALSE(LikePattern("%a%b%c%").Matches("xxcxxbxxaxx"));
+  EXPECT_TRUE(LikePattern("100\\%").Matches("100%"));
+  EXPECT_FALSE(LikePattern("100\\%").Matches("1000"));
+  EXPECT_TRUE(LikePattern("\\_%").Matches("_abc"));
+  EXPECT_FALSE(LikePattern("\\_%").Matches("abc"));
+  EXPECT_TRUE(LikePattern("%").Matches(""));
+  EXPECT_FALSE(LikePattern("_").Matches(""));
+
+  // Patterns too long for the NFA use the fallback matcher
+  const std::string long_pattern = "%" + std::string(70, '_') + "x";
+  EXPECT_TRUE(LikePattern(long_pattern).Matches(std::string(100, 'a') + "x"));
+  EXPECT_FALSE(LikePattern(long_pattern).Matches(std::string(10, 'a') + "x"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, RandomMatch) {
+  // Random strings and patterns over a small alphabet, so that matches are common
+  std::mt19937 gen;
+  std::uniform_int_distribution<uint32_t> len_dist(0, 40);
+  const std::string str_alphabet = "ab";
+  const std::string pattern_alphabet = "ab%_";
+
+  auto random_string = [&](const std::string &alphabet, uint32_t max_len) {
+    std::string result;
+    const uint32_t len = len_dist(gen) % (max_len + 1);
+    for (uint32_t i = 0; i < len; i++) {
+      result.push_back(alphabet[gen() % alphabet.size()]);
+    }
+    return result;
+  };
+
+  for (uint32_t i = 0; i < 2000; i++) {
+    const std::string pattern = random_string(pattern_alphabet, 8);
+    const LikePattern compiled(pattern);
+    for (uint32_t j = 0; j < 20; j++) {
+      const std::string str = random_string(str_alphabet, 40);
+      const bool expected = ReferenceMatch(str, pattern);
+      EXPECT_EQ(expected, compiled.Matches(str)) << "'" << str << "' LIKE '" << pattern << "'";
+      EXPECT_EQ(expected, compiled.Matches(MakeVarlen(str))) << "'" << str << "' LIKE '" << pattern << "'";
+      EXPECT_EQ(expected, LikePattern::Match(str, pattern)) << "'" << str << "' LIKE '" << pattern << "'";
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, FilterVector) {
+  constexpr uint32_t num_elems = 1000;
+
+  // Every third string is NULL
+  std::vector<std::string> strings;
+  std::vector<storage::VarlenEntry> entries;
+  common::RawBitmap *nulls = common::RawBitmap::Allocate(num_elems);
+  strings.reserve(num_elems);
+  for (uint32_t i = 0; i < num_elems; i++) {
+    strings.emplace_back((i % 2 == 0 ? "prefix_" : "other_") + std::to_string(i) + (i % 5 == 0 ? "_suffix" : ""));
+    entries.push_back(MakeVarlen(strings.back()));
+    nulls->Set(i, i % 3 != 0);
+  }
+
+  for (const char *pattern : {"prefix%", "pre%", "%suffix", "%_1%", "prefix_1_", "%1%0%"}) {
+    const LikePattern like(pattern);
+
+    for (const bool negated : {false, true}) {
+      // All elements
+      std::vector<uint32_t> out(num_elems);
+      const uint32_t count = like.FilterVector(entries.data(), nulls, num_elems, nullptr, out.data(), negated);
+      std::vector<uint32_t> expected;
+      for (uint32_t i = 0; i < num_elems; i++) {
+        if (i % 3 != 0 && ReferenceMatch(strings[i], pattern) != negated) expected.push_back(i);
+      }
+      EXPECT_EQ(expected, std::vector<uint32_t>(out.begin(), out.begin() + count)) << pattern;
+
+      // Only even elements, filtering the selection vector in place
+      std::vector<uint32_t> sel;
+      for (uint32_t i = 0; i < num_elems; i += 2) sel.push_back(i);
+      const uint32_t sel_count = like.FilterVector(entries.data(), nulls, sel.size(), sel.data(), sel.data(), negated);
+      expected.clear();
+      for (uint32_t i = 0; i < num_elems; i += 2) {
+        if (i % 3 != 0 && ReferenceMatch(strings[i], pattern) != negated) expected.push_back(i);
+      }
+      EXPECT_EQ(expected, std::vector<uint32_t>(sel.begin(), sel.begin() + sel_count)) << pattern;
+    }
+  }
+
+  common::RawBitmap::Deallocate(nulls);
+}
+
+}  // namespace terrier::execution::sql::test
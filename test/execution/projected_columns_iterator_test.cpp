@@ -1,5 +1,9 @@
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <string_view>
 #include <numeric>
 #include <random>
 #include <utility>
@@ -8,7 +12,12 @@
 #include "execution/sql_test.h"
 
 #include "catalog/catalog.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/sql/projected_columns_iterator.h"
+#include "execution/sql/string_in_list.h"
+#include "execution/sql/value.h"
+#include "execution/util/hash.h"
+#include "storage/arrow_block_metadata.h"
 
 namespace terrier::execution::sql::test {
 
@@ -17,8 +26,11 @@ namespace terrier::execution::sql::test {
 /// named "col_a" is a non-nullable small integer column whose values are
 /// monotonically increasing. The second column, "col_b", is a nullable integer
 /// column whose values are random. The third column, "col_c", is a non-nullable
-/// integer column whose values are in the range [0, 1000). The last column,
-/// "col_d", is a nullable big-integer column whose values are random.
+/// integer column whose values are in the range [0, 1000). The fourth column,
+/// "col_d", is a nullable big-integer column whose values are random. The fifth
+/// column, "col_e", is a non-nullable date column whose values are random dates
+/// between 1970 and 2069. The last column, "col_f", is a non-nullable string
+/// column whose values are drawn from a small set of short strings.
 ///
 
 namespace {
@@ -46,6 +58,40 @@ std::unique_ptr<byte[]> CreateRandom(uint32_t num_elems, T min = 0, T max = std:
   return input;
 }
 
+std::unique_ptr<byte[]> CreateRandomDates(uint32_t num_elems) {
+  auto input = std::make_unique<byte[]>(num_elems * sizeof(uint32_t));
+
+  std::mt19937 generator;
+  std::uniform_int_distribution<int32_t> year(1970, 2069);
+  std::uniform_int_distribution<uint32_t> month(1, 12);
+  std::uniform_int_distribution<uint32_t> day(1, 28);
+
+  auto *typed_input = reinterpret_cast<uint32_t *>(input.get());
+  for (uint32_t i = 0; i < num_elems; i++) {
+    typed_input[i] = Date(year(generator), month(generator), day(generator)).int_val_;
+  }
+
+  return input;
+}
+
+// The strings are all short enough to be inlined, so the entries own their contents
+const char *const K_STRINGS[] = {"", "a", "ab", "abc", "abcd", "abcde", "abcdx", "b", "ba", "zzzzzzzzzzzz"};
+
+std::unique_ptr<byte[]> CreateRandomStrings(uint32_t num_elems) {
+  auto input = std::make_unique<byte[]>(num_elems * sizeof(storage::VarlenEntry));
+
+  std::mt19937 generator;
+  std::uniform_int_distribution<uint32_t> distribution(0, std::size(K_STRINGS) - 1);
+
+  auto *typed_input = reinterpret_cast<storage::VarlenEntry *>(input.get());
+  for (uint32_t i = 0; i < num_elems; i++) {
+    const char *str = K_STRINGS[distribution(generator)];
+    typed_input[i] = storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(str), std::strlen(str));
+  }
+
+  return input;
+}
+
 std::pair<std::unique_ptr<uint32_t[]>, uint32_t> CreateRandomNullBitmap(uint32_t num_elems) {
   auto input = std::make_unique<uint32_t[]>(util::BitUtil::Num32BitWordsFor(num_elems));
   uint32_t num_nulls = 0;
@@ -67,7 +113,7 @@ std::pair<std::unique_ptr<uint32_t[]>, uint32_t> CreateRandomNullBitmap(uint32_t
 
 class ProjectedColumnsIteratorTest : public SqlBasedTest {
  protected:
-  enum ColId : uint8_t { col_a = 0, col_b = 1, col_c = 2, col_d = 3 };
+  enum ColId : uint8_t { col_a = 0, col_b = 1, col_c = 2, col_d = 3, col_e = 4, col_f = 5 };
 
   struct ColData {
     std::unique_ptr<byte[]> data_;
@@ -99,6 +145,8 @@ class ProjectedColumnsIteratorTest : public SqlBasedTest {
     auto colc_data = CreateRandom<int32_t>(NumTuples(), 0, 1000);
     auto cold_data = CreateRandom<int64_t>(NumTuples());
     auto cold_null = CreateRandomNullBitmap(NumTuples());
+    auto cole_data = CreateRandomDates(NumTuples());
+    auto colf_data = CreateRandomStrings(NumTuples());
 
     data_.emplace_back(std::move(cola_data), nullptr, 0, NumTuples(), sizeof(int16_t));
     data_.emplace_back(std::move(colb_data), std::move(colb_null.first), colb_null.second, NumTuples(),
@@ -106,6 +154,8 @@ class ProjectedColumnsIteratorTest : public SqlBasedTest {
     data_.emplace_back(std::move(colc_data), nullptr, 0, NumTuples(), sizeof(int32_t));
     data_.emplace_back(std::move(cold_data), std::move(cold_null.first), cold_null.second, NumTuples(),
                        sizeof(int64_t));
+    data_.emplace_back(std::move(cole_data), nullptr, 0, NumTuples(), sizeof(uint32_t));
+    data_.emplace_back(std::move(colf_data), nullptr, 0, NumTuples(), sizeof(storage::VarlenEntry));
 
     InitializeColumns();
     //  Fill up data
@@ -126,9 +176,9 @@ class ProjectedColumnsIteratorTest : public SqlBasedTest {
           projected_columns_->ColumnNullBitmap(col_offset)->Flip(i);
         }
       } else {
-        // Set all rows to non-null.
+        // Set all rows to non-null. Again, the storage layer treats 1 as non-null.
         // Recast ColumnNullBitmap again as a -Wclass-memaccess workaround
-        std::memset(static_cast<void *>(projected_columns_->ColumnNullBitmap(col_offset)), 0,
+        std::memset(static_cast<void *>(projected_columns_->ColumnNullBitmap(col_offset)), 0xFF,
                     num_tuples / common::Constants::K_BITS_PER_BYTE);
       }
       // Fill up the values.
@@ -142,9 +192,11 @@ class ProjectedColumnsIteratorTest : public SqlBasedTest {
     catalog::Schema::Column col_b("col_b", type::TypeId::INTEGER, false, DummyCVE());
     catalog::Schema::Column col_c("col_c", type::TypeId::INTEGER, false, DummyCVE());
     catalog::Schema::Column col_d("col_d", type::TypeId::BIGINT, false, DummyCVE());
+    catalog::Schema::Column col_e("col_e", type::TypeId::DATE, false, DummyCVE());
+    catalog::Schema::Column col_f("col_f", type::TypeId::VARCHAR, 20, false, DummyCVE());
 
     // Create the table in the catalog.
-    catalog::Schema tmp_schema({col_a, col_b, col_c, col_d});
+    catalog::Schema tmp_schema({col_a, col_b, col_c, col_d, col_e, col_f});
     auto table_oid = exec_ctx_->GetAccessor()->CreateTable(NSOid(), "pci_test_table", tmp_schema);
     auto schema = exec_ctx_->GetAccessor()->GetSchema(table_oid);
     auto sql_table = new storage::SqlTable(BlockStore(), schema);
@@ -452,4 +504,305 @@ TEST_F(ProjectedColumnsIteratorTest, MultipleVectorizedFilterTest) {
   EXPECT_LE(count, 10u);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, NullableVectorizedFilterTest) {
+  //
+  // NULLs never pass a comparison, whatever their (undefined) value. Apply
+  // col_b < 2^30 and check that only non-NULL values are selected.
+  //
+
+  const int32_t bound = 1 << 30;
+  ProjectedColumnsIterator iter(GetProjectedColumn());
+  SetSize(common::Constants::K_DEFAULT_VECTOR_SIZE);
+
+  // Compute expected result
+  uint32_t expected = 0;
+  for (; iter.HasNext(); iter.Advance()) {
+    bool null = false;
+    auto val = *iter.Get<int32_t, true>(GetColOffset(ColId::col_b), &null);
+    if (!null && val < bound) {
+      expected++;
+    }
+  }
+
+  // Filter
+  iter.FilterColByVal<std::less>(GetColOffset(ColId::col_b), type::TypeId::INTEGER,
+                                 ProjectedColumnsIterator::FilterVal{.i_ = bound});
+
+  // Check
+  uint32_t count = 0;
+  for (; iter.HasNextFiltered(); iter.AdvanceFiltered()) {
+    bool null = false;
+    auto val = *iter.Get<int32_t, true>(GetColOffset(ColId::col_b), &null);
+    EXPECT_FALSE(null);
+    EXPECT_LT(val, bound);
+    count++;
+  }
+
+  EXPECT_EQ(expected, count);
+  EXPECT_GT(count, 0u);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, DateVectorizedFilterTest) {
+  //
+  // Dates are not stored in chronological integer order, so check that the
+  // date filter uses calendar order. Apply col_e < 2020-06-15, then
+  // col_e >= 2000-01-01.
+  //
+
+  ProjectedColumnsIterator iter(GetProjectedColumn());
+  SetSize(common::Constants::K_DEFAULT_VECTOR_SIZE);
+
+  const Date lo(2000, 1, 1), hi(2020, 6, 15);
+
+  // Compute expected result
+  uint32_t expected = 0;
+  for (; iter.HasNext(); iter.Advance()) {
+    Date val(*iter.Get<uint32_t, false>(GetColOffset(ColId::col_e), nullptr));
+    if (val.ymd_ < hi.ymd_ && val.ymd_ >= lo.ymd_) {
+      expected++;
+    }
+  }
+
+  // Filter
+  iter.FilterColByVal<std::less>(GetColOffset(ColId::col_e), type::TypeId::DATE,
+                                 ProjectedColumnsIterator::FilterVal{.date_ = hi.int_val_});
+  iter.FilterColByVal<std::greater_equal>(GetColOffset(ColId::col_e), type::TypeId::DATE,
+                                          ProjectedColumnsIterator::FilterVal{.date_ = lo.int_val_});
+
+  // Check
+  uint32_t count = 0;
+  for (; iter.HasNextFiltered(); iter.AdvanceFiltered()) {
+    Date val(*iter.Get<uint32_t, false>(GetColOffset(ColId::col_e), nullptr));
+    EXPECT_TRUE(val.ymd_ < hi.ymd_);
+    EXPECT_TRUE(val.ymd_ >= lo.ymd_);
+    count++;
+  }
+
+  EXPECT_EQ(expected, count);
+  EXPECT_GT(count, 0u);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, StringVectorizedFilterTest) {
+  //
+  // Check string filters against std::string_view comparisons. The strings
+  // share prefixes and differ in length, exercising both the inlined-prefix
+  // fast path and the full comparison.
+  //
+
+  const auto as_view = [](const storage::VarlenEntry &entry) {
+    return std::string_view(reinterpret_cast<const char *>(entry.Content()), entry.Size());
+  };
+
+  for (const char *str : K_STRINGS) {
+    const auto val = storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(str), std::strlen(str));
+
+    // col_f = str
+    ProjectedColumnsIterator eq_iter(GetProjectedColumn());
+    eq_iter.FilterColByVal<std::equal_to>(GetColOffset(ColId::col_f), type::TypeId::VARCHAR,
+                                          ProjectedColumnsIterator::FilterVal{.str_ = val});
+    uint32_t eq_count = 0;
+    for (; eq_iter.HasNextFiltered(); eq_iter.AdvanceFiltered()) {
+      EXPECT_EQ(str, as_view(*eq_iter.Get<storage::VarlenEntry, false>(GetColOffset(ColId::col_f), nullptr)));
+      eq_count++;
+    }
+
+    // col_f < str
+    ProjectedColumnsIterator lt_iter(GetProjectedColumn());
+    lt_iter.FilterColByVal<std::less>(GetColOffset(ColId::col_f), type::TypeId::VARCHAR,
+                                      ProjectedColumnsIterator::FilterVal{.str_ = val});
+    uint32_t lt_count = 0;
+    for (; lt_iter.HasNextFiltered(); lt_iter.AdvanceFiltered()) {
+      EXPECT_LT(as_view(*lt_iter.Get<storage::VarlenEntry, false>(GetColOffset(ColId::col_f), nullptr)), str);
+      lt_count++;
+    }
+
+    // Compute expected results
+    uint32_t expected_eq = 0, expected_lt = 0;
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    for (; iter.HasNext(); iter.Advance()) {
+      auto view = as_view(*iter.Get<storage::VarlenEntry, false>(GetColOffset(ColId::col_f), nullptr));
+      expected_eq += static_cast<uint32_t>(view == str);
+      expected_lt += static_cast<uint32_t>(view < str);
+    }
+
+    EXPECT_EQ(expected_eq, eq_count);
+    EXPECT_EQ(expected_lt, lt_count);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, HashColumnsTest) {
+  //
+  // Hashing columns in batch must agree with hashing each tuple's values one
+  // at a time, the way @hash() does, including for NULLs
+  //
+
+  const uint32_t col_idxs[] = {GetColOffset(ColId::col_b), GetColOffset(ColId::col_d), GetColOffset(ColId::col_f)};
+  const type::TypeId col_types[] = {type::TypeId::INTEGER, type::TypeId::BIGINT, type::TypeId::VARCHAR};
+
+  const auto expected_hash = [&](const ProjectedColumnsIterator &iter) {
+    bool null = false;
+    hash_t hash = 1;
+    const auto *b = iter.Get<int32_t, true>(col_idxs[0], &null);
+    hash = util::Hasher::CombineHashes(hash, null ? 0 : util::Hasher::Hash<util::HashMethod::Crc>(int64_t{*b}));
+    const auto *d = iter.Get<int64_t, true>(col_idxs[1], &null);
+    hash = util::Hasher::CombineHashes(hash, null ? 0 : util::Hasher::Hash<util::HashMethod::Crc>(*d));
+    const auto *f = iter.Get<storage::VarlenEntry, false>(col_idxs[2], nullptr);
+    const auto *content = reinterpret_cast<const uint8_t *>(f->Content());
+    return util::Hasher::CombineHashes(hash, util::Hasher::Hash<util::HashMethod::xxHash3>(content, f->Size()));
+  };
+
+  // Unfiltered
+  {
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    EXPECT_FALSE(iter.HasHashes());
+    iter.HashColumns(col_idxs, col_types, 3);
+    EXPECT_TRUE(iter.HasHashes());
+    for (; iter.HasNext(); iter.Advance()) {
+      EXPECT_EQ(expected_hash(iter), iter.GetHash());
+    }
+  }
+
+  // Filtered, both before and after hashing
+  {
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    iter.FilterColByVal<std::less>(GetColOffset(ColId::col_c), type::TypeId::INTEGER,
+                                   ProjectedColumnsIterator::FilterVal{.i_ = 500});
+    iter.HashColumns(col_idxs, col_types, 3);
+    iter.FilterColByVal<std::greater>(GetColOffset(ColId::col_c), type::TypeId::INTEGER,
+                                      ProjectedColumnsIterator::FilterVal{.i_ = 100});
+    uint32_t count = 0;
+    for (; iter.HasNextFiltered(); iter.AdvanceFiltered()) {
+      EXPECT_EQ(expected_hash(iter), iter.GetHash());
+      count++;
+    }
+    EXPECT_EQ(iter.NumSelected(), count);
+
+    // Moving to a new projection invalidates the hashes
+    iter.SetProjectedColumn(GetProjectedColumn());
+    EXPECT_FALSE(iter.HasHashes());
+  }
+
+  // One column at a time, the way generated code hashes its keys
+  {
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    for (uint32_t i = 0; i < 3; i++) {
+      iter.HashColumn(col_idxs[i], col_types[i], i > 0);
+    }
+    EXPECT_TRUE(iter.HasHashes());
+    for (; iter.HasNext(); iter.Advance()) {
+      EXPECT_EQ(expected_hash(iter), iter.GetHash());
+    }
+  }
+
+  // Hashes computed by a function
+  {
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    iter.CacheHashes([&] { return expected_hash(iter); });
+    EXPECT_TRUE(iter.HasHashes());
+    for (; iter.HasNext(); iter.Advance()) {
+      EXPECT_EQ(expected_hash(iter), iter.GetHash());
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, DictionaryCodesTest) {
+  //
+  // Filters and hashes computed through dictionary codes must agree with those
+  // computed on the strings themselves
+  //
+
+  const auto as_view = [](const storage::VarlenEntry &entry) {
+    return std::string_view(reinterpret_cast<const char *>(entry.Content()), entry.Size());
+  };
+
+  // The strings are sorted, so they make up a dictionary as built by the storage layer
+  const auto num_words = static_cast<uint32_t>(std::size(K_STRINGS));
+  uint32_t values_length = 0;
+  for (const char *str : K_STRINGS) values_length += std::strlen(str);
+  storage::ArrowVarlenColumn dictionary(values_length, num_words + 1);
+  for (uint32_t code = 0, offset = 0; code < num_words; code++) {
+    dictionary.Offsets()[code] = offset;
+    std::memcpy(dictionary.Values() + offset, K_STRINGS[code], std::strlen(K_STRINGS[code]));
+    offset += std::strlen(K_STRINGS[code]);
+  }
+  dictionary.Offsets()[num_words] = values_length;
+
+  const uint16_t col_f = GetColOffset(ColId::col_f);
+  std::vector<uint32_t> codes(NumTuples());
+  {
+    ProjectedColumnsIterator iter(GetProjectedColumn());
+    for (uint32_t i = 0; iter.HasNext(); iter.Advance(), i++) {
+      const std::string_view str = as_view(*iter.Get<storage::VarlenEntry, false>(col_f, nullptr));
+      codes[i] = std::find(std::begin(K_STRINGS), std::end(K_STRINGS), str) - std::begin(K_STRINGS);
+    }
+  }
+
+  // Apply the same operations to two iterators, one of which has the codes
+  const auto check = [&](const auto &op) {
+    ProjectedColumnsIterator plain(GetProjectedColumn()), encoded(GetProjectedColumn());
+    encoded.SetDictionaryCodes(col_f, codes.data(), &dictionary);
+    EXPECT_TRUE(encoded.HasDictionaryCodes(col_f));
+    EXPECT_FALSE(plain.HasDictionaryCodes(col_f));
+    op(&plain);
+    op(&encoded);
+    ASSERT_EQ(plain.NumSelected(), encoded.NumSelected());
+    for (; plain.HasNextFiltered(); plain.AdvanceFiltered(), encoded.AdvanceFiltered()) {
+      ASSERT_EQ(plain.CurrentSlot(), encoded.CurrentSlot());
+      EXPECT_EQ(plain.GetHash(), encoded.GetHash());
+    }
+  };
+  const uint32_t hash_col_idxs[] = {col_f};
+  const type::TypeId hash_col_types[] = {type::TypeId::VARCHAR};
+
+  for (const char *str : K_STRINGS) {
+    const auto val = storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(str), std::strlen(str));
+    check([&](ProjectedColumnsIterator *iter) {
+      iter->FilterColByVal<std::equal_to>(col_f, type::TypeId::VARCHAR,
+                                          ProjectedColumnsIterator::FilterVal{.str_ = val});
+      iter->HashColumns(hash_col_idxs, hash_col_types, 1);
+    });
+    check([&](ProjectedColumnsIterator *iter) {
+      iter->HashColumns(hash_col_idxs, hash_col_types, 1);
+      iter->FilterColByVal<std::less>(col_f, type::TypeId::VARCHAR, ProjectedColumnsIterator::FilterVal{.str_ = val});
+    });
+  }
+
+  for (const char *pattern : {"ab%", "%b%", "_"}) {
+    const LikePattern like(pattern);
+    for (const bool negated : {false, true}) {
+      check([&](ProjectedColumnsIterator *iter) {
+        iter->FilterColByLike(col_f, like, negated);
+        iter->HashColumns(hash_col_idxs, hash_col_types, 1);
+      });
+    }
+  }
+
+  // IN, after a filter on another column, and with a selection smaller than the dictionary
+  const StringInList in_list({"a", "ba", "zz", "a string too long to inline"});
+  EXPECT_EQ(4, in_list.GetNumValues());
+  EXPECT_EQ("a string too long to inline", as_view(in_list.GetValues()[3]));
+  for (const int32_t bound : {500, 3}) {
+    check([&](ProjectedColumnsIterator *iter) {
+      iter->FilterColByVal<std::less>(GetColOffset(ColId::col_c), type::TypeId::INTEGER,
+                                      ProjectedColumnsIterator::FilterVal{.i_ = bound});
+      iter->HashColumns(hash_col_idxs, hash_col_types, 1);
+      iter->FilterColByInList(col_f, in_list.GetValues(), in_list.GetNumValues());
+    });
+  }
+
+  // Codes can be read tuple-at-a-time, and are dropped when moving to a new projection
+  ProjectedColumnsIterator iter(GetProjectedColumn());
+  iter.SetDictionaryCodes(col_f, codes.data(), &dictionary);
+  for (uint32_t i = 0; iter.HasNext(); iter.Advance(), i++) {
+    EXPECT_EQ(codes[i], iter.GetDictionaryCode(col_f));
+  }
+  iter.SetProjectedColumn(GetProjectedColumn());
+  EXPECT_FALSE(iter.HasDictionaryCodes(col_f));
+}
+
 }  // namespace terrier::execution::sql::test
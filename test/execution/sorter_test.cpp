@@ -14,6 +14,7 @@
 #include "ips4o/ips4o.hpp"
 
 #include "execution/exec/execution_context.h"
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/thread_state_container.h"
 
@@ -249,4 +250,128 @@ TEST_F(SorterTest, UnbalancedParallelSortTest) {
   }
 }
 
+template <uint32_t N>
+void TestExternalSort(const uint32_t num_tuples, const std::size_t memory_budget) {
+  static const auto cmp_fn = [](const void *left, const void *right) {
+    const auto *l = reinterpret_cast<const TestTuple<N> *>(left);
+    const auto *r = reinterpret_cast<const TestTuple<N> *>(right);
+    return l->Compare(*r);
+  };
+
+  std::default_random_engine generator;
+  std::uniform_int_distribution<uint32_t> rng(0, 1000000);
+
+  MemoryPool memory(nullptr);
+  Sorter sorter(&memory, cmp_fn, sizeof(TestTuple<N>));
+  sorter.SetMemoryBudget(memory_budget);
+
+  std::vector<uint32_t> reference;
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    auto *elem = reinterpret_cast<TestTuple<N> *>(sorter.AllocInputTuple());
+    elem->key_ = rng(generator);
+    elem->data_[0] = elem->key_;
+    reference.push_back(elem->key_);
+  }
+
+  EXPECT_TRUE(sorter.HasSpilled());
+  EXPECT_EQ(num_tuples, sorter.NumTuples());
+
+  sorter.Sort();
+  std::sort(reference.begin(), reference.end());
+
+  uint32_t count = 0;
+  for (SorterIterator iter(&sorter); iter.HasNext(); iter.Next()) {
+    auto *curr = iter.GetRowAs<TestTuple<N>>();
+    ASSERT_LT(count, num_tuples);
+    EXPECT_EQ(reference[count], curr->key_);
+    EXPECT_EQ(curr->key_, curr->data_[0]);
+    count++;
+  }
+  EXPECT_EQ(num_tuples, count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, ExternalSortTest) {
+  // Budget fits several merge buffers: single merge pass
+  TestExternalSort<2>(200000, 4 * Sorter::K_MERGE_BUFFER_SIZE);
+  // Budget below a merge buffer: multiple merge passes with the minimum fan-in
+  TestExternalSort<2>(50000, 16 * common::Constants::KB);
+  TestExternalSort<32>(50000, 64 * common::Constants::KB);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, ExternalParallelSortTest) {
+  static const auto cmp_fn = [](const void *left, const void *right) {
+    const auto *l = reinterpret_cast<const TestTuple<2> *>(left);
+    const auto *r = reinterpret_cast<const TestTuple<2> *>(right);
+    return l->Compare(*r);
+  };
+
+  // Each thread-local sorter gets a budget well below its input size
+  const auto init_sorter = [](void *ctx, void *s) {
+    auto *sorter = new (s)
+        Sorter(reinterpret_cast<exec::ExecutionContext *>(ctx)->GetMemoryPool(), cmp_fn, sizeof(TestTuple<2>));
+    sorter->SetMemoryBudget(32 * common::Constants::KB);
+  };
+  const auto destroy_sorter = [](UNUSED_ATTRIBUTE void *ctx, void *s) { reinterpret_cast<Sorter *>(s)->~Sorter(); };
+
+  exec::ExecutionContext exec_ctx(catalog::INVALID_DATABASE_OID, nullptr, nullptr, nullptr, nullptr);
+  ThreadStateContainer container(exec_ctx.GetMemoryPool());
+  container.Reset(sizeof(Sorter), init_sorter, destroy_sorter, &exec_ctx);
+
+  const std::vector<uint32_t> sorter_sizes = {10000, 20000, 30000, 40000};
+  tbb::task_scheduler_init sched;
+  tbb::parallel_for_each(sorter_sizes.begin(), sorter_sizes.end(), [&container](auto sorter_size) {
+    auto *sorter = container.AccessThreadStateOfCurrentThreadAs<Sorter>();
+    for (uint32_t i = 0; i < sorter_size; i++) {
+      auto *elem = reinterpret_cast<TestTuple<2> *>(sorter->AllocInputTuple());
+      elem->key_ = sorter_size - i;
+    }
+  });
+
+  Sorter main(exec_ctx.GetMemoryPool(), cmp_fn, sizeof(TestTuple<2>));
+  main.SortParallel(&container, 0);
+
+  EXPECT_TRUE(main.IsSorted());
+  EXPECT_TRUE(main.HasSpilled());
+  EXPECT_EQ(100000u, main.NumTuples());
+
+  // Rows of spilled runs are only valid until the iterator moves on, so the previous key is copied
+  uint32_t count = 0;
+  uint32_t prev_key = 0;
+  for (SorterIterator iter(&main); iter.HasNext(); iter.Next()) {
+    const uint32_t key = iter.GetRowAs<TestTuple<2>>()->key_;
+    EXPECT_LE(prev_key, key);
+    prev_key = key;
+    count++;
+  }
+  EXPECT_EQ(100000u, count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, QueryMemoryLimitTest) {
+  static const auto cmp_fn = [](const void *left, const void *right) {
+    const auto *l = reinterpret_cast<const TestTuple<2> *>(left);
+    const auto *r = reinterpret_cast<const TestTuple<2> *>(right);
+    return l->Compare(*r);
+  };
+
+  // Both sorters get the full limit as their budget, and each of them fits in it
+  MemoryTracker tracker(4 * common::Constants::MB);
+  MemoryPool memory(&tracker);
+  Sorter first(&memory, cmp_fn, sizeof(TestTuple<2>));
+  Sorter second(&memory, cmp_fn, sizeof(TestTuple<2>));
+  for (Sorter *sorter : {&first, &second}) {
+    for (uint32_t i = 0; i < 100000; i++) {
+      reinterpret_cast<TestTuple<2> *>(sorter->AllocInputTuple())->key_ = i;
+    }
+  }
+
+  // Together they do not, so the second spills, and the query stays within the limit
+  EXPECT_FALSE(first.HasSpilled());
+  EXPECT_TRUE(second.HasSpilled());
+  EXPECT_EQ(100000u, second.NumTuples());
+  EXPECT_FALSE(tracker.IsOverLimit());
+}
+
 }  // namespace terrier::execution::sql::test
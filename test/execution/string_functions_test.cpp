@@ -10,6 +10,7 @@
 
 #include "execution/exec/execution_context.h"
 #include "execution/sql/functions/string_functions.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/sql/value.h"
 #include "execution/util/timer.h"
 
@@ -515,4 +516,65 @@ TEST_F(StringFunctionsTests, Trim) {
   EXPECT_TRUE(StringVal("test") == result);
 }
 
+// NOLINTNEXTLINE
+TEST_F(StringFunctionsTests, Like) {
+  // Nulls
+  {
+    auto result = BoolVal(false);
+    StringFunctions::Like(&result, StringVal::Null(), StringVal("%"));
+    EXPECT_TRUE(result.is_null_);
+
+    result = BoolVal(false);
+    StringFunctions::Like(&result, StringVal(test_string_2_), StringVal::Null());
+    EXPECT_TRUE(result.is_null_);
+  }
+
+  auto result = BoolVal(false);
+  auto x = StringVal(test_string_1_);
+
+  StringFunctions::Like(&result, x, StringVal("I only%"));
+  EXPECT_FALSE(result.is_null_);
+  EXPECT_TRUE(result.val_);
+
+  StringFunctions::Like(&result, x, StringVal("%my bed%"));
+  EXPECT_TRUE(result.val_);
+
+  StringFunctions::Like(&result, x, StringVal("%I_m sorry"));
+  EXPECT_TRUE(result.val_);
+
+  StringFunctions::Like(&result, x, StringVal("%momma"));
+  EXPECT_FALSE(result.val_);
+
+  StringFunctions::Like(&result, StringVal(test_string_2_), StringVal("Dr_ke"));
+  EXPECT_TRUE(result.val_);
+
+  StringFunctions::Like(&result, StringVal("100%"), StringVal("100\\%"));
+  EXPECT_TRUE(result.val_);
+
+  StringFunctions::Like(&result, StringVal("1000"), StringVal("100\\%"));
+  EXPECT_FALSE(result.val_);
+}
+
+// NOLINTNEXTLINE
+TEST_F(StringFunctionsTests, CompiledLike) {
+  // A compiled pattern matches the same strings as the uncompiled one
+  const char *patterns[] = {"I only%", "%my bed%", "%I_m sorry", "%momma", "Dr_ke", "100\\%", "%"};
+  const char *strings[] = {test_string_1_, test_string_2_, "100%", "1000", ""};
+  for (const char *pattern : patterns) {
+    const LikePattern compiled(pattern);
+    for (const char *str : strings) {
+      auto expected = BoolVal(false), result = BoolVal(false);
+      StringFunctions::Like(&expected, StringVal(str), StringVal(pattern));
+      StringFunctions::Like(&result, StringVal(str), compiled);
+      EXPECT_FALSE(result.is_null_);
+      EXPECT_EQ(expected.val_, result.val_) << str << " LIKE " << pattern;
+    }
+  }
+
+  // Only the string can be NULL
+  auto result = BoolVal(false);
+  StringFunctions::Like(&result, StringVal::Null(), LikePattern("%"));
+  EXPECT_TRUE(result.is_null_);
+}
+
 }  // namespace terrier::execution::sql::test
@@ -1,5 +1,6 @@
 #include <array>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 #include "execution/sql_test.h"
@@ -129,4 +130,59 @@ TEST_F(TableVectorIteratorTest, IteratorColOidsTest) {
   EXPECT_EQ(sql::TEST2_SIZE, num_tuples);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, LateMaterializationTest) {
+  //
+  // Ensure deferring the non-filter columns until after filtering reads the same tuples as reading all of them up
+  // front, and that the columns of a tuple can be fetched by its slot
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_2");
+  std::array<uint32_t, 4> col_oids{1, 2, 3, 4};
+  // col3 is the first column in the PCI, col2 and col4 are the next two, and col1 is the last
+  constexpr int64_t cutoff = 100;
+  auto filter = [](ProjectedColumnsIterator *pci) {
+    pci->RunFilter([pci] { return *pci->Get<int64_t, false>(0, nullptr) < cutoff; });
+  };
+  auto read_tuple = [](ProjectedColumnsIterator *pci) {
+    bool null = false;
+    auto col2 = pci->Get<int32_t, true>(1, &null);
+    return std::make_tuple(*pci->Get<int16_t, false>(3, nullptr), null ? -1 : *col2,
+                           *pci->Get<int64_t, false>(0, nullptr));
+  };
+
+  std::vector<std::tuple<int16_t, int32_t, int64_t>> expected;
+  {
+    TableVectorIterator iter(exec_ctx_.get(), !table_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size()));
+    iter.Init();
+    ProjectedColumnsIterator *pci = iter.GetProjectedColumnsIterator();
+    while (iter.Advance()) {
+      filter(pci);
+      pci->ForEach([&] { expected.push_back(read_tuple(pci)); });
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+
+  std::vector<std::tuple<int16_t, int32_t, int64_t>> actual;
+  TableVectorIterator iter(exec_ctx_.get(), !table_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size()));
+  iter.Init();
+  std::array<uint32_t, 1> filter_col_oids{3};
+  iter.SetFilterColumns(filter_col_oids.data(), static_cast<uint32_t>(filter_col_oids.size()));
+  ProjectedColumnsIterator *pci = iter.GetProjectedColumnsIterator();
+  while (iter.Advance()) {
+    filter(pci);
+    iter.Materialize();
+    pci->ForEach([&] {
+      actual.push_back(read_tuple(pci));
+      // The row fetched by slot has the same layout as the PCI
+      storage::ProjectedRow *row = iter.FetchRow(pci->CurrentSlot());
+      const int16_t col1 = *row->Get<int16_t, false>(3, nullptr);
+      const int64_t col3 = *row->Get<int64_t, false>(0, nullptr);
+      EXPECT_EQ(std::get<0>(actual.back()), col1);
+      EXPECT_EQ(std::get<2>(actual.back()), col3);
+    });
+  }
+  EXPECT_EQ(expected, actual);
+}
+
 }  // namespace terrier::execution::sql::test
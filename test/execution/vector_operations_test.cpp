@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "execution/tpl_test.h"
+
+#include "common/allocator.h"
+#include "execution/sql/like_pattern.h"
+#include "execution/sql/projected_columns_iterator.h"
+#include "execution/sql/value.h"
+#include "execution/sql/vector.h"
+#include "execution/sql/vector_expression.h"
+#include "execution/sql/vector_operations.h"
+#include "execution/sql/vector_projection.h"
+#include "storage/block_layout.h"
+#include "storage/projected_columns.h"
+
+namespace terrier::execution::sql::test {
+
+class VectorOperationsTest : public TplTest {};
+
+namespace {
+
+// Fill an owning vector with the given values
+template <typename T>
+void Fill(Vector *vector, const std::vector<T> &values) {
+  std::copy(values.begin(), values.end(), vector->template GetDataAs<T>());
+  vector->SetSelectionVector(nullptr, static_cast<uint32_t>(values.size()));
+  vector->GetMutableNullMask()->reset();
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST_F(VectorOperationsTest, Arithmetic) {
+  Vector a(type::TypeId::INTEGER), b(type::TypeId::INTEGER), result(type::TypeId::INTEGER);
+  Fill<int32_t>(&a, {1, 2, 3, 4, 5, 6});
+  Fill<int32_t>(&b, {10, 0, -3, 2, 7, 0});
+  a.SetNull(3, true);
+
+  VectorOps::Add(a, b, &result);
+  EXPECT_EQ(6u, result.GetCount());
+  EXPECT_EQ(11, result.GetDataAs<int32_t>()[0]);
+  EXPECT_EQ(0, result.GetDataAs<int32_t>()[2]);
+  EXPECT_TRUE(result.IsNull(3));
+  EXPECT_FALSE(result.IsNull(4));
+
+  VectorOps::Multiply(a, b, &result);
+  EXPECT_EQ(-9, result.GetDataAs<int32_t>()[2]);
+
+  // Division by zero yields NULL
+  VectorOps::Divide(a, b, &result);
+  EXPECT_EQ(0, result.GetDataAs<int32_t>()[0]);
+  EXPECT_TRUE(result.IsNull(1));
+  EXPECT_EQ(-1, result.GetDataAs<int32_t>()[2]);
+  EXPECT_TRUE(result.IsNull(3));
+  EXPECT_FALSE(result.IsNull(4));
+  EXPECT_TRUE(result.IsNull(5));
+
+  VectorOps::Modulo(a, b, &result);
+  EXPECT_EQ(1, result.GetDataAs<int32_t>()[0]);
+  EXPECT_EQ(5, result.GetDataAs<int32_t>()[4]);
+  EXPECT_TRUE(result.IsNull(5));
+
+  // Constants are broadcast
+  Vector c(type::TypeId::INTEGER);
+  c.SetConstant<int32_t>(100);
+  VectorOps::Subtract(c, a, &result);
+  EXPECT_FALSE(result.IsConstant());
+  EXPECT_EQ(6u, result.GetCount());
+  EXPECT_EQ(99, result.GetDataAs<int32_t>()[0]);
+  EXPECT_EQ(94, result.GetDataAs<int32_t>()[5]);
+  EXPECT_TRUE(result.IsNull(3));
+
+  c.SetNullConstant();
+  VectorOps::Add(a, c, &result);
+  for (uint32_t i = 0; i < 6; i++) EXPECT_TRUE(result.IsNull(i));
+
+  // Only selected elements are computed
+  const uint32_t sel[] = {1, 4};
+  a.SetSelectionVector(sel, 2);
+  b.SetSelectionVector(sel, 2);
+  Vector sel_result(type::TypeId::INTEGER);
+  VectorOps::Add(a, b, &sel_result);
+  EXPECT_EQ(2u, sel_result.GetCount());
+  EXPECT_EQ(sel, sel_result.GetSelectionVector());
+  EXPECT_EQ(2, sel_result.GetDataAs<int32_t>()[1]);
+  EXPECT_EQ(12, sel_result.GetDataAs<int32_t>()[4]);
+
+  // Mismatched types are rejected
+  Vector d(type::TypeId::DECIMAL);
+  Fill<double>(&d, {1, 2, 3, 4, 5, 6});
+  EXPECT_THROW(VectorOps::Add(a, d, &result), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorOperationsTest, ComparisonAndSelection) {
+  constexpr uint32_t num_elems = common::Constants::K_DEFAULT_VECTOR_SIZE;
+  Vector a(type::TypeId::BIGINT), pivot(type::TypeId::BIGINT), cmp(type::TypeId::BOOLEAN);
+  std::vector<int64_t> values(num_elems);
+  std::iota(values.begin(), values.end(), 0);
+  Fill(&a, values);
+  for (uint32_t i = 0; i < num_elems; i += 10) a.SetNull(i, true);
+  pivot.SetConstant<int64_t>(1000);
+
+  // a < 1000, skipping NULLs
+  VectorOps::LessThan(a, pivot, &cmp);
+  std::vector<uint32_t> sel(num_elems);
+  uint32_t count = VectorOps::SelectTrue(cmp, sel.data());
+  EXPECT_EQ(900u, count);
+  for (uint32_t i = 0; i < count; i++) {
+    EXPECT_LT(sel[i], 1000u);
+    EXPECT_NE(0u, sel[i] % 10);
+  }
+
+  // Further restrict to even values, in place
+  a.SetSelectionVector(sel.data(), count);
+  Vector two(type::TypeId::BIGINT), zero(type::TypeId::BIGINT), rem(type::TypeId::BIGINT);
+  two.SetConstant<int64_t>(2);
+  zero.SetConstant<int64_t>(0);
+  VectorOps::Modulo(a, two, &rem);
+  VectorOps::Equal(rem, zero, &cmp);
+  count = VectorOps::SelectTrue(cmp, sel.data());
+  EXPECT_EQ(400u, count);
+  for (uint32_t i = 0; i < count; i++) {
+    EXPECT_EQ(0u, sel[i] % 2);
+  }
+
+  // Three-valued logic
+  Vector l(type::TypeId::BOOLEAN), r(type::TypeId::BOOLEAN), out(type::TypeId::BOOLEAN);
+  Fill<bool>(&l, {true, true, false, true, false});
+  Fill<bool>(&r, {true, false, false, false, false});
+  r.SetNull(3, true);
+  l.SetNull(4, true);
+  VectorOps::And(l, r, &out);
+  EXPECT_TRUE(out.GetDataAs<bool>()[0]);
+  EXPECT_FALSE(out.GetDataAs<bool>()[1]);
+  EXPECT_TRUE(out.IsNull(3));
+  EXPECT_FALSE(out.IsNull(4));
+  EXPECT_FALSE(out.GetDataAs<bool>()[4]);
+  VectorOps::Or(l, r, &out);
+  EXPECT_TRUE(out.GetDataAs<bool>()[1]);
+  EXPECT_FALSE(out.GetDataAs<bool>()[2]);
+  EXPECT_FALSE(out.IsNull(3));
+  EXPECT_TRUE(out.GetDataAs<bool>()[3]);
+  EXPECT_TRUE(out.IsNull(4));
+  VectorOps::Not(l, &out);
+  EXPECT_FALSE(out.GetDataAs<bool>()[0]);
+  EXPECT_TRUE(out.GetDataAs<bool>()[2]);
+  EXPECT_TRUE(out.IsNull(4));
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorOperationsTest, DateAndStringComparison) {
+  Vector dates(type::TypeId::DATE), pivot(type::TypeId::DATE), cmp(type::TypeId::BOOLEAN);
+  Fill<uint32_t>(&dates, {Date(1999, 12, 31).int_val_, Date(2000, 1, 1).int_val_, Date(1900, 6, 1).int_val_,
+                          Date(2001, 2, 1).int_val_});
+  pivot.SetConstant<uint32_t>(Date(2000, 1, 1).int_val_);
+  VectorOps::GreaterThanEqual(dates, pivot, &cmp);
+  EXPECT_FALSE(cmp.GetDataAs<bool>()[0]);
+  EXPECT_TRUE(cmp.GetDataAs<bool>()[1]);
+  EXPECT_FALSE(cmp.GetDataAs<bool>()[2]);
+  EXPECT_TRUE(cmp.GetDataAs<bool>()[3]);
+
+  Vector strings(type::TypeId::VARCHAR), other(type::TypeId::VARCHAR);
+  const std::vector<std::string> values = {"abc", "a string that is not inlined", "", "abd"};
+  std::vector<storage::VarlenEntry> entries;
+  for (const auto &value : values) entries.push_back(strings.AddString(value));
+  Fill(&strings, entries);
+  other.SetConstant(other.AddString("abc"));
+  VectorOps::LessThanEqual(strings, other, &cmp);
+  EXPECT_TRUE(cmp.GetDataAs<bool>()[0]);
+  EXPECT_TRUE(cmp.GetDataAs<bool>()[1]);
+  EXPECT_TRUE(cmp.GetDataAs<bool>()[2]);
+  EXPECT_FALSE(cmp.GetDataAs<bool>()[3]);
+
+  // NULL strings are never read
+  std::memset(&strings.GetDataAs<storage::VarlenEntry>()[1], 0xAB, sizeof(storage::VarlenEntry));
+  strings.SetNull(1, true);
+  VectorOps::Equal(strings, other, &cmp);
+  EXPECT_TRUE(cmp.GetDataAs<bool>()[0]);
+  EXPECT_TRUE(cmp.IsNull(1));
+  EXPECT_FALSE(cmp.GetDataAs<bool>()[3]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorOperationsTest, Cast) {
+  Vector a(type::TypeId::SMALLINT), b(type::TypeId::DECIMAL), c(type::TypeId::BOOLEAN), d(type::TypeId::TINYINT);
+  Fill<int16_t>(&a, {-3, 0, 300});
+  a.SetNull(1, true);
+
+  VectorOps::Cast(a, &b);
+  EXPECT_DOUBLE_EQ(-3.0, b.GetDataAs<double>()[0]);
+  EXPECT_DOUBLE_EQ(300.0, b.GetDataAs<double>()[2]);
+  EXPECT_TRUE(b.IsNull(1));
+
+  VectorOps::Cast(b, &c);
+  EXPECT_TRUE(c.GetDataAs<bool>()[0]);
+  EXPECT_TRUE(c.IsNull(1));
+
+  VectorOps::Cast(a, &d);
+  EXPECT_EQ(static_cast<int8_t>(300), d.GetDataAs<int8_t>()[2]);
+
+  Vector str(type::TypeId::VARCHAR);
+  EXPECT_THROW(VectorOps::Cast(a, &str), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorOperationsTest, StringFunctions) {
+  Vector strings(type::TypeId::VARCHAR);
+  const std::vector<std::string> values = {"Hello", "MiXeD CaSe StRiNg LoNg EnOuGh", "", "hello world"};
+  std::vector<storage::VarlenEntry> entries;
+  for (const auto &value : values) entries.push_back(strings.AddString(value));
+  Fill(&strings, entries);
+  strings.SetNull(2, true);
+
+  auto as_string = [](const storage::VarlenEntry &entry) {
+    return std::string(reinterpret_cast<const char *>(entry.Content()), entry.Size());
+  };
+
+  Vector lengths(type::TypeId::INTEGER);
+  VectorOps::Length(strings, &lengths);
+  EXPECT_EQ(5, lengths.GetDataAs<int32_t>()[0]);
+  EXPECT_EQ(29, lengths.GetDataAs<int32_t>()[1]);
+  EXPECT_TRUE(lengths.IsNull(2));
+
+  Vector converted(type::TypeId::VARCHAR);
+  VectorOps::Lower(strings, &converted);
+  EXPECT_EQ("hello", as_string(converted.GetDataAs<storage::VarlenEntry>()[0]));
+  EXPECT_EQ("mixed case string long enough", as_string(converted.GetDataAs<storage::VarlenEntry>()[1]));
+  EXPECT_TRUE(converted.IsNull(2));
+  VectorOps::Upper(strings, &converted);
+  EXPECT_EQ("HELLO WORLD", as_string(converted.GetDataAs<storage::VarlenEntry>()[3]));
+
+  Vector matches(type::TypeId::BOOLEAN);
+  VectorOps::Like(strings, LikePattern("%ello%"), &matches);
+  EXPECT_TRUE(matches.GetDataAs<bool>()[0]);
+  EXPECT_FALSE(matches.GetDataAs<bool>()[1]);
+  EXPECT_TRUE(matches.IsNull(2));
+  EXPECT_TRUE(matches.GetDataAs<bool>()[3]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorOperationsTest, ProjectionOverProjectedColumns) {
+  constexpr uint32_t num_tuples = 100;
+  const storage::BlockLayout layout({8, 4});
+  const std::vector<storage::col_id_t> col_ids = {storage::col_id_t(1)};
+  storage::ProjectedColumnsInitializer initializer(layout, col_ids, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+  storage::ProjectedColumns *columns = initializer.Initialize(buffer);
+  columns->SetNumTuples(num_tuples);
+
+  // Every seventh value is NULL
+  auto *values = reinterpret_cast<int32_t *>(columns->ColumnStart(0));
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    values[i] = static_cast<int32_t>(i);
+    columns->ColumnNullBitmap(0)->Set(i, i % 7 != 0);
+  }
+
+  // Filter on values >= 50 in the iterator, then compute 2 * value over the surviving tuples. NULLs
+  // are carried over from the storage layer.
+  ProjectedColumnsIterator pci(columns);
+  pci.FilterColByVal<std::greater_equal>(0, type::TypeId::INTEGER, pci.MakeFilterVal(50, type::TypeId::INTEGER));
+  VectorProjection projection({type::TypeId::INTEGER});
+  projection.Reference(pci);
+  EXPECT_EQ(pci.NumSelected(), projection.GetCount());
+
+  Vector two(type::TypeId::INTEGER), doubled(type::TypeId::INTEGER);
+  two.SetConstant<int32_t>(2);
+  VectorOps::Multiply(*projection.GetColumn(0), two, &doubled);
+  ASSERT_EQ(pci.NumSelected(), doubled.GetCount());
+  for (uint32_t i = 0; i < doubled.GetCount(); i++) {
+    const uint32_t pos = doubled.GetSelectionVector()[i];
+    EXPECT_GE(pos, 50u);
+    EXPECT_EQ(pos % 7 == 0, doubled.IsNull(pos));
+    if (!doubled.IsNull(pos)) {
+      EXPECT_EQ(static_cast<int32_t>(2 * pos), doubled.GetDataAs<int32_t>()[pos]);
+    }
+  }
+
+  // Without a filter, all tuples are selected
+  projection.Reference(columns, nullptr, num_tuples);
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    EXPECT_EQ(i % 7 == 0, projection.GetColumn(0)->IsNull(i));
+  }
+
+  delete[] buffer;
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorOperationsTest, VectorFilter) {
+  constexpr uint32_t num_tuples = 100;
+  const storage::BlockLayout layout({8, 4});
+  const std::vector<storage::col_id_t> col_ids = {storage::col_id_t(1)};
+  storage::ProjectedColumnsInitializer initializer(layout, col_ids, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+  storage::ProjectedColumns *columns = initializer.Initialize(buffer);
+  columns->SetNumTuples(num_tuples);
+
+  // Every seventh value is NULL
+  auto *values = reinterpret_cast<int32_t *>(columns->ColumnStart(0));
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    values[i] = static_cast<int32_t>(i);
+    columns->ColumnNullBitmap(0)->Set(i, i % 7 != 0);
+  }
+
+  // CAST(value AS BIGINT) % 3 = 0, evaluated on the tuples a PCI filter left with value >= 50
+  std::vector<std::unique_ptr<VectorExpression>> cast_operands, mod_operands, eq_operands;
+  cast_operands.emplace_back(VectorExpression::Column(0, type::TypeId::INTEGER));
+  mod_operands.emplace_back(
+      VectorExpression::Operation(VectorExpression::Op::Cast, type::TypeId::BIGINT, std::move(cast_operands)));
+  mod_operands.emplace_back(VectorExpression::IntegerConstant(3));
+  eq_operands.emplace_back(
+      VectorExpression::Operation(VectorExpression::Op::Modulo, type::TypeId::BIGINT, std::move(mod_operands)));
+  eq_operands.emplace_back(VectorExpression::IntegerConstant(0));
+  VectorFilter filter({0}, {type::TypeId::INTEGER},
+                      VectorExpression::Operation(VectorExpression::Op::Equal, type::TypeId::BOOLEAN,
+                                                  std::move(eq_operands)));
+
+  ProjectedColumnsIterator pci(columns);
+  pci.FilterColByVal<std::greater_equal>(0, type::TypeId::INTEGER, pci.MakeFilterVal(50, type::TypeId::INTEGER));
+  pci.FilterByVectorFilter(filter);
+
+  // NULLs never pass
+  uint32_t num_expected = 0;
+  for (uint32_t i = 50; i < num_tuples; i++) {
+    num_expected += static_cast<uint32_t>(i % 3 == 0 && i % 7 != 0);
+  }
+  EXPECT_EQ(num_expected, pci.NumSelected());
+  for (; pci.HasNextFiltered(); pci.AdvanceFiltered()) {
+    bool null = false;
+    const int32_t val = *pci.Get<int32_t, true>(0, &null);
+    EXPECT_FALSE(null);
+    EXPECT_GE(val, 50);
+    EXPECT_EQ(0, val % 3);
+  }
+
+  delete[] buffer;
+}
+
+}  // namespace terrier::execution::sql::test
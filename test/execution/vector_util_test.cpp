@@ -265,6 +265,19 @@ TEST_F(VectorUtilTest, ComparisonsTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorUtilTest, NegativeComparisonsTest) {
+  // The comparisons are signed
+  simd::Vec8 in(-40, -30, -20, -10, 0, 10, 20, 30);
+  auto check = simd::Vec8(-10);
+  simd::Vec8Mask ge_mask = in >= check;
+  simd::Vec8Mask le_mask = in <= check;
+  for (uint32_t i = 0; i < 8; i++) {
+    EXPECT_EQ(i >= 3, ge_mask[i]);
+    EXPECT_EQ(i <= 3, le_mask[i]);
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(VectorUtilTest, MaskToPositionTest) {
   simd::Vec8 vec(3, 0, 4, 1, 5, 2, 6, 2);
@@ -381,6 +394,48 @@ void SmallScaleMultiFilterTest() {
   EXPECT_EQ(actual_count, count);
 }
 
+template <typename T>
+void SmallScaleNegativeFilterTest() {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>, "This only works for signed integral types");
+
+  constexpr const uint32_t num_elems = 4400;
+  constexpr const uint32_t chunk_size = 1024;
+  constexpr const T needle = -16;
+
+  std::vector<T> arr(num_elems);
+
+  uint32_t actual_count = 0;
+
+  // Load
+  {
+    std::mt19937 gen;
+    std::uniform_int_distribution<int32_t> dist(-100, 100);
+    for (uint32_t i = 0; i < num_elems; i++) {
+      arr[i] = static_cast<T>(dist(gen));
+      if (arr[i] >= needle) {
+        actual_count++;
+      }
+    }
+  }
+
+  uint32_t out[chunk_size] = {0};
+
+  uint32_t count = 0;
+  for (uint32_t offset = 0; offset < num_elems; offset += chunk_size) {
+    auto size = std::min(chunk_size, num_elems - offset);
+    auto found = VectorUtil::FilterGe(&arr[offset], size, needle, out, nullptr);
+    count += found;
+
+    // Check each element in this vector
+    for (uint32_t i = 0; i < found; i++) {
+      EXPECT_GE(arr[offset + out[i]], needle);
+    }
+  }
+
+  // Ensure total found through vector util matches what we generated
+  EXPECT_EQ(actual_count, count);
+}
+
 // NOLINTNEXTLINE
 TEST_F(VectorUtilTest, SimpleFilterTest) {
   SmallScaleNeedleTest<int8_t>();
@@ -405,6 +460,14 @@ TEST_F(VectorUtilTest, MultiFilterTest) {
   SmallScaleMultiFilterTest<uint64_t>();
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorUtilTest, NegativeFilterTest) {
+  SmallScaleNegativeFilterTest<int8_t>();
+  SmallScaleNegativeFilterTest<int16_t>();
+  SmallScaleNegativeFilterTest<int32_t>();
+  SmallScaleNegativeFilterTest<int64_t>();
+}
+
 // NOLINTNEXTLINE
 TEST_F(VectorUtilTest, VectorVectorFilterTest) {
   //
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
+#include "common/worker_pool.h"
 #include "main/db_main.h"
 #include "optimizer/optimizer.h"
 #include "parser/postgresparser.h"
@@ -32,8 +33,9 @@ class TpccPlanTest : public TerrierTest {
   void BeginTransaction();
   void EndTransaction(bool commit);
 
-  std::unique_ptr<planner::AbstractPlanNode> Optimize(const std::string &query, catalog::table_oid_t tbl_oid,
-                                                      parser::StatementType stmt_type);
+  std::unique_ptr<planner::AbstractPlanNode> Optimize(
+      const std::string &query, catalog::table_oid_t tbl_oid, parser::StatementType stmt_type,
+      common::ManagedPointer<common::WorkerPool> optimizer_threads = nullptr);
 
   // Optimizer on Insert
   void OptimizeInsert(const std::string &query, catalog::table_oid_t tbl_oid);
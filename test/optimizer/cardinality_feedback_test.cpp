@@ -0,0 +1,50 @@
+#include "optimizer/statistics/cardinality_feedback.h"
+
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+
+namespace terrier::optimizer {
+class CardinalityFeedbackTests : public TerrierTest {
+ protected:
+  CardinalityFeedback feedback_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityFeedbackTests, MisestimateTest) {
+  EXPECT_FALSE(CardinalityFeedback::IsMisestimate(100, 100));
+  EXPECT_FALSE(CardinalityFeedback::IsMisestimate(100, 1000));
+  EXPECT_TRUE(CardinalityFeedback::IsMisestimate(100, 1011));
+  EXPECT_TRUE(CardinalityFeedback::IsMisestimate(1011, 100));
+
+  // Empty results are only misestimated by estimates of more than a few rows
+  EXPECT_FALSE(CardinalityFeedback::IsMisestimate(0, 0));
+  EXPECT_FALSE(CardinalityFeedback::IsMisestimate(5, 0));
+  EXPECT_TRUE(CardinalityFeedback::IsMisestimate(10, 0));
+
+  // Without an estimate, any count is news
+  EXPECT_TRUE(CardinalityFeedback::IsMisestimate(-1, 100));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityFeedbackTests, RecordRowsTest) {
+  const common::hash_t key = 42;
+  EXPECT_EQ(feedback_.GetLearnedRows(key), -1);
+
+  // The first execution is learned as is
+  EXPECT_TRUE(feedback_.RecordRows(key, 10, 1000));
+  EXPECT_EQ(feedback_.GetLearnedRows(key), 1000);
+
+  // Close observations are blended in
+  EXPECT_FALSE(feedback_.RecordRows(key, 1000, 1200));
+  EXPECT_EQ(feedback_.GetLearnedRows(key), 1100);
+
+  // Grossly misestimated ones replace the learned count
+  EXPECT_TRUE(feedback_.RecordRows(key, 1100, 20));
+  EXPECT_EQ(feedback_.GetLearnedRows(key), 20);
+
+  // Fragments with key 0 are not tracked
+  EXPECT_FALSE(feedback_.RecordRows(0, -1, 100));
+  EXPECT_EQ(feedback_.GetLearnedRows(0), -1);
+}
+
+}  // namespace terrier::optimizer
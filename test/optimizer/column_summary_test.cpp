@@ -0,0 +1,70 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "optimizer/statistics/column_summary.h"
+#include "storage/storage_defs.h"
+
+#include "test_util/test_harness.h"
+
+namespace terrier::optimizer {
+
+class ColumnSummaryTests : public TerrierTest {
+ protected:
+  // Add the integers in [begin, end) to the summary
+  static void AddIntegers(ColumnSummary *const summary, const int32_t begin, const int32_t end) {
+    for (int32_t i = begin; i < end; i++) summary->Add(type::TypeId::INTEGER, reinterpret_cast<const byte *>(&i));
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(ColumnSummaryTests, SparseTest) {
+  // A few values are counted exactly, however often they repeat
+  ColumnSummary summary;
+  for (int round = 0; round < 10; round++) AddIntegers(&summary, 0, 100);
+  summary.AddNull();
+  EXPECT_EQ(summary.EstimateCardinality(), 100);
+  EXPECT_EQ(summary.GetNumValues(), 1000);
+  EXPECT_EQ(summary.GetNumNulls(), 1);
+  ASSERT_TRUE(summary.HasMinMax());
+  EXPECT_EQ(summary.GetMinValue(), 0.0);
+  EXPECT_EQ(summary.GetMaxValue(), 99.0);
+
+  // Variable-length values are summarized by their content, and have no min/max
+  ColumnSummary varlen_summary;
+  EXPECT_FALSE(varlen_summary.HasMinMax());
+  for (const std::string value : {"apple", "banana", "apple"}) {
+    const auto entry = storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(value.data()),
+                                                          static_cast<uint32_t>(value.size()));
+    varlen_summary.Add(type::TypeId::VARCHAR, reinterpret_cast<const byte *>(&entry));
+  }
+  EXPECT_EQ(varlen_summary.EstimateCardinality(), 2);
+  EXPECT_FALSE(varlen_summary.HasMinMax());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ColumnSummaryTests, MergeTest) {
+  // A summary of many values merged with a sparse summary and with another sketch estimates the union
+  ColumnSummary summary;
+  AddIntegers(&summary, 0, 100000);
+  const double error = 0.05;
+  EXPECT_NEAR(static_cast<double>(summary.EstimateCardinality()), 100000, 100000 * error);
+
+  ColumnSummary sparse;
+  AddIntegers(&sparse, 99990, 100010);
+  ColumnSummary dense;
+  AddIntegers(&dense, 150000, 200000);
+  summary.Merge(sparse);
+  summary.Merge(dense);
+  EXPECT_NEAR(static_cast<double>(summary.EstimateCardinality()), 150010, 150010 * error);
+  EXPECT_EQ(summary.GetNumValues(), 150020);
+  EXPECT_EQ(summary.GetMinValue(), 0.0);
+  EXPECT_EQ(summary.GetMaxValue(), 199999.0);
+
+  // A sparse summary becomes a sketch when a merge gives it too many values
+  ColumnSummary small;
+  AddIntegers(&small, 0, 10);
+  small.Merge(dense);
+  EXPECT_NEAR(static_cast<double>(small.EstimateCardinality()), 50010, 50010 * error);
+}
+
+}  // namespace terrier::optimizer
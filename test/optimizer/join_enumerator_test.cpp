@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "optimizer/cost_model/stats_cost_model.h"
+#include "optimizer/join_enumerator.h"
+#include "optimizer/statistics/stats_storage.h"
+
+#include "test_util/test_harness.h"
+
+namespace terrier::optimizer {
+
+using RelationSet = JoinEnumerator::RelationSet;
+
+class JoinEnumeratorTests : public TerrierTest {
+ protected:
+  struct TestEdge {
+    RelationSet left_;
+    RelationSet right_;
+    double selectivity_;
+  };
+
+  // Add a relation to the enumerator and to the copy of the graph
+  void AddRelation(JoinEnumerator *enumerator, const double num_rows) {
+    enumerator->AddRelation(num_rows);
+    rows_.push_back(num_rows);
+  }
+
+  // Add an equality predicate to the enumerator and to the copy of the graph
+  void AddEdge(JoinEnumerator *enumerator, const RelationSet left, const RelationSet right, const double selectivity) {
+    enumerator->AddEdge(left, right, selectivity, true);
+    edges_.push_back({left, right, selectivity});
+  }
+
+  bool Connects(const RelationSet left, const RelationSet right) const {
+    return std::any_of(edges_.begin(), edges_.end(), [&](const TestEdge &edge) {
+      return ((edge.left_ & ~left) == 0 && (edge.right_ & ~right) == 0) ||
+             ((edge.left_ & ~right) == 0 && (edge.right_ & ~left) == 0);
+    });
+  }
+
+  double Rows(const RelationSet relations) const {
+    double rows = 1.0;
+    for (size_t relation = 0; relation < rows_.size(); relation++) {
+      if ((relations & (RelationSet{1} << relation)) != 0) rows *= rows_[relation];
+    }
+    for (const auto &edge : edges_) {
+      if (((edge.left_ | edge.right_) & ~relations) == 0) rows *= edge.selectivity_;
+    }
+    return std::max(rows, 1.0);
+  }
+
+  // The cost of the cheapest plan without cross products, found by trying every split of every set of relations
+  double ExhaustiveCost() const {
+    const RelationSet all = (RelationSet{1} << rows_.size()) - 1;
+    std::unordered_map<RelationSet, double> costs;
+    for (size_t relation = 0; relation < rows_.size(); relation++) costs[RelationSet{1} << relation] = 0;
+    for (RelationSet relations = 1; relations <= all; relations++) {
+      double best = std::numeric_limits<double>::max();
+      for (RelationSet left = (relations - 1) & relations; left != 0; left = (left - 1) & relations) {
+        const RelationSet right = relations & ~left;
+        if (costs.count(left) == 0 || costs.count(right) == 0 || !Connects(left, right)) continue;
+        size_t num_predicates = 0;
+        for (const auto &edge : edges_) {
+          const RelationSet both = edge.left_ | edge.right_;
+          if ((both & ~relations) == 0 && (both & ~left) != 0 && (both & ~right) != 0) num_predicates++;
+        }
+        best = std::min(best, costs[left] + costs[right] +
+                                  cost_model_.EstimateJoinCost(Rows(left), Rows(right), Rows(relations),
+                                                               num_predicates, num_predicates > 0));
+      }
+      if (best < std::numeric_limits<double>::max()) costs[relations] = best;
+    }
+    return costs.at(all);
+  }
+
+  // Check that every join of the plan of the relations joins two connected subplans
+  void CheckNoCrossProducts(const JoinEnumerator &enumerator, const RelationSet relations) const {
+    const auto &plan = enumerator.GetPlan(relations);
+    if (plan.left_ == 0) return;
+    EXPECT_EQ(plan.left_ | plan.right_, relations);
+    EXPECT_EQ(plan.left_ & plan.right_, 0);
+    EXPECT_TRUE(Connects(plan.left_, plan.right_));
+    CheckNoCrossProducts(enumerator, plan.left_);
+    CheckNoCrossProducts(enumerator, plan.right_);
+  }
+
+  std::vector<double> rows_;
+  std::vector<TestEdge> edges_;
+  StatsStorage stats_storage_;
+  StatsCostModel cost_model_{common::ManagedPointer(&stats_storage_)};
+};
+
+// NOLINTNEXTLINE
+TEST_F(JoinEnumeratorTests, DPhypTest) {
+  // A cycle with a chord over tables of very different sizes, where DPhyp must find the cheapest bushy plan
+  JoinEnumerator enumerator{common::ManagedPointer<AbstractCostModel>(&cost_model_)};
+  const std::vector<double> sizes = {100000, 20, 5000, 300, 800000, 10, 60000};
+  for (const double size : sizes) AddRelation(&enumerator, size);
+  for (size_t relation = 0; relation < sizes.size(); relation++) {
+    const size_t next = (relation + 1) % sizes.size();
+    AddEdge(&enumerator, RelationSet{1} << relation, RelationSet{1} << next,
+            1.0 / std::max(sizes[relation], sizes[next]));
+  }
+  AddEdge(&enumerator, 1 << 1, 1 << 4, 0.01);
+  ASSERT_TRUE(enumerator.IsConnected());
+
+  const auto &plan = enumerator.Enumerate();
+  EXPECT_FALSE(enumerator.UsedGreedy());
+  EXPECT_DOUBLE_EQ(plan.rows_, Rows(enumerator.GetAllRelations()));
+  EXPECT_NEAR(plan.cost_, ExhaustiveCost(), plan.cost_ * 1e-9);
+  CheckNoCrossProducts(enumerator, enumerator.GetAllRelations());
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinEnumeratorTests, HyperedgeTest) {
+  // A predicate over three tables, e.g. a.x + b.y = c.z, can only be evaluated once a and b are joined
+  JoinEnumerator enumerator{common::ManagedPointer<AbstractCostModel>(&cost_model_)};
+  for (const double size : {1000.0, 2000.0, 10.0, 500.0, 700.0}) AddRelation(&enumerator, size);
+  AddEdge(&enumerator, 0b00001, 0b00010, 0.001);
+  AddEdge(&enumerator, 0b00011, 0b00100, 0.1);
+  AddEdge(&enumerator, 0b00100, 0b01000, 0.01);
+  AddEdge(&enumerator, 0b01000, 0b10000, 0.002);
+  ASSERT_TRUE(enumerator.IsConnected());
+
+  const auto &plan = enumerator.Enumerate();
+  EXPECT_FALSE(enumerator.UsedGreedy());
+  EXPECT_NEAR(plan.cost_, ExhaustiveCost(), plan.cost_ * 1e-9);
+  CheckNoCrossProducts(enumerator, enumerator.GetAllRelations());
+
+  // Without the predicates connecting them, two halves of a graph cannot be joined
+  JoinEnumerator disconnected{common::ManagedPointer<AbstractCostModel>(&cost_model_)};
+  for (int relation = 0; relation < 4; relation++) disconnected.AddRelation(100);
+  disconnected.AddEdge(0b0001, 0b0010, 0.01, true);
+  disconnected.AddEdge(0b0100, 0b1000, 0.01, true);
+  EXPECT_FALSE(disconnected.IsConnected());
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinEnumeratorTests, GreedyFallbackTest) {
+  // A clique of 20 tables has far too many pairs of subgraphs for DPhyp, so the joins are ordered greedily
+  JoinEnumerator enumerator{common::ManagedPointer<AbstractCostModel>(&cost_model_)};
+  const size_t num_relations = 20;
+  for (size_t relation = 0; relation < num_relations; relation++) {
+    AddRelation(&enumerator, static_cast<double>(100 * (relation + 1)));
+  }
+  for (size_t left = 0; left < num_relations; left++) {
+    for (size_t right = left + 1; right < num_relations; right++) {
+      AddEdge(&enumerator, RelationSet{1} << left, RelationSet{1} << right, 0.1);
+    }
+  }
+
+  const auto &plan = enumerator.Enumerate();
+  EXPECT_TRUE(enumerator.UsedGreedy());
+  EXPECT_GT(enumerator.GetNumPairs(), JoinEnumerator::K_MAX_CSG_CMP_PAIRS);
+  EXPECT_DOUBLE_EQ(plan.rows_, Rows(enumerator.GetAllRelations()));
+  CheckNoCrossProducts(enumerator, enumerator.GetAllRelations());
+}
+
+}  // namespace terrier::optimizer
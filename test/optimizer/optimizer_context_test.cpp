@@ -1,8 +1,14 @@
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
+#include <stdexcept>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
+#include "common/managed_pointer.h"
+#include "common/worker_pool.h"
 #include "optimizer/binding.h"
 #include "optimizer/optimizer_context.h"
 #include "optimizer/optimizer_defs.h"
@@ -20,6 +26,56 @@ struct OptimizerContextTest : public TerrierTest {
   void TearDown() override { TerrierTest::TearDown(); }
 };
 
+/**
+ * Task that records when it runs, and then pushes its children to the pool.
+ * A task with id 1 pushes the tasks 10 to 14, which push the tasks 100 to 104 and 140 to 144.
+ */
+class RecordingTask : public OptimizerTask {
+ public:
+  RecordingTask(OptimizerTaskPool *pool, std::vector<int> *order, common::SpinLatch *latch, int id, bool parallel)
+      : OptimizerTask(nullptr, OptimizerTaskType::OPTIMIZE_GROUP),
+        pool_(pool),
+        order_(order),
+        latch_(latch),
+        id_(id),
+        parallel_(parallel) {}
+
+  void Execute() override {
+    {
+      common::SpinLatch::ScopedSpinLatch guard(latch_);
+      order_->push_back(id_);
+    }
+    if (id_ >= 100) return;
+
+    std::vector<OptimizerTask *> children;
+    for (int child = 0; child < 5; child++) {
+      children.push_back(new RecordingTask(pool_, order_, latch_, id_ * 10 + child, parallel_));
+    }
+    if (parallel_) {
+      pool_->PushParallel(std::move(children));
+    } else {
+      for (auto *task : children) pool_->Push(task);
+    }
+  }
+
+ private:
+  OptimizerTaskPool *pool_;
+  std::vector<int> *order_;
+  common::SpinLatch *latch_;
+  int id_;
+  bool parallel_;
+};
+
+/**
+ * Task that throws when it runs
+ */
+class ThrowingTask : public OptimizerTask {
+ public:
+  ThrowingTask() : OptimizerTask(nullptr, OptimizerTaskType::OPTIMIZE_GROUP) {}
+
+  void Execute() override { throw std::runtime_error("task failed"); }
+};
+
 // NOLINTNEXTLINE
 TEST_F(OptimizerContextTest, PatternTest) {
   // Creates a Pattern and makes sure everything is set correctly
@@ -109,6 +165,134 @@ TEST_F(OptimizerContextTest, OptimizerContextTaskStackNullptrTest) {
   context.SetTaskPool(nullptr);
 }
 
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, ParallelOptimizerTaskPoolStackTest) {
+  // Outside of execution, the pool behaves as a stack, batches included
+  common::WorkerPool threads(3, {});
+  ParallelOptimizerTaskPool pool(common::ManagedPointer(&threads));
+  std::vector<OptimizerTask *> pushed;
+  for (size_t i = 0; i < 5; i++) pushed.push_back(new OptimizeGroup(nullptr, nullptr));
+  pool.Push(pushed[0]);
+  pool.Push(pushed[1]);
+  pool.PushParallel({pushed[2], pushed[3]});
+  pool.PushDeferred(pushed[4]);
+
+  for (size_t i = pushed.size(); i > 0; i--) {
+    ASSERT_FALSE(pool.Empty());
+    auto *task = pool.Pop();
+    EXPECT_EQ(task, pushed[i - 1]);
+    delete task;
+  }
+  EXPECT_TRUE(pool.Empty());
+
+  // Tasks left in the pool are freed with it
+  pool.Push(new OptimizeGroup(nullptr, nullptr));
+  pool.PushParallel({new OptimizeGroup(nullptr, nullptr), new OptimizeGroup(nullptr, nullptr)});
+}
+
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, ParallelOptimizerTaskPoolOrderTest) {
+  // Without batches, the tasks run in the order of a stack, whatever the number of workers
+  common::SpinLatch latch;
+  std::vector<int> expected;
+  OptimizerTaskStack stack;
+  stack.Push(new RecordingTask(&stack, &expected, &latch, 2, false));
+  stack.Push(new RecordingTask(&stack, &expected, &latch, 1, false));
+  EXPECT_TRUE(stack.ExecuteTasks([](uint64_t) { return false; }));
+  EXPECT_EQ(expected.size(), 62);
+
+  for (uint32_t num_workers : {1, 4}) {
+    std::vector<int> order;
+    common::WorkerPool threads(num_workers - 1, {});
+    ParallelOptimizerTaskPool pool(common::ManagedPointer(&threads));
+    pool.Push(new RecordingTask(&pool, &order, &latch, 2, false));
+    pool.Push(new RecordingTask(&pool, &order, &latch, 1, false));
+    EXPECT_TRUE(pool.ExecuteTasks([](uint64_t) { return false; }));
+    EXPECT_EQ(order, expected);
+    EXPECT_TRUE(pool.Empty());
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, ParallelOptimizerTaskPoolBatchTest) {
+  // The tasks of a batch run concurrently, and all finish before the task pushed before the batch
+  common::SpinLatch latch;
+  std::vector<int> order;
+  common::WorkerPool threads(3, {});
+  ParallelOptimizerTaskPool pool(common::ManagedPointer(&threads));
+  pool.Push(new RecordingTask(&pool, &order, &latch, 2, true));
+  pool.Push(new RecordingTask(&pool, &order, &latch, 1, true));
+  EXPECT_TRUE(pool.ExecuteTasks([](uint64_t) { return false; }));
+
+  ASSERT_EQ(order.size(), 62);
+  EXPECT_EQ(order.front(), 1);
+  // Tasks 1x and 1xx all ran before task 2
+  const auto task_2 = std::find(order.begin(), order.end(), 2);
+  ASSERT_NE(task_2, order.end());
+  EXPECT_EQ(task_2 - order.begin(), 31);
+  for (auto it = order.begin(); it != task_2; it++) {
+    EXPECT_TRUE(*it == 1 || (*it >= 10 && *it < 15) || (*it >= 100 && *it < 150));
+  }
+
+  // A task of a batch runs after the task that pushed it
+  for (int parent = 10; parent < 15; parent++) {
+    const auto parent_it = std::find(order.begin(), order.end(), parent);
+    for (int child = parent * 10; child < parent * 10 + 5; child++) {
+      EXPECT_LT(parent_it - order.begin(), std::find(order.begin(), order.end(), child) - order.begin());
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, ParallelOptimizerTaskPoolSharedThreadsTest) {
+  // Concurrent executions share the threads of a worker pool, and each waits for its own tasks only
+  common::SpinLatch latch;
+  std::vector<int> expected;
+  OptimizerTaskStack stack;
+  stack.Push(new RecordingTask(&stack, &expected, &latch, 2, false));
+  stack.Push(new RecordingTask(&stack, &expected, &latch, 1, false));
+  EXPECT_TRUE(stack.ExecuteTasks([](uint64_t) { return false; }));
+
+  common::WorkerPool threads(3, {});
+  std::vector<std::vector<int>> orders(4);
+  std::vector<std::thread> executions;
+  for (auto &order : orders) {
+    executions.emplace_back([&threads, &order] {
+      common::SpinLatch order_latch;
+      for (int execution = 0; execution < 10; execution++) {
+        order.clear();
+        ParallelOptimizerTaskPool pool(common::ManagedPointer(&threads));
+        pool.Push(new RecordingTask(&pool, &order, &order_latch, 2, false));
+        pool.Push(new RecordingTask(&pool, &order, &order_latch, 1, false));
+        EXPECT_TRUE(pool.ExecuteTasks([](uint64_t) { return false; }));
+        EXPECT_TRUE(pool.Empty());
+      }
+    });
+  }
+  for (auto &execution : executions) execution.join();
+  for (const auto &order : orders) EXPECT_EQ(order, expected);
+}
+
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, ParallelOptimizerTaskPoolStopTest) {
+  // An execution that stops early discards the tasks that did not run
+  common::SpinLatch latch;
+  std::vector<int> order;
+  common::WorkerPool threads(3, {});
+  ParallelOptimizerTaskPool pool(common::ManagedPointer(&threads));
+  pool.Push(new RecordingTask(&pool, &order, &latch, 1, true));
+  std::atomic<uint32_t> checks = 0;
+  EXPECT_FALSE(pool.ExecuteTasks([&](uint64_t) { return ++checks >= 3; }));
+  EXPECT_LT(order.size(), 31);
+  EXPECT_TRUE(pool.Empty());
+
+  // The exception of a task ends the execution
+  pool.Push(new RecordingTask(&pool, &order, &latch, 1, true));
+  pool.Push(new ThrowingTask());
+  EXPECT_THROW(pool.ExecuteTasks([](uint64_t) { return false; }), std::runtime_error);
+  EXPECT_TRUE(pool.Empty());
+}
+
 // NOLINTNEXTLINE
 TEST_F(OptimizerContextTest, RecordOperatorExpressionIntoGroupDuplicateSingleLayer) {
   auto context = OptimizerContext(nullptr);
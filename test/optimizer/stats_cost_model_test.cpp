@@ -0,0 +1,169 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "optimizer/cost_model/stats_cost_model.h"
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/logical_operators.h"
+#include "optimizer/memo.h"
+#include "optimizer/physical_operators.h"
+#include "optimizer/statistics/stats_storage.h"
+#include "parser/expression/column_value_expression.h"
+#include "type/transient_value_factory.h"
+
+#include "test_util/test_harness.h"
+
+namespace terrier::optimizer {
+class StatsCostModelTests : public TerrierTest {
+ protected:
+  const catalog::db_oid_t db_oid_{1};
+  const catalog::namespace_oid_t ns_oid_{1};
+
+  // Add a base table group of the given number of rows to the memo
+  group_id_t AddTableGroup(const catalog::table_oid_t table_oid, const int num_rows) {
+    auto gexpr = memo_.InsertExpression(
+        new GroupExpression(LogicalGet::Make(db_oid_, ns_oid_, table_oid, {}, "tbl", false), {}), false);
+    memo_.GetGroupByID(gexpr->GetGroupID())->SetNumRows(num_rows);
+    return gexpr->GetGroupID();
+  }
+
+  // Add a group over the given children to the memo
+  group_id_t AddGroup(Operator op, std::vector<group_id_t> &&children, const int num_rows) {
+    auto gexpr = memo_.InsertExpression(new GroupExpression(std::move(op), std::move(children)), false);
+    memo_.GetGroupByID(gexpr->GetGroupID())->SetNumRows(num_rows);
+    return gexpr->GetGroupID();
+  }
+
+  // Cost a physical operator placed in the given group, with the given model or the default one
+  double Cost(Operator op, const group_id_t group_id, std::vector<group_id_t> &&children = {},
+              StatsCostModel *model = nullptr) {
+    auto gexpr = memo_.InsertExpression(new GroupExpression(std::move(op), std::move(children)), group_id, false);
+    return (model == nullptr ? &cost_model_ : model)->CalculateCost(nullptr, &memo_, gexpr);
+  }
+
+  Memo memo_;
+  StatsStorage stats_storage_;
+  StatsCostModel cost_model_{common::ManagedPointer(&stats_storage_)};
+};
+
+// NOLINTNEXTLINE
+TEST_F(StatsCostModelTests, ScanTest) {
+  const catalog::table_oid_t analyzed_oid(1);
+  const catalog::table_oid_t unknown_oid(2);
+  ColumnStats column_stats(db_oid_, analyzed_oid, catalog::col_oid_t(1), 100000, 100000, 0.0, {}, {}, {}, true);
+  stats_storage_.InsertTableStats(db_oid_, analyzed_oid,
+                                  TableStats(db_oid_, analyzed_oid, 100000, true, {column_stats}));
+  const auto index_scan = [&](const catalog::table_oid_t table_oid, std::vector<parser::ExpressionType> &&key_types) {
+    return IndexScan::Make(db_oid_, ns_oid_, catalog::index_oid_t(!table_oid), {}, "tbl", false,
+                           {catalog::col_oid_t(1)}, std::move(key_types), {});
+  };
+
+  // A point lookup on a table that was never analyzed goes through the index
+  const auto unknown_group = AddTableGroup(unknown_oid, -1);
+  EXPECT_LT(Cost(index_scan(unknown_oid, {parser::ExpressionType::COMPARE_EQUAL}), unknown_group),
+            Cost(SeqScan::Make(db_oid_, ns_oid_, unknown_oid, {}, "tbl", false), unknown_group));
+
+  // A selective predicate on an analyzed table goes through the index, but one that keeps half the table does not
+  const auto analyzed_group = AddTableGroup(analyzed_oid, 10);
+  EXPECT_LT(Cost(index_scan(analyzed_oid, {parser::ExpressionType::COMPARE_EQUAL}), analyzed_group),
+            Cost(SeqScan::Make(db_oid_, ns_oid_, analyzed_oid, {}, "tbl", false), analyzed_group));
+  memo_.GetGroupByID(analyzed_group)->SetNumRows(50000);
+  EXPECT_GT(Cost(index_scan(analyzed_oid, {parser::ExpressionType::COMPARE_EQUAL}), analyzed_group),
+            Cost(SeqScan::Make(db_oid_, ns_oid_, analyzed_oid, {}, "tbl", false), analyzed_group));
+
+  // Every value of an IN list is probed separately, and fetches its own matches
+  std::vector<type::TransientValue> in_values;
+  in_values.push_back(type::TransientValueFactory::GetNull(type::TypeId::INTEGER));
+  const auto in_scan =
+      IndexScan::Make(db_oid_, ns_oid_, catalog::index_oid_t(!unknown_oid), {}, "tbl", false, {catalog::col_oid_t(1)},
+                      {parser::ExpressionType::COMPARE_IN}, std::move(in_values), {10});
+  EXPECT_GT(Cost(in_scan, unknown_group),
+            Cost(index_scan(unknown_oid, {parser::ExpressionType::COMPARE_EQUAL}), unknown_group));
+}
+
+// NOLINTNEXTLINE
+TEST_F(StatsCostModelTests, JoinTest) {
+  const auto single = AddTableGroup(catalog::table_oid_t(1), 1);
+  const auto large = AddTableGroup(catalog::table_oid_t(2), 100000);
+  const auto other_large = AddTableGroup(catalog::table_oid_t(3), 100000);
+
+  // A nested loop is cheapest for a single outer tuple
+  const auto small_join = AddGroup(LogicalInnerJoin::Make(), {single, large}, 1);
+  EXPECT_LT(Cost(InnerNLJoin::Make({}, {}, {}), small_join, {single, large}),
+            Cost(InnerHashJoin::Make({}, {}, {}), small_join, {single, large}));
+
+  // Large inputs are joined by hashing, building the hash table on the smaller side
+  const auto large_join = AddGroup(LogicalInnerJoin::Make(), {large, other_large}, 100000);
+  EXPECT_GT(Cost(InnerNLJoin::Make({}, {}, {}), large_join, {large, other_large}),
+            Cost(InnerHashJoin::Make({}, {}, {}), large_join, {large, other_large}));
+  const auto mixed_join = AddGroup(LogicalInnerJoin::Make(), {large, single}, 1);
+  EXPECT_LT(Cost(InnerHashJoin::Make({}, {}, {}), small_join, {single, large}),
+            Cost(InnerHashJoin::Make({}, {}, {}), mixed_join, {large, single}));
+
+  // A merge join sorts its left input itself. With a small left input and a right input that arrives sorted it is
+  // cheaper than hashing, but sorting the right input first does not pay off
+  const auto medium = AddTableGroup(catalog::table_oid_t(4), 1000);
+  const auto medium_join = AddGroup(LogicalInnerJoin::Make(), {medium, large}, 100000);
+  const double merge_cost = Cost(InnerMergeJoin::Make({}, {}, {}), medium_join, {medium, large});
+  const double hash_cost = Cost(InnerHashJoin::Make({}, {}, {}), medium_join, {medium, large});
+  EXPECT_LT(merge_cost, hash_cost);
+  EXPECT_GT(merge_cost + Cost(OrderBy::Make(), large), hash_cost);
+
+  // Sorting a large left input inside the join costs more than hashing it
+  EXPECT_GT(Cost(InnerMergeJoin::Make({}, {}, {}), large_join, {large, other_large}),
+            Cost(InnerHashJoin::Make({}, {}, {}), large_join, {large, other_large}));
+}
+
+// NOLINTNEXTLINE
+TEST_F(StatsCostModelTests, GroupByTest) {
+  const auto table = AddTableGroup(catalog::table_oid_t(1), 100000);
+  parser::ColumnValueExpression column("tbl", "col");
+  memo_.GetGroupByID(table)->AddStats(
+      column.GetFullName(), std::make_unique<ColumnStats>(db_oid_, catalog::table_oid_t(1), catalog::col_oid_t(1),
+                                                          100000, 10, 0.0, std::vector<double>{},
+                                                          std::vector<double>{}, std::vector<double>{}, true));
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> columns{
+      common::ManagedPointer<parser::AbstractExpression>(&column)};
+  const auto group_by = AddGroup(LogicalAggregateAndGroupBy::Make(std::vector(columns)), {table}, 10);
+
+  // Sorted input aggregates in a single pass, but sorting it first costs more than hashing
+  const double hash_cost = Cost(HashGroupBy::Make(std::vector(columns), {}), group_by, {table});
+  const double sort_cost = Cost(SortGroupBy::Make(std::vector(columns), {}), group_by, {table});
+  EXPECT_LT(sort_cost, hash_cost);
+  EXPECT_GT(sort_cost + Cost(OrderBy::Make(), table), hash_cost);
+}
+
+// NOLINTNEXTLINE
+TEST_F(StatsCostModelTests, MemoryBudgetTest) {
+  // Room for the build side of 1000 tuples, but not of 100000
+  CostModelParameters params;
+  params.memory_budget_ = 1000 * params.tuple_width_;
+  StatsCostModel limited_model{common::ManagedPointer(&stats_storage_), params};
+
+  // A build side that fits does not spill
+  EXPECT_EQ(limited_model.EstimateJoinCost(1000, 100000, 1000, 1, true),
+            cost_model_.EstimateJoinCost(1000, 100000, 1000, 1, true));
+
+  // A build side over the budget spills both inputs once
+  const double unlimited_cost = cost_model_.EstimateJoinCost(100000, 100000, 1000, 1, true);
+  EXPECT_DOUBLE_EQ(limited_model.EstimateJoinCost(100000, 100000, 1000, 1, true),
+                   unlimited_cost + 200000 * params.spill_tuple_cost_);
+
+  // Hash aggregations of more groups than fit spill their input, unless a single small integer key addresses the
+  // groups directly
+  const auto table = AddTableGroup(catalog::table_oid_t(1), 100000);
+  parser::ColumnValueExpression int_column(catalog::table_oid_t(1), catalog::col_oid_t(1), type::TypeId::INTEGER);
+  parser::ColumnValueExpression tinyint_column(catalog::table_oid_t(1), catalog::col_oid_t(2), type::TypeId::TINYINT);
+  for (auto *column : {&int_column, &tinyint_column}) {
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> columns{
+        common::ManagedPointer<parser::AbstractExpression>(column)};
+    const auto group_by = AddGroup(LogicalAggregateAndGroupBy::Make(std::vector(columns)), {table}, 10000);
+    const double spill_cost = Cost(HashGroupBy::Make(std::vector(columns), {}), group_by, {table}, &limited_model) -
+                              Cost(HashGroupBy::Make(std::vector(columns), {}), group_by, {table});
+    EXPECT_DOUBLE_EQ(column == &int_column ? 100000 * params.spill_tuple_cost_ : 0.0, spill_cost);
+  }
+}
+
+}  // namespace terrier::optimizer
@@ -30,7 +30,6 @@ class StatsStorageTests : public TerrierTest {
     table_stats_obj_ = TableStats(
         catalog::db_oid_t(1), catalog::table_oid_t(1), 5, true,
         {column_stats_obj_1_, column_stats_obj_2_, column_stats_obj_3_, column_stats_obj_4_, column_stats_obj_5_});
-    stats_storage_ = StatsStorage();
   }
 };
 
@@ -55,4 +54,62 @@ TEST_F(StatsStorageTests, DeleteTableStatsTest) {
 
   ASSERT_EQ(false, stats_storage_.DeleteTableStats(catalog::db_oid_t(2), catalog::table_oid_t(1)));
 }
+
+// NOLINTNEXTLINE
+TEST_F(StatsStorageTests, StaleTablesTest) {
+  const auto modify = [&](const catalog::table_oid_t table_oid, const int num_rows) {
+    TableStatsDelta delta;
+    for (int i = 0; i < num_rows; i++) delta.RecordInsert();
+    stats_storage_.ApplyTableStatsDelta(catalog::db_oid_t(1), table_oid, delta);
+  };
+
+  // An analyzed table of 5 rows goes stale once more than 50 + 10% of its rows are modified
+  stats_storage_.InsertTableStats(catalog::db_oid_t(1), catalog::table_oid_t(1), std::move(table_stats_obj_));
+  modify(catalog::table_oid_t(1), 40);
+  EXPECT_EQ(stats_storage_.GetTableStats(catalog::db_oid_t(1), catalog::table_oid_t(1))->GetNumRows(), 45);
+  EXPECT_TRUE(stats_storage_.TakeStaleTables().empty());
+  modify(catalog::table_oid_t(1), 20);
+  auto stale_tables = stats_storage_.TakeStaleTables();
+  ASSERT_EQ(stale_tables.size(), 1);
+  EXPECT_EQ(stale_tables[0], std::make_pair(catalog::db_oid_t(1), catalog::table_oid_t(1)));
+  EXPECT_TRUE(stats_storage_.TakeStaleTables().empty());
+
+  // A table that was never analyzed gets no statistics, but goes stale as well
+  modify(catalog::table_oid_t(2), 51);
+  EXPECT_EQ(stats_storage_.GetTableStats(catalog::db_oid_t(1), catalog::table_oid_t(2)), nullptr);
+  stale_tables = stats_storage_.TakeStaleTables();
+  ASSERT_EQ(stale_tables.size(), 1);
+  EXPECT_EQ(stale_tables[0], std::make_pair(catalog::db_oid_t(1), catalog::table_oid_t(2)));
+
+  // Analyzing the table forgets its modifications
+  modify(catalog::table_oid_t(2), 51);
+  stats_storage_.InsertTableStats(catalog::db_oid_t(1), catalog::table_oid_t(2),
+                                  TableStats(catalog::db_oid_t(1), catalog::table_oid_t(2), 102, true, {}));
+  EXPECT_TRUE(stats_storage_.TakeStaleTables().empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(StatsStorageTests, SnapshotTest) {
+  stats_storage_.InsertTableStats(catalog::db_oid_t(1), catalog::table_oid_t(1), std::move(table_stats_obj_));
+  const auto snapshot = stats_storage_.GetTableStats(catalog::db_oid_t(1), catalog::table_oid_t(1));
+  ASSERT_NE(snapshot, nullptr);
+
+  // Deltas publish new statistics and leave the ones readers hold alone
+  TableStatsDelta delta;
+  for (int i = 0; i < 10; i++) delta.RecordInsert();
+  stats_storage_.ApplyTableStatsDelta(catalog::db_oid_t(1), catalog::table_oid_t(1), delta);
+  EXPECT_EQ(snapshot->GetNumRows(), 5);
+  EXPECT_EQ(snapshot->GetNumModifiedRows(), 0);
+  EXPECT_EQ(stats_storage_.GetTableStats(catalog::db_oid_t(1), catalog::table_oid_t(1))->GetNumRows(), 15);
+
+  // So does replacing the statistics
+  stats_storage_.ReplaceTableStats(catalog::db_oid_t(1), catalog::table_oid_t(1),
+                                   TableStats(catalog::db_oid_t(1), catalog::table_oid_t(1), 100, true, {}));
+  EXPECT_EQ(snapshot->GetNumRows(), 5);
+  EXPECT_EQ(snapshot->GetColumnCount(), 5);
+  const auto replaced = stats_storage_.GetTableStats(catalog::db_oid_t(1), catalog::table_oid_t(1));
+  ASSERT_NE(replaced, nullptr);
+  EXPECT_EQ(replaced->GetNumRows(), 100);
+  EXPECT_EQ(replaced->GetColumnCount(), 0);
+}
 }  // namespace terrier::optimizer
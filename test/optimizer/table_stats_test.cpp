@@ -2,6 +2,7 @@
 
 #include "gtest/gtest.h"
 #include "optimizer/statistics/table_stats.h"
+#include "optimizer/statistics/table_stats_delta.h"
 
 #include "test_util/test_harness.h"
 
@@ -85,6 +86,36 @@ TEST_F(TableStatsTests, IsBaseTableTest) { ASSERT_EQ(table_stats_obj_.IsBaseTabl
 // NOLINTNEXTLINE
 TEST_F(TableStatsTests, GetNumRowsTest) { ASSERT_EQ(table_stats_obj_.GetNumRows(), 5); }
 
+// NOLINTNEXTLINE
+TEST_F(TableStatsTests, ApplyDeltaTest) {
+  // Insert 10 rows of new values into column 1, and delete 3 rows
+  TableStatsDelta delta;
+  for (int32_t i = 100; i < 110; i++) {
+    delta.RecordInsert();
+    delta.GetColumnSummary(catalog::col_oid_t(1))->Add(type::TypeId::INTEGER, reinterpret_cast<const byte *>(&i));
+  }
+  for (int i = 0; i < 3; i++) delta.RecordDelete();
+  table_stats_obj_.ApplyDelta(delta);
+
+  EXPECT_EQ(table_stats_obj_.GetNumRows(), 12);
+  EXPECT_EQ(table_stats_obj_.GetNumModifiedRows(), 13);
+  EXPECT_EQ(table_stats_obj_.GetColumnStats(catalog::col_oid_t(1))->GetNumRows(), 12);
+  EXPECT_EQ(table_stats_obj_.GetCardinality(catalog::col_oid_t(1)), 10);
+  EXPECT_EQ(table_stats_obj_.GetCardinality(catalog::col_oid_t(2)), 4);
+  const auto summary = table_stats_obj_.GetColumnSummary(catalog::col_oid_t(1));
+  ASSERT_NE(summary, nullptr);
+  EXPECT_EQ(summary->GetMinValue(), 100.0);
+  EXPECT_EQ(summary->GetMaxValue(), 109.0);
+  EXPECT_EQ(table_stats_obj_.GetColumnSummary(catalog::col_oid_t(2)), nullptr);
+
+  // Deleting more rows than the table holds empties it
+  TableStatsDelta delete_all;
+  for (int i = 0; i < 20; i++) delete_all.RecordDelete();
+  table_stats_obj_.ApplyDelta(delete_all);
+  EXPECT_EQ(table_stats_obj_.GetNumRows(), 0);
+  EXPECT_EQ(table_stats_obj_.GetCardinality(catalog::col_oid_t(1)), 0);
+}
+
 // NOLINTNEXTLINE
 TEST_F(TableStatsTests, TableStatsJsonTest) {
   auto table_stats_obj_json = table_stats_obj_.ToJson();
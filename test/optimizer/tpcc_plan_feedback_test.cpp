@@ -0,0 +1,40 @@
+#include <memory>
+#include <string>
+
+#include "optimizer/statistics/cardinality_feedback.h"
+#include "optimizer/statistics/stats_storage.h"
+#include "test_util/test_harness.h"
+#include "test_util/tpcc/tpcc_plan_test.h"
+
+namespace terrier {
+
+struct TpccPlanFeedbackTests : public TpccPlanTest {};
+
+// NOLINTNEXTLINE
+TEST_F(TpccPlanFeedbackTests, LearnedRowsTest) {
+  std::string query = "SELECT I_NAME FROM ITEM WHERE I_PRICE > 10";
+  const int64_t actual_rows = 4321;
+
+  BeginTransaction();
+  auto plan = Optimize(query, tbl_item_, parser::StatementType::SELECT);
+  const common::hash_t fragment_key = plan->GetFragmentKey();
+  ASSERT_NE(fragment_key, 0U);
+  ASSERT_NE(plan->GetEstimatedRows(), actual_rows);
+
+  // The executor reports the rows of the plan, as the TrafficCop does after running it
+  auto feedback = stats_storage_->GetCardinalityFeedback();
+  feedback->RecordRows(fragment_key, plan->GetEstimatedRows(), actual_rows);
+
+  // The StatsCalculator estimates the same fragment with the learned count the next time the query is planned
+  auto replanned = Optimize(query, tbl_item_, parser::StatementType::SELECT);
+  EXPECT_EQ(replanned->GetFragmentKey(), fragment_key);
+  EXPECT_EQ(replanned->GetEstimatedRows(), actual_rows);
+
+  // Other queries are not affected
+  auto other = Optimize("SELECT I_NAME FROM ITEM WHERE I_PRICE < 10", tbl_item_, parser::StatementType::SELECT);
+  EXPECT_NE(other->GetFragmentKey(), fragment_key);
+  EXPECT_NE(other->GetEstimatedRows(), actual_rows);
+  EndTransaction(true);
+}
+
+}  // namespace terrier
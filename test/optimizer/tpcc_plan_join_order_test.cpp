@@ -0,0 +1,92 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "parser/expression/derived_value_expression.h"
+#include "planner/plannodes/abstract_join_plan_node.h"
+#include "planner/plannodes/index_scan_plan_node.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
+#include "test_util/test_harness.h"
+#include "test_util/tpcc/tpcc_plan_test.h"
+
+namespace terrier {
+
+struct TpccPlanJoinOrderTests : public TpccPlanTest {
+  // Collects the conjuncts of a predicate
+  static void CollectConjuncts(common::ManagedPointer<parser::AbstractExpression> expr,
+                               std::vector<common::ManagedPointer<parser::AbstractExpression>> *conjuncts) {
+    if (expr->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+      for (const auto &child : expr->GetChildren()) CollectConjuncts(child, conjuncts);
+      return;
+    }
+    conjuncts->push_back(expr);
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(TpccPlanJoinOrderTests, SixWayJoin) {
+  auto check = [](TpccPlanTest *test, parser::SelectStatement *sel_stmt, catalog::table_oid_t tbl_oid,
+                  std::unique_ptr<planner::AbstractPlanNode> plan) {
+    std::multiset<catalog::table_oid_t> tables;
+    size_t num_joins = 0;
+    size_t num_predicates = 0;
+    std::vector<const planner::AbstractPlanNode *> to_visit{plan.get()};
+    while (!to_visit.empty()) {
+      const planner::AbstractPlanNode *node = to_visit.back();
+      to_visit.pop_back();
+      for (size_t child = 0; child < node->GetChildrenSize(); child++) to_visit.push_back(node->GetChild(child));
+
+      switch (node->GetPlanNodeType()) {
+        case planner::PlanNodeType::SEQSCAN:
+          tables.insert(reinterpret_cast<const planner::SeqScanPlanNode *>(node)->GetTableOid());
+          break;
+        case planner::PlanNodeType::INDEXSCAN:
+          tables.insert(reinterpret_cast<const planner::IndexScanPlanNode *>(node)->GetTableOid());
+          break;
+        case planner::PlanNodeType::HASHJOIN:
+        case planner::PlanNodeType::NESTLOOP: {
+          num_joins++;
+          ASSERT_EQ(node->GetChildrenSize(), 2);
+
+          // Every join compares its two inputs, so the plan has no cross products
+          auto join = reinterpret_cast<const planner::AbstractJoinPlanNode *>(node);
+          ASSERT_NE(join->GetJoinPredicate(), nullptr);
+          std::vector<common::ManagedPointer<parser::AbstractExpression>> conjuncts;
+          TpccPlanJoinOrderTests::CollectConjuncts(join->GetJoinPredicate(), &conjuncts);
+          for (const auto &conjunct : conjuncts) {
+            EXPECT_EQ(conjunct->GetExpressionType(), parser::ExpressionType::COMPARE_EQUAL);
+            ASSERT_EQ(conjunct->GetChildrenSize(), 2);
+            ASSERT_EQ(conjunct->GetChild(0)->GetExpressionType(), parser::ExpressionType::VALUE_TUPLE);
+            ASSERT_EQ(conjunct->GetChild(1)->GetExpressionType(), parser::ExpressionType::VALUE_TUPLE);
+            auto left = conjunct->GetChild(0).CastManagedPointerTo<parser::DerivedValueExpression>();
+            auto right = conjunct->GetChild(1).CastManagedPointerTo<parser::DerivedValueExpression>();
+            EXPECT_NE(left->GetTupleIdx(), right->GetTupleIdx());
+          }
+          num_predicates += conjuncts.size();
+          break;
+        }
+        default:
+          break;
+      }
+    }
+
+    // Each table is scanned once, and each predicate of the query is evaluated by exactly one join
+    const std::multiset<catalog::table_oid_t> expected_tables{
+        test->tbl_warehouse_, test->tbl_district_,   test->tbl_customer_,
+        test->tbl_order_,     test->tbl_order_line_, test->tbl_item_};
+    EXPECT_EQ(tables, expected_tables);
+    EXPECT_EQ(num_joins, 5);
+    EXPECT_EQ(num_predicates, 10);
+  };
+
+  // Enough relations for the join enumerator, which orders the joins instead of the rules
+  std::string query =
+      "SELECT W_NAME, D_NAME, C_LAST, O_ENTRY_D, OL_AMOUNT, I_NAME "
+      "FROM WAREHOUSE, DISTRICT, CUSTOMER, \"ORDER\", \"ORDER LINE\", ITEM "
+      "WHERE W_ID = D_W_ID AND D_W_ID = C_W_ID AND D_ID = C_D_ID AND C_W_ID = O_W_ID AND C_D_ID = O_D_ID AND "
+      "C_ID = O_C_ID AND O_W_ID = OL_W_ID AND O_D_ID = OL_D_ID AND O_ID = OL_O_ID AND OL_I_ID = I_ID";
+  OptimizeQuery(query, tbl_customer_, check);
+}
+
+}  // namespace terrier
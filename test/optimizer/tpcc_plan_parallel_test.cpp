@@ -0,0 +1,66 @@
+#include <memory>
+#include <string>
+
+#include "common/managed_pointer.h"
+#include "common/worker_pool.h"
+#include "planner/plannodes/abstract_join_plan_node.h"
+#include "planner/plannodes/index_scan_plan_node.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
+#include "test_util/test_harness.h"
+#include "test_util/tpcc/tpcc_plan_test.h"
+
+namespace terrier {
+
+struct TpccPlanParallelTests : public TpccPlanTest {
+  // Checks that two plans have the same operators, join order and scanned tables
+  static void ExpectSamePlan(const planner::AbstractPlanNode *expected, const planner::AbstractPlanNode *actual) {
+    ASSERT_EQ(actual->GetPlanNodeType(), expected->GetPlanNodeType());
+    ASSERT_EQ(actual->GetChildrenSize(), expected->GetChildrenSize());
+    EXPECT_EQ(actual->GetOutputSchema()->GetColumns().size(), expected->GetOutputSchema()->GetColumns().size());
+
+    switch (expected->GetPlanNodeType()) {
+      case planner::PlanNodeType::SEQSCAN:
+        EXPECT_EQ(reinterpret_cast<const planner::SeqScanPlanNode *>(actual)->GetTableOid(),
+                  reinterpret_cast<const planner::SeqScanPlanNode *>(expected)->GetTableOid());
+        break;
+      case planner::PlanNodeType::INDEXSCAN:
+        EXPECT_EQ(reinterpret_cast<const planner::IndexScanPlanNode *>(actual)->GetTableOid(),
+                  reinterpret_cast<const planner::IndexScanPlanNode *>(expected)->GetTableOid());
+        break;
+      case planner::PlanNodeType::HASHJOIN:
+      case planner::PlanNodeType::NESTLOOP:
+        EXPECT_EQ(reinterpret_cast<const planner::AbstractJoinPlanNode *>(actual)->GetLogicalJoinType(),
+                  reinterpret_cast<const planner::AbstractJoinPlanNode *>(expected)->GetLogicalJoinType());
+        break;
+      default:
+        break;
+    }
+
+    for (size_t child = 0; child < expected->GetChildrenSize(); child++) {
+      ExpectSamePlan(expected->GetChild(child), actual->GetChild(child));
+    }
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(TpccPlanParallelTests, MultiWayJoin) {
+  // Join orders of equal cost abound with the trivial cost model, so the workers must agree on how ties are broken
+  std::string query =
+      "SELECT C_LAST, O_ENTRY_D, OL_AMOUNT, I_NAME FROM CUSTOMER, \"ORDER\", \"ORDER LINE\", ITEM "
+      "WHERE C_W_ID = O_W_ID AND C_D_ID = O_D_ID AND C_ID = O_C_ID AND O_W_ID = OL_W_ID AND O_D_ID = OL_D_ID AND "
+      "O_ID = OL_O_ID AND OL_I_ID = I_ID AND C_W_ID = 1";
+
+  BeginTransaction();
+  auto serial_plan = Optimize(query, tbl_customer_, parser::StatementType::SELECT);
+
+  // The threads are shared by the optimizations, as they are by the queries of the TrafficCop
+  common::WorkerPool threads(3, {});
+  for (int run = 0; run < 5; run++) {
+    auto parallel_plan =
+        Optimize(query, tbl_customer_, parser::StatementType::SELECT, common::ManagedPointer(&threads));
+    ExpectSamePlan(serial_plan.get(), parallel_plan.get());
+  }
+  EndTransaction(true);
+}
+
+}  // namespace terrier
@@ -0,0 +1,40 @@
+#include <memory>
+#include <string>
+
+#include "planner/plannodes/hash_join_plan_node.h"
+#include "test_util/test_harness.h"
+#include "test_util/tpcc/tpcc_plan_test.h"
+
+namespace terrier {
+
+struct TpccPlanUnnestingTests : public TpccPlanTest {};
+
+// NOLINTNEXTLINE
+TEST_F(TpccPlanUnnestingTests, InSubqueryToSemiJoin) {
+  auto check = [](TpccPlanTest *test, parser::SelectStatement *sel_stmt, catalog::table_oid_t tbl_oid,
+                  std::unique_ptr<planner::AbstractPlanNode> plan) {
+    // The IN subquery is unnested into a semi join of ITEM with STOCK
+    const planner::AbstractPlanNode *node = plan.get();
+    while (node->GetPlanNodeType() != planner::PlanNodeType::HASHJOIN) {
+      ASSERT_EQ(node->GetChildrenSize(), 1);
+      node = node->GetChild(0);
+    }
+    auto join = reinterpret_cast<const planner::HashJoinPlanNode *>(node);
+    EXPECT_EQ(join->GetLogicalJoinType(), planner::LogicalJoinType::SEMI);
+    EXPECT_EQ(join->GetLeftHashKeys().size(), 1);
+    EXPECT_EQ(join->GetRightHashKeys().size(), 1);
+    EXPECT_EQ(join->GetChildrenSize(), 2);
+
+    // Equal hashes do not make equal keys, so the IN predicate is checked as an equality
+    ASSERT_NE(join->GetJoinPredicate(), nullptr);
+    EXPECT_EQ(join->GetJoinPredicate()->GetExpressionType(), parser::ExpressionType::COMPARE_EQUAL);
+
+    // Only the columns of ITEM are produced
+    EXPECT_EQ(join->GetOutputSchema()->GetColumns().size(), 1);
+  };
+
+  std::string query = "SELECT I_NAME FROM ITEM WHERE I_ID IN (SELECT S_I_ID FROM STOCK WHERE S_QUANTITY < 10)";
+  OptimizeQuery(query, tbl_item_, check);
+}
+
+}  // namespace terrier
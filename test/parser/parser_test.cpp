@@ -427,6 +427,32 @@ TEST_F(ParserTestBase, SubqueryTest) {
   EXPECT_EQ(result->GetStatement(0)->GetType(), StatementType::SELECT);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, InListTest) {
+  // IN lists become disjunctions of equalities
+  auto result = parser::PostgresParser::BuildParseTree("SELECT * FROM foo WHERE id IN (1, 2, 3)");
+  auto select_stmt = result->GetStatement(0).CastManagedPointerTo<SelectStatement>();
+  auto where = select_stmt->GetSelectCondition();
+  EXPECT_EQ(where->GetExpressionType(), ExpressionType::CONJUNCTION_OR);
+  EXPECT_EQ(where->GetChild(0)->GetExpressionType(), ExpressionType::CONJUNCTION_OR);
+  EXPECT_EQ(where->GetChild(0)->GetChild(0)->GetExpressionType(), ExpressionType::COMPARE_EQUAL);
+  EXPECT_EQ(where->GetChild(0)->GetChild(1)->GetExpressionType(), ExpressionType::COMPARE_EQUAL);
+  auto last = where->GetChild(1);
+  EXPECT_EQ(last->GetExpressionType(), ExpressionType::COMPARE_EQUAL);
+  EXPECT_EQ(last->GetChild(0)->GetExpressionType(), ExpressionType::COLUMN_VALUE);
+  EXPECT_EQ(type::TransientValuePeeker::PeekInteger(
+                last->GetChild(1).CastManagedPointerTo<ConstantValueExpression>()->GetValue()),
+            3);
+
+  // NOT IN lists become conjunctions of inequalities
+  result = parser::PostgresParser::BuildParseTree("SELECT * FROM foo WHERE id NOT IN (1, 2)");
+  select_stmt = result->GetStatement(0).CastManagedPointerTo<SelectStatement>();
+  where = select_stmt->GetSelectCondition();
+  EXPECT_EQ(where->GetExpressionType(), ExpressionType::CONJUNCTION_AND);
+  EXPECT_EQ(where->GetChild(0)->GetExpressionType(), ExpressionType::COMPARE_NOT_EQUAL);
+  EXPECT_EQ(where->GetChild(1)->GetExpressionType(), ExpressionType::COMPARE_NOT_EQUAL);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ParserTestBase, TruncateTest) {
   auto result = parser::PostgresParser::BuildParseTree("TRUNCATE TABLE test_db;");
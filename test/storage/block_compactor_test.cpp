@@ -382,4 +382,87 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
   }
 }
 
+// This tests dictionary compresses random single blocks, and verifies that the dictionary codes of the tuples in a
+// frozen block can be read for a buffer of tuples materialized from it, but not once the block thaws.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, DictionaryCodesTest) {
+  uint32_t repeat = 10;
+  for (uint32_t iteration = 0; iteration < repeat; iteration++) {
+    storage::BlockLayout layout = StorageTestUtil::RandomLayoutWithVarlens(100, &generator_);
+    storage::TupleAccessStrategy accessor(layout);
+    storage::DataTable table(&block_store_, layout, storage::layout_version_t(0));
+    storage::RawBlock *block = block_store_.Get();
+    accessor.InitializeRawBlock(&table, block, storage::layout_version_t(0));
+
+    transaction::TimestampManager timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool_), true, DISABLED};
+    storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                                 DISABLED};
+
+    auto tuples = StorageTestUtil::PopulateBlockRandomly(&table, block, percent_empty_, &generator_);
+    auto num_tuples = static_cast<uint32_t>(tuples.size());
+
+    auto &arrow_metadata = accessor.GetArrowBlockMetadata(block);
+    for (storage::col_id_t col_id : layout.AllColumns()) {
+      if (layout.IsVarlen(col_id)) {
+        arrow_metadata.GetColumnInfo(layout, col_id).Type() = storage::ArrowColumnType::DICTIONARY_COMPRESSED;
+      } else {
+        arrow_metadata.GetColumnInfo(layout, col_id).Type() = storage::ArrowColumnType::FIXED_LENGTH;
+      }
+    }
+
+    storage::BlockCompactor compactor;
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+    gc.PerformGarbageCollection();
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+    EXPECT_EQ(storage::BlockState::FROZEN, block->controller_.GetBlockState()->load());
+
+    // Lay out the compacted tuples in a buffer, as a scan of the block would
+    storage::ProjectedColumnsInitializer initializer(layout, StorageTestUtil::ProjectionListAllColumns(layout),
+                                                     layout.NumSlots());
+    byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+    storage::ProjectedColumns *columns = initializer.Initialize(buffer);
+    for (uint32_t i = 0; i < num_tuples; i++) columns->TupleSlots()[i] = storage::TupleSlot(block, i);
+    columns->SetNumTuples(num_tuples);
+
+    std::vector<uint32_t> codes(layout.NumSlots());
+    for (uint16_t i = 0; i < columns->NumColumns(); i++) {
+      storage::col_id_t col_id = columns->ColumnIds()[i];
+      const storage::ArrowVarlenColumn *dictionary = table.ReadDictionaryCodes(*columns, i, codes.data());
+      if (!layout.IsVarlen(col_id) || num_tuples == 0) {
+        EXPECT_EQ(nullptr, dictionary);
+        continue;
+      }
+      const storage::ArrowColumnInfo &col_info = arrow_metadata.GetColumnInfo(layout, col_id);
+      EXPECT_EQ(&col_info.VarlenColumn(), dictionary);
+      for (uint32_t j = 0; j < num_tuples; j++) {
+        if (accessor.ColumnNullBitmap(block, col_id)->Test(j)) {
+          EXPECT_EQ(col_info.Indices()[j], codes[j]);
+        }
+      }
+    }
+
+    // Codes cannot be read once writers may have changed the block
+    block->controller_.GetBlockState()->store(storage::BlockState::HOT);
+    for (uint16_t i = 0; i < columns->NumColumns(); i++) {
+      EXPECT_EQ(nullptr, table.ReadDictionaryCodes(*columns, i, codes.data()));
+    }
+    delete[] buffer;
+
+    for (auto &entry : tuples) delete[] reinterpret_cast<byte *>(entry.second);  // reclaim memory used for bookkeeping
+
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();  // Second call to deallocate.
+    for (storage::col_id_t col_id : layout.AllColumns())
+      if (layout.IsVarlen(col_id)) arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
+    block_store_.Release(block);
+  }
+}
+
 }  // namespace terrier
@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <random>
+#include <utility>
 #include <vector>
 
 #include "main/db_main.h"
@@ -530,6 +531,134 @@ TEST_F(BwTreeIndexTests, ScanLimitDescending) {
   txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+/**
+ * Tests that scans with keys return the keys the values are stored under, in scan order and up to the limit
+ */
+// NOLINTNEXTLINE
+TEST_F(BwTreeIndexTests, ScanWithKeys) {
+  // populate index with [0..20] even keys
+  std::map<int32_t, storage::TupleSlot> reference;
+  auto *const insert_txn = txn_manager_->BeginTransaction();
+  for (int32_t i = 0; i <= 20; i += 2) {
+    auto *const insert_redo =
+        insert_txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    auto *const insert_tuple = insert_redo->Delta();
+    *reinterpret_cast<int32_t *>(insert_tuple->AccessForceNotNull(0)) = i;
+    const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(insert_txn), insert_redo);
+
+    auto *const insert_key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+    *reinterpret_cast<int32_t *>(insert_key->AccessForceNotNull(0)) = i;
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *insert_key, tuple_slot));
+    reference[i] = tuple_slot;
+  }
+  txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  EXPECT_TRUE(default_index_->SupportsScanWithKeys());
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+
+  std::vector<storage::TupleSlot> results;
+  std::vector<byte> key_rows;
+  const uint32_t key_row_size = default_index_->KeyRowSize();
+  const auto key_at = [&](const uint32_t i) {
+    const auto *const key = reinterpret_cast<const storage::ProjectedRow *>(key_rows.data() + i * key_row_size);
+    return *reinterpret_cast<const int32_t *>(key->AccessWithNullCheck(0));
+  };
+
+  auto *const low_key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+  auto *const high_key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_2_);
+
+  // scan[7,13] should hit keys 8, 10, 12
+  *reinterpret_cast<int32_t *>(low_key_pr->AccessForceNotNull(0)) = 7;
+  *reinterpret_cast<int32_t *>(high_key_pr->AccessForceNotNull(0)) = 13;
+  default_index_->ScanWithKeys(*scan_txn, *low_key_pr, *high_key_pr, true, 0, &results, &key_rows);
+  EXPECT_EQ(results.size(), 3);
+  EXPECT_EQ(key_rows.size(), 3 * key_row_size);
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(key_at(i), static_cast<int32_t>(8 + 2 * i));
+    EXPECT_EQ(reference.at(key_at(i)), results[i]);
+  }
+  results.clear();
+  key_rows.clear();
+
+  // scan_limit[-1,21] should hit keys 20, 18
+  *reinterpret_cast<int32_t *>(low_key_pr->AccessForceNotNull(0)) = -1;
+  *reinterpret_cast<int32_t *>(high_key_pr->AccessForceNotNull(0)) = 21;
+  default_index_->ScanWithKeys(*scan_txn, *low_key_pr, *high_key_pr, false, 2, &results, &key_rows);
+  EXPECT_EQ(results.size(), 2);
+  EXPECT_EQ(key_rows.size(), 2 * key_row_size);
+  EXPECT_EQ(key_at(0), 20);
+  EXPECT_EQ(key_at(1), 18);
+  EXPECT_EQ(reference.at(20), results[0]);
+  EXPECT_EQ(reference.at(18), results[1]);
+  results.clear();
+  key_rows.clear();
+
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/**
+ * Tests that multi-range scans return the values of all the ranges once, in key order
+ */
+// NOLINTNEXTLINE
+TEST_F(BwTreeIndexTests, ScanRanges) {
+  // populate index with [0..20] even keys
+  std::map<int32_t, storage::TupleSlot> reference;
+  auto *const insert_txn = txn_manager_->BeginTransaction();
+  for (int32_t i = 0; i <= 20; i += 2) {
+    auto *const insert_redo =
+        insert_txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    auto *const insert_tuple = insert_redo->Delta();
+    *reinterpret_cast<int32_t *>(insert_tuple->AccessForceNotNull(0)) = i;
+    const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(insert_txn), insert_redo);
+
+    auto *const insert_key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+    *reinterpret_cast<int32_t *>(insert_key->AccessForceNotNull(0)) = i;
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *insert_key, tuple_slot));
+    reference[i] = tuple_slot;
+  }
+  txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+
+  // ranges [11,15], [19,3], [7,13], [2,2] should hit keys 2, 8, 10, 12, 14. The empty range [19,3] hits nothing, and
+  // the overlapping ranges [7,13] and [11,15] do not return 12 twice.
+  const std::vector<std::pair<int32_t, int32_t>> bounds{{11, 15}, {19, 3}, {7, 13}, {2, 2}};
+  const std::vector<int32_t> expected_keys{2, 8, 10, 12, 14};
+  const uint32_t key_row_size = default_index_->KeyRowSize();
+  std::vector<byte> range_rows(2 * bounds.size() * key_row_size);
+  std::vector<std::pair<const storage::ProjectedRow *, const storage::ProjectedRow *>> ranges;
+  for (uint32_t i = 0; i < bounds.size(); i++) {
+    auto *const low_key_pr =
+        default_index_->GetProjectedRowInitializer().InitializeRow(range_rows.data() + 2 * i * key_row_size);
+    auto *const high_key_pr =
+        default_index_->GetProjectedRowInitializer().InitializeRow(range_rows.data() + (2 * i + 1) * key_row_size);
+    *reinterpret_cast<int32_t *>(low_key_pr->AccessForceNotNull(0)) = bounds[i].first;
+    *reinterpret_cast<int32_t *>(high_key_pr->AccessForceNotNull(0)) = bounds[i].second;
+    ranges.emplace_back(low_key_pr, high_key_pr);
+  }
+
+  std::vector<storage::TupleSlot> results;
+  default_index_->ScanRanges(*scan_txn, ranges, &results, nullptr);
+  EXPECT_EQ(results.size(), expected_keys.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(reference.at(expected_keys[i]), results[i]);
+  }
+  results.clear();
+
+  // the same scan also returns the keys
+  std::vector<byte> key_rows;
+  default_index_->ScanRanges(*scan_txn, ranges, &results, &key_rows);
+  EXPECT_EQ(results.size(), expected_keys.size());
+  EXPECT_EQ(key_rows.size(), expected_keys.size() * key_row_size);
+  for (uint32_t i = 0; i < results.size(); i++) {
+    const auto *const key = reinterpret_cast<const storage::ProjectedRow *>(key_rows.data() + i * key_row_size);
+    EXPECT_EQ(*reinterpret_cast<const int32_t *>(key->AccessWithNullCheck(0)), expected_keys[i]);
+    EXPECT_EQ(reference.at(expected_keys[i]), results[i]);
+  }
+
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 // Verifies that primary key insert fails on write-write conflict
 // NOLINTNEXTLINE
 TEST_F(BwTreeIndexTests, UniqueKey1) {
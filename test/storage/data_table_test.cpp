@@ -137,11 +137,12 @@ class RandomDataTableTestObject {
   }
 
   void Scan(storage::DataTable::SlotIterator *begin, const transaction::timestamp_t timestamp,
-            storage::ProjectedColumns *buffer, storage::RecordBufferSegmentPool *buffer_pool) {
+            storage::ProjectedColumns *buffer, storage::RecordBufferSegmentPool *buffer_pool,
+            const storage::DataTable::SlotIterator *stop = nullptr) {
     auto *txn =
         new transaction::TransactionContext(timestamp, timestamp, common::ManagedPointer(buffer_pool), DISABLED);
     loose_txns_.push_back(txn);
-    table_.Scan(common::ManagedPointer(txn), begin, buffer);
+    table_.Scan(common::ManagedPointer(txn), begin, buffer, nullptr, stop);
   }
 
   storage::DataTable &GetTable() { return table_; }
@@ -234,6 +235,41 @@ TEST_F(DataTableTests, SimpleSequentialScan) {
   }
 }
 
+// Insert tuples into several blocks and scan each block on its own, stopping at the start of the next one
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, BlockRangeScan) {
+  const uint16_t max_columns = 20;
+  RandomDataTableTestObject tested(&block_store_, max_columns, null_ratio_(generator_), &generator_);
+  const uint32_t num_slots = tested.Layout().NumSlots();
+  const uint32_t num_inserts = 2 * num_slots + std::uniform_int_distribution<uint32_t>(1, num_slots - 1)(generator_);
+  for (uint32_t i = 0; i < num_inserts; ++i)
+    tested.InsertRandomTuple(transaction::timestamp_t(0), &generator_, &buffer_pool_);
+
+  const std::vector<storage::DataTable::SlotIterator> blocks = tested.GetTable().BlockBegins();
+  ASSERT_EQ(3, blocks.size());
+  EXPECT_EQ(tested.GetTable().begin(), blocks[0]);
+
+  std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(tested.Layout());
+  storage::ProjectedColumnsInitializer initializer(tested.Layout(), all_cols, num_inserts);
+  auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+  storage::ProjectedColumns *columns = initializer.Initialize(buffer);
+  uint32_t num_scanned = 0;
+  for (uint32_t block = 0; block < blocks.size(); block++) {
+    const storage::DataTable::SlotIterator stop =
+        block + 1 < blocks.size() ? blocks[block + 1] : tested.GetTable().end();
+    auto it = blocks[block];
+    tested.Scan(&it, transaction::timestamp_t(1), columns, &buffer_pool_, &stop);
+    EXPECT_EQ(stop, it);
+    EXPECT_EQ(block + 1 < blocks.size() ? num_slots : num_inserts - 2 * num_slots, columns->NumTuples());
+    for (uint32_t i = 0; i < columns->NumTuples(); i++) {
+      EXPECT_EQ(blocks[block]->GetBlock(), columns->TupleSlots()[i].GetBlock());
+    }
+    num_scanned += columns->NumTuples();
+  }
+  EXPECT_EQ(num_inserts, num_scanned);
+  delete[] buffer;
+}
+
 // Generates a random table layout and coin flip bias for an attribute being null, inserts 1 random tuple into an empty
 // DataTable. Then, randomly updates the tuple num_updates times. Finally, Selects at each timestamp to verify that the
 // delta chain produces the correct tuple. Repeats for num_iterations.
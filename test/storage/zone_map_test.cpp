@@ -0,0 +1,152 @@
+#include "storage/zone_map.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "storage/arrow_block_metadata.h"
+#include "storage/block_access_controller.h"
+#include "storage/tuple_access_strategy.h"
+#include "test_util/test_harness.h"
+
+namespace terrier {
+
+struct ZoneMapTests : public TerrierTest {
+  storage::RawBlock *raw_block_ = nullptr;
+  storage::BlockStore block_store_{1, 1};
+
+ protected:
+  void SetUp() override { raw_block_ = block_store_.Get(); }
+
+  void TearDown() override { block_store_.Release(raw_block_); }
+};
+
+// Keys must order values of every type the same way the values themselves are ordered
+// NOLINTNEXTLINE
+TEST_F(ZoneMapTests, KeyOrder) {
+  std::vector<int64_t> signed_values = {std::numeric_limits<int64_t>::min(), -100, -1, 0, 1, 100,
+                                        std::numeric_limits<int64_t>::max()};
+  for (uint32_t i = 1; i < signed_values.size(); i++) {
+    EXPECT_LT(storage::ZoneMap::SignedIntegerKey(signed_values[i - 1]),
+              storage::ZoneMap::SignedIntegerKey(signed_values[i]));
+  }
+
+  std::vector<uint64_t> unsigned_values = {0, 1, uint64_t{1} << 62u, uint64_t{1} << 63u,
+                                           std::numeric_limits<uint64_t>::max()};
+  for (uint32_t i = 1; i < unsigned_values.size(); i++) {
+    EXPECT_LT(storage::ZoneMap::UnsignedIntegerKey(unsigned_values[i - 1]),
+              storage::ZoneMap::UnsignedIntegerKey(unsigned_values[i]));
+  }
+
+  std::vector<double> float_values = {-std::numeric_limits<double>::infinity(), -1e300, -2.5, -1e-300, 0.0, 1e-300,
+                                      2.5, 1e300, std::numeric_limits<double>::infinity()};
+  for (uint32_t i = 1; i < float_values.size(); i++) {
+    EXPECT_LT(storage::ZoneMap::FloatKey(float_values[i - 1]), storage::ZoneMap::FloatKey(float_values[i]));
+  }
+  EXPECT_EQ(storage::ZoneMap::FloatKey(0.0), storage::ZoneMap::FloatKey(-0.0));
+
+  // Dates are packed as year | month << 16 | day << 24
+  auto pack = [](int16_t year, uint8_t month, uint8_t day) {
+    return static_cast<uint32_t>(static_cast<uint16_t>(year)) | static_cast<uint32_t>(month) << 16u |
+           static_cast<uint32_t>(day) << 24u;
+  };
+  std::vector<uint32_t> date_values = {pack(-44, 3, 15), pack(1999, 12, 31), pack(2000, 1, 1), pack(2000, 1, 2),
+                                       pack(2000, 2, 1), pack(2020, 1, 1)};
+  for (uint32_t i = 1; i < date_values.size(); i++) {
+    EXPECT_LT(storage::ZoneMap::DateKey(date_values[i - 1]), storage::ZoneMap::DateKey(date_values[i]));
+  }
+}
+
+// Zone maps summarize only the non-NULL values of a column
+// NOLINTNEXTLINE
+TEST_F(ZoneMapTests, Compute) {
+  constexpr uint32_t num_records = 1000;
+  std::default_random_engine generator;
+  std::uniform_int_distribution<int32_t> distribution(-10000, 10000);
+
+  std::vector<int32_t> values(num_records);
+  common::RawConcurrentBitmap *nulls = common::RawConcurrentBitmap::Allocate(num_records);
+  int32_t min = std::numeric_limits<int32_t>::max(), max = std::numeric_limits<int32_t>::min();
+  uint32_t num_values = 0;
+  for (uint32_t i = 0; i < num_records; i++) {
+    values[i] = distribution(generator);
+    if (i % 10 == 0) {
+      // NULLs hold values outside the range of the non-NULL values, which must be ignored
+      values[i] = (i % 20 == 0) ? -20000 : 20000;
+      continue;
+    }
+    nulls->Flip(i, false);
+    min = std::min(min, values[i]);
+    max = std::max(max, values[i]);
+    num_values++;
+  }
+
+  storage::ZoneMap zone_map{};
+  EXPECT_FALSE(zone_map.IsValid());
+  EXPECT_TRUE(zone_map.MayContain(30000, 40000));
+
+  zone_map.Compute(storage::ZoneMapType::SIGNED_INTEGER, reinterpret_cast<const byte *>(values.data()),
+                   sizeof(int32_t), nulls, num_records);
+  EXPECT_TRUE(zone_map.IsValid());
+  EXPECT_EQ(min, zone_map.GetMinKey());
+  EXPECT_EQ(max, zone_map.GetMaxKey());
+  EXPECT_EQ(num_values, zone_map.NumValues());
+
+  EXPECT_TRUE(zone_map.MayContain(min, min));
+  EXPECT_TRUE(zone_map.MayContain(max, max));
+  EXPECT_TRUE(zone_map.MayContain(std::numeric_limits<int64_t>::min(), min));
+  EXPECT_FALSE(zone_map.MayContain(std::numeric_limits<int64_t>::min(), min - 1));
+  EXPECT_FALSE(zone_map.MayContain(max + 1, std::numeric_limits<int64_t>::max()));
+
+  // A column of only NULLs contains nothing
+  common::RawConcurrentBitmap *all_nulls = common::RawConcurrentBitmap::Allocate(num_records);
+  zone_map.Compute(storage::ZoneMapType::SIGNED_INTEGER, reinterpret_cast<const byte *>(values.data()),
+                   sizeof(int32_t), all_nulls, num_records);
+  EXPECT_EQ(0, zone_map.NumValues());
+  EXPECT_FALSE(zone_map.MayContain(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()));
+
+  common::RawConcurrentBitmap::Deallocate(nulls);
+  common::RawConcurrentBitmap::Deallocate(all_nulls);
+}
+
+// Filters only skip frozen blocks whose zone maps rule out every tuple
+// NOLINTNEXTLINE
+TEST_F(ZoneMapTests, FilterSkipsFrozenBlocks) {
+  storage::BlockLayout layout({8, 4});
+  storage::TupleAccessStrategy accessor(layout);
+  accessor.InitializeRawBlock(nullptr, raw_block_, storage::layout_version_t(0));
+
+  // Column 1 holds the integers [100, 200)
+  constexpr uint32_t num_records = 100;
+  auto *values = reinterpret_cast<int32_t *>(accessor.ColumnStart(raw_block_, storage::col_id_t(1)));
+  common::RawConcurrentBitmap *nulls = accessor.ColumnNullBitmap(raw_block_, storage::col_id_t(1));
+  for (uint32_t i = 0; i < num_records; i++) {
+    values[i] = static_cast<int32_t>(100 + i);
+    nulls->Flip(i, false);
+  }
+  storage::ArrowBlockMetadata &metadata = accessor.GetArrowBlockMetadata(raw_block_);
+  metadata.GetZoneMap(layout, storage::col_id_t(1))
+      .Compute(storage::ZoneMapType::SIGNED_INTEGER, reinterpret_cast<const byte *>(values), sizeof(int32_t), nulls,
+               num_records);
+
+  storage::ZoneMapFilter outside, inside;
+  EXPECT_TRUE(outside.Empty());
+  outside.AddRange(storage::col_id_t(1), 200, 300);
+  inside.AddRange(storage::col_id_t(1), 150, 150);
+  EXPECT_FALSE(outside.Empty());
+
+  // Hot blocks are always scanned
+  EXPECT_FALSE(outside.CanSkip(accessor, raw_block_));
+  EXPECT_FALSE(inside.CanSkip(accessor, raw_block_));
+
+  raw_block_->controller_.GetBlockState()->store(storage::BlockState::FROZEN);
+  EXPECT_TRUE(outside.CanSkip(accessor, raw_block_));
+  EXPECT_FALSE(inside.CanSkip(accessor, raw_block_));
+
+  // One range that rules out the block is enough to skip it
+  inside.AddRange(storage::col_id_t(1), 0, 99);
+  EXPECT_TRUE(inside.CanSkip(accessor, raw_block_));
+}
+
+}  // namespace terrier
@@ -91,9 +91,9 @@ void TpccPlanTest::EndTransaction(bool commit) {
     txn_manager_->Abort(txn_);
 }
 
-std::unique_ptr<planner::AbstractPlanNode> TpccPlanTest::Optimize(const std::string &query,
-                                                                  catalog::table_oid_t tbl_oid,
-                                                                  parser::StatementType stmt_type) {
+std::unique_ptr<planner::AbstractPlanNode> TpccPlanTest::Optimize(
+    const std::string &query, catalog::table_oid_t tbl_oid, parser::StatementType stmt_type,
+    common::ManagedPointer<common::WorkerPool> optimizer_threads) {
   auto stmt_list = parser::PostgresParser::BuildParseTree(query);
 
   // Bind + Transform
@@ -105,7 +105,8 @@ std::unique_ptr<planner::AbstractPlanNode> TpccPlanTest::Optimize(const std::str
   delete binder;
   delete transformer;
 
-  auto optimizer = new optimizer::Optimizer(std::make_unique<optimizer::TrivialCostModel>(), task_execution_timeout_);
+  auto optimizer = new optimizer::Optimizer(std::make_unique<optimizer::TrivialCostModel>(), task_execution_timeout_,
+                                            optimizer_threads);
   std::unique_ptr<planner::AbstractPlanNode> out_plan;
   if (stmt_type == parser::StatementType::SELECT) {
     auto sel_stmt = stmt_list->GetStatement(0).CastManagedPointerTo<parser::SelectStatement>();
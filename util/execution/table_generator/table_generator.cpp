@@ -200,6 +200,12 @@ void TableGenerator::GenerateTestTables() {
         {"col3", type::TypeId::BIGINT, false, Dist::Uniform, 0, common::Constants::K_DEFAULT_VECTOR_SIZE},
         {"col4", type::TypeId::INTEGER, true, Dist::Uniform, 0, 2 * common::Constants::K_DEFAULT_VECTOR_SIZE}}},
 
+      // Table with a nullable small-domain grouping key
+      {"test_tinyint",
+       TEST2_SIZE,
+       {{"colA", type::TypeId::INTEGER, false, Dist::Serial, 0, 0},
+        {"colB", type::TypeId::TINYINT, true, Dist::Uniform, 0, 9}}},
+
       // Empty table with two columns
       {"empty_table2",
        0,